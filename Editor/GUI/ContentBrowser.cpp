@@ -2,6 +2,7 @@
 #include <vector>
 #include <string>
 #include <filesystem>
+#include <tuple>
 #include "imgui.h"
 using std::vector;
 using std::string;
@@ -32,6 +33,20 @@ namespace SoulEditor
         return {directories, files};
     }
 
+    void ContentBrowser::SetRootPath(const std::string& path)
+    {
+        rootPath = path;
+        currentPath.clear();
+        listingDirty = true;
+
+        auto& watcher = SoulEngine::FileWatcher::GetInstance();
+        watcher.Unwatch(watchId);
+        watchId = watcher.Watch(rootPath, true, [this](const std::vector<SoulEngine::FileChangeEvent>&)
+        {
+            listingDirty = true;
+        });
+    }
+
     void ContentBrowser::OnInitialize()
     {
         GuiWindow::OnInitialize();
@@ -60,7 +75,14 @@ namespace SoulEditor
         }
 
         std::filesystem::path path(root);
-        auto [dirs, files] = ListFilesAndDirs(path.string().c_str());
+        if (listingDirty || listedPath != path.string())
+        {
+            listedPath = path.string();
+            std::tie(listedDirs, listedFiles) = ListFilesAndDirs(listedPath.c_str());
+            listingDirty = false;
+        }
+        const auto& dirs = listedDirs;
+        const auto& files = listedFiles;
         // Display directories
         for (const auto& dir : dirs)
         {
@@ -101,6 +123,8 @@ namespace SoulEditor
 
     void ContentBrowser::OnShutdown()
     {
+        SoulEngine::FileWatcher::GetInstance().Unwatch(watchId);
+        watchId = 0;
         GuiWindow::OnShutdown();
     }
 
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "GuiWindow.h"
+#include "Core/FileWatcher.h"
 namespace SoulEditor
 {
     class ContentBrowser:public GuiWindow
@@ -12,12 +13,18 @@ namespace SoulEditor
         void OnRender() override;
         void OnShutdown() override;
 
-        void SetRootPath(const std::string& path) { rootPath = path; }
+        void SetRootPath(const std::string& path);
     protected:
         bool CanClose() const override;
     private:
         std::string rootPath;
         std::vector<std::string> currentPath;
+        // 当前目录的列表只在切换目录或 FileWatcher 报告变化时重新枚举
+        std::string listedPath;
+        std::vector<std::string> listedDirs;
+        std::vector<std::string> listedFiles;
+        bool listingDirty = true;
+        SoulEngine::FileWatcher::WatchId watchId = 0;
     private:
         void RenderContent();
     };
@@ -24,6 +24,7 @@ namespace SoulEditor
             return false;
         }
         
+        OpenImportDatabase();
         isLoaded_ = true;
         isDirty_ = false;
         return true;
@@ -60,6 +61,7 @@ namespace SoulEditor
             return false;
         }
         
+        OpenImportDatabase();
         isLoaded_ = true;
         isDirty_ = false;
         return true;
@@ -83,12 +85,47 @@ namespace SoulEditor
 
     void Project::CloseProject()
     {
+        SoulEngine::FileWatcher::GetInstance().Unwatch(assetsWatch_);
+        assetsWatch_ = 0;
+        importDatabase_.Close();
         projectPath_.clear();
         settings_ = ProjectSettings();
         isLoaded_ = false;
         isDirty_ = false;
     }
 
+    SoulEngine::ImportStats Project::RefreshAssets()
+    {
+        if (!isLoaded_)
+        {
+            return {};
+        }
+        return importDatabase_.Refresh();
+    }
+
+    bool Project::OpenImportDatabase()
+    {
+        importDatabase_.Close();
+        if (!std::filesystem::exists(GetAssetsPath()))
+        {
+            std::filesystem::create_directories(GetAssetsPath());
+        }
+        importDatabase_.RegisterDefaultImporters();
+        if (!importDatabase_.Open(GetAssetsPath(), GetLibraryPath()))
+        {
+            return false;
+        }
+
+        // 一批合并后的文件变化只触发一次增量导入
+        SoulEngine::FileWatcher::GetInstance().Unwatch(assetsWatch_);
+        assetsWatch_ = SoulEngine::FileWatcher::GetInstance().Watch(GetAssetsPath(), true,
+            [this](const std::vector<SoulEngine::FileChangeEvent> &)
+            {
+                RefreshAssets();
+            });
+        return true;
+    }
+
     bool Project::CreateProjectDirectories() const
     {
         try
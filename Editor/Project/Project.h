@@ -2,6 +2,8 @@
 #include <string>
 #include <filesystem>
 #include "Define.h"
+#include "Core/FileWatcher.h"
+#include "Resource/ImportDatabase.h"
 
 namespace SoulEditor
 {
@@ -54,6 +56,13 @@ namespace SoulEditor
          */
         void CloseProject();
 
+        /**
+         * @brief 增量导入 Assets 中变化的资源，结果缓存在 Library 中
+         * 项目打开期间 Assets 的变化（FileWatcher）会自动触发
+         * @return 本次扫描与导入的统计
+         */
+        SoulEngine::ImportStats RefreshAssets();
+
         // 获取器
         const std::string &GetProjectPath() const { return projectPath_; }
         const std::string &GetProjectName() const { return settings_.name; }
@@ -72,17 +81,22 @@ namespace SoulEditor
         std::string GetLibraryPath() const { return projectPath_ + "/Library"; }
         std::string GetLogsPath() const { return projectPath_ + "/Logs"; }
 
+        SoulEngine::ImportDatabase &GetImportDatabase() { return importDatabase_; }
+
     private:
         std::string projectPath_;       // 项目根目录路径
         ProjectSettings settings_;      // 项目设置
         bool isLoaded_ = false;        // 是否已加载项目
         bool isDirty_ = false;         // 是否有未保存的更改
+        SoulEngine::ImportDatabase importDatabase_;     // 资源导入记录（Library/AssetDatabase）
+        SoulEngine::FileWatcher::WatchId assetsWatch_ = 0;
         
         // 私有辅助方法
         bool CreateProjectDirectories() const;
         bool CreateProjectFile();
         bool LoadProjectFile();
         bool SaveProjectFile();
+        bool OpenImportDatabase();
         void MarkClean() { isDirty_ = false; }
     };
 
@@ -12,6 +12,7 @@ namespace SoulEditor
         proj->CreateNewProject(path, name);
         currentProject_ = proj;
         SoulEngine::EngineFileIO::SetProjectPath(proj->GetProjectPath());
+        proj->RefreshAssets();
         AddToRecentProjects(proj->GetProjectPath());
         if (onProjectCreatedCallback_)
         {
@@ -25,6 +26,7 @@ namespace SoulEditor
         auto proj = std::make_shared<Project>();
         proj->LoadProject(path);
         SoulEngine::EngineFileIO::SetProjectPath(proj->GetProjectPath());
+        proj->RefreshAssets();
         currentProject_ = proj;
         AddToRecentProjects(proj->GetProjectPath());
         if (onProjectOpenedCallback_)
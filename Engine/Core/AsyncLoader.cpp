@@ -0,0 +1,409 @@
+#include "AsyncLoader.h"
+#include "EngineFileIO.h"
+#include "JobSystem.h"
+#include "Log/Logger.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+
+namespace SoulEngine
+{
+    namespace Detail
+    {
+        // 一次实际的读取/解码，合并的请求共享同一个条目
+        struct LoadEntry
+        {
+            std::string key;
+            LoadRequest request;
+            std::atomic<LoadStatus> status{ LoadStatus::Queued };
+            std::atomic<bool> abandoned{ false };       // 开始读取后所有请求都被取消
+            std::shared_ptr<LoadResult> result = std::make_shared<LoadResult>();
+            std::vector<std::shared_ptr<LoadTicket>> tickets; // 交付或丢弃时清空，打破与 ticket 的循环引用
+            uint32_t liveTickets = 0;
+        };
+
+        // 一次 Load 调用；以下字段都受 AsyncLoader::mutex_ 保护
+        struct LoadTicket
+        {
+            std::shared_ptr<LoadEntry> entry;
+            LoadCallback callback;
+            std::shared_ptr<const LoadResult> result;
+            bool cancelled = false;
+        };
+    }
+
+    namespace
+    {
+        constexpr uint32_t kDefaultIoThreads = 2;
+
+        double ElapsedMs(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    LoadStatus LoadHandle::GetStatus() const
+    {
+        if (!ticket_)
+            return LoadStatus::Cancelled;
+        std::lock_guard<std::mutex> lock(AsyncLoader::GetInstance().mutex_);
+        if (ticket_->cancelled)
+            return LoadStatus::Cancelled;
+        if (ticket_->result)
+            return ticket_->result->status;
+        // 条目已完成但还没在主线程交付时仍报告解码中
+        const LoadStatus status = ticket_->entry ? ticket_->entry->status.load() : LoadStatus::Cancelled;
+        return status == LoadStatus::Ready || status == LoadStatus::Failed ? LoadStatus::Decoding : status;
+    }
+
+    bool LoadHandle::IsDone() const
+    {
+        const LoadStatus status = GetStatus();
+        return status == LoadStatus::Ready || status == LoadStatus::Failed || status == LoadStatus::Cancelled;
+    }
+
+    std::shared_ptr<const LoadResult> LoadHandle::GetResult() const
+    {
+        if (!ticket_)
+            return nullptr;
+        std::lock_guard<std::mutex> lock(AsyncLoader::GetInstance().mutex_);
+        return ticket_->result;
+    }
+
+    void LoadHandle::Cancel()
+    {
+        if (!ticket_)
+            return;
+        AsyncLoader &loader = AsyncLoader::GetInstance();
+        std::lock_guard<std::mutex> lock(loader.mutex_);
+        loader.CancelTicket(*ticket_);
+    }
+
+    void AsyncLoader::Initialize(uint32_t ioThreadCount)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_)
+            return;
+        if (ioThreadCount == 0)
+            ioThreadCount = kDefaultIoThreads;
+
+        // 与 JobSystem 相同：单例析构前线程必须已回收
+        static bool exitHookRegistered = false;
+        if (!exitHookRegistered)
+        {
+            std::atexit([] { AsyncLoader::GetInstance().StopThreads(); });
+            exitHookRegistered = true;
+        }
+
+        running_ = true;
+        ioThreads_.reserve(ioThreadCount);
+        for (uint32_t i = 0; i < ioThreadCount; ++i)
+            ioThreads_.emplace_back([this] { IoLoop(); });
+        Logger::Log("AsyncLoader started with {} I/O threads", ioThreadCount);
+    }
+
+    void AsyncLoader::Shutdown()
+    {
+        if (StopThreads())
+            Logger::Log("AsyncLoader shutdown");
+    }
+
+    bool AsyncLoader::StopThreads()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_)
+                return false;
+            running_ = false;
+            while (!queue_.empty())
+            {
+                EntryPtr entry = queue_.top().entry;
+                queue_.pop();
+                LoadStatus expected = LoadStatus::Queued;
+                if (entry->status.compare_exchange_strong(expected, LoadStatus::Cancelled))
+                {
+                    for (auto &ticket : entry->tickets)
+                        ticket->entry.reset();
+                    entry->tickets.clear();
+                }
+            }
+        }
+        queueCv_.notify_all();
+        for (auto &t : ioThreads_)
+        {
+            if (t.joinable())
+                t.join();
+        }
+        ioThreads_.clear();
+
+        // 正在读取的请求已完成；仍在 JobSystem 上解码的请求完成时看到 running_ == false 会自行丢弃
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &entry : completed_)
+        {
+            for (auto &ticket : entry->tickets)
+                ticket->entry.reset();
+            entry->tickets.clear();
+        }
+        completed_.clear();
+        inFlight_.clear();
+        pending_ = 0;
+        completedCv_.notify_all();
+        return true;
+    }
+
+    void AsyncLoader::EnsureStarted()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (running_)
+                return;
+        }
+        Initialize();
+    }
+
+    LoadHandle AsyncLoader::Load(LoadRequest request, LoadCallback callback)
+    {
+        EnsureStarted();
+
+        auto ticket = std::make_shared<Detail::LoadTicket>();
+        ticket->callback = std::move(callback);
+
+        const bool coalescable = !request.decodeKey.empty() || !request.decode;
+        std::string key = coalescable ? request.path + '\n' + request.decodeKey : std::string();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.requests;
+        if (coalescable)
+        {
+            auto it = inFlight_.find(key);
+            if (it != inFlight_.end())
+            {
+                EntryPtr &entry = it->second;
+                ++stats_.coalesced;
+                ++entry->liveTickets;
+                ticket->entry = entry;
+                entry->tickets.push_back(ticket);
+                // 提升优先级：重新入队，旧的队列项在取出时因状态已改变而被跳过
+                if (request.priority > entry->request.priority && entry->status == LoadStatus::Queued)
+                {
+                    entry->request.priority = request.priority;
+                    queue_.push({ request.priority, sequence_++, entry });
+                    queueCv_.notify_one();
+                }
+                return LoadHandle(std::move(ticket));
+            }
+        }
+
+        auto entry = std::make_shared<Detail::LoadEntry>();
+        entry->key = std::move(key);
+        entry->result->path = request.path;
+        entry->request = std::move(request);
+        entry->liveTickets = 1;
+        entry->tickets.push_back(ticket);
+        ticket->entry = entry;
+        if (coalescable)
+            inFlight_.emplace(entry->key, entry);
+        queue_.push({ entry->request.priority, sequence_++, entry });
+        ++pending_;
+        queueCv_.notify_one();
+        return LoadHandle(std::move(ticket));
+    }
+
+    void AsyncLoader::CancelTicket(Detail::LoadTicket &ticket)
+    {
+        if (ticket.cancelled || ticket.result || !ticket.entry)
+            return;
+        ticket.cancelled = true;
+        ticket.callback = nullptr;
+        EntryPtr entry = std::move(ticket.entry);
+        if (--entry->liveTickets > 0)
+            return;
+
+        // 最后一个请求被取消：之后相同路径的请求重新加载
+        auto it = inFlight_.find(entry->key);
+        if (it != inFlight_.end() && it->second == entry)
+            inFlight_.erase(it);
+
+        LoadStatus expected = LoadStatus::Queued;
+        if (entry->status.compare_exchange_strong(expected, LoadStatus::Cancelled))
+        {
+            // 尚未读取：直接丢弃，队列项在取出时被跳过
+            entry->tickets.clear();
+            --pending_;
+            ++stats_.cancelled;
+        }
+        else
+        {
+            // 已在读取或解码：跳过解码，完成后在 Update 中丢弃
+            entry->abandoned = true;
+        }
+    }
+
+    void AsyncLoader::IoLoop()
+    {
+        for (;;)
+        {
+            EntryPtr entry;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                queueCv_.wait(lock, [this] { return !running_ || !queue_.empty(); });
+                if (!running_)
+                    return;
+                entry = queue_.top().entry;
+                queue_.pop();
+                LoadStatus expected = LoadStatus::Queued;
+                if (!entry->status.compare_exchange_strong(expected, LoadStatus::Reading))
+                    continue; // 已取消，或是优先级提升后留下的旧队列项
+            }
+            Read(entry);
+        }
+    }
+
+    void AsyncLoader::Read(const EntryPtr &entry)
+    {
+        LoadResult &result = *entry->result;
+        const auto start = std::chrono::steady_clock::now();
+        if (entry->abandoned)
+        {
+            Complete(entry, LoadStatus::Cancelled);
+            return;
+        }
+        if (!EngineFileIO::FileExists(entry->request.path))
+        {
+            Logger::Warn("AsyncLoader: file not found: {}", entry->request.path);
+            Complete(entry, LoadStatus::Failed);
+            return;
+        }
+        const bool read = EngineFileIO::LoadBinary(entry->request.path, result.bytes);
+        result.readMs = ElapsedMs(start);
+        if (!read)
+        {
+            // I/O 错误不能当作空文件交给解码
+            Complete(entry, LoadStatus::Failed);
+            return;
+        }
+        {
+            // 在解码取走 bytes 之前计数
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.bytesRead += result.bytes.size();
+        }
+
+        if (!entry->request.decode || entry->abandoned)
+        {
+            Complete(entry, entry->abandoned ? LoadStatus::Cancelled : LoadStatus::Ready);
+            return;
+        }
+        entry->status = LoadStatus::Decoding;
+        JobSystem::GetInstance().Submit([this, entry] { Decode(entry); });
+    }
+
+    void AsyncLoader::Decode(const EntryPtr &entry)
+    {
+        if (entry->abandoned)
+        {
+            Complete(entry, LoadStatus::Cancelled);
+            return;
+        }
+        LoadResult &result = *entry->result;
+        const auto start = std::chrono::steady_clock::now();
+        result.decoded = entry->request.decode(result.bytes);
+        result.decodeMs = ElapsedMs(start);
+        if (!result.decoded)
+            Logger::Warn("AsyncLoader: failed to decode {}", entry->request.path);
+        Complete(entry, result.decoded ? LoadStatus::Ready : LoadStatus::Failed);
+    }
+
+    void AsyncLoader::Complete(const EntryPtr &entry, LoadStatus status)
+    {
+        entry->result->status = status;
+        std::lock_guard<std::mutex> lock(mutex_);
+        entry->status = status;
+        if (!running_)
+        {
+            for (auto &ticket : entry->tickets)
+                ticket->entry.reset();
+            entry->tickets.clear();
+            return;
+        }
+        // 交付前移出合并表：此后的同名请求会重新读取文件（可能已被修改）
+        auto it = inFlight_.find(entry->key);
+        if (it != inFlight_.end() && it->second == entry)
+            inFlight_.erase(it);
+        completed_.push_back(entry);
+        completedCv_.notify_all();
+    }
+
+    uint32_t AsyncLoader::Update()
+    {
+        std::vector<EntryPtr> completed;
+        std::vector<std::pair<LoadCallback, std::shared_ptr<const LoadResult>>> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            completed.swap(completed_);
+            for (auto &entry : completed)
+            {
+                --pending_;
+                if (entry->result->status == LoadStatus::Ready)
+                    ++stats_.completed;
+                else if (entry->result->status == LoadStatus::Failed)
+                    ++stats_.failed;
+                else
+                    ++stats_.cancelled;
+
+                std::shared_ptr<const LoadResult> result = entry->result;
+                for (auto &ticket : entry->tickets)
+                {
+                    ticket->entry.reset();
+                    if (ticket->cancelled)
+                        continue;
+                    ticket->result = result;
+                    if (ticket->callback)
+                        callbacks.emplace_back(std::move(ticket->callback), result);
+                }
+                entry->tickets.clear();
+            }
+        }
+
+        // 回调在锁外执行，回调中可以继续发起加载
+        for (auto &[callback, result] : callbacks)
+            callback(*result);
+        return static_cast<uint32_t>(completed.size());
+    }
+
+    void AsyncLoader::Wait(const LoadHandle &handle)
+    {
+        if (!handle.ticket_)
+            return;
+        for (;;)
+        {
+            Update();
+            std::unique_lock<std::mutex> lock(mutex_);
+            const Detail::LoadTicket &ticket = *handle.ticket_;
+            if (ticket.cancelled || ticket.result || !ticket.entry)
+                return;
+            completedCv_.wait(lock, [this] { return !completed_.empty() || !running_; });
+            if (!running_)
+                return;
+        }
+    }
+
+    void AsyncLoader::WaitAll()
+    {
+        for (;;)
+        {
+            Update();
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (pending_ == 0 || !running_)
+                return;
+            completedCv_.wait(lock, [this] { return !completed_.empty() || !running_; });
+        }
+    }
+
+    AsyncLoader::Stats AsyncLoader::GetStats()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stats stats = stats_;
+        stats.pending = pending_;
+        return stats;
+    }
+} // namespace SoulEngine
@@ -0,0 +1,197 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Define.h"
+
+namespace SoulEngine
+{
+    enum class LoadPriority : uint8_t
+    {
+        Background = 0,
+        Low,
+        Normal,
+        High,
+        Critical,
+    };
+
+    enum class LoadStatus : uint8_t
+    {
+        Queued,
+        Reading,
+        Decoding,
+        Ready,
+        Failed,
+        Cancelled,
+    };
+
+    // 解码函数在 JobSystem 工作线程上执行，可以取走 bytes；返回空指针表示解码失败
+    using LoadDecodeFn = std::function<std::shared_ptr<void>(std::vector<uint8_t> &bytes)>;
+
+    struct LoadRequest
+    {
+        std::string path;
+        LoadPriority priority = LoadPriority::Normal;
+        // 相同 path + decodeKey 的进行中请求共享一次读取与解码（decodeKey 标识解码方式，如 "texture.rgba8"）
+        // 有 decode 而 decodeKey 为空时不合并
+        std::string decodeKey;
+        LoadDecodeFn decode;
+    };
+
+    struct LoadResult
+    {
+        LoadStatus status = LoadStatus::Queued;
+        std::string path;
+        std::vector<uint8_t> bytes;         // 文件内容（解码函数取走时为空）
+        std::shared_ptr<void> decoded;      // 解码结果，无解码函数时为空
+        double readMs = 0.0;
+        double decodeMs = 0.0;
+
+        bool IsOk() const { return status == LoadStatus::Ready; }
+
+        template <class T>
+        std::shared_ptr<T> Get() const { return std::static_pointer_cast<T>(decoded); }
+
+        std::string_view GetText() const { return { reinterpret_cast<const char *>(bytes.data()), bytes.size() }; }
+    };
+
+    // 在主线程（AsyncLoader::Update / Wait 内）调用；合并的请求共享同一个结果对象
+    using LoadCallback = std::function<void(const LoadResult &)>;
+
+    namespace Detail
+    {
+        struct LoadEntry;
+        struct LoadTicket;
+    }
+
+    /**
+     * @brief 一次加载请求的句柄，可查询状态、取消、在完成后取得结果
+     */
+    class LoadHandle
+    {
+    public:
+        LoadHandle() = default;
+
+        bool IsValid() const { return ticket_ != nullptr; }
+        LoadStatus GetStatus() const;
+        // 结果已在主线程交付（Ready/Failed）或已取消
+        bool IsDone() const;
+        // 交付之前返回空
+        std::shared_ptr<const LoadResult> GetResult() const;
+        // 取消后不再回调；所有合并的请求都取消时，尚未开始读取的加载会被直接丢弃
+        void Cancel();
+
+    private:
+        friend class AsyncLoader;
+        explicit LoadHandle(std::shared_ptr<Detail::LoadTicket> ticket) : ticket_(std::move(ticket)) {}
+
+        std::shared_ptr<Detail::LoadTicket> ticket_;
+    };
+
+    /**
+     * @brief 异步资源加载器 - 优先级队列 + 专用 I/O 线程 + JobSystem 解码 + 主线程回调
+     *
+     * I/O 线程按优先级（同级先进先出）取出请求，通过 EngineFileIO::LoadBinary 读取（支持搜索路径与资源包），
+     * 有解码函数时把解码提交到 JobSystem，读取与解码因此可以流水线并行；完成的请求在主线程的 Update 中统一回调。
+     * 相同路径（与解码方式）的进行中请求会合并为一次读取，更高优先级的重复请求会提升已排队请求的优先级。
+     * 加载器不缓存结果：交付后条目即被移除，缓存与引用计数由上层的资源管理负责。
+     *
+     * 使用方式:
+     *   auto& loader = AsyncLoader::GetInstance();
+     *   LoadHandle vs = loader.Load({ "Shaders/base.vs.glsl", LoadPriority::High });
+     *   loader.Load({ "Textures/a.png", LoadPriority::Normal, "texture.rgba8", DecodeFn },
+     *               [](const LoadResult& r) { if (r.IsOk()) Use(r.Get<Image>()); });
+     *   loader.Wait(vs);                     // 启动阶段需要立即使用时阻塞等待
+     *   loader.Update();                     // 每帧一次（Engine 主循环中调用）
+     */
+    class AsyncLoader
+    {
+        SINGLETON_CLASS(AsyncLoader);
+
+    public:
+        struct Stats
+        {
+            uint64_t requests = 0;
+            uint64_t coalesced = 0;          // 合并到进行中请求的次数
+            uint64_t cancelled = 0;          // 所有请求都被取消的加载
+            uint64_t completed = 0;
+            uint64_t failed = 0;
+            uint64_t bytesRead = 0;
+            uint32_t pending = 0;            // 当前未交付的加载数
+        };
+
+        /**
+         * @brief 启动 I/O 线程
+         * @param ioThreadCount I/O 线程数量，0 表示默认（2 个）
+         */
+        void Initialize(uint32_t ioThreadCount = 0);
+
+        /**
+         * @brief 丢弃排队的请求、等待正在读取的请求结束并回收 I/O 线程；未交付的回调不再调用
+         */
+        void Shutdown();
+
+        LoadHandle Load(LoadRequest request, LoadCallback callback = nullptr);
+
+        /**
+         * @brief 交付已完成的请求并调用回调，只能在主线程调用
+         * @return 本次交付的加载数
+         */
+        uint32_t Update();
+
+        /**
+         * @brief 阻塞到请求完成并交付（会顺带交付其它已完成的请求），只能在主线程调用
+         */
+        void Wait(const LoadHandle &handle);
+        void WaitAll();
+
+        Stats GetStats();
+
+    private:
+        using EntryPtr = std::shared_ptr<Detail::LoadEntry>;
+
+        struct QueueItem
+        {
+            LoadPriority priority;
+            uint64_t sequence;
+            EntryPtr entry;
+
+            bool operator<(const QueueItem &other) const
+            {
+                if (priority != other.priority)
+                    return priority < other.priority;
+                return sequence > other.sequence;
+            }
+        };
+
+        friend class LoadHandle;
+
+        void EnsureStarted();
+        bool StopThreads();
+        void IoLoop();
+        void Read(const EntryPtr &entry);
+        void Decode(const EntryPtr &entry);
+        void Complete(const EntryPtr &entry, LoadStatus status);
+        void CancelTicket(Detail::LoadTicket &ticket);
+
+        std::mutex mutex_;
+        std::condition_variable queueCv_;
+        std::condition_variable completedCv_;
+        std::priority_queue<QueueItem> queue_;
+        std::unordered_map<std::string, EntryPtr> inFlight_;
+        std::vector<EntryPtr> completed_;
+        std::vector<std::thread> ioThreads_;
+        uint64_t sequence_ = 0;
+        uint32_t pending_ = 0;
+        bool running_ = false;
+        Stats stats_;
+    };
+} // namespace SoulEngine
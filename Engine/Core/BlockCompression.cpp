@@ -0,0 +1,186 @@
+#include "BlockCompression.h"
+#include <cstring>
+#include <vector>
+
+namespace SoulEngine
+{
+    namespace
+    {
+        constexpr std::size_t kMinMatch = 4;
+        constexpr std::size_t kLastLiterals = 5;   // 块末尾必须是字面量
+        constexpr std::size_t kMatchStartLimit = 12; // 最后一个匹配必须在距末尾 12 字节之前开始
+        constexpr std::size_t kMaxOffset = 65535;
+        constexpr uint32_t kHashLog = 16;
+
+        uint32_t Read32(const uint8_t *p)
+        {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        uint32_t Hash(uint32_t sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - kHashLog);
+        }
+
+        uint8_t *WriteLength(uint8_t *op, std::size_t length)
+        {
+            while (length >= 255)
+            {
+                *op++ = 255;
+                length -= 255;
+            }
+            *op++ = static_cast<uint8_t>(length);
+            return op;
+        }
+
+        uint8_t *WriteSequence(uint8_t *op, const uint8_t *literals, std::size_t literalCount, std::size_t offset, std::size_t matchLength)
+        {
+            uint8_t *token = op++;
+            *token = static_cast<uint8_t>((literalCount < 15 ? literalCount : 15) << 4);
+            if (literalCount >= 15)
+                op = WriteLength(op, literalCount - 15);
+            if (literalCount)
+                std::memcpy(op, literals, literalCount);
+            op += literalCount;
+            if (matchLength == 0)
+                return op;
+
+            *op++ = static_cast<uint8_t>(offset & 0xFF);
+            *op++ = static_cast<uint8_t>(offset >> 8);
+            const std::size_t ml = matchLength - kMinMatch;
+            *token |= static_cast<uint8_t>(ml < 15 ? ml : 15);
+            if (ml >= 15)
+                op = WriteLength(op, ml - 15);
+            return op;
+        }
+
+        bool ReadLength(const uint8_t *&ip, const uint8_t *end, std::size_t &length)
+        {
+            uint8_t b;
+            do
+            {
+                if (ip >= end)
+                    return false;
+                b = *ip++;
+                length += b;
+            } while (b == 255);
+            return true;
+        }
+    }
+
+    std::size_t BlockCompression::CompressBound(std::size_t srcSize)
+    {
+        return srcSize + srcSize / 255 + 16;
+    }
+
+    std::size_t BlockCompression::Compress(const void *src, std::size_t srcSize, void *dst, std::size_t dstCapacity)
+    {
+        if (dstCapacity < CompressBound(srcSize))
+            return 0;
+        const auto *in = static_cast<const uint8_t *>(src);
+        auto *op = static_cast<uint8_t *>(dst);
+        std::size_t anchor = 0;
+
+        if (srcSize > kMatchStartLimit)
+        {
+            std::vector<uint32_t> table(std::size_t(1) << kHashLog, 0);
+            const std::size_t matchStartLimit = srcSize - kMatchStartLimit;
+            const std::size_t matchEndLimit = srcSize - kLastLiterals;
+            std::size_t ip = 0;
+            while (ip < matchStartLimit)
+            {
+                const uint32_t sequence = Read32(in + ip);
+                const uint32_t h = Hash(sequence);
+                std::size_t ref = table[h];
+                table[h] = static_cast<uint32_t>(ip);
+                if (ref >= ip || ip - ref > kMaxOffset || Read32(in + ref) != sequence)
+                {
+                    // 长时间没有匹配时加大步长，避免在不可压缩数据上浪费时间
+                    ip += 1 + ((ip - anchor) >> 6);
+                    continue;
+                }
+
+                while (ip > anchor && ref > 0 && in[ip - 1] == in[ref - 1])
+                {
+                    --ip;
+                    --ref;
+                }
+                std::size_t length = kMinMatch;
+                while (ip + length < matchEndLimit && in[ref + length] == in[ip + length])
+                    ++length;
+
+                op = WriteSequence(op, in + anchor, ip - anchor, ip - ref, length);
+                ip += length;
+                anchor = ip;
+                if (ip - 2 < matchStartLimit)
+                    table[Hash(Read32(in + ip - 2))] = static_cast<uint32_t>(ip - 2);
+            }
+        }
+
+        op = WriteSequence(op, in + anchor, srcSize - anchor, 0, 0);
+        return static_cast<std::size_t>(op - static_cast<uint8_t *>(dst));
+    }
+
+    bool BlockCompression::Decompress(const void *src, std::size_t srcSize, void *dst, std::size_t dstSize)
+    {
+        const auto *ip = static_cast<const uint8_t *>(src);
+        const uint8_t *const end = ip + srcSize;
+        auto *const out = static_cast<uint8_t *>(dst);
+        std::size_t op = 0;
+
+        while (ip < end)
+        {
+            const uint8_t token = *ip++;
+            std::size_t literalCount = token >> 4;
+            if (literalCount == 15 && !ReadLength(ip, end, literalCount))
+                return false;
+            if (literalCount > static_cast<std::size_t>(end - ip) || literalCount > dstSize - op)
+                return false;
+            if (literalCount)
+                std::memcpy(out + op, ip, literalCount);
+            ip += literalCount;
+            op += literalCount;
+            if (ip == end)
+                break;
+
+            if (end - ip < 2)
+                return false;
+            const std::size_t offset = ip[0] | (std::size_t(ip[1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > op)
+                return false;
+            std::size_t length = token & 15;
+            if (length == 15 && !ReadLength(ip, end, length))
+                return false;
+            length += kMinMatch;
+            if (length > dstSize - op)
+                return false;
+
+            const uint8_t *match = out + op - offset;
+            uint8_t *dstPtr = out + op;
+            if (offset >= length)
+            {
+                std::memcpy(dstPtr, match, length);
+            }
+            else if (offset >= 8)
+            {
+                // 重叠但每 8 字节块内不重叠，按块向前拷贝
+                std::size_t i = 0;
+                for (; i + 8 <= length; i += 8)
+                    std::memcpy(dstPtr + i, match + i, 8);
+                for (; i < length; ++i)
+                    dstPtr[i] = match[i];
+            }
+            else
+            {
+                // 短周期的重复模式，只能逐字节向前
+                for (std::size_t i = 0; i < length; ++i)
+                    dstPtr[i] = match[i];
+            }
+            op += length;
+        }
+        return op == dstSize;
+    }
+} // namespace SoulEngine
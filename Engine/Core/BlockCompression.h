@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "Define.h"
+
+namespace SoulEngine
+{
+    /**
+     * @brief LZ4 块格式的压缩/解压
+     * 贪心哈希匹配，压缩率一般但解压只有内存拷贝的开销，适合打包资源在加载时解压。
+     * 只处理单个块（无帧头），解压时必须知道原始大小。
+     */
+    class BlockCompression
+    {
+        STATIC_CLASS(BlockCompression);
+
+    public:
+        // dst 至少需要的容量
+        static std::size_t CompressBound(std::size_t srcSize);
+
+        // 返回压缩后的字节数；dstCapacity 小于 CompressBound 时返回 0
+        static std::size_t Compress(const void *src, std::size_t srcSize, void *dst, std::size_t dstCapacity);
+
+        // 解压到恰好 dstSize 字节；数据损坏或大小不符时返回 false
+        static bool Decompress(const void *src, std::size_t srcSize, void *dst, std::size_t dstSize);
+    };
+} // namespace SoulEngine
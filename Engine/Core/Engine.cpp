@@ -1,6 +1,10 @@
 #include "Engine.h"
 #include "Application.h"
 #include "Timer.h"
+#include "JobSystem.h"
+#include "AsyncLoader.h"
+#include "FileWatcher.h"
+#include "Resource/ResourceManager.h"
 #include "Renderer/RenderSystem.h"
 #include "Window/WindowSystem.h"
 #include "Core/Input.h"
@@ -28,6 +32,8 @@ namespace SoulEngine {
 
         Logger::Log("Initializing SoulEngine...");
         Timer::GetInstance().Initialize();
+        JobSystem::GetInstance().Initialize();
+        AsyncLoader::GetInstance().Initialize();
         
         // 初始化窗口系统
         RegisterSystem<WindowSystem>();
@@ -60,6 +66,9 @@ namespace SoulEngine {
             m_application->Shutdown();
             m_application.reset();
         }
+
+        // 释放缓存的资源（仍被句柄持有的随句柄释放）
+        ResourceManager::GetInstance().Clear();
         
         // 关闭渲染器
         UnregisterSystem<RenderSystem>();
@@ -70,6 +79,10 @@ namespace SoulEngine {
         // 关闭各个子系统
         // TODO: 关闭音频系统
         // TODO: 关闭物理系统  
+
+        FileWatcher::GetInstance().Shutdown();
+        AsyncLoader::GetInstance().Shutdown();
+        JobSystem::GetInstance().Shutdown();
         
         m_initialized = false;
 
@@ -104,6 +117,10 @@ namespace SoulEngine {
             timer->Update();
             window->PollEvents();
             Input::GetInstance().Update();
+            // 交付异步加载结果，回调在主线程执行
+            AsyncLoader::GetInstance().Update();
+            // 交付合并后的文件变化（热重载、重新导入），回调在主线程执行
+            FileWatcher::GetInstance().Update();
             auto deltaTime = timer->GetDeltaTime();
             // update system
             for (const auto& system : m_systems) {
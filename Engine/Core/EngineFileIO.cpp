@@ -1,19 +1,157 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <fstream>
-#include <sstream>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include "EngineFileIO.h"
 #include "Log/Logger.h"
+#include "PackFile.h"
 #include "Util/FileUtil.hpp"
-#include "EngineFileIO.h"
 
 namespace SoulEngine
 {
+    namespace
+    {
+        // 一个搜索路径下所有常规文件的相对路径，首次查找时建立
+        struct SearchPathIndex
+        {
+            bool built = false;
+            std::unordered_set<std::string> files;
+            // 指向目录的符号链接（键加 '/'）：遍历不进入其中，其下的路径仍需逐个查询
+            std::vector<std::string> linkedDirectories;
+
+            bool IsUnderLinkedDirectory(const std::string &key) const
+            {
+                for (const std::string &dir : linkedDirectories)
+                {
+                    if (key.compare(0, dir.size(), dir) == 0)
+                        return true;
+                }
+                return false;
+            }
+        };
+
+        struct PathCache
+        {
+            std::shared_mutex mutex;
+            std::vector<SearchPathIndex> indices; // 与 searchPaths 一一对应
+            std::unordered_map<std::string, std::optional<std::filesystem::path>> resolved;
+            // 规范化键 -> 以该键缓存的原始请求路径，文件变化时只丢弃这些解析结果
+            std::unordered_map<std::string, std::vector<std::string>> requestsByKey;
+            std::atomic<uint64_t> hits{0};
+            std::atomic<uint64_t> misses{0};
+            std::atomic<uint64_t> statCalls{0};
+        };
+
+        PathCache &GetPathCache()
+        {
+            static PathCache cache;
+            return cache;
+        }
+
+        // 规范化的相对路径；Windows 文件系统不区分大小写，键统一转小写
+        std::string MakeIndexKey(const std::filesystem::path &relative)
+        {
+            std::string key = relative.lexically_normal().generic_string();
+#if defined(_WIN32)
+            std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+#endif
+            return key;
+        }
+
+        bool IsIndexableKey(const std::string &key)
+        {
+            return !key.empty() && key != "." && key.compare(0, 2, "..") != 0;
+        }
+
+        void BuildIndex(const std::filesystem::path &root, SearchPathIndex &index)
+        {
+            index.files.clear();
+            index.linkedDirectories.clear();
+            index.built = true;
+            std::error_code ec;
+            auto it = std::filesystem::recursive_directory_iterator(root, std::filesystem::directory_options::skip_permission_denied, ec);
+            for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+            {
+                std::error_code typeEc;
+                if (it->is_symlink(typeEc) && it->is_directory(typeEc))
+                    index.linkedDirectories.push_back(MakeIndexKey(it->path().lexically_relative(root)) + '/');
+                else if (it->is_regular_file(typeEc))
+                    index.files.insert(MakeIndexKey(it->path().lexically_relative(root)));
+            }
+        }
+
+        void ClearResolved(PathCache &cache)
+        {
+            cache.resolved.clear();
+            cache.requestsByKey.clear();
+        }
+
+        // 丢弃以 key 缓存的解析结果（包括未找到的）
+        void EraseResolved(PathCache &cache, const std::string &key)
+        {
+            auto it = cache.requestsByKey.find(key);
+            if (it == cache.requestsByKey.end())
+                return;
+            for (const std::string &request : it->second)
+                cache.resolved.erase(request);
+            cache.requestsByKey.erase(it);
+        }
+
+        struct PackRegistry
+        {
+            std::shared_mutex mutex;
+            std::vector<std::shared_ptr<PackArchive>> packs; // 后挂载的优先
+        };
+
+        PackRegistry &GetPackRegistry()
+        {
+            static PackRegistry registry;
+            return registry;
+        }
+
+        struct PackHit
+        {
+            std::shared_ptr<PackArchive> pack;
+            const PackEntry *entry = nullptr;
+        };
+
+        PackHit FindInPacks(const std::string &path)
+        {
+            auto &registry = GetPackRegistry();
+            std::shared_lock lock(registry.mutex);
+            for (auto it = registry.packs.rbegin(); it != registry.packs.rend(); ++it)
+            {
+                if (const PackEntry *entry = (*it)->Find(path))
+                    return {*it, entry};
+            }
+            return {};
+        }
+
+        bool Exists(const std::filesystem::path &path, PathCache &cache)
+        {
+            ++cache.statCalls;
+            std::error_code ec;
+            return std::filesystem::exists(path, ec);
+        }
+    }
+
     std::vector<std::filesystem::path> EngineFileIO::searchPaths{};
     std::filesystem::path EngineFileIO::projectPath = std::filesystem::current_path();
     std::string EngineFileIO::LoadText(const std::string &path)
     {
         auto fullPath = FindResourcePath(path);
-        if (!fullPath.has_value() || !std::filesystem::exists(fullPath.value()))
+        if (!fullPath.has_value())
         {
+            if (PackHit hit = FindInPacks(path); hit.entry)
+            {
+                std::vector<uint8_t> data;
+                hit.pack->ReadEntry(*hit.entry, data);
+                return std::string(data.begin(), data.end());
+            }
             Logger::Error("Could not find resource file: {}", path);
             return "";
         }
@@ -25,34 +163,70 @@ namespace SoulEngine
             return "";
         }
 
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return buffer.str();
+        // 按文件大小一次性读取；文本模式下换行转换可能使读到的字符更少
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(fullPath.value(), ec);
+        std::string content(ec ? 0 : static_cast<std::size_t>(size), '\0');
+        file.read(content.data(), static_cast<std::streamsize>(content.size()));
+        content.resize(static_cast<std::size_t>(file.gcount()));
+        return content;
     }
 
     std::vector<uint8_t> EngineFileIO::LoadBinary(const std::string &path)
     {
+        std::vector<uint8_t> data;
+        LoadBinary(path, data);
+        return data;
+    }
+
+    bool EngineFileIO::LoadBinary(const std::string &path, std::vector<uint8_t> &data)
+    {
+        data.clear();
         auto fullPath = FindResourcePath(path);
-        if (!fullPath.has_value() || !std::filesystem::exists(fullPath.value()))
+        if (!fullPath.has_value())
         {
-            Logger::Error("File does not exist: {}", fullPath.value().string());
-            return {};
+            if (PackHit hit = FindInPacks(path); hit.entry)
+                return hit.pack->ReadEntry(*hit.entry, data);
+            Logger::Error("File does not exist: {}", path);
+            return false;
         }
 
+        // file_size 对目录等非常规文件报错；ifstream 能打开目录，tellg 会给出无意义的大小
+        std::error_code ec;
+        const std::uintmax_t size = std::filesystem::file_size(fullPath.value(), ec);
         std::ifstream file(fullPath.value(), std::ios::binary);
-        if (!file.is_open())
+        if (ec || !file.is_open())
         {
             Logger::Error("Failed to open file: {}", fullPath.value().string());
-            return {};
+            return false;
         }
 
-        return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        data.resize(static_cast<std::size_t>(size));
+        if (!file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size())))
+        {
+            Logger::Error("Failed to read file: {}", fullPath.value().string());
+            data.clear();
+            return false;
+        }
+        return true;
     }
 
-    bool EngineFileIO::FileExists(const std::string &path)
+    MappedFile EngineFileIO::MapFile(const std::string &path)
     {
         auto fullPath = FindResourcePath(path);
-        return fullPath.has_value() && std::filesystem::exists(fullPath.value());
+        if (!fullPath.has_value())
+        {
+            if (PackHit hit = FindInPacks(path); hit.entry)
+                return hit.pack->OpenEntry(*hit.entry);
+            Logger::Error("File does not exist: {}", path);
+            return {};
+        }
+        return MappedFile(fullPath.value());
+    }
+
+    bool EngineFileIO::FileExists(const std::string &path)
+    {
+        return FindResourcePath(path).has_value() || FindInPacks(path).entry != nullptr;
     }
 
     std::optional<std::filesystem::path> EngineFileIO::ResolveFilePath(const std::string &path)
@@ -61,7 +235,35 @@ namespace SoulEngine
     }
     void EngineFileIO::AddSearchPath(const std::string &path)
     {
+        auto &cache = GetPathCache();
+        std::unique_lock lock(cache.mutex);
         searchPaths.emplace_back(path);
+        cache.indices.resize(searchPaths.size());
+        ClearResolved(cache);
+    }
+
+    bool EngineFileIO::MountPack(const std::string &path)
+    {
+        auto fullPath = FindResourcePath(path);
+        auto pack = PackArchive::Open(fullPath.value_or(std::filesystem::path(path)));
+        if (!pack)
+        {
+            Logger::Error("Failed to mount pack: {}", path);
+            return false;
+        }
+        Logger::Log("Mounted pack {} ({} entries)", pack->GetPath().string(), pack->GetEntryCount());
+        auto &registry = GetPackRegistry();
+        std::unique_lock lock(registry.mutex);
+        registry.packs.push_back(std::move(pack));
+        return true;
+    }
+
+    void EngineFileIO::UnmountPacks()
+    {
+        // 仍在使用的条目视图持有各自包的引用，映射在它们释放后才解除
+        auto &registry = GetPackRegistry();
+        std::unique_lock lock(registry.mutex);
+        registry.packs.clear();
     }
 
     const std::vector<std::filesystem::path> &EngineFileIO::GetSearchPaths()
@@ -71,26 +273,113 @@ namespace SoulEngine
 
     void EngineFileIO::ClearSearchPaths()
     {
+        auto &cache = GetPathCache();
+        std::unique_lock lock(cache.mutex);
         searchPaths.clear();
+        cache.indices.clear();
+        ClearResolved(cache);
+    }
+
+    void EngineFileIO::InvalidatePathCache()
+    {
+        auto &cache = GetPathCache();
+        std::unique_lock lock(cache.mutex);
+        for (auto &index : cache.indices)
+            index = {};
+        ClearResolved(cache);
+    }
+
+    void EngineFileIO::NotifyFileChanged(const std::filesystem::path &file, bool exists)
+    {
+        auto &cache = GetPathCache();
+        std::unique_lock lock(cache.mutex);
+        const auto absoluteFile = std::filesystem::absolute(file).lexically_normal();
+        EraseResolved(cache, MakeIndexKey(absoluteFile));
+        for (std::size_t i = 0; i < searchPaths.size(); ++i)
+        {
+            // 只有相对这个搜索路径得到同一键的请求可能改变结果（包括之前未找到的）
+            const auto root = std::filesystem::absolute(searchPaths[i]).lexically_normal();
+            const std::string key = MakeIndexKey(absoluteFile.lexically_relative(root));
+            EraseResolved(cache, key);
+            if (i >= cache.indices.size() || !cache.indices[i].built || !IsIndexableKey(key))
+                continue;
+            if (exists)
+                cache.indices[i].files.insert(key);
+            else
+                cache.indices[i].files.erase(key);
+        }
+    }
+
+    EngineFileIO::PathCacheStats EngineFileIO::GetPathCacheStats()
+    {
+        auto &cache = GetPathCache();
+        std::shared_lock lock(cache.mutex);
+        PathCacheStats stats;
+        stats.hits = cache.hits;
+        stats.misses = cache.misses;
+        stats.statCalls = cache.statCalls;
+        for (const auto &index : cache.indices)
+            stats.indexedFiles += index.files.size();
+        return stats;
     }
 
     std::optional<std::filesystem::path> EngineFileIO::FindResourcePath(const std::string &path)
     {
-        auto fullPath = std::filesystem::path(path);
-        if (fullPath.is_absolute() && std::filesystem::exists(fullPath))
+        auto &cache = GetPathCache();
+        {
+            std::shared_lock lock(cache.mutex);
+            auto it = cache.resolved.find(path);
+            if (it != cache.resolved.end())
+            {
+                ++cache.hits;
+                return it->second;
+            }
+        }
+
+        std::unique_lock lock(cache.mutex);
+        auto it = cache.resolved.find(path);
+        if (it != cache.resolved.end())
         {
-            return fullPath;
+            ++cache.hits;
+            return it->second;
         }
+        ++cache.misses;
 
-        for (const auto &searchPath : EngineFileIO::searchPaths)
+        std::optional<std::filesystem::path> result;
+        const std::filesystem::path request(path);
+        const std::string key = MakeIndexKey(request);
+        if (request.is_absolute())
         {
-            auto fullPath = std::filesystem::path(searchPath) / path;
-            if (std::filesystem::exists(fullPath))
+            if (Exists(request, cache))
+                result = request;
+        }
+        else if (IsIndexableKey(key))
+        {
+            // 索引未命中即不存在，无需访问文件系统；只有经由目录符号链接的路径（索引不进入）逐个查询
+            cache.indices.resize(searchPaths.size());
+            for (std::size_t i = 0; i < searchPaths.size() && !result; ++i)
             {
-                return fullPath;
+                SearchPathIndex &index = cache.indices[i];
+                if (!index.built)
+                    BuildIndex(searchPaths[i], index);
+                if (index.files.count(key) || (index.IsUnderLinkedDirectory(key) && Exists(searchPaths[i] / path, cache)))
+                    result = searchPaths[i] / path;
             }
         }
-        return std::nullopt;
+        else
+        {
+            // ../ 开头等索引不覆盖的路径按原方式逐个查询
+            for (std::size_t i = 0; i < searchPaths.size() && !result; ++i)
+            {
+                auto fullPath = searchPaths[i] / path;
+                if (Exists(fullPath, cache))
+                    result = fullPath;
+            }
+        }
+
+        cache.resolved.emplace(path, result);
+        cache.requestsByKey[key].push_back(path);
+        return result;
     }
 
     bool EngineFileIO::SaveText(const std::string &path, const std::string &content)
@@ -109,6 +398,8 @@ namespace SoulEngine
         }
 
         file << content;
+        file.close();
+        NotifyFileChanged(fullPath, true);
         return true;
     }
 
@@ -138,13 +429,22 @@ namespace SoulEngine
     unsigned int EngineFileIO::GetFileSize(const std::string &path)
     {
         auto fullPath = FindResourcePath(path);
-        if (!fullPath.has_value() || !std::filesystem::exists(fullPath.value()))
+        if (!fullPath.has_value())
         {
-            Logger::Error("File does not exist: {}", fullPath.value().string());
+            if (PackHit hit = FindInPacks(path); hit.entry)
+                return static_cast<unsigned int>(hit.entry->size);
+            Logger::Error("File does not exist: {}", path);
             return 0;
         }
 
-        return static_cast<unsigned int>(std::filesystem::file_size(fullPath.value()));
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(fullPath.value(), ec);
+        if (ec)
+        {
+            Logger::Error("Failed to get size of file: {}", fullPath.value().string());
+            return 0;
+        }
+        return static_cast<unsigned int>(size);
     }
 
     std::string EngineFileIO::GetRelativePath(const std::string &path)
@@ -4,12 +4,17 @@
 #include <filesystem>
 #include <optional>
 #include "Define.h"
+#include "MappedFile.h"
 namespace SoulEngine
 {
 
     /**
      * @brief EngineFileIO 提供静态方法用于文件输入输出操作
      * 主要用于加载文本和二进制文件，检查文件是否存在等功能。
+     * 相对路径的解析结果会被缓存：每个搜索路径首次查找时递归建立一次目录索引，之后的查找不再访问文件系统。
+     * AddSearchPath/ClearSearchPaths 会清空缓存；文件在运行期增删时由文件监视器调用 NotifyFileChanged，
+     * 或手动调用 InvalidatePathCache。路径解析与加载函数可在多个线程中并发调用。
+     * MountPack 挂载的资源包位于搜索路径之后：同名的散文件优先（开发期覆盖），后挂载的包优先于先挂载的包。
      */
     class EngineFileIO
     {
@@ -19,23 +24,46 @@ namespace SoulEngine
         // 加载文本文件
         static std::string LoadText(const std::string &path);
 
-        // 加载二进制文件
+        // 加载二进制文件；失败时返回空，与空文件无法区分
         static std::vector<uint8_t> LoadBinary(const std::string &path);
+        // 同上，打开或读取失败时返回 false
+        static bool LoadBinary(const std::string &path, std::vector<uint8_t> &data);
+
+        // 只读映射文件，避免拷贝；找不到或映射失败时返回未打开的 MappedFile
+        static MappedFile MapFile(const std::string &path);
 
         // 检查文件是否存在
         static bool FileExists(const std::string &path);
 
-        // 解析文件路径，返回实际的文件路径
+        // 解析文件路径，返回实际的文件路径（只查散文件，不查资源包）
         static std::optional<std::filesystem::path> ResolveFilePath(const std::string &path);
 
         // 添加查找资源路径
         static void AddSearchPath(const std::string &path);
 
-        // 获取所有搜索路径
+        // 挂载资源包（.pak，由 AssetPacker 生成），条目名相对于搜索路径
+        static bool MountPack(const std::string &path);
+        static void UnmountPacks();
+
+        // 获取所有搜索路径（不加锁，不要与 AddSearchPath/ClearSearchPaths 并发调用）
         static const std::vector<std::filesystem::path> &GetSearchPaths();
         // 清除所有搜索路径
         static void ClearSearchPaths();
 
+        struct PathCacheStats
+        {
+            uint64_t hits = 0;           // 命中已解析的缓存
+            uint64_t misses = 0;         // 需要查索引的解析
+            uint64_t indexedFiles = 0;   // 所有已建立索引中的文件数
+            uint64_t statCalls = 0;      // 绝对路径、索引之外的路径等回退到文件系统查询的次数
+        };
+
+        // 丢弃所有解析结果与目录索引，下次查找时重建
+        static void InvalidatePathCache();
+        // 增量更新索引：file 被创建/修改（exists=true）或删除（exists=false），只丢弃该文件对应的解析结果
+        static void NotifyFileChanged(const std::filesystem::path &file, bool exists);
+        static PathCacheStats GetPathCacheStats();
+
         // 保存文本到文件
         static bool SaveText(const std::string &path, const std::string &content);
 
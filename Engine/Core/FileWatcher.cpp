@@ -0,0 +1,402 @@
+#include "FileWatcher.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include "Core/EngineFileIO.h"
+#include "Log/Logger.h"
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace SoulEngine
+{
+    namespace
+    {
+#if defined(__linux__)
+        // 只在写入完成（IN_CLOSE_WRITE）时报告修改，避免每次 write 都产生事件
+        constexpr uint32_t kWatchMask = IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                                        IN_ONLYDIR | IN_DONT_FOLLOW | IN_EXCL_UNLINK;
+#endif
+
+        std::filesystem::path NormalizeDirectory(const std::filesystem::path &directory)
+        {
+            std::filesystem::path normalized = std::filesystem::absolute(directory).lexically_normal();
+            if (!normalized.has_filename() && normalized.has_parent_path() && normalized != normalized.root_path())
+                normalized = normalized.parent_path();
+            return normalized;
+        }
+
+        // path 位于 root 之下（不含 root 本身）
+        bool IsUnder(const std::filesystem::path &path, const std::filesystem::path &root)
+        {
+            const std::string &p = path.native();
+            const std::string &r = root.native();
+            return p.size() > r.size() && p.compare(0, r.size(), r) == 0 && p[r.size()] == '/';
+        }
+
+        bool Covers(const std::filesystem::path &root, bool recursive, const std::filesystem::path &path)
+        {
+            return path.parent_path() == root || (recursive && IsUnder(path, root));
+        }
+
+        // 同一文件在合并窗口内的先后两次变化合并为一次；返回 false 表示两者抵消
+        bool Merge(FileAction previous, FileAction next, FileAction &merged)
+        {
+            if (previous == FileAction::Created && next == FileAction::Deleted)
+                return false;
+            if (previous == FileAction::Created)
+                merged = FileAction::Created;
+            else if (previous == FileAction::Deleted && next == FileAction::Created)
+                merged = FileAction::Modified;
+            else
+                merged = next;
+            return true;
+        }
+    }
+
+    bool FileWatcher::IsSupported()
+    {
+#if defined(__linux__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    FileWatcher::WatchId FileWatcher::Watch(const std::filesystem::path &directory, bool recursive, FileChangeCallback callback)
+    {
+#if defined(__linux__)
+        std::error_code ec;
+        if (!std::filesystem::is_directory(directory, ec))
+        {
+            Logger::Error("FileWatcher: {} is not a directory", directory.string());
+            return 0;
+        }
+        const std::filesystem::path root = NormalizeDirectory(directory);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_ && !Start())
+            return 0;
+        AddWatches(root, recursive, false);
+        const WatchId id = nextId_++;
+        subscriptions_[id] = { root, recursive, std::move(callback) };
+        return id;
+#else
+        (void)recursive;
+        (void)callback;
+        Logger::Warn("FileWatcher: not supported on this platform, {} is not watched", directory.string());
+        return 0;
+#endif
+    }
+
+    void FileWatcher::Unwatch(WatchId id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (subscriptions_.erase(id) == 0)
+            return;
+#if defined(__linux__)
+        // 移除不再被任何订阅覆盖的目录
+        for (auto it = watchDescriptors_.begin(); it != watchDescriptors_.end();)
+        {
+            const bool covered = std::any_of(subscriptions_.begin(), subscriptions_.end(), [&](const auto &entry) {
+                const Subscription &subscription = entry.second;
+                return it->first == subscription.root || (subscription.recursive && IsUnder(it->first, subscription.root));
+            });
+            if (covered)
+            {
+                ++it;
+                continue;
+            }
+            inotify_rm_watch(inotifyFd_, it->second);
+            watchPaths_.erase(it->second);
+            it = watchDescriptors_.erase(it);
+        }
+#endif
+    }
+
+    void FileWatcher::SetCoalesceDelay(std::chrono::milliseconds delay)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        coalesceDelay_ = delay;
+    }
+
+    void FileWatcher::Update()
+    {
+        std::vector<FileChangeEvent> ready;
+        std::vector<std::pair<WatchId, Subscription>> subscriptions;
+        bool overflowed = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (pending_.empty() && !overflowed_)
+                return;
+            const auto now = std::chrono::steady_clock::now();
+            for (auto it = pending_.begin(); it != pending_.end();)
+            {
+                if (now - it->second.lastChange < coalesceDelay_)
+                {
+                    ++it;
+                    continue;
+                }
+                ready.push_back({ it->first, it->second.action, it->second.isDirectory });
+                it = pending_.erase(it);
+            }
+            overflowed = overflowed_;
+            overflowed_ = false;
+            if (ready.empty() && !overflowed)
+                return;
+            stats_.delivered += ready.size();
+            subscriptions.assign(subscriptions_.begin(), subscriptions_.end());
+        }
+        std::sort(ready.begin(), ready.end(), [](const FileChangeEvent &a, const FileChangeEvent &b) { return a.path < b.path; });
+
+        // 先更新路径缓存，回调中的查找与加载即可看到变化；移动的目录不会逐个报告其中的文件，只能整体丢弃
+        bool directoryChanged = overflowed;
+        for (const FileChangeEvent &event : ready)
+        {
+            if (event.isDirectory)
+                directoryChanged = true;
+            else
+                EngineFileIO::NotifyFileChanged(event.path, event.action != FileAction::Deleted);
+        }
+        if (directoryChanged)
+            EngineFileIO::InvalidatePathCache();
+
+        for (const auto &[id, subscription] : subscriptions)
+        {
+            std::vector<FileChangeEvent> events;
+            if (overflowed)
+                events.push_back({ subscription.root, FileAction::Modified, true });
+            for (const FileChangeEvent &event : ready)
+            {
+                if (Covers(subscription.root, subscription.recursive, event.path))
+                    events.push_back(event);
+            }
+            if (events.empty() || !subscription.callback)
+                continue;
+            {
+                // 之前的回调可能已经取消了这个订阅
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (subscriptions_.count(id) == 0)
+                    continue;
+            }
+            subscription.callback(events);
+        }
+    }
+
+    void FileWatcher::Shutdown()
+    {
+#if defined(__linux__)
+        if (running_)
+        {
+            running_ = false;
+            const uint64_t wake = 1;
+            [[maybe_unused]] const ssize_t written = write(wakeFd_, &wake, sizeof(wake));
+            if (thread_.joinable())
+                thread_.join();
+            close(inotifyFd_);
+            close(wakeFd_);
+            inotifyFd_ = -1;
+            wakeFd_ = -1;
+        }
+#endif
+        std::lock_guard<std::mutex> lock(mutex_);
+        subscriptions_.clear();
+        watchPaths_.clear();
+        watchDescriptors_.clear();
+        pending_.clear();
+        overflowed_ = false;
+    }
+
+    FileWatcher::Stats FileWatcher::GetStats()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stats stats = stats_;
+        stats.watchedDirectories = static_cast<uint32_t>(watchDescriptors_.size());
+        return stats;
+    }
+
+    bool FileWatcher::Start()
+    {
+#if defined(__linux__)
+        inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (inotifyFd_ < 0 || wakeFd_ < 0)
+        {
+            Logger::Error("FileWatcher: failed to create inotify instance: {}", std::strerror(errno));
+            if (inotifyFd_ >= 0)
+                close(inotifyFd_);
+            if (wakeFd_ >= 0)
+                close(wakeFd_);
+            inotifyFd_ = wakeFd_ = -1;
+            return false;
+        }
+        running_ = true;
+        thread_ = std::thread(&FileWatcher::ThreadMain, this);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void FileWatcher::ThreadMain()
+    {
+#if defined(__linux__)
+        alignas(inotify_event) char buffer[64 * 1024];
+        while (running_)
+        {
+            pollfd fds[2] = { { inotifyFd_, POLLIN, 0 }, { wakeFd_, POLLIN, 0 } };
+            if (poll(fds, 2, -1) < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                Logger::Error("FileWatcher: poll failed: {}", std::strerror(errno));
+                break;
+            }
+            if (fds[1].revents != 0)
+                break;
+
+            for (;;)
+            {
+                const ssize_t size = read(inotifyFd_, buffer, sizeof(buffer));
+                if (size <= 0)
+                    break;
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (ssize_t offset = 0; offset < size;)
+                {
+                    const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+                    offset += sizeof(inotify_event) + event->len;
+                    ++stats_.rawEvents;
+
+                    if (event->mask & IN_Q_OVERFLOW)
+                    {
+                        Logger::Warn("FileWatcher: event queue overflowed, watched directories must be rescanned");
+                        overflowed_ = true;
+                        ++stats_.overflows;
+                        continue;
+                    }
+                    auto watch = watchPaths_.find(event->wd);
+                    if (watch == watchPaths_.end())
+                        continue;
+                    if (event->mask & IN_IGNORED)
+                    {
+                        // 目录被删除或移出了文件系统，内核已自动移除监视
+                        watchDescriptors_.erase(watch->second);
+                        watchPaths_.erase(watch);
+                        continue;
+                    }
+                    if (event->len == 0)
+                        continue;
+
+                    const std::filesystem::path path = watch->second / event->name;
+                    const bool isDirectory = (event->mask & IN_ISDIR) != 0;
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                    {
+                        Record(path, FileAction::Created, isDirectory);
+                        // 新目录中在加入监视之前就已创建的文件作为 Created 补报
+                        if (isDirectory && IsCovered(path, true))
+                            AddWatches(path, true, true);
+                    }
+                    else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                    {
+                        Record(path, FileAction::Deleted, isDirectory);
+                        // 移出的目录仍会以旧路径报告事件，主动移除
+                        if (isDirectory && (event->mask & IN_MOVED_FROM))
+                            RemoveWatches(path);
+                    }
+                    else if (event->mask & IN_CLOSE_WRITE)
+                    {
+                        Record(path, FileAction::Modified, false);
+                    }
+                }
+            }
+        }
+#endif
+    }
+
+    void FileWatcher::AddWatches(const std::filesystem::path &directory, bool recursive, bool reportExisting)
+    {
+#if defined(__linux__)
+        const int wd = inotify_add_watch(inotifyFd_, directory.c_str(), kWatchMask);
+        if (wd < 0)
+        {
+            // ENOSPC：超出 /proc/sys/fs/inotify/max_user_watches
+            Logger::Warn("FileWatcher: cannot watch {}: {}", directory.string(), std::strerror(errno));
+            return;
+        }
+        watchPaths_[wd] = directory;
+        watchDescriptors_[directory] = wd;
+        if (!recursive && !reportExisting)
+            return;
+
+        std::error_code ec;
+        for (const auto &entry : std::filesystem::directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied, ec))
+        {
+            if (entry.is_symlink(ec))
+                continue;
+            const bool isDirectory = entry.is_directory(ec);
+            if (reportExisting)
+                Record(entry.path(), FileAction::Created, isDirectory);
+            if (isDirectory && recursive)
+                AddWatches(entry.path(), true, reportExisting);
+        }
+#else
+        (void)directory;
+        (void)recursive;
+        (void)reportExisting;
+#endif
+    }
+
+    void FileWatcher::RemoveWatches(const std::filesystem::path &directory)
+    {
+#if defined(__linux__)
+        for (auto it = watchDescriptors_.lower_bound(directory); it != watchDescriptors_.end();)
+        {
+            if (it->first != directory && !IsUnder(it->first, directory))
+            {
+                ++it;
+                continue;
+            }
+            inotify_rm_watch(inotifyFd_, it->second);
+            watchPaths_.erase(it->second);
+            it = watchDescriptors_.erase(it);
+        }
+#else
+        (void)directory;
+#endif
+    }
+
+    bool FileWatcher::IsCovered(const std::filesystem::path &path, bool needRecursive) const
+    {
+        for (const auto &[id, subscription] : subscriptions_)
+        {
+            if (needRecursive ? subscription.recursive && IsUnder(path, subscription.root)
+                              : Covers(subscription.root, subscription.recursive, path))
+                return true;
+        }
+        return false;
+    }
+
+    void FileWatcher::Record(const std::filesystem::path &path, FileAction action, bool isDirectory)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        auto it = pending_.find(path.native());
+        if (it == pending_.end())
+        {
+            pending_.emplace(path.native(), PendingChange{ action, isDirectory, now });
+            return;
+        }
+        FileAction merged = action;
+        if (!Merge(it->second.action, action, merged))
+        {
+            pending_.erase(it);
+            return;
+        }
+        it->second.action = merged;
+        it->second.isDirectory = isDirectory;
+        it->second.lastChange = now;
+    }
+} // namespace SoulEngine
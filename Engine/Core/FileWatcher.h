@@ -0,0 +1,128 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Define.h"
+
+namespace SoulEngine
+{
+    enum class FileAction : uint8_t
+    {
+        Created,
+        Modified,
+        Deleted,
+    };
+
+    struct FileChangeEvent
+    {
+        std::filesystem::path path;         // 绝对路径
+        FileAction action = FileAction::Modified;
+        // 目录事件；目录被移入/移出时不会逐个报告其中的文件，监视溢出时以 Modified 报告监视根目录，
+        // 收到时应重新扫描该目录
+        bool isDirectory = false;
+    };
+
+    // 在主线程（FileWatcher::Update）调用，每次 Update 一批，按路径排序
+    using FileChangeCallback = std::function<void(const std::vector<FileChangeEvent> &events)>;
+
+    /**
+     * @brief 文件监视器 - 由操作系统推送目录变化，无需轮询扫描
+     *
+     * Linux 上使用 inotify：专用线程阻塞读取事件，递归监视时新建的子目录自动加入监视。
+     * 同一文件在合并窗口内的多次变化合并为一个事件（例如 Created + Modified -> Created，
+     * 保存时的 Deleted + Created -> Modified，临时文件的 Created + Deleted 被丢弃），
+     * 文件静默超过合并窗口后才在主线程的 Update 中交付，编辑器的分段写入因此只触发一次处理。
+     * 重命名覆盖已有文件（常见的原子保存方式）报告为 Created，使用方应把 Created 与 Modified 同等对待。
+     * 交付前先用事件更新 EngineFileIO 的路径缓存（NotifyFileChanged），回调中的加载已能看到新文件。
+     * 其他平台尚无实现，Watch 返回 0。
+     *
+     * 使用方式:
+     *   auto& watcher = FileWatcher::GetInstance();
+     *   FileWatcher::WatchId id = watcher.Watch("Assets", true, [](const std::vector<FileChangeEvent>& events) {
+     *       for (const FileChangeEvent& e : events) Reimport(e.path);
+     *   });
+     *   watcher.Update();                    // 每帧一次（Engine 主循环中调用）
+     *   watcher.Unwatch(id);
+     */
+    class FileWatcher
+    {
+        SINGLETON_CLASS(FileWatcher);
+
+    public:
+        using WatchId = uint32_t;
+
+        struct Stats
+        {
+            uint64_t rawEvents = 0;          // 从操作系统读到的事件
+            uint64_t delivered = 0;          // 合并后交付的事件
+            uint64_t overflows = 0;          // 事件队列溢出次数
+            uint32_t watchedDirectories = 0;
+        };
+
+        /**
+         * @brief 开始监视目录，首次调用时启动监视线程
+         * @param recursive 是否包含子目录（包括之后新建的）
+         * @return 监视 ID；目录不存在或平台不支持时返回 0
+         */
+        WatchId Watch(const std::filesystem::path &directory, bool recursive, FileChangeCallback callback);
+        void Unwatch(WatchId id);
+
+        // 同一文件最后一次变化后静默多久才交付，默认 100 ms
+        void SetCoalesceDelay(std::chrono::milliseconds delay);
+
+        // 交付已稳定的事件；只能在主线程调用
+        void Update();
+
+        // 停止监视线程并移除所有监视；未交付的事件被丢弃
+        void Shutdown();
+
+        static bool IsSupported();
+        Stats GetStats();
+
+    private:
+        struct Subscription
+        {
+            std::filesystem::path root;
+            bool recursive = false;
+            FileChangeCallback callback;
+        };
+
+        struct PendingChange
+        {
+            FileAction action = FileAction::Modified;
+            bool isDirectory = false;
+            std::chrono::steady_clock::time_point lastChange;
+        };
+
+        bool Start();
+        void ThreadMain();
+        // 以下调用方持有 mutex_
+        void AddWatches(const std::filesystem::path &directory, bool recursive, bool reportExisting);
+        void RemoveWatches(const std::filesystem::path &directory);
+        bool IsCovered(const std::filesystem::path &path, bool needRecursive) const;
+        void Record(const std::filesystem::path &path, FileAction action, bool isDirectory);
+
+        std::mutex mutex_;
+        std::map<WatchId, Subscription> subscriptions_;
+        WatchId nextId_ = 1;
+        std::unordered_map<int, std::filesystem::path> watchPaths_;     // inotify 监视描述符 -> 目录
+        std::map<std::filesystem::path, int> watchDescriptors_;         // 目录 -> 监视描述符
+        std::unordered_map<std::string, PendingChange> pending_;
+        bool overflowed_ = false;
+        std::chrono::milliseconds coalesceDelay_{ 100 };
+        Stats stats_;
+
+        std::thread thread_;
+        std::atomic<bool> running_{ false };
+        int inotifyFd_ = -1;
+        int wakeFd_ = -1;
+    };
+} // namespace SoulEngine
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace SoulEngine
+{
+    /**
+     * @brief 将 value 的哈希值合并到 seed 中（boost::hash_combine 风格）
+     */
+    template <class T>
+    inline void HashCombine(std::size_t &seed, const T &value)
+    {
+        seed ^= std::hash<T>{}(value) + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2);
+    }
+
+    /**
+     * @brief FNV-1a 64位哈希，适用于短小的键（名称、描述结构体等）
+     */
+    inline uint64_t HashFNV1a(const void *data, std::size_t size, uint64_t seed = 14695981039346656037ull)
+    {
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        uint64_t h = seed;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            h ^= bytes[i];
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    /**
+     * @brief XXH64 哈希（与 xxHash 的 XXH64 结果一致），每周期处理 32 字节，适用于文件内容等大块数据
+     */
+    uint64_t HashXXH64(const void *data, std::size_t size, uint64_t seed = 0);
+} // namespace SoulEngine
@@ -0,0 +1,179 @@
+#include "JobSystem.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+
+namespace SoulEngine
+{
+    namespace
+    {
+        thread_local bool t_isWorker = false;
+    }
+
+    void JobSystem::Initialize(uint32_t workerCount)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_)
+            return;
+
+        if (workerCount == 0)
+        {
+            const uint32_t hw = std::thread::hardware_concurrency();
+            workerCount = hw > 1 ? hw - 1 : 1;
+        }
+
+        // 单例析构时线程必须已回收，注册退出钩子兜底（未走 Engine::Shutdown 的无头程序）
+        static bool exitHookRegistered = false;
+        if (!exitHookRegistered)
+        {
+            // 此时日志系统可能已析构，只回收线程不打印
+            std::atexit([] { JobSystem::GetInstance().StopWorkers(); });
+            exitHookRegistered = true;
+        }
+
+        running_ = true;
+        workers_.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i)
+            workers_.emplace_back([this] { WorkerLoop(); });
+        Logger::Log("JobSystem started with {} worker threads", workerCount);
+    }
+
+    void JobSystem::Shutdown()
+    {
+        if (StopWorkers())
+            Logger::Log("JobSystem shutdown");
+    }
+
+    bool JobSystem::StopWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_)
+                return false;
+            running_ = false;
+        }
+        cv_.notify_all();
+        for (auto &t : workers_)
+        {
+            if (t.joinable())
+                t.join();
+        }
+        workers_.clear();
+        return true;
+    }
+
+    uint32_t JobSystem::GetWorkerCount()
+    {
+        EnsureStarted();
+        std::lock_guard<std::mutex> lock(mutex_);
+        return static_cast<uint32_t>(workers_.size());
+    }
+
+    bool JobSystem::IsWorkerThread()
+    {
+        return t_isWorker;
+    }
+
+    void JobSystem::EnsureStarted()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (running_)
+                return;
+        }
+        Initialize();
+    }
+
+    void JobSystem::Enqueue(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(std::move(job));
+        }
+        cv_.notify_one();
+    }
+
+    std::future<void> JobSystem::Submit(std::function<void()> job)
+    {
+        EnsureStarted();
+        auto task = std::make_shared<std::packaged_task<void()>>(std::move(job));
+        std::future<void> future = task->get_future();
+        Enqueue([task] { (*task)(); });
+        return future;
+    }
+
+    void JobSystem::ParallelFor(uint32_t count, uint32_t grain, const std::function<void(uint32_t, uint32_t)> &fn)
+    {
+        if (count == 0)
+            return;
+        grain = std::max<uint32_t>(grain, 1);
+        const uint32_t chunkCount = (count + grain - 1) / grain;
+        if (chunkCount == 1)
+        {
+            fn(0, count);
+            return;
+        }
+
+        EnsureStarted();
+
+        // 共享状态放在堆上：迟到的辅助任务可能在 ParallelFor 返回后才被调度
+        struct State
+        {
+            std::atomic<uint32_t> next{0};
+            std::atomic<uint32_t> done{0};
+            std::mutex mutex;
+            std::condition_variable cv;
+        };
+        auto state = std::make_shared<State>();
+
+        auto runChunks = [state, count, grain, chunkCount, &fn]()
+        {
+            uint32_t chunk;
+            while ((chunk = state->next.fetch_add(1)) < chunkCount)
+            {
+                const uint32_t begin = chunk * grain;
+                fn(begin, std::min(begin + grain, count));
+                if (state->done.fetch_add(1) + 1 == chunkCount)
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->cv.notify_all();
+                }
+            }
+        };
+
+        const uint32_t helpers = std::min<uint32_t>(chunkCount - 1, static_cast<uint32_t>(workers_.size()));
+        for (uint32_t i = 0; i < helpers; ++i)
+        {
+            // 辅助任务只捕获共享状态；fn 引用仅在仍有未领取的块时才会被使用
+            Enqueue([state, chunkCount, runChunks]
+                    {
+                        if (state->next.load() < chunkCount)
+                            runChunks();
+                    });
+        }
+
+        runChunks();
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->cv.wait(lock, [&] { return state->done.load() == chunkCount; });
+    }
+
+    void JobSystem::WorkerLoop()
+    {
+        t_isWorker = true;
+        for (;;)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return !running_ || !queue_.empty(); });
+                if (queue_.empty())
+                    return; // 已停止且队列为空
+                job = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            job();
+        }
+    }
+} // namespace SoulEngine
@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Define.h"
+
+namespace SoulEngine
+{
+    /**
+     * @brief 引擎任务系统 - 固定数量的工作线程 + FIFO 任务队列
+     *
+     * ParallelFor 会让调用线程也参与执行，因此可以在工作线程内部嵌套调用而不会死锁。
+     * 未显式 Initialize 时会在第一次提交任务时按默认线程数启动。
+     */
+    class JobSystem
+    {
+        SINGLETON_CLASS(JobSystem);
+
+    public:
+        /**
+         * @brief 启动工作线程
+         * @param workerCount 工作线程数量，0 表示 hardware_concurrency - 1（至少 1 个）
+         */
+        void Initialize(uint32_t workerCount = 0);
+
+        /**
+         * @brief 等待队列清空并回收所有工作线程
+         */
+        void Shutdown();
+
+        uint32_t GetWorkerCount();
+
+        /**
+         * @brief 提交单个异步任务
+         */
+        std::future<void> Submit(std::function<void()> job);
+
+        /**
+         * @brief 将 [0, count) 按 grain 大小切块并行执行，返回前所有块均已完成
+         * @param fn 以 (begin, end) 形式接收一个块
+         */
+        void ParallelFor(uint32_t count, uint32_t grain, const std::function<void(uint32_t begin, uint32_t end)> &fn);
+
+        /**
+         * @brief 当前线程是否为任务系统的工作线程
+         */
+        static bool IsWorkerThread();
+
+    private:
+        void EnsureStarted();
+        bool StopWorkers();
+        void Enqueue(std::function<void()> job);
+        void WorkerLoop();
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque<std::function<void()>> queue_;
+        std::vector<std::thread> workers_;
+        bool running_ = false;
+    };
+} // namespace SoulEngine
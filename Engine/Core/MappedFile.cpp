@@ -0,0 +1,153 @@
+#include "MappedFile.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SoulEngine
+{
+    MappedFile::MappedFile(const std::filesystem::path &path)
+    {
+#if defined(_WIN32)
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            Logger::Error("MappedFile: failed to open {}", path.string());
+            return;
+        }
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size))
+        {
+            Logger::Error("MappedFile: failed to query size of {}", path.string());
+            CloseHandle(file);
+            return;
+        }
+        if (size.QuadPart > 0)
+        {
+            // 映射对象持有文件引用，文件句柄可以立即关闭
+            mapping_ = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            void *view = mapping_ ? MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if (!view)
+            {
+                Logger::Error("MappedFile: failed to map {}", path.string());
+                if (mapping_)
+                    CloseHandle(mapping_);
+                mapping_ = nullptr;
+                CloseHandle(file);
+                return;
+            }
+            data_ = static_cast<const uint8_t *>(view);
+            size_ = static_cast<std::size_t>(size.QuadPart);
+        }
+        CloseHandle(file);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            Logger::Error("MappedFile: failed to open {}", path.string());
+            return;
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0)
+        {
+            Logger::Error("MappedFile: failed to stat {}", path.string());
+            ::close(fd);
+            return;
+        }
+        if (st.st_size > 0)
+        {
+            // 映射持有文件引用，描述符可以立即关闭
+            void *view = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view == MAP_FAILED)
+            {
+                Logger::Error("MappedFile: failed to map {}", path.string());
+                ::close(fd);
+                return;
+            }
+            data_ = static_cast<const uint8_t *>(view);
+            size_ = static_cast<std::size_t>(st.st_size);
+        }
+        ::close(fd);
+#endif
+        open_ = true;
+    }
+
+    MappedFile MappedFile::FromView(std::shared_ptr<const void> owner, const uint8_t *data, std::size_t size)
+    {
+        MappedFile view;
+        view.owner_ = std::move(owner);
+        view.data_ = data;
+        view.size_ = size;
+        view.open_ = true;
+        return view;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(open_, other.open_);
+            std::swap(owner_, other.owner_);
+#if defined(_WIN32)
+            std::swap(mapping_, other.mapping_);
+#endif
+        }
+        return *this;
+    }
+
+    std::string_view MappedFile::GetView(std::size_t offset, std::size_t size) const
+    {
+        if (offset >= size_)
+            return {};
+        return std::string_view(reinterpret_cast<const char *>(data_) + offset, std::min(size, size_ - offset));
+    }
+
+    void MappedFile::Close()
+    {
+        if (owner_)
+        {
+            owner_.reset();
+        }
+        else if (data_)
+        {
+#if defined(_WIN32)
+            UnmapViewOfFile(data_);
+#else
+            ::munmap(const_cast<uint8_t *>(data_), size_);
+#endif
+        }
+#if defined(_WIN32)
+        if (mapping_)
+            CloseHandle(mapping_);
+        mapping_ = nullptr;
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        open_ = false;
+    }
+} // namespace SoulEngine
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+namespace SoulEngine
+{
+    /**
+     * @brief 只读内存映射文件（RAII）
+     * Linux 上使用 mmap，Windows 上使用 CreateFileMapping；析构时解除映射。
+     * 空文件视为打开成功但 Size() 为 0、Data() 为空。可移动、不可拷贝。
+     * 也可以是其他内存的视图（FromView），例如包文件中未压缩的条目，由 owner 维持底层内存的生命周期。
+     *
+     * 使用方式:
+     *   MappedFile file = EngineFileIO::MapFile("Textures/albedo.stex");
+     *   if (file.IsOpen())
+     *       Parse(file.Data(), file.Size());          // 视图在 file 存活期间有效
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::filesystem::path &path);
+        ~MappedFile();
+
+        // 不拥有映射的视图；owner 在视图存活期间保持 data 有效
+        static MappedFile FromView(std::shared_ptr<const void> owner, const uint8_t *data, std::size_t size);
+
+        MappedFile(MappedFile &&other) noexcept;
+        MappedFile &operator=(MappedFile &&other) noexcept;
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        bool IsOpen() const { return open_; }
+        explicit operator bool() const { return open_; }
+
+        const uint8_t *Data() const { return data_; }
+        std::size_t Size() const { return size_; }
+        const uint8_t *begin() const { return data_; }
+        const uint8_t *end() const { return data_ + size_; }
+
+        // 子区间视图，越界部分被截断
+        std::string_view GetView(std::size_t offset = 0, std::size_t size = SIZE_MAX) const;
+
+        void Close();
+
+    private:
+        const uint8_t *data_ = nullptr;
+        std::size_t size_ = 0;
+        bool open_ = false;
+        std::shared_ptr<const void> owner_;
+#if defined(_WIN32)
+        void *mapping_ = nullptr;
+#endif
+    };
+} // namespace SoulEngine
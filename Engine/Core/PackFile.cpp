@@ -0,0 +1,306 @@
+#include "PackFile.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include "BlockCompression.h"
+#include "Hash.h"
+#include "JobSystem.h"
+#include "Log/Logger.h"
+
+namespace SoulEngine
+{
+    namespace
+    {
+        double ElapsedMs(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        uint64_t HashName(std::string_view name)
+        {
+            return HashFNV1a(name.data(), name.size());
+        }
+
+        uint64_t AlignUp(uint64_t value, uint64_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        void WritePadding(std::ofstream &out, uint64_t &position, uint64_t alignment)
+        {
+            static const char zeros[4096] = {};
+            uint64_t padding = AlignUp(position, alignment) - position;
+            position += padding;
+            while (padding > 0)
+            {
+                const uint64_t chunk = std::min<uint64_t>(padding, sizeof(zeros));
+                out.write(zeros, static_cast<std::streamsize>(chunk));
+                padding -= chunk;
+            }
+        }
+    }
+
+    PackArchive::PackArchive(std::filesystem::path path, MappedFile file)
+        : path_(std::move(path)), file_(std::move(file))
+    {
+    }
+
+    std::shared_ptr<PackArchive> PackArchive::Open(const std::filesystem::path &path)
+    {
+        MappedFile file(path);
+        if (!file.IsOpen())
+            return nullptr;
+        auto archive = std::make_shared<PackArchive>(path, std::move(file));
+        if (!archive->Bind())
+        {
+            Logger::Error("PackArchive: {} is not a valid pack file", path.string());
+            return nullptr;
+        }
+        return archive;
+    }
+
+    bool PackArchive::Bind()
+    {
+        const uint64_t fileSize = file_.Size();
+        if (fileSize < sizeof(PackHeader))
+            return false;
+        header_ = reinterpret_cast<const PackHeader *>(file_.Data());
+        if (std::memcmp(header_->magic, kPackMagic, sizeof(kPackMagic)) != 0 || header_->version != kPackVersion)
+            return false;
+        if (header_->tocOffset % alignof(PackEntry) != 0 || header_->tocOffset > fileSize ||
+            uint64_t(header_->entryCount) * sizeof(PackEntry) > fileSize - header_->tocOffset ||
+            header_->namesOffset > fileSize || header_->namesSize > fileSize - header_->namesOffset)
+            return false;
+        entries_ = reinterpret_cast<const PackEntry *>(file_.Data() + header_->tocOffset);
+        names_ = reinterpret_cast<const char *>(file_.Data() + header_->namesOffset);
+
+        for (uint32_t i = 0; i < header_->entryCount; ++i)
+        {
+            const PackEntry &e = entries_[i];
+            if (e.offset > fileSize || e.storedSize > fileSize - e.offset ||
+                uint64_t(e.nameOffset) + e.nameLength > header_->namesSize)
+                return false;
+            if (!(e.flags & PackEntryCompressed) && e.storedSize != e.size)
+                return false;
+        }
+        return true;
+    }
+
+    std::string PackArchive::NormalizeName(std::string_view name)
+    {
+        std::string normalized = std::filesystem::path(name).lexically_normal().generic_string();
+        std::transform(normalized.begin(), normalized.end(), normalized.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return normalized;
+    }
+
+    const PackEntry *PackArchive::Find(std::string_view name) const
+    {
+        const std::string key = NormalizeName(name);
+        const uint64_t hash = HashName(key);
+        const PackEntry *end = entries_ + header_->entryCount;
+        const PackEntry *it = std::lower_bound(entries_, end, hash, [](const PackEntry &e, uint64_t h) { return e.pathHash < h; });
+        for (; it != end && it->pathHash == hash; ++it)
+        {
+            if (GetEntryName(*it) == key)
+                return it;
+        }
+        return nullptr;
+    }
+
+    std::string_view PackArchive::GetEntryName(const PackEntry &entry) const
+    {
+        return std::string_view(names_ + entry.nameOffset, entry.nameLength);
+    }
+
+    MappedFile PackArchive::OpenEntry(const PackEntry &entry) const
+    {
+        if (!(entry.flags & PackEntryCompressed))
+            return MappedFile::FromView(shared_from_this(), file_.Data() + entry.offset, static_cast<std::size_t>(entry.size));
+
+        auto buffer = std::make_shared<std::vector<uint8_t>>();
+        if (!ReadEntry(entry, *buffer))
+            return {};
+        const uint8_t *data = buffer->data();
+        const std::size_t size = buffer->size();
+        return MappedFile::FromView(std::move(buffer), data, size);
+    }
+
+    bool PackArchive::ReadEntry(const PackEntry &entry, std::vector<uint8_t> &out) const
+    {
+        out.resize(static_cast<std::size_t>(entry.size));
+        const uint8_t *src = file_.Data() + entry.offset;
+        if (!(entry.flags & PackEntryCompressed))
+        {
+            if (!out.empty())
+                std::memcpy(out.data(), src, out.size());
+            return true;
+        }
+        if (!BlockCompression::Decompress(src, static_cast<std::size_t>(entry.storedSize), out.data(), out.size()))
+        {
+            Logger::Error("PackArchive: corrupt entry {} in {}", GetEntryName(entry), path_.string());
+            out.clear();
+            return false;
+        }
+        return true;
+    }
+
+    void PackWriter::AddDirectory(const std::filesystem::path &root)
+    {
+        std::error_code ec;
+        auto it = std::filesystem::recursive_directory_iterator(root, std::filesystem::directory_options::skip_permission_denied, ec);
+        for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+        {
+            std::error_code typeEc;
+            if (it->is_regular_file(typeEc))
+                AddFile(it->path().lexically_relative(root).generic_string(), it->path());
+        }
+    }
+
+    void PackWriter::AddFile(const std::string &name, const std::filesystem::path &source)
+    {
+        items_.push_back({PackArchive::NormalizeName(name), source, {}});
+    }
+
+    void PackWriter::AddData(const std::string &name, std::vector<uint8_t> data)
+    {
+        items_.push_back({PackArchive::NormalizeName(name), {}, std::move(data)});
+    }
+
+    bool PackWriter::Write(const std::filesystem::path &output, const PackWriterSettings &settings, PackWriterStats *stats)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const uint64_t alignment = std::max<uint32_t>(settings.alignment, 1);
+        if ((alignment & (alignment - 1)) != 0)
+        {
+            Logger::Error("PackWriter: alignment {} is not a power of two", alignment);
+            return false;
+        }
+
+        // 目录表顺序：哈希、名称；重名时保留最后加入的
+        std::stable_sort(items_.begin(), items_.end(), [](const Item &a, const Item &b) {
+            const uint64_t ha = HashName(a.name), hb = HashName(b.name);
+            return ha != hb ? ha < hb : a.name < b.name;
+        });
+        for (std::size_t i = 0; i + 1 < items_.size();)
+        {
+            if (items_[i].name == items_[i + 1].name)
+            {
+                Logger::Warn("PackWriter: duplicate entry {}, keeping the last one", items_[i].name);
+                items_.erase(items_.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+            else
+                ++i;
+        }
+
+        // 并行读取与压缩
+        std::vector<PackEntry> entries(items_.size());
+        std::vector<std::vector<uint8_t>> stored(items_.size());
+        std::vector<uint8_t> failed(items_.size(), 0);
+        JobSystem::GetInstance().ParallelFor(static_cast<uint32_t>(items_.size()), 4, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                Item &item = items_[i];
+                std::vector<uint8_t> data;
+                if (!item.source.empty())
+                {
+                    MappedFile file(item.source);
+                    if (!file.IsOpen())
+                    {
+                        failed[i] = 1;
+                        continue;
+                    }
+                    data.assign(file.begin(), file.end());
+                }
+                else
+                {
+                    data = item.data;
+                }
+
+                PackEntry &e = entries[i];
+                e.pathHash = HashName(item.name);
+                e.size = data.size();
+                if (settings.compress && data.size() >= settings.minCompressSize)
+                {
+                    std::vector<uint8_t> packed(BlockCompression::CompressBound(data.size()));
+                    const std::size_t packedSize = BlockCompression::Compress(data.data(), data.size(), packed.data(), packed.size());
+                    if (packedSize > 0 && packedSize < data.size() * settings.maxCompressedRatio)
+                    {
+                        packed.resize(packedSize);
+                        stored[i] = std::move(packed);
+                        e.flags |= PackEntryCompressed;
+                        continue;
+                    }
+                }
+                stored[i] = std::move(data);
+            }
+        });
+        for (std::size_t i = 0; i < items_.size(); ++i)
+        {
+            if (failed[i])
+            {
+                Logger::Error("PackWriter: cannot read {}", items_[i].source.string());
+                return false;
+            }
+        }
+
+        std::ofstream out(output, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            Logger::Error("PackWriter: cannot create {}", output.string());
+            return false;
+        }
+
+        PackHeader header;
+        header.entryCount = static_cast<uint32_t>(entries.size());
+        header.alignment = static_cast<uint32_t>(alignment);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        uint64_t position = sizeof(header);
+
+        std::string names;
+        PackWriterStats result;
+        for (std::size_t i = 0; i < entries.size(); ++i)
+        {
+            WritePadding(out, position, alignment);
+            PackEntry &e = entries[i];
+            e.offset = position;
+            e.storedSize = stored[i].size();
+            e.nameOffset = static_cast<uint32_t>(names.size());
+            e.nameLength = static_cast<uint32_t>(items_[i].name.size());
+            names += items_[i].name;
+            out.write(reinterpret_cast<const char *>(stored[i].data()), static_cast<std::streamsize>(stored[i].size()));
+            position += stored[i].size();
+
+            result.inputBytes += e.size;
+            result.compressedEntries += (e.flags & PackEntryCompressed) ? 1 : 0;
+            std::vector<uint8_t>().swap(stored[i]);
+        }
+
+        WritePadding(out, position, alignof(PackEntry));
+        header.tocOffset = position;
+        out.write(reinterpret_cast<const char *>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(PackEntry)));
+        position += entries.size() * sizeof(PackEntry);
+        header.namesOffset = position;
+        header.namesSize = names.size();
+        out.write(names.data(), static_cast<std::streamsize>(names.size()));
+        position += names.size();
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.close();
+        if (!out)
+        {
+            Logger::Error("PackWriter: failed writing {}", output.string());
+            return false;
+        }
+
+        result.entries = header.entryCount;
+        result.outputBytes = position;
+        result.ms = ElapsedMs(start);
+        if (stats)
+            *stats = result;
+        return true;
+    }
+} // namespace SoulEngine
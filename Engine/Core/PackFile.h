@@ -0,0 +1,137 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "MappedFile.h"
+
+namespace SoulEngine
+{
+    // 包文件布局（小端）：PackHeader | 条目数据（按 alignment 对齐） | PackEntry[entryCount]（按 pathHash、名称排序） | 名称表
+    constexpr char kPackMagic[4] = {'S', 'P', 'A', 'K'};
+    constexpr uint32_t kPackVersion = 1;
+
+    struct PackHeader
+    {
+        char magic[4] = {'S', 'P', 'A', 'K'};
+        uint32_t version = kPackVersion;
+        uint32_t entryCount = 0;
+        uint32_t alignment = 16;
+        uint64_t tocOffset = 0;
+        uint64_t namesOffset = 0;
+        uint64_t namesSize = 0;
+        uint64_t reserved = 0;
+    };
+    static_assert(sizeof(PackHeader) == 48, "PackHeader layout is part of the file format");
+
+    enum PackEntryFlags : uint32_t
+    {
+        PackEntryCompressed = 1u << 0, // BlockCompression
+    };
+
+    struct PackEntry
+    {
+        uint64_t pathHash = 0;         // HashFNV1a(规范化名称)
+        uint64_t offset = 0;
+        uint64_t storedSize = 0;
+        uint64_t size = 0;             // 解压后大小
+        uint32_t nameOffset = 0;       // 名称表内偏移，不含结尾 0
+        uint32_t nameLength = 0;
+        uint32_t flags = 0;
+        uint32_t reserved = 0;
+    };
+    static_assert(sizeof(PackEntry) == 48, "PackEntry layout is part of the file format");
+
+    /**
+     * @brief 只读资源包
+     * 整个文件被内存映射，目录表直接在映射内存上二分查找；未压缩的条目以零拷贝视图返回，压缩条目解压到独立缓冲。
+     * 名称为相对于打包根目录的路径，查找时规范化为小写、'/' 分隔（NormalizeName）。
+     *
+     * 使用方式:
+     *   auto pack = PackArchive::Open("Assets.pak");
+     *   if (const PackEntry *e = pack->Find("Texture/FireAnim/Fire001.bmp"))
+     *       MappedFile data = pack->OpenEntry(*e);      // 通常经由 EngineFileIO::MountPack 间接使用
+     */
+    class PackArchive : public std::enable_shared_from_this<PackArchive>
+    {
+    public:
+        static std::shared_ptr<PackArchive> Open(const std::filesystem::path &path);
+
+        static std::string NormalizeName(std::string_view name);
+
+        const PackEntry *Find(std::string_view name) const;
+
+        // 未压缩条目返回指向包映射的视图（视图持有包的引用），压缩条目返回解压后的缓冲
+        MappedFile OpenEntry(const PackEntry &entry) const;
+        bool ReadEntry(const PackEntry &entry, std::vector<uint8_t> &out) const;
+
+        uint32_t GetEntryCount() const { return header_->entryCount; }
+        const PackEntry &GetEntry(uint32_t index) const { return entries_[index]; }
+        std::string_view GetEntryName(const PackEntry &entry) const;
+        const std::filesystem::path &GetPath() const { return path_; }
+
+        // 只供 Open 经由 make_shared 使用
+        PackArchive(std::filesystem::path path, MappedFile file);
+
+    private:
+        // 定位头、目录表与名称表并检查所有区间都在文件内
+        bool Bind();
+
+        std::filesystem::path path_;
+        MappedFile file_;
+        const PackHeader *header_ = nullptr;
+        const PackEntry *entries_ = nullptr;
+        const char *names_ = nullptr;
+    };
+
+    struct PackWriterSettings
+    {
+        uint32_t alignment = 16;          // 条目起始对齐，2 的幂
+        bool compress = true;
+        float maxCompressedRatio = 0.9f;  // 压缩后不小于原大小的这个比例时按原样存储
+        std::size_t minCompressSize = 256;
+    };
+
+    struct PackWriterStats
+    {
+        uint32_t entries = 0;
+        uint32_t compressedEntries = 0;
+        uint64_t inputBytes = 0;
+        uint64_t outputBytes = 0;
+        double ms = 0.0;
+    };
+
+    /**
+     * @brief 资源包构建器，供打包工具使用
+     * 条目在任务系统上并行读取与压缩，随后按目录表顺序写出。
+     *
+     * 使用方式:
+     *   PackWriter writer;
+     *   writer.AddDirectory("Resources");
+     *   writer.Write("Assets.pak", {}, &stats);
+     */
+    class PackWriter
+    {
+    public:
+        // 名称相对 root，递归加入所有常规文件
+        void AddDirectory(const std::filesystem::path &root);
+        void AddFile(const std::string &name, const std::filesystem::path &source);
+        void AddData(const std::string &name, std::vector<uint8_t> data);
+
+        std::size_t GetEntryCount() const { return items_.size(); }
+
+        bool Write(const std::filesystem::path &output, const PackWriterSettings &settings = {}, PackWriterStats *stats = nullptr);
+
+    private:
+        struct Item
+        {
+            std::string name;                 // 规范化后的名称
+            std::filesystem::path source;     // 为空时使用 data
+            std::vector<uint8_t> data;
+        };
+
+        std::vector<Item> items_;
+    };
+} // namespace SoulEngine
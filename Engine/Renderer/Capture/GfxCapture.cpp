@@ -0,0 +1,1019 @@
+#include "Renderer/Capture/GfxCapture.h"
+#include "Renderer/Capture/GfxCaptureFormat.h"
+#include "Renderer/Renderer.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+
+namespace SoulEngine::Gfx
+{
+    class CaptureResource;
+
+    struct GfxCaptureState
+    {
+        GfxCaptureWriter writer;
+        std::map<uint32_t, CaptureResource*> live;      // ordered by id, i.e. creation order
+        uint32_t nextId = 1;
+        uint32_t framesCaptured = 0;
+        uint32_t frameLimit = 0;
+        bool capturing = false;
+
+        GfxCaptureWriter* Recording() { return capturing ? &writer : nullptr; }
+    };
+
+    namespace
+    {
+        // Number of floats a uniform of this type carries; ints are stored separately
+        uint32_t GetUniformFloatCount(UniformType type)
+        {
+            switch (type)
+            {
+            case UniformType::Float: return 1;
+            case UniformType::Vec2:  return 2;
+            case UniformType::Vec3:  return 3;
+            case UniformType::Vec4:  return 4;
+            case UniformType::Mat4:  return 16;
+            default: return 0;
+            }
+        }
+
+        struct UniformValue
+        {
+            UniformType type = UniformType::Unknown;
+            bool transpose = false;
+            int32_t i = 0;
+            float f[16] = {};
+        };
+
+        UniformValue MakeUniform(UniformType type, const float* values, bool transpose = false)
+        {
+            UniformValue value;
+            value.type = type;
+            value.transpose = transpose;
+            if (values)
+                std::memcpy(value.f, values, sizeof(float) * GetUniformFloatCount(type));
+            return value;
+        }
+
+        UniformValue MakeUniform(int v)
+        {
+            UniformValue value;
+            value.type = UniformType::Int;
+            value.i = v;
+            return value;
+        }
+
+        void PutUniform(GfxCaptureWriter& w, const UniformValue& value)
+        {
+            w.Put(static_cast<uint8_t>(value.type));
+            w.Put(static_cast<uint8_t>(value.transpose));
+            if (value.type == UniformType::Int)
+                w.Put(value.i);
+            else
+                w.PutBytes(value.f, sizeof(float) * GetUniformFloatCount(value.type));
+        }
+    }
+
+    // Base of every recorded object: owns the capture id and emits Destroy while recording
+    class CaptureResource
+    {
+    public:
+        explicit CaptureResource(std::shared_ptr<GfxCaptureState> state)
+            : state_(std::move(state)), id_(state_->nextId++)
+        {
+            state_->live[id_] = this;
+        }
+
+        virtual ~CaptureResource()
+        {
+            state_->live.erase(id_);
+            if (GfxCaptureWriter* w = state_->Recording())
+            {
+                w->Begin(GfxCaptureOp::Destroy);
+                w->Put(id_);
+                w->End();
+            }
+        }
+
+        CaptureResource(const CaptureResource&) = delete;
+        CaptureResource& operator=(const CaptureResource&) = delete;
+
+        uint32_t GetCaptureId() const { return id_; }
+
+        // Creation record(s) reproducing the current state; also used to snapshot live objects at Start
+        virtual void WriteCreate(GfxCaptureWriter& w) const = 0;
+
+    protected:
+        void RecordCreate() const
+        {
+            if (GfxCaptureWriter* w = state_->Recording())
+                WriteCreate(*w);
+        }
+
+        std::shared_ptr<GfxCaptureState> state_;
+        uint32_t id_ = 0;
+    };
+
+    class CaptureBuffer final : public IBuffer, public CaptureResource
+    {
+    public:
+        CaptureBuffer(std::shared_ptr<GfxCaptureState> state, std::shared_ptr<IBuffer> inner, const BufferDesc& desc, const SubresourceData* initial)
+            : CaptureResource(std::move(state)), inner_(std::move(inner)), desc_(desc), shadow_(desc.size, 0)
+        {
+            name_ = desc.name ? desc.name : "";
+            desc_.name = desc.name ? name_.c_str() : nullptr;
+            if (initial && initial->data && initial->offset < shadow_.size())
+            {
+                const std::size_t size = std::min(initial->size ? initial->size : desc_.size, shadow_.size() - initial->offset);
+                std::memcpy(shadow_.data() + initial->offset, initial->data, size);
+            }
+            RecordCreate();
+        }
+
+        const BufferDesc& GetDesc() const override { return desc_; }
+
+        void Update(const SubresourceData& src) override
+        {
+            inner_->Update(src);
+            if (!src.data)
+                return;
+            const std::size_t size = src.size ? src.size : desc_.size;
+            if (src.offset + size > shadow_.size())
+                return;
+            std::memcpy(shadow_.data() + src.offset, src.data, size);
+            RecordUpdate(src.offset, size);
+        }
+
+        // Writes go to a CPU staging copy so Unmap can diff them against the shadow and record only what changed
+        void* Map(MapMode mode) override
+        {
+            mapMode_ = mode;
+            if (mode == MapMode::Read)
+                return inner_->Map(mode);
+            staging_ = shadow_;
+            return staging_.data();
+        }
+
+        void Unmap() override
+        {
+            if (mapMode_ == MapMode::Read)
+            {
+                inner_->Unmap();
+                return;
+            }
+
+            const std::size_t size = shadow_.size();
+            std::size_t first = 0;
+            while (first < size && staging_[first] == shadow_[first])
+                ++first;
+            std::size_t last = size;
+            while (last > first && staging_[last - 1] == shadow_[last - 1])
+                --last;
+
+            // Discard invalidates the whole buffer, other modes only need the changed bytes
+            const std::size_t copyBegin = mapMode_ == MapMode::WriteDiscard ? 0 : first;
+            const std::size_t copyEnd = mapMode_ == MapMode::WriteDiscard ? size : last;
+            if (copyEnd > copyBegin)
+            {
+                if (auto* dst = static_cast<uint8_t*>(inner_->Map(mapMode_)))
+                {
+                    std::memcpy(dst + copyBegin, staging_.data() + copyBegin, copyEnd - copyBegin);
+                    inner_->Unmap();
+                }
+                else
+                {
+                    inner_->Update({ staging_.data() + copyBegin, copyEnd - copyBegin, copyBegin });
+                }
+            }
+            if (last > first)
+            {
+                std::memcpy(shadow_.data() + first, staging_.data() + first, last - first);
+                RecordUpdate(first, last - first);
+            }
+        }
+
+        IBuffer* GetInner() const { return inner_.get(); }
+
+        void WriteCreate(GfxCaptureWriter& w) const override
+        {
+            w.Begin(GfxCaptureOp::CreateBuffer);
+            w.Put(id_);
+            w.Put<uint64_t>(desc_.size);
+            w.Put(static_cast<uint8_t>(desc_.kind));
+            w.Put(static_cast<uint8_t>(desc_.usage));
+            w.Put(static_cast<uint32_t>(desc_.bindFlags));
+            w.Put(static_cast<uint8_t>(desc_.cpuAccess));
+            w.Put<uint64_t>(desc_.stride);
+            w.Put(static_cast<uint8_t>(desc_.indexFormat));
+            w.PutString(desc_.name);
+            w.PutBlob(shadow_.data(), shadow_.size());
+            w.End();
+        }
+
+    private:
+        void RecordUpdate(std::size_t offset, std::size_t size) const
+        {
+            if (GfxCaptureWriter* w = state_->Recording())
+            {
+                w->Begin(GfxCaptureOp::BufferUpdate);
+                w->Put(id_);
+                w->Put<uint64_t>(offset);
+                w->PutBlob(shadow_.data() + offset, size);
+                w->End();
+            }
+        }
+
+        std::shared_ptr<IBuffer> inner_;
+        BufferDesc desc_{};
+        std::string name_;
+        std::vector<uint8_t> shadow_;
+        std::vector<uint8_t> staging_;
+        MapMode mapMode_ = MapMode::Write;
+    };
+
+    class CaptureVertexInputLayout final : public IVertexInputLayout, public CaptureResource
+    {
+    public:
+        CaptureVertexInputLayout(std::shared_ptr<GfxCaptureState> state, std::shared_ptr<IVertexInputLayout> inner,
+                                 const VertexAttribute* attrs, uint32_t count)
+            : CaptureResource(std::move(state)), inner_(std::move(inner)), attributes_(attrs, attrs + count)
+        {
+            RecordCreate();
+        }
+
+        IVertexInputLayout* GetInner() const { return inner_.get(); }
+        const std::shared_ptr<IVertexInputLayout>& ShareInner() const { return inner_; }
+
+        void WriteCreate(GfxCaptureWriter& w) const override
+        {
+            w.Begin(GfxCaptureOp::CreateVertexInputLayout);
+            w.Put(id_);
+            w.Put(static_cast<uint32_t>(attributes_.size()));
+            for (const VertexAttribute& a : attributes_)
+            {
+                w.Put(a.location);
+                w.Put(static_cast<uint16_t>(a.format));
+                w.Put(a.offset);
+                w.Put(a.bindingSlot);
+                w.Put(a.stepRate);
+            }
+            w.End();
+        }
+
+    private:
+        std::shared_ptr<IVertexInputLayout> inner_;
+        std::vector<VertexAttribute> attributes_;
+    };
+
+    class CaptureShaderModule final : public IShaderModule, public CaptureResource
+    {
+    public:
+        CaptureShaderModule(std::shared_ptr<GfxCaptureState> state, std::shared_ptr<IShaderModule> inner, const ShaderDesc& desc)
+            : CaptureResource(std::move(state)), inner_(std::move(inner)), stage_(desc.stage),
+              source_(desc.source ? desc.source : ""), entryPoint_(desc.entryPoint ? desc.entryPoint : ""), name_(desc.name ? desc.name : ""),
+              hasSource_(desc.source != nullptr), hasEntryPoint_(desc.entryPoint != nullptr), hasName_(desc.name != nullptr)
+        {
+            RecordCreate();
+        }
+
+        ShaderStage GetStage() const override { return inner_->GetStage(); }
+        const std::shared_ptr<IShaderModule>& ShareInner() const { return inner_; }
+
+        void WriteCreate(GfxCaptureWriter& w) const override
+        {
+            w.Begin(GfxCaptureOp::CreateShaderModule);
+            w.Put(id_);
+            w.Put(static_cast<uint8_t>(stage_));
+            w.PutString(hasSource_ ? source_.c_str() : nullptr);
+            w.PutString(hasEntryPoint_ ? entryPoint_.c_str() : nullptr);
+            w.PutString(hasName_ ? name_.c_str() : nullptr);
+            w.End();
+        }
+
+    private:
+        std::shared_ptr<IShaderModule> inner_;
+        ShaderStage stage_;
+        std::string source_;
+        std::string entryPoint_;
+        std::string name_;
+        bool hasSource_;
+        bool hasEntryPoint_;
+        bool hasName_;
+    };
+
+    // Remembers the last value of every uniform so a capture started later still reproduces it
+    class CaptureProgram final : public IProgram, public CaptureResource
+    {
+    public:
+        CaptureProgram(std::shared_ptr<GfxCaptureState> state, std::shared_ptr<IProgram> inner,
+                       std::shared_ptr<CaptureShaderModule> vs, std::shared_ptr<CaptureShaderModule> fs, const char* name)
+            : CaptureResource(std::move(state)), inner_(std::move(inner)), vs_(std::move(vs)), fs_(std::move(fs)),
+              name_(name ? name : ""), hasName_(name != nullptr)
+        {
+            RecordCreate();
+        }
+
+        const ProgramReflection& GetReflection() const override { return inner_->GetReflection(); }
+
+        void SetTexture(const char* name, int slot) override
+        {
+            inner_->SetTexture(name, slot);
+            if (!name)
+                return;
+            textureSlots_[name] = slot;
+            if (GfxCaptureWriter* w = state_->Recording())
+                WriteNamedSlot(*w, GfxCaptureOp::ProgramSetTexture, name, slot);
+        }
+
+        void SetFloat(const char* name, float v) override { inner_->SetFloat(name, v); SetNamed(name, MakeUniform(UniformType::Float, &v)); }
+        void SetInt(const char* name, int v) override { inner_->SetInt(name, v); SetNamed(name, MakeUniform(v)); }
+        void SetVec2(const char* name, const float* v2) override { inner_->SetVec2(name, v2); SetNamed(name, MakeUniform(UniformType::Vec2, v2)); }
+        void SetVec3(const char* name, const float* v3) override { inner_->SetVec3(name, v3); SetNamed(name, MakeUniform(UniformType::Vec3, v3)); }
+        void SetVec4(const char* name, const float* v4) override { inner_->SetVec4(name, v4); SetNamed(name, MakeUniform(UniformType::Vec4, v4)); }
+        void SetMat4(const char* name, const float* m16, bool transpose) override
+        {
+            inner_->SetMat4(name, m16, transpose);
+            SetNamed(name, MakeUniform(UniformType::Mat4, m16, transpose));
+        }
+
+        UniformHandle GetUniformHandle(const char* name) const override
+        {
+            const UniformHandle handle = inner_->GetUniformHandle(name);
+            if (handle.IsValid() && name && handleNames_.emplace(handle.location, name).second)
+            {
+                if (GfxCaptureWriter* w = state_->Recording())
+                    WriteHandleName(*w, handle.location, name);
+            }
+            return handle;
+        }
+
+        void SetInt(UniformHandle h, int v) override { inner_->SetInt(h, v); SetHandle(h, MakeUniform(v)); }
+        void SetFloat(UniformHandle h, float v) override { inner_->SetFloat(h, v); SetHandle(h, MakeUniform(UniformType::Float, &v)); }
+        void SetVec2(UniformHandle h, const float* v2) override { inner_->SetVec2(h, v2); SetHandle(h, MakeUniform(UniformType::Vec2, v2)); }
+        void SetVec3(UniformHandle h, const float* v3) override { inner_->SetVec3(h, v3); SetHandle(h, MakeUniform(UniformType::Vec3, v3)); }
+        void SetVec4(UniformHandle h, const float* v4) override { inner_->SetVec4(h, v4); SetHandle(h, MakeUniform(UniformType::Vec4, v4)); }
+        void SetMat4(UniformHandle h, const float* m16, bool transpose) override
+        {
+            inner_->SetMat4(h, m16, transpose);
+            SetHandle(h, MakeUniform(UniformType::Mat4, m16, transpose));
+        }
+
+        void BindUniformBlock(const char* blockName, uint32_t slot) override
+        {
+            inner_->BindUniformBlock(blockName, slot);
+            if (!blockName)
+                return;
+            blockSlots_[blockName] = static_cast<int>(slot);
+            if (GfxCaptureWriter* w = state_->Recording())
+                WriteNamedSlot(*w, GfxCaptureOp::ProgramBindUniformBlock, blockName, static_cast<int>(slot));
+        }
+
+        IProgram* GetInner() const { return inner_.get(); }
+        const std::shared_ptr<IProgram>& ShareInner() const { return inner_; }
+
+        void WriteCreate(GfxCaptureWriter& w) const override
+        {
+            w.Begin(GfxCaptureOp::CreateProgram);
+            w.Put(id_);
+            w.Put(vs_ ? vs_->GetCaptureId() : 0u);
+            w.Put(fs_ ? fs_->GetCaptureId() : 0u);
+            w.PutString(hasName_ ? name_.c_str() : nullptr);
+            w.End();
+
+            for (const auto& [name, slot] : textureSlots_)
+                WriteNamedSlot(w, GfxCaptureOp::ProgramSetTexture, name.c_str(), slot);
+            for (const auto& [name, slot] : blockSlots_)
+                WriteNamedSlot(w, GfxCaptureOp::ProgramBindUniformBlock, name.c_str(), slot);
+            for (const auto& [name, value] : namedUniforms_)
+                WriteNamedUniform(w, name.c_str(), value);
+            for (const auto& [location, name] : handleNames_)
+                WriteHandleName(w, location, name.c_str());
+            for (const auto& [location, value] : handleUniforms_)
+                WriteHandleUniform(w, location, value);
+        }
+
+    private:
+        void SetNamed(const char* name, const UniformValue& value)
+        {
+            if (!name)
+                return;
+            namedUniforms_[name] = value;
+            if (GfxCaptureWriter* w = state_->Recording())
+                WriteNamedUniform(*w, name, value);
+        }
+
+        void SetHandle(UniformHandle h, const UniformValue& value)
+        {
+            if (!h.IsValid())
+                return;
+            handleUniforms_[h.location] = value;
+            if (GfxCaptureWriter* w = state_->Recording())
+                WriteHandleUniform(*w, h.location, value);
+        }
+
+        void WriteNamedSlot(GfxCaptureWriter& w, GfxCaptureOp op, const char* name, int slot) const
+        {
+            w.Begin(op);
+            w.Put(id_);
+            w.PutString(name);
+            w.Put<int32_t>(slot);
+            w.End();
+        }
+
+        void WriteNamedUniform(GfxCaptureWriter& w, const char* name, const UniformValue& value) const
+        {
+            w.Begin(GfxCaptureOp::ProgramSetUniform);
+            w.Put(id_);
+            w.PutString(name);
+            PutUniform(w, value);
+            w.End();
+        }
+
+        void WriteHandleName(GfxCaptureWriter& w, int32_t location, const char* name) const
+        {
+            w.Begin(GfxCaptureOp::ProgramUniformHandle);
+            w.Put(id_);
+            w.PutString(name);
+            w.Put(location);
+            w.End();
+        }
+
+        void WriteHandleUniform(GfxCaptureWriter& w, int32_t location, const UniformValue& value) const
+        {
+            w.Begin(GfxCaptureOp::ProgramSetUniformHandle);
+            w.Put(id_);
+            w.Put(location);
+            PutUniform(w, value);
+            w.End();
+        }
+
+        std::shared_ptr<IProgram> inner_;
+        std::shared_ptr<CaptureShaderModule> vs_;
+        std::shared_ptr<CaptureShaderModule> fs_;
+        std::string name_;
+        bool hasName_;
+        std::map<std::string, int> textureSlots_;
+        std::map<std::string, int> blockSlots_;
+        std::map<std::string, UniformValue> namedUniforms_;
+        std::map<int32_t, UniformValue> handleUniforms_;
+        mutable std::map<int32_t, std::string> handleNames_;
+    };
+
+    class CapturePipelineState final : public IPipelineState, public CaptureResource
+    {
+    public:
+        CapturePipelineState(std::shared_ptr<GfxCaptureState> state, std::shared_ptr<IPipelineState> inner, const PipelineStateDesc& desc)
+            : CaptureResource(std::move(state)), inner_(std::move(inner)), desc_(desc), name_(desc.name ? desc.name : "")
+        {
+            desc_.name = desc.name ? name_.c_str() : nullptr;
+            RecordCreate();
+        }
+
+        const PipelineStateDesc& GetDesc() const override { return desc_; }
+        std::size_t GetHash() const override { return inner_->GetHash(); }
+        IPipelineState* GetInner() const { return inner_.get(); }
+
+        void WriteCreate(GfxCaptureWriter& w) const override
+        {
+            w.Begin(GfxCaptureOp::CreatePipelineState);
+            w.Put(id_);
+            w.Put(desc_.program ? static_cast<const CaptureProgram*>(desc_.program.get())->GetCaptureId() : 0u);
+            w.Put(desc_.inputLayout ? static_cast<const CaptureVertexInputLayout*>(desc_.inputLayout.get())->GetCaptureId() : 0u);
+            w.Put(static_cast<uint8_t>(desc_.polygonMode));
+            w.Put(static_cast<uint8_t>(desc_.cullMode));
+            w.Put(static_cast<uint8_t>(desc_.blendMode));
+            w.Put(static_cast<uint8_t>(desc_.depthTest));
+            w.Put(static_cast<uint8_t>(desc_.depthWrite));
+            w.Put(static_cast<uint8_t>(desc_.depthFunc));
+            w.PutString(desc_.name);
+            w.End();
+        }
+
+    private:
+        std::shared_ptr<IPipelineState> inner_;
+        PipelineStateDesc desc_;
+        std::string name_;
+    };
+
+    class CaptureTexture final : public ITexture, public CaptureResource
+    {
+    public:
+        CaptureTexture(std::shared_ptr<GfxCaptureState> state, std::shared_ptr<ITexture> inner, const SubresourceData* initial)
+            : CaptureResource(std::move(state)), inner_(std::move(inner)), desc_(inner_->GetDesc()),
+              name_(desc_.name ? desc_.name : ""), hasName_(desc_.name != nullptr)
+        {
+            desc_.name = hasName_ ? name_.c_str() : nullptr;
+            levels_.resize(static_cast<std::size_t>(desc_.arrayLayers) * desc_.mipLevels);
+            for (uint32_t layer = 0; layer < desc_.arrayLayers; ++layer)
+            {
+                for (uint32_t mip = 0; mip < desc_.mipLevels; ++mip)
+                {
+                    std::vector<uint8_t>& level = levels_[layer * desc_.mipLevels + mip];
+                    level.assign(GetLevelSize(mip), 0);
+                    const SubresourceData* src = initial ? &initial[layer * desc_.mipLevels + mip] : nullptr;
+                    if (src && src->data)
+                        std::memcpy(level.data(), src->data, std::min(level.size(), src->size ? src->size : level.size()));
+                }
+            }
+            RecordCreate();
+        }
+
+        const TextureDesc& GetDesc() const override { return desc_; }
+
+        void UpdateLevel(uint32_t mipLevel, uint32_t arrayLayer, const void* data, std::size_t size) override
+        {
+            inner_->UpdateLevel(mipLevel, arrayLayer, data, size);
+            if (mipLevel >= desc_.mipLevels || arrayLayer >= desc_.arrayLayers || !data)
+                return;
+            std::vector<uint8_t>& level = levels_[arrayLayer * desc_.mipLevels + mipLevel];
+            std::memcpy(level.data(), data, std::min(level.size(), size ? size : level.size()));
+            if (GfxCaptureWriter* w = state_->Recording())
+            {
+                w->Begin(GfxCaptureOp::TextureUpdateLevel);
+                w->Put(id_);
+                w->Put(mipLevel);
+                w->Put(arrayLayer);
+                w->PutBlob(level.data(), level.size());
+                w->End();
+            }
+        }
+
+        ITexture* GetInner() const { return inner_.get(); }
+
+        void WriteCreate(GfxCaptureWriter& w) const override
+        {
+            w.Begin(GfxCaptureOp::CreateTexture);
+            w.Put(id_);
+            w.Put(static_cast<uint8_t>(desc_.type));
+            w.Put(static_cast<uint16_t>(desc_.format));
+            w.Put(desc_.width);
+            w.Put(desc_.height);
+            w.Put(desc_.arrayLayers);
+            w.Put(desc_.mipLevels);
+            w.PutString(desc_.name);
+            for (const std::vector<uint8_t>& level : levels_)
+                w.PutBlob(level.data(), level.size());
+            w.End();
+        }
+
+    private:
+        std::size_t GetLevelSize(uint32_t mip) const
+        {
+            return GetTextureLevelSize(desc_.format, std::max(desc_.width >> mip, 1u), std::max(desc_.height >> mip, 1u));
+        }
+
+        std::shared_ptr<ITexture> inner_;
+        TextureDesc desc_{};
+        std::string name_;
+        bool hasName_;
+        std::vector<std::vector<uint8_t>> levels_;
+    };
+
+    class CaptureSampler final : public ISampler, public CaptureResource
+    {
+    public:
+        CaptureSampler(std::shared_ptr<GfxCaptureState> state, std::shared_ptr<ISampler> inner)
+            : CaptureResource(std::move(state)), inner_(std::move(inner))
+        {
+            RecordCreate();
+        }
+
+        const SamplerDesc& GetDesc() const override { return inner_->GetDesc(); }
+        ISampler* GetInner() const { return inner_.get(); }
+
+        void WriteCreate(GfxCaptureWriter& w) const override
+        {
+            const SamplerDesc& d = inner_->GetDesc();
+            w.Begin(GfxCaptureOp::CreateSampler);
+            w.Put(id_);
+            w.Put(static_cast<uint8_t>(d.minFilter));
+            w.Put(static_cast<uint8_t>(d.magFilter));
+            w.Put(static_cast<uint8_t>(d.mipFilter));
+            w.Put(static_cast<uint8_t>(d.addressU));
+            w.Put(static_cast<uint8_t>(d.addressV));
+            w.Put(static_cast<uint8_t>(d.addressW));
+            w.Put(d.maxAnisotropy);
+            w.Put(d.mipLodBias);
+            w.Put(d.minLod);
+            w.Put(d.maxLod);
+            w.PutBytes(d.borderColor, sizeof(d.borderColor));
+            w.End();
+        }
+
+    private:
+        std::shared_ptr<ISampler> inner_;
+    };
+
+    namespace
+    {
+        template <class Wrapper, class Interface>
+        auto* Unwrap(Interface* object)
+        {
+            return object ? static_cast<Wrapper*>(object)->GetInner() : nullptr;
+        }
+
+        template <class Wrapper, class Interface>
+        uint32_t IdOf(Interface* object)
+        {
+            return object ? static_cast<Wrapper*>(object)->GetCaptureId() : 0u;
+        }
+    }
+
+    class GfxCaptureDevice final : public IDevice
+    {
+    public:
+        GfxCaptureDevice(IDevice* inner, std::shared_ptr<GfxCaptureState> state)
+            : inner_(inner), state_(std::move(state))
+        {
+        }
+
+        std::shared_ptr<IBuffer> CreateBuffer(const BufferDesc& desc, const SubresourceData* initial) override
+        {
+            auto buffer = inner_->CreateBuffer(desc, initial);
+            return buffer ? std::make_shared<CaptureBuffer>(state_, std::move(buffer), desc, initial) : nullptr;
+        }
+
+        std::shared_ptr<IVertexInputLayout> CreateVertexInputLayout(const VertexAttribute* attrs, uint32_t count) override
+        {
+            auto layout = inner_->CreateVertexInputLayout(attrs, count);
+            return layout ? std::make_shared<CaptureVertexInputLayout>(state_, std::move(layout), attrs, count) : nullptr;
+        }
+
+        std::shared_ptr<IShaderModule> CreateShaderModule(const ShaderDesc& desc) override
+        {
+            auto module = inner_->CreateShaderModule(desc);
+            return module ? std::make_shared<CaptureShaderModule>(state_, std::move(module), desc) : nullptr;
+        }
+
+        std::shared_ptr<IProgram> CreateProgram(const std::shared_ptr<IShaderModule>& vs, const std::shared_ptr<IShaderModule>& fs,
+                                               const char* name) override
+        {
+            auto capVs = std::static_pointer_cast<CaptureShaderModule>(vs);
+            auto capFs = std::static_pointer_cast<CaptureShaderModule>(fs);
+            auto program = inner_->CreateProgram(capVs ? capVs->ShareInner() : nullptr, capFs ? capFs->ShareInner() : nullptr, name);
+            return program ? std::make_shared<CaptureProgram>(state_, std::move(program), capVs, capFs, name) : nullptr;
+        }
+
+        std::shared_ptr<IPipelineState> CreatePipelineState(const PipelineStateDesc& desc) override
+        {
+            PipelineStateDesc innerDesc = desc;
+            innerDesc.program = desc.program ? static_cast<CaptureProgram*>(desc.program.get())->ShareInner() : nullptr;
+            innerDesc.inputLayout = desc.inputLayout ? static_cast<CaptureVertexInputLayout*>(desc.inputLayout.get())->ShareInner() : nullptr;
+            auto pipeline = inner_->CreatePipelineState(innerDesc);
+            if (!pipeline)
+                return nullptr;
+            // The backend dedupes equal descs; keep one wrapper per backend object so ids stay stable
+            auto& cached = pipelines_[pipeline.get()];
+            if (auto existing = cached.lock())
+                return existing;
+            auto wrapper = std::make_shared<CapturePipelineState>(state_, std::move(pipeline), desc);
+            cached = wrapper;
+            return wrapper;
+        }
+
+        std::size_t TrimPipelineStates() override
+        {
+            // Wrappers hold their backend pipeline, so the backend only frees pipelines whose wrapper is gone
+            for (auto it = pipelines_.begin(); it != pipelines_.end();)
+                it = it->second.expired() ? pipelines_.erase(it) : std::next(it);
+            return inner_->TrimPipelineStates();
+        }
+
+        std::shared_ptr<ITexture> CreateTexture(const TextureDesc& desc, const SubresourceData* initial) override
+        {
+            auto texture = inner_->CreateTexture(desc, initial);
+            return texture ? std::make_shared<CaptureTexture>(state_, std::move(texture), initial) : nullptr;
+        }
+
+        std::shared_ptr<ISampler> CreateSampler(const SamplerDesc& desc) override
+        {
+            auto sampler = inner_->CreateSampler(desc);
+            if (!sampler)
+                return nullptr;
+            auto& cached = samplers_[sampler.get()];
+            if (auto existing = cached.lock())
+                return existing;
+            auto wrapper = std::make_shared<CaptureSampler>(state_, std::move(sampler));
+            cached = wrapper;
+            return wrapper;
+        }
+
+    private:
+        IDevice* inner_ = nullptr;
+        std::shared_ptr<GfxCaptureState> state_;
+        std::unordered_map<const IPipelineState*, std::weak_ptr<CapturePipelineState>> pipelines_;
+        std::unordered_map<const ISampler*, std::weak_ptr<CaptureSampler>> samplers_;
+    };
+
+    class GfxCaptureContext final : public IContext
+    {
+    public:
+        GfxCaptureContext(IContext* inner, std::shared_ptr<GfxCaptureState> state)
+            : inner_(inner), state_(std::move(state))
+        {
+        }
+
+        void SetVertexBuffers(uint32_t startSlot, IBuffer* const* buffers, const uint32_t* strides, const uint32_t* offsets, uint32_t count) override
+        {
+            scratch_.resize(count);
+            for (uint32_t i = 0; i < count; ++i)
+                scratch_[i] = buffers ? Unwrap<CaptureBuffer>(buffers[i]) : nullptr;
+            inner_->SetVertexBuffers(startSlot, scratch_.data(), strides, offsets, count);
+            if (GfxCaptureWriter* w = Begin(GfxCaptureOp::SetVertexBuffers))
+            {
+                w->Put(startSlot);
+                w->Put(count);
+                w->Put(static_cast<uint8_t>((strides ? 1 : 0) | (offsets ? 2 : 0)));
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    w->Put(buffers ? IdOf<CaptureBuffer>(buffers[i]) : 0u);
+                    w->Put(strides ? strides[i] : 0u);
+                    w->Put(offsets ? offsets[i] : 0u);
+                }
+                w->End();
+            }
+        }
+
+        void SetIndexBuffer(IBuffer* buffer, IndexFormat fmt) override
+        {
+            inner_->SetIndexBuffer(Unwrap<CaptureBuffer>(buffer), fmt);
+            if (GfxCaptureWriter* w = Begin(GfxCaptureOp::SetIndexBuffer))
+            {
+                w->Put(IdOf<CaptureBuffer>(buffer));
+                w->Put(static_cast<uint8_t>(fmt));
+                w->End();
+            }
+        }
+
+        void SetConstantBuffer(uint32_t stage, uint32_t slot, IBuffer* buffer) override
+        {
+            inner_->SetConstantBuffer(stage, slot, Unwrap<CaptureBuffer>(buffer));
+            if (GfxCaptureWriter* w = Begin(GfxCaptureOp::SetConstantBuffer))
+            {
+                w->Put(stage);
+                w->Put(slot);
+                w->Put(IdOf<CaptureBuffer>(buffer));
+                w->End();
+            }
+        }
+
+        void SetStorageBuffer(uint32_t slot, IBuffer* buffer) override
+        {
+            inner_->SetStorageBuffer(slot, Unwrap<CaptureBuffer>(buffer));
+            if (GfxCaptureWriter* w = Begin(GfxCaptureOp::SetStorageBuffer))
+            {
+                w->Put(slot);
+                w->Put(IdOf<CaptureBuffer>(buffer));
+                w->End();
+            }
+        }
+
+        void SetTexture(uint32_t slot, ITexture* texture, ISampler* sampler) override
+        {
+            inner_->SetTexture(slot, Unwrap<CaptureTexture>(texture), Unwrap<CaptureSampler>(sampler));
+            if (GfxCaptureWriter* w = Begin(GfxCaptureOp::SetTexture))
+            {
+                w->Put(slot);
+                w->Put(IdOf<CaptureTexture>(texture));
+                w->Put(IdOf<CaptureSampler>(sampler));
+                w->End();
+            }
+        }
+
+        void SetVertexInputLayout(IVertexInputLayout* layout) override
+        {
+            inner_->SetVertexInputLayout(Unwrap<CaptureVertexInputLayout>(layout));
+            RecordId(GfxCaptureOp::SetVertexInputLayout, IdOf<CaptureVertexInputLayout>(layout));
+        }
+
+        void BindProgram(IProgram* program) override
+        {
+            inner_->BindProgram(Unwrap<CaptureProgram>(program));
+            RecordId(GfxCaptureOp::BindProgram, IdOf<CaptureProgram>(program));
+        }
+
+        void SetPipelineState(IPipelineState* pipeline) override
+        {
+            inner_->SetPipelineState(Unwrap<CapturePipelineState>(pipeline));
+            RecordId(GfxCaptureOp::SetPipelineState, IdOf<CapturePipelineState>(pipeline));
+        }
+
+        void SetPolygonMode(PolygonMode mode) override
+        {
+            inner_->SetPolygonMode(mode);
+            RecordByte(GfxCaptureOp::SetPolygonMode, static_cast<uint8_t>(mode));
+        }
+
+        void SetCullMode(CullMode mode) override
+        {
+            inner_->SetCullMode(mode);
+            RecordByte(GfxCaptureOp::SetCullMode, static_cast<uint8_t>(mode));
+        }
+
+        void SetBlendMode(BlendMode mode) override
+        {
+            inner_->SetBlendMode(mode);
+            RecordByte(GfxCaptureOp::SetBlendMode, static_cast<uint8_t>(mode));
+        }
+
+        void SetDepthTest(bool enable) override
+        {
+            inner_->SetDepthTest(enable);
+            RecordByte(GfxCaptureOp::SetDepthTest, static_cast<uint8_t>(enable));
+        }
+
+        void SetScissorTest(bool enable, int x, int y, int width, int height) override
+        {
+            inner_->SetScissorTest(enable, x, y, width, height);
+            if (GfxCaptureWriter* w = Begin(GfxCaptureOp::SetScissorTest))
+            {
+                w->Put(static_cast<uint8_t>(enable));
+                w->Put<int32_t>(x);
+                w->Put<int32_t>(y);
+                w->Put<int32_t>(width);
+                w->Put<int32_t>(height);
+                w->End();
+            }
+        }
+
+        void Draw(uint32_t vertexCount, uint32_t startVertex) override
+        {
+            inner_->Draw(vertexCount, startVertex);
+            if (GfxCaptureWriter* w = Begin(GfxCaptureOp::Draw))
+            {
+                w->Put(vertexCount);
+                w->Put(startVertex);
+                w->End();
+            }
+        }
+
+        void DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex) override
+        {
+            inner_->DrawIndexed(indexCount, startIndex, baseVertex);
+            if (GfxCaptureWriter* w = Begin(GfxCaptureOp::DrawIndexed))
+            {
+                w->Put(indexCount);
+                w->Put(startIndex);
+                w->Put(baseVertex);
+                w->End();
+            }
+        }
+
+        void DrawIndexedIndirect(IBuffer* argsBuffer, uint32_t byteOffset) override
+        {
+            inner_->DrawIndexedIndirect(Unwrap<CaptureBuffer>(argsBuffer), byteOffset);
+            if (GfxCaptureWriter* w = Begin(GfxCaptureOp::DrawIndexedIndirect))
+            {
+                w->Put(IdOf<CaptureBuffer>(argsBuffer));
+                w->Put(byteOffset);
+                w->End();
+            }
+        }
+
+        void MultiDrawIndexedIndirect(IBuffer* argsBuffer, uint32_t byteOffset, uint32_t drawCount, uint32_t stride) override
+        {
+            inner_->MultiDrawIndexedIndirect(Unwrap<CaptureBuffer>(argsBuffer), byteOffset, drawCount, stride);
+            if (GfxCaptureWriter* w = Begin(GfxCaptureOp::MultiDrawIndexedIndirect))
+            {
+                w->Put(IdOf<CaptureBuffer>(argsBuffer));
+                w->Put(byteOffset);
+                w->Put(drawCount);
+                w->Put(stride);
+                w->End();
+            }
+        }
+
+    private:
+        GfxCaptureWriter* Begin(GfxCaptureOp op)
+        {
+            GfxCaptureWriter* w = state_->Recording();
+            if (w)
+                w->Begin(op);
+            return w;
+        }
+
+        void RecordId(GfxCaptureOp op, uint32_t id)
+        {
+            if (GfxCaptureWriter* w = Begin(op))
+            {
+                w->Put(id);
+                w->End();
+            }
+        }
+
+        void RecordByte(GfxCaptureOp op, uint8_t value)
+        {
+            if (GfxCaptureWriter* w = Begin(op))
+            {
+                w->Put(value);
+                w->End();
+            }
+        }
+
+        IContext* inner_ = nullptr;
+        std::shared_ptr<GfxCaptureState> state_;
+        std::vector<IBuffer*> scratch_;
+    };
+
+    GfxCapture::GfxCapture(IDevice* device, IContext* context, const GfxCaptureSettings& settings)
+        : state_(std::make_shared<GfxCaptureState>()),
+          device_(std::make_unique<GfxCaptureDevice>(device, state_)),
+          context_(std::make_unique<GfxCaptureContext>(context, state_)),
+          settings_(settings)
+    {
+        if (!settings_.path.empty() && settings_.firstFrame == 0)
+            Start(settings_.path, settings_.frameCount);
+    }
+
+    GfxCapture::~GfxCapture()
+    {
+        Stop();
+    }
+
+    IDevice* GfxCapture::GetDevice() const
+    {
+        return device_.get();
+    }
+
+    IContext* GfxCapture::GetContext() const
+    {
+        return context_.get();
+    }
+
+    bool GfxCapture::Start(const std::string& path, uint32_t frameCount)
+    {
+        Stop();
+        if (!state_->writer.Open(path))
+            return false;
+        state_->capturing = true;
+        state_->framesCaptured = 0;
+        state_->frameLimit = frameCount;
+
+        // Everything created before this point is replayed from its current contents
+        for (const auto& entry : state_->live)
+            entry.second->WriteCreate(state_->writer);
+
+        Logger::Log("GfxCapture: recording {} ({} live objects, {} frames)", path, state_->live.size(),
+                    frameCount ? std::to_string(frameCount) : std::string("until stopped"));
+        return true;
+    }
+
+    void GfxCapture::Stop()
+    {
+        if (!state_->capturing)
+            return;
+        const uint64_t bytes = state_->writer.GetBytesWritten();
+        const uint32_t records = state_->writer.GetRecordCount();
+        state_->writer.Close(state_->framesCaptured);
+        state_->capturing = false;
+        Logger::Log("GfxCapture: wrote {} frames, {} records, {} bytes", state_->framesCaptured, records, bytes);
+    }
+
+    bool GfxCapture::IsCapturing() const
+    {
+        return state_->capturing;
+    }
+
+    void GfxCapture::EndFrame()
+    {
+        if (state_->capturing)
+        {
+            state_->writer.Begin(GfxCaptureOp::FrameEnd);
+            state_->writer.Put(state_->framesCaptured);
+            state_->writer.End();
+            ++state_->framesCaptured;
+            if (state_->frameLimit && state_->framesCaptured >= state_->frameLimit)
+                Stop();
+        }
+
+        ++frameIndex_;
+        if (!state_->capturing && !settings_.path.empty() && settings_.firstFrame != 0 && frameIndex_ == settings_.firstFrame)
+            Start(settings_.path, settings_.frameCount);
+    }
+
+    GfxCaptureStats GfxCapture::GetStats() const
+    {
+        GfxCaptureStats stats;
+        stats.framesCaptured = state_->framesCaptured;
+        stats.records = state_->writer.GetRecordCount();
+        stats.bytes = state_->writer.GetBytesWritten();
+        return stats;
+    }
+}
+
+namespace SoulEngine
+{
+    void Renderer::SetGfxCapture(const Gfx::GfxCaptureSettings& settings)
+    {
+        gfxCaptureSettings_ = std::make_shared<Gfx::GfxCaptureSettings>(settings);
+    }
+
+    void Renderer::InstallGfxCapture(Gfx::IDevice* device, Gfx::IContext* context)
+    {
+        gfxCapture_.reset();
+        if (gfxCaptureSettings_ && device && context)
+            gfxCapture_ = std::make_shared<Gfx::GfxCapture>(device, context, *gfxCaptureSettings_);
+    }
+}
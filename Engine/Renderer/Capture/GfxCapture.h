@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Renderer/Gfx.h"
+
+namespace SoulEngine::Gfx
+{
+    struct GfxCaptureState;
+    class GfxCaptureDevice;
+    class GfxCaptureContext;
+
+    struct GfxCaptureSettings
+    {
+        std::string path;                   // empty = recorder installed but idle until Start
+        uint32_t firstFrame = 0;            // frame (counted by EndFrame) at which recording starts
+        uint32_t frameCount = 1;            // 0 = until Stop
+    };
+
+    struct GfxCaptureStats
+    {
+        uint32_t framesCaptured = 0;
+        uint64_t records = 0;
+        uint64_t bytes = 0;
+    };
+
+    /**
+     * @brief Gfx 调用录制器
+     * 在真实的 IDevice/IContext 外包一层：所有调用照常转发给后端，录制期间同时序列化为紧凑的二进制流
+     * （缓冲内容只记录 Map 前后实际变化的区间），可用 Tools/GfxReplay 在任意后端（包括 null 后端）上回放并逐调用计时。
+     * 录制器必须在创建任何资源之前装上；开始录制时会先写出所有存活对象的创建记录（含当前内容），
+     * 所以可以在任意帧开始。上下文绑定状态不做快照，录制从帧边界开始，各个 Pass 会重新绑定。
+     *
+     * 使用方式:
+     *   GfxCapture capture(device, context, { "frame.gfxcap", 100, 10 });  // 第 100 帧起录 10 帧
+     *   IDevice* dev = capture.GetDevice();          // 之后只使用包装后的设备与上下文
+     *   IContext* ctx = capture.GetContext();
+     *   capture.EndFrame();                          // 每帧一次（SwapBuffers 处）
+     */
+    class GfxCapture
+    {
+    public:
+        GfxCapture(IDevice* device, IContext* context, const GfxCaptureSettings& settings = {});
+        ~GfxCapture();
+
+        GfxCapture(const GfxCapture&) = delete;
+        GfxCapture& operator=(const GfxCapture&) = delete;
+
+        IDevice* GetDevice() const;
+        IContext* GetContext() const;
+
+        // Starts recording right away; frameCount 0 records until Stop
+        bool Start(const std::string& path, uint32_t frameCount);
+        void Stop();
+        bool IsCapturing() const;
+
+        // Frame boundary: starts a scheduled capture and stops a finished one
+        void EndFrame();
+
+        GfxCaptureStats GetStats() const;
+
+    private:
+        std::shared_ptr<GfxCaptureState> state_;
+        std::unique_ptr<GfxCaptureDevice> device_;
+        std::unique_ptr<GfxCaptureContext> context_;
+        GfxCaptureSettings settings_;
+        uint64_t frameIndex_ = 0;
+    };
+}
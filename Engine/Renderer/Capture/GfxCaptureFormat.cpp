@@ -0,0 +1,209 @@
+#include "Renderer/Capture/GfxCaptureFormat.h"
+#include "Core/EngineFileIO.h"
+#include "Log/Logger.h"
+
+namespace SoulEngine::Gfx
+{
+    namespace
+    {
+        constexpr std::size_t kWriterFlushSize = 4u << 20;
+    }
+
+    const char* GetGfxCaptureOpName(GfxCaptureOp op)
+    {
+        switch (op)
+        {
+        case GfxCaptureOp::CreateBuffer:             return "CreateBuffer";
+        case GfxCaptureOp::CreateVertexInputLayout:  return "CreateVertexInputLayout";
+        case GfxCaptureOp::CreateShaderModule:       return "CreateShaderModule";
+        case GfxCaptureOp::CreateProgram:            return "CreateProgram";
+        case GfxCaptureOp::CreatePipelineState:      return "CreatePipelineState";
+        case GfxCaptureOp::CreateTexture:            return "CreateTexture";
+        case GfxCaptureOp::CreateSampler:            return "CreateSampler";
+        case GfxCaptureOp::Destroy:                  return "Destroy";
+        case GfxCaptureOp::BufferUpdate:             return "BufferUpdate";
+        case GfxCaptureOp::TextureUpdateLevel:       return "TextureUpdateLevel";
+        case GfxCaptureOp::ProgramSetTexture:        return "ProgramSetTexture";
+        case GfxCaptureOp::ProgramSetUniform:        return "ProgramSetUniform";
+        case GfxCaptureOp::ProgramUniformHandle:     return "ProgramUniformHandle";
+        case GfxCaptureOp::ProgramSetUniformHandle:  return "ProgramSetUniformHandle";
+        case GfxCaptureOp::ProgramBindUniformBlock:  return "ProgramBindUniformBlock";
+        case GfxCaptureOp::SetVertexBuffers:         return "SetVertexBuffers";
+        case GfxCaptureOp::SetIndexBuffer:           return "SetIndexBuffer";
+        case GfxCaptureOp::SetConstantBuffer:        return "SetConstantBuffer";
+        case GfxCaptureOp::SetStorageBuffer:         return "SetStorageBuffer";
+        case GfxCaptureOp::SetTexture:               return "SetTexture";
+        case GfxCaptureOp::SetVertexInputLayout:     return "SetVertexInputLayout";
+        case GfxCaptureOp::BindProgram:              return "BindProgram";
+        case GfxCaptureOp::SetPipelineState:         return "SetPipelineState";
+        case GfxCaptureOp::SetPolygonMode:           return "SetPolygonMode";
+        case GfxCaptureOp::SetCullMode:              return "SetCullMode";
+        case GfxCaptureOp::SetBlendMode:             return "SetBlendMode";
+        case GfxCaptureOp::SetDepthTest:             return "SetDepthTest";
+        case GfxCaptureOp::SetScissorTest:           return "SetScissorTest";
+        case GfxCaptureOp::Draw:                     return "Draw";
+        case GfxCaptureOp::DrawIndexed:              return "DrawIndexed";
+        case GfxCaptureOp::DrawIndexedIndirect:      return "DrawIndexedIndirect";
+        case GfxCaptureOp::MultiDrawIndexedIndirect: return "MultiDrawIndexedIndirect";
+        case GfxCaptureOp::FrameEnd:                 return "FrameEnd";
+        }
+        return "Unknown";
+    }
+
+    bool GfxCaptureWriter::Open(const std::string& path)
+    {
+        Close(0);
+        file_ = std::fopen(path.c_str(), "wb");
+        if (!file_)
+        {
+            Logger::Error("GfxCaptureWriter: cannot open {} for writing", path);
+            return false;
+        }
+        bytesWritten_ = 0;
+        recordCount_ = 0;
+        buffer_.clear();
+        const GfxCaptureHeader header{};
+        PutBytes(&header, sizeof(header));
+        return true;
+    }
+
+    void GfxCaptureWriter::Close(uint32_t frameCount)
+    {
+        if (!file_)
+            return;
+        Flush();
+        GfxCaptureHeader header{};
+        header.frameCount = frameCount;
+        header.recordCount = recordCount_;
+        std::fseek(file_, 0, SEEK_SET);
+        std::fwrite(&header, sizeof(header), 1, file_);
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+
+    void GfxCaptureWriter::Begin(GfxCaptureOp op)
+    {
+        recordStart_ = buffer_.size();
+        const uint16_t code = static_cast<uint16_t>(op);
+        const uint32_t size = 0;
+        PutBytes(&code, sizeof(code));
+        PutBytes(&size, sizeof(size));
+    }
+
+    void GfxCaptureWriter::End()
+    {
+        const uint32_t size = static_cast<uint32_t>(buffer_.size() - recordStart_ - kGfxCaptureRecordHeaderSize);
+        std::memcpy(buffer_.data() + recordStart_ + sizeof(uint16_t), &size, sizeof(size));
+        ++recordCount_;
+        // Only flush between records so the size patch above always lands in memory
+        if (buffer_.size() >= kWriterFlushSize)
+            Flush();
+    }
+
+    void GfxCaptureWriter::PutBytes(const void* data, std::size_t size)
+    {
+        if (size == 0)
+            return;
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        buffer_.insert(buffer_.end(), bytes, bytes + size);
+    }
+
+    void GfxCaptureWriter::PutString(const char* str)
+    {
+        if (!str)
+        {
+            Put<uint32_t>(UINT32_MAX);
+            return;
+        }
+        const uint32_t length = static_cast<uint32_t>(std::strlen(str));
+        Put(length);
+        PutBytes(str, length);
+    }
+
+    void GfxCaptureWriter::PutBlob(const void* data, std::size_t size)
+    {
+        Put<uint64_t>(data ? size : 0);
+        if (data)
+            PutBytes(data, size);
+    }
+
+    void GfxCaptureWriter::Flush()
+    {
+        if (file_ && !buffer_.empty())
+        {
+            std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+            bytesWritten_ += buffer_.size();
+        }
+        buffer_.clear();
+    }
+
+    const uint8_t* GfxCapturePayload::Take(std::size_t size)
+    {
+        if (!valid_ || size > size_ - offset_)
+        {
+            valid_ = false;
+            return nullptr;
+        }
+        const uint8_t* src = data_ + offset_;
+        offset_ += size;
+        return src;
+    }
+
+    bool GfxCapturePayload::GetString(std::string& out)
+    {
+        out.clear();
+        const uint32_t length = Get<uint32_t>();
+        if (length == UINT32_MAX)
+            return false;
+        if (const uint8_t* src = Take(length))
+            out.assign(reinterpret_cast<const char*>(src), length);
+        return valid_;
+    }
+
+    const uint8_t* GfxCapturePayload::GetBlob(std::size_t& size)
+    {
+        size = static_cast<std::size_t>(Get<uint64_t>());
+        return size ? Take(size) : nullptr;
+    }
+
+    bool GfxCaptureReader::Open(const std::string& path)
+    {
+        offset_ = 0;
+        data_ = EngineFileIO::MapFile(path);
+        if (data_.Size() < sizeof(GfxCaptureHeader))
+        {
+            data_.Close();
+            Logger::Error("GfxCaptureReader: {} is not a capture file", path);
+            return false;
+        }
+        std::memcpy(&header_, data_.Data(), sizeof(header_));
+        if (std::memcmp(header_.magic, kGfxCaptureMagic, sizeof(kGfxCaptureMagic)) != 0 || header_.version != kGfxCaptureVersion)
+        {
+            Logger::Error("GfxCaptureReader: {} has an unsupported header (version {})", path, header_.version);
+            data_.Close();
+            return false;
+        }
+        Rewind();
+        return true;
+    }
+
+    bool GfxCaptureReader::Next(GfxCaptureRecord& record)
+    {
+        if (data_.Size() - offset_ < kGfxCaptureRecordHeaderSize)
+            return false;
+        uint16_t code;
+        uint32_t size;
+        std::memcpy(&code, data_.Data() + offset_, sizeof(code));
+        std::memcpy(&size, data_.Data() + offset_ + sizeof(code), sizeof(size));
+        if (size > data_.Size() - offset_ - kGfxCaptureRecordHeaderSize)
+        {
+            Logger::Warn("GfxCaptureReader: truncated record at offset {}", offset_);
+            return false;
+        }
+        record.op = static_cast<GfxCaptureOp>(code);
+        record.data = data_.Data() + offset_ + kGfxCaptureRecordHeaderSize;
+        record.size = size;
+        offset_ += kGfxCaptureRecordHeaderSize + size;
+        return true;
+    }
+}
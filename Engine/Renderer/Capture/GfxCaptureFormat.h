@@ -0,0 +1,167 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Core/MappedFile.h"
+
+namespace SoulEngine::Gfx
+{
+    // File layout: GfxCaptureHeader, then records until end of file.
+    // Record: uint16 op, uint32 payload size, payload. All values little-endian, unaligned.
+    // Objects are referred to by capture ids; 0 means null.
+    constexpr char kGfxCaptureMagic[4] = { 'S', 'E', 'G', 'C' };
+    constexpr uint32_t kGfxCaptureVersion = 1;
+    constexpr uint32_t kGfxCaptureRecordHeaderSize = 6;
+
+    struct GfxCaptureHeader
+    {
+        char magic[4] = { 'S', 'E', 'G', 'C' };
+        uint32_t version = kGfxCaptureVersion;
+        uint32_t frameCount = 0;            // patched when the capture is closed
+        uint32_t recordCount = 0;
+    };
+
+    enum class GfxCaptureOp : uint16_t
+    {
+        // Device
+        CreateBuffer = 1,
+        CreateVertexInputLayout,
+        CreateShaderModule,
+        CreateProgram,
+        CreatePipelineState,
+        CreateTexture,
+        CreateSampler,
+        Destroy,
+
+        // Resources
+        BufferUpdate = 32,
+        TextureUpdateLevel,
+
+        // Program
+        ProgramSetTexture = 48,
+        ProgramSetUniform,                  // by name
+        ProgramUniformHandle,               // name -> location seen at capture time
+        ProgramSetUniformHandle,            // by captured location
+        ProgramBindUniformBlock,
+
+        // Context
+        SetVertexBuffers = 64,
+        SetIndexBuffer,
+        SetConstantBuffer,
+        SetStorageBuffer,
+        SetTexture,
+        SetVertexInputLayout,
+        BindProgram,
+        SetPipelineState,
+        SetPolygonMode,
+        SetCullMode,
+        SetBlendMode,
+        SetDepthTest,
+        SetScissorTest,
+        Draw,
+        DrawIndexed,
+        DrawIndexedIndirect,
+        MultiDrawIndexedIndirect,
+
+        FrameEnd = 128,
+    };
+
+    const char* GetGfxCaptureOpName(GfxCaptureOp op);
+
+    // Buffers records in memory and appends them to the file in large writes
+    class GfxCaptureWriter
+    {
+    public:
+        GfxCaptureWriter() = default;
+        ~GfxCaptureWriter() { Close(0); }
+
+        GfxCaptureWriter(const GfxCaptureWriter&) = delete;
+        GfxCaptureWriter& operator=(const GfxCaptureWriter&) = delete;
+
+        bool Open(const std::string& path);
+        // Flushes and patches the header; no-op when not open
+        void Close(uint32_t frameCount);
+        bool IsOpen() const { return file_ != nullptr; }
+        uint64_t GetBytesWritten() const { return bytesWritten_ + buffer_.size(); }
+        uint32_t GetRecordCount() const { return recordCount_; }
+
+        void Begin(GfxCaptureOp op);
+        void End();
+
+        template <class T>
+        void Put(const T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Put expects a plain value");
+            PutBytes(&value, sizeof(T));
+        }
+        void PutBytes(const void* data, std::size_t size);
+        // uint32 length (UINT32_MAX for null) + bytes, no terminator
+        void PutString(const char* str);
+        // uint64 size + bytes
+        void PutBlob(const void* data, std::size_t size);
+
+    private:
+        void Flush();
+
+        std::FILE* file_ = nullptr;
+        std::vector<uint8_t> buffer_;
+        std::size_t recordStart_ = 0;
+        uint64_t bytesWritten_ = 0;
+        uint32_t recordCount_ = 0;
+    };
+
+    // Bounds-checked cursor over one record payload; reads past the end yield zeros and clear IsValid
+    class GfxCapturePayload
+    {
+    public:
+        GfxCapturePayload(const uint8_t* data, std::size_t size) : data_(data), size_(size) {}
+
+        template <class T>
+        T Get()
+        {
+            T value{};
+            if (const uint8_t* src = Take(sizeof(T)))
+                std::memcpy(&value, src, sizeof(T));
+            return value;
+        }
+        const uint8_t* GetBytes(std::size_t size) { return Take(size); }
+        // Returns false for a null string
+        bool GetString(std::string& out);
+        const uint8_t* GetBlob(std::size_t& size);
+
+        bool IsValid() const { return valid_; }
+
+    private:
+        const uint8_t* Take(std::size_t size);
+
+        const uint8_t* data_ = nullptr;
+        std::size_t size_ = 0;
+        std::size_t offset_ = 0;
+        bool valid_ = true;
+    };
+
+    struct GfxCaptureRecord
+    {
+        GfxCaptureOp op = GfxCaptureOp::FrameEnd;
+        const uint8_t* data = nullptr;
+        uint32_t size = 0;
+    };
+
+    class GfxCaptureReader
+    {
+    public:
+        bool Open(const std::string& path);
+        const GfxCaptureHeader& GetHeader() const { return header_; }
+        // Restarts at the first record
+        void Rewind() { offset_ = sizeof(GfxCaptureHeader); }
+        bool Next(GfxCaptureRecord& record);
+
+    private:
+        MappedFile data_;
+        GfxCaptureHeader header_{};
+        std::size_t offset_ = 0;
+    };
+}
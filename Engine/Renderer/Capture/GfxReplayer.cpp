@@ -0,0 +1,567 @@
+#include "Renderer/Capture/GfxReplayer.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <chrono>
+
+namespace SoulEngine::Gfx
+{
+    namespace
+    {
+        double ElapsedMs(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        struct UniformValue
+        {
+            UniformType type = UniformType::Unknown;
+            bool transpose = false;
+            int32_t i = 0;
+            float f[16] = {};
+        };
+
+        uint32_t GetUniformFloatCount(UniformType type)
+        {
+            switch (type)
+            {
+            case UniformType::Float: return 1;
+            case UniformType::Vec2:  return 2;
+            case UniformType::Vec3:  return 3;
+            case UniformType::Vec4:  return 4;
+            case UniformType::Mat4:  return 16;
+            default: return 0;
+            }
+        }
+
+        UniformValue GetUniform(GfxCapturePayload& in)
+        {
+            UniformValue value;
+            value.type = static_cast<UniformType>(in.Get<uint8_t>());
+            value.transpose = in.Get<uint8_t>() != 0;
+            if (value.type == UniformType::Int)
+                value.i = in.Get<int32_t>();
+            else if (const uint8_t* src = in.GetBytes(sizeof(float) * GetUniformFloatCount(value.type)))
+                std::memcpy(value.f, src, sizeof(float) * GetUniformFloatCount(value.type));
+            return value;
+        }
+
+        // Same dispatch for by-name and by-handle setters
+        template <class Key>
+        void ApplyUniform(IProgram* program, Key key, const UniformValue& v)
+        {
+            switch (v.type)
+            {
+            case UniformType::Int:   program->SetInt(key, v.i); break;
+            case UniformType::Float: program->SetFloat(key, v.f[0]); break;
+            case UniformType::Vec2:  program->SetVec2(key, v.f); break;
+            case UniformType::Vec3:  program->SetVec3(key, v.f); break;
+            case UniformType::Vec4:  program->SetVec4(key, v.f); break;
+            case UniformType::Mat4:  program->SetMat4(key, v.f, v.transpose); break;
+            default: break;
+            }
+        }
+
+        template <class Map>
+        auto* FindIn(const Map& map, uint32_t id)
+        {
+            auto it = map.find(id);
+            return it != map.end() ? it->second.get() : nullptr;
+        }
+    }
+
+    GfxReplayer::GfxReplayer(IDevice* device, IContext* context)
+        : device_(device), context_(context)
+    {
+    }
+
+    GfxReplayer::~GfxReplayer()
+    {
+        ReleaseObjects();
+    }
+
+    bool GfxReplayer::Load(const std::string& path)
+    {
+        loaded_ = reader_.Open(path);
+        return loaded_;
+    }
+
+    bool GfxReplayer::Replay(uint32_t loops, const FrameCallback& onFrameEnd)
+    {
+        if (!loaded_ || !device_ || !context_)
+            return false;
+
+        for (uint32_t loop = 0; loop < loops; ++loop)
+        {
+            reader_.Rewind();
+            auto frameStart = std::chrono::steady_clock::now();
+            GfxCaptureRecord record;
+            while (reader_.Next(record))
+            {
+                ++stats_.records;
+                if (record.op != GfxCaptureOp::FrameEnd)
+                {
+                    Execute(record);
+                    continue;
+                }
+                if (onFrameEnd)
+                    Timed(GfxCaptureOp::FrameEnd, [&] { onFrameEnd(stats_.frames); });
+                stats_.frameMs.push_back(ElapsedMs(frameStart));
+                ++stats_.frames;
+                frameStart = std::chrono::steady_clock::now();
+            }
+            ReleaseObjects();
+        }
+        return true;
+    }
+
+    template <class Fn>
+    void GfxReplayer::Timed(GfxCaptureOp op, Fn&& fn)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        const double ms = ElapsedMs(start);
+        GfxReplayOpStats& s = stats_.ops[static_cast<uint16_t>(op) & 0xFF];
+        ++s.count;
+        s.totalMs += ms;
+        s.maxMs = std::max(s.maxMs, ms);
+        stats_.totalMs += ms;
+    }
+
+    void GfxReplayer::Execute(const GfxCaptureRecord& record)
+    {
+        GfxCapturePayload in(record.data, record.size);
+        const auto op = static_cast<uint16_t>(record.op);
+        if (op < static_cast<uint16_t>(GfxCaptureOp::ProgramSetTexture))
+            ExecuteDevice(record.op, in);
+        else if (op < static_cast<uint16_t>(GfxCaptureOp::SetVertexBuffers))
+            ExecuteProgram(record.op, in);
+        else if (op < static_cast<uint16_t>(GfxCaptureOp::FrameEnd))
+            ExecuteContext(record.op, in);
+        else
+            ++stats_.skipped;
+
+        if (!in.IsValid())
+            Logger::Warn("GfxReplayer: truncated {} record", GetGfxCaptureOpName(record.op));
+    }
+
+    void GfxReplayer::ExecuteDevice(GfxCaptureOp op, GfxCapturePayload& in)
+    {
+        const uint32_t id = in.Get<uint32_t>();
+        switch (op)
+        {
+        case GfxCaptureOp::CreateBuffer:
+        {
+            BufferDesc desc;
+            desc.size = static_cast<std::size_t>(in.Get<uint64_t>());
+            desc.kind = static_cast<BufferKind>(in.Get<uint8_t>());
+            desc.usage = static_cast<BufferUsage>(in.Get<uint8_t>());
+            desc.bindFlags = static_cast<BindFlags>(in.Get<uint32_t>());
+            desc.cpuAccess = static_cast<CpuAccessFlags>(in.Get<uint8_t>());
+            desc.stride = static_cast<std::size_t>(in.Get<uint64_t>());
+            desc.indexFormat = static_cast<IndexFormat>(in.Get<uint8_t>());
+            desc.name = KeepName(in);
+            std::size_t size = 0;
+            const uint8_t* data = in.GetBlob(size);
+            const SubresourceData initial{ data, size, 0 };
+            std::shared_ptr<IBuffer> buffer;
+            Timed(op, [&] { buffer = device_->CreateBuffer(desc, data ? &initial : nullptr); });
+            stats_.failedCreates += buffer ? 0 : 1;
+            buffers_[id] = std::move(buffer);
+            break;
+        }
+        case GfxCaptureOp::CreateVertexInputLayout:
+        {
+            std::vector<VertexAttribute> attrs(std::min<uint32_t>(in.Get<uint32_t>(), 64));
+            for (VertexAttribute& a : attrs)
+            {
+                a.location = in.Get<uint32_t>();
+                a.format = static_cast<DataFormat>(in.Get<uint16_t>());
+                a.offset = in.Get<uint32_t>();
+                a.bindingSlot = in.Get<uint32_t>();
+                a.stepRate = in.Get<uint32_t>();
+            }
+            std::shared_ptr<IVertexInputLayout> layout;
+            Timed(op, [&] { layout = device_->CreateVertexInputLayout(attrs.data(), static_cast<uint32_t>(attrs.size())); });
+            stats_.failedCreates += layout ? 0 : 1;
+            layouts_[id] = std::move(layout);
+            break;
+        }
+        case GfxCaptureOp::CreateShaderModule:
+        {
+            ShaderDesc desc{};
+            desc.stage = static_cast<ShaderStage>(in.Get<uint8_t>());
+            std::string source;
+            desc.source = in.GetString(source) ? source.c_str() : nullptr;
+            desc.entryPoint = KeepName(in);
+            desc.name = KeepName(in);
+            std::shared_ptr<IShaderModule> module;
+            Timed(op, [&] { module = device_->CreateShaderModule(desc); });
+            stats_.failedCreates += module ? 0 : 1;
+            shaders_[id] = std::move(module);
+            break;
+        }
+        case GfxCaptureOp::CreateProgram:
+        {
+            auto vs = shaders_.find(in.Get<uint32_t>());
+            auto fs = shaders_.find(in.Get<uint32_t>());
+            const char* name = KeepName(in);
+            std::shared_ptr<IProgram> program;
+            if (vs != shaders_.end() && fs != shaders_.end() && vs->second && fs->second)
+                Timed(op, [&] { program = device_->CreateProgram(vs->second, fs->second, name); });
+            stats_.failedCreates += program ? 0 : 1;
+            programs_[id] = std::move(program);
+            handles_.erase(id);
+            break;
+        }
+        case GfxCaptureOp::CreatePipelineState:
+        {
+            PipelineStateDesc desc;
+            auto program = programs_.find(in.Get<uint32_t>());
+            auto layout = layouts_.find(in.Get<uint32_t>());
+            desc.program = program != programs_.end() ? program->second : nullptr;
+            desc.inputLayout = layout != layouts_.end() ? layout->second : nullptr;
+            desc.polygonMode = static_cast<PolygonMode>(in.Get<uint8_t>());
+            desc.cullMode = static_cast<CullMode>(in.Get<uint8_t>());
+            desc.blendMode = static_cast<BlendMode>(in.Get<uint8_t>());
+            desc.depthTest = in.Get<uint8_t>() != 0;
+            desc.depthWrite = in.Get<uint8_t>() != 0;
+            desc.depthFunc = static_cast<CompareFunc>(in.Get<uint8_t>());
+            desc.name = KeepName(in);
+            std::shared_ptr<IPipelineState> pipeline;
+            Timed(op, [&] { pipeline = device_->CreatePipelineState(desc); });
+            stats_.failedCreates += pipeline ? 0 : 1;
+            pipelines_[id] = std::move(pipeline);
+            break;
+        }
+        case GfxCaptureOp::CreateTexture:
+        {
+            TextureDesc desc;
+            desc.type = static_cast<TextureType>(in.Get<uint8_t>());
+            desc.format = static_cast<DataFormat>(in.Get<uint16_t>());
+            desc.width = in.Get<uint32_t>();
+            desc.height = in.Get<uint32_t>();
+            desc.arrayLayers = in.Get<uint32_t>();
+            desc.mipLevels = in.Get<uint32_t>();
+            desc.name = KeepName(in);
+            scratchLevels_.clear();
+            for (uint64_t i = 0, n = uint64_t(desc.arrayLayers) * desc.mipLevels; i < n && in.IsValid(); ++i)
+            {
+                std::size_t size = 0;
+                const uint8_t* data = in.GetBlob(size);
+                scratchLevels_.push_back({ data, size, 0 });
+            }
+            std::shared_ptr<ITexture> texture;
+            if (in.IsValid())
+                Timed(op, [&] { texture = device_->CreateTexture(desc, scratchLevels_.data()); });
+            stats_.failedCreates += texture ? 0 : 1;
+            textures_[id] = std::move(texture);
+            break;
+        }
+        case GfxCaptureOp::CreateSampler:
+        {
+            SamplerDesc desc;
+            desc.minFilter = static_cast<FilterMode>(in.Get<uint8_t>());
+            desc.magFilter = static_cast<FilterMode>(in.Get<uint8_t>());
+            desc.mipFilter = static_cast<FilterMode>(in.Get<uint8_t>());
+            desc.addressU = static_cast<AddressMode>(in.Get<uint8_t>());
+            desc.addressV = static_cast<AddressMode>(in.Get<uint8_t>());
+            desc.addressW = static_cast<AddressMode>(in.Get<uint8_t>());
+            desc.maxAnisotropy = in.Get<float>();
+            desc.mipLodBias = in.Get<float>();
+            desc.minLod = in.Get<float>();
+            desc.maxLod = in.Get<float>();
+            for (float& c : desc.borderColor)
+                c = in.Get<float>();
+            std::shared_ptr<ISampler> sampler;
+            Timed(op, [&] { sampler = device_->CreateSampler(desc); });
+            stats_.failedCreates += sampler ? 0 : 1;
+            samplers_[id] = std::move(sampler);
+            break;
+        }
+        case GfxCaptureOp::Destroy:
+        {
+            // Ids are unique across types, at most one of these erases something
+            Timed(op, [&] {
+                buffers_.erase(id);
+                layouts_.erase(id);
+                shaders_.erase(id);
+                programs_.erase(id);
+                pipelines_.erase(id);
+                textures_.erase(id);
+                samplers_.erase(id);
+            });
+            handles_.erase(id);
+            break;
+        }
+        case GfxCaptureOp::BufferUpdate:
+        {
+            const std::size_t offset = static_cast<std::size_t>(in.Get<uint64_t>());
+            std::size_t size = 0;
+            const uint8_t* data = in.GetBlob(size);
+            IBuffer* buffer = FindBuffer(id);
+            if (!buffer || !data || size == 0)
+            {
+                ++stats_.skipped;
+                break;
+            }
+            Timed(op, [&] { buffer->Update({ data, size, offset }); });
+            break;
+        }
+        case GfxCaptureOp::TextureUpdateLevel:
+        {
+            const uint32_t mip = in.Get<uint32_t>();
+            const uint32_t layer = in.Get<uint32_t>();
+            std::size_t size = 0;
+            const uint8_t* data = in.GetBlob(size);
+            ITexture* texture = FindIn(textures_, id);
+            if (!texture || !data)
+            {
+                ++stats_.skipped;
+                break;
+            }
+            Timed(op, [&] { texture->UpdateLevel(mip, layer, data, size); });
+            break;
+        }
+        default:
+            ++stats_.skipped;
+            break;
+        }
+    }
+
+    void GfxReplayer::ExecuteProgram(GfxCaptureOp op, GfxCapturePayload& in)
+    {
+        const uint32_t id = in.Get<uint32_t>();
+        IProgram* program = FindProgram(id);
+        switch (op)
+        {
+        case GfxCaptureOp::ProgramSetTexture:
+        case GfxCaptureOp::ProgramBindUniformBlock:
+        {
+            std::string name;
+            in.GetString(name);
+            const int32_t slot = in.Get<int32_t>();
+            if (!program)
+                break;
+            if (op == GfxCaptureOp::ProgramSetTexture)
+                Timed(op, [&] { program->SetTexture(name.c_str(), slot); });
+            else
+                Timed(op, [&] { program->BindUniformBlock(name.c_str(), static_cast<uint32_t>(slot)); });
+            return;
+        }
+        case GfxCaptureOp::ProgramSetUniform:
+        {
+            std::string name;
+            in.GetString(name);
+            const UniformValue value = GetUniform(in);
+            if (!program)
+                break;
+            Timed(op, [&] { ApplyUniform(program, name.c_str(), value); });
+            return;
+        }
+        case GfxCaptureOp::ProgramUniformHandle:
+        {
+            std::string name;
+            in.GetString(name);
+            const int32_t location = in.Get<int32_t>();
+            if (!program)
+                break;
+            UniformHandle handle;
+            Timed(op, [&] { handle = program->GetUniformHandle(name.c_str()); });
+            handles_[id][location] = handle;
+            return;
+        }
+        case GfxCaptureOp::ProgramSetUniformHandle:
+        {
+            const int32_t location = in.Get<int32_t>();
+            const UniformValue value = GetUniform(in);
+            auto programHandles = handles_.find(id);
+            if (!program || programHandles == handles_.end())
+                break;
+            auto handle = programHandles->second.find(location);
+            if (handle == programHandles->second.end())
+                break;
+            Timed(op, [&] { ApplyUniform(program, handle->second, value); });
+            return;
+        }
+        default:
+            break;
+        }
+        ++stats_.skipped;
+    }
+
+    void GfxReplayer::ExecuteContext(GfxCaptureOp op, GfxCapturePayload& in)
+    {
+        switch (op)
+        {
+        case GfxCaptureOp::SetVertexBuffers:
+        {
+            const uint32_t startSlot = in.Get<uint32_t>();
+            const uint32_t count = std::min<uint32_t>(in.Get<uint32_t>(), 64);
+            const uint8_t flags = in.Get<uint8_t>();
+            scratchBuffers_.resize(count);
+            scratchStrides_.resize(count);
+            scratchOffsets_.resize(count);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                scratchBuffers_[i] = FindBuffer(in.Get<uint32_t>());
+                scratchStrides_[i] = in.Get<uint32_t>();
+                scratchOffsets_[i] = in.Get<uint32_t>();
+            }
+            Timed(op, [&] {
+                context_->SetVertexBuffers(startSlot, scratchBuffers_.data(), (flags & 1) ? scratchStrides_.data() : nullptr,
+                                           (flags & 2) ? scratchOffsets_.data() : nullptr, count);
+            });
+            break;
+        }
+        case GfxCaptureOp::SetIndexBuffer:
+        {
+            IBuffer* buffer = FindBuffer(in.Get<uint32_t>());
+            const auto fmt = static_cast<IndexFormat>(in.Get<uint8_t>());
+            Timed(op, [&] { context_->SetIndexBuffer(buffer, fmt); });
+            break;
+        }
+        case GfxCaptureOp::SetConstantBuffer:
+        {
+            const uint32_t stage = in.Get<uint32_t>();
+            const uint32_t slot = in.Get<uint32_t>();
+            IBuffer* buffer = FindBuffer(in.Get<uint32_t>());
+            Timed(op, [&] { context_->SetConstantBuffer(stage, slot, buffer); });
+            break;
+        }
+        case GfxCaptureOp::SetStorageBuffer:
+        {
+            const uint32_t slot = in.Get<uint32_t>();
+            IBuffer* buffer = FindBuffer(in.Get<uint32_t>());
+            Timed(op, [&] { context_->SetStorageBuffer(slot, buffer); });
+            break;
+        }
+        case GfxCaptureOp::SetTexture:
+        {
+            const uint32_t slot = in.Get<uint32_t>();
+            ITexture* texture = FindIn(textures_, in.Get<uint32_t>());
+            ISampler* sampler = FindIn(samplers_, in.Get<uint32_t>());
+            Timed(op, [&] { context_->SetTexture(slot, texture, sampler); });
+            break;
+        }
+        case GfxCaptureOp::SetVertexInputLayout:
+        {
+            IVertexInputLayout* layout = FindIn(layouts_, in.Get<uint32_t>());
+            Timed(op, [&] { context_->SetVertexInputLayout(layout); });
+            break;
+        }
+        case GfxCaptureOp::BindProgram:
+        {
+            IProgram* program = FindProgram(in.Get<uint32_t>());
+            Timed(op, [&] { context_->BindProgram(program); });
+            break;
+        }
+        case GfxCaptureOp::SetPipelineState:
+        {
+            IPipelineState* pipeline = FindIn(pipelines_, in.Get<uint32_t>());
+            Timed(op, [&] { context_->SetPipelineState(pipeline); });
+            break;
+        }
+        case GfxCaptureOp::SetPolygonMode:
+        {
+            const auto mode = static_cast<PolygonMode>(in.Get<uint8_t>());
+            Timed(op, [&] { context_->SetPolygonMode(mode); });
+            break;
+        }
+        case GfxCaptureOp::SetCullMode:
+        {
+            const auto mode = static_cast<CullMode>(in.Get<uint8_t>());
+            Timed(op, [&] { context_->SetCullMode(mode); });
+            break;
+        }
+        case GfxCaptureOp::SetBlendMode:
+        {
+            const auto mode = static_cast<BlendMode>(in.Get<uint8_t>());
+            Timed(op, [&] { context_->SetBlendMode(mode); });
+            break;
+        }
+        case GfxCaptureOp::SetDepthTest:
+        {
+            const bool enable = in.Get<uint8_t>() != 0;
+            Timed(op, [&] { context_->SetDepthTest(enable); });
+            break;
+        }
+        case GfxCaptureOp::SetScissorTest:
+        {
+            const bool enable = in.Get<uint8_t>() != 0;
+            const int32_t x = in.Get<int32_t>();
+            const int32_t y = in.Get<int32_t>();
+            const int32_t width = in.Get<int32_t>();
+            const int32_t height = in.Get<int32_t>();
+            Timed(op, [&] { context_->SetScissorTest(enable, x, y, width, height); });
+            break;
+        }
+        case GfxCaptureOp::Draw:
+        {
+            const uint32_t vertexCount = in.Get<uint32_t>();
+            const uint32_t startVertex = in.Get<uint32_t>();
+            Timed(op, [&] { context_->Draw(vertexCount, startVertex); });
+            break;
+        }
+        case GfxCaptureOp::DrawIndexed:
+        {
+            const uint32_t indexCount = in.Get<uint32_t>();
+            const uint32_t startIndex = in.Get<uint32_t>();
+            const int32_t baseVertex = in.Get<int32_t>();
+            Timed(op, [&] { context_->DrawIndexed(indexCount, startIndex, baseVertex); });
+            break;
+        }
+        case GfxCaptureOp::DrawIndexedIndirect:
+        {
+            IBuffer* args = FindBuffer(in.Get<uint32_t>());
+            const uint32_t byteOffset = in.Get<uint32_t>();
+            Timed(op, [&] { context_->DrawIndexedIndirect(args, byteOffset); });
+            break;
+        }
+        case GfxCaptureOp::MultiDrawIndexedIndirect:
+        {
+            IBuffer* args = FindBuffer(in.Get<uint32_t>());
+            const uint32_t byteOffset = in.Get<uint32_t>();
+            const uint32_t drawCount = in.Get<uint32_t>();
+            const uint32_t stride = in.Get<uint32_t>();
+            Timed(op, [&] { context_->MultiDrawIndexedIndirect(args, byteOffset, drawCount, stride); });
+            break;
+        }
+        default:
+            ++stats_.skipped;
+            break;
+        }
+    }
+
+    void GfxReplayer::ReleaseObjects()
+    {
+        // Dependents first, so pipelines and programs do not outlive what they reference by much
+        pipelines_.clear();
+        programs_.clear();
+        handles_.clear();
+        shaders_.clear();
+        layouts_.clear();
+        buffers_.clear();
+        textures_.clear();
+        samplers_.clear();
+        names_.clear();
+    }
+
+    IBuffer* GfxReplayer::FindBuffer(uint32_t id) const
+    {
+        return FindIn(buffers_, id);
+    }
+
+    IProgram* GfxReplayer::FindProgram(uint32_t id) const
+    {
+        return FindIn(programs_, id);
+    }
+
+    const char* GfxReplayer::KeepName(GfxCapturePayload& in)
+    {
+        std::string name;
+        if (!in.GetString(name))
+            return nullptr;
+        names_.push_back(std::move(name));
+        return names_.back().c_str();
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Renderer/Gfx.h"
+#include "Renderer/Capture/GfxCaptureFormat.h"
+
+namespace SoulEngine::Gfx
+{
+    struct GfxReplayOpStats
+    {
+        uint64_t count = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    struct GfxReplayStats
+    {
+        uint32_t frames = 0;
+        uint64_t records = 0;
+        uint64_t skipped = 0;                    // unknown ops, malformed payloads, references to missing objects
+        uint64_t failedCreates = 0;              // the target backend returned null
+        double totalMs = 0.0;                    // backend time only, summed over all ops
+        std::vector<double> frameMs;             // wall time between frame boundaries, onFrameEnd included
+        std::array<GfxReplayOpStats, 256> ops{}; // indexed by GfxCaptureOp
+    };
+
+    /**
+     * @brief Gfx 录制文件回放器
+     * 按顺序把 GfxCapture 写出的记录重新提交给任意 IDevice/IContext，逐调用计时（只计后端调用本身，不含解码）。
+     * 录制时的对象 id 与 uniform location 都会映射到回放端的对象与句柄。后端创建失败（例如软件后端没有注册对应着色器）
+     * 时对象按空处理，引用它的调用照常以空指针转发，因此回放不会中断。
+     *
+     * 使用方式:
+     *   GfxReplayer replayer(device, context);
+     *   if (replayer.Load("frame.gfxcap"))
+     *       replayer.Replay(10, [&](uint32_t frame) { swap(); });
+     *   const GfxReplayStats& stats = replayer.GetStats();
+     */
+    class GfxReplayer
+    {
+    public:
+        using FrameCallback = std::function<void(uint32_t frame)>;
+
+        GfxReplayer(IDevice* device, IContext* context);
+        ~GfxReplayer();
+
+        GfxReplayer(const GfxReplayer&) = delete;
+        GfxReplayer& operator=(const GfxReplayer&) = delete;
+
+        bool Load(const std::string& path);
+        const GfxCaptureHeader& GetHeader() const { return reader_.GetHeader(); }
+
+        // Plays the whole file loops times; every loop recreates all objects. onFrameEnd runs at each frame boundary.
+        bool Replay(uint32_t loops = 1, const FrameCallback& onFrameEnd = {});
+
+        const GfxReplayStats& GetStats() const { return stats_; }
+        void ResetStats() { stats_ = {}; }
+
+    private:
+        void Execute(const GfxCaptureRecord& record);
+        void ExecuteDevice(GfxCaptureOp op, GfxCapturePayload& in);
+        void ExecuteProgram(GfxCaptureOp op, GfxCapturePayload& in);
+        void ExecuteContext(GfxCaptureOp op, GfxCapturePayload& in);
+        void ReleaseObjects();
+
+        template <class Fn>
+        void Timed(GfxCaptureOp op, Fn&& fn);
+
+        IBuffer* FindBuffer(uint32_t id) const;
+        IProgram* FindProgram(uint32_t id) const;
+        const char* KeepName(GfxCapturePayload& in);
+
+        IDevice* device_ = nullptr;
+        IContext* context_ = nullptr;
+        GfxCaptureReader reader_;
+        bool loaded_ = false;
+        GfxReplayStats stats_;
+
+        std::unordered_map<uint32_t, std::shared_ptr<IBuffer>> buffers_;
+        std::unordered_map<uint32_t, std::shared_ptr<IVertexInputLayout>> layouts_;
+        std::unordered_map<uint32_t, std::shared_ptr<IShaderModule>> shaders_;
+        std::unordered_map<uint32_t, std::shared_ptr<IProgram>> programs_;
+        std::unordered_map<uint32_t, std::shared_ptr<IPipelineState>> pipelines_;
+        std::unordered_map<uint32_t, std::shared_ptr<ITexture>> textures_;
+        std::unordered_map<uint32_t, std::shared_ptr<ISampler>> samplers_;
+        // program id -> captured location -> replay handle
+        std::unordered_map<uint32_t, std::unordered_map<int32_t, UniformHandle>> handles_;
+        std::deque<std::string> names_;          // backends may keep the debug name pointer
+        std::vector<IBuffer*> scratchBuffers_;
+        std::vector<uint32_t> scratchStrides_;
+        std::vector<uint32_t> scratchOffsets_;
+        std::vector<SubresourceData> scratchLevels_;
+    };
+}
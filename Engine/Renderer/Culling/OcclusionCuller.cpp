@@ -0,0 +1,445 @@
+#include "Renderer/Culling/OcclusionCuller.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOULENGINE_OCCLUSION_SSE2 1
+#endif
+
+namespace SoulEngine
+{
+    namespace
+    {
+        constexpr uint32_t kBlockSize = 8;      // depth hierarchy granularity
+        constexpr uint32_t kTileSize = 32;      // raster job granularity, multiple of kBlockSize
+        constexpr float kNearW = 1e-5f;
+        constexpr float kGuardBand = 4.0f;      // NDC extent kept after clipping
+        constexpr uint32_t kClipPlaneCount = 5;
+        constexpr uint32_t kMaxClipVertices = 3 + kClipPlaneCount;
+
+        void MultiplyMatrix(const float a[16], const float b[16], float out[16])
+        {
+            for (int c = 0; c < 4; ++c)
+                for (int r = 0; r < 4; ++r)
+                    out[c * 4 + r] = a[0 * 4 + r] * b[c * 4 + 0] + a[1 * 4 + r] * b[c * 4 + 1] +
+                                     a[2 * 4 + r] * b[c * 4 + 2] + a[3 * 4 + r] * b[c * 4 + 3];
+        }
+
+        void TransformPoint(const float m[16], float x, float y, float z, float out[4])
+        {
+            for (int r = 0; r < 4; ++r)
+                out[r] = m[0 * 4 + r] * x + m[1 * 4 + r] * y + m[2 * 4 + r] * z + m[3 * 4 + r];
+        }
+
+        // Near plane plus a guard band on x/y; inside is >= 0
+        float ClipDistance(uint32_t plane, const float* p)
+        {
+            switch (plane)
+            {
+            case 0: return p[3] + p[2] - kNearW;
+            case 1: return kGuardBand * p[3] - p[0];
+            case 2: return kGuardBand * p[3] + p[0];
+            case 3: return kGuardBand * p[3] - p[1];
+            default: return kGuardBand * p[3] + p[1];
+            }
+        }
+
+        double ElapsedMs(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    OcclusionCuller::OcclusionCuller(uint32_t width, uint32_t height)
+    {
+        Resize(width, height);
+    }
+
+    void OcclusionCuller::Resize(uint32_t width, uint32_t height)
+    {
+        width_ = std::max<uint32_t>((width + kBlockSize - 1) / kBlockSize, 1) * kBlockSize;
+        height_ = std::max<uint32_t>((height + kBlockSize - 1) / kBlockSize, 1) * kBlockSize;
+        tilesX_ = (width_ + kTileSize - 1) / kTileSize;
+        tilesY_ = (height_ + kTileSize - 1) / kTileSize;
+        depth_.assign(static_cast<std::size_t>(width_) * height_, 1.0f);
+        hiz_.assign(static_cast<std::size_t>(width_ / kBlockSize) * (height_ / kBlockSize), 1.0f);
+        bins_.assign(static_cast<std::size_t>(tilesX_) * tilesY_, {});
+        triangles_.clear();
+    }
+
+    void OcclusionCuller::BeginFrame(const float viewProj[16])
+    {
+        std::memcpy(viewProj_, viewProj, sizeof(viewProj_));
+        std::fill(depth_.begin(), depth_.end(), 1.0f);
+        std::fill(hiz_.begin(), hiz_.end(), 1.0f);
+        triangles_.clear();
+        stats_ = OcclusionCullingStats{};
+        tested_ = 0;
+        frustumCulled_ = 0;
+        occlusionCulled_ = 0;
+    }
+
+    void OcclusionCuller::AddOccluder(const float* positions, uint32_t stride, const uint32_t* indices, uint32_t indexCount,
+                                      const float model[16], bool cullBackFaces)
+    {
+        if (!positions || !indices || indexCount < 3)
+            return;
+        if (stride == 0)
+            stride = sizeof(float) * 3;
+
+        float mvp[16];
+        if (model)
+            MultiplyMatrix(viewProj_, model, mvp);
+        else
+            std::memcpy(mvp, viewProj_, sizeof(mvp));
+
+        const uint32_t vertexCount = *std::max_element(indices, indices + indexCount) + 1;
+        clipScratch_.resize(static_cast<std::size_t>(vertexCount) * 4);
+        const auto* base = reinterpret_cast<const uint8_t*>(positions);
+        for (uint32_t v = 0; v < vertexCount; ++v)
+        {
+            float p[3];
+            std::memcpy(p, base + static_cast<std::size_t>(v) * stride, sizeof(p));
+            TransformPoint(mvp, p[0], p[1], p[2], &clipScratch_[v * 4]);
+        }
+
+        const uint32_t triangleCount = indexCount / 3;
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            AddClipTriangle(&clipScratch_[indices[t * 3 + 0] * 4], &clipScratch_[indices[t * 3 + 1] * 4],
+                            &clipScratch_[indices[t * 3 + 2] * 4], cullBackFaces);
+        }
+        ++stats_.occluderMeshes;
+        stats_.occluderTriangles += triangleCount;
+    }
+
+    void OcclusionCuller::AddClipTriangle(const float* a, const float* b, const float* c, bool cullBackFaces)
+    {
+        // Trivial reject against the view frustum sides and the near plane
+        const float* verts[3] = { a, b, c };
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            if (a[axis] > a[3] && b[axis] > b[3] && c[axis] > c[3]) return;
+            if (a[axis] < -a[3] && b[axis] < -b[3] && c[axis] < -c[3]) return;
+        }
+
+        float polyA[kMaxClipVertices][4];
+        float polyB[kMaxClipVertices][4];
+        float (*in)[4] = polyA;
+        float (*out)[4] = polyB;
+        uint32_t count = 3;
+        for (int i = 0; i < 3; ++i)
+            std::memcpy(in[i], verts[i], sizeof(float) * 4);
+
+        for (uint32_t plane = 0; plane < kClipPlaneCount && count >= 3; ++plane)
+        {
+            bool allInside = true;
+            for (uint32_t i = 0; i < count && allInside; ++i)
+                allInside = ClipDistance(plane, in[i]) >= 0.0f;
+            if (allInside)
+                continue;
+
+            uint32_t outCount = 0;
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const float* p = in[i];
+                const float* q = in[(i + 1) % count];
+                const float dp = ClipDistance(plane, p);
+                const float dq = ClipDistance(plane, q);
+                if (dp >= 0.0f)
+                    std::memcpy(out[outCount++], p, sizeof(float) * 4);
+                if ((dp >= 0.0f) != (dq >= 0.0f) && outCount < kMaxClipVertices)
+                {
+                    const float t = dp / (dp - dq);
+                    for (int k = 0; k < 4; ++k)
+                        out[outCount][k] = p[k] + (q[k] - p[k]) * t;
+                    ++outCount;
+                }
+            }
+            std::swap(in, out);
+            count = outCount;
+        }
+        if (count < 3)
+            return;
+
+        const float w = static_cast<float>(width_);
+        const float h = static_cast<float>(height_);
+        float sx[kMaxClipVertices], sy[kMaxClipVertices], sz[kMaxClipVertices];
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const float invW = 1.0f / in[i][3];
+            sx[i] = (in[i][0] * invW * 0.5f + 0.5f) * w;
+            sy[i] = (in[i][1] * invW * 0.5f + 0.5f) * h;
+            sz[i] = std::min(std::max(in[i][2] * invW * 0.5f + 0.5f, 0.0f), 1.0f);
+        }
+
+        for (uint32_t i = 1; i + 1 < count; ++i)
+        {
+            uint32_t idx[3] = { 0, i, i + 1 };
+            const float area = (sx[idx[1]] - sx[idx[0]]) * (sy[idx[2]] - sy[idx[0]]) -
+                               (sx[idx[2]] - sx[idx[0]]) * (sy[idx[1]] - sy[idx[0]]);
+            if (area == 0.0f || (cullBackFaces && area < 0.0f))
+                continue;
+            if (area < 0.0f)
+                std::swap(idx[1], idx[2]);
+
+            Triangle tri{};
+            for (int k = 0; k < 3; ++k)
+            {
+                tri.x[k] = sx[idx[k]];
+                tri.y[k] = sy[idx[k]];
+            }
+            const float minXf = std::min({ tri.x[0], tri.x[1], tri.x[2] });
+            const float maxXf = std::max({ tri.x[0], tri.x[1], tri.x[2] });
+            const float minYf = std::min({ tri.y[0], tri.y[1], tri.y[2] });
+            const float maxYf = std::max({ tri.y[0], tri.y[1], tri.y[2] });
+            // Pixel centres sit at +0.5
+            tri.minX = std::max(static_cast<int32_t>(std::ceil(minXf - 0.5f)), 0);
+            tri.minY = std::max(static_cast<int32_t>(std::ceil(minYf - 0.5f)), 0);
+            tri.maxX = std::min(static_cast<int32_t>(std::floor(maxXf - 0.5f)) + 1, static_cast<int32_t>(width_));
+            tri.maxY = std::min(static_cast<int32_t>(std::floor(maxYf - 0.5f)) + 1, static_cast<int32_t>(height_));
+            if (tri.minX >= tri.maxX || tri.minY >= tri.maxY)
+                continue;
+
+            const float dx1 = tri.x[1] - tri.x[0], dy1 = tri.y[1] - tri.y[0];
+            const float dx2 = tri.x[2] - tri.x[0], dy2 = tri.y[2] - tri.y[0];
+            const float invArea = 1.0f / (dx1 * dy2 - dx2 * dy1);
+            const float dz1 = sz[idx[1]] - sz[idx[0]], dz2 = sz[idx[2]] - sz[idx[0]];
+            tri.z[0] = sz[idx[0]];
+            tri.z[1] = (dz1 * dy2 - dz2 * dy1) * invArea;
+            tri.z[2] = (dz2 * dx1 - dz1 * dx2) * invArea;
+            triangles_.push_back(tri);
+        }
+    }
+
+    void OcclusionCuller::RenderOccluders()
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (auto& bin : bins_)
+            bin.clear();
+        for (uint32_t i = 0; i < triangles_.size(); ++i)
+        {
+            const Triangle& tri = triangles_[i];
+            for (uint32_t ty = tri.minY / kTileSize; ty <= (tri.maxY - 1) / kTileSize; ++ty)
+                for (uint32_t tx = tri.minX / kTileSize; tx <= (tri.maxX - 1) / kTileSize; ++tx)
+                    bins_[ty * tilesX_ + tx].push_back(i);
+        }
+        stats_.rasterizedTriangles = static_cast<uint32_t>(triangles_.size());
+
+        // Every tile also refreshes its hierarchy blocks, so empty tiles are processed too
+        JobSystem::GetInstance().ParallelFor(tilesX_ * tilesY_, 1, [this](uint32_t begin, uint32_t end) {
+            for (uint32_t t = begin; t < end; ++t)
+                RasterizeTile(t);
+        });
+
+        triangles_.clear();
+        stats_.rasterMs += ElapsedMs(start);
+    }
+
+    void OcclusionCuller::RasterizeTile(uint32_t tileIndex)
+    {
+        const int32_t tileX0 = static_cast<int32_t>((tileIndex % tilesX_) * kTileSize);
+        const int32_t tileY0 = static_cast<int32_t>((tileIndex / tilesX_) * kTileSize);
+        const int32_t tileX1 = std::min(tileX0 + static_cast<int32_t>(kTileSize), static_cast<int32_t>(width_));
+        const int32_t tileY1 = std::min(tileY0 + static_cast<int32_t>(kTileSize), static_cast<int32_t>(height_));
+        float* depth = depth_.data();
+
+        for (uint32_t triIndex : bins_[tileIndex])
+        {
+            const Triangle& tri = triangles_[triIndex];
+            const int32_t rx0 = std::max(tri.minX, tileX0), rx1 = std::min(tri.maxX, tileX1);
+            const int32_t ry0 = std::max(tri.minY, tileY0), ry1 = std::min(tri.maxY, tileY1);
+            if (rx0 >= rx1 || ry0 >= ry1)
+                continue;
+
+            // Iterate whole 4-pixel groups; tiles are 8-aligned so groups never leave the tile
+            const int32_t gx0 = rx0 & ~3;
+            const int32_t gx1 = (rx1 + 3) & ~3;
+
+            float edgeA[3], edgeB[3], edgeRow[3];
+            const float px0 = static_cast<float>(gx0) + 0.5f;
+            const float py0 = static_cast<float>(ry0) + 0.5f;
+            for (int k = 0; k < 3; ++k)
+            {
+                const float ax = tri.x[k], ay = tri.y[k];
+                const float bx = tri.x[(k + 1) % 3], by = tri.y[(k + 1) % 3];
+                edgeA[k] = -(by - ay);
+                edgeB[k] = bx - ax;
+                edgeRow[k] = (bx - ax) * (py0 - ay) - (by - ay) * (px0 - ax);
+            }
+            float zRow = tri.z[0] + tri.z[1] * (px0 - tri.x[0]) + tri.z[2] * (py0 - tri.y[0]);
+
+            for (int32_t y = ry0; y < ry1; ++y)
+            {
+                float* row = depth + static_cast<std::size_t>(y) * width_;
+#if defined(SOULENGINE_OCCLUSION_SSE2)
+                const __m128 lane = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+                const __m128 zero = _mm_setzero_ps();
+                __m128 e0 = _mm_add_ps(_mm_set1_ps(edgeRow[0]), _mm_mul_ps(lane, _mm_set1_ps(edgeA[0])));
+                __m128 e1 = _mm_add_ps(_mm_set1_ps(edgeRow[1]), _mm_mul_ps(lane, _mm_set1_ps(edgeA[1])));
+                __m128 e2 = _mm_add_ps(_mm_set1_ps(edgeRow[2]), _mm_mul_ps(lane, _mm_set1_ps(edgeA[2])));
+                __m128 z = _mm_add_ps(_mm_set1_ps(zRow), _mm_mul_ps(lane, _mm_set1_ps(tri.z[1])));
+                const __m128 step0 = _mm_set1_ps(edgeA[0] * 4.0f);
+                const __m128 step1 = _mm_set1_ps(edgeA[1] * 4.0f);
+                const __m128 step2 = _mm_set1_ps(edgeA[2] * 4.0f);
+                const __m128 stepZ = _mm_set1_ps(tri.z[1] * 4.0f);
+                const __m128 rectMin = _mm_set1_ps(static_cast<float>(rx0));
+                const __m128 rectMax = _mm_set1_ps(static_cast<float>(rx1));
+                for (int32_t x = gx0; x < gx1; x += 4)
+                {
+                    const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lane);
+                    __m128 mask = _mm_and_ps(_mm_cmpge_ps(px, rectMin), _mm_cmplt_ps(px, rectMax));
+                    mask = _mm_and_ps(mask, _mm_cmpge_ps(e0, zero));
+                    mask = _mm_and_ps(mask, _mm_cmpge_ps(e1, zero));
+                    mask = _mm_and_ps(mask, _mm_cmpge_ps(e2, zero));
+                    if (_mm_movemask_ps(mask))
+                    {
+                        const __m128 d = _mm_loadu_ps(row + x);
+                        const __m128 nearest = _mm_min_ps(d, z);
+                        _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(mask, nearest), _mm_andnot_ps(mask, d)));
+                    }
+                    e0 = _mm_add_ps(e0, step0);
+                    e1 = _mm_add_ps(e1, step1);
+                    e2 = _mm_add_ps(e2, step2);
+                    z = _mm_add_ps(z, stepZ);
+                }
+#else
+                for (int32_t x = rx0; x < rx1; ++x)
+                {
+                    const float dx = static_cast<float>(x - gx0);
+                    if (edgeRow[0] + edgeA[0] * dx >= 0.0f && edgeRow[1] + edgeA[1] * dx >= 0.0f &&
+                        edgeRow[2] + edgeA[2] * dx >= 0.0f)
+                    {
+                        row[x] = std::min(row[x], zRow + tri.z[1] * dx);
+                    }
+                }
+#endif
+                for (int k = 0; k < 3; ++k)
+                    edgeRow[k] += edgeB[k];
+                zRow += tri.z[2];
+            }
+        }
+
+        // Farthest depth per block: a box nearer than this is guaranteed visible somewhere in the block
+        const uint32_t blocksX = width_ / kBlockSize;
+        for (int32_t by = tileY0; by < tileY1; by += kBlockSize)
+        {
+            for (int32_t bx = tileX0; bx < tileX1; bx += kBlockSize)
+            {
+                float farthest = 0.0f;
+                for (uint32_t y = 0; y < kBlockSize; ++y)
+                {
+                    const float* row = depth + static_cast<std::size_t>(by + y) * width_ + bx;
+                    for (uint32_t x = 0; x < kBlockSize; ++x)
+                        farthest = std::max(farthest, row[x]);
+                }
+                hiz_[(by / kBlockSize) * blocksX + bx / kBlockSize] = farthest;
+            }
+        }
+    }
+
+    OcclusionCuller::TestResult OcclusionCuller::Classify(const OcclusionAABB& box) const
+    {
+        float minX = 1e30f, minY = 1e30f, minZ = 1e30f;
+        float maxX = -1e30f, maxY = -1e30f;
+        for (int i = 0; i < 8; ++i)
+        {
+            float clip[4];
+            TransformPoint(viewProj_, (i & 1) ? box.max[0] : box.min[0], (i & 2) ? box.max[1] : box.min[1],
+                           (i & 4) ? box.max[2] : box.min[2], clip);
+            // Corner behind the near plane: the camera is at or inside the box, never cull
+            if (clip[3] <= kNearW || clip[2] < -clip[3])
+                return TestResult::Visible;
+            const float invW = 1.0f / clip[3];
+            minX = std::min(minX, clip[0] * invW);
+            maxX = std::max(maxX, clip[0] * invW);
+            minY = std::min(minY, clip[1] * invW);
+            maxY = std::max(maxY, clip[1] * invW);
+            minZ = std::min(minZ, clip[2] * invW);
+        }
+        if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f || minZ > 1.0f)
+            return TestResult::FrustumCulled;
+
+        const float nearest = std::max(minZ * 0.5f + 0.5f, 0.0f);
+        const int32_t w = static_cast<int32_t>(width_), h = static_cast<int32_t>(height_);
+        const int32_t x0 = std::clamp(static_cast<int32_t>(std::floor((minX * 0.5f + 0.5f) * w)), 0, w - 1);
+        const int32_t x1 = std::clamp(static_cast<int32_t>(std::floor((maxX * 0.5f + 0.5f) * w)), 0, w - 1);
+        const int32_t y0 = std::clamp(static_cast<int32_t>(std::floor((minY * 0.5f + 0.5f) * h)), 0, h - 1);
+        const int32_t y1 = std::clamp(static_cast<int32_t>(std::floor((maxY * 0.5f + 0.5f) * h)), 0, h - 1);
+
+        const uint32_t blocksX = width_ / kBlockSize;
+        for (int32_t by = y0 / static_cast<int32_t>(kBlockSize); by <= y1 / static_cast<int32_t>(kBlockSize); ++by)
+        {
+            for (int32_t bx = x0 / static_cast<int32_t>(kBlockSize); bx <= x1 / static_cast<int32_t>(kBlockSize); ++bx)
+            {
+                if (hiz_[by * blocksX + bx] < nearest)
+                    continue;
+
+                // Block is inconclusive: compare the pixels the box actually covers
+                const int32_t px0 = std::max(x0, bx * static_cast<int32_t>(kBlockSize));
+                const int32_t px1 = std::min(x1, bx * static_cast<int32_t>(kBlockSize) + static_cast<int32_t>(kBlockSize) - 1);
+                const int32_t py0 = std::max(y0, by * static_cast<int32_t>(kBlockSize));
+                const int32_t py1 = std::min(y1, by * static_cast<int32_t>(kBlockSize) + static_cast<int32_t>(kBlockSize) - 1);
+                for (int32_t y = py0; y <= py1; ++y)
+                {
+                    const float* row = depth_.data() + static_cast<std::size_t>(y) * width_;
+                    int32_t x = px0;
+#if defined(SOULENGINE_OCCLUSION_SSE2)
+                    const __m128 nearest4 = _mm_set1_ps(nearest);
+                    for (; x + 3 <= px1; x += 4)
+                    {
+                        if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(row + x), nearest4)))
+                            return TestResult::Visible;
+                    }
+#endif
+                    for (; x <= px1; ++x)
+                    {
+                        if (row[x] >= nearest)
+                            return TestResult::Visible;
+                    }
+                }
+            }
+        }
+        return TestResult::Occluded;
+    }
+
+    bool OcclusionCuller::TestAABB(const OcclusionAABB& box) const
+    {
+        tested_.fetch_add(1, std::memory_order_relaxed);
+        switch (Classify(box))
+        {
+        case TestResult::FrustumCulled:
+            frustumCulled_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        case TestResult::Occluded:
+            occlusionCulled_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        default:
+            return true;
+        }
+    }
+
+    void OcclusionCuller::TestAABBs(const OcclusionAABB* boxes, uint32_t count, uint8_t* visible)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        JobSystem::GetInstance().ParallelFor(count, 256, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i)
+                visible[i] = TestAABB(boxes[i]) ? 1 : 0;
+        });
+        stats_.testMs += ElapsedMs(start);
+    }
+
+    const OcclusionCullingStats& OcclusionCuller::GetStats() const
+    {
+        stats_.testedObjects = tested_.load();
+        stats_.frustumCulled = frustumCulled_.load();
+        stats_.occlusionCulled = occlusionCulled_.load();
+        stats_.visibleObjects = stats_.testedObjects - stats_.frustumCulled - stats_.occlusionCulled;
+        return stats_;
+    }
+} // namespace SoulEngine
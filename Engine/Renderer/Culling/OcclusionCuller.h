@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "Define.h"
+
+namespace SoulEngine
+{
+    struct OcclusionAABB
+    {
+        float min[3];
+        float max[3];
+    };
+
+    // Per-frame counters, reset by BeginFrame
+    struct OcclusionCullingStats
+    {
+        uint32_t occluderMeshes = 0;
+        uint32_t occluderTriangles = 0;     // submitted
+        uint32_t rasterizedTriangles = 0;   // after clipping and back-face culling
+        uint32_t testedObjects = 0;
+        uint32_t frustumCulled = 0;
+        uint32_t occlusionCulled = 0;
+        uint32_t visibleObjects = 0;
+        double rasterMs = 0.0;
+        double testMs = 0.0;
+
+        uint32_t GetCulledCount() const { return frustumCulled + occlusionCulled; }
+    };
+
+    /**
+     * @brief 纯 CPU 遮挡剔除
+     * 选定的遮挡体网格被光栅化到低分辨率深度缓冲（按分块在任务系统上并行，SSE2 每次处理 4 像素），
+     * 同时生成 8x8 块的最远深度层级；物体 AABB 先与层级比较，无法判定时才逐像素比较。
+     * 深度约定与 GL 一致：裁剪空间 z/w 映射到 [0,1]，越小越近；矩阵为列主序 float[16]。
+     *
+     * 使用方式:
+     *   culler.BeginFrame(viewProj);
+     *   culler.AddOccluder(positions, stride, indices, indexCount, model);
+     *   culler.RenderOccluders();
+     *   if (culler.TestAABB(box)) context->DrawIndexed(...);
+     */
+    class OcclusionCuller
+    {
+        NON_COPY_AND_MOVE(OcclusionCuller)
+
+    public:
+        // width/height are rounded up to multiples of the 8x8 hierarchy block
+        explicit OcclusionCuller(uint32_t width = 320, uint32_t height = 192);
+        ~OcclusionCuller() = default;
+
+        void Resize(uint32_t width, uint32_t height);
+
+        // Clears the depth buffer and stats, and captures the camera for this frame
+        void BeginFrame(const float viewProj[16]);
+
+        // positions are float3 at the given byte stride; model may be null for identity.
+        // Counter-clockwise triangles are front-facing; back faces are skipped when cullBackFaces is set.
+        void AddOccluder(const float* positions, uint32_t stride, const uint32_t* indices, uint32_t indexCount,
+                         const float model[16] = nullptr, bool cullBackFaces = true);
+
+        // Rasterizes all queued occluders and builds the depth hierarchy
+        void RenderOccluders();
+
+        // True when the box may be visible; thread-safe after RenderOccluders
+        bool TestAABB(const OcclusionAABB& box) const;
+        // Tests in parallel on the job system; visible[i] is 1 when boxes[i] may be visible
+        void TestAABBs(const OcclusionAABB* boxes, uint32_t count, uint8_t* visible);
+
+        const OcclusionCullingStats& GetStats() const;
+        uint32_t GetWidth() const { return width_; }
+        uint32_t GetHeight() const { return height_; }
+        const std::vector<float>& GetDepthBuffer() const { return depth_; }
+
+    private:
+        struct Triangle
+        {
+            float x[3], y[3];       // pixel coordinates
+            float z[3];             // value, d/dx, d/dy relative to (x[0], y[0])
+            int32_t minX, minY, maxX, maxY; // covered pixels, max exclusive
+        };
+
+        enum class TestResult : uint8_t { Visible, FrustumCulled, Occluded };
+
+        TestResult Classify(const OcclusionAABB& box) const;
+        void AddClipTriangle(const float* a, const float* b, const float* c, bool cullBackFaces);
+        void RasterizeTile(uint32_t tileIndex);
+
+        uint32_t width_ = 0;
+        uint32_t height_ = 0;
+        uint32_t tilesX_ = 0;
+        uint32_t tilesY_ = 0;
+        float viewProj_[16] = {};
+        std::vector<float> depth_;          // width_ * height_, bottom row first
+        std::vector<float> hiz_;            // farthest depth per 8x8 block
+        std::vector<Triangle> triangles_;
+        std::vector<std::vector<uint32_t>> bins_;
+        std::vector<float> clipScratch_;
+
+        mutable OcclusionCullingStats stats_{};
+        mutable std::atomic<uint32_t> tested_{ 0 };
+        mutable std::atomic<uint32_t> frustumCulled_{ 0 };
+        mutable std::atomic<uint32_t> occlusionCulled_{ 0 };
+    };
+} // namespace SoulEngine
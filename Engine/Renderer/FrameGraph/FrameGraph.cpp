@@ -0,0 +1,391 @@
+#include "Renderer/FrameGraph/FrameGraph.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+namespace SoulEngine
+{
+    namespace
+    {
+        std::size_t AlignUp(std::size_t v, std::size_t a)
+        {
+            return a > 1 ? (v + a - 1) / a * a : v;
+        }
+
+        bool Contains(const std::vector<uint32_t>& v, uint32_t x)
+        {
+            return std::find(v.begin(), v.end(), x) != v.end();
+        }
+    }
+
+    std::size_t FrameGraphResourceDesc::GetByteSize() const
+    {
+        if (type == FrameGraphResourceType::Buffer)
+            return size;
+        return static_cast<std::size_t>(width) * height * Gfx::GetDataFormatSize(format);
+    }
+
+    // ---------------------------------------------------------------- builder
+
+    FrameGraphResource FrameGraphBuilder::Create(const char* name, const FrameGraphResourceDesc& desc)
+    {
+        FrameGraphResource res = graph_.AddResource(name, desc, false, nullptr);
+        return Write(res);
+    }
+
+    FrameGraphResource FrameGraphBuilder::Read(FrameGraphResource res)
+    {
+        if (!res.IsValid() || res.index >= graph_.resources_.size())
+        {
+            Logger::Error("FrameGraph: pass '{}' reads an invalid resource", pass_.GetName());
+            return {};
+        }
+        if (!Contains(pass_.reads_, res.index))
+            pass_.reads_.push_back(res.index);
+        return res;
+    }
+
+    FrameGraphResource FrameGraphBuilder::Write(FrameGraphResource res)
+    {
+        if (!res.IsValid() || res.index >= graph_.resources_.size())
+        {
+            Logger::Error("FrameGraph: pass '{}' writes an invalid resource", pass_.GetName());
+            return {};
+        }
+        if (!Contains(pass_.writes_, res.index))
+        {
+            pass_.writes_.push_back(res.index);
+            graph_.resources_[res.index].writers.push_back(static_cast<uint32_t>(graph_.passes_.size() - 1));
+        }
+        // 写入导入资源（如后备缓冲）即为帧图的最终输出
+        if (graph_.resources_[res.index].imported)
+            pass_.sideEffect_ = true;
+        return res;
+    }
+
+    void FrameGraphBuilder::SetSideEffect()
+    {
+        pass_.sideEffect_ = true;
+    }
+
+    // ---------------------------------------------------------------- pass resources
+
+    const FrameGraphResourceDesc& FrameGraphPassResources::GetDesc(FrameGraphResource res) const
+    {
+        return graph_.resources_[res.index].desc;
+    }
+
+    void* FrameGraphPassResources::Get(FrameGraphResource res) const
+    {
+        if (!res.IsValid() || res.index >= graph_.resources_.size())
+            return nullptr;
+        if (!Contains(pass_.reads_, res.index) && !Contains(pass_.writes_, res.index))
+        {
+            Logger::Warn("FrameGraph: pass '{}' accesses undeclared resource '{}'", pass_.GetName(), graph_.resources_[res.index].name);
+            return nullptr;
+        }
+        return graph_.resources_[res.index].realized;
+    }
+
+    // ---------------------------------------------------------------- graph
+
+    FrameGraphResource FrameGraph::AddResource(const char* name, const FrameGraphResourceDesc& desc, bool imported, void* external)
+    {
+        ResourceNode node{};
+        node.name = name ? name : "";
+        node.desc = desc;
+        node.imported = imported;
+        node.external = external;
+        resources_.push_back(std::move(node));
+        compiled_ = false;
+        return FrameGraphResource{ static_cast<uint32_t>(resources_.size() - 1) };
+    }
+
+    FrameGraphResource FrameGraph::Import(const char* name, const FrameGraphResourceDesc& desc, void* external)
+    {
+        return AddResource(name, desc, true, external);
+    }
+
+    void FrameGraph::Reset()
+    {
+        passes_.clear();
+        resources_.clear();
+        order_.clear();
+        acquireAt_.clear();
+        releaseAt_.clear();
+        stats_ = FrameGraphStats{};
+        compiled_ = false;
+    }
+
+    bool FrameGraph::Compile()
+    {
+        stats_ = FrameGraphStats{};
+        stats_.passCount = static_cast<uint32_t>(passes_.size());
+        stats_.resourceCount = static_cast<uint32_t>(resources_.size());
+
+        CullPasses();
+        if (!SortPasses())
+            return false;
+        ComputeLifetimes();
+        AssignAliases();
+
+        compiled_ = true;
+        return true;
+    }
+
+    // 引用计数剔除：没有读者的资源递减其写入者的计数，计数归零且无副作用的 Pass 被剔除
+    void FrameGraph::CullPasses()
+    {
+        for (auto& pass : passes_)
+        {
+            pass->culled_ = false;
+            pass->refCount_ = static_cast<uint32_t>(pass->writes_.size()) + (pass->sideEffect_ ? 1u : 0u);
+        }
+        for (auto& res : resources_)
+        {
+            res.culled = false;
+            res.refCount = 0;
+        }
+        for (const auto& pass : passes_)
+        {
+            for (uint32_t r : pass->reads_)
+                ++resources_[r].refCount;
+        }
+
+        std::vector<uint32_t> unreferenced;
+        auto cullPass = [&](FrameGraphPassBase& pass) {
+            pass.culled_ = true;
+            for (uint32_t read : pass.reads_)
+            {
+                if (resources_[read].refCount > 0 && --resources_[read].refCount == 0 && !resources_[read].imported)
+                    unreferenced.push_back(read);
+            }
+        };
+
+        // 既无输出也无副作用的 Pass 直接剔除
+        for (auto& pass : passes_)
+        {
+            if (pass->refCount_ == 0)
+                cullPass(*pass);
+        }
+        for (uint32_t i = 0; i < resources_.size(); ++i)
+        {
+            if (resources_[i].refCount == 0 && !resources_[i].imported)
+                unreferenced.push_back(i);
+        }
+
+        while (!unreferenced.empty())
+        {
+            const uint32_t r = unreferenced.back();
+            unreferenced.pop_back();
+
+            for (uint32_t w : resources_[r].writers)
+            {
+                auto& writer = *passes_[w];
+                if (writer.culled_ || --writer.refCount_ > 0)
+                    continue;
+                cullPass(writer);
+            }
+        }
+
+        for (const auto& pass : passes_)
+            stats_.culledPassCount += pass->culled_ ? 1u : 0u;
+    }
+
+    // 依据读写冒险 (RAW/WAW/WAR) 建立依赖边后做稳定的拓扑排序，独立 Pass 保持声明顺序
+    bool FrameGraph::SortPasses()
+    {
+        const uint32_t passCount = static_cast<uint32_t>(passes_.size());
+        std::vector<std::vector<uint32_t>> edges(passCount);
+        std::vector<uint32_t> inDegree(passCount, 0);
+
+        auto addEdge = [&](uint32_t from, uint32_t to) {
+            if (from == to || Contains(edges[from], to))
+                return;
+            edges[from].push_back(to);
+            ++inDegree[to];
+        };
+
+        for (uint32_t r = 0; r < resources_.size(); ++r)
+        {
+            uint32_t lastWriter = UINT32_MAX;
+            std::vector<uint32_t> readers;
+            for (uint32_t p = 0; p < passCount; ++p)
+            {
+                const auto& pass = *passes_[p];
+                if (pass.culled_)
+                    continue;
+                if (Contains(pass.reads_, r))
+                {
+                    if (lastWriter != UINT32_MAX)
+                        addEdge(lastWriter, p);
+                    readers.push_back(p);
+                }
+                if (Contains(pass.writes_, r))
+                {
+                    if (lastWriter != UINT32_MAX)
+                        addEdge(lastWriter, p);
+                    for (uint32_t reader : readers)
+                        addEdge(reader, p);
+                    readers.clear();
+                    lastWriter = p;
+                }
+            }
+        }
+
+        order_.clear();
+        std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> ready;
+        uint32_t liveCount = 0;
+        for (uint32_t p = 0; p < passCount; ++p)
+        {
+            if (passes_[p]->culled_)
+                continue;
+            ++liveCount;
+            if (inDegree[p] == 0)
+                ready.push(p);
+        }
+        while (!ready.empty())
+        {
+            const uint32_t p = ready.top();
+            ready.pop();
+            order_.push_back(p);
+            for (uint32_t next : edges[p])
+            {
+                if (--inDegree[next] == 0)
+                    ready.push(next);
+            }
+        }
+
+        if (order_.size() != liveCount)
+        {
+            Logger::Error("FrameGraph: dependency cycle detected ({} of {} passes ordered)", order_.size(), liveCount);
+            return false;
+        }
+        return true;
+    }
+
+    void FrameGraph::ComputeLifetimes()
+    {
+        acquireAt_.assign(order_.size(), {});
+        releaseAt_.assign(order_.size(), {});
+        for (auto& res : resources_)
+        {
+            res.firstUse = UINT32_MAX;
+            res.lastUse = 0;
+        }
+
+        for (uint32_t pos = 0; pos < order_.size(); ++pos)
+        {
+            const auto& pass = *passes_[order_[pos]];
+            auto touch = [&](uint32_t r) {
+                auto& res = resources_[r];
+                res.firstUse = std::min(res.firstUse, pos);
+                res.lastUse = std::max(res.lastUse, pos);
+            };
+            for (uint32_t r : pass.reads_) touch(r);
+            for (uint32_t r : pass.writes_) touch(r);
+        }
+
+        for (uint32_t r = 0; r < resources_.size(); ++r)
+        {
+            auto& res = resources_[r];
+            if (res.firstUse == UINT32_MAX)
+            {
+                res.culled = !res.imported;
+                continue;
+            }
+            res.culled = false;
+            acquireAt_[res.firstUse].push_back(r);
+            releaseAt_[res.lastUse].push_back(r);
+        }
+
+        for (const auto& res : resources_)
+            stats_.culledResourceCount += res.culled ? 1u : 0u;
+    }
+
+    // 贪心首次适配：大资源优先放置，只与生命周期重叠的资源避开地址区间
+    void FrameGraph::AssignAliases()
+    {
+        std::vector<uint32_t> transient;
+        for (uint32_t r = 0; r < resources_.size(); ++r)
+        {
+            const auto& res = resources_[r];
+            if (res.imported || res.culled)
+                continue;
+            transient.push_back(r);
+            // 与池内放置使用相同的对齐，使 transientBytes 与 pooledBytes 可直接比较
+            stats_.transientBytes += AlignUp(res.desc.GetByteSize(), res.desc.alignment);
+        }
+        stats_.transientCount = static_cast<uint32_t>(transient.size());
+
+        std::stable_sort(transient.begin(), transient.end(), [&](uint32_t a, uint32_t b) {
+            return resources_[a].desc.GetByteSize() > resources_[b].desc.GetByteSize();
+        });
+
+        struct Range { std::size_t begin, end; };
+        std::vector<uint32_t> placed;
+        std::vector<Range> busy;
+        for (uint32_t r : transient)
+        {
+            auto& res = resources_[r];
+            const std::size_t size = res.desc.GetByteSize();
+
+            busy.clear();
+            for (uint32_t other : placed)
+            {
+                const auto& o = resources_[other];
+                const bool overlapsInTime = o.firstUse <= res.lastUse && res.firstUse <= o.lastUse;
+                if (overlapsInTime)
+                    busy.push_back({ o.poolOffset, o.poolOffset + o.desc.GetByteSize() });
+            }
+            std::sort(busy.begin(), busy.end(), [](const Range& a, const Range& b) { return a.begin < b.begin; });
+
+            std::size_t offset = 0;
+            for (const Range& range : busy)
+            {
+                if (offset + size <= range.begin)
+                    break;
+                offset = std::max(offset, AlignUp(range.end, res.desc.alignment));
+            }
+            res.poolOffset = offset;
+            stats_.pooledBytes = std::max(stats_.pooledBytes, offset + size);
+            placed.push_back(r);
+        }
+    }
+
+    void FrameGraph::Execute(IFrameGraphAllocator* allocator)
+    {
+        if (!compiled_ && !Compile())
+            return;
+
+        if (allocator)
+            allocator->BeginFrame(stats_.pooledBytes);
+
+        for (uint32_t pos = 0; pos < order_.size(); ++pos)
+        {
+            for (uint32_t r : acquireAt_[pos])
+            {
+                auto& res = resources_[r];
+                if (res.imported)
+                    res.realized = res.external;
+                else
+                    res.realized = allocator ? allocator->Acquire(res.name.c_str(), res.desc, res.poolOffset) : nullptr;
+            }
+
+            const auto& pass = *passes_[order_[pos]];
+            pass.Execute(FrameGraphPassResources(*this, pass));
+
+            for (uint32_t r : releaseAt_[pos])
+            {
+                auto& res = resources_[r];
+                if (!res.imported && allocator && res.realized)
+                    allocator->Release(res.realized);
+                res.realized = nullptr;
+            }
+        }
+
+        if (allocator)
+            allocator->EndFrame();
+    }
+} // namespace SoulEngine
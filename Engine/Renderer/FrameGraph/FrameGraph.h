@@ -0,0 +1,220 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Define.h"
+#include "Renderer/Gfx.h"
+
+namespace SoulEngine
+{
+    enum class FrameGraphResourceType : uint8_t { Buffer, Texture };
+
+    struct FrameGraphResourceDesc
+    {
+        FrameGraphResourceType type = FrameGraphResourceType::Texture;
+        uint32_t width = 0;                 // textures
+        uint32_t height = 0;                // textures
+        Gfx::DataFormat format = Gfx::DataFormat::R8G8B8A8_UNorm;
+        std::size_t size = 0;               // buffers, in bytes
+        std::size_t alignment = 256;        // placement alignment inside the transient pool
+
+        // 纹理按 width*height*格式大小 估算，缓冲直接使用 size
+        std::size_t GetByteSize() const;
+    };
+
+    struct FrameGraphResource
+    {
+        uint32_t index = UINT32_MAX;
+        bool IsValid() const { return index != UINT32_MAX; }
+        bool operator==(const FrameGraphResource& o) const { return index == o.index; }
+        bool operator!=(const FrameGraphResource& o) const { return index != o.index; }
+    };
+
+    struct FrameGraphStats
+    {
+        uint32_t passCount = 0;
+        uint32_t culledPassCount = 0;
+        uint32_t resourceCount = 0;
+        uint32_t culledResourceCount = 0;
+        uint32_t transientCount = 0;        // live transient resources after culling
+        std::size_t transientBytes = 0;     // sum of aligned live transient sizes, i.e. without aliasing
+        std::size_t pooledBytes = 0;        // size of the aliased transient pool
+        std::size_t GetSavedBytes() const { return transientBytes - pooledBytes; }
+    };
+
+    /**
+     * @brief 瞬态资源的实际分配者（由后端实现）
+     * 编译阶段只计算池内偏移；执行时才通过该接口把虚拟资源映射为具体对象。
+     * 不提供分配器时资源解析为 nullptr，便于在无 GPU 的环境下运行帧图。
+     */
+    class IFrameGraphAllocator
+    {
+    public:
+        virtual ~IFrameGraphAllocator() = default;
+        virtual void BeginFrame(std::size_t poolBytes) = 0;
+        virtual void* Acquire(const char* name, const FrameGraphResourceDesc& desc, std::size_t poolOffset) = 0;
+        virtual void Release(void* resource) = 0;
+        virtual void EndFrame() = 0;
+    };
+
+    class FrameGraph;
+    class FrameGraphPassBase;
+
+    /**
+     * @brief 执行阶段传给 Pass 的资源访问器
+     */
+    class FrameGraphPassResources
+    {
+    public:
+        FrameGraphPassResources(const FrameGraph& graph, const FrameGraphPassBase& pass) : graph_(graph), pass_(pass) {}
+
+        const FrameGraphResourceDesc& GetDesc(FrameGraphResource res) const;
+        void* Get(FrameGraphResource res) const;
+
+        template <class T>
+        T* Get(FrameGraphResource res) const { return static_cast<T*>(Get(res)); }
+
+    private:
+        const FrameGraph& graph_;
+        const FrameGraphPassBase& pass_;
+    };
+
+    /**
+     * @brief Pass 声明阶段使用的构建器，记录对虚拟资源的创建/读/写
+     */
+    class FrameGraphBuilder
+    {
+    public:
+        FrameGraphBuilder(FrameGraph& graph, FrameGraphPassBase& pass) : graph_(graph), pass_(pass) {}
+
+        FrameGraphResource Create(const char* name, const FrameGraphResourceDesc& desc);
+        FrameGraphResource Read(FrameGraphResource res);
+        FrameGraphResource Write(FrameGraphResource res);
+
+        // 标记该 Pass 有外部可见副作用，永不被剔除
+        void SetSideEffect();
+
+    private:
+        FrameGraph& graph_;
+        FrameGraphPassBase& pass_;
+    };
+
+    class FrameGraphPassBase
+    {
+    public:
+        explicit FrameGraphPassBase(const char* name) : name_(name ? name : "") {}
+        virtual ~FrameGraphPassBase() = default;
+
+        const std::string& GetName() const { return name_; }
+        bool IsCulled() const { return culled_; }
+
+    protected:
+        virtual void Execute(const FrameGraphPassResources& resources) const = 0;
+
+    private:
+        friend class FrameGraph;
+        friend class FrameGraphBuilder;
+        friend class FrameGraphPassResources;
+
+        std::string name_;
+        std::vector<uint32_t> reads_;
+        std::vector<uint32_t> writes_;
+        bool sideEffect_ = false;
+        bool culled_ = false;
+        uint32_t refCount_ = 0;
+    };
+
+    template <class Data, class ExecuteFn>
+    class FrameGraphPass final : public FrameGraphPassBase
+    {
+    public:
+        FrameGraphPass(const char* name, ExecuteFn&& fn) : FrameGraphPassBase(name), execute_(std::move(fn)) {}
+
+        Data data{};
+
+    protected:
+        void Execute(const FrameGraphPassResources& resources) const override { execute_(data, resources); }
+
+    private:
+        ExecuteFn execute_;
+    };
+
+    /**
+     * @brief 帧图：Pass 声明对虚拟资源的读写，Compile 剔除无用 Pass、排序、
+     * 计算资源生命周期并在瞬态内存池中为不重叠的资源做别名分配。
+     *
+     * 使用方式:
+     *   graph.AddPass<GBufferData>("GBuffer",
+     *       [&](FrameGraphBuilder& b, GBufferData& d) { d.albedo = b.Create("Albedo", desc); },
+     *       [=](const GBufferData& d, const FrameGraphPassResources& r) { ... });
+     *   graph.Compile();
+     *   graph.Execute(allocator);
+     */
+    class FrameGraph
+    {
+        NON_COPY_AND_MOVE(FrameGraph)
+
+    public:
+        FrameGraph() = default;
+        ~FrameGraph() = default;
+
+        template <class Data, class SetupFn, class ExecuteFn>
+        const Data& AddPass(const char* name, SetupFn&& setup, ExecuteFn&& execute);
+
+        // 导入外部资源（如后备缓冲），不参与别名分配；写入导入资源的 Pass 视为输出
+        FrameGraphResource Import(const char* name, const FrameGraphResourceDesc& desc, void* external);
+
+        bool Compile();
+        void Execute(IFrameGraphAllocator* allocator = nullptr);
+
+        // 清空所有 Pass 与资源，供下一帧重新声明
+        void Reset();
+
+        const FrameGraphStats& GetStats() const { return stats_; }
+        const std::vector<uint32_t>& GetExecutionOrder() const { return order_; }
+        const FrameGraphPassBase& GetPass(uint32_t index) const { return *passes_[index]; }
+        uint32_t GetPassCount() const { return static_cast<uint32_t>(passes_.size()); }
+
+        const FrameGraphResourceDesc& GetResourceDesc(FrameGraphResource res) const { return resources_[res.index].desc; }
+        const std::string& GetResourceName(FrameGraphResource res) const { return resources_[res.index].name; }
+        bool IsResourceCulled(FrameGraphResource res) const { return resources_[res.index].culled; }
+        std::size_t GetPoolOffset(FrameGraphResource res) const { return resources_[res.index].poolOffset; }
+
+    private:
+        friend class FrameGraphBuilder;
+        friend class FrameGraphPassResources;
+
+        struct ResourceNode
+        {
+            std::string name;
+            FrameGraphResourceDesc desc{};
+            bool imported = false;
+            void* external = nullptr;
+            std::vector<uint32_t> writers;      // passes that create or write the resource
+            uint32_t refCount = 0;              // number of live readers
+            bool culled = false;
+            uint32_t firstUse = UINT32_MAX;     // position in order_
+            uint32_t lastUse = 0;
+            std::size_t poolOffset = 0;
+            void* realized = nullptr;
+        };
+
+        FrameGraphResource AddResource(const char* name, const FrameGraphResourceDesc& desc, bool imported, void* external);
+        void CullPasses();
+        bool SortPasses();
+        void ComputeLifetimes();
+        void AssignAliases();
+
+        std::vector<std::unique_ptr<FrameGraphPassBase>> passes_;
+        std::vector<ResourceNode> resources_;
+        std::vector<uint32_t> order_;
+        std::vector<std::vector<uint32_t>> acquireAt_;  // per order_ position
+        std::vector<std::vector<uint32_t>> releaseAt_;
+        FrameGraphStats stats_{};
+        bool compiled_ = false;
+    };
+} // namespace SoulEngine
+
+#include "Renderer/FrameGraph/FrameGraph.inl"
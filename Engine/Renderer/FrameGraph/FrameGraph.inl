@@ -0,0 +1,28 @@
+// FrameGraph.inl - template implementations for FrameGraph
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+namespace SoulEngine
+{
+
+template <class Data, class SetupFn, class ExecuteFn>
+const Data& FrameGraph::AddPass(const char* name, SetupFn&& setup, ExecuteFn&& execute)
+{
+    static_assert(std::is_invocable_v<SetupFn, FrameGraphBuilder&, Data&>, "setup must be callable as (FrameGraphBuilder&, Data&)");
+    static_assert(std::is_invocable_v<ExecuteFn, const Data&, const FrameGraphPassResources&>,
+                  "execute must be callable as (const Data&, const FrameGraphPassResources&)");
+
+    using PassType = FrameGraphPass<Data, std::decay_t<ExecuteFn>>;
+    auto pass = std::make_unique<PassType>(name, std::decay_t<ExecuteFn>(std::forward<ExecuteFn>(execute)));
+    PassType* raw = pass.get();
+    passes_.push_back(std::move(pass));
+    compiled_ = false;
+
+    FrameGraphBuilder builder(*this, *raw);
+    setup(builder, raw->data);
+    return raw->data;
+}
+
+} // namespace SoulEngine
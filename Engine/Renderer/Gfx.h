@@ -38,8 +38,94 @@ namespace SoulEngine::Gfx
         R32G32B32_Float,
         R32G32B32A32_Float,
         R8G8B8A8_UNorm,
+        // Compact vertex formats (see Renderer/GfxPackedFormats.h for the conversions)
+        R16G16_Float,
+        R16G16B16A16_Float,
+        R16G16_SNorm,
+        R16G16B16A16_SNorm,
+        R16G16_UNorm,
+        R16G16B16A16_UNorm,
+        R8G8_SNorm,
+        R8G8B8A8_SNorm,
+        R10G10B10A2_UNorm,
+        R10G10B10A2_SNorm,
+        // Octahedral unit vectors: fetched as two snorm components, decoded to xyz by the vertex stage
+        R16G16_SNorm_Oct,
+        R8G8_SNorm_Oct,
+        // Texture-only formats
+        R8_UNorm,
+        R8G8_UNorm,
+        R8G8B8A8_SRGB,
+        BC1_UNorm,
+        BC1_SRGB,
+        BC3_UNorm,
+        BC3_SRGB,
+        BC4_UNorm,
+        BC5_UNorm,
+        BC7_UNorm,
+        BC7_SRGB,
     };
 
+    inline uint32_t GetDataFormatSize(DataFormat fmt)
+    {
+        switch (fmt)
+        {
+        case DataFormat::R32_Float:          return 4;
+        case DataFormat::R32G32_Float:       return 8;
+        case DataFormat::R32G32B32_Float:    return 12;
+        case DataFormat::R32G32B32A32_Float: return 16;
+        case DataFormat::R8G8B8A8_UNorm:     return 4;
+        case DataFormat::R16G16_Float:       return 4;
+        case DataFormat::R16G16B16A16_Float: return 8;
+        case DataFormat::R16G16_SNorm:       return 4;
+        case DataFormat::R16G16B16A16_SNorm: return 8;
+        case DataFormat::R16G16_UNorm:       return 4;
+        case DataFormat::R16G16B16A16_UNorm: return 8;
+        case DataFormat::R8G8_SNorm:         return 2;
+        case DataFormat::R8G8B8A8_SNorm:     return 4;
+        case DataFormat::R10G10B10A2_UNorm:  return 4;
+        case DataFormat::R10G10B10A2_SNorm:  return 4;
+        case DataFormat::R16G16_SNorm_Oct:   return 4;
+        case DataFormat::R8G8_SNorm_Oct:     return 2;
+        case DataFormat::R8_UNorm:           return 1;
+        case DataFormat::R8G8_UNorm:         return 2;
+        case DataFormat::R8G8B8A8_SRGB:      return 4;
+        default: return 0;
+        }
+    }
+
+    inline bool IsBlockCompressed(DataFormat fmt)
+    {
+        return fmt >= DataFormat::BC1_UNorm && fmt <= DataFormat::BC7_SRGB;
+    }
+
+    // Bytes per 4x4 block for BC formats, per texel otherwise
+    inline uint32_t GetFormatBlockBytes(DataFormat fmt)
+    {
+        switch (fmt)
+        {
+        case DataFormat::BC1_UNorm:
+        case DataFormat::BC1_SRGB:
+        case DataFormat::BC4_UNorm: return 8;
+        case DataFormat::BC3_UNorm:
+        case DataFormat::BC3_SRGB:
+        case DataFormat::BC5_UNorm:
+        case DataFormat::BC7_UNorm:
+        case DataFormat::BC7_SRGB:  return 16;
+        default: return GetDataFormatSize(fmt);
+        }
+    }
+
+    // Tightly packed size of one layer of a mip level with the given dimensions
+    inline std::size_t GetTextureLevelSize(DataFormat fmt, uint32_t width, uint32_t height)
+    {
+        width = width ? width : 1;
+        height = height ? height : 1;
+        if (IsBlockCompressed(fmt))
+            return static_cast<std::size_t>((width + 3) / 4) * ((height + 3) / 4) * GetFormatBlockBytes(fmt);
+        return static_cast<std::size_t>(width) * height * GetDataFormatSize(fmt);
+    }
+
     enum class ShaderStage : uint8_t { Vertex, Fragment, Geometry, Compute };
 
     struct BufferDesc
@@ -63,6 +149,64 @@ namespace SoulEngine::Gfx
 
     enum class MapMode : uint8_t { Read, Write, WriteDiscard, WriteNoOverwrite };
 
+    enum class TextureType : uint8_t { Texture2D, Texture2DArray };
+
+    struct TextureDesc
+    {
+        TextureType type = TextureType::Texture2D;
+        DataFormat format = DataFormat::R8G8B8A8_UNorm;
+        uint32_t width = 1;
+        uint32_t height = 1;
+        uint32_t arrayLayers = 1;
+        uint32_t mipLevels = 1;
+        const char* name = nullptr;         // debug name
+    };
+
+    inline uint32_t GetMipLevelCount(uint32_t width, uint32_t height)
+    {
+        uint32_t levels = 1;
+        for (uint32_t size = width > height ? width : height; size > 1; size >>= 1)
+            ++levels;
+        return levels;
+    }
+
+    enum class FilterMode : uint8_t { Nearest, Linear };
+    enum class AddressMode : uint8_t { Repeat, MirroredRepeat, ClampToEdge, ClampToBorder };
+
+    struct SamplerDesc
+    {
+        FilterMode minFilter = FilterMode::Linear;
+        FilterMode magFilter = FilterMode::Linear;
+        FilterMode mipFilter = FilterMode::Linear;
+        AddressMode addressU = AddressMode::Repeat;
+        AddressMode addressV = AddressMode::Repeat;
+        AddressMode addressW = AddressMode::Repeat;
+        float maxAnisotropy = 1.0f;         // > 1 enables anisotropic filtering where supported
+        float mipLodBias = 0.0f;
+        float minLod = 0.0f;
+        float maxLod = 1000.0f;
+        float borderColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    };
+
+    inline bool operator==(const SamplerDesc& a, const SamplerDesc& b)
+    {
+        return a.minFilter == b.minFilter && a.magFilter == b.magFilter && a.mipFilter == b.mipFilter &&
+               a.addressU == b.addressU && a.addressV == b.addressV && a.addressW == b.addressW &&
+               a.maxAnisotropy == b.maxAnisotropy && a.mipLodBias == b.mipLodBias && a.minLod == b.minLod &&
+               a.maxLod == b.maxLod && a.borderColor[0] == b.borderColor[0] && a.borderColor[1] == b.borderColor[1] &&
+               a.borderColor[2] == b.borderColor[2] && a.borderColor[3] == b.borderColor[3];
+    }
+
+    // Matches the GL/D3D12 indexed indirect argument layout (20 bytes, tightly packed)
+    struct DrawIndexedIndirectArgs
+    {
+        uint32_t indexCount = 0;
+        uint32_t instanceCount = 1;
+        uint32_t firstIndex = 0;
+        int32_t  baseVertex = 0;
+        uint32_t baseInstance = 0;
+    };
+
     struct VertexAttribute
     {
         uint32_t location; 
@@ -93,9 +237,22 @@ namespace SoulEngine::Gfx
         int location = -1; // usually a uniform location
     };
 
+    struct UniformBlockInfo {
+        std::string name;
+        uint32_t index = 0;
+        uint32_t size = 0; // bytes, as reported by the backend
+    };
+
     struct ProgramReflection {
         std::vector<UniformInfo> uniforms;
         std::vector<SamplerInfo> samplers;
+        std::vector<UniformBlockInfo> uniformBlocks;
+    };
+
+    // Resolved once via IProgram::GetUniformHandle; invalid handles are ignored by setters
+    struct UniformHandle {
+        int32_t location = -1;
+        bool IsValid() const { return location >= 0; }
     };
 
 
@@ -110,6 +267,20 @@ namespace SoulEngine::Gfx
         virtual void Unmap() = 0;
     };
 
+    class ITexture {
+    public:
+        virtual ~ITexture() = default;
+        virtual const TextureDesc& GetDesc() const = 0;
+        // data holds one tightly packed layer of the mip level (GetTextureLevelSize bytes)
+        virtual void UpdateLevel(uint32_t mipLevel, uint32_t arrayLayer, const void* data, std::size_t size) = 0;
+    };
+
+    class ISampler {
+    public:
+        virtual ~ISampler() = default;
+        virtual const SamplerDesc& GetDesc() const = 0;
+    };
+
     class IVertexInputLayout {
     public:
         virtual ~IVertexInputLayout() = default;
@@ -133,6 +304,49 @@ namespace SoulEngine::Gfx
         virtual void SetVec3(const char* name, const float* v3) = 0;
         virtual void SetVec4(const char* name, const float* v4) = 0;
         virtual void SetMat4(const char* name, const float* m16, bool transpose=false) = 0;
+
+        // Handle-based setters skip the name lookup on every call
+        virtual UniformHandle GetUniformHandle(const char* name) const = 0;
+        virtual void SetInt(UniformHandle h, int v) = 0;
+        virtual void SetFloat(UniformHandle h, float v) = 0;
+        virtual void SetVec2(UniformHandle h, const float* v2) = 0;
+        virtual void SetVec3(UniformHandle h, const float* v3) = 0;
+        virtual void SetVec4(UniformHandle h, const float* v4) = 0;
+        virtual void SetMat4(UniformHandle h, const float* m16, bool transpose=false) = 0;
+
+        // Routes a named uniform block to a constant buffer slot used by IContext::SetConstantBuffer
+        virtual void BindUniformBlock(const char* blockName, uint32_t slot) = 0;
+    };
+
+    enum class PolygonMode : uint8_t { Fill, Line, Point };
+    enum class CullMode : uint8_t { None, Front, Back };
+    enum class BlendMode : uint8_t { None, Alpha, Additive };
+    enum class CompareFunc : uint8_t { Never, Less, Equal, LessEqual, Greater, NotEqual, GreaterEqual, Always };
+
+    // Immutable bundle of program, input layout and fixed-function state.
+    // Defaults match the GL context defaults so an empty desc is a no-op.
+    struct PipelineStateDesc
+    {
+        std::shared_ptr<IProgram> program;
+        std::shared_ptr<IVertexInputLayout> inputLayout;
+        PolygonMode polygonMode = PolygonMode::Fill;
+        CullMode    cullMode    = CullMode::None;
+        BlendMode   blendMode   = BlendMode::None;
+        bool        depthTest   = false;
+        bool        depthWrite  = true;
+        CompareFunc depthFunc   = CompareFunc::Less;
+        const char* name = nullptr;           // debug name, not part of the hash
+    };
+
+    std::size_t HashPipelineStateDesc(const PipelineStateDesc& desc);
+    bool operator==(const PipelineStateDesc& a, const PipelineStateDesc& b);
+    inline bool operator!=(const PipelineStateDesc& a, const PipelineStateDesc& b) { return !(a == b); }
+
+    class IPipelineState {
+    public:
+        virtual ~IPipelineState() = default;
+        virtual const PipelineStateDesc& GetDesc() const = 0;
+        virtual std::size_t GetHash() const = 0;
     };
 
     class IDevice {
@@ -144,11 +358,23 @@ namespace SoulEngine::Gfx
         virtual std::shared_ptr<IProgram> CreateProgram(const std::shared_ptr<IShaderModule>& vs,
                                                        const std::shared_ptr<IShaderModule>& fs,
                                                        const char* name = nullptr) = 0;
+        // Equal descs return the same cached object
+        virtual std::shared_ptr<IPipelineState> CreatePipelineState(const PipelineStateDesc& desc) = 0;
+        // Releases cached pipeline states (and the programs / layouts they hold) that no caller references any more;
+        // returns how many were released. Renderers call it once per frame.
+        virtual std::size_t TrimPipelineStates() = 0;
+        // initial (optional) holds arrayLayers * mipLevels entries, layer-major: [layer * mipLevels + mip].
+        // Returns null when the backend cannot sample the format.
+        virtual std::shared_ptr<ITexture> CreateTexture(const TextureDesc& desc, const SubresourceData* initial) = 0;
+        // Equal descs return the same cached object
+        virtual std::shared_ptr<ISampler> CreateSampler(const SamplerDesc& desc) = 0;
     };
 
-    enum class PolygonMode : uint8_t { Fill, Line, Point };
-    enum class CullMode : uint8_t { None, Front, Back };
-    enum class BlendMode : uint8_t { None, Alpha, Additive };
+    // Binding slot ranges. GL has a single texture-unit space for textures and buffer textures, so storage-buffer
+    // slot N lives on unit kStorageBufferUnitBase + N, after every texture slot (32 units, within GL 3.3's 48).
+    constexpr uint32_t kMaxTextureSlots = 16;
+    constexpr uint32_t kMaxStorageBufferSlots = 16;
+    constexpr uint32_t kStorageBufferUnitBase = kMaxTextureSlots;
 
     class IContext {
     public:
@@ -156,8 +382,16 @@ namespace SoulEngine::Gfx
         virtual void SetVertexBuffers(uint32_t startSlot, IBuffer* const* buffers, const uint32_t* strides, const uint32_t* offsets, uint32_t count) = 0;
         virtual void SetIndexBuffer(IBuffer* buffer, IndexFormat fmt) = 0;
         virtual void SetConstantBuffer(uint32_t stage, uint32_t slot, IBuffer* buffer) = 0;
+        // Read-only BufferKind::Storage buffer for both stages, slot < kMaxStorageBufferSlots. Storage slots are
+        // numbered independently of texture slots; on GL the buffer is a usamplerBuffer (texelFetch) on texture unit
+        // kStorageBufferUnitBase + slot, so point the sampler uniform there: IProgram::SetTexture(name, kStorageBufferUnitBase + slot).
+        virtual void SetStorageBuffer(uint32_t slot, IBuffer* buffer) = 0;
+        // Binds texture and sampler to texture unit slot; pair it with IProgram::SetTexture(name, slot)
+        virtual void SetTexture(uint32_t slot, ITexture* texture, ISampler* sampler) = 0;
         virtual void SetVertexInputLayout(IVertexInputLayout* layout) = 0;
         virtual void BindProgram(IProgram* program) = 0;
+        // Applies only the state that differs from the currently bound pipeline
+        virtual void SetPipelineState(IPipelineState* pipeline) = 0;
         
         // 渲染状态设置
         virtual void SetPolygonMode(PolygonMode mode) = 0;
@@ -168,6 +402,10 @@ namespace SoulEngine::Gfx
         
         virtual void Draw(uint32_t vertexCount, uint32_t startVertex) = 0;
         virtual void DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex) = 0;
+        // Arguments are DrawIndexedIndirectArgs read from a BufferKind::Indirect buffer at byteOffset
+        virtual void DrawIndexedIndirect(IBuffer* argsBuffer, uint32_t byteOffset) = 0;
+        virtual void MultiDrawIndexedIndirect(IBuffer* argsBuffer, uint32_t byteOffset, uint32_t drawCount,
+                                              uint32_t stride = sizeof(DrawIndexedIndirectArgs)) = 0;
 
     };
 
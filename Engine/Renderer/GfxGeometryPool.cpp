@@ -0,0 +1,423 @@
+#include "Renderer/GfxGeometryPool.h"
+#include "Renderer/GfxIndirectDrawBuilder.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace SoulEngine::Gfx
+{
+    // ---- RangeAllocator ----
+
+    void RangeAllocator::Reset(uint32_t capacity)
+    {
+        freeByOffset_.clear();
+        freeBySize_.clear();
+        capacity_ = capacity;
+        used_ = 0;
+        if (capacity > 0)
+            InsertFree(0, capacity);
+    }
+
+    void RangeAllocator::Grow(uint32_t newCapacity)
+    {
+        if (newCapacity <= capacity_)
+            return;
+        const uint32_t oldCapacity = capacity_;
+        capacity_ = newCapacity;
+        // Free() already merges with the neighbouring blocks; account for the range as if it had been allocated
+        used_ += newCapacity - oldCapacity;
+        Free(oldCapacity, newCapacity - oldCapacity);
+    }
+
+    uint32_t RangeAllocator::Allocate(uint32_t size)
+    {
+        if (size == 0)
+            return kInvalidOffset;
+        auto bySize = freeBySize_.lower_bound(size);
+        if (bySize == freeBySize_.end())
+            return kInvalidOffset;
+
+        const uint32_t offset = bySize->second;
+        const uint32_t blockSize = bySize->first;
+        EraseFree(freeByOffset_.find(offset));
+        if (blockSize > size)
+            InsertFree(offset + size, blockSize - size);
+        used_ += size;
+        return offset;
+    }
+
+    void RangeAllocator::Free(uint32_t offset, uint32_t size)
+    {
+        if (size == 0)
+            return;
+        used_ -= size;
+
+        auto next = freeByOffset_.lower_bound(offset);
+        if (next != freeByOffset_.begin())
+        {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == offset)
+            {
+                offset = prev->first;
+                size += prev->second;
+                EraseFree(prev);
+            }
+        }
+        if (next != freeByOffset_.end() && offset + size == next->first)
+        {
+            size += next->second;
+            EraseFree(next);
+        }
+        InsertFree(offset, size);
+    }
+
+    uint32_t RangeAllocator::GetLargestFreeBlock() const
+    {
+        return freeBySize_.empty() ? 0u : freeBySize_.rbegin()->first;
+    }
+
+    void RangeAllocator::InsertFree(uint32_t offset, uint32_t size)
+    {
+        freeByOffset_.emplace(offset, size);
+        freeBySize_.emplace(size, offset);
+    }
+
+    void RangeAllocator::EraseFree(std::map<uint32_t, uint32_t>::iterator it)
+    {
+        auto range = freeBySize_.equal_range(it->second);
+        for (auto s = range.first; s != range.second; ++s)
+        {
+            if (s->second == it->first)
+            {
+                freeBySize_.erase(s);
+                break;
+            }
+        }
+        freeByOffset_.erase(it);
+    }
+
+    // ---- GeometryPool ----
+
+    GeometryPool::GeometryPool(IDevice* device, const GeometryPoolDesc& desc)
+        : device_(device), desc_(desc)
+    {
+        if (desc_.vertexStrides.empty())
+            Logger::Error("GeometryPool '{}': no vertex streams", desc_.name ? desc_.name : "");
+        if (desc_.vertexStrides.size() > kMaxPoolStreams)
+        {
+            Logger::Warn("GeometryPool '{}': {} vertex streams, only the first {} are pooled",
+                         desc_.name ? desc_.name : "", desc_.vertexStrides.size(), kMaxPoolStreams);
+            desc_.vertexStrides.resize(kMaxPoolStreams);
+        }
+
+        vertexShadow_.resize(desc_.vertexStrides.size());
+        for (size_t i = 0; i < desc_.vertexStrides.size(); ++i)
+            vertexShadow_[i].resize(static_cast<size_t>(desc_.vertexCapacity) * desc_.vertexStrides[i]);
+        indexShadow_.resize(static_cast<size_t>(desc_.indexCapacity) * GetIndexSize());
+        vertexAllocator_.Reset(desc_.vertexCapacity);
+        indexAllocator_.Reset(desc_.indexCapacity);
+        CreateBuffers();
+    }
+
+    void GeometryPool::CreateBuffers()
+    {
+        vertexBuffers_.resize(desc_.vertexStrides.size());
+        for (size_t i = 0; i < desc_.vertexStrides.size(); ++i)
+        {
+            BufferDesc bd{};
+            bd.size = vertexShadow_[i].size();
+            bd.kind = BufferKind::Vertex;
+            bd.stride = desc_.vertexStrides[i];
+            bd.cpuAccess = CpuAccessFlags::Write;
+            bd.name = desc_.name;
+            SubresourceData init{ vertexShadow_[i].data(), vertexShadow_[i].size(), 0 };
+            vertexBuffers_[i] = device_->CreateBuffer(bd, &init);
+        }
+
+        BufferDesc ib{};
+        ib.size = indexShadow_.size();
+        ib.kind = BufferKind::Index;
+        ib.indexFormat = desc_.indexFormat;
+        ib.cpuAccess = CpuAccessFlags::Write;
+        ib.name = desc_.name;
+        SubresourceData init{ indexShadow_.data(), indexShadow_.size(), 0 };
+        indexBuffer_ = device_->CreateBuffer(ib, &init);
+        ++bufferVersion_;
+    }
+
+    void GeometryPool::Upload(uint32_t stream, uint32_t firstVertex, uint32_t vertexCount)
+    {
+        if (vertexCount == 0)
+            return;
+        const size_t stride = desc_.vertexStrides[stream];
+        const size_t offset = firstVertex * stride;
+        SubresourceData src{ vertexShadow_[stream].data() + offset, vertexCount * stride, offset };
+        vertexBuffers_[stream]->Update(src);
+    }
+
+    void GeometryPool::UploadIndices(uint32_t firstIndex, uint32_t indexCount)
+    {
+        if (indexCount == 0)
+            return;
+        const size_t offset = static_cast<size_t>(firstIndex) * GetIndexSize();
+        SubresourceData src{ indexShadow_.data() + offset, static_cast<size_t>(indexCount) * GetIndexSize(), offset };
+        indexBuffer_->Update(src);
+    }
+
+    bool GeometryPool::Reserve(uint32_t vertexCount, uint32_t indexCount, uint32_t& vertexOffset, uint32_t& indexOffset)
+    {
+        auto tryAllocate = [&]() {
+            vertexOffset = vertexAllocator_.Allocate(vertexCount);
+            if (vertexOffset == RangeAllocator::kInvalidOffset)
+                return false;
+            indexOffset = indexAllocator_.Allocate(indexCount);
+            if (indexOffset == RangeAllocator::kInvalidOffset)
+            {
+                vertexAllocator_.Free(vertexOffset, vertexCount);
+                return false;
+            }
+            return true;
+        };
+
+        if (tryAllocate())
+            return true;
+
+        // Enough space in total but fragmented: compact and retry
+        const bool vertexFits = vertexAllocator_.GetCapacity() - vertexAllocator_.GetUsed() >= vertexCount;
+        const bool indexFits = indexAllocator_.GetCapacity() - indexAllocator_.GetUsed() >= indexCount;
+        if (vertexFits && indexFits)
+        {
+            Defragment();
+            if (tryAllocate())
+                return true;
+        }
+
+        if (!desc_.allowGrowth)
+            return false;
+
+        // Doubling until the appended tail alone fits keeps the new range contiguous without another compaction.
+        // Done in 64 bits so a capacity past 2^31 cannot wrap to zero and spin forever.
+        auto grownCapacity = [](uint32_t capacity, uint32_t count) {
+            uint64_t grown = std::max<uint64_t>(capacity, 1);
+            while (grown - capacity < count)
+                grown *= 2;
+            return grown;
+        };
+        const uint64_t vertexCapacity64 = grownCapacity(vertexAllocator_.GetCapacity(), vertexCount);
+        const uint64_t indexCapacity64 = grownCapacity(indexAllocator_.GetCapacity(), indexCount);
+        if (vertexCapacity64 > UINT32_MAX || indexCapacity64 > UINT32_MAX)
+        {
+            Logger::Error("GeometryPool '{}': growing to {} vertices / {} indices exceeds 32-bit offsets",
+                          desc_.name ? desc_.name : "", vertexCapacity64, indexCapacity64);
+            return false;
+        }
+        const uint32_t newVertexCapacity = static_cast<uint32_t>(vertexCapacity64);
+        const uint32_t newIndexCapacity = static_cast<uint32_t>(indexCapacity64);
+
+        Logger::Log("GeometryPool '{}': growing to {} vertices / {} indices",
+                    desc_.name ? desc_.name : "", newVertexCapacity, newIndexCapacity);
+        vertexAllocator_.Grow(newVertexCapacity);
+        indexAllocator_.Grow(newIndexCapacity);
+        for (size_t i = 0; i < vertexShadow_.size(); ++i)
+            vertexShadow_[i].resize(static_cast<size_t>(newVertexCapacity) * desc_.vertexStrides[i]);
+        indexShadow_.resize(static_cast<size_t>(newIndexCapacity) * GetIndexSize());
+        desc_.vertexCapacity = newVertexCapacity;
+        desc_.indexCapacity = newIndexCapacity;
+        CreateBuffers();
+        ++growths_;
+
+        return tryAllocate();
+    }
+
+    MeshHandle GeometryPool::Allocate(const void* const* streams, uint32_t vertexCount, const void* indices, uint32_t indexCount)
+    {
+        if (vertexCount == 0 || indexCount == 0 || !streams || !indices)
+            return {};
+
+        uint32_t vertexOffset = 0;
+        uint32_t indexOffset = 0;
+        if (!Reserve(vertexCount, indexCount, vertexOffset, indexOffset))
+        {
+            Logger::Error("GeometryPool '{}': out of space for {} vertices / {} indices",
+                          desc_.name ? desc_.name : "", vertexCount, indexCount);
+            return {};
+        }
+
+        for (size_t i = 0; i < vertexShadow_.size(); ++i)
+        {
+            const size_t stride = desc_.vertexStrides[i];
+            std::memcpy(vertexShadow_[i].data() + vertexOffset * stride, streams[i], vertexCount * stride);
+            Upload(static_cast<uint32_t>(i), vertexOffset, vertexCount);
+        }
+        std::memcpy(indexShadow_.data() + static_cast<size_t>(indexOffset) * GetIndexSize(), indices,
+                    static_cast<size_t>(indexCount) * GetIndexSize());
+        UploadIndices(indexOffset, indexCount);
+
+        uint32_t index;
+        if (!freeSlots_.empty())
+        {
+            index = freeSlots_.back();
+            freeSlots_.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+
+        Slot& slot = slots_[index];
+        slot.alive = true;
+        slot.vertexOffset = vertexOffset;
+        slot.range.firstIndex = indexOffset;
+        slot.range.indexCount = indexCount;
+        slot.range.baseVertex = static_cast<int32_t>(vertexOffset);
+        slot.range.vertexCount = vertexCount;
+        ++meshCount_;
+        return MeshHandle{ index, slot.generation };
+    }
+
+    void GeometryPool::Free(MeshHandle handle)
+    {
+        if (!IsAlive(handle))
+            return;
+        Slot& slot = slots_[handle.index];
+        vertexAllocator_.Free(slot.vertexOffset, slot.range.vertexCount);
+        indexAllocator_.Free(slot.range.firstIndex, slot.range.indexCount);
+        slot.alive = false;
+        ++slot.generation;
+        freeSlots_.push_back(handle.index);
+        --meshCount_;
+    }
+
+    bool GeometryPool::IsAlive(MeshHandle handle) const
+    {
+        return handle.index < slots_.size() && slots_[handle.index].alive &&
+               slots_[handle.index].generation == handle.generation;
+    }
+
+    const MeshRange* GeometryPool::GetRange(MeshHandle handle) const
+    {
+        return IsAlive(handle) ? &slots_[handle.index].range : nullptr;
+    }
+
+    uint64_t GeometryPool::Defragment()
+    {
+        std::vector<uint32_t> order;
+        order.reserve(meshCount_);
+        for (uint32_t i = 0; i < slots_.size(); ++i)
+            if (slots_[i].alive)
+                order.push_back(i);
+
+        uint64_t moved = 0;
+
+        // Vertices: slide every live range down in address order, so memmove never overwrites unread data
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return slots_[a].vertexOffset < slots_[b].vertexOffset; });
+        uint32_t cursor = 0;
+        uint32_t firstMoved = UINT32_MAX;
+        for (uint32_t i : order)
+        {
+            Slot& slot = slots_[i];
+            if (slot.vertexOffset != cursor)
+            {
+                for (size_t s = 0; s < vertexShadow_.size(); ++s)
+                {
+                    const size_t stride = desc_.vertexStrides[s];
+                    std::memmove(vertexShadow_[s].data() + cursor * stride, vertexShadow_[s].data() + slot.vertexOffset * stride,
+                                 slot.range.vertexCount * stride);
+                }
+                firstMoved = std::min(firstMoved, cursor);
+                slot.vertexOffset = cursor;
+                slot.range.baseVertex = static_cast<int32_t>(cursor);
+            }
+            cursor += slot.range.vertexCount;
+        }
+        const uint32_t usedVertices = cursor;
+        if (firstMoved != UINT32_MAX)
+        {
+            for (size_t s = 0; s < vertexShadow_.size(); ++s)
+            {
+                Upload(static_cast<uint32_t>(s), firstMoved, usedVertices - firstMoved);
+                moved += static_cast<uint64_t>(usedVertices - firstMoved) * desc_.vertexStrides[s];
+            }
+        }
+
+        // Indices are mesh-local, so they move verbatim
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return slots_[a].range.firstIndex < slots_[b].range.firstIndex; });
+        const uint32_t indexSize = GetIndexSize();
+        cursor = 0;
+        firstMoved = UINT32_MAX;
+        for (uint32_t i : order)
+        {
+            MeshRange& range = slots_[i].range;
+            if (range.firstIndex != cursor)
+            {
+                std::memmove(indexShadow_.data() + static_cast<size_t>(cursor) * indexSize,
+                             indexShadow_.data() + static_cast<size_t>(range.firstIndex) * indexSize,
+                             static_cast<size_t>(range.indexCount) * indexSize);
+                firstMoved = std::min(firstMoved, cursor);
+                range.firstIndex = cursor;
+            }
+            cursor += range.indexCount;
+        }
+        const uint32_t usedIndices = cursor;
+        if (firstMoved != UINT32_MAX)
+        {
+            UploadIndices(firstMoved, usedIndices - firstMoved);
+            moved += static_cast<uint64_t>(usedIndices - firstMoved) * indexSize;
+        }
+
+        // Live data is now one block at the front of each range
+        vertexAllocator_.Reset(vertexAllocator_.GetCapacity());
+        indexAllocator_.Reset(indexAllocator_.GetCapacity());
+        if (usedVertices > 0)
+            vertexAllocator_.Allocate(usedVertices);
+        if (usedIndices > 0)
+            indexAllocator_.Allocate(usedIndices);
+
+        ++defragmentations_;
+        bytesMoved_ += moved;
+        return moved;
+    }
+
+    void GeometryPool::Bind(IContext* context) const
+    {
+        IBuffer* buffers[kMaxPoolStreams];
+        uint32_t offsets[kMaxPoolStreams] = {};
+        const uint32_t count = static_cast<uint32_t>(vertexBuffers_.size());
+        for (uint32_t i = 0; i < count; ++i)
+            buffers[i] = vertexBuffers_[i].get();
+        context->SetVertexBuffers(0, buffers, desc_.vertexStrides.data(), offsets, count);
+        context->SetIndexBuffer(indexBuffer_.get(), desc_.indexFormat);
+    }
+
+    void GeometryPool::Draw(IContext* context, MeshHandle handle) const
+    {
+        const MeshRange* range = GetRange(handle);
+        if (range)
+            context->DrawIndexed(range->indexCount, range->firstIndex, range->baseVertex);
+    }
+
+    bool GeometryPool::AppendIndirect(IndirectDrawBuilder& builder, MeshHandle handle, uint32_t instanceCount, uint32_t baseInstance) const
+    {
+        const MeshRange* range = GetRange(handle);
+        if (!range)
+            return false;
+        return builder.Add(range->indexCount, range->firstIndex, range->baseVertex, instanceCount, baseInstance);
+    }
+
+    GeometryPoolStats GeometryPool::GetStats() const
+    {
+        GeometryPoolStats stats;
+        stats.meshCount = meshCount_;
+        stats.usedVertices = vertexAllocator_.GetUsed();
+        stats.vertexCapacity = vertexAllocator_.GetCapacity();
+        stats.usedIndices = indexAllocator_.GetUsed();
+        stats.indexCapacity = indexAllocator_.GetCapacity();
+        stats.vertexFreeBlocks = vertexAllocator_.GetFreeBlockCount();
+        stats.indexFreeBlocks = indexAllocator_.GetFreeBlockCount();
+        stats.defragmentations = defragmentations_;
+        stats.growths = growths_;
+        stats.bytesMoved = bytesMoved_;
+        return stats;
+    }
+}
@@ -0,0 +1,155 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+#include "Renderer/Gfx.h"
+
+namespace SoulEngine::Gfx
+{
+    class IndirectDrawBuilder;
+
+    constexpr uint32_t kMaxPoolStreams = 8;
+
+    // Best-fit free-list over an abstract [0, capacity) range of elements.
+    // Free blocks are indexed by offset (for coalescing) and by size (for best-fit lookup).
+    class RangeAllocator
+    {
+    public:
+        static constexpr uint32_t kInvalidOffset = UINT32_MAX;
+
+        explicit RangeAllocator(uint32_t capacity = 0) { Reset(capacity); }
+
+        void Reset(uint32_t capacity);
+        // Extends the range; the new tail merges with a trailing free block
+        void Grow(uint32_t newCapacity);
+
+        uint32_t Allocate(uint32_t size);
+        void Free(uint32_t offset, uint32_t size);
+
+        uint32_t GetCapacity() const { return capacity_; }
+        uint32_t GetUsed() const { return used_; }
+        uint32_t GetFreeBlockCount() const { return static_cast<uint32_t>(freeByOffset_.size()); }
+        uint32_t GetLargestFreeBlock() const;
+
+    private:
+        void InsertFree(uint32_t offset, uint32_t size);
+        void EraseFree(std::map<uint32_t, uint32_t>::iterator it);
+
+        std::map<uint32_t, uint32_t> freeByOffset_;        // offset -> size
+        std::multimap<uint32_t, uint32_t> freeBySize_;     // size -> offset
+        uint32_t capacity_ = 0;
+        uint32_t used_ = 0;
+    };
+
+    struct GeometryPoolDesc
+    {
+        std::vector<uint32_t> vertexStrides;   // one pooled vertex buffer per stream (at most kMaxPoolStreams), bound to slots 0..N-1
+        uint32_t vertexCapacity = 1u << 16;    // in vertices
+        uint32_t indexCapacity = 1u << 18;     // in indices
+        IndexFormat indexFormat = IndexFormat::UInt32;
+        bool allowGrowth = true;               // reallocate the buffers (doubling) when defragmenting is not enough
+        const char* name = nullptr;
+    };
+
+    // Stable reference to a pooled mesh; offsets are looked up through the pool so defragmentation stays transparent
+    struct MeshHandle
+    {
+        uint32_t index = UINT32_MAX;
+        uint32_t generation = 0;
+        bool IsValid() const { return index != UINT32_MAX; }
+    };
+
+    struct MeshRange
+    {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        int32_t baseVertex = 0;
+        uint32_t vertexCount = 0;
+    };
+
+    struct GeometryPoolStats
+    {
+        uint32_t meshCount = 0;
+        uint32_t usedVertices = 0;
+        uint32_t vertexCapacity = 0;
+        uint32_t usedIndices = 0;
+        uint32_t indexCapacity = 0;
+        uint32_t vertexFreeBlocks = 0;
+        uint32_t indexFreeBlocks = 0;
+        uint32_t defragmentations = 0;
+        uint32_t growths = 0;
+        uint64_t bytesMoved = 0;
+    };
+
+    /**
+     * @brief 统一几何缓冲池
+     * 多个网格从少量大顶点/索引缓冲中子分配：索引保持网格局部编号，绘制时通过 firstIndex + baseVertex 定位，
+     * 所以切换网格不需要重新绑定缓冲。系统内存中保留一份镜像用于碎片整理与扩容时的数据搬移。
+     *
+     * 使用方式:
+     *   MeshHandle quad = pool.Allocate(streams, 4, indices, 6);
+     *   pool.Bind(context);                 // 每帧一次
+     *   pool.Draw(context, quad);           // 任意多个网格，无缓冲切换
+     */
+    class GeometryPool
+    {
+    public:
+        GeometryPool(IDevice* device, const GeometryPoolDesc& desc);
+        ~GeometryPool() = default;
+
+        GeometryPool(const GeometryPool&) = delete;
+        GeometryPool& operator=(const GeometryPool&) = delete;
+
+        // streams[i] points to vertexCount elements of vertexStrides[i] bytes; indices use the pool index format
+        MeshHandle Allocate(const void* const* streams, uint32_t vertexCount, const void* indices, uint32_t indexCount);
+        void Free(MeshHandle handle);
+        bool IsAlive(MeshHandle handle) const;
+        const MeshRange* GetRange(MeshHandle handle) const;
+
+        // Packs all live meshes to the start of the buffers; returns the number of bytes re-uploaded
+        uint64_t Defragment();
+
+        // Binds the pooled vertex streams to slots 0..N-1 and the pooled index buffer
+        void Bind(IContext* context) const;
+        void Draw(IContext* context, MeshHandle handle) const;
+        bool AppendIndirect(IndirectDrawBuilder& builder, MeshHandle handle, uint32_t instanceCount = 1, uint32_t baseInstance = 0) const;
+
+        IBuffer* GetVertexBuffer(uint32_t stream) const { return vertexBuffers_[stream].get(); }
+        IBuffer* GetIndexBuffer() const { return indexBuffer_.get(); }
+        // Bumped whenever the buffers are recreated by growth, so cached bindings can be refreshed
+        uint32_t GetBufferVersion() const { return bufferVersion_; }
+        GeometryPoolStats GetStats() const;
+
+    private:
+        struct Slot
+        {
+            MeshRange range;
+            uint32_t vertexOffset = 0;
+            uint32_t generation = 0;
+            bool alive = false;
+        };
+
+        bool Reserve(uint32_t vertexCount, uint32_t indexCount, uint32_t& vertexOffset, uint32_t& indexOffset);
+        void CreateBuffers();
+        void Upload(uint32_t stream, uint32_t firstVertex, uint32_t vertexCount);
+        void UploadIndices(uint32_t firstIndex, uint32_t indexCount);
+        uint32_t GetIndexSize() const { return desc_.indexFormat == IndexFormat::UInt16 ? 2u : 4u; }
+
+        IDevice* device_ = nullptr;
+        GeometryPoolDesc desc_;
+        std::vector<std::shared_ptr<IBuffer>> vertexBuffers_;
+        std::shared_ptr<IBuffer> indexBuffer_;
+        std::vector<std::vector<uint8_t>> vertexShadow_;
+        std::vector<uint8_t> indexShadow_;
+        RangeAllocator vertexAllocator_;
+        RangeAllocator indexAllocator_;
+        std::vector<Slot> slots_;
+        std::vector<uint32_t> freeSlots_;
+        uint32_t meshCount_ = 0;
+        uint32_t bufferVersion_ = 0;
+        uint32_t defragmentations_ = 0;
+        uint32_t growths_ = 0;
+        uint64_t bytesMoved_ = 0;
+    };
+}
@@ -0,0 +1,53 @@
+#include "Renderer/GfxIndirectDrawBuilder.h"
+#include "Log/Logger.h"
+
+namespace SoulEngine::Gfx
+{
+    IndirectDrawBuilder::IndirectDrawBuilder(IBuffer* argsBuffer)
+        : buffer_(argsBuffer)
+    {
+        if (buffer_)
+            capacity_ = static_cast<uint32_t>(buffer_->GetDesc().size / sizeof(DrawIndexedIndirectArgs));
+    }
+
+    IndirectDrawBuilder::~IndirectDrawBuilder()
+    {
+        if (IsMapped())
+            End();
+    }
+
+    bool IndirectDrawBuilder::Begin(MapMode mode)
+    {
+        if (!buffer_ || IsMapped())
+            return false;
+        if (buffer_->GetDesc().kind != BufferKind::Indirect)
+            Logger::Warn("IndirectDrawBuilder: buffer '{}' is not an indirect buffer", buffer_->GetDesc().name ? buffer_->GetDesc().name : "");
+        cursor_ = static_cast<DrawIndexedIndirectArgs*>(buffer_->Map(mode));
+        count_ = 0;
+        return cursor_ != nullptr;
+    }
+
+    bool IndirectDrawBuilder::Add(const DrawIndexedIndirectArgs& args)
+    {
+        if (!cursor_ || count_ >= capacity_)
+            return false;
+        cursor_[count_++] = args;
+        return true;
+    }
+
+    bool IndirectDrawBuilder::Add(uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex,
+                                  uint32_t instanceCount, uint32_t baseInstance)
+    {
+        return Add(DrawIndexedIndirectArgs{ indexCount, instanceCount, firstIndex, baseVertex, baseInstance });
+    }
+
+    uint32_t IndirectDrawBuilder::End()
+    {
+        if (IsMapped())
+        {
+            buffer_->Unmap();
+            cursor_ = nullptr;
+        }
+        return count_;
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include "Renderer/Gfx.h"
+
+namespace SoulEngine::Gfx
+{
+    // Writes DrawIndexedIndirectArgs straight into a mapped BufferKind::Indirect buffer.
+    // Usage: Begin() -> Add() per draw -> End() -> IContext::MultiDrawIndexedIndirect(buffer, 0, count).
+    class IndirectDrawBuilder
+    {
+    public:
+        explicit IndirectDrawBuilder(IBuffer* argsBuffer);
+        ~IndirectDrawBuilder();
+
+        bool Begin(MapMode mode = MapMode::WriteDiscard);
+        bool Add(const DrawIndexedIndirectArgs& args);
+        bool Add(uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex,
+                 uint32_t instanceCount = 1, uint32_t baseInstance = 0);
+        // Unmaps the buffer and returns the number of records written
+        uint32_t End();
+
+        bool IsMapped() const { return cursor_ != nullptr; }
+        uint32_t GetDrawCount() const { return count_; }
+        uint32_t GetCapacity() const { return capacity_; }
+        IBuffer* GetBuffer() const { return buffer_; }
+
+    private:
+        IBuffer* buffer_ = nullptr;
+        DrawIndexedIndirectArgs* cursor_ = nullptr;
+        uint32_t count_ = 0;
+        uint32_t capacity_ = 0;
+    };
+}
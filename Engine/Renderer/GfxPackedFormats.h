@@ -0,0 +1,243 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "Renderer/Gfx.h"
+
+// Scalar conversions for the compact vertex formats in Gfx::DataFormat.
+// Signed normalized values follow the GL 4.2 / D3D rule: decode = max(c / (2^(b-1) - 1), -1).
+
+namespace SoulEngine::Gfx
+{
+    inline uint32_t FloatBits(float f) { uint32_t u; std::memcpy(&u, &f, 4); return u; }
+    inline float BitsToFloat(uint32_t u) { float f; std::memcpy(&f, &u, 4); return f; }
+
+    // IEEE binary16, round-to-nearest-even; overflow goes to infinity and NaN stays NaN
+    inline uint16_t FloatToHalf(float value)
+    {
+        uint32_t f = FloatBits(value);
+        const uint32_t sign = f & 0x80000000u;
+        f ^= sign;
+
+        uint32_t h;
+        if (f >= (127u + 16u) << 23)
+        {
+            h = f > 0x7F800000u ? 0x7E00u : 0x7C00u;
+        }
+        else if (f < (127u - 14u) << 23)
+        {
+            // Subnormal result: let the FPU round by adding a magic value that aligns the mantissa
+            const uint32_t magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+            h = FloatBits(BitsToFloat(f) + BitsToFloat(magic)) - magic;
+        }
+        else
+        {
+            const uint32_t mantissaOdd = (f >> 13) & 1u;
+            f += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFFu;
+            f += mantissaOdd;
+            h = f >> 13;
+        }
+        return static_cast<uint16_t>(h | (sign >> 16));
+    }
+
+    inline float HalfToFloat(uint16_t half)
+    {
+        const uint32_t shiftedExp = 0x7C00u << 13;
+        uint32_t o = (half & 0x7FFFu) << 13;
+        const uint32_t exp = shiftedExp & o;
+        o += (127u - 15u) << 23;
+        if (exp == shiftedExp)
+        {
+            o += (128u - 16u) << 23;                 // Inf/NaN
+        }
+        else if (exp == 0)
+        {
+            o += 1u << 23;                           // zero/subnormal: renormalize
+            o = FloatBits(BitsToFloat(o) - BitsToFloat(113u << 23));
+        }
+        return BitsToFloat(o | (static_cast<uint32_t>(half & 0x8000u) << 16));
+    }
+
+    inline int16_t PackSNorm16(float v)
+    {
+        v = v < -1.0f ? -1.0f : (v > 1.0f ? 1.0f : v);
+        return static_cast<int16_t>(std::lrintf(v * 32767.0f));
+    }
+
+    inline float UnpackSNorm16(int16_t v)
+    {
+        const float f = static_cast<float>(v) * (1.0f / 32767.0f);
+        return f < -1.0f ? -1.0f : f;
+    }
+
+    inline uint16_t PackUNorm16(float v)
+    {
+        v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+        return static_cast<uint16_t>(std::lrintf(v * 65535.0f));
+    }
+
+    inline float UnpackUNorm16(uint16_t v) { return static_cast<float>(v) * (1.0f / 65535.0f); }
+
+    inline int8_t PackSNorm8(float v)
+    {
+        v = v < -1.0f ? -1.0f : (v > 1.0f ? 1.0f : v);
+        return static_cast<int8_t>(std::lrintf(v * 127.0f));
+    }
+
+    inline float UnpackSNorm8(int8_t v)
+    {
+        const float f = static_cast<float>(v) * (1.0f / 127.0f);
+        return f < -1.0f ? -1.0f : f;
+    }
+
+    inline uint8_t PackUNorm8(float v)
+    {
+        v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+        return static_cast<uint8_t>(std::lrintf(v * 255.0f));
+    }
+
+    // x in bits 0-9, y in 10-19, z in 20-29, w in 30-31 (GL_*_2_10_10_10_REV)
+    inline uint32_t PackR10G10B10A2SNorm(const float v[4])
+    {
+        auto q = [](float x, float range) {
+            x = x < -1.0f ? -1.0f : (x > 1.0f ? 1.0f : x);
+            return static_cast<uint32_t>(static_cast<int32_t>(std::lrintf(x * range)));
+        };
+        return (q(v[0], 511.0f) & 0x3FFu) | ((q(v[1], 511.0f) & 0x3FFu) << 10) |
+               ((q(v[2], 511.0f) & 0x3FFu) << 20) | ((q(v[3], 1.0f) & 0x3u) << 30);
+    }
+
+    inline void UnpackR10G10B10A2SNorm(uint32_t packed, float out[4])
+    {
+        // Shift each field to the top, then arithmetic-shift back to sign-extend it
+        const int32_t s = static_cast<int32_t>(packed);
+        const int32_t x = static_cast<int32_t>(static_cast<uint32_t>(s) << 22) >> 22;
+        const int32_t y = static_cast<int32_t>(static_cast<uint32_t>(s) << 12) >> 22;
+        const int32_t z = static_cast<int32_t>(static_cast<uint32_t>(s) << 2) >> 22;
+        const int32_t w = s >> 30;
+        out[0] = std::fmax(static_cast<float>(x) / 511.0f, -1.0f);
+        out[1] = std::fmax(static_cast<float>(y) / 511.0f, -1.0f);
+        out[2] = std::fmax(static_cast<float>(z) / 511.0f, -1.0f);
+        out[3] = std::fmax(static_cast<float>(w), -1.0f);
+    }
+
+    inline uint32_t PackR10G10B10A2UNorm(const float v[4])
+    {
+        auto q = [](float x, float range) {
+            x = x < 0.0f ? 0.0f : (x > 1.0f ? 1.0f : x);
+            return static_cast<uint32_t>(std::lrintf(x * range));
+        };
+        return q(v[0], 1023.0f) | (q(v[1], 1023.0f) << 10) | (q(v[2], 1023.0f) << 20) | (q(v[3], 3.0f) << 30);
+    }
+
+    inline void UnpackR10G10B10A2UNorm(uint32_t packed, float out[4])
+    {
+        out[0] = static_cast<float>(packed & 0x3FFu) / 1023.0f;
+        out[1] = static_cast<float>((packed >> 10) & 0x3FFu) / 1023.0f;
+        out[2] = static_cast<float>((packed >> 20) & 0x3FFu) / 1023.0f;
+        out[3] = static_cast<float>(packed >> 30) / 3.0f;
+    }
+
+    // Octahedral mapping of a unit vector to [-1,1]^2 (Meyer et al. 2010)
+    inline void OctEncode(const float n[3], float out[2])
+    {
+        const float invL1 = 1.0f / (std::fabs(n[0]) + std::fabs(n[1]) + std::fabs(n[2]) + 1e-20f);
+        float x = n[0] * invL1;
+        float y = n[1] * invL1;
+        if (n[2] < 0.0f)
+        {
+            const float ox = x;
+            x = (1.0f - std::fabs(y)) * (ox >= 0.0f ? 1.0f : -1.0f);
+            y = (1.0f - std::fabs(ox)) * (y >= 0.0f ? 1.0f : -1.0f);
+        }
+        out[0] = x;
+        out[1] = y;
+    }
+
+    // GLSL equivalent:
+    //   vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y)); float t = max(-n.z, 0.0);
+    //   n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0))); n = normalize(n);
+    inline void OctDecode(const float e[2], float out[3])
+    {
+        float x = e[0];
+        float y = e[1];
+        const float z = 1.0f - std::fabs(x) - std::fabs(y);
+        const float t = z < 0.0f ? -z : 0.0f;
+        x += x >= 0.0f ? -t : t;
+        y += y >= 0.0f ? -t : t;
+        const float invLen = 1.0f / std::sqrt(x * x + y * y + z * z);
+        out[0] = x * invLen;
+        out[1] = y * invLen;
+        out[2] = z * invLen;
+    }
+
+    // Decodes one vertex element into float4 as the input assembler would, filling missing
+    // components with (0,0,0,1). Octahedral formats are returned as their raw snorm pair.
+    inline void DecodeVertexFormat(DataFormat fmt, const uint8_t* src, float out[4])
+    {
+        out[0] = 0.0f; out[1] = 0.0f; out[2] = 0.0f; out[3] = 1.0f;
+        switch (fmt)
+        {
+        case DataFormat::R32_Float:          std::memcpy(out, src, 4); break;
+        case DataFormat::R32G32_Float:       std::memcpy(out, src, 8); break;
+        case DataFormat::R32G32B32_Float:    std::memcpy(out, src, 12); break;
+        case DataFormat::R32G32B32A32_Float: std::memcpy(out, src, 16); break;
+        case DataFormat::R8G8B8A8_UNorm:
+            for (int i = 0; i < 4; ++i)
+                out[i] = src[i] * (1.0f / 255.0f);
+            break;
+        case DataFormat::R16G16_Float:
+        case DataFormat::R16G16B16A16_Float:
+        {
+            const int n = fmt == DataFormat::R16G16_Float ? 2 : 4;
+            uint16_t h[4];
+            std::memcpy(h, src, n * 2);
+            for (int i = 0; i < n; ++i)
+                out[i] = HalfToFloat(h[i]);
+            break;
+        }
+        case DataFormat::R16G16_SNorm:
+        case DataFormat::R16G16B16A16_SNorm:
+        case DataFormat::R16G16_SNorm_Oct:
+        {
+            const int n = fmt == DataFormat::R16G16B16A16_SNorm ? 4 : 2;
+            int16_t v[4];
+            std::memcpy(v, src, n * 2);
+            for (int i = 0; i < n; ++i)
+                out[i] = UnpackSNorm16(v[i]);
+            break;
+        }
+        case DataFormat::R16G16_UNorm:
+        case DataFormat::R16G16B16A16_UNorm:
+        {
+            const int n = fmt == DataFormat::R16G16_UNorm ? 2 : 4;
+            uint16_t v[4];
+            std::memcpy(v, src, n * 2);
+            for (int i = 0; i < n; ++i)
+                out[i] = UnpackUNorm16(v[i]);
+            break;
+        }
+        case DataFormat::R8G8_SNorm:
+        case DataFormat::R8G8_SNorm_Oct:
+        case DataFormat::R8G8B8A8_SNorm:
+        {
+            const int n = fmt == DataFormat::R8G8B8A8_SNorm ? 4 : 2;
+            for (int i = 0; i < n; ++i)
+                out[i] = UnpackSNorm8(static_cast<int8_t>(src[i]));
+            break;
+        }
+        case DataFormat::R10G10B10A2_UNorm:
+        case DataFormat::R10G10B10A2_SNorm:
+        {
+            uint32_t packed;
+            std::memcpy(&packed, src, 4);
+            if (fmt == DataFormat::R10G10B10A2_UNorm)
+                UnpackR10G10B10A2UNorm(packed, out);
+            else
+                UnpackR10G10B10A2SNorm(packed, out);
+            break;
+        }
+        default: break;
+        }
+    }
+}
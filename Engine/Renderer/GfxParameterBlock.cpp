@@ -0,0 +1,129 @@
+#include "Renderer/GfxParameterBlock.h"
+#include "Log/Logger.h"
+#include <cstring>
+
+namespace SoulEngine::Gfx
+{
+    namespace
+    {
+        struct Std140Info { uint32_t size; uint32_t align; };
+
+        Std140Info GetStd140Info(UniformType type)
+        {
+            switch (type)
+            {
+            case UniformType::Float: return { 4, 4 };
+            case UniformType::Int:   return { 4, 4 };
+            case UniformType::Vec2:  return { 8, 8 };
+            case UniformType::Vec3:  return { 12, 16 };
+            case UniformType::Vec4:  return { 16, 16 };
+            case UniformType::Mat4:  return { 64, 16 };
+            default: return { 0, 4 };
+            }
+        }
+
+        uint32_t AlignUp(uint32_t v, uint32_t a) { return (v + a - 1) & ~(a - 1); }
+    }
+
+    ParameterBlockLayout& ParameterBlockLayout::Add(const char* name, UniformType type, uint32_t arraySize)
+    {
+        const Std140Info info = GetStd140Info(type);
+        Member m{};
+        m.name = name ? name : "";
+        m.type = type;
+        m.arraySize = arraySize > 0 ? arraySize : 1;
+        if (arraySize > 1)
+        {
+            // std140: array elements are padded to a vec4 stride
+            m.arrayStride = AlignUp(info.size, 16);
+            m.offset = AlignUp(cursor_, 16);
+            cursor_ = m.offset + m.arrayStride * m.arraySize;
+        }
+        else
+        {
+            m.offset = AlignUp(cursor_, info.align);
+            cursor_ = m.offset + info.size;
+        }
+        members_.push_back(std::move(m));
+        return *this;
+    }
+
+    uint32_t ParameterBlockLayout::GetSize() const
+    {
+        return AlignUp(cursor_ > 0 ? cursor_ : 16, 16);
+    }
+
+    int32_t ParameterBlockLayout::Find(const char* name) const
+    {
+        if (!name) return -1;
+        for (std::size_t i = 0; i < members_.size(); ++i)
+        {
+            if (members_[i].name == name)
+                return static_cast<int32_t>(i);
+        }
+        return -1;
+    }
+
+    ParameterBlock::ParameterBlock(IDevice* device, ParameterBlockLayout layout, const char* name)
+        : layout_(std::move(layout))
+    {
+        data_.assign(layout_.GetSize(), 0);
+        if (device)
+        {
+            BufferDesc desc{};
+            desc.size = data_.size();
+            desc.kind = BufferKind::Constant;
+            desc.usage = BufferUsage::Dynamic;
+            desc.bindFlags = BindFlags::ConstantBuffer;
+            desc.cpuAccess = CpuAccessFlags::Write;
+            desc.name = name;
+            buffer_ = device->CreateBuffer(desc, nullptr);
+        }
+    }
+
+    void ParameterBlock::Write(ParameterHandle h, uint32_t element, const void* src, uint32_t size)
+    {
+        const auto& members = layout_.GetMembers();
+        if (!h.IsValid() || static_cast<std::size_t>(h.index) >= members.size())
+            return;
+        const auto& m = members[static_cast<std::size_t>(h.index)];
+        if (element >= m.arraySize)
+        {
+            Logger::Warn("ParameterBlock: element {} out of range for '{}'", element, m.name);
+            return;
+        }
+        // A setter of the wrong type (e.g. SetMat4 on a float) must not spill into the next member or past the block
+        if (size > GetStd140Info(m.type).size)
+        {
+            Logger::Warn("ParameterBlock: {} bytes do not fit '{}'", size, m.name);
+            return;
+        }
+        uint8_t* dst = data_.data() + m.offset + element * m.arrayStride;
+        if (std::memcmp(dst, src, size) != 0)
+        {
+            std::memcpy(dst, src, size);
+            dirty_ = true;
+        }
+    }
+
+    void ParameterBlock::SetInt(ParameterHandle h, int v, uint32_t element) { Write(h, element, &v, sizeof(v)); }
+    void ParameterBlock::SetFloat(ParameterHandle h, float v, uint32_t element) { Write(h, element, &v, sizeof(v)); }
+    void ParameterBlock::SetVec2(ParameterHandle h, const float* v2, uint32_t element) { Write(h, element, v2, sizeof(float) * 2); }
+    void ParameterBlock::SetVec3(ParameterHandle h, const float* v3, uint32_t element) { Write(h, element, v3, sizeof(float) * 3); }
+    void ParameterBlock::SetVec4(ParameterHandle h, const float* v4, uint32_t element) { Write(h, element, v4, sizeof(float) * 4); }
+    void ParameterBlock::SetMat4(ParameterHandle h, const float* m16, uint32_t element) { Write(h, element, m16, sizeof(float) * 16); }
+
+    void ParameterBlock::Commit(IContext* context, uint32_t slot)
+    {
+        if (!buffer_)
+            return;
+        if (dirty_)
+        {
+            buffer_->Update(SubresourceData{ data_.data(), data_.size(), 0 });
+            dirty_ = false;
+            ++uploads_;
+        }
+        if (context)
+            context->SetConstantBuffer(0, slot, buffer_.get());
+    }
+}
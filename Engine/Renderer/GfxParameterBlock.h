@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Renderer/Gfx.h"
+
+namespace SoulEngine::Gfx
+{
+    // std140 member layout of a uniform block, built in declaration order
+    class ParameterBlockLayout
+    {
+    public:
+        struct Member
+        {
+            std::string name;
+            UniformType type = UniformType::Unknown;
+            uint32_t offset = 0;
+            uint32_t arraySize = 1;
+            uint32_t arrayStride = 0; // 0 for non-array members
+        };
+
+        ParameterBlockLayout& Add(const char* name, UniformType type, uint32_t arraySize = 1);
+
+        // Total block size, rounded up to a vec4 as std140 requires
+        uint32_t GetSize() const;
+        const std::vector<Member>& GetMembers() const { return members_; }
+        int32_t Find(const char* name) const;
+
+    private:
+        std::vector<Member> members_;
+        uint32_t cursor_ = 0;
+    };
+
+    struct ParameterHandle
+    {
+        int32_t index = -1;
+        bool IsValid() const { return index >= 0; }
+    };
+
+    // CPU-side std140 staging for one uniform block.
+    // Setters only touch the shadow copy; Commit uploads it with a single buffer write when dirty.
+    class ParameterBlock
+    {
+    public:
+        ParameterBlock(IDevice* device, ParameterBlockLayout layout, const char* name = nullptr);
+
+        ParameterHandle GetHandle(const char* name) const { return ParameterHandle{ layout_.Find(name) }; }
+
+        void SetInt(ParameterHandle h, int v, uint32_t element = 0);
+        void SetFloat(ParameterHandle h, float v, uint32_t element = 0);
+        void SetVec2(ParameterHandle h, const float* v2, uint32_t element = 0);
+        void SetVec3(ParameterHandle h, const float* v3, uint32_t element = 0);
+        void SetVec4(ParameterHandle h, const float* v4, uint32_t element = 0);
+        void SetMat4(ParameterHandle h, const float* m16, uint32_t element = 0);
+
+        // Upload pending changes and bind the block to the given constant buffer slot
+        void Commit(IContext* context, uint32_t slot);
+
+        IBuffer* GetBuffer() const { return buffer_.get(); }
+        const ParameterBlockLayout& GetLayout() const { return layout_; }
+        const uint8_t* GetData() const { return data_.data(); }
+        uint32_t GetSize() const { return static_cast<uint32_t>(data_.size()); }
+        uint64_t GetUploadCount() const { return uploads_; }
+
+    private:
+        void Write(ParameterHandle h, uint32_t element, const void* src, uint32_t size);
+
+        ParameterBlockLayout layout_;
+        std::vector<uint8_t> data_;
+        std::shared_ptr<IBuffer> buffer_;
+        bool dirty_ = true;
+        uint64_t uploads_ = 0;
+    };
+}
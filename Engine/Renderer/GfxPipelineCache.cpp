@@ -0,0 +1,80 @@
+#include "Renderer/GfxPipelineCache.h"
+#include "Core/Hash.h"
+#include <algorithm>
+#include <iterator>
+
+namespace SoulEngine::Gfx
+{
+    std::size_t HashPipelineStateDesc(const PipelineStateDesc& desc)
+    {
+        std::size_t seed = 0;
+        HashCombine(seed, desc.program.get());
+        HashCombine(seed, desc.inputLayout.get());
+        HashCombine(seed, static_cast<uint8_t>(desc.polygonMode));
+        HashCombine(seed, static_cast<uint8_t>(desc.cullMode));
+        HashCombine(seed, static_cast<uint8_t>(desc.blendMode));
+        HashCombine(seed, desc.depthTest);
+        HashCombine(seed, desc.depthWrite);
+        HashCombine(seed, static_cast<uint8_t>(desc.depthFunc));
+        return seed;
+    }
+
+    bool operator==(const PipelineStateDesc& a, const PipelineStateDesc& b)
+    {
+        return a.program == b.program
+            && a.inputLayout == b.inputLayout
+            && a.polygonMode == b.polygonMode
+            && a.cullMode == b.cullMode
+            && a.blendMode == b.blendMode
+            && a.depthTest == b.depthTest
+            && a.depthWrite == b.depthWrite
+            && a.depthFunc == b.depthFunc;
+    }
+
+    std::shared_ptr<IPipelineState> PipelineStateCache::GetOrCreate(const PipelineStateDesc& desc, const Factory& create)
+    {
+        const std::size_t hash = HashPipelineStateDesc(desc);
+        auto& bucket = buckets_[hash];
+        for (const auto& pso : bucket)
+        {
+            if (pso->GetDesc() == desc)
+            {
+                ++stats_.hits;
+                return pso;
+            }
+        }
+
+        ++stats_.misses;
+        auto pso = create(desc, hash);
+        if (pso)
+        {
+            bucket.push_back(pso);
+            ++stats_.entries;
+        }
+        return pso;
+    }
+
+    std::size_t PipelineStateCache::Trim()
+    {
+        std::size_t removed = 0;
+        for (auto it = buckets_.begin(); it != buckets_.end();)
+        {
+            auto& bucket = it->second;
+            const std::size_t before = bucket.size();
+            bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+                                        [](const std::shared_ptr<IPipelineState>& pso) { return pso.use_count() == 1; }),
+                         bucket.end());
+            removed += before - bucket.size();
+            it = bucket.empty() ? buckets_.erase(it) : std::next(it);
+        }
+        stats_.entries -= removed;
+        stats_.trimmed += removed;
+        return removed;
+    }
+
+    void PipelineStateCache::Clear()
+    {
+        buckets_.clear();
+        stats_.entries = 0;
+    }
+}
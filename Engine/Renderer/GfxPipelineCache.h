@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "Renderer/Gfx.h"
+
+namespace SoulEngine::Gfx
+{
+    // Device-level de-duplication of pipeline state objects.
+    // Entries are bucketed by HashPipelineStateDesc and compared field-wise on collision. Each entry keeps its
+    // program and input layout alive, so Trim (IDevice::TrimPipelineStates) drops the ones nobody else holds.
+    class PipelineStateCache
+    {
+    public:
+        using Factory = std::function<std::shared_ptr<IPipelineState>(const PipelineStateDesc&, std::size_t hash)>;
+
+        struct Stats
+        {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t trimmed = 0;
+            std::size_t entries = 0;
+        };
+
+        std::shared_ptr<IPipelineState> GetOrCreate(const PipelineStateDesc& desc, const Factory& create);
+        void Clear();
+        // Removes entries only the cache still references; returns how many were removed
+        std::size_t Trim();
+
+        const Stats& GetStats() const { return stats_; }
+
+    private:
+        std::unordered_map<std::size_t, std::vector<std::shared_ptr<IPipelineState>>> buckets_;
+        Stats stats_{};
+    };
+}
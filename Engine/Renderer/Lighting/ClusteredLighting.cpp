@@ -0,0 +1,331 @@
+#include "Renderer/Lighting/ClusteredLighting.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOULENGINE_CLUSTER_SSE2 1
+#endif
+
+namespace SoulEngine
+{
+    namespace
+    {
+        // Pads SoA candidate arrays to a multiple of 4 with entries that never pass the test
+        void PadCandidates(std::vector<float>& x, std::vector<float>& y, std::vector<float>& z, std::vector<float>& radiusSq)
+        {
+            while (x.size() % 4 != 0)
+            {
+                x.push_back(0.0f);
+                y.push_back(0.0f);
+                z.push_back(0.0f);
+                radiusSq.push_back(-1.0f);
+            }
+        }
+
+        // Bit i of the result is set when sphere i of the group of four at first touches the box
+        uint32_t TestSpheres4(const float* x, const float* y, const float* z, const float* radiusSq, const float* box)
+        {
+#if defined(SOULENGINE_CLUSTER_SSE2)
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 cx = _mm_loadu_ps(x);
+            const __m128 cy = _mm_loadu_ps(y);
+            const __m128 cz = _mm_loadu_ps(z);
+            const __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(box[0]), cx), _mm_sub_ps(cx, _mm_set1_ps(box[3]))), zero);
+            const __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(box[1]), cy), _mm_sub_ps(cy, _mm_set1_ps(box[4]))), zero);
+            const __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(box[2]), cz), _mm_sub_ps(cz, _mm_set1_ps(box[5]))), zero);
+            const __m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(distSq, _mm_loadu_ps(radiusSq))));
+#else
+            uint32_t mask = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                const float dx = std::max(std::max(box[0] - x[i], x[i] - box[3]), 0.0f);
+                const float dy = std::max(std::max(box[1] - y[i], y[i] - box[4]), 0.0f);
+                const float dz = std::max(std::max(box[2] - z[i], z[i] - box[5]), 0.0f);
+                if (dx * dx + dy * dy + dz * dz <= radiusSq[i])
+                    mask |= 1u << i;
+            }
+            return mask;
+#endif
+        }
+
+        // Cone against the cluster's bounding sphere (Wronski 2016); the sphere test already passed
+        bool SpotTouchesBox(const ClusterLight& light, const float* box)
+        {
+            const float center[3] = { (box[0] + box[3]) * 0.5f, (box[1] + box[4]) * 0.5f, (box[2] + box[5]) * 0.5f };
+            const float ex = box[3] - center[0], ey = box[4] - center[1], ez = box[5] - center[2];
+            const float sphereRadius = std::sqrt(ex * ex + ey * ey + ez * ez);
+
+            const float v[3] = { center[0] - light.position[0], center[1] - light.position[1], center[2] - light.position[2] };
+            const float lenSq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+            const float v1 = v[0] * light.direction[0] + v[1] * light.direction[1] + v[2] * light.direction[2];
+            const float cosAngle = light.cosOuter;
+            const float sinAngle = std::sqrt(std::max(1.0f - cosAngle * cosAngle, 0.0f));
+            const float distClosest = cosAngle * std::sqrt(std::max(lenSq - v1 * v1, 0.0f)) - v1 * sinAngle;
+            return !(distClosest > sphereRadius || v1 > sphereRadius + light.range || v1 < -sphereRadius);
+        }
+
+        double ElapsedMs(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    ClusteredLightCuller::ClusteredLightCuller(const ClusterGridDesc& desc)
+    {
+        SetGrid(desc);
+    }
+
+    void ClusteredLightCuller::SetGrid(const ClusterGridDesc& desc)
+    {
+        desc_ = desc;
+        desc_.tilesX = std::max(desc_.tilesX, 1u);
+        desc_.tilesY = std::max(desc_.tilesY, 1u);
+        desc_.slices = std::max(desc_.slices, 1u);
+        desc_.nearPlane = std::max(desc_.nearPlane, 1e-4f);
+        desc_.farPlane = std::max(desc_.farPlane, desc_.nearPlane * 1.001f);
+        BuildClusterBounds();
+
+        candidates_.assign(desc_.slices, {});
+        outputs_.assign(desc_.slices, {});
+        ranges_.assign(GetClusterCount(), {});
+        indices_.clear();
+    }
+
+    void ClusteredLightCuller::BuildClusterBounds()
+    {
+        const float tanY = std::tan(desc_.fovY * 0.5f);
+        const float tanX = tanY * desc_.aspect;
+
+        sliceDepth_.resize(desc_.slices + 1);
+        const float ratio = desc_.farPlane / desc_.nearPlane;
+        for (uint32_t s = 0; s <= desc_.slices; ++s)
+            sliceDepth_[s] = desc_.nearPlane * std::pow(ratio, static_cast<float>(s) / desc_.slices);
+
+        bounds_.resize(static_cast<std::size_t>(GetClusterCount()) * 6);
+        for (uint32_t s = 0; s < desc_.slices; ++s)
+        {
+            const float dn = sliceDepth_[s];
+            const float df = sliceDepth_[s + 1];
+            for (uint32_t y = 0; y < desc_.tilesY; ++y)
+            {
+                const float y0 = (-1.0f + 2.0f * y / desc_.tilesY) * tanY;
+                const float y1 = (-1.0f + 2.0f * (y + 1) / desc_.tilesY) * tanY;
+                for (uint32_t x = 0; x < desc_.tilesX; ++x)
+                {
+                    const float x0 = (-1.0f + 2.0f * x / desc_.tilesX) * tanX;
+                    const float x1 = (-1.0f + 2.0f * (x + 1) / desc_.tilesX) * tanX;
+                    float* box = &bounds_[static_cast<std::size_t>(GetClusterIndex(x, y, s)) * 6];
+                    box[0] = std::min(x0 * dn, x0 * df);
+                    box[1] = std::min(y0 * dn, y0 * df);
+                    box[2] = -df;
+                    box[3] = std::max(x1 * dn, x1 * df);
+                    box[4] = std::max(y1 * dn, y1 * df);
+                    box[5] = -dn;
+                }
+            }
+        }
+    }
+
+    void ClusteredLightCuller::Assign(const float view[16], const ClusterLight* lights, uint32_t lightCount)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        stats_ = ClusteredLightingStats{};
+        stats_.lights = lightCount;
+        stats_.clusters = GetClusterCount();
+
+        for (SliceCandidates& c : candidates_)
+        {
+            c.x.clear(); c.y.clear(); c.z.clear(); c.radiusSq.clear(); c.light.clear();
+        }
+
+        const float tanY = std::tan(desc_.fovY * 0.5f);
+        const float tanX = tanY * desc_.aspect;
+        const float invX = 1.0f / std::sqrt(1.0f + tanX * tanX);
+        const float invY = 1.0f / std::sqrt(1.0f + tanY * tanY);
+        const float sliceScale = desc_.slices / std::log(desc_.farPlane / desc_.nearPlane);
+        auto sliceOf = [&](float depth) {
+            const float s = std::log(std::max(depth, desc_.nearPlane) / desc_.nearPlane) * sliceScale;
+            return std::min(static_cast<uint32_t>(std::max(s, 0.0f)), desc_.slices - 1);
+        };
+
+        viewLights_.assign(lights, lights + lightCount);
+        for (uint32_t i = 0; i < lightCount; ++i)
+        {
+            ClusterLight& l = viewLights_[i];
+            const float* p = lights[i].position;
+            const float* d = lights[i].direction;
+            for (int r = 0; r < 3; ++r)
+            {
+                l.position[r] = view[0 * 4 + r] * p[0] + view[1 * 4 + r] * p[1] + view[2 * 4 + r] * p[2] + view[3 * 4 + r];
+                l.direction[r] = view[0 * 4 + r] * d[0] + view[1 * 4 + r] * d[1] + view[2 * 4 + r] * d[2];
+            }
+
+            // Frustum: near/far by depth, the four side planes pass through the eye
+            const float x = l.position[0], y = l.position[1], z = l.position[2], r = l.range;
+            const float depth = -z;
+            if (r <= 0.0f || depth + r < desc_.nearPlane || depth - r > desc_.farPlane)
+                continue;
+            if ((x - tanX * depth) * invX > r || (-x - tanX * depth) * invX > r ||
+                (y - tanY * depth) * invY > r || (-y - tanY * depth) * invY > r)
+                continue;
+
+            ++stats_.visibleLights;
+            const uint32_t s0 = sliceOf(depth - r);
+            const uint32_t s1 = sliceOf(depth + r);
+            for (uint32_t s = s0; s <= s1; ++s)
+            {
+                SliceCandidates& c = candidates_[s];
+                c.x.push_back(x);
+                c.y.push_back(y);
+                c.z.push_back(z);
+                c.radiusSq.push_back(r * r);
+                c.light.push_back(i);
+            }
+        }
+
+        JobSystem::GetInstance().ParallelFor(desc_.slices, 1, [this](uint32_t begin, uint32_t end) {
+            for (uint32_t s = begin; s < end; ++s)
+                AssignSlice(s);
+        });
+
+        // Slices wrote slice-relative offsets; rebase them and concatenate the lists
+        indices_.clear();
+        const uint32_t clustersPerSlice = desc_.tilesX * desc_.tilesY;
+        for (uint32_t s = 0; s < desc_.slices; ++s)
+        {
+            const uint32_t base = static_cast<uint32_t>(indices_.size());
+            const SliceOutput& out = outputs_[s];
+            indices_.insert(indices_.end(), out.indices.begin(), out.indices.end());
+            stats_.droppedIndices += out.dropped;
+            for (uint32_t c = s * clustersPerSlice; c < (s + 1) * clustersPerSlice; ++c)
+            {
+                ranges_[c].offset += base;
+                stats_.occupiedClusters += ranges_[c].count ? 1 : 0;
+                stats_.maxLightsInCluster = std::max(stats_.maxLightsInCluster, ranges_[c].count);
+            }
+        }
+        stats_.indices = static_cast<uint32_t>(indices_.size());
+        stats_.assignMs = ElapsedMs(start);
+    }
+
+    void ClusteredLightCuller::AssignSlice(uint32_t slice)
+    {
+        SliceCandidates& cand = candidates_[slice];
+        SliceOutput& out = outputs_[slice];
+        out.indices.clear();
+        out.dropped = 0;
+        PadCandidates(cand.x, cand.y, cand.z, cand.radiusSq);
+        const uint32_t candidateGroups = static_cast<uint32_t>(cand.x.size() / 4);
+
+        SliceCandidates& row = out.row;
+        for (uint32_t y = 0; y < desc_.tilesY; ++y)
+        {
+            // Narrow the slice candidates to the row's bounds before testing every cluster in it
+            const float* first = &bounds_[static_cast<std::size_t>(GetClusterIndex(0, y, slice)) * 6];
+            const float* last = &bounds_[static_cast<std::size_t>(GetClusterIndex(desc_.tilesX - 1, y, slice)) * 6];
+            const float rowBox[6] = { first[0], first[1], first[2], last[3], last[4], last[5] };
+
+            row.x.clear(); row.y.clear(); row.z.clear(); row.radiusSq.clear(); row.light.clear();
+            for (uint32_t g = 0; g < candidateGroups; ++g)
+            {
+                const uint32_t mask = TestSpheres4(&cand.x[g * 4], &cand.y[g * 4], &cand.z[g * 4], &cand.radiusSq[g * 4], rowBox);
+                for (uint32_t bit = 0; mask >> bit; ++bit)
+                {
+                    if (!(mask & (1u << bit)))
+                        continue;
+                    const uint32_t i = g * 4 + bit;
+                    row.x.push_back(cand.x[i]);
+                    row.y.push_back(cand.y[i]);
+                    row.z.push_back(cand.z[i]);
+                    row.radiusSq.push_back(cand.radiusSq[i]);
+                    row.light.push_back(cand.light[i]);
+                }
+            }
+            PadCandidates(row.x, row.y, row.z, row.radiusSq);
+            const uint32_t rowGroups = static_cast<uint32_t>(row.x.size() / 4);
+
+            for (uint32_t x = 0; x < desc_.tilesX; ++x)
+            {
+                const uint32_t cluster = GetClusterIndex(x, y, slice);
+                const float* box = &bounds_[static_cast<std::size_t>(cluster) * 6];
+                ClusterRange& range = ranges_[cluster];
+                range.offset = static_cast<uint32_t>(out.indices.size());
+                range.count = 0;
+
+                for (uint32_t g = 0; g < rowGroups; ++g)
+                {
+                    const uint32_t mask = TestSpheres4(&row.x[g * 4], &row.y[g * 4], &row.z[g * 4], &row.radiusSq[g * 4], box);
+                    for (uint32_t bit = 0; mask >> bit; ++bit)
+                    {
+                        if (!(mask & (1u << bit)))
+                            continue;
+                        const uint32_t light = row.light[g * 4 + bit];
+                        const ClusterLight& l = viewLights_[light];
+                        if (l.type == ClusterLightType::Spot && !SpotTouchesBox(l, box))
+                            continue;
+                        if (range.count >= desc_.maxLightsPerCluster)
+                        {
+                            ++out.dropped;
+                            continue;
+                        }
+                        out.indices.push_back(light);
+                        ++range.count;
+                    }
+                }
+            }
+        }
+    }
+
+    ClusterShaderParams ClusteredLightCuller::GetShaderParams(uint32_t viewportWidth, uint32_t viewportHeight) const
+    {
+        ClusterShaderParams params{};
+        params.sliceScale = desc_.slices / std::log(desc_.farPlane / desc_.nearPlane);
+        params.sliceBias = -std::log(desc_.nearPlane) * params.sliceScale;
+        params.invTileWidth = static_cast<float>(desc_.tilesX) / std::max(viewportWidth, 1u);
+        params.invTileHeight = static_cast<float>(desc_.tilesY) / std::max(viewportHeight, 1u);
+        params.tilesX = desc_.tilesX;
+        params.tilesY = desc_.tilesY;
+        params.slices = desc_.slices;
+        params.lightCount = stats_.lights;
+        return params;
+    }
+
+    void ClusteredLightBuffers::Upload(Gfx::IDevice* device, const ClusteredLightCuller& culler, const ClusterLight* lights, uint32_t lightCount)
+    {
+        const auto& ranges = culler.GetClusterRanges();
+        const auto& indices = culler.GetLightIndices();
+        Write(device, lights_, lights, lightCount * sizeof(ClusterLight), 16, "ClusterLights");
+        Write(device, ranges_, ranges.data(), ranges.size() * sizeof(ClusterRange), 8, "ClusterRanges");
+        Write(device, indices_, indices.data(), indices.size() * sizeof(uint32_t), 4, "ClusterLightIndices");
+    }
+
+    void ClusteredLightBuffers::Bind(Gfx::IContext* context, uint32_t firstSlot) const
+    {
+        context->SetStorageBuffer(firstSlot + 0, lights_.get());
+        context->SetStorageBuffer(firstSlot + 1, ranges_.get());
+        context->SetStorageBuffer(firstSlot + 2, indices_.get());
+    }
+
+    void ClusteredLightBuffers::Write(Gfx::IDevice* device, std::shared_ptr<Gfx::IBuffer>& buffer, const void* data, std::size_t size,
+                                      uint32_t stride, const char* name)
+    {
+        if (!buffer || buffer->GetDesc().size < size)
+        {
+            Gfx::BufferDesc desc;
+            desc.size = std::max<std::size_t>({ size, buffer ? buffer->GetDesc().size * 2 : 0, 256 });
+            desc.kind = Gfx::BufferKind::Storage;
+            desc.usage = Gfx::BufferUsage::Dynamic;
+            desc.bindFlags = Gfx::BindFlags::ShaderResource;
+            desc.cpuAccess = Gfx::CpuAccessFlags::Write;
+            desc.stride = stride;
+            desc.name = name;
+            buffer = device->CreateBuffer(desc, nullptr);
+        }
+        if (buffer && size)
+            buffer->Update({ data, size, 0 });
+    }
+} // namespace SoulEngine
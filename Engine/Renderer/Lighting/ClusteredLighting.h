@@ -0,0 +1,160 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Define.h"
+#include "Renderer/Gfx.h"
+
+namespace SoulEngine
+{
+    enum class ClusterLightType : uint32_t { Point = 0, Spot = 1 };
+
+    // World-space light, 64 bytes. The array is uploaded as-is, so the layout is shared with the shader
+    // (four RGBA32UI texels per light, floats reinterpreted with uintBitsToFloat).
+    struct ClusterLight
+    {
+        float position[3] = { 0.0f, 0.0f, 0.0f };
+        float range = 1.0f;                         // influence radius, attenuation reaches 0 here
+        float color[3] = { 1.0f, 1.0f, 1.0f };
+        float intensity = 1.0f;
+        float direction[3] = { 0.0f, 0.0f, -1.0f };   // spot only, normalized
+        ClusterLightType type = ClusterLightType::Point;
+        float cosInner = 1.0f;                      // spot only
+        float cosOuter = 0.7071f;                   // spot only, defines the culled cone
+        float padding[2] = { 0.0f, 0.0f };
+    };
+    static_assert(sizeof(ClusterLight) == 64, "ClusterLight must match the shader layout");
+
+    // Cluster lookup entry: lightIndices[offset .. offset + count)
+    struct ClusterRange
+    {
+        uint32_t offset = 0;
+        uint32_t count = 0;
+    };
+
+    struct ClusterGridDesc
+    {
+        uint32_t tilesX = 16;
+        uint32_t tilesY = 9;
+        uint32_t slices = 24;                       // exponential in view depth
+        float nearPlane = 0.1f;
+        float farPlane = 500.0f;
+        float fovY = 1.0471976f;                    // radians
+        float aspect = 16.0f / 9.0f;
+        uint32_t maxLightsPerCluster = 256;         // extra lights are dropped and counted in the stats
+    };
+
+    // Constants for the shader-side lookup:
+    //   slice = uint(max(log(viewDepth) * sliceScale + sliceBias, 0.0));
+    //   cluster = (slice * tilesY + uint(fragCoord.y * invTileHeight)) * tilesX + uint(fragCoord.x * invTileWidth);
+    struct ClusterShaderParams
+    {
+        float sliceScale;
+        float sliceBias;
+        float invTileWidth;
+        float invTileHeight;
+        uint32_t tilesX;
+        uint32_t tilesY;
+        uint32_t slices;
+        uint32_t lightCount;
+    };
+
+    struct ClusteredLightingStats
+    {
+        uint32_t lights = 0;
+        uint32_t visibleLights = 0;                 // survived the frustum test
+        uint32_t clusters = 0;
+        uint32_t occupiedClusters = 0;
+        uint32_t indices = 0;
+        uint32_t maxLightsInCluster = 0;
+        uint32_t droppedIndices = 0;                // over maxLightsPerCluster
+        double assignMs = 0.0;
+    };
+
+    /**
+     * @brief CPU 分簇光源分配（Clustered Forward）
+     * 视锥按屏幕分块 x 指数深度切片划分为三维簇，每个簇在观察空间中是一个 AABB。
+     * 点光源按球与 AABB 测试（SSE2 一次测 4 盏灯），聚光灯再用锥体与簇包围球细化；
+     * 每个深度切片作为一个任务在任务系统上并行，最后合并为紧凑的光源索引列表。
+     * 约定与 GL 一致：观察空间朝 -Z，矩阵为列主序 float[16]，屏幕原点在左下角。
+     *
+     * 使用方式:
+     *   culler.SetGrid(desc);                       // 投影或分辨率变化时
+     *   culler.Assign(view, lights.data(), lights.size());
+     *   buffers.Upload(device, culler, lights.data(), lights.size());
+     *   buffers.Bind(context, 0);                   // 存储缓冲槽 0/1/2: 光源、簇范围、光源索引（GL 上为纹理单元 kStorageBufferUnitBase + 槽）
+     */
+    class ClusteredLightCuller
+    {
+        NON_COPY_AND_MOVE(ClusteredLightCuller)
+
+    public:
+        explicit ClusteredLightCuller(const ClusterGridDesc& desc = {});
+        ~ClusteredLightCuller() = default;
+
+        void SetGrid(const ClusterGridDesc& desc);
+        const ClusterGridDesc& GetGrid() const { return desc_; }
+
+        void Assign(const float view[16], const ClusterLight* lights, uint32_t lightCount);
+
+        uint32_t GetClusterCount() const { return desc_.tilesX * desc_.tilesY * desc_.slices; }
+        uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t slice) const { return (slice * desc_.tilesY + y) * desc_.tilesX + x; }
+        const std::vector<ClusterRange>& GetClusterRanges() const { return ranges_; }
+        const std::vector<uint32_t>& GetLightIndices() const { return indices_; }
+        ClusterShaderParams GetShaderParams(uint32_t viewportWidth, uint32_t viewportHeight) const;
+        const ClusteredLightingStats& GetStats() const { return stats_; }
+
+    private:
+        // Lights of one depth slice, SoA for the SIMD test
+        struct SliceCandidates
+        {
+            std::vector<float> x, y, z, radiusSq;
+            std::vector<uint32_t> light;
+        };
+
+        struct SliceOutput
+        {
+            std::vector<uint32_t> indices;
+            uint32_t dropped = 0;
+            SliceCandidates row;                    // candidates that touch the current tile row
+        };
+
+        void BuildClusterBounds();
+        void AssignSlice(uint32_t slice);
+
+        ClusterGridDesc desc_{};
+        std::vector<float> bounds_;                 // per cluster: min xyz, max xyz (view space)
+        std::vector<float> sliceDepth_;             // slices + 1 boundaries, positive view depth
+        std::vector<ClusterLight> viewLights_;      // position/direction in view space
+        std::vector<SliceCandidates> candidates_;
+        std::vector<SliceOutput> outputs_;
+        std::vector<ClusterRange> ranges_;
+        std::vector<uint32_t> indices_;
+        ClusteredLightingStats stats_{};
+    };
+
+    /**
+     * @brief 分簇光照的 GPU 存储缓冲（光源数组、簇范围、光源索引），容量不足时按 2 倍扩容
+     */
+    class ClusteredLightBuffers
+    {
+        NON_COPY_AND_MOVE(ClusteredLightBuffers)
+
+    public:
+        ClusteredLightBuffers() = default;
+        ~ClusteredLightBuffers() = default;
+
+        void Upload(Gfx::IDevice* device, const ClusteredLightCuller& culler, const ClusterLight* lights, uint32_t lightCount);
+
+        // Lights at firstSlot, ranges at firstSlot + 1, indices at firstSlot + 2
+        void Bind(Gfx::IContext* context, uint32_t firstSlot) const;
+
+    private:
+        static void Write(Gfx::IDevice* device, std::shared_ptr<Gfx::IBuffer>& buffer, const void* data, std::size_t size,
+                          uint32_t stride, const char* name);
+
+        std::shared_ptr<Gfx::IBuffer> lights_;
+        std::shared_ptr<Gfx::IBuffer> ranges_;
+        std::shared_ptr<Gfx::IBuffer> indices_;
+    };
+} // namespace SoulEngine
@@ -0,0 +1,389 @@
+#include "Renderer/Mesh/MeshOptimizer.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace SoulEngine
+{
+    namespace
+    {
+        // Triangles incident to each vertex, as a CSR table
+        struct Adjacency
+        {
+            std::vector<uint32_t> counts;
+            std::vector<uint32_t> offsets;
+            std::vector<uint32_t> triangles;
+
+            void Build(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount)
+            {
+                counts.assign(vertexCount, 0);
+                offsets.assign(vertexCount, 0);
+                triangles.resize(indexCount);
+
+                for (uint32_t i = 0; i < indexCount; ++i)
+                    ++counts[indices[i]];
+
+                uint32_t offset = 0;
+                for (uint32_t v = 0; v < vertexCount; ++v)
+                {
+                    offsets[v] = offset;
+                    offset += counts[v];
+                }
+
+                std::vector<uint32_t> cursor(offsets);
+                for (uint32_t i = 0; i < indexCount; ++i)
+                    triangles[cursor[indices[i]]++] = i / 3;
+            }
+        };
+
+        // Cache misses of triangles [begin, end) with a timestamp cache (Tipsify's model)
+        uint32_t CountMisses(const uint32_t* indices, uint32_t beginTri, uint32_t endTri, std::vector<uint32_t>& timestamps,
+                             uint32_t& time, uint32_t cacheSize)
+        {
+            uint32_t misses = 0;
+            for (uint32_t t = beginTri; t < endTri; ++t)
+            {
+                for (uint32_t k = 0; k < 3; ++k)
+                {
+                    const uint32_t v = indices[t * 3 + k];
+                    if (time - timestamps[v] > cacheSize)
+                    {
+                        timestamps[v] = time++;
+                        ++misses;
+                    }
+                }
+            }
+            return misses;
+        }
+    }
+
+    VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount, uint32_t cacheSize)
+    {
+        VertexCacheStats stats;
+        stats.triangles = indexCount / 3;
+        if (indexCount == 0 || vertexCount == 0)
+            return stats;
+
+        // FIFO: a vertex is resident while fewer than cacheSize misses happened since it was loaded
+        std::vector<uint32_t> loadedAt(vertexCount, 0);
+        std::vector<uint8_t> referenced(vertexCount, 0);
+        uint32_t time = cacheSize + 1;
+        for (uint32_t i = 0; i < indexCount; ++i)
+        {
+            const uint32_t v = indices[i];
+            if (time - loadedAt[v] > cacheSize)
+            {
+                loadedAt[v] = time++;
+                ++stats.misses;
+            }
+            if (!referenced[v])
+            {
+                referenced[v] = 1;
+                ++stats.vertices;
+            }
+        }
+
+        stats.acmr = stats.triangles ? static_cast<float>(stats.misses) / stats.triangles : 0.0f;
+        stats.atvr = stats.vertices ? static_cast<float>(stats.misses) / stats.vertices : 0.0f;
+        return stats;
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(uint32_t* dst, const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount,
+                                            uint32_t cacheSize, std::vector<uint32_t>* clusters)
+    {
+        if (clusters)
+            clusters->clear();
+        if (indexCount < 3 || vertexCount == 0)
+            return;
+
+        // Work from a copy so dst may alias indices
+        std::vector<uint32_t> source(indices, indices + indexCount);
+        const uint32_t triangleCount = indexCount / 3;
+
+        Adjacency adjacency;
+        adjacency.Build(source.data(), triangleCount * 3, vertexCount);
+
+        std::vector<uint32_t> live(adjacency.counts);
+        std::vector<uint32_t> cacheTime(vertexCount, 0);
+        std::vector<uint8_t> emitted(triangleCount, 0);
+        std::vector<uint32_t> deadEnd;
+        std::vector<uint32_t> candidates;
+        deadEnd.reserve(indexCount);
+        candidates.reserve(64);
+
+        uint32_t time = cacheSize + 1;
+        uint32_t cursor = 0;         // next vertex to try when the dead-end stack runs dry
+        uint32_t outTri = 0;
+
+        // Start at the first referenced vertex
+        int64_t fan = -1;
+        while (cursor < vertexCount && live[cursor] == 0)
+            ++cursor;
+        if (cursor < vertexCount)
+            fan = cursor;
+
+        bool newCluster = true;
+        while (fan >= 0)
+        {
+            const uint32_t f = static_cast<uint32_t>(fan);
+            candidates.clear();
+
+            const uint32_t* adj = adjacency.triangles.data() + adjacency.offsets[f];
+            for (uint32_t a = 0; a < adjacency.counts[f]; ++a)
+            {
+                const uint32_t t = adj[a];
+                if (emitted[t])
+                    continue;
+
+                if (newCluster && clusters)
+                    clusters->push_back(outTri * 3);
+                newCluster = false;
+
+                for (uint32_t k = 0; k < 3; ++k)
+                {
+                    const uint32_t v = source[t * 3 + k];
+                    dst[outTri * 3 + k] = v;
+                    deadEnd.push_back(v);
+                    candidates.push_back(v);
+                    --live[v];
+                    if (time - cacheTime[v] > cacheSize)
+                        cacheTime[v] = time++;
+                }
+                emitted[t] = 1;
+                ++outTri;
+            }
+
+            // Prefer the candidate that stays in cache longest once its remaining triangles are emitted
+            int64_t best = -1;
+            int64_t bestPriority = -1;
+            for (uint32_t v : candidates)
+            {
+                if (live[v] == 0)
+                    continue;
+                int64_t priority = 0;
+                if (time - cacheTime[v] + 2 * live[v] <= cacheSize)
+                    priority = time - cacheTime[v];
+                if (priority > bestPriority)
+                {
+                    bestPriority = priority;
+                    best = v;
+                }
+            }
+
+            if (best < 0)
+            {
+                // Dead end: recently used vertices first, then scan in input order; either way the cache locality breaks
+                newCluster = true;
+                while (!deadEnd.empty())
+                {
+                    const uint32_t v = deadEnd.back();
+                    deadEnd.pop_back();
+                    if (live[v] > 0)
+                    {
+                        best = v;
+                        break;
+                    }
+                }
+                while (best < 0 && cursor < vertexCount)
+                {
+                    if (live[cursor] > 0)
+                        best = cursor;
+                    else
+                        ++cursor;
+                }
+            }
+            fan = best;
+        }
+
+        // Degenerate input (indexCount not a multiple of 3) keeps its trailing indices
+        for (uint32_t i = triangleCount * 3; i < indexCount; ++i)
+            dst[i] = source[i];
+    }
+
+    uint32_t MeshOptimizer::OptimizeOverdraw(uint32_t* dst, const uint32_t* indices, uint32_t indexCount,
+                                             const float* positions, uint32_t positionStride, uint32_t vertexCount,
+                                             const std::vector<uint32_t>& hardClusters, uint32_t cacheSize, float threshold)
+    {
+        const uint32_t triangleCount = indexCount / 3;
+        if (triangleCount == 0)
+            return 0;
+
+        std::vector<uint32_t> source(indices, indices + indexCount);
+        auto position = [&](uint32_t v) {
+            return reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(positions) + static_cast<size_t>(v) * positionStride);
+        };
+
+        // Hard boundaries are where the cache optimizer lost locality anyway; splitting further (soft boundaries)
+        // is allowed where the running ACMR is already within threshold of the whole cluster's
+        std::vector<uint32_t> boundaries;
+        std::vector<uint32_t> timestamps(vertexCount, 0);
+        uint32_t time = cacheSize + 1;
+        std::vector<uint32_t> hard(hardClusters);
+        if (hard.empty() || hard.front() != 0)
+            hard.insert(hard.begin(), 0);
+
+        for (size_t c = 0; c < hard.size(); ++c)
+        {
+            const uint32_t beginTri = hard[c] / 3;
+            const uint32_t endTri = c + 1 < hard.size() ? hard[c + 1] / 3 : triangleCount;
+            if (beginTri >= endTri)
+                continue;
+            boundaries.push_back(beginTri);
+            if (threshold <= 0.0f)
+                continue;
+
+            time += cacheSize + 1;
+            const uint32_t clusterMisses = CountMisses(source.data(), beginTri, endTri, timestamps, time, cacheSize);
+            const float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(endTri - beginTri);
+
+            time += cacheSize + 1;
+            uint32_t runningMisses = 0;
+            uint32_t runningTriangles = 0;
+            for (uint32_t t = beginTri; t < endTri; ++t)
+            {
+                runningMisses += CountMisses(source.data(), t, t + 1, timestamps, time, cacheSize);
+                ++runningTriangles;
+                if (t + 1 < endTri && static_cast<float>(runningMisses) / runningTriangles <= clusterThreshold)
+                {
+                    boundaries.push_back(t + 1);
+                    time += cacheSize + 1;
+                    runningMisses = 0;
+                    runningTriangles = 0;
+                }
+            }
+        }
+
+        // Mesh centroid weighted by area, then per-cluster area-weighted centroid and normal
+        struct Cluster
+        {
+            uint32_t beginTri;
+            uint32_t endTri;
+            float sortKey;
+        };
+        std::vector<Cluster> clusterList(boundaries.size());
+        double meshCentroid[3] = { 0.0, 0.0, 0.0 };
+        double meshArea = 0.0;
+        std::vector<float> clusterData(boundaries.size() * 7, 0.0f); // centroid * area (3), normal (3), area
+
+        for (size_t c = 0; c < boundaries.size(); ++c)
+        {
+            const uint32_t beginTri = boundaries[c];
+            const uint32_t endTri = c + 1 < boundaries.size() ? boundaries[c + 1] : triangleCount;
+            clusterList[c] = { beginTri, endTri, 0.0f };
+            float* data = &clusterData[c * 7];
+            for (uint32_t t = beginTri; t < endTri; ++t)
+            {
+                const float* p0 = position(source[t * 3 + 0]);
+                const float* p1 = position(source[t * 3 + 1]);
+                const float* p2 = position(source[t * 3 + 2]);
+                const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+                const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+                const float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+                const float area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) * 0.5f;
+                for (int i = 0; i < 3; ++i)
+                {
+                    const float center = (p0[i] + p1[i] + p2[i]) * (1.0f / 3.0f);
+                    data[i] += center * area;
+                    data[3 + i] += n[i];        // |n| = 2 * area, so this is already area-weighted
+                    meshCentroid[i] += center * area;
+                }
+                data[6] += area;
+                meshArea += area;
+            }
+        }
+        if (meshArea > 0.0)
+            for (int i = 0; i < 3; ++i)
+                meshCentroid[i] /= meshArea;
+
+        for (size_t c = 0; c < clusterList.size(); ++c)
+        {
+            const float* data = &clusterData[c * 7];
+            if (data[6] <= 0.0f)
+                continue;
+            const float nLen = std::sqrt(data[3] * data[3] + data[4] * data[4] + data[5] * data[5]);
+            if (nLen <= 0.0f)
+                continue;
+            float key = 0.0f;
+            for (int i = 0; i < 3; ++i)
+                key += (data[i] / data[6] - static_cast<float>(meshCentroid[i])) * (data[3 + i] / nLen);
+            clusterList[c].sortKey = key;
+        }
+
+        // Most outward-facing first: they tend to occlude the rest of the mesh
+        std::stable_sort(clusterList.begin(), clusterList.end(), [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+        uint32_t out = 0;
+        for (const Cluster& c : clusterList)
+        {
+            const uint32_t count = (c.endTri - c.beginTri) * 3;
+            std::memcpy(dst + out, source.data() + c.beginTri * 3, count * sizeof(uint32_t));
+            out += count;
+        }
+        for (uint32_t i = triangleCount * 3; i < indexCount; ++i)
+            dst[i] = source[i];
+        return static_cast<uint32_t>(clusterList.size());
+    }
+
+    uint32_t MeshOptimizer::OptimizeVertexFetchRemap(std::vector<uint32_t>& remap, uint32_t* indices, uint32_t indexCount, uint32_t vertexCount)
+    {
+        remap.assign(vertexCount, UINT32_MAX);
+        uint32_t next = 0;
+        for (uint32_t i = 0; i < indexCount; ++i)
+        {
+            uint32_t& target = remap[indices[i]];
+            if (target == UINT32_MAX)
+                target = next++;
+            indices[i] = target;
+        }
+        return next;
+    }
+
+    void MeshOptimizer::RemapVertices(void* dst, const void* src, uint32_t vertexCount, uint32_t vertexSize, const std::vector<uint32_t>& remap)
+    {
+        auto* out = static_cast<uint8_t*>(dst);
+        const auto* in = static_cast<const uint8_t*>(src);
+        for (uint32_t v = 0; v < vertexCount; ++v)
+        {
+            if (remap[v] != UINT32_MAX)
+                std::memcpy(out + static_cast<size_t>(remap[v]) * vertexSize, in + static_cast<size_t>(v) * vertexSize, vertexSize);
+        }
+    }
+
+    MeshOptimizeReport MeshOptimizer::Optimize(std::vector<uint32_t>& indices, void* vertices, uint32_t vertexCount, uint32_t vertexSize,
+                                               uint32_t positionOffset, const MeshOptimizeSettings& settings)
+    {
+        MeshOptimizeReport report;
+        const uint32_t indexCount = static_cast<uint32_t>(indices.size());
+        for (uint32_t i = 0; i < indexCount; ++i)
+        {
+            if (indices[i] >= vertexCount)
+            {
+                Logger::Error("MeshOptimizer: index {} at {} is out of range ({} vertices)", indices[i], i, vertexCount);
+                report.fetchedVertices = vertexCount;
+                return report;
+            }
+        }
+
+        report.before = AnalyzeVertexCache(indices.data(), indexCount, vertexCount, settings.analyzeCacheSize);
+
+        std::vector<uint32_t> clusters;
+        OptimizeVertexCache(indices.data(), indices.data(), indexCount, vertexCount, settings.cacheSize, &clusters);
+
+        const auto* positions = reinterpret_cast<const float*>(static_cast<const uint8_t*>(vertices) + positionOffset);
+        report.clusters = OptimizeOverdraw(indices.data(), indices.data(), indexCount, positions, vertexSize, vertexCount,
+                                           clusters, settings.cacheSize, settings.overdrawThreshold);
+
+        report.fetchedVertices = vertexCount;
+        if (settings.remapVertexFetch)
+        {
+            std::vector<uint32_t> remap;
+            report.fetchedVertices = OptimizeVertexFetchRemap(remap, indices.data(), indexCount, vertexCount);
+            std::vector<uint8_t> copy(static_cast<const uint8_t*>(vertices), static_cast<const uint8_t*>(vertices) + static_cast<size_t>(vertexCount) * vertexSize);
+            RemapVertices(vertices, copy.data(), vertexCount, vertexSize, remap);
+        }
+
+        report.after = AnalyzeVertexCache(indices.data(), indexCount, report.fetchedVertices, settings.analyzeCacheSize);
+        return report;
+    }
+}
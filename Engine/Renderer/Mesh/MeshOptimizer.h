@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Define.h"
+
+namespace SoulEngine
+{
+    // Post-transform cache statistics of an index buffer
+    struct VertexCacheStats
+    {
+        uint32_t triangles = 0;
+        uint32_t vertices = 0;          // distinct vertices referenced
+        uint32_t misses = 0;            // vertex shader invocations
+        float acmr = 0.0f;              // misses per triangle, 0.5 is the ideal for a regular grid, 3 the worst
+        float atvr = 0.0f;              // misses per referenced vertex, 1 is ideal
+    };
+
+    struct MeshOptimizeReport
+    {
+        VertexCacheStats before;
+        VertexCacheStats after;
+        uint32_t clusters = 0;          // clusters ordered by the overdraw pass
+        uint32_t fetchedVertices = 0;   // vertices kept after fetch remapping (unused ones are dropped)
+    };
+
+    struct MeshOptimizeSettings
+    {
+        uint32_t cacheSize = 16;        // target post-transform cache size for Tipsify
+        uint32_t analyzeCacheSize = 16; // FIFO size used for the ACMR/ATVR report
+        // Overdraw pass may split clusters as long as their ACMR stays within this factor of the optimized order; 0 disables it
+        float overdrawThreshold = 1.05f;
+        bool remapVertexFetch = true;
+    };
+
+    /**
+     * @brief 网格索引/顶点顺序优化（资源管线离线使用）
+     * - OptimizeVertexCache: Tipsify（Sander et al. 2007）线性时间的顶点后变换缓存优化
+     * - OptimizeOverdraw: 在缓存优化后的簇之间按朝外程度排序，先画外侧面以减少过度绘制
+     * - OptimizeVertexFetch: 按首次引用顺序重排顶点，使顶点读取连续
+     * 所有函数只处理三角形列表，索引为 32 位。
+     *
+     * 使用方式:
+     *   MeshOptimizeReport report = MeshOptimizer::Optimize(indices, vertices.data(), vertexCount, sizeof(Vertex), offsetof(Vertex, position));
+     *   vertices.resize(report.fetchedVertices);
+     */
+    class MeshOptimizer
+    {
+        STATIC_CLASS(MeshOptimizer);
+
+    public:
+        // Simulates a FIFO post-transform cache of cacheSize entries
+        static VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount, uint32_t cacheSize = 16);
+
+        // dst may alias indices. clusters (optional) receives the first index of every cache-hard cluster,
+        // which OptimizeOverdraw uses as reorder boundaries.
+        static void OptimizeVertexCache(uint32_t* dst, const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount,
+                                        uint32_t cacheSize = 16, std::vector<uint32_t>* clusters = nullptr);
+
+        // Reorders clusters of a cache-optimized index buffer so outward-facing parts draw first.
+        // positions are float3 at positionStride bytes. dst may alias indices. Returns the number of clusters.
+        static uint32_t OptimizeOverdraw(uint32_t* dst, const uint32_t* indices, uint32_t indexCount,
+                                         const float* positions, uint32_t positionStride, uint32_t vertexCount,
+                                         const std::vector<uint32_t>& hardClusters, uint32_t cacheSize = 16, float threshold = 1.05f);
+
+        // Builds remap[old] = new in first-use order and rewrites indices in place; unreferenced vertices map to UINT32_MAX.
+        // Returns the number of referenced vertices.
+        static uint32_t OptimizeVertexFetchRemap(std::vector<uint32_t>& remap, uint32_t* indices, uint32_t indexCount, uint32_t vertexCount);
+
+        // Applies a remap table to one vertex stream of vertexSize bytes per vertex; dst must not alias src
+        static void RemapVertices(void* dst, const void* src, uint32_t vertexCount, uint32_t vertexSize, const std::vector<uint32_t>& remap);
+
+        // Full pipeline on a single interleaved vertex stream: cache -> overdraw -> fetch. The float3 position sits at
+        // positionOffset in each vertex. vertices is compacted in place to report.fetchedVertices entries.
+        static MeshOptimizeReport Optimize(std::vector<uint32_t>& indices, void* vertices, uint32_t vertexCount, uint32_t vertexSize,
+                                           uint32_t positionOffset, const MeshOptimizeSettings& settings = {});
+    };
+}
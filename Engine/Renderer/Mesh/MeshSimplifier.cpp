@@ -0,0 +1,441 @@
+#include "Renderer/Mesh/MeshSimplifier.h"
+#include "Renderer/Mesh/MeshOptimizer.h"
+#include "Core/Hash.h"
+#include "Core/JobSystem.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace SoulEngine
+{
+    namespace
+    {
+        // Symmetric 4x4 error quadric, stored as its 10 unique coefficients plus the accumulated area
+        struct Quadric
+        {
+            double a00 = 0, a01 = 0, a02 = 0, a03 = 0;
+            double a11 = 0, a12 = 0, a13 = 0;
+            double a22 = 0, a23 = 0;
+            double a33 = 0;
+            double weight = 0;
+
+            void AddPlane(double nx, double ny, double nz, double d, double w)
+            {
+                a00 += w * nx * nx; a01 += w * nx * ny; a02 += w * nx * nz; a03 += w * nx * d;
+                a11 += w * ny * ny; a12 += w * ny * nz; a13 += w * ny * d;
+                a22 += w * nz * nz; a23 += w * nz * d;
+                a33 += w * d * d;
+                weight += w;
+            }
+
+            void Add(const Quadric& q)
+            {
+                a00 += q.a00; a01 += q.a01; a02 += q.a02; a03 += q.a03;
+                a11 += q.a11; a12 += q.a12; a13 += q.a13;
+                a22 += q.a22; a23 += q.a23;
+                a33 += q.a33;
+                weight += q.weight;
+            }
+
+            double Evaluate(const float* p) const
+            {
+                const double x = p[0], y = p[1], z = p[2];
+                return a00 * x * x + 2 * a01 * x * y + 2 * a02 * x * z + 2 * a03 * x +
+                       a11 * y * y + 2 * a12 * y * z + 2 * a13 * y +
+                       a22 * z * z + 2 * a23 * z + a33;
+            }
+        };
+
+        // Squared distance implied by the combined quadric of a collapse evaluated at the kept vertex
+        double CollapseCost(const Quadric& a, const Quadric& b, const float* p)
+        {
+            Quadric q = a;
+            q.Add(b);
+            const double e = q.Evaluate(p);
+            return q.weight > 0.0 ? std::max(e, 0.0) / q.weight : 0.0;
+        }
+
+        void Cross(const float* a, const float* b, const float* c, double n[3])
+        {
+            const double e1[3] = { double(b[0]) - a[0], double(b[1]) - a[1], double(b[2]) - a[2] };
+            const double e2[3] = { double(c[0]) - a[0], double(c[1]) - a[1], double(c[2]) - a[2] };
+            n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+            n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+            n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+        }
+
+        struct PositionKey
+        {
+            uint32_t bits[3];
+            bool operator==(const PositionKey& o) const { return std::memcmp(bits, o.bits, sizeof(bits)) == 0; }
+        };
+
+        struct PositionKeyHash
+        {
+            size_t operator()(const PositionKey& k) const { return static_cast<size_t>(HashFNV1a(k.bits, sizeof(k.bits))); }
+        };
+
+        struct Candidate
+        {
+            double cost;
+            uint32_t from;
+            uint32_t to;
+        };
+
+        // Border edges get a plane through the edge, perpendicular to the face, so sliding along a curved border costs
+        constexpr double kBorderWeight = 10.0;
+    }
+
+    uint32_t MeshSimplifier::Simplify(uint32_t* dst, const MeshSimplifyInput& input, uint32_t targetIndexCount,
+                                      float targetError, bool lockBorder, float* outError)
+    {
+        const uint32_t indexCount = input.indexCount - input.indexCount % 3;
+        const uint32_t vertexCount = input.vertexCount;
+        if (outError)
+            *outError = 0.0f;
+
+        std::vector<uint32_t> indices(input.indices, input.indices + indexCount);
+        for (uint32_t i = 0; i < indexCount; ++i)
+        {
+            if (indices[i] >= vertexCount)
+            {
+                Logger::Error("MeshSimplifier: index {} at {} is out of range ({} vertices)", indices[i], i, vertexCount);
+                std::memmove(dst, input.indices, indexCount * sizeof(uint32_t));
+                return indexCount;
+            }
+        }
+
+        auto position = [&](uint32_t v) {
+            return reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(input.positions) + static_cast<size_t>(v) * input.positionStride);
+        };
+
+        // Weld by position: topology and quadrics live on the canonical vertex, attributes stay on the originals
+        std::vector<uint32_t> canonical(vertexCount);
+        std::vector<uint32_t> originals(vertexCount, 0);
+        {
+            std::unordered_map<PositionKey, uint32_t, PositionKeyHash> welded;
+            welded.reserve(vertexCount);
+            for (uint32_t v = 0; v < vertexCount; ++v)
+            {
+                PositionKey key;
+                std::memcpy(key.bits, position(v), sizeof(key.bits));
+                canonical[v] = welded.emplace(key, v).first->second;
+            }
+            std::vector<uint8_t> referenced(vertexCount, 0);
+            for (uint32_t i = 0; i < indexCount; ++i)
+            {
+                if (!referenced[indices[i]])
+                {
+                    referenced[indices[i]] = 1;
+                    ++originals[canonical[indices[i]]];
+                }
+            }
+        }
+
+        // Initial quadrics from the face planes, weighted by area
+        std::vector<Quadric> quadrics(vertexCount);
+        for (uint32_t i = 0; i < indexCount; i += 3)
+        {
+            const uint32_t c[3] = { canonical[indices[i]], canonical[indices[i + 1]], canonical[indices[i + 2]] };
+            double n[3];
+            Cross(position(c[0]), position(c[1]), position(c[2]), n);
+            const double len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (len <= 0.0)
+                continue;
+            n[0] /= len; n[1] /= len; n[2] /= len;
+            const float* p0 = position(c[0]);
+            const double d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+            for (uint32_t k = 0; k < 3; ++k)
+                quadrics[c[k]].AddPlane(n[0], n[1], n[2], d, len * 0.5);
+        }
+
+        // Border edges: canonical edges used by a single triangle
+        {
+            std::unordered_map<uint64_t, uint32_t> edgeUse;
+            edgeUse.reserve(indexCount);
+            auto edgeKey = [](uint32_t a, uint32_t b) { return a < b ? (uint64_t(a) << 32 | b) : (uint64_t(b) << 32 | a); };
+            for (uint32_t i = 0; i < indexCount; i += 3)
+                for (uint32_t k = 0; k < 3; ++k)
+                    ++edgeUse[edgeKey(canonical[indices[i + k]], canonical[indices[i + (k + 1) % 3]])];
+
+            for (uint32_t i = 0; i < indexCount; i += 3)
+            {
+                const uint32_t c[3] = { canonical[indices[i]], canonical[indices[i + 1]], canonical[indices[i + 2]] };
+                double n[3];
+                Cross(position(c[0]), position(c[1]), position(c[2]), n);
+                for (uint32_t k = 0; k < 3; ++k)
+                {
+                    const uint32_t a = c[k], b = c[(k + 1) % 3];
+                    if (edgeUse[edgeKey(a, b)] != 1)
+                        continue;
+                    const float* pa = position(a);
+                    const float* pb = position(b);
+                    const double e[3] = { double(pb[0]) - pa[0], double(pb[1]) - pa[1], double(pb[2]) - pa[2] };
+                    double m[3] = { e[1] * n[2] - e[2] * n[1], e[2] * n[0] - e[0] * n[2], e[0] * n[1] - e[1] * n[0] };
+                    const double len = std::sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+                    if (len <= 0.0)
+                        continue;
+                    m[0] /= len; m[1] /= len; m[2] /= len;
+                    const double d = -(m[0] * pa[0] + m[1] * pa[1] + m[2] * pa[2]);
+                    const double w = kBorderWeight * (e[0] * e[0] + e[1] * e[1] + e[2] * e[2]);
+                    quadrics[a].AddPlane(m[0], m[1], m[2], d, w);
+                    quadrics[b].AddPlane(m[0], m[1], m[2], d, w);
+                }
+            }
+        }
+
+        const uint32_t targetTriangles = targetIndexCount / 3;
+        const double maxCost = targetError > 0.0f ? double(targetError) * targetError : -1.0;
+        double resultCost = 0.0;
+
+        std::vector<uint32_t> fanCount(vertexCount), fanOffset(vertexCount + 1), fan;
+        std::vector<uint32_t> neighbourCount(vertexCount, 0);
+        std::vector<uint32_t> neighbours;
+        std::vector<Candidate> candidates;
+        std::vector<uint8_t> moved(vertexCount), frozen(vertexCount);
+        std::vector<uint32_t> collapseTo(vertexCount);
+
+        while (indices.size() / 3 > targetTriangles)
+        {
+            const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+            // Canonical vertex -> triangles
+            std::fill(fanCount.begin(), fanCount.end(), 0);
+            for (uint32_t idx : indices)
+                ++fanCount[canonical[idx]];
+            fanOffset[0] = 0;
+            for (uint32_t v = 0; v < vertexCount; ++v)
+                fanOffset[v + 1] = fanOffset[v] + fanCount[v];
+            fan.resize(indices.size());
+            for (uint32_t t = 0; t < triangleCount; ++t)
+                for (uint32_t k = 0; k < 3; ++k)
+                {
+                    const uint32_t c = canonical[indices[t * 3 + k]];
+                    fan[fanOffset[c + 1] - fanCount[c]--] = t;
+                }
+
+            // Cheapest collapse per movable vertex
+            candidates.clear();
+            for (uint32_t v = 0; v < vertexCount; ++v)
+            {
+                if (fanOffset[v] == fanOffset[v + 1] || canonical[v] != v || originals[v] > 1)
+                    continue;
+
+                neighbours.clear();
+                for (uint32_t f = fanOffset[v]; f < fanOffset[v + 1]; ++f)
+                    for (uint32_t k = 0; k < 3; ++k)
+                    {
+                        const uint32_t u = canonical[indices[fan[f] * 3 + k]];
+                        if (u == v)
+                            continue;
+                        if (neighbourCount[u]++ == 0)
+                            neighbours.push_back(u);
+                    }
+
+                bool border = false, nonManifold = false;
+                for (uint32_t u : neighbours)
+                {
+                    border |= neighbourCount[u] == 1;
+                    nonManifold |= neighbourCount[u] > 2;
+                }
+
+                Candidate best = { -1.0, v, v };
+                if (!nonManifold && !(border && lockBorder))
+                {
+                    for (uint32_t u : neighbours)
+                    {
+                        // Border vertices may only slide along the border
+                        if (border && neighbourCount[u] != 1)
+                            continue;
+                        const double cost = CollapseCost(quadrics[v], quadrics[u], position(u));
+                        if (best.cost < 0.0 || cost < best.cost)
+                            best = { cost, v, u };
+                    }
+                }
+                for (uint32_t u : neighbours)
+                    neighbourCount[u] = 0;
+
+                if (best.cost >= 0.0 && (maxCost < 0.0 || best.cost <= maxCost))
+                    candidates.push_back(best);
+            }
+            if (candidates.empty())
+                break;
+
+            std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+                return a.cost < b.cost || (a.cost == b.cost && a.from < b.from);
+            });
+
+            // Greedy independent set: a collapse only sees a fan that no other collapse in this pass has touched
+            std::fill(moved.begin(), moved.end(), 0);
+            std::fill(frozen.begin(), frozen.end(), 0);
+            uint32_t removed = 0;
+            const uint32_t toRemove = triangleCount - targetTriangles;
+            for (const Candidate& c : candidates)
+            {
+                if (removed >= toRemove)
+                    break;
+                const uint32_t v = c.from, t = c.to;
+                if (frozen[v] || moved[v] || moved[t])
+                    continue;
+
+                bool valid = true;
+                uint32_t shared = 0;
+                uint32_t target = UINT32_MAX;
+                const float* pt = position(t);
+                for (uint32_t f = fanOffset[v]; f < fanOffset[v + 1] && valid; ++f)
+                {
+                    const uint32_t* tri = &indices[fan[f] * 3];
+                    const uint32_t cc[3] = { canonical[tri[0]], canonical[tri[1]], canonical[tri[2]] };
+                    bool hasTarget = false;
+                    for (uint32_t k = 0; k < 3; ++k)
+                    {
+                        if (moved[cc[k]])
+                            valid = false;
+                        if (cc[k] == t)
+                        {
+                            hasTarget = true;
+                            target = tri[k];   // the original of t on v's side of any attribute seam
+                        }
+                    }
+                    if (hasTarget)
+                    {
+                        ++shared;
+                        continue;
+                    }
+
+                    // Reject collapses that flip or nearly degenerate a remaining triangle
+                    const float* p[3] = { position(cc[0]), position(cc[1]), position(cc[2]) };
+                    double before[3], after[3];
+                    Cross(p[0], p[1], p[2], before);
+                    for (uint32_t k = 0; k < 3; ++k)
+                        if (cc[k] == v)
+                            p[k] = pt;
+                    Cross(p[0], p[1], p[2], after);
+                    const double dot = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+                    const double lb = std::sqrt(before[0] * before[0] + before[1] * before[1] + before[2] * before[2]);
+                    const double la = std::sqrt(after[0] * after[0] + after[1] * after[1] + after[2] * after[2]);
+                    if (dot <= 0.25 * lb * la)
+                        valid = false;
+                }
+                if (!valid || target == UINT32_MAX)
+                    continue;
+
+                moved[v] = 1;
+                frozen[t] = 1;
+                for (uint32_t f = fanOffset[v]; f < fanOffset[v + 1]; ++f)
+                    for (uint32_t k = 0; k < 3; ++k)
+                        frozen[canonical[indices[fan[f] * 3 + k]]] = 1;
+                collapseTo[v] = target;
+                quadrics[t].Add(quadrics[v]);
+                resultCost = std::max(resultCost, c.cost);
+                removed += shared;
+            }
+            if (removed == 0)
+                break;
+
+            // Rewrite the index buffer and drop triangles that became degenerate. moved/collapseTo are keyed by
+            // canonical vertex, which need not be the (single) referenced original of a movable vertex.
+            uint32_t out = 0;
+            for (uint32_t t = 0; t < triangleCount; ++t)
+            {
+                uint32_t tri[3];
+                for (uint32_t k = 0; k < 3; ++k)
+                {
+                    const uint32_t idx = indices[t * 3 + k];
+                    const uint32_t c = canonical[idx];
+                    tri[k] = moved[c] ? collapseTo[c] : idx;
+                }
+                const uint32_t c0 = canonical[tri[0]], c1 = canonical[tri[1]], c2 = canonical[tri[2]];
+                if (c0 == c1 || c1 == c2 || c0 == c2)
+                    continue;
+                indices[out++] = tri[0];
+                indices[out++] = tri[1];
+                indices[out++] = tri[2];
+            }
+            // removed only estimates the pass; stop when nothing was actually dropped
+            const bool progressed = out < indices.size();
+            indices.resize(out);
+            if (!progressed)
+                break;
+        }
+
+        if (outError)
+            *outError = static_cast<float>(std::sqrt(resultCost));
+        std::memcpy(dst, indices.data(), indices.size() * sizeof(uint32_t));
+        return static_cast<uint32_t>(indices.size());
+    }
+
+    MeshLodChain MeshSimplifier::BuildLodChain(const MeshSimplifyInput& input, const MeshLodSettings& settings)
+    {
+        MeshLodChain chain;
+        const uint32_t indexCount = input.indexCount - input.indexCount % 3;
+        chain.indices.assign(input.indices, input.indices + indexCount);
+        chain.levels.push_back({ 0, indexCount, 0.0f });
+
+        std::vector<uint32_t> current(chain.indices);
+        std::vector<uint32_t> next(indexCount);
+        float error = 0.0f;
+        while (chain.levels.size() < settings.maxLevels)
+        {
+            const uint32_t triangles = static_cast<uint32_t>(current.size() / 3);
+            const uint32_t target = static_cast<uint32_t>(triangles * settings.levelRatio);
+            if (target < settings.minTriangles)
+                break;
+
+            float budget = 0.0f;
+            if (settings.maxError > 0.0f)
+            {
+                budget = settings.maxError - error;
+                if (budget <= 0.0f)
+                    break;
+            }
+
+            // Each level simplifies the previous one, so errors add up to a conservative bound against LOD 0
+            MeshSimplifyInput levelInput = input;
+            levelInput.indices = current.data();
+            levelInput.indexCount = static_cast<uint32_t>(current.size());
+            float levelError = 0.0f;
+            const uint32_t count = Simplify(next.data(), levelInput, target * 3, budget, settings.lockBorder, &levelError);
+            if (count == 0 || count >= current.size() * 95 / 100)
+                break;
+
+            if (settings.optimizeVertexCache)
+                MeshOptimizer::OptimizeVertexCache(next.data(), next.data(), count, input.vertexCount);
+
+            error += levelError;
+            chain.levels.push_back({ static_cast<uint32_t>(chain.indices.size()), count, error });
+            chain.indices.insert(chain.indices.end(), next.begin(), next.begin() + count);
+            current.assign(next.begin(), next.begin() + count);
+        }
+        return chain;
+    }
+
+    std::vector<MeshLodChain> MeshSimplifier::BuildLodChains(const std::vector<MeshSimplifyInput>& inputs, const MeshLodSettings& settings)
+    {
+        std::vector<MeshLodChain> chains(inputs.size());
+        JobSystem::GetInstance().ParallelFor(static_cast<uint32_t>(inputs.size()), 1, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i)
+                chains[i] = BuildLodChain(inputs[i], settings);
+        });
+        return chains;
+    }
+
+    float MeshSimplifier::GetScreenScale(float viewportHeight, float fovY)
+    {
+        return viewportHeight / (2.0f * std::tan(fovY * 0.5f));
+    }
+
+    uint32_t MeshLodChain::SelectLevel(float distance, float screenScale, float maxPixelError, float objectScale) const
+    {
+        if (distance <= 0.0f)
+            return 0;
+        for (size_t level = levels.size(); level-- > 1;)
+        {
+            if (levels[level].error * objectScale * screenScale <= maxPixelError * distance)
+                return static_cast<uint32_t>(level);
+        }
+        return 0;
+    }
+}
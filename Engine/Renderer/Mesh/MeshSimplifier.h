@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Define.h"
+
+namespace SoulEngine
+{
+    // Triangle list view with float3 positions; all LODs of a mesh index the same vertex buffer
+    struct MeshSimplifyInput
+    {
+        const uint32_t* indices = nullptr;
+        uint32_t indexCount = 0;
+        const float* positions = nullptr;
+        uint32_t positionStride = 12;
+        uint32_t vertexCount = 0;
+    };
+
+    struct MeshLodSettings
+    {
+        uint32_t maxLevels = 6;             // including LOD 0
+        float levelRatio = 0.5f;            // target triangle ratio of each level against the previous one
+        uint32_t minTriangles = 32;         // stop once a level would drop below this
+        float maxError = 0.0f;              // object-space limit for the whole chain, 0 = unlimited
+        bool lockBorder = false;            // keep open borders (e.g. grid edges stitched to neighbours) untouched
+        bool optimizeVertexCache = true;    // reorder every level with MeshOptimizer::OptimizeVertexCache
+    };
+
+    struct MeshLodLevel
+    {
+        uint32_t firstIndex = 0;            // into MeshLodChain::indices
+        uint32_t indexCount = 0;
+        float error = 0.0f;                 // object-space deviation from LOD 0 (upper bound)
+    };
+
+    struct MeshLodChain
+    {
+        std::vector<uint32_t> indices;      // every level back to back, upload once
+        std::vector<MeshLodLevel> levels;   // levels[0] is the source mesh
+
+        // Picks the coarsest level whose error projects to at most maxPixelError pixels at distance.
+        // screenScale comes from MeshSimplifier::GetScreenScale; objectScale is the largest axis scale of the instance.
+        uint32_t SelectLevel(float distance, float screenScale, float maxPixelError, float objectScale = 1.0f) const;
+    };
+
+    /**
+     * @brief 基于二次误差度量（Garland-Heckbert）的网格简化与 LOD 链生成
+     * 采用半边折叠：顶点只会折叠到已有顶点上，所以所有 LOD 共用同一份顶点缓冲，LOD 之间只有索引不同。
+     * 位置相同但属性不同的顶点（UV/法线接缝）视为接缝顶点，不会被移走，以免撕裂属性。
+     * 每一轮选取一批互不相邻的最小代价折叠，并拒绝会使三角形翻转的折叠。
+     *
+     * 使用方式:
+     *   MeshLodChain chain = MeshSimplifier::BuildLodChain(input);
+     *   uint32_t lod = chain.SelectLevel(distance, MeshSimplifier::GetScreenScale(viewportHeight, fovY), 1.0f);
+     *   const MeshLodLevel& level = chain.levels[lod];
+     *   context->DrawIndexed(level.indexCount, range->firstIndex + level.firstIndex, range->baseVertex);
+     */
+    class MeshSimplifier
+    {
+        STATIC_CLASS(MeshSimplifier);
+
+    public:
+        // Writes at most input.indexCount indices to dst (which may alias input.indices) and returns the count.
+        // Stops at targetIndexCount or when the next collapse would exceed targetError (object space, 0 = unlimited).
+        static uint32_t Simplify(uint32_t* dst, const MeshSimplifyInput& input, uint32_t targetIndexCount,
+                                 float targetError = 0.0f, bool lockBorder = false, float* outError = nullptr);
+
+        static MeshLodChain BuildLodChain(const MeshSimplifyInput& input, const MeshLodSettings& settings = {});
+
+        // One mesh per job on the JobSystem; the result order matches inputs
+        static std::vector<MeshLodChain> BuildLodChains(const std::vector<MeshSimplifyInput>& inputs, const MeshLodSettings& settings = {});
+
+        // Pixels per object-space unit at distance 1 for a perspective projection
+        static float GetScreenScale(float viewportHeight, float fovY);
+    };
+}
@@ -0,0 +1,518 @@
+#include "Renderer/Mesh/VertexCompression.h"
+#include "Renderer/GfxPackedFormats.h"
+#include "Core/JobSystem.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOULENGINE_VERTEX_COMPRESSION_SSE2 1
+#endif
+
+namespace SoulEngine
+{
+    using Gfx::DataFormat;
+
+    namespace
+    {
+        constexpr uint32_t kSourceComponents[kVertexSemanticCount] = { 3, 3, 4, 2, 2, 4 };
+        constexpr uint32_t kParallelGrain = 8192;
+
+        uint32_t GetComponentCount(VertexSemantic semantic)
+        {
+            return kSourceComponents[static_cast<uint32_t>(semantic)];
+        }
+
+        bool IsSupported(VertexSemantic semantic, DataFormat fmt)
+        {
+            switch (semantic)
+            {
+            case VertexSemantic::Position:
+                return fmt == DataFormat::R32G32B32_Float || fmt == DataFormat::R16G16B16A16_Float ||
+                       fmt == DataFormat::R16G16B16A16_SNorm;
+            case VertexSemantic::Normal:
+                return fmt == DataFormat::R32G32B32_Float || fmt == DataFormat::R16G16_SNorm_Oct ||
+                       fmt == DataFormat::R8G8_SNorm_Oct || fmt == DataFormat::R10G10B10A2_SNorm ||
+                       fmt == DataFormat::R8G8B8A8_SNorm || fmt == DataFormat::R16G16B16A16_SNorm;
+            case VertexSemantic::Tangent:
+                return fmt == DataFormat::R32G32B32A32_Float || fmt == DataFormat::R10G10B10A2_SNorm ||
+                       fmt == DataFormat::R8G8B8A8_SNorm || fmt == DataFormat::R16G16B16A16_SNorm;
+            case VertexSemantic::TexCoord0:
+            case VertexSemantic::TexCoord1:
+                return fmt == DataFormat::R32G32_Float || fmt == DataFormat::R16G16_Float ||
+                       fmt == DataFormat::R16G16_UNorm || fmt == DataFormat::R16G16_SNorm;
+            case VertexSemantic::Color:
+                return fmt == DataFormat::R32G32B32A32_Float || fmt == DataFormat::R16G16B16A16_Float ||
+                       fmt == DataFormat::R8G8B8A8_UNorm || fmt == DataFormat::R10G10B10A2_UNorm;
+            default:
+                return false;
+            }
+        }
+
+        bool IsOctahedral(DataFormat fmt)
+        {
+            return fmt == DataFormat::R16G16_SNorm_Oct || fmt == DataFormat::R8G8_SNorm_Oct;
+        }
+
+        const float* GetSource(const VertexSourceF32::Stream& stream, uint32_t components, uint32_t vertex)
+        {
+            const uint32_t stride = stream.stride ? stream.stride : components * 4u;
+            return reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(stream.data) + static_cast<size_t>(vertex) * stride);
+        }
+
+        // Packs up to four floats into fmt at dst. Components beyond the format's width are ignored.
+#if defined(SOULENGINE_VERTEX_COMPRESSION_SSE2)
+        inline __m128 Clamp(__m128 v, float lo, float hi)
+        {
+            return _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(lo)), _mm_set1_ps(hi));
+        }
+
+        // Four floats to binary16 in the low half of each lane, round-to-nearest-even (branch-free FloatToHalf)
+        inline __m128i FloatToHalf4(__m128 f)
+        {
+            const __m128i maskSign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+            const __m128i f16Max = _mm_set1_epi32((127 + 16) << 23);
+            const __m128i nanBit = _mm_set1_epi32(0x200);
+            const __m128i infinity = _mm_set1_epi32(0x7C00);
+            const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+            const __m128i subnormMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+            const __m128i normalBias = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+
+            const __m128 justSign = _mm_and_ps(_mm_castsi128_ps(maskSign), f);
+            const __m128 absF = _mm_xor_ps(f, justSign);
+            const __m128i absInt = _mm_castps_si128(absF);
+            const __m128 isNan = _mm_cmpunord_ps(absF, absF);
+            const __m128i isRegular = _mm_cmpgt_epi32(f16Max, absInt);
+            const __m128i special = _mm_or_si128(_mm_and_si128(_mm_castps_si128(isNan), nanBit), infinity);
+
+            const __m128i isSubnormal = _mm_cmpgt_epi32(minNormal, absInt);
+            const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absF, _mm_castsi128_ps(subnormMagic))), subnormMagic);
+
+            const __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absInt, 31 - 13), 31);
+            const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absInt, normalBias), mantissaOdd), 13);
+
+            const __m128i finite = _mm_or_si128(_mm_and_si128(subnormal, isSubnormal), _mm_andnot_si128(isSubnormal, normal));
+            const __m128i joined = _mm_or_si128(_mm_and_si128(finite, isRegular), _mm_andnot_si128(isRegular, special));
+            // Sign-extended so _mm_packs_epi32 keeps the low 16 bits intact
+            return _mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(justSign), 16));
+        }
+
+        inline void StoreBytes(uint8_t* dst, __m128i v, uint32_t bytes)
+        {
+            if (bytes == 8)
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), v);
+            else
+            {
+                const int32_t lo = _mm_cvtsi128_si32(v);
+                std::memcpy(dst, &lo, bytes);
+            }
+        }
+
+        inline void PackFormat(DataFormat fmt, const float in[4], uint8_t* dst)
+        {
+            const __m128 v = _mm_loadu_ps(in);
+            switch (fmt)
+            {
+            case DataFormat::R16G16_SNorm:
+            case DataFormat::R16G16_SNorm_Oct:
+            case DataFormat::R16G16B16A16_SNorm:
+            {
+                const __m128i q = _mm_cvtps_epi32(_mm_mul_ps(Clamp(v, -1.0f, 1.0f), _mm_set1_ps(32767.0f)));
+                StoreBytes(dst, _mm_packs_epi32(q, q), fmt == DataFormat::R16G16B16A16_SNorm ? 8u : 4u);
+                break;
+            }
+            case DataFormat::R16G16_UNorm:
+            case DataFormat::R16G16B16A16_UNorm:
+            {
+                // No unsigned 32->16 pack in SSE2: bias into the signed range, pack, then flip the top bit back
+                const __m128i q = _mm_sub_epi32(_mm_cvtps_epi32(_mm_mul_ps(Clamp(v, 0.0f, 1.0f), _mm_set1_ps(65535.0f))), _mm_set1_epi32(32768));
+                const __m128i packed = _mm_xor_si128(_mm_packs_epi32(q, q), _mm_set1_epi16(static_cast<short>(0x8000)));
+                StoreBytes(dst, packed, fmt == DataFormat::R16G16B16A16_UNorm ? 8u : 4u);
+                break;
+            }
+            case DataFormat::R8G8_SNorm:
+            case DataFormat::R8G8_SNorm_Oct:
+            case DataFormat::R8G8B8A8_SNorm:
+            {
+                const __m128i q = _mm_cvtps_epi32(_mm_mul_ps(Clamp(v, -1.0f, 1.0f), _mm_set1_ps(127.0f)));
+                const __m128i w = _mm_packs_epi32(q, q);
+                StoreBytes(dst, _mm_packs_epi16(w, w), fmt == DataFormat::R8G8B8A8_SNorm ? 4u : 2u);
+                break;
+            }
+            case DataFormat::R8G8B8A8_UNorm:
+            {
+                const __m128i q = _mm_cvtps_epi32(_mm_mul_ps(Clamp(v, 0.0f, 1.0f), _mm_set1_ps(255.0f)));
+                const __m128i w = _mm_packs_epi32(q, q);
+                StoreBytes(dst, _mm_packus_epi16(w, w), 4u);
+                break;
+            }
+            case DataFormat::R16G16_Float:
+            case DataFormat::R16G16B16A16_Float:
+            {
+                const __m128i h = FloatToHalf4(v);
+                StoreBytes(dst, _mm_packs_epi32(h, h), fmt == DataFormat::R16G16B16A16_Float ? 8u : 4u);
+                break;
+            }
+            case DataFormat::R10G10B10A2_SNorm:
+            case DataFormat::R10G10B10A2_UNorm:
+            {
+                const bool snorm = fmt == DataFormat::R10G10B10A2_SNorm;
+                const __m128 scale = snorm ? _mm_setr_ps(511.0f, 511.0f, 511.0f, 1.0f) : _mm_setr_ps(1023.0f, 1023.0f, 1023.0f, 3.0f);
+                const __m128 c = snorm ? Clamp(v, -1.0f, 1.0f) : Clamp(v, 0.0f, 1.0f);
+                alignas(16) int32_t q[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(q), _mm_cvtps_epi32(_mm_mul_ps(c, scale)));
+                const uint32_t packed = (static_cast<uint32_t>(q[0]) & 0x3FFu) | ((static_cast<uint32_t>(q[1]) & 0x3FFu) << 10) |
+                                        ((static_cast<uint32_t>(q[2]) & 0x3FFu) << 20) | ((static_cast<uint32_t>(q[3]) & 0x3u) << 30);
+                std::memcpy(dst, &packed, 4);
+                break;
+            }
+            default:
+                std::memcpy(dst, in, Gfx::GetDataFormatSize(fmt));
+                break;
+            }
+        }
+#else
+        inline void PackFormat(DataFormat fmt, const float in[4], uint8_t* dst)
+        {
+            switch (fmt)
+            {
+            case DataFormat::R16G16_SNorm:
+            case DataFormat::R16G16_SNorm_Oct:
+            case DataFormat::R16G16B16A16_SNorm:
+            {
+                int16_t q[4];
+                for (int i = 0; i < 4; ++i)
+                    q[i] = Gfx::PackSNorm16(in[i]);
+                std::memcpy(dst, q, fmt == DataFormat::R16G16B16A16_SNorm ? 8 : 4);
+                break;
+            }
+            case DataFormat::R16G16_UNorm:
+            case DataFormat::R16G16B16A16_UNorm:
+            {
+                uint16_t q[4];
+                for (int i = 0; i < 4; ++i)
+                    q[i] = Gfx::PackUNorm16(in[i]);
+                std::memcpy(dst, q, fmt == DataFormat::R16G16B16A16_UNorm ? 8 : 4);
+                break;
+            }
+            case DataFormat::R8G8_SNorm:
+            case DataFormat::R8G8_SNorm_Oct:
+            case DataFormat::R8G8B8A8_SNorm:
+            {
+                int8_t q[4];
+                for (int i = 0; i < 4; ++i)
+                    q[i] = Gfx::PackSNorm8(in[i]);
+                std::memcpy(dst, q, fmt == DataFormat::R8G8B8A8_SNorm ? 4 : 2);
+                break;
+            }
+            case DataFormat::R8G8B8A8_UNorm:
+                for (int i = 0; i < 4; ++i)
+                    dst[i] = Gfx::PackUNorm8(in[i]);
+                break;
+            case DataFormat::R16G16_Float:
+            case DataFormat::R16G16B16A16_Float:
+            {
+                uint16_t h[4];
+                for (int i = 0; i < 4; ++i)
+                    h[i] = Gfx::FloatToHalf(in[i]);
+                std::memcpy(dst, h, fmt == DataFormat::R16G16B16A16_Float ? 8 : 4);
+                break;
+            }
+            case DataFormat::R10G10B10A2_SNorm:
+            {
+                const uint32_t packed = Gfx::PackR10G10B10A2SNorm(in);
+                std::memcpy(dst, &packed, 4);
+                break;
+            }
+            case DataFormat::R10G10B10A2_UNorm:
+            {
+                const uint32_t packed = Gfx::PackR10G10B10A2UNorm(in);
+                std::memcpy(dst, &packed, 4);
+                break;
+            }
+            default:
+                std::memcpy(dst, in, Gfx::GetDataFormatSize(fmt));
+                break;
+            }
+        }
+#endif
+
+        struct ElementJob
+        {
+            const VertexSourceF32::Stream* stream;
+            uint32_t components;
+            uint32_t stride;
+            bool boundsNormalized;
+            const float* offset;
+            float invScale[3];
+        };
+
+        // One loop per format so PackFormat's switch folds away in the hot path
+        template <DataFormat Format>
+        void EncodeElement(const ElementJob& job, uint8_t* dst, uint32_t begin, uint32_t end)
+        {
+            for (uint32_t v = begin; v < end; ++v, dst += job.stride)
+            {
+                const float* src = GetSource(*job.stream, job.components, v);
+                float value[4] = { src[0], src[1], 0.0f, 1.0f };
+                if (job.components > 2)
+                    value[2] = src[2];
+                if (job.components > 3)
+                    value[3] = src[3];
+
+                if constexpr (Format == DataFormat::R16G16_SNorm_Oct || Format == DataFormat::R8G8_SNorm_Oct)
+                {
+                    const float n[3] = { value[0], value[1], value[2] };
+                    Gfx::OctEncode(n, value);
+                }
+                else if (job.boundsNormalized)
+                {
+                    for (int i = 0; i < 3; ++i)
+                        value[i] = (value[i] - job.offset[i]) * job.invScale[i];
+                }
+                PackFormat(Format, value, dst);
+            }
+        }
+
+        void EncodeRange(const VertexSourceF32& source, const CompressedVertexLayout& layout, uint8_t* out,
+                         uint32_t begin, uint32_t end)
+        {
+            // Element-major so each inner loop runs a single format
+            for (const auto& e : layout.elements)
+            {
+                ElementJob job{};
+                job.stream = &source.streams[static_cast<uint32_t>(e.semantic)];
+                job.components = GetComponentCount(e.semantic);
+                job.stride = layout.stride;
+                job.boundsNormalized = e.semantic == VertexSemantic::Position && e.format == DataFormat::R16G16B16A16_SNorm;
+                job.offset = layout.positionOffset;
+                for (int i = 0; i < 3; ++i)
+                    job.invScale[i] = 1.0f / layout.positionScale[i];
+
+                uint8_t* dst = out + static_cast<size_t>(begin) * layout.stride + e.offset;
+                switch (e.format)
+                {
+                case DataFormat::R32G32_Float:       EncodeElement<DataFormat::R32G32_Float>(job, dst, begin, end); break;
+                case DataFormat::R32G32B32_Float:    EncodeElement<DataFormat::R32G32B32_Float>(job, dst, begin, end); break;
+                case DataFormat::R32G32B32A32_Float: EncodeElement<DataFormat::R32G32B32A32_Float>(job, dst, begin, end); break;
+                case DataFormat::R8G8B8A8_UNorm:     EncodeElement<DataFormat::R8G8B8A8_UNorm>(job, dst, begin, end); break;
+                case DataFormat::R16G16_Float:       EncodeElement<DataFormat::R16G16_Float>(job, dst, begin, end); break;
+                case DataFormat::R16G16B16A16_Float: EncodeElement<DataFormat::R16G16B16A16_Float>(job, dst, begin, end); break;
+                case DataFormat::R16G16_SNorm:       EncodeElement<DataFormat::R16G16_SNorm>(job, dst, begin, end); break;
+                case DataFormat::R16G16B16A16_SNorm: EncodeElement<DataFormat::R16G16B16A16_SNorm>(job, dst, begin, end); break;
+                case DataFormat::R16G16_UNorm:       EncodeElement<DataFormat::R16G16_UNorm>(job, dst, begin, end); break;
+                case DataFormat::R8G8B8A8_SNorm:     EncodeElement<DataFormat::R8G8B8A8_SNorm>(job, dst, begin, end); break;
+                case DataFormat::R10G10B10A2_UNorm:  EncodeElement<DataFormat::R10G10B10A2_UNorm>(job, dst, begin, end); break;
+                case DataFormat::R10G10B10A2_SNorm:  EncodeElement<DataFormat::R10G10B10A2_SNorm>(job, dst, begin, end); break;
+                case DataFormat::R16G16_SNorm_Oct:   EncodeElement<DataFormat::R16G16_SNorm_Oct>(job, dst, begin, end); break;
+                case DataFormat::R8G8_SNorm_Oct:     EncodeElement<DataFormat::R8G8_SNorm_Oct>(job, dst, begin, end); break;
+                default: break;
+                }
+            }
+        }
+
+        float AngleDegrees(const float a[3], const float b[3])
+        {
+            const float la = std::sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+            const float lb = std::sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]);
+            if (la <= 0.0f || lb <= 0.0f)
+                return 0.0f;
+            float c = (a[0] * b[0] + a[1] * b[1] + a[2] * b[2]) / (la * lb);
+            c = c > 1.0f ? 1.0f : (c < -1.0f ? -1.0f : c);
+            return std::acos(c) * 57.29577951f;
+        }
+    }
+
+    VertexCompressionSettings VertexCompressionSettings::Uncompressed()
+    {
+        VertexCompressionSettings s;
+        s.Set(VertexSemantic::Position, DataFormat::R32G32B32_Float);
+        s.Set(VertexSemantic::Normal, DataFormat::R32G32B32_Float);
+        s.Set(VertexSemantic::Tangent, DataFormat::R32G32B32A32_Float);
+        s.Set(VertexSemantic::TexCoord0, DataFormat::R32G32_Float);
+        s.Set(VertexSemantic::TexCoord1, DataFormat::R32G32_Float);
+        s.Set(VertexSemantic::Color, DataFormat::R32G32B32A32_Float);
+        return s;
+    }
+
+    const CompressedVertexLayout::Element* CompressedVertexLayout::Find(VertexSemantic semantic) const
+    {
+        for (const auto& e : elements)
+            if (e.semantic == semantic)
+                return &e;
+        return nullptr;
+    }
+
+    void CompressedVertexLayout::GetPositionDequantizeMatrix(float out[16]) const
+    {
+        std::memset(out, 0, sizeof(float) * 16);
+        out[0] = positionScale[0];
+        out[5] = positionScale[1];
+        out[10] = positionScale[2];
+        out[12] = positionOffset[0];
+        out[13] = positionOffset[1];
+        out[14] = positionOffset[2];
+        out[15] = 1.0f;
+    }
+
+    std::vector<Gfx::VertexAttribute> CompressedVertexLayout::MakeAttributes(uint32_t bindingSlot, const uint32_t* locations) const
+    {
+        std::vector<Gfx::VertexAttribute> attrs;
+        attrs.reserve(elements.size());
+        for (const auto& e : elements)
+        {
+            const uint32_t semantic = static_cast<uint32_t>(e.semantic);
+            attrs.push_back({ locations ? locations[semantic] : semantic, e.format, e.offset, bindingSlot, 0 });
+        }
+        return attrs;
+    }
+
+    CompressedVertexLayout VertexCompression::BuildLayout(const VertexSourceF32& source, const VertexCompressionSettings& settings)
+    {
+        CompressedVertexLayout layout;
+        uint32_t offset = 0;
+        for (uint32_t s = 0; s < kVertexSemanticCount; ++s)
+        {
+            const DataFormat fmt = settings.formats[s];
+            if (!source.streams[s].data || fmt == DataFormat::Unknown)
+                continue;
+            layout.elements.push_back({ static_cast<VertexSemantic>(s), fmt, offset });
+            // 4-byte alignment keeps every attribute on the fast fetch path
+            offset += (Gfx::GetDataFormatSize(fmt) + 3u) & ~3u;
+        }
+        layout.stride = offset;
+
+        const auto* position = layout.Find(VertexSemantic::Position);
+        if (position && position->format == DataFormat::R16G16B16A16_SNorm && source.vertexCount > 0)
+        {
+            const auto& stream = source.streams[static_cast<uint32_t>(VertexSemantic::Position)];
+            float lo[3], hi[3];
+            const float* first = GetSource(stream, 3, 0);
+            for (int i = 0; i < 3; ++i)
+                lo[i] = hi[i] = first[i];
+            for (uint32_t v = 1; v < source.vertexCount; ++v)
+            {
+                const float* p = GetSource(stream, 3, v);
+                for (int i = 0; i < 3; ++i)
+                {
+                    lo[i] = std::min(lo[i], p[i]);
+                    hi[i] = std::max(hi[i], p[i]);
+                }
+            }
+            for (int i = 0; i < 3; ++i)
+            {
+                const float halfExtent = (hi[i] - lo[i]) * 0.5f;
+                layout.positionOffset[i] = (hi[i] + lo[i]) * 0.5f;
+                layout.positionScale[i] = halfExtent > 0.0f ? halfExtent : 1.0f;
+            }
+        }
+        return layout;
+    }
+
+    bool VertexCompression::Encode(const VertexSourceF32& source, const CompressedVertexLayout& layout, void* out)
+    {
+        for (const auto& e : layout.elements)
+        {
+            if (!source.streams[static_cast<uint32_t>(e.semantic)].data)
+            {
+                Logger::Error("VertexCompression: layout references semantic {} missing from the source", static_cast<uint32_t>(e.semantic));
+                return false;
+            }
+            if (!IsSupported(e.semantic, e.format))
+            {
+                Logger::Error("VertexCompression: format {} is not supported for semantic {}",
+                              static_cast<uint32_t>(e.format), static_cast<uint32_t>(e.semantic));
+                return false;
+            }
+        }
+
+        auto* dst = static_cast<uint8_t*>(out);
+        if (source.vertexCount <= kParallelGrain)
+        {
+            EncodeRange(source, layout, dst, 0, source.vertexCount);
+        }
+        else
+        {
+            JobSystem::GetInstance().ParallelFor(source.vertexCount, kParallelGrain, [&](uint32_t begin, uint32_t end) {
+                EncodeRange(source, layout, dst, begin, end);
+            });
+        }
+        return true;
+    }
+
+    std::vector<uint8_t> VertexCompression::Compress(const VertexSourceF32& source, const VertexCompressionSettings& settings,
+                                                     CompressedVertexLayout& outLayout)
+    {
+        outLayout = BuildLayout(source, settings);
+        std::vector<uint8_t> data(static_cast<size_t>(source.vertexCount) * outLayout.stride);
+        if (!Encode(source, outLayout, data.data()))
+            data.clear();
+        return data;
+    }
+
+    VertexCompressionReport VertexCompression::Measure(const VertexSourceF32& source, const CompressedVertexLayout& layout, const void* encoded)
+    {
+        VertexCompressionReport report;
+        for (uint32_t s = 0; s < kVertexSemanticCount; ++s)
+            if (source.streams[s].data)
+                report.sourceBytesPerVertex += kSourceComponents[s] * 4u;
+        report.compressedBytesPerVertex = layout.stride;
+
+        const auto* base = static_cast<const uint8_t*>(encoded);
+        for (const auto& e : layout.elements)
+        {
+            const uint32_t components = GetComponentCount(e.semantic);
+            const auto& stream = source.streams[static_cast<uint32_t>(e.semantic)];
+            for (uint32_t v = 0; v < source.vertexCount; ++v)
+            {
+                const float* src = GetSource(stream, components, v);
+                float decoded[4];
+                Gfx::DecodeVertexFormat(e.format, base + static_cast<size_t>(v) * layout.stride + e.offset, decoded);
+
+                switch (e.semantic)
+                {
+                case VertexSemantic::Position:
+                {
+                    const bool boundsNormalized = e.format == DataFormat::R16G16B16A16_SNorm;
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        const float p = boundsNormalized ? decoded[i] * layout.positionScale[i] + layout.positionOffset[i] : decoded[i];
+                        report.maxPositionError = std::max(report.maxPositionError, std::fabs(p - src[i]));
+                    }
+                    break;
+                }
+                case VertexSemantic::Normal:
+                {
+                    float n[3] = { decoded[0], decoded[1], decoded[2] };
+                    if (IsOctahedral(e.format))
+                        Gfx::OctDecode(decoded, n);
+                    report.maxNormalErrorDegrees = std::max(report.maxNormalErrorDegrees, AngleDegrees(n, src));
+                    break;
+                }
+                case VertexSemantic::Tangent:
+                {
+                    // A flipped handedness mirrors the bitangent, which is as wrong as it gets
+                    const bool flipped = (decoded[3] < 0.0f) != (src[3] < 0.0f);
+                    const float error = flipped ? 180.0f : AngleDegrees(decoded, src);
+                    report.maxTangentErrorDegrees = std::max(report.maxTangentErrorDegrees, error);
+                    break;
+                }
+                case VertexSemantic::TexCoord0:
+                case VertexSemantic::TexCoord1:
+                    for (int i = 0; i < 2; ++i)
+                        report.maxTexCoordError = std::max(report.maxTexCoordError, std::fabs(decoded[i] - src[i]));
+                    break;
+                case VertexSemantic::Color:
+                    for (int i = 0; i < 4; ++i)
+                        report.maxColorError = std::max(report.maxColorError, std::fabs(decoded[i] - src[i]));
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+        return report;
+    }
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Define.h"
+#include "Renderer/Gfx.h"
+
+namespace SoulEngine
+{
+    enum class VertexSemantic : uint8_t { Position, Normal, Tangent, TexCoord0, TexCoord1, Color, Count };
+
+    constexpr uint32_t kVertexSemanticCount = static_cast<uint32_t>(VertexSemantic::Count);
+
+    // Full-precision source attributes. Expected component counts: position 3, normal 3 (unit length),
+    // tangent 4 (w = handedness ±1), texcoords 2, color 4. A stride of 0 means tightly packed.
+    struct VertexSourceF32
+    {
+        struct Stream
+        {
+            const float* data = nullptr;
+            uint32_t stride = 0;
+        };
+
+        uint32_t vertexCount = 0;
+        Stream streams[kVertexSemanticCount];
+
+        void Set(VertexSemantic semantic, const float* data, uint32_t stride = 0)
+        {
+            streams[static_cast<uint32_t>(semantic)] = { data, stride };
+        }
+    };
+
+    // Target format per semantic; Unknown drops the attribute. Supported targets:
+    //   Position  R32G32B32_Float, R16G16B16A16_Float, R16G16B16A16_SNorm (normalized to the mesh bounds)
+    //   Normal    R32G32B32_Float, R16G16_SNorm_Oct, R8G8_SNorm_Oct, R10G10B10A2_SNorm, R8G8B8A8_SNorm, R16G16B16A16_SNorm
+    //   Tangent   R32G32B32A32_Float, R10G10B10A2_SNorm, R8G8B8A8_SNorm, R16G16B16A16_SNorm
+    //   TexCoord  R32G32_Float, R16G16_Float, R16G16_UNorm, R16G16_SNorm
+    //   Color     R32G32B32A32_Float, R16G16B16A16_Float, R8G8B8A8_UNorm, R10G10B10A2_UNorm
+    struct VertexCompressionSettings
+    {
+        Gfx::DataFormat formats[kVertexSemanticCount] = {
+            Gfx::DataFormat::R16G16B16A16_SNorm,
+            Gfx::DataFormat::R16G16_SNorm_Oct,
+            Gfx::DataFormat::R10G10B10A2_SNorm,
+            Gfx::DataFormat::R16G16_Float,
+            Gfx::DataFormat::R16G16_Float,
+            Gfx::DataFormat::R8G8B8A8_UNorm,
+        };
+
+        void Set(VertexSemantic semantic, Gfx::DataFormat format) { formats[static_cast<uint32_t>(semantic)] = format; }
+
+        // Every attribute stays 32-bit float; useful as a reference layout
+        static VertexCompressionSettings Uncompressed();
+    };
+
+    struct CompressedVertexLayout
+    {
+        struct Element
+        {
+            VertexSemantic semantic;
+            Gfx::DataFormat format;
+            uint32_t offset;
+        };
+
+        std::vector<Element> elements;      // interleaved, each element 4-byte aligned
+        uint32_t stride = 0;
+        // Bounds-normalized positions decode as position = snorm * positionScale + positionOffset
+        float positionScale[3] = { 1.0f, 1.0f, 1.0f };
+        float positionOffset[3] = { 0.0f, 0.0f, 0.0f };
+
+        const Element* Find(VertexSemantic semantic) const;
+
+        // Column-major matrix that maps decoded positions back to object space; fold it into the model matrix
+        void GetPositionDequantizeMatrix(float out[16]) const;
+
+        // Input layout for a single interleaved stream. locations[semantic] overrides the default location,
+        // which is the semantic index.
+        std::vector<Gfx::VertexAttribute> MakeAttributes(uint32_t bindingSlot = 0, const uint32_t* locations = nullptr) const;
+    };
+
+    // Maximum reconstruction error per semantic, measured against the source
+    struct VertexCompressionReport
+    {
+        uint32_t sourceBytesPerVertex = 0;      // 4 bytes per float the source provides
+        uint32_t compressedBytesPerVertex = 0;
+        float maxPositionError = 0.0f;          // object-space units
+        float maxNormalErrorDegrees = 0.0f;
+        float maxTangentErrorDegrees = 0.0f;
+        float maxTexCoordError = 0.0f;
+        float maxColorError = 0.0f;
+
+        float GetRatio() const { return compressedBytesPerVertex ? static_cast<float>(sourceBytesPerVertex) / compressedBytesPerVertex : 0.0f; }
+    };
+
+    /**
+     * @brief 顶点压缩编码器
+     * 把全精度 float 顶点转换为紧凑的交错布局（半精度 UV、包围盒归一化的 snorm16 位置、八面体法线、10:10:10:2 切线等）。
+     * 转换以 SSE2 每次处理一个顶点的全部分量，大网格按顶点区间在任务系统上并行。
+     *
+     * 使用方式:
+     *   CompressedVertexLayout layout;
+     *   std::vector<uint8_t> data = VertexCompression::Compress(source, settings, layout);
+     *   auto attrs = layout.MakeAttributes();
+     *   device->CreateVertexInputLayout(attrs.data(), attrs.size());
+     */
+    class VertexCompression
+    {
+        STATIC_CLASS(VertexCompression);
+
+    public:
+        // Resolves offsets and the stride for the semantics present in source, and the position bounds
+        static CompressedVertexLayout BuildLayout(const VertexSourceF32& source, const VertexCompressionSettings& settings);
+
+        // Writes source.vertexCount * layout.stride bytes to out; false on an unsupported semantic/format pair
+        static bool Encode(const VertexSourceF32& source, const CompressedVertexLayout& layout, void* out);
+
+        static std::vector<uint8_t> Compress(const VertexSourceF32& source, const VertexCompressionSettings& settings,
+                                             CompressedVertexLayout& outLayout);
+
+        // Decodes the encoded stream again and compares it with source
+        static VertexCompressionReport Measure(const VertexSourceF32& source, const CompressedVertexLayout& layout, const void* encoded);
+    };
+}
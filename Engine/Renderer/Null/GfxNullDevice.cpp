@@ -0,0 +1,206 @@
+#include "Renderer/Null/GfxNullDevice.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+namespace SoulEngine::Gfx
+{
+    namespace
+    {
+        class NullBuffer final : public IBuffer
+        {
+        public:
+            NullBuffer(const BufferDesc& desc, const SubresourceData* initial)
+                : desc_(desc), data_(desc.size, 0)
+            {
+                desc_.name = nullptr;
+                if (initial && initial->data)
+                    Update(*initial);
+            }
+
+            const BufferDesc& GetDesc() const override { return desc_; }
+
+            void Update(const SubresourceData& src) override
+            {
+                if (!src.data || src.offset >= data_.size())
+                    return;
+                const std::size_t size = std::min(src.size ? src.size : desc_.size, data_.size() - src.offset);
+                std::memcpy(data_.data() + src.offset, src.data, size);
+            }
+
+            void* Map(MapMode) override { return data_.data(); }
+            void Unmap() override {}
+
+        private:
+            BufferDesc desc_{};
+            std::vector<uint8_t> data_;
+        };
+
+        class NullVertexInputLayout final : public IVertexInputLayout
+        {
+        };
+
+        class NullShaderModule final : public IShaderModule
+        {
+        public:
+            explicit NullShaderModule(ShaderStage stage) : stage_(stage) {}
+            ShaderStage GetStage() const override { return stage_; }
+
+        private:
+            ShaderStage stage_;
+        };
+
+        // Hands out a distinct location per uniform name so handle-based callers behave as on a real backend
+        class NullProgram final : public IProgram
+        {
+        public:
+            const ProgramReflection& GetReflection() const override { return reflection_; }
+
+            void SetTexture(const char*, int) override {}
+            void SetFloat(const char*, float) override {}
+            void SetInt(const char*, int) override {}
+            void SetVec2(const char*, const float*) override {}
+            void SetVec3(const char*, const float*) override {}
+            void SetVec4(const char*, const float*) override {}
+            void SetMat4(const char*, const float*, bool) override {}
+
+            UniformHandle GetUniformHandle(const char* name) const override
+            {
+                UniformHandle handle;
+                if (!name)
+                    return handle;
+                auto it = locations_.emplace(name, static_cast<int32_t>(locations_.size())).first;
+                handle.location = it->second;
+                return handle;
+            }
+
+            void SetInt(UniformHandle, int) override {}
+            void SetFloat(UniformHandle, float) override {}
+            void SetVec2(UniformHandle, const float*) override {}
+            void SetVec3(UniformHandle, const float*) override {}
+            void SetVec4(UniformHandle, const float*) override {}
+            void SetMat4(UniformHandle, const float*, bool) override {}
+
+            void BindUniformBlock(const char*, uint32_t) override {}
+
+        private:
+            ProgramReflection reflection_;
+            mutable std::unordered_map<std::string, int32_t> locations_;
+        };
+
+        class NullPipelineState final : public IPipelineState
+        {
+        public:
+            NullPipelineState(const PipelineStateDesc& desc, std::size_t hash)
+                : desc_(desc), hash_(hash), name_(desc.name ? desc.name : "")
+            {
+                desc_.name = desc.name ? name_.c_str() : nullptr;
+            }
+            const PipelineStateDesc& GetDesc() const override { return desc_; }
+            std::size_t GetHash() const override { return hash_; }
+
+        private:
+            PipelineStateDesc desc_;
+            std::size_t hash_;
+            std::string name_;
+        };
+
+        class NullTexture final : public ITexture
+        {
+        public:
+            explicit NullTexture(const TextureDesc& desc) : desc_(desc) { desc_.name = nullptr; }
+            const TextureDesc& GetDesc() const override { return desc_; }
+            void UpdateLevel(uint32_t, uint32_t, const void*, std::size_t) override {}
+
+        private:
+            TextureDesc desc_;
+        };
+
+        class NullSampler final : public ISampler
+        {
+        public:
+            explicit NullSampler(const SamplerDesc& desc) : desc_(desc) {}
+            const SamplerDesc& GetDesc() const override { return desc_; }
+
+        private:
+            SamplerDesc desc_;
+        };
+    }
+
+    GfxNullDevice::~GfxNullDevice()
+    {
+        pipelineCache_.Clear();
+    }
+
+    std::shared_ptr<IBuffer> GfxNullDevice::CreateBuffer(const BufferDesc& desc, const SubresourceData* initial)
+    {
+        return std::make_shared<NullBuffer>(desc, initial);
+    }
+
+    std::shared_ptr<IVertexInputLayout> GfxNullDevice::CreateVertexInputLayout(const VertexAttribute*, uint32_t)
+    {
+        return std::make_shared<NullVertexInputLayout>();
+    }
+
+    std::shared_ptr<IShaderModule> GfxNullDevice::CreateShaderModule(const ShaderDesc& desc)
+    {
+        return std::make_shared<NullShaderModule>(desc.stage);
+    }
+
+    std::shared_ptr<IProgram> GfxNullDevice::CreateProgram(const std::shared_ptr<IShaderModule>&,
+                                                           const std::shared_ptr<IShaderModule>&,
+                                                           const char*)
+    {
+        return std::make_shared<NullProgram>();
+    }
+
+    std::shared_ptr<IPipelineState> GfxNullDevice::CreatePipelineState(const PipelineStateDesc& desc)
+    {
+        return pipelineCache_.GetOrCreate(desc, [](const PipelineStateDesc& d, std::size_t hash) {
+            return std::make_shared<NullPipelineState>(d, hash);
+        });
+    }
+
+    std::size_t GfxNullDevice::TrimPipelineStates()
+    {
+        return pipelineCache_.Trim();
+    }
+
+    std::shared_ptr<ITexture> GfxNullDevice::CreateTexture(const TextureDesc& desc, const SubresourceData*)
+    {
+        return std::make_shared<NullTexture>(desc);
+    }
+
+    std::shared_ptr<ISampler> GfxNullDevice::CreateSampler(const SamplerDesc& desc)
+    {
+        for (const auto& entry : samplers_)
+        {
+            if (entry.first == desc)
+                return entry.second;
+        }
+        auto sampler = std::make_shared<NullSampler>(desc);
+        samplers_.emplace_back(desc, sampler);
+        return sampler;
+    }
+
+    void GfxNullContext::SetVertexBuffers(uint32_t, IBuffer* const*, const uint32_t*, const uint32_t*, uint32_t) { ++stats_.stateChanges; }
+    void GfxNullContext::SetIndexBuffer(IBuffer*, IndexFormat) { ++stats_.stateChanges; }
+    void GfxNullContext::SetConstantBuffer(uint32_t, uint32_t, IBuffer*) { ++stats_.stateChanges; }
+    void GfxNullContext::SetStorageBuffer(uint32_t, IBuffer*) { ++stats_.stateChanges; }
+    void GfxNullContext::SetTexture(uint32_t, ITexture*, ISampler*) { ++stats_.stateChanges; }
+    void GfxNullContext::SetVertexInputLayout(IVertexInputLayout*) { ++stats_.stateChanges; }
+    void GfxNullContext::BindProgram(IProgram*) { ++stats_.stateChanges; }
+    void GfxNullContext::SetPipelineState(IPipelineState*) { ++stats_.stateChanges; }
+
+    void GfxNullContext::SetPolygonMode(PolygonMode) { ++stats_.stateChanges; }
+    void GfxNullContext::SetCullMode(CullMode) { ++stats_.stateChanges; }
+    void GfxNullContext::SetBlendMode(BlendMode) { ++stats_.stateChanges; }
+    void GfxNullContext::SetDepthTest(bool) { ++stats_.stateChanges; }
+    void GfxNullContext::SetScissorTest(bool, int, int, int, int) { ++stats_.stateChanges; }
+
+    void GfxNullContext::Draw(uint32_t, uint32_t) { ++stats_.draws; }
+    void GfxNullContext::DrawIndexed(uint32_t, uint32_t, int32_t) { ++stats_.draws; }
+    void GfxNullContext::DrawIndexedIndirect(IBuffer*, uint32_t) { ++stats_.indirectDraws; }
+    void GfxNullContext::MultiDrawIndexedIndirect(IBuffer*, uint32_t, uint32_t drawCount, uint32_t) { stats_.indirectDraws += drawCount; }
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "Renderer/Gfx.h"
+#include "Renderer/GfxPipelineCache.h"
+
+namespace SoulEngine::Gfx
+{
+    // Backend that validates nothing and draws nothing. Buffers keep their bytes so Map works,
+    // everything else only keeps its desc. Used to measure CPU-side cost, e.g. by the capture replayer.
+    class GfxNullDevice final : public IDevice
+    {
+    public:
+        GfxNullDevice() = default;
+        ~GfxNullDevice() override;
+
+        std::shared_ptr<IBuffer> CreateBuffer(const BufferDesc& desc, const SubresourceData* initial) override;
+        std::shared_ptr<IVertexInputLayout> CreateVertexInputLayout(const VertexAttribute* attrs, uint32_t count) override;
+        std::shared_ptr<IShaderModule> CreateShaderModule(const ShaderDesc& desc) override;
+        std::shared_ptr<IProgram> CreateProgram(const std::shared_ptr<IShaderModule>& vs,
+                                               const std::shared_ptr<IShaderModule>& fs,
+                                               const char* name = nullptr) override;
+        std::shared_ptr<IPipelineState> CreatePipelineState(const PipelineStateDesc& desc) override;
+        std::size_t TrimPipelineStates() override;
+        std::shared_ptr<ITexture> CreateTexture(const TextureDesc& desc, const SubresourceData* initial) override;
+        std::shared_ptr<ISampler> CreateSampler(const SamplerDesc& desc) override;
+
+        const PipelineStateCache& GetPipelineCache() const { return pipelineCache_; }
+
+    private:
+        PipelineStateCache pipelineCache_;
+        std::vector<std::pair<SamplerDesc, std::shared_ptr<ISampler>>> samplers_;
+    };
+
+    struct NullContextStats
+    {
+        uint64_t draws = 0;
+        uint64_t indirectDraws = 0;
+        uint64_t stateChanges = 0;
+    };
+
+    class GfxNullContext final : public IContext
+    {
+    public:
+        void SetVertexBuffers(uint32_t startSlot, IBuffer* const* buffers, const uint32_t* strides, const uint32_t* offsets, uint32_t count) override;
+        void SetIndexBuffer(IBuffer* buffer, IndexFormat fmt) override;
+        void SetConstantBuffer(uint32_t stage, uint32_t slot, IBuffer* buffer) override;
+        void SetStorageBuffer(uint32_t slot, IBuffer* buffer) override;
+        void SetTexture(uint32_t slot, ITexture* texture, ISampler* sampler) override;
+        void SetVertexInputLayout(IVertexInputLayout* layout) override;
+        void BindProgram(IProgram* program) override;
+        void SetPipelineState(IPipelineState* pipeline) override;
+
+        void SetPolygonMode(PolygonMode mode) override;
+        void SetCullMode(CullMode mode) override;
+        void SetBlendMode(BlendMode mode) override;
+        void SetDepthTest(bool enable) override;
+        void SetScissorTest(bool enable, int x = 0, int y = 0, int width = 0, int height = 0) override;
+
+        void Draw(uint32_t vertexCount, uint32_t startVertex) override;
+        void DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex) override;
+        void DrawIndexedIndirect(IBuffer* argsBuffer, uint32_t byteOffset) override;
+        void MultiDrawIndexedIndirect(IBuffer* argsBuffer, uint32_t byteOffset, uint32_t drawCount, uint32_t stride) override;
+
+        const NullContextStats& GetStats() const { return stats_; }
+        void ResetStats() { stats_ = {}; }
+
+    private:
+        NullContextStats stats_{};
+    };
+}
@@ -1,11 +1,25 @@
 #if defined(SOULENGINE_ENABLE_OPENGL)
 
 #include "Renderer/OpenGL/GfxGLBuffer.h"
+#include "Renderer/OpenGL/GfxGLDeferredDeleter.h"
 
 namespace SoulEngine::Gfx
 {
-    GLBuffer::GLBuffer(const BufferDesc& desc)
-        : desc_(desc)
+    namespace
+    {
+        // Uploads go through the copy-write binding point: GL_ELEMENT_ARRAY_BUFFER is VAO state,
+        // and binding an index buffer there would silently rewire whichever cached VAO is current.
+        constexpr GLenum kUploadTarget = GL_COPY_WRITE_BUFFER;
+
+        uint64_t NextBufferId()
+        {
+            static uint64_t counter = 0;
+            return ++counter;
+        }
+    }
+
+    GLBuffer::GLBuffer(const BufferDesc& desc, std::shared_ptr<GLDeferredDeleter> deleter)
+        : desc_(desc), id_(NextBufferId()), deleter_(std::move(deleter))
     {
         glGenBuffers(1, &buffer_);
         target_ = ToGLBufferTarget(desc_.kind);
@@ -13,32 +27,58 @@ namespace SoulEngine::Gfx
 
     GLBuffer::~GLBuffer()
     {
-        if (buffer_)
+        if (!buffer_)
+            return;
+        if (mapped_)
+            Unmap();
+        // The GPU may still read this buffer for in-flight frames
+        if (deleter_)
+        {
+            deleter_->Enqueue(GLDeferredDeleter::ObjectType::Texture, textureView_);
+            deleter_->Enqueue(GLDeferredDeleter::ObjectType::Buffer, buffer_);
+        }
+        else
+        {
+            if (textureView_)
+                glDeleteTextures(1, &textureView_);
             glDeleteBuffers(1, &buffer_);
+        }
+    }
+
+    GLuint GLBuffer::GetTextureView()
+    {
+        if (textureView_ == 0)
+        {
+            const GLenum format = desc_.stride == 16 ? GL_RGBA32UI : (desc_.stride == 8 ? GL_RG32UI : GL_R32UI);
+            glGenTextures(1, &textureView_);
+            glBindTexture(GL_TEXTURE_BUFFER, textureView_);
+            glTexBuffer(GL_TEXTURE_BUFFER, format, buffer_);
+        }
+        return textureView_;
     }
 
     void GLBuffer::Initialize(const SubresourceData* initial)
     {
-        glBindBuffer(target_, buffer_);
+        glBindBuffer(kUploadTarget, buffer_);
         if (initial && initial->data && initial->size)
         {
-            glBufferData(target_, static_cast<GLsizeiptr>(initial->size), initial->data, ToGLUsage(desc_.usage));
+            glBufferData(kUploadTarget, static_cast<GLsizeiptr>(initial->size), initial->data, ToGLUsage(desc_.usage));
         }
         else
         {
-            glBufferData(target_, static_cast<GLsizeiptr>(desc_.size), nullptr, ToGLUsage(desc_.usage));
+            glBufferData(kUploadTarget, static_cast<GLsizeiptr>(desc_.size), nullptr, ToGLUsage(desc_.usage));
         }
     }
 
     void GLBuffer::Update(const SubresourceData& src)
     {
-        glBindBuffer(target_, buffer_);
-        glBufferSubData(target_, static_cast<GLintptr>(src.offset), static_cast<GLsizeiptr>(src.size), src.data);
+        glBindBuffer(kUploadTarget, buffer_);
+        glBufferSubData(kUploadTarget, static_cast<GLintptr>(src.offset), static_cast<GLsizeiptr>(src.size), src.data);
     }
 
     void* GLBuffer::Map(MapMode mode)
     {
-        glBindBuffer(target_, buffer_);
+        glBindBuffer(kUploadTarget, buffer_);
         GLbitfield access = 0;
         switch (mode)
         {
@@ -47,7 +87,7 @@ namespace SoulEngine::Gfx
         case MapMode::WriteDiscard: access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT; break;
         case MapMode::WriteNoOverwrite: access = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT; break;
         }
-        mapped_ = glMapBufferRange(target_, 0, static_cast<GLsizeiptr>(desc_.size), access);
+        mapped_ = glMapBufferRange(kUploadTarget, 0, static_cast<GLsizeiptr>(desc_.size), access);
         return mapped_;
     }
 
@@ -55,8 +95,8 @@ namespace SoulEngine::Gfx
     {
         if (mapped_)
         {
-            glBindBuffer(target_, buffer_);
-            glUnmapBuffer(target_);
+            glBindBuffer(kUploadTarget, buffer_);
+            glUnmapBuffer(kUploadTarget);
             mapped_ = nullptr;
         }
     }
@@ -5,13 +5,17 @@
 #include <glad/glad.h>
 #include "Renderer/Gfx.h"
 #include "Renderer/OpenGL/GfxGLCommon.h"
+#include <memory>
 
 namespace SoulEngine::Gfx
 {
+    class GLDeferredDeleter;
+
     class GLBuffer final : public IBuffer
     {
     public:
-        explicit GLBuffer(const BufferDesc& desc);
+        // deleter may be null, in which case the GL name is deleted immediately
+        GLBuffer(const BufferDesc& desc, std::shared_ptr<GLDeferredDeleter> deleter);
         ~GLBuffer() override;
 
         const BufferDesc& GetDesc() const override { return desc_; }
@@ -22,13 +26,21 @@ namespace SoulEngine::Gfx
         void Unmap() override;
 
         GLuint GetGLName() const { return buffer_; }
+        // Texture buffer view of a Storage buffer, created on first use. Texels are R32UI, or RG32UI/RGBA32UI
+        // when desc.stride is 8/16; shaders reinterpret floats with uintBitsToFloat.
+        GLuint GetTextureView();
         GLenum GetTarget() const { return target_; }
+        // Unique for the process lifetime, unlike GL names which are recycled after deletion
+        uint64_t GetId() const { return id_; }
 
     private:
         BufferDesc desc_{};
         GLuint buffer_ = 0;
+        GLuint textureView_ = 0;
         GLenum target_ = GL_ARRAY_BUFFER;
+        uint64_t id_ = 0;
         void* mapped_ = nullptr;
+        std::shared_ptr<GLDeferredDeleter> deleter_;
     };
 }
 
@@ -5,6 +5,7 @@
 #include <glad/glad.h>
 #include <cstdint>
 #include "Renderer/Gfx.h"
+#include "Renderer/OpenGL/GfxGLExtensions.h"
 
 namespace SoulEngine::Gfx
 {
@@ -15,8 +16,10 @@ namespace SoulEngine::Gfx
         case BufferKind::Vertex:   return GL_ARRAY_BUFFER;
         case BufferKind::Index:    return GL_ELEMENT_ARRAY_BUFFER;
         case BufferKind::Constant: return GL_UNIFORM_BUFFER;
-        // case BufferKind::Storage:  return GL_SHADER_STORAGE_BUFFER;/
-        // case BufferKind::Indirect: return GL_DRAW_INDIRECT_BUFFER;
+        // GL 3.3 has no SSBOs; storage buffers are read in shaders through a texture buffer view
+        case BufferKind::Storage:  return GL_TEXTURE_BUFFER;
+        // GL 3.3 has no indirect target; args then live in a plain buffer read back by the fallback path
+        case BufferKind::Indirect: return GetGLExtensions().HasDrawIndirect() ? GL_DRAW_INDIRECT_BUFFER : GL_COPY_WRITE_BUFFER;
         case BufferKind::Staging:  return GL_COPY_READ_BUFFER; // simple default
         default: return GL_ARRAY_BUFFER;
         }
@@ -44,6 +47,22 @@ namespace SoulEngine::Gfx
         }
     }
 
+    inline GLenum ToGLCompareFunc(CompareFunc func)
+    {
+        switch (func)
+        {
+        case CompareFunc::Never:        return GL_NEVER;
+        case CompareFunc::Less:         return GL_LESS;
+        case CompareFunc::Equal:        return GL_EQUAL;
+        case CompareFunc::LessEqual:    return GL_LEQUAL;
+        case CompareFunc::Greater:      return GL_GREATER;
+        case CompareFunc::NotEqual:     return GL_NOTEQUAL;
+        case CompareFunc::GreaterEqual: return GL_GEQUAL;
+        case CompareFunc::Always:       return GL_ALWAYS;
+        default: return GL_LESS;
+        }
+    }
+
     struct GLFormatInfo { GLenum type; GLint size; GLboolean normalized; };
 
     inline GLFormatInfo ToGLVertexFormat(DataFormat fmt)
@@ -55,9 +74,74 @@ namespace SoulEngine::Gfx
         case DataFormat::R32G32B32_Float:    return { GL_FLOAT, 3, GL_FALSE };
         case DataFormat::R32G32B32A32_Float: return { GL_FLOAT, 4, GL_FALSE };
         case DataFormat::R8G8B8A8_UNorm:     return { GL_UNSIGNED_BYTE, 4, GL_TRUE };
+        case DataFormat::R16G16_Float:       return { GL_HALF_FLOAT, 2, GL_FALSE };
+        case DataFormat::R16G16B16A16_Float: return { GL_HALF_FLOAT, 4, GL_FALSE };
+        case DataFormat::R16G16_SNorm:       return { GL_SHORT, 2, GL_TRUE };
+        case DataFormat::R16G16B16A16_SNorm: return { GL_SHORT, 4, GL_TRUE };
+        case DataFormat::R16G16_UNorm:       return { GL_UNSIGNED_SHORT, 2, GL_TRUE };
+        case DataFormat::R16G16B16A16_UNorm: return { GL_UNSIGNED_SHORT, 4, GL_TRUE };
+        case DataFormat::R8G8_SNorm:         return { GL_BYTE, 2, GL_TRUE };
+        case DataFormat::R8G8B8A8_SNorm:     return { GL_BYTE, 4, GL_TRUE };
+        case DataFormat::R10G10B10A2_UNorm:  return { GL_UNSIGNED_INT_2_10_10_10_REV, 4, GL_TRUE };
+        case DataFormat::R10G10B10A2_SNorm:  return { GL_INT_2_10_10_10_REV, 4, GL_TRUE };
+        // The shader decodes the octahedral pair, see OctDecode in Renderer/GfxPackedFormats.h
+        case DataFormat::R16G16_SNorm_Oct:   return { GL_SHORT, 2, GL_TRUE };
+        case DataFormat::R8G8_SNorm_Oct:     return { GL_BYTE, 2, GL_TRUE };
         default: return { GL_FLOAT, 4, GL_FALSE };
         }
     }
+
+    // internalFormat 0 means the format cannot be sampled on this context
+    struct GLTextureFormat { GLenum internalFormat; GLenum format; GLenum type; bool compressed; };
+
+    inline GLTextureFormat ToGLTextureFormat(DataFormat fmt)
+    {
+        const GLExtensions& ext = GetGLExtensions();
+        switch (fmt)
+        {
+        case DataFormat::R8_UNorm:           return { GL_R8, GL_RED, GL_UNSIGNED_BYTE, false };
+        case DataFormat::R8G8_UNorm:         return { GL_RG8, GL_RG, GL_UNSIGNED_BYTE, false };
+        case DataFormat::R8G8B8A8_UNorm:     return { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, false };
+        case DataFormat::R8G8B8A8_SRGB:      return { GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE, false };
+        case DataFormat::R16G16_Float:       return { GL_RG16F, GL_RG, GL_HALF_FLOAT, false };
+        case DataFormat::R16G16B16A16_Float: return { GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, false };
+        case DataFormat::R32_Float:          return { GL_R32F, GL_RED, GL_FLOAT, false };
+        case DataFormat::R32G32_Float:       return { GL_RG32F, GL_RG, GL_FLOAT, false };
+        case DataFormat::R32G32B32A32_Float: return { GL_RGBA32F, GL_RGBA, GL_FLOAT, false };
+        case DataFormat::R10G10B10A2_UNorm:  return { GL_RGB10_A2, GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV, false };
+        // RGTC is core since 3.0; S3TC and BPTC depend on the driver
+        case DataFormat::BC4_UNorm:          return { GL_COMPRESSED_RED_RGTC1, 0, 0, true };
+        case DataFormat::BC5_UNorm:          return { GL_COMPRESSED_RG_RGTC2, 0, 0, true };
+        case DataFormat::BC1_UNorm:          return { ext.hasS3TC ? GLenum(GL_COMPRESSED_RGBA_S3TC_DXT1_EXT) : 0u, 0, 0, true };
+        case DataFormat::BC3_UNorm:          return { ext.hasS3TC ? GLenum(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT) : 0u, 0, 0, true };
+        case DataFormat::BC1_SRGB:           return { ext.hasS3TCSRGB ? GLenum(GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT) : 0u, 0, 0, true };
+        case DataFormat::BC3_SRGB:           return { ext.hasS3TCSRGB ? GLenum(GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT) : 0u, 0, 0, true };
+        case DataFormat::BC7_UNorm:          return { ext.hasBPTC ? GLenum(GL_COMPRESSED_RGBA_BPTC_UNORM) : 0u, 0, 0, true };
+        case DataFormat::BC7_SRGB:           return { ext.hasBPTC ? GLenum(GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM) : 0u, 0, 0, true };
+        default: return { 0, 0, 0, false };
+        }
+    }
+
+    inline GLenum ToGLAddressMode(AddressMode mode)
+    {
+        switch (mode)
+        {
+        case AddressMode::Repeat:         return GL_REPEAT;
+        case AddressMode::MirroredRepeat: return GL_MIRRORED_REPEAT;
+        case AddressMode::ClampToEdge:    return GL_CLAMP_TO_EDGE;
+        case AddressMode::ClampToBorder:  return GL_CLAMP_TO_BORDER;
+        default: return GL_REPEAT;
+        }
+    }
+
+    inline GLenum ToGLMinFilter(FilterMode minFilter, FilterMode mipFilter, bool hasMips)
+    {
+        if (!hasMips)
+            return minFilter == FilterMode::Linear ? GL_LINEAR : GL_NEAREST;
+        if (minFilter == FilterMode::Linear)
+            return mipFilter == FilterMode::Linear ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR_MIPMAP_NEAREST;
+        return mipFilter == FilterMode::Linear ? GL_NEAREST_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST;
+    }
 }
 
 #endif // SOULENGINE_ENABLE_OPENGL
@@ -5,32 +5,53 @@
 #include "Renderer/OpenGL/GfxGLCommon.h"
 #include "Renderer/OpenGL/GfxGLBuffer.h"
 #include "Renderer/OpenGL/GfxGLProgram.h"
+#include "Renderer/OpenGL/GfxGLPipelineState.h"
+#include "Renderer/OpenGL/GfxGLTexture.h"
+#include "Log/Logger.h"
 #include <glad/glad.h>
+#include <cstring>
 
 namespace SoulEngine::Gfx
 {
-    void GfxGLContext::SetVertexBuffers(uint32_t startSlot, IBuffer* const* buffers, const uint32_t* strides, const uint32_t* offsets, uint32_t count)
+    GfxGLContext::GfxGLContext(std::shared_ptr<GLDeferredDeleter> deleter)
+        : vertexArrays_(std::move(deleter))
     {
-        if (startSlot != 0)
-            return; // simple implementation supports startSlot=0 only for now
+    }
 
-        vbSlots_.resize(count);
-        strides_.assign(strides, strides + count);
-        offsets_.assign(offsets, offsets + count);
+    void GfxGLContext::SetVertexBuffers(uint32_t startSlot, IBuffer* const* buffers, const uint32_t* strides, const uint32_t* offsets, uint32_t count)
+    {
+        const uint32_t end = startSlot + count;
+        if (vbSlots_.size() < end)
+        {
+            vbSlots_.resize(end, nullptr);
+            strides_.resize(end, 0);
+            offsets_.resize(end, 0);
+        }
 
         for (uint32_t i = 0; i < count; ++i)
         {
-            vbSlots_[i] = static_cast<GLBuffer*>(buffers[i]);
+            auto* buffer = static_cast<GLBuffer*>(buffers[i]);
+            const uint32_t offset = offsets ? offsets[i] : 0;
+            const uint32_t slot = startSlot + i;
+            if (vbSlots_[slot] != buffer || strides_[slot] != strides[i] || offsets_[slot] != offset)
+            {
+                vbSlots_[slot] = buffer;
+                strides_[slot] = strides[i];
+                offsets_[slot] = offset;
+                vertexArrayDirty_ = true;
+            }
         }
-
-        ApplyVertexArrayBindings();
     }
 
     void GfxGLContext::SetIndexBuffer(IBuffer* buffer, IndexFormat fmt)
     {
-        indexBuffer_ = static_cast<GLBuffer*>(buffer);
+        auto* glbuf = static_cast<GLBuffer*>(buffer);
+        if (glbuf != indexBuffer_)
+        {
+            indexBuffer_ = glbuf;
+            vertexArrayDirty_ = true;
+        }
         indexFormat_ = fmt;
-        ApplyVertexArrayBindings();
     }
 
     void GfxGLContext::SetConstantBuffer(uint32_t /*stage*/, uint32_t slot, IBuffer* buffer)
@@ -43,79 +64,206 @@ namespace SoulEngine::Gfx
         }
     }
 
+    void GfxGLContext::SetStorageBuffer(uint32_t slot, IBuffer* buffer)
+    {
+        if (slot >= kMaxStorageBufferSlots)
+        {
+            Logger::Warn("GfxGLContext: storage buffer slot {} exceeds {}", slot, kMaxStorageBufferSlots);
+            return;
+        }
+        auto* glbuf = static_cast<GLBuffer*>(buffer);
+        // Own unit range so storage slot N never replaces texture slot N
+        glActiveTexture(GL_TEXTURE0 + kStorageBufferUnitBase + slot);
+        glBindTexture(GL_TEXTURE_BUFFER, glbuf ? glbuf->GetTextureView() : 0);
+    }
+
+    void GfxGLContext::SetTexture(uint32_t slot, ITexture* texture, ISampler* sampler)
+    {
+        if (slot >= kMaxTextureSlots)
+        {
+            Logger::Warn("GfxGLContext: texture slot {} exceeds {}", slot, kMaxTextureSlots);
+            return;
+        }
+        auto* gltex = static_cast<GLTexture*>(texture);
+        glActiveTexture(GL_TEXTURE0 + slot);
+        glBindTexture(gltex ? gltex->GetTarget() : GL_TEXTURE_2D, gltex ? gltex->GetGLName() : 0);
+        glBindSampler(slot, sampler ? static_cast<GLSampler*>(sampler)->GetGLName() : 0);
+    }
+
     void GfxGLContext::SetVertexInputLayout(IVertexInputLayout* layout)
     {
-        currentLayout_ = static_cast<GLVertexInputLayout*>(layout);
-        ApplyVertexArrayBindings();
+        currentPipeline_ = nullptr;
+        auto* glLayout = static_cast<GLVertexInputLayout*>(layout);
+        if (glLayout != currentLayout_)
+        {
+            currentLayout_ = glLayout;
+            vertexArrayDirty_ = true;
+        }
     }
 
     void GfxGLContext::BindProgram(IProgram* program)
     {
-        auto* glp = static_cast<GLProgram*>(program);
-        if (glp)
+        currentPipeline_ = nullptr;
+        ApplyProgram(static_cast<GLProgram*>(program));
+    }
+
+    void GfxGLContext::SetPipelineState(IPipelineState* pipeline)
+    {
+        auto* pso = static_cast<GLPipelineState*>(pipeline);
+        if (pso == currentPipeline_.get() || !pso)
+            return;
+
+        const PipelineStateDesc& desc = pso->GetDesc();
+        ApplyProgram(static_cast<GLProgram*>(desc.program.get()));
+        auto* layout = static_cast<GLVertexInputLayout*>(desc.inputLayout.get());
+        if (layout && layout != currentLayout_)
         {
-            glUseProgram(glp->GetGLName());
+            currentLayout_ = layout;
+            vertexArrayDirty_ = true;
         }
+        ApplyPolygonMode(desc.polygonMode);
+        ApplyCullMode(desc.cullMode);
+        ApplyBlendMode(desc.blendMode);
+        ApplyDepthState(desc.depthTest, desc.depthWrite, desc.depthFunc);
+        currentPipeline_ = pso->shared_from_this();
+    }
+
+    void GfxGLContext::ApplyProgram(GLProgram* program)
+    {
+        if (!program || program == currentProgram_)
+            return;
+        glUseProgram(program->GetGLName());
+        currentProgram_ = program;
     }
 
     void GfxGLContext::Draw(uint32_t vertexCount, uint32_t startVertex)
     {
-        if (!currentLayout_) return;
-        glBindVertexArray(currentLayout_->GetVAO());
+        if (!PrepareVertexArray()) return;
         glDrawArrays(GL_TRIANGLES, static_cast<GLint>(startVertex), static_cast<GLsizei>(vertexCount));
     }
 
     void GfxGLContext::DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex)
     {
-        if (!currentLayout_ || !indexBuffer_) return;
-        glBindVertexArray(currentLayout_->GetVAO());
+        if (!indexBuffer_ || !PrepareVertexArray()) return;
         const GLenum type = ToGLIndexType(indexFormat_);
         const void* indices = reinterpret_cast<const void*>(static_cast<uintptr_t>(startIndex * (type == GL_UNSIGNED_SHORT ? 2u : 4u)));
         glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(indexCount), type, indices, baseVertex);
     }
-   // todo: 优化项 : 缓存当前绑定状态，避免重复绑定
-    void GfxGLContext::ApplyVertexArrayBindings()
+
+    void GfxGLContext::DrawIndexedIndirect(IBuffer* argsBuffer, uint32_t byteOffset)
     {
-        if (!currentLayout_)
-            return;
+        MultiDrawIndexedIndirect(argsBuffer, byteOffset, 1, sizeof(DrawIndexedIndirectArgs));
+    }
 
-        glBindVertexArray(currentLayout_->GetVAO());
+    void GfxGLContext::MultiDrawIndexedIndirect(IBuffer* argsBuffer, uint32_t byteOffset, uint32_t drawCount, uint32_t stride)
+    {
+        auto* args = static_cast<GLBuffer*>(argsBuffer);
+        if (!indexBuffer_ || !args || drawCount == 0 || !PrepareVertexArray()) return;
+        if (stride == 0) stride = sizeof(DrawIndexedIndirectArgs);
 
-        // Configure attributes for current bound vertex buffers
-        const auto& attrs = currentLayout_->GetAttributes();
-        for (const auto& a : attrs)
+        const GLExtensions& ext = GetGLExtensions();
+        if (!ext.HasDrawIndirect())
         {
-            const uint32_t slot = a.bindingSlot;
-            if (slot >= vbSlots_.size() || vbSlots_[slot] == nullptr)
-                continue;
-
-            const GLuint vbo = vbSlots_[slot]->GetGLName();
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
-
-            const auto fmt = ToGLVertexFormat(a.format);
-            const GLsizei stride = static_cast<GLsizei>(strides_.size() > slot ? strides_[slot] : 0);
-            const GLsizei attribStride = stride;
-            const GLvoid* pointer = reinterpret_cast<const GLvoid*>(static_cast<uintptr_t>((offsets_.size() > slot ? offsets_[slot] : 0) + a.offset));
+            DrawIndexedIndirectFallback(args, byteOffset, drawCount, stride);
+            return;
+        }
 
-            glEnableVertexAttribArray(a.location);
-            glVertexAttribPointer(a.location, fmt.size, fmt.type, fmt.normalized, attribStride, pointer);
-            // Optional: instance rate handling via glVertexAttribDivisor if stepRate > 0
-            if (a.stepRate > 0)
-                glVertexAttribDivisor(a.location, a.stepRate);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, args->GetGLName());
+        const GLenum type = ToGLIndexType(indexFormat_);
+        if (ext.HasMultiDrawIndirect())
+        {
+            ext.MultiDrawElementsIndirect(GL_TRIANGLES, type, reinterpret_cast<const void*>(static_cast<uintptr_t>(byteOffset)),
+                                          static_cast<GLsizei>(drawCount), static_cast<GLsizei>(stride));
+        }
+        else
+        {
+            for (uint32_t i = 0; i < drawCount; ++i)
+            {
+                const uintptr_t offset = static_cast<uintptr_t>(byteOffset) + static_cast<uintptr_t>(i) * stride;
+                ext.DrawElementsIndirect(GL_TRIANGLES, type, reinterpret_cast<const void*>(offset));
+            }
         }
+    }
+
+    // GL 3.3 path: read the arguments back and issue one draw per record (baseInstance is not supported)
+    void GfxGLContext::DrawIndexedIndirectFallback(GLBuffer* argsBuffer, uint32_t byteOffset, uint32_t drawCount, uint32_t stride)
+    {
+        const auto* base = static_cast<const uint8_t*>(argsBuffer->Map(MapMode::Read));
+        if (!base) return;
 
-        // Bind index buffer to VAO state if available
-        if (indexBuffer_)
+        const GLenum type = ToGLIndexType(indexFormat_);
+        const uint32_t indexSize = type == GL_UNSIGNED_SHORT ? 2u : 4u;
+        const std::size_t bufferSize = argsBuffer->GetDesc().size;
+        for (uint32_t i = 0; i < drawCount; ++i)
         {
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer_->GetGLName());
+            const std::size_t offset = static_cast<std::size_t>(byteOffset) + static_cast<std::size_t>(i) * stride;
+            if (offset + sizeof(DrawIndexedIndirectArgs) > bufferSize)
+                break;
+            DrawIndexedIndirectArgs a{};
+            std::memcpy(&a, base + offset, sizeof(a));
+            if (a.indexCount == 0 || a.instanceCount == 0)
+                continue;
+            const void* indices = reinterpret_cast<const void*>(static_cast<uintptr_t>(a.firstIndex) * indexSize);
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(a.indexCount), type, indices,
+                                              static_cast<GLsizei>(a.instanceCount), a.baseVertex);
         }
+        argsBuffer->Unmap();
+    }
+    // Resolves the current layout + buffers to a cached VAO; steady state costs at most one glBindVertexArray
+    bool GfxGLContext::PrepareVertexArray()
+    {
+        if (!currentLayout_)
+            return false;
+        if (!vertexArrayDirty_)
+            return true;
 
-        // Unbind array buffer to avoid accidental state leakage
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        bool created = false;
+        const GLuint vao = vertexArrays_.Acquire(*currentLayout_, vbSlots_, strides_, offsets_, indexBuffer_, created);
+        if (vao != boundVAO_ && !created)
+            glBindVertexArray(vao);
+        boundVAO_ = vao;
+        vertexArrayDirty_ = false;
+        return true;
     }
 
+    void GfxGLContext::BeginFrame(uint64_t frameIndex, uint64_t maxIdleFrames)
+    {
+        vertexArrays_.SetFrame(frameIndex);
+        vertexArrays_.Trim(frameIndex, maxIdleFrames);
+        // The bound VAO may just have been evicted, and its lastUsedFrame must be refreshed in the new frame
+        boundVAO_ = 0;
+        vertexArrayDirty_ = true;
+    }
+
+    // Explicit state setters drop the pipeline binding so the next SetPipelineState re-applies its diff
     void GfxGLContext::SetPolygonMode(PolygonMode mode)
     {
+        currentPipeline_ = nullptr;
+        ApplyPolygonMode(mode);
+    }
+
+    void GfxGLContext::SetCullMode(CullMode mode)
+    {
+        currentPipeline_ = nullptr;
+        ApplyCullMode(mode);
+    }
+
+    void GfxGLContext::SetBlendMode(BlendMode mode)
+    {
+        currentPipeline_ = nullptr;
+        ApplyBlendMode(mode);
+    }
+
+    void GfxGLContext::SetDepthTest(bool enable)
+    {
+        currentPipeline_ = nullptr;
+        ApplyDepthState(enable, state_.depthWrite, enable ? CompareFunc::Less : state_.depthFunc);
+    }
+
+    void GfxGLContext::ApplyPolygonMode(PolygonMode mode)
+    {
+        if (state_.polygonMode == mode)
+            return;
         GLenum glMode;
         switch (mode)
         {
@@ -125,10 +273,13 @@ namespace SoulEngine::Gfx
             default: return;
         }
         glPolygonMode(GL_FRONT_AND_BACK, glMode);
+        state_.polygonMode = mode;
     }
 
-    void GfxGLContext::SetCullMode(CullMode mode)
+    void GfxGLContext::ApplyCullMode(CullMode mode)
     {
+        if (state_.cullMode == mode)
+            return;
         switch (mode)
         {
             case CullMode::None:
@@ -143,10 +294,13 @@ namespace SoulEngine::Gfx
                 glCullFace(GL_BACK);
                 break;
         }
+        state_.cullMode = mode;
     }
 
-    void GfxGLContext::SetBlendMode(BlendMode mode)
+    void GfxGLContext::ApplyBlendMode(BlendMode mode)
     {
+        if (state_.blendMode == mode)
+            return;
         switch (mode)
         {
             case BlendMode::None:
@@ -161,18 +315,26 @@ namespace SoulEngine::Gfx
                 glBlendFunc(GL_SRC_ALPHA, GL_ONE);
                 break;
         }
+        state_.blendMode = mode;
     }
 
-    void GfxGLContext::SetDepthTest(bool enable)
+    void GfxGLContext::ApplyDepthState(bool enable, bool write, CompareFunc func)
     {
-        if (enable)
+        if (state_.depthTest != enable)
         {
-            glEnable(GL_DEPTH_TEST);
-            glDepthFunc(GL_LESS);
+            if (enable) glEnable(GL_DEPTH_TEST);
+            else glDisable(GL_DEPTH_TEST);
+            state_.depthTest = enable;
         }
-        else
+        if (state_.depthWrite != write)
+        {
+            glDepthMask(write ? GL_TRUE : GL_FALSE);
+            state_.depthWrite = write;
+        }
+        if (state_.depthFunc != func)
         {
-            glDisable(GL_DEPTH_TEST);
+            glDepthFunc(ToGLCompareFunc(func));
+            state_.depthFunc = func;
         }
     }
 
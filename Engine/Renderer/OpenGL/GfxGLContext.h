@@ -3,25 +3,34 @@
 #if defined(SOULENGINE_ENABLE_OPENGL)
 
 #include "Renderer/Gfx.h"
+#include "Renderer/OpenGL/GfxGLVertexArrayCache.h"
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace SoulEngine::Gfx
 {
     class GLBuffer;
     class GLVertexInputLayout;
+    class GLProgram;
+    class GLPipelineState;
+    class GLDeferredDeleter;
 
     class GfxGLContext final : public IContext
     {
     public:
-        GfxGLContext() = default;
+        // deleter receives VAOs evicted from the vertex array cache; may be null
+        explicit GfxGLContext(std::shared_ptr<GLDeferredDeleter> deleter = nullptr);
         ~GfxGLContext() override = default;
 
         void SetVertexBuffers(uint32_t startSlot, IBuffer* const* buffers, const uint32_t* strides, const uint32_t* offsets, uint32_t count) override;
         void SetIndexBuffer(IBuffer* buffer, IndexFormat fmt) override;
         void SetConstantBuffer(uint32_t stage, uint32_t slot, IBuffer* buffer) override;
+        void SetStorageBuffer(uint32_t slot, IBuffer* buffer) override;
+        void SetTexture(uint32_t slot, ITexture* texture, ISampler* sampler) override;
         void SetVertexInputLayout(IVertexInputLayout* layout) override;
         void BindProgram(IProgram* program) override;
+        void SetPipelineState(IPipelineState* pipeline) override;
         
         // 渲染状态设置
         void SetPolygonMode(PolygonMode mode) override;
@@ -32,8 +41,28 @@ namespace SoulEngine::Gfx
         
         void Draw(uint32_t vertexCount, uint32_t startVertex) override;
         void DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex) override;
+        void DrawIndexedIndirect(IBuffer* argsBuffer, uint32_t byteOffset) override;
+        void MultiDrawIndexedIndirect(IBuffer* argsBuffer, uint32_t byteOffset, uint32_t drawCount, uint32_t stride) override;
+
+        // Called once per frame by OpenGLRenderer; releases VAOs unused for maxIdleFrames
+        void BeginFrame(uint64_t frameIndex, uint64_t maxIdleFrames = 120);
+        const GLVertexArrayCache::Stats& GetVertexArrayStats() const { return vertexArrays_.GetStats(); }
 
     private:
+        // Shadow of the GL fixed-function state, initialised to the GL defaults
+        struct FixedFunctionState
+        {
+            PolygonMode polygonMode = PolygonMode::Fill;
+            CullMode    cullMode    = CullMode::None;
+            BlendMode   blendMode   = BlendMode::None;
+            bool        depthTest   = false;
+            bool        depthWrite  = true;
+            CompareFunc depthFunc   = CompareFunc::Less;
+        };
+
+        FixedFunctionState state_{};
+        std::shared_ptr<GLPipelineState> currentPipeline_;    // held so a pipeline-cache trim cannot recycle it while bound
+        GLProgram* currentProgram_ = nullptr;
         GLVertexInputLayout* currentLayout_ = nullptr;
         std::vector<GLBuffer*> vbSlots_;
         std::vector<uint32_t> strides_;
@@ -41,7 +70,18 @@ namespace SoulEngine::Gfx
         GLBuffer* indexBuffer_ = nullptr;
         IndexFormat indexFormat_ = IndexFormat::UInt32;
 
-        void ApplyVertexArrayBindings();
+        // Format (layout) and bindings (buffers) are tracked separately and only resolved to a VAO at draw time
+        GLVertexArrayCache vertexArrays_;
+        GLuint boundVAO_ = 0;
+        bool vertexArrayDirty_ = true;
+
+        bool PrepareVertexArray();
+        void DrawIndexedIndirectFallback(GLBuffer* argsBuffer, uint32_t byteOffset, uint32_t drawCount, uint32_t stride);
+        void ApplyProgram(GLProgram* program);
+        void ApplyPolygonMode(PolygonMode mode);
+        void ApplyCullMode(CullMode mode);
+        void ApplyBlendMode(BlendMode mode);
+        void ApplyDepthState(bool enable, bool write, CompareFunc func);
     };
 }
 
@@ -0,0 +1,83 @@
+#if defined(SOULENGINE_ENABLE_OPENGL)
+
+#include "Renderer/OpenGL/GfxGLDeferredDeleter.h"
+#include <algorithm>
+
+namespace SoulEngine::Gfx
+{
+    GLDeferredDeleter::~GLDeferredDeleter()
+    {
+        FlushAll(true);
+    }
+
+    void GLDeferredDeleter::Enqueue(ObjectType type, GLuint name)
+    {
+        if (name == 0)
+            return;
+        if (immediate_)
+        {
+            if (type == ObjectType::Buffer) glDeleteBuffers(1, &name);
+            else if (type == ObjectType::Texture) glDeleteTextures(1, &name);
+            else glDeleteVertexArrays(1, &name);
+            ++stats_.deleted;
+            ++stats_.batches;
+            return;
+        }
+        queue_.push_back({ currentFrame_, type, name });
+        stats_.pending = queue_.size();
+        stats_.peakPending = std::max(stats_.peakPending, stats_.pending);
+    }
+
+    void GLDeferredDeleter::RetireFrame(uint64_t completedFrame)
+    {
+        // Entries are appended in frame order, so the retired ones form a prefix
+        auto end = std::find_if(queue_.begin(), queue_.end(),
+                                [completedFrame](const Entry& e) { return e.frame > completedFrame; });
+        DeleteBatch(end);
+    }
+
+    void GLDeferredDeleter::FlushAll(bool deleteImmediatelyAfter)
+    {
+        DeleteBatch(queue_.end());
+        immediate_ = deleteImmediatelyAfter;
+    }
+
+    void GLDeferredDeleter::DeleteBatch(std::deque<Entry>::iterator end)
+    {
+        if (end == queue_.begin())
+            return;
+
+        scratchBuffers_.clear();
+        scratchArrays_.clear();
+        scratchTextures_.clear();
+        for (auto it = queue_.begin(); it != end; ++it)
+        {
+            if (it->type == ObjectType::Buffer) scratchBuffers_.push_back(it->name);
+            else if (it->type == ObjectType::Texture) scratchTextures_.push_back(it->name);
+            else scratchArrays_.push_back(it->name);
+        }
+
+        if (!scratchBuffers_.empty())
+        {
+            glDeleteBuffers(static_cast<GLsizei>(scratchBuffers_.size()), scratchBuffers_.data());
+            ++stats_.batches;
+        }
+        if (!scratchArrays_.empty())
+        {
+            glDeleteVertexArrays(static_cast<GLsizei>(scratchArrays_.size()), scratchArrays_.data());
+            ++stats_.batches;
+        }
+
+        if (!scratchTextures_.empty())
+        {
+            glDeleteTextures(static_cast<GLsizei>(scratchTextures_.size()), scratchTextures_.data());
+            ++stats_.batches;
+        }
+
+        stats_.deleted += scratchBuffers_.size() + scratchArrays_.size() + scratchTextures_.size();
+        queue_.erase(queue_.begin(), end);
+        stats_.pending = queue_.size();
+    }
+}
+
+#endif // SOULENGINE_ENABLE_OPENGL
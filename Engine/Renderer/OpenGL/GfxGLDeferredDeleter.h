@@ -0,0 +1,65 @@
+#pragma once
+
+#if defined(SOULENGINE_ENABLE_OPENGL)
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include <glad/glad.h>
+
+namespace SoulEngine::Gfx
+{
+    // Per-device queue of GL object names whose destruction is postponed until the
+    // frame that last referenced them has retired its fence (see OpenGLRenderer::frameFences_).
+    class GLDeferredDeleter
+    {
+    public:
+        enum class ObjectType : uint8_t { Buffer, VertexArray, Texture };
+
+        struct Stats
+        {
+            std::size_t pending = 0;        // current queue depth
+            std::size_t peakPending = 0;
+            uint64_t deleted = 0;
+            uint64_t batches = 0;           // glDelete* calls issued
+        };
+
+        GLDeferredDeleter() = default;
+        ~GLDeferredDeleter();
+
+        void Enqueue(ObjectType type, GLuint name);
+
+        // Objects enqueued from now on belong to frameIndex
+        void SetCurrentFrame(uint64_t frameIndex) { currentFrame_ = frameIndex; }
+        uint64_t GetCurrentFrame() const { return currentFrame_; }
+
+        // Frame completedFrame's fence has signaled: delete everything recorded up to it
+        void RetireFrame(uint64_t completedFrame);
+
+        // Delete everything now; subsequent Enqueue calls delete immediately
+        void FlushAll(bool deleteImmediatelyAfter);
+
+        const Stats& GetStats() const { return stats_; }
+
+    private:
+        struct Entry
+        {
+            uint64_t frame;
+            ObjectType type;
+            GLuint name;
+        };
+
+        void DeleteBatch(std::deque<Entry>::iterator end);
+
+        std::deque<Entry> queue_;
+        std::vector<GLuint> scratchBuffers_;
+        std::vector<GLuint> scratchArrays_;
+        std::vector<GLuint> scratchTextures_;
+        uint64_t currentFrame_ = 0;
+        bool immediate_ = false;
+        Stats stats_{};
+    };
+}
+
+#endif // SOULENGINE_ENABLE_OPENGL
@@ -6,13 +6,45 @@
 #include "Renderer/OpenGL/GfxGLBuffer.h"
 #include "Renderer/OpenGL/GfxGLShader.h"
 #include "Renderer/OpenGL/GfxGLProgram.h"
+#include "Renderer/OpenGL/GfxGLPipelineState.h"
+#include "Renderer/OpenGL/GfxGLDeferredDeleter.h"
+#include "Renderer/OpenGL/GfxGLTexture.h"
+#include "Log/Logger.h"
 #include <glad/glad.h>
 
 namespace SoulEngine::Gfx
 {
+    GfxGLDevice::GfxGLDevice()
+        : deleter_(std::make_shared<GLDeferredDeleter>())
+    {
+    }
+
+    GfxGLDevice::~GfxGLDevice()
+    {
+        // Release cached pipelines (and the layouts they hold) before the final flush
+        pipelineCache_.Clear();
+        FlushDeferredDeletes();
+    }
+
+    void GfxGLDevice::BeginFrame(uint64_t frameIndex)
+    {
+        deleter_->SetCurrentFrame(frameIndex);
+    }
+
+    void GfxGLDevice::RetireFrame(uint64_t completedFrame)
+    {
+        deleter_->RetireFrame(completedFrame);
+    }
+
+    void GfxGLDevice::FlushDeferredDeletes()
+    {
+        // Objects released after this point (e.g. resources outliving the device) are deleted immediately
+        deleter_->FlushAll(true);
+    }
+
     std::shared_ptr<IBuffer> GfxGLDevice::CreateBuffer(const BufferDesc& desc, const SubresourceData* initial)
     {
-        auto buf = std::make_shared<GLBuffer>(desc);
+        auto buf = std::make_shared<GLBuffer>(desc, deleter_);
         buf->Initialize(initial);
         return buf;
     }
@@ -44,6 +76,44 @@ namespace SoulEngine::Gfx
         auto glfs = std::static_pointer_cast<GLShaderModule>(fs);
         return std::make_shared<GLProgram>(glvs, glfs, name);
     }
+
+    std::shared_ptr<IPipelineState> GfxGLDevice::CreatePipelineState(const PipelineStateDesc& desc)
+    {
+        return pipelineCache_.GetOrCreate(desc, [](const PipelineStateDesc& d, std::size_t hash) {
+            return std::make_shared<GLPipelineState>(d, hash);
+        });
+    }
+
+    std::size_t GfxGLDevice::TrimPipelineStates()
+    {
+        return pipelineCache_.Trim();
+    }
+
+    std::shared_ptr<ITexture> GfxGLDevice::CreateTexture(const TextureDesc& desc, const SubresourceData* initial)
+    {
+        const GLTextureFormat format = ToGLTextureFormat(desc.format);
+        if (format.internalFormat == 0)
+        {
+            Logger::Error("GfxGLDevice: texture '{}' uses a format this context cannot sample ({})",
+                          desc.name ? desc.name : "", static_cast<int>(desc.format));
+            return nullptr;
+        }
+        auto tex = std::make_shared<GLTexture>(desc, format, deleter_);
+        tex->Initialize(initial);
+        return tex;
+    }
+
+    std::shared_ptr<ISampler> GfxGLDevice::CreateSampler(const SamplerDesc& desc)
+    {
+        for (const auto& entry : samplers_)
+        {
+            if (entry.first == desc)
+                return entry.second;
+        }
+        auto sampler = std::make_shared<GLSampler>(desc);
+        samplers_.emplace_back(desc, sampler);
+        return sampler;
+    }
 }
 
 #endif // SOULENGINE_ENABLE_OPENGL
@@ -3,18 +3,22 @@
 #if defined(SOULENGINE_ENABLE_OPENGL)
 
 #include <memory>
+#include <utility>
+#include <vector>
 #include "Renderer/Gfx.h"
+#include "Renderer/GfxPipelineCache.h"
 
 namespace SoulEngine::Gfx
 {
     class GLBuffer;
     class GLVertexInputLayout;
+    class GLDeferredDeleter;
 
     class GfxGLDevice final : public IDevice
     {
     public:
-        GfxGLDevice() = default;
-        ~GfxGLDevice() override = default;
+        GfxGLDevice();
+        ~GfxGLDevice() override;
 
         std::shared_ptr<IBuffer> CreateBuffer(const BufferDesc& desc, const SubresourceData* initial) override;
         std::shared_ptr<IVertexInputLayout> CreateVertexInputLayout(const VertexAttribute* attrs, uint32_t count) override;
@@ -22,6 +26,25 @@ namespace SoulEngine::Gfx
         std::shared_ptr<IProgram> CreateProgram(const std::shared_ptr<IShaderModule>& vs,
                                                const std::shared_ptr<IShaderModule>& fs,
                                                const char* name = nullptr) override;
+        std::shared_ptr<IPipelineState> CreatePipelineState(const PipelineStateDesc& desc) override;
+        std::size_t TrimPipelineStates() override;
+        std::shared_ptr<ITexture> CreateTexture(const TextureDesc& desc, const SubresourceData* initial) override;
+        std::shared_ptr<ISampler> CreateSampler(const SamplerDesc& desc) override;
+
+        const PipelineStateCache& GetPipelineCache() const { return pipelineCache_; }
+
+        // Frame bookkeeping for deferred GL object destruction, driven by OpenGLRenderer
+        void BeginFrame(uint64_t frameIndex);
+        void RetireFrame(uint64_t completedFrame);
+        void FlushDeferredDeletes();
+        GLDeferredDeleter& GetDeferredDeleter() const { return *deleter_; }
+        const std::shared_ptr<GLDeferredDeleter>& ShareDeferredDeleter() const { return deleter_; }
+
+    private:
+        PipelineStateCache pipelineCache_;
+        std::shared_ptr<GLDeferredDeleter> deleter_;
+        // Few distinct samplers exist in practice, a linear search is enough
+        std::vector<std::pair<SamplerDesc, std::shared_ptr<ISampler>>> samplers_;
     };
 }
 
@@ -0,0 +1,66 @@
+#if defined(SOULENGINE_ENABLE_OPENGL)
+
+#include "Renderer/OpenGL/GfxGLExtensions.h"
+#include "Log/Logger.h"
+#include <cstring>
+
+namespace SoulEngine::Gfx
+{
+    namespace
+    {
+        GLExtensions g_extensions{};
+
+        bool VersionAtLeast(int major, int minor)
+        {
+            return g_extensions.majorVersion > major
+                || (g_extensions.majorVersion == major && g_extensions.minorVersion >= minor);
+        }
+    }
+
+    void LoadGLExtensions(GLADloadfunc load)
+    {
+        g_extensions = GLExtensions{};
+        glGetIntegerv(GL_MAJOR_VERSION, &g_extensions.majorVersion);
+        glGetIntegerv(GL_MINOR_VERSION, &g_extensions.minorVersion);
+
+        // Some drivers hand out non-null pointers for unsupported entry points, so gate on the version
+        if (load && VersionAtLeast(4, 0))
+            g_extensions.DrawElementsIndirect = reinterpret_cast<PFNSEGLDRAWELEMENTSINDIRECTPROC>(load("glDrawElementsIndirect"));
+        if (load && VersionAtLeast(4, 3))
+            g_extensions.MultiDrawElementsIndirect = reinterpret_cast<PFNSEGLMULTIDRAWELEMENTSINDIRECTPROC>(load("glMultiDrawElementsIndirect"));
+
+        bool anisotropic = VersionAtLeast(4, 6);
+        g_extensions.hasBPTC = VersionAtLeast(4, 2);
+        GLint extensionCount = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+        for (GLint i = 0; i < extensionCount; ++i)
+        {
+            const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+            if (!name)
+                continue;
+            if (std::strcmp(name, "GL_EXT_texture_compression_s3tc") == 0)
+                g_extensions.hasS3TC = true;
+            else if (std::strcmp(name, "GL_EXT_texture_sRGB") == 0 || std::strcmp(name, "GL_EXT_texture_compression_s3tc_srgb") == 0)
+                g_extensions.hasS3TCSRGB = true;
+            else if (std::strcmp(name, "GL_ARB_texture_compression_bptc") == 0)
+                g_extensions.hasBPTC = true;
+            else if (std::strcmp(name, "GL_EXT_texture_filter_anisotropic") == 0 || std::strcmp(name, "GL_ARB_texture_filter_anisotropic") == 0)
+                anisotropic = true;
+        }
+        g_extensions.hasS3TCSRGB = g_extensions.hasS3TCSRGB && g_extensions.hasS3TC;
+        if (anisotropic)
+            glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &g_extensions.maxAnisotropy);
+
+        Logger::Log("GL {}.{}: drawIndirect={}, multiDrawIndirect={}, s3tc={}, bptc={}, anisotropy={}",
+                    g_extensions.majorVersion, g_extensions.minorVersion,
+                    g_extensions.HasDrawIndirect(), g_extensions.HasMultiDrawIndirect(),
+                    g_extensions.hasS3TC, g_extensions.hasBPTC, g_extensions.maxAnisotropy);
+    }
+
+    const GLExtensions& GetGLExtensions()
+    {
+        return g_extensions;
+    }
+}
+
+#endif // SOULENGINE_ENABLE_OPENGL
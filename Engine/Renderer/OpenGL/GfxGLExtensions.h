@@ -0,0 +1,59 @@
+#pragma once
+
+#if defined(SOULENGINE_ENABLE_OPENGL)
+
+#include <glad/glad.h>
+
+// The vendored glad loader is generated for GL 3.3 core.
+// Entry points from newer versions are resolved at runtime and may be null.
+
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+
+// EXT_texture_compression_s3tc, EXT_texture_sRGB, ARB_texture_compression_bptc, EXT_texture_filter_anisotropic
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#define GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM 0x8E8D
+#endif
+#ifndef GL_TEXTURE_MAX_ANISOTROPY
+#define GL_TEXTURE_MAX_ANISOTROPY 0x84FE
+#define GL_MAX_TEXTURE_MAX_ANISOTROPY 0x84FF
+#endif
+
+namespace SoulEngine::Gfx
+{
+    typedef void (GLAD_API_PTR *PFNSEGLDRAWELEMENTSINDIRECTPROC)(GLenum mode, GLenum type, const void* indirect);
+    typedef void (GLAD_API_PTR *PFNSEGLMULTIDRAWELEMENTSINDIRECTPROC)(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride);
+
+    struct GLExtensions
+    {
+        int majorVersion = 3;
+        int minorVersion = 3;
+
+        PFNSEGLDRAWELEMENTSINDIRECTPROC      DrawElementsIndirect = nullptr;      // GL 4.0
+        PFNSEGLMULTIDRAWELEMENTSINDIRECTPROC MultiDrawElementsIndirect = nullptr; // GL 4.3
+
+        bool hasS3TC = false;           // BC1/BC3
+        bool hasS3TCSRGB = false;
+        bool hasBPTC = false;           // BC7, core in 4.2
+        float maxAnisotropy = 1.0f;     // 1 when anisotropic filtering is unavailable
+
+        bool HasDrawIndirect() const { return DrawElementsIndirect != nullptr; }
+        bool HasMultiDrawIndirect() const { return MultiDrawElementsIndirect != nullptr; }
+    };
+
+    // Call once after gladLoadGL, with the same loader
+    void LoadGLExtensions(GLADloadfunc load);
+    const GLExtensions& GetGLExtensions();
+}
+
+#endif // SOULENGINE_ENABLE_OPENGL
@@ -0,0 +1,33 @@
+#pragma once
+
+#if defined(SOULENGINE_ENABLE_OPENGL)
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include "Renderer/Gfx.h"
+#include "Renderer/OpenGL/GfxGLCommon.h"
+
+namespace SoulEngine::Gfx
+{
+    // The context keeps the bound pipeline alive (shared_from_this) so a cache trim cannot recycle its address
+    class GLPipelineState final : public IPipelineState, public std::enable_shared_from_this<GLPipelineState>
+    {
+    public:
+        GLPipelineState(const PipelineStateDesc& desc, std::size_t hash)
+            : desc_(desc), hash_(hash), name_(desc.name ? desc.name : "")
+        {
+            desc_.name = desc.name ? name_.c_str() : nullptr;
+        }
+
+        const PipelineStateDesc& GetDesc() const override { return desc_; }
+        std::size_t GetHash() const override { return hash_; }
+
+    private:
+        PipelineStateDesc desc_;
+        std::size_t hash_ = 0;
+        std::string name_;
+    };
+}
+
+#endif // SOULENGINE_ENABLE_OPENGL
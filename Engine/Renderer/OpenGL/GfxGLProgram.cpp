@@ -35,6 +35,7 @@ namespace SoulEngine::Gfx
     {
         reflection_.uniforms.clear();
         reflection_.samplers.clear();
+        reflection_.uniformBlocks.clear();
 
         GLint uniformCount = 0;
         glGetProgramiv(program_, GL_ACTIVE_UNIFORMS, &uniformCount);
@@ -71,18 +72,94 @@ namespace SoulEngine::Gfx
             }
             reflection_.uniforms.push_back(std::move(u));
         }
+
+        GLint blockCount = 0;
+        glGetProgramiv(program_, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+        for (GLint i = 0; i < blockCount; ++i)
+        {
+            GLint nameLen = 0, size = 0;
+            glGetActiveUniformBlockiv(program_, i, GL_UNIFORM_BLOCK_NAME_LENGTH, &nameLen);
+            glGetActiveUniformBlockiv(program_, i, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+            UniformBlockInfo b{};
+            b.name.resize(nameLen > 0 ? nameLen : 0);
+            GLsizei written = 0;
+            glGetActiveUniformBlockName(program_, i, nameLen, &written, b.name.data());
+            b.name.resize(written);
+            b.index = static_cast<uint32_t>(i);
+            b.size = static_cast<uint32_t>(size);
+            reflection_.uniformBlocks.push_back(std::move(b));
+        }
+
+        // Seed the lookup cache; arrays are also reachable by their base name ("u_Lights" for "u_Lights[0]")
+        uniformCache_.clear();
+        for (const auto& u : reflection_.uniforms)
+        {
+            std::string_view key(u.name);
+            uniformCache_.emplace(key, u.location);
+            const auto bracket = key.find('[');
+            if (bracket != std::string_view::npos)
+                uniformCache_.emplace(key.substr(0, bracket), u.location);
+        }
     }
 
     int GLProgram::GetUniformLocation(const char* name) const
     {
         if (!name) return -1;
-        auto it = uniformCache_.find(name);
+        auto it = uniformCache_.find(std::string_view(name));
         if (it != uniformCache_.end()) return it->second;
         GLint loc = glGetUniformLocation(program_, name);
-        uniformCache_[name] = loc;
+        const std::string& key = extraNames_.emplace_back(name);
+        uniformCache_.emplace(std::string_view(key), loc);
         return loc;
     }
 
+    UniformHandle GLProgram::GetUniformHandle(const char* name) const
+    {
+        return UniformHandle{ GetUniformLocation(name) };
+    }
+
+    void GLProgram::SetInt(UniformHandle h, int v)
+    {
+        if (h.IsValid()) glUniform1i(h.location, v);
+    }
+
+    void GLProgram::SetFloat(UniformHandle h, float v)
+    {
+        if (h.IsValid()) glUniform1f(h.location, v);
+    }
+
+    void GLProgram::SetVec2(UniformHandle h, const float* v2)
+    {
+        if (h.IsValid()) glUniform2fv(h.location, 1, v2);
+    }
+
+    void GLProgram::SetVec3(UniformHandle h, const float* v3)
+    {
+        if (h.IsValid()) glUniform3fv(h.location, 1, v3);
+    }
+
+    void GLProgram::SetVec4(UniformHandle h, const float* v4)
+    {
+        if (h.IsValid()) glUniform4fv(h.location, 1, v4);
+    }
+
+    void GLProgram::SetMat4(UniformHandle h, const float* m16, bool transpose)
+    {
+        if (h.IsValid()) glUniformMatrix4fv(h.location, 1, transpose ? GL_TRUE : GL_FALSE, m16);
+    }
+
+    void GLProgram::BindUniformBlock(const char* blockName, uint32_t slot)
+    {
+        if (!blockName) return;
+        const GLuint index = glGetUniformBlockIndex(program_, blockName);
+        if (index == GL_INVALID_INDEX)
+        {
+            Logger::Warn("Uniform block not found: {}", blockName);
+            return;
+        }
+        glUniformBlockBinding(program_, index, slot);
+    }
+
     void GLProgram::SetTexture(const char* name, int slot)
     {
         const int loc = GetUniformLocation(name);
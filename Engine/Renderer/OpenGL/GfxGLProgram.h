@@ -5,6 +5,8 @@
 #include <memory>
 #include <unordered_map>
 #include <string>
+#include <string_view>
+#include <deque>
 #include <vector>
 #include <glad/glad.h>
 #include "Renderer/Gfx.h"
@@ -34,12 +36,24 @@ namespace SoulEngine::Gfx
     void SetVec4(const char* name, const float* v4) override;
     void SetMat4(const char* name, const float* m16, bool transpose=false) override;
 
+        UniformHandle GetUniformHandle(const char* name) const override;
+        void SetInt(UniformHandle h, int v) override;
+        void SetFloat(UniformHandle h, float v) override;
+        void SetVec2(UniformHandle h, const float* v2) override;
+        void SetVec3(UniformHandle h, const float* v3) override;
+        void SetVec4(UniformHandle h, const float* v4) override;
+        void SetMat4(UniformHandle h, const float* m16, bool transpose=false) override;
+
+        void BindUniformBlock(const char* blockName, uint32_t slot) override;
+
         int GetUniformLocation(const char* name) const;
 
     private:
         GLuint program_ = 0;
         ProgramReflection reflection_{};
-        mutable std::unordered_map<std::string, int> uniformCache_;
+        // Keys view into reflection_ names or extraNames_, so lookups never allocate
+        mutable std::unordered_map<std::string_view, int> uniformCache_;
+        mutable std::deque<std::string> extraNames_;
 
         void Reflect();
     };
@@ -0,0 +1,150 @@
+#if defined(SOULENGINE_ENABLE_OPENGL)
+
+#include "Renderer/OpenGL/GfxGLTexture.h"
+#include "Renderer/OpenGL/GfxGLDeferredDeleter.h"
+#include "Log/Logger.h"
+#include <algorithm>
+
+namespace SoulEngine::Gfx
+{
+    namespace
+    {
+        // Rows of small formats (R8, BC tails) are not 4-byte aligned; other GL code keeps its own unpack alignment
+        class ScopedUnpackAlignment
+        {
+        public:
+            ScopedUnpackAlignment()
+            {
+                glGetIntegerv(GL_UNPACK_ALIGNMENT, &previous_);
+                if (previous_ != 1)
+                    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            }
+            ~ScopedUnpackAlignment()
+            {
+                if (previous_ != 1)
+                    glPixelStorei(GL_UNPACK_ALIGNMENT, previous_);
+            }
+
+        private:
+            GLint previous_ = 4;
+        };
+    }
+
+    GLTexture::GLTexture(const TextureDesc& desc, const GLTextureFormat& format, std::shared_ptr<GLDeferredDeleter> deleter)
+        : desc_(desc), format_(format), deleter_(std::move(deleter))
+    {
+        desc_.width = std::max(desc_.width, 1u);
+        desc_.height = std::max(desc_.height, 1u);
+        desc_.arrayLayers = std::max(desc_.arrayLayers, 1u);
+        desc_.mipLevels = std::min(std::max(desc_.mipLevels, 1u), GetMipLevelCount(desc_.width, desc_.height));
+        target_ = desc_.type == TextureType::Texture2DArray ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+        glGenTextures(1, &texture_);
+    }
+
+    GLTexture::~GLTexture()
+    {
+        if (!texture_)
+            return;
+        if (deleter_)
+            deleter_->Enqueue(GLDeferredDeleter::ObjectType::Texture, texture_);
+        else
+            glDeleteTextures(1, &texture_);
+    }
+
+    void GLTexture::Initialize(const SubresourceData* initial)
+    {
+        glBindTexture(target_, texture_);
+        ScopedUnpackAlignment unpackAlignment;
+        glTexParameteri(target_, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(target_, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(desc_.mipLevels - 1));
+
+        for (uint32_t mip = 0; mip < desc_.mipLevels; ++mip)
+        {
+            const GLsizei w = static_cast<GLsizei>(std::max(desc_.width >> mip, 1u));
+            const GLsizei h = static_cast<GLsizei>(std::max(desc_.height >> mip, 1u));
+            const std::size_t layerSize = GetTextureLevelSize(desc_.format, w, h);
+
+            if (target_ == GL_TEXTURE_2D)
+            {
+                const void* data = initial ? initial[mip].data : nullptr;
+                if (format_.compressed)
+                    glCompressedTexImage2D(target_, mip, format_.internalFormat, w, h, 0, static_cast<GLsizei>(layerSize), data);
+                else
+                    glTexImage2D(target_, mip, format_.internalFormat, w, h, 0, format_.format, format_.type, data);
+                continue;
+            }
+
+            // Arrays: allocate the level, then fill it layer by layer
+            const GLsizei layers = static_cast<GLsizei>(desc_.arrayLayers);
+            if (format_.compressed)
+                glCompressedTexImage3D(target_, mip, format_.internalFormat, w, h, layers, 0, static_cast<GLsizei>(layerSize * layers), nullptr);
+            else
+                glTexImage3D(target_, mip, format_.internalFormat, w, h, layers, 0, format_.format, format_.type, nullptr);
+            if (initial)
+            {
+                for (uint32_t layer = 0; layer < desc_.arrayLayers; ++layer)
+                {
+                    const SubresourceData& src = initial[layer * desc_.mipLevels + mip];
+                    if (src.data)
+                        UpdateLevel(mip, layer, src.data, src.size ? src.size : layerSize);
+                }
+            }
+        }
+    }
+
+    void GLTexture::UpdateLevel(uint32_t mipLevel, uint32_t arrayLayer, const void* data, std::size_t size)
+    {
+        if (mipLevel >= desc_.mipLevels || arrayLayer >= desc_.arrayLayers || !data)
+        {
+            Logger::Warn("GLTexture '{}': invalid update of mip {} layer {}", desc_.name ? desc_.name : "", mipLevel, arrayLayer);
+            return;
+        }
+        const GLsizei w = static_cast<GLsizei>(std::max(desc_.width >> mipLevel, 1u));
+        const GLsizei h = static_cast<GLsizei>(std::max(desc_.height >> mipLevel, 1u));
+
+        glBindTexture(target_, texture_);
+        ScopedUnpackAlignment unpackAlignment;
+        if (target_ == GL_TEXTURE_2D)
+        {
+            if (format_.compressed)
+                glCompressedTexSubImage2D(target_, mipLevel, 0, 0, w, h, format_.internalFormat, static_cast<GLsizei>(size), data);
+            else
+                glTexSubImage2D(target_, mipLevel, 0, 0, w, h, format_.format, format_.type, data);
+        }
+        else
+        {
+            if (format_.compressed)
+                glCompressedTexSubImage3D(target_, mipLevel, 0, 0, arrayLayer, w, h, 1, format_.internalFormat, static_cast<GLsizei>(size), data);
+            else
+                glTexSubImage3D(target_, mipLevel, 0, 0, arrayLayer, w, h, 1, format_.format, format_.type, data);
+        }
+    }
+
+    GLSampler::GLSampler(const SamplerDesc& desc)
+        : desc_(desc)
+    {
+        glGenSamplers(1, &sampler_);
+        glSamplerParameteri(sampler_, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(ToGLMinFilter(desc_.minFilter, desc_.mipFilter, true)));
+        glSamplerParameteri(sampler_, GL_TEXTURE_MAG_FILTER, desc_.magFilter == FilterMode::Linear ? GL_LINEAR : GL_NEAREST);
+        glSamplerParameteri(sampler_, GL_TEXTURE_WRAP_S, static_cast<GLint>(ToGLAddressMode(desc_.addressU)));
+        glSamplerParameteri(sampler_, GL_TEXTURE_WRAP_T, static_cast<GLint>(ToGLAddressMode(desc_.addressV)));
+        glSamplerParameteri(sampler_, GL_TEXTURE_WRAP_R, static_cast<GLint>(ToGLAddressMode(desc_.addressW)));
+        glSamplerParameterf(sampler_, GL_TEXTURE_MIN_LOD, desc_.minLod);
+        glSamplerParameterf(sampler_, GL_TEXTURE_MAX_LOD, desc_.maxLod);
+        glSamplerParameterf(sampler_, GL_TEXTURE_LOD_BIAS, desc_.mipLodBias);
+        glSamplerParameterfv(sampler_, GL_TEXTURE_BORDER_COLOR, desc_.borderColor);
+
+        const float maxAnisotropy = GetGLExtensions().maxAnisotropy;
+        if (desc_.maxAnisotropy > 1.0f && maxAnisotropy > 1.0f)
+            glSamplerParameterf(sampler_, GL_TEXTURE_MAX_ANISOTROPY, std::min(desc_.maxAnisotropy, maxAnisotropy));
+    }
+
+    GLSampler::~GLSampler()
+    {
+        // Sampler state is not referenced by in-flight commands after unbinding, so no deferral is needed
+        if (sampler_)
+            glDeleteSamplers(1, &sampler_);
+    }
+}
+
+#endif // SOULENGINE_ENABLE_OPENGL
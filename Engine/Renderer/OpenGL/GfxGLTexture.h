@@ -0,0 +1,53 @@
+#pragma once
+
+#if defined(SOULENGINE_ENABLE_OPENGL)
+
+#include <glad/glad.h>
+#include "Renderer/Gfx.h"
+#include "Renderer/OpenGL/GfxGLCommon.h"
+#include <memory>
+
+namespace SoulEngine::Gfx
+{
+    class GLDeferredDeleter;
+
+    class GLTexture final : public ITexture
+    {
+    public:
+        // deleter may be null, in which case the GL name is deleted immediately
+        GLTexture(const TextureDesc& desc, const GLTextureFormat& format, std::shared_ptr<GLDeferredDeleter> deleter);
+        ~GLTexture() override;
+
+        const TextureDesc& GetDesc() const override { return desc_; }
+
+        // Allocates every level, filling the ones initial provides
+        void Initialize(const SubresourceData* initial);
+        void UpdateLevel(uint32_t mipLevel, uint32_t arrayLayer, const void* data, std::size_t size) override;
+
+        GLuint GetGLName() const { return texture_; }
+        GLenum GetTarget() const { return target_; }
+
+    private:
+        TextureDesc desc_{};
+        GLTextureFormat format_{};
+        GLuint texture_ = 0;
+        GLenum target_ = GL_TEXTURE_2D;
+        std::shared_ptr<GLDeferredDeleter> deleter_;
+    };
+
+    class GLSampler final : public ISampler
+    {
+    public:
+        explicit GLSampler(const SamplerDesc& desc);
+        ~GLSampler() override;
+
+        const SamplerDesc& GetDesc() const override { return desc_; }
+        GLuint GetGLName() const { return sampler_; }
+
+    private:
+        SamplerDesc desc_{};
+        GLuint sampler_ = 0;
+    };
+}
+
+#endif // SOULENGINE_ENABLE_OPENGL
@@ -0,0 +1,150 @@
+#if defined(SOULENGINE_ENABLE_OPENGL)
+
+#include "Renderer/OpenGL/GfxGLVertexArrayCache.h"
+#include "Renderer/OpenGL/GfxGLBuffer.h"
+#include "Renderer/OpenGL/GfxGLVertexInputLayout.h"
+#include "Renderer/OpenGL/GfxGLDeferredDeleter.h"
+#include "Core/Hash.h"
+
+namespace SoulEngine::Gfx
+{
+    std::size_t GLVertexArrayCache::KeyHash::operator()(const Key& key) const
+    {
+        std::size_t seed = 0;
+        HashCombine(seed, key.layoutId);
+        HashCombine(seed, key.indexBufferId);
+        for (const SlotKey& s : key.slots)
+        {
+            HashCombine(seed, s.bufferId);
+            HashCombine(seed, (static_cast<uint64_t>(s.stride) << 32) | s.offset);
+        }
+        return seed;
+    }
+
+    GLVertexArrayCache::GLVertexArrayCache(std::shared_ptr<GLDeferredDeleter> deleter, std::size_t maxEntries)
+        : deleter_(std::move(deleter)), maxEntries_(maxEntries)
+    {
+    }
+
+    GLVertexArrayCache::~GLVertexArrayCache()
+    {
+        Clear();
+    }
+
+    GLuint GLVertexArrayCache::Acquire(const GLVertexInputLayout& layout, const std::vector<GLBuffer*>& buffers,
+                                       const std::vector<uint32_t>& strides, const std::vector<uint32_t>& offsets, const GLBuffer* indexBuffer,
+                                       bool& created)
+    {
+        created = false;
+        // Only the slots the layout reads take part in the key; unused bindings do not split entries
+        const uint32_t slotCount = layout.GetBindingCount();
+        scratch_.layoutId = layout.GetId();
+        scratch_.indexBufferId = indexBuffer ? indexBuffer->GetId() : 0;
+        scratch_.slots.resize(slotCount);
+        for (uint32_t i = 0; i < slotCount; ++i)
+        {
+            const GLBuffer* buffer = i < buffers.size() ? buffers[i] : nullptr;
+            scratch_.slots[i] = { buffer ? buffer->GetId() : 0,
+                                  i < strides.size() ? strides[i] : 0,
+                                  i < offsets.size() ? offsets[i] : 0 };
+        }
+
+        auto it = entries_.find(scratch_);
+        if (it != entries_.end())
+        {
+            it->second.lastUsedFrame = frame_;
+            ++stats_.hits;
+            return it->second.vao;
+        }
+
+        if (entries_.size() >= maxEntries_)
+        {
+            auto oldest = entries_.begin();
+            for (auto e = entries_.begin(); e != entries_.end(); ++e)
+                if (e->second.lastUsedFrame < oldest->second.lastUsedFrame)
+                    oldest = e;
+            Release(oldest->second.vao);
+            entries_.erase(oldest);
+            ++stats_.evicted;
+        }
+
+        ++stats_.misses;
+        created = true;
+        const GLuint vao = Create(layout, buffers, strides, offsets, indexBuffer);
+        entries_.emplace(scratch_, Entry{ vao, frame_ });
+        stats_.live = entries_.size();
+        return vao;
+    }
+
+    GLuint GLVertexArrayCache::Create(const GLVertexInputLayout& layout, const std::vector<GLBuffer*>& buffers,
+                                      const std::vector<uint32_t>& strides, const std::vector<uint32_t>& offsets, const GLBuffer* indexBuffer)
+    {
+        GLuint vao = 0;
+        glGenVertexArrays(1, &vao);
+        glBindVertexArray(vao);
+
+        GLuint boundVbo = 0;
+        for (const GLVertexAttribFormat& f : layout.GetFormats())
+        {
+            const uint32_t slot = f.bindingSlot;
+            if (slot >= buffers.size() || buffers[slot] == nullptr)
+                continue;
+
+            const GLuint vbo = buffers[slot]->GetGLName();
+            if (vbo != boundVbo)
+            {
+                glBindBuffer(GL_ARRAY_BUFFER, vbo);
+                boundVbo = vbo;
+            }
+
+            const GLsizei stride = static_cast<GLsizei>(slot < strides.size() ? strides[slot] : 0);
+            const uintptr_t offset = static_cast<uintptr_t>((slot < offsets.size() ? offsets[slot] : 0) + f.relativeOffset);
+            glEnableVertexAttribArray(f.location);
+            glVertexAttribPointer(f.location, f.format.size, f.format.type, f.format.normalized, stride,
+                                  reinterpret_cast<const GLvoid*>(offset));
+            if (f.divisor > 0)
+                glVertexAttribDivisor(f.location, f.divisor);
+        }
+
+        if (indexBuffer)
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer->GetGLName());
+
+        // GL_ARRAY_BUFFER is not VAO state; reset it to avoid leaking the binding
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return vao;
+    }
+
+    void GLVertexArrayCache::Trim(uint64_t currentFrame, uint64_t maxIdleFrames)
+    {
+        for (auto it = entries_.begin(); it != entries_.end();)
+        {
+            if (currentFrame - it->second.lastUsedFrame > maxIdleFrames)
+            {
+                Release(it->second.vao);
+                it = entries_.erase(it);
+                ++stats_.evicted;
+            }
+            else
+                ++it;
+        }
+        stats_.live = entries_.size();
+    }
+
+    void GLVertexArrayCache::Clear()
+    {
+        for (auto& [key, entry] : entries_)
+            Release(entry.vao);
+        entries_.clear();
+        stats_.live = 0;
+    }
+
+    void GLVertexArrayCache::Release(GLuint vao)
+    {
+        if (deleter_)
+            deleter_->Enqueue(GLDeferredDeleter::ObjectType::VertexArray, vao);
+        else
+            glDeleteVertexArrays(1, &vao);
+    }
+}
+
+#endif // SOULENGINE_ENABLE_OPENGL
@@ -0,0 +1,95 @@
+#pragma once
+
+#if defined(SOULENGINE_ENABLE_OPENGL)
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace SoulEngine::Gfx
+{
+    class GLBuffer;
+    class GLVertexInputLayout;
+    class GLDeferredDeleter;
+
+    // Fully configured VAOs keyed by (layout, vertex buffer tuple, index buffer).
+    // GL 3.3 has no ARB_vertex_attrib_binding, so a binding change cannot be applied to an existing VAO
+    // cheaply; instead every distinct combination gets its own VAO, configured once with glVertexAttribPointer.
+    // Keys use the layout/buffer ids rather than GL names, so a recycled name never hits a stale VAO.
+    class GLVertexArrayCache
+    {
+    public:
+        struct Stats
+        {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t evicted = 0;
+            std::size_t live = 0;
+        };
+
+        // deleter may be null, in which case evicted VAOs are deleted immediately
+        explicit GLVertexArrayCache(std::shared_ptr<GLDeferredDeleter> deleter, std::size_t maxEntries = 1024);
+        ~GLVertexArrayCache();
+
+        GLVertexArrayCache(const GLVertexArrayCache&) = delete;
+        GLVertexArrayCache& operator=(const GLVertexArrayCache&) = delete;
+
+        // Returns the VAO for this combination, creating and configuring it on a miss.
+        // A miss leaves the new VAO bound and sets created; a hit does not touch GL state.
+        GLuint Acquire(const GLVertexInputLayout& layout, const std::vector<GLBuffer*>& buffers,
+                       const std::vector<uint32_t>& strides, const std::vector<uint32_t>& offsets, const GLBuffer* indexBuffer,
+                       bool& created);
+
+        // Drops VAOs not used during the last maxIdleFrames frames. Entries that reference destroyed
+        // buffers can never be hit again and are released here.
+        void Trim(uint64_t currentFrame, uint64_t maxIdleFrames);
+        void Clear();
+
+        void SetFrame(uint64_t frame) { frame_ = frame; }
+        const Stats& GetStats() const { return stats_; }
+
+    private:
+        struct SlotKey
+        {
+            uint64_t bufferId;
+            uint32_t stride;
+            uint32_t offset;
+            bool operator==(const SlotKey& o) const { return bufferId == o.bufferId && stride == o.stride && offset == o.offset; }
+        };
+
+        struct Key
+        {
+            uint64_t layoutId = 0;
+            uint64_t indexBufferId = 0;
+            std::vector<SlotKey> slots;
+            bool operator==(const Key& o) const { return layoutId == o.layoutId && indexBufferId == o.indexBufferId && slots == o.slots; }
+        };
+
+        struct KeyHash
+        {
+            std::size_t operator()(const Key& key) const;
+        };
+
+        struct Entry
+        {
+            GLuint vao = 0;
+            uint64_t lastUsedFrame = 0;
+        };
+
+        GLuint Create(const GLVertexInputLayout& layout, const std::vector<GLBuffer*>& buffers,
+                      const std::vector<uint32_t>& strides, const std::vector<uint32_t>& offsets, const GLBuffer* indexBuffer);
+        void Release(GLuint vao);
+
+        std::unordered_map<Key, Entry, KeyHash> entries_;
+        Key scratch_;
+        std::shared_ptr<GLDeferredDeleter> deleter_;
+        std::size_t maxEntries_;
+        uint64_t frame_ = 0;
+        Stats stats_{};
+    };
+}
+
+#endif // SOULENGINE_ENABLE_OPENGL
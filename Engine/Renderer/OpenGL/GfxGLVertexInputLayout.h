@@ -9,29 +9,54 @@
 
 namespace SoulEngine::Gfx
 {
+    // Attribute format resolved once at creation; the buffers it reads from are bound separately
+    struct GLVertexAttribFormat
+    {
+        GLuint location;
+        uint32_t bindingSlot;
+        uint32_t relativeOffset;
+        uint32_t divisor;
+        GLFormatInfo format;
+    };
+
+    // Vertex format only (ARB_vertex_attrib_binding style). The VAO that combines it with concrete
+    // buffers lives in GLVertexArrayCache, keyed by this layout's id and the bound buffer tuple.
     class GLVertexInputLayout final : public IVertexInputLayout
     {
     public:
         GLVertexInputLayout(const VertexAttribute* attrs, uint32_t count)
-            : attributes_(attrs, attrs + count)
+            : attributes_(attrs, attrs + count), id_(NextId())
         {
-            glGenVertexArrays(1, &vao_);
+            formats_.reserve(count);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const VertexAttribute& a = attrs[i];
+                formats_.push_back({ a.location, a.bindingSlot, a.offset, a.stepRate, ToGLVertexFormat(a.format) });
+                if (a.bindingSlot + 1 > bindingCount_)
+                    bindingCount_ = a.bindingSlot + 1;
+            }
         }
 
-        ~GLVertexInputLayout() override
-        {
-            if (vao_)
-                glDeleteVertexArrays(1, &vao_);
-        }
+        ~GLVertexInputLayout() override = default;
 
-        GLuint GetVAO() const { return vao_; }
+        // Unique for the process lifetime, so cache keys never alias a destroyed layout
+        uint64_t GetId() const { return id_; }
         const std::vector<VertexAttribute>& GetAttributes() const { return attributes_; }
+        const std::vector<GLVertexAttribFormat>& GetFormats() const { return formats_; }
+        // Highest referenced binding slot + 1
         uint32_t GetBindingCount() const { return bindingCount_; }
 
     private:
-        GLuint vao_ = 0;
+        static uint64_t NextId()
+        {
+            static uint64_t counter = 0;
+            return ++counter;
+        }
+
         std::vector<VertexAttribute> attributes_;
-        uint32_t bindingCount_ = 0; // optional: could compute max binding + 1
+        std::vector<GLVertexAttribFormat> formats_;
+        uint64_t id_ = 0;
+        uint32_t bindingCount_ = 0;
     };
 }
 
@@ -10,6 +10,9 @@
 #include "Renderer/Gfx.h"
 #include "Renderer/OpenGL/GfxGLDevice.h"
 #include "Renderer/OpenGL/GfxGLContext.h"
+#include "Renderer/OpenGL/GfxGLExtensions.h"
+#include "Renderer/OpenGL/GfxGLDeferredDeleter.h"
+#include "Renderer/Capture/GfxCapture.h"
 
 using namespace SoulEngine::Gfx;
 namespace
@@ -34,12 +37,14 @@ namespace SoulEngine
             Logger::Error("Failed to initialize GLAD");
             return false;
         }
+        LoadGLExtensions((GLADloadfunc)glfwGetProcAddress);
         glViewport(0, 0, m_window->GetWidth(), m_window->GetHeight());
         window->SetFramebufferSizeCallback(framebuffer_size_callback);
 
         // Create Gfx device/context now that GL is initialized
         device_ = std::make_shared<GfxGLDevice>();
-        context_ = std::make_shared<GfxGLContext>();
+        context_ = std::make_shared<GfxGLContext>(device_->ShareDeferredDeleter());
+        InstallGfxCapture(device_.get(), context_.get());
 
         m_initialized = true;
         Logger::Log("OpenGLRenderer initialized successfully");
@@ -56,11 +61,10 @@ namespace SoulEngine
     {
         while (!frameFences_.empty())
         {
-            GLenum res = glClientWaitSync(frameFences_.front(), 0, 0);
+            GLenum res = glClientWaitSync(frameFences_.front().sync, 0, 0);
             if (res == GL_ALREADY_SIGNALED || res == GL_CONDITION_SATISFIED)
             {
-                glDeleteSync(frameFences_.front());
-                frameFences_.pop_front();
+                PopFrameFence();
             }
             else
                 break;
@@ -75,20 +79,29 @@ namespace SoulEngine
 
     void OpenGLRenderer::EndFrame()
     {
-        
+        // Pipelines released this frame no longer pin their programs and layouts
+        if (Gfx::IDevice* device = GetGfxDevice())
+            device->TrimPipelineStates();
     }
 
     void OpenGLRenderer::Shutdown()
     {
         Logger::Log("OpenGLRenderer Shutdown");
+        gfxCapture_.reset();
         context_.reset();
-        device_.reset();
-        m_initialized = false;
+        if (m_initialized)
+            glFinish();
         while (!frameFences_.empty())
+            PopFrameFence();
+        if (device_)
         {
-            glDeleteSync(frameFences_.front());
-            frameFences_.pop_front();
+            device_->FlushDeferredDeletes();
+            const auto& stats = device_->GetDeferredDeleter().GetStats();
+            Logger::Log("GL deferred deletes: {} objects in {} batches, peak queue depth {}",
+                        stats.deleted, stats.batches, stats.peakPending);
         }
+        device_.reset();
+        m_initialized = false;
     }
 
     void OpenGLRenderer::Clear()
@@ -100,24 +113,29 @@ namespace SoulEngine
     void OpenGLRenderer::SwapBuffers()
     {
         m_window->SwapBuffers();
+        if (gfxCapture_)
+            gfxCapture_->EndFrame();
         // optional: flush to ensure commands submitted so fence will observe them
         glFlush();
         
         // create fence and check
         if (GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0))
-            frameFences_.push_back(fence);
+            frameFences_.push_back({fence, frameIndex_});
         else
         {
             Logger::Warn("glFenceSync failed");
         }
+        // resources released from here on belong to the next frame
+        ++frameIndex_;
+        device_->BeginFrame(frameIndex_);
+        static_cast<GfxGLContext*>(context_.get())->BeginFrame(frameIndex_);
         
         while (!frameFences_.empty())
         {
-            GLenum res = glClientWaitSync(frameFences_.front(), 0, 0);
+            GLenum res = glClientWaitSync(frameFences_.front().sync, 0, 0);
             if (res == GL_ALREADY_SIGNALED || res == GL_CONDITION_SATISFIED)
             {
-                glDeleteSync(frameFences_.front());
-                frameFences_.pop_front();
+                PopFrameFence();
             }
             else
                 break;
@@ -127,42 +145,50 @@ namespace SoulEngine
         {
             while (frameFences_.size() > maxFramesInFlight)
             {
-                GLsync oldFence = frameFences_.front();
+                GLsync oldFence = frameFences_.front().sync;
                 GLenum waitRes = glClientWaitSync(oldFence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
                 if (waitRes == GL_WAIT_FAILED)
                 {
                     Logger::Warn("glClientWaitSync failed in flushGpu branch");
                     break;
                 }
-                glDeleteSync(oldFence);
-                frameFences_.pop_front();
+                PopFrameFence();
             }
         }
         else if (forceSync_)
         {
             while (frameFences_.size() > 1)
             {
-                GLsync oldFence = frameFences_.front();
+                GLsync oldFence = frameFences_.front().sync;
                 GLenum waitRes = glClientWaitSync(oldFence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
                 if (waitRes == GL_WAIT_FAILED)
                 {
                     Logger::Warn("glClientWaitSync failed in forceSync branch");
                     break;
                 }
-                glDeleteSync(oldFence);
-                frameFences_.pop_front();
+                PopFrameFence();
             }
         }
     }
 
+    void OpenGLRenderer::PopFrameFence()
+    {
+        const FrameFence retired = frameFences_.front();
+        glDeleteSync(retired.sync);
+        frameFences_.pop_front();
+        // GPU finished this frame: GL objects released during it can now be deleted without stalling
+        if (device_)
+            device_->RetireFrame(retired.frameIndex);
+    }
+
     Gfx::IDevice* OpenGLRenderer::GetGfxDevice()
     {
-        return device_.get();
+        return gfxCapture_ ? gfxCapture_->GetDevice() : device_.get();
     }
 
     Gfx::IContext* OpenGLRenderer::GetGfxContext()
     {
-        return context_.get();
+        return gfxCapture_ ? gfxCapture_->GetContext() : context_.get();
     }
 } // namespace SoulEngine
 
@@ -4,12 +4,13 @@
 #include <glad/glad.h>
 #include <memory>
 #include <deque>
+#include <cstdint>
 
 
 namespace SoulEngine
 {
     class IWindow;
-    namespace Gfx { class IDevice; class IContext; }
+    namespace Gfx { class IDevice; class IContext; class GfxGLDevice; }
 
     class OpenGLRenderer final : public Renderer
     {
@@ -32,10 +33,19 @@ namespace SoulEngine
         bool m_initialized = false;
         IWindow* m_window = nullptr;
 
-        std::shared_ptr<Gfx::IDevice> device_;
+        std::shared_ptr<Gfx::GfxGLDevice> device_;
         std::shared_ptr<Gfx::IContext> context_;
 
-        std::deque<GLsync> frameFences_;
+        struct FrameFence
+        {
+            GLsync sync;
+            uint64_t frameIndex;
+        };
+
+        std::deque<FrameFence> frameFences_;
+        uint64_t frameIndex_ = 0;
         bool forceSync_ = false;
+
+        void PopFrameFence();
     };
 } // namespace SoulEngine
@@ -2,6 +2,8 @@
 #include "Log/Logger.h"
 #if defined(SOULENGINE_ENABLE_OPENGL)
 #include "Renderer/OpenGL/OpenGLRenderer.h"
+#elif defined(SOULENGINE_ENABLE_SOFTWARE)
+#include "Renderer/Software/SoftwareRenderer.h"
 #endif
 
 namespace SoulEngine
@@ -18,6 +20,9 @@ namespace SoulEngine
 #if defined(SOULENGINE_ENABLE_OPENGL)
         Logger::Log("RendererFactory: creating OpenGL renderer");
         renderer_ = std::make_unique<OpenGLRenderer>();
+#elif defined(SOULENGINE_ENABLE_SOFTWARE)
+        Logger::Log("RendererFactory: creating software renderer");
+        renderer_ = std::make_unique<SoftwareRenderer>();
 #else
         Logger::Warn("RendererFactory: no renderer backend enabled. Returning nullptr");
 #endif
@@ -1,9 +1,12 @@
 #pragma once
+#include <memory>
 
 namespace SoulEngine {
     namespace Gfx {
         class IDevice;
         class IContext;
+        class GfxCapture;
+        struct GfxCaptureSettings;
     }
     
     /**
@@ -54,9 +57,21 @@ namespace SoulEngine {
         void SetMaxFramesInFlight(int maxFrames);
         int GetMaxFramesInFlight() const { return maxFramesInFlight; }
 
+        /**
+         * @brief 录制 Gfx 调用到文件，须在 Initialize 之前调用
+         * 之后 GetGfxDevice/GetGfxContext 返回录制包装，SwapBuffers 作为帧边界
+         */
+        void SetGfxCapture(const Gfx::GfxCaptureSettings& settings);
+        Gfx::GfxCapture* GetGfxCapture() const { return gfxCapture_.get(); }
+
     protected:
+        // Wraps the backend device/context when SetGfxCapture was called; for Initialize of derived renderers
+        void InstallGfxCapture(Gfx::IDevice* device, Gfx::IContext* context);
+
         bool flushGpu{true};
         int maxFramesInFlight{1};
+        std::shared_ptr<Gfx::GfxCaptureSettings> gfxCaptureSettings_;
+        std::shared_ptr<Gfx::GfxCapture> gfxCapture_;
     };
  
 } // namespace SoulEngine
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Renderer/Gfx.h"
+#include "Log/Logger.h"
+
+namespace SoulEngine::Gfx
+{
+    // System-memory buffer; Map hands out the storage directly since there is no GPU copy to sync with
+    class SWBuffer final : public IBuffer
+    {
+    public:
+        SWBuffer(const BufferDesc& desc, const SubresourceData* initial)
+            : desc_(desc), data_(desc.size, 0)
+        {
+            if (initial && initial->data)
+                Update(*initial);
+        }
+
+        const BufferDesc& GetDesc() const override { return desc_; }
+
+        void Update(const SubresourceData& src) override
+        {
+            if (!src.data)
+                return;
+            const std::size_t size = src.size ? src.size : desc_.size;
+            if (src.offset + size > data_.size())
+            {
+                Logger::Error("SWBuffer '{}': update of {} bytes at {} exceeds size {}",
+                              desc_.name ? desc_.name : "", size, src.offset, data_.size());
+                return;
+            }
+            std::memcpy(data_.data() + src.offset, src.data, size);
+        }
+
+        void* Map(MapMode) override { return data_.data(); }
+        void Unmap() override {}
+
+        const uint8_t* GetData() const { return data_.data(); }
+        std::size_t GetSize() const { return data_.size(); }
+
+    private:
+        BufferDesc desc_{};
+        std::vector<uint8_t> data_;
+    };
+
+    class SWVertexInputLayout final : public IVertexInputLayout
+    {
+    public:
+        SWVertexInputLayout(const VertexAttribute* attrs, uint32_t count)
+            : attributes_(attrs, attrs + count)
+        {
+        }
+
+        const std::vector<VertexAttribute>& GetAttributes() const { return attributes_; }
+
+    private:
+        std::vector<VertexAttribute> attributes_;
+    };
+
+    class SWPipelineState final : public IPipelineState
+    {
+    public:
+        SWPipelineState(const PipelineStateDesc& desc, std::size_t hash)
+            : desc_(desc), hash_(hash), name_(desc.name ? desc.name : "")
+        {
+            desc_.name = desc.name ? name_.c_str() : nullptr;
+        }
+
+        const PipelineStateDesc& GetDesc() const override { return desc_; }
+        std::size_t GetHash() const override { return hash_; }
+
+    private:
+        PipelineStateDesc desc_;
+        std::size_t hash_ = 0;
+        std::string name_;
+    };
+}
+
+#endif // SOULENGINE_ENABLE_SOFTWARE
@@ -0,0 +1,53 @@
+#pragma once
+
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+
+#include <cstdint>
+#include <cstring>
+#include "Renderer/Gfx.h"
+#include "Renderer/GfxPackedFormats.h"
+
+namespace SoulEngine::Gfx
+{
+    // Decodes one vertex attribute into float4, filling missing components with (0,0,0,1)
+    inline void SWFetchAttribute(DataFormat fmt, const uint8_t* src, float out[4])
+    {
+        DecodeVertexFormat(fmt, src, out);
+    }
+
+    // RGBA8 packed with R in the lowest byte, i.e. the glReadPixels(GL_RGBA, GL_UNSIGNED_BYTE) byte order
+    inline uint32_t SWPackColor(const float c[4])
+    {
+        uint32_t packed = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            const float v = c[i] < 0.0f ? 0.0f : (c[i] > 1.0f ? 1.0f : c[i]);
+            packed |= static_cast<uint32_t>(v * 255.0f + 0.5f) << (i * 8);
+        }
+        return packed;
+    }
+
+    inline void SWUnpackColor(uint32_t packed, float out[4])
+    {
+        for (int i = 0; i < 4; ++i)
+            out[i] = static_cast<float>((packed >> (i * 8)) & 0xFFu) * (1.0f / 255.0f);
+    }
+
+    inline bool SWDepthCompare(CompareFunc func, float fragment, float stored)
+    {
+        switch (func)
+        {
+        case CompareFunc::Never:        return false;
+        case CompareFunc::Less:         return fragment < stored;
+        case CompareFunc::Equal:        return fragment == stored;
+        case CompareFunc::LessEqual:    return fragment <= stored;
+        case CompareFunc::Greater:      return fragment > stored;
+        case CompareFunc::NotEqual:     return fragment != stored;
+        case CompareFunc::GreaterEqual: return fragment >= stored;
+        case CompareFunc::Always:       return true;
+        }
+        return true;
+    }
+}
+
+#endif // SOULENGINE_ENABLE_SOFTWARE
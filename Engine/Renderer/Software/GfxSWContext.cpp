@@ -0,0 +1,361 @@
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+
+#include "Renderer/Software/GfxSWContext.h"
+#include "Renderer/Software/GfxSWBuffer.h"
+#include "Renderer/Software/GfxSWCommon.h"
+#include "Renderer/Software/GfxSWShader.h"
+#include "Renderer/Software/GfxSWTexture.h"
+#include "Core/JobSystem.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace SoulEngine::Gfx
+{
+    namespace
+    {
+        // Bounds queued triangle/varying memory when a frame submits a lot of geometry
+        constexpr std::size_t kFlushTriangleThreshold = 1u << 18;
+        constexpr uint32_t kVertexGrain = 256;
+    }
+
+    GfxSWContext::GfxSWContext(uint32_t width, uint32_t height)
+    {
+        raster_.Resize(width, height);
+    }
+
+    void GfxSWContext::SetVertexBuffers(uint32_t startSlot, IBuffer* const* buffers, const uint32_t* strides, const uint32_t* offsets, uint32_t count)
+    {
+        if (vbSlots_.size() < startSlot + count)
+        {
+            vbSlots_.resize(startSlot + count, nullptr);
+            strides_.resize(startSlot + count, 0);
+            offsets_.resize(startSlot + count, 0);
+        }
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            vbSlots_[startSlot + i] = static_cast<SWBuffer*>(buffers[i]);
+            strides_[startSlot + i] = strides ? strides[i] : 0;
+            offsets_[startSlot + i] = offsets ? offsets[i] : 0;
+        }
+    }
+
+    void GfxSWContext::SetIndexBuffer(IBuffer* buffer, IndexFormat fmt)
+    {
+        indexBuffer_ = static_cast<SWBuffer*>(buffer);
+        indexFormat_ = fmt;
+    }
+
+    // Slots are shared by both stages, matching GL uniform buffer binding points
+    void GfxSWContext::SetConstantBuffer(uint32_t /*stage*/, uint32_t slot, IBuffer* buffer)
+    {
+        if (slot >= kSWMaxUniformBlocks)
+        {
+            Logger::Warn("GfxSWContext: constant buffer slot {} exceeds {}", slot, kSWMaxUniformBlocks);
+            return;
+        }
+        constantBuffers_[slot] = static_cast<SWBuffer*>(buffer);
+    }
+
+    void GfxSWContext::SetStorageBuffer(uint32_t slot, IBuffer* buffer)
+    {
+        if (slot >= kSWMaxStorageBuffers)
+        {
+            Logger::Warn("GfxSWContext: storage buffer slot {} exceeds {}", slot, kSWMaxStorageBuffers);
+            return;
+        }
+        storageBuffers_[slot] = static_cast<SWBuffer*>(buffer);
+    }
+
+    void GfxSWContext::SetTexture(uint32_t slot, ITexture* texture, ISampler* sampler)
+    {
+        if (slot >= kSWMaxTextures)
+        {
+            Logger::Warn("GfxSWContext: texture slot {} exceeds {}", slot, kSWMaxTextures);
+            return;
+        }
+        textures_[slot] = static_cast<SWTexture*>(texture);
+        samplers_[slot] = static_cast<SWSampler*>(sampler);
+    }
+
+    void GfxSWContext::SetVertexInputLayout(IVertexInputLayout* layout)
+    {
+        currentLayout_ = static_cast<SWVertexInputLayout*>(layout);
+    }
+
+    void GfxSWContext::BindProgram(IProgram* program)
+    {
+        currentProgram_ = static_cast<SWProgram*>(program);
+    }
+
+    // State is only captured at draw time, so applying a pipeline is plain assignment
+    void GfxSWContext::SetPipelineState(IPipelineState* pipeline)
+    {
+        if (!pipeline)
+            return;
+        const PipelineStateDesc& desc = pipeline->GetDesc();
+        if (desc.program)
+            currentProgram_ = static_cast<SWProgram*>(desc.program.get());
+        if (desc.inputLayout)
+            currentLayout_ = static_cast<SWVertexInputLayout*>(desc.inputLayout.get());
+        SetPolygonMode(desc.polygonMode);
+        state_.cullMode = desc.cullMode;
+        state_.blendMode = desc.blendMode;
+        state_.depthTest = desc.depthTest;
+        state_.depthWrite = desc.depthWrite;
+        state_.depthFunc = desc.depthFunc;
+    }
+
+    void GfxSWContext::SetPolygonMode(PolygonMode mode)
+    {
+        if (mode != PolygonMode::Fill && !warnedPolygonMode_)
+        {
+            Logger::Warn("GfxSWContext: only PolygonMode::Fill is rasterized, line/point modes draw filled");
+            warnedPolygonMode_ = true;
+        }
+        state_.polygonMode = mode;
+    }
+
+    void GfxSWContext::SetCullMode(CullMode mode) { state_.cullMode = mode; }
+    void GfxSWContext::SetBlendMode(BlendMode mode) { state_.blendMode = mode; }
+
+    void GfxSWContext::SetDepthTest(bool enable)
+    {
+        state_.depthTest = enable;
+        if (enable)
+            state_.depthFunc = CompareFunc::Less;
+    }
+
+    void GfxSWContext::SetScissorTest(bool enable, int x, int y, int width, int height)
+    {
+        scissorTest_ = enable;
+        scissor_[0] = x;
+        scissor_[1] = y;
+        scissor_[2] = width;
+        scissor_[3] = height;
+    }
+
+    void GfxSWContext::Draw(uint32_t vertexCount, uint32_t startVertex)
+    {
+        indexScratch_.resize(vertexCount);
+        for (uint32_t i = 0; i < vertexCount; ++i)
+            indexScratch_[i] = startVertex + i;
+        DrawTriangles(indexScratch_.data(), vertexCount, 0, 0);
+    }
+
+    void GfxSWContext::DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex)
+    {
+        DrawIndexedIndirectArgs args{};
+        args.indexCount = indexCount;
+        args.firstIndex = startIndex;
+        args.baseVertex = baseVertex;
+        DrawIndexedInstanced(args);
+    }
+
+    void GfxSWContext::DrawIndexedIndirect(IBuffer* argsBuffer, uint32_t byteOffset)
+    {
+        MultiDrawIndexedIndirect(argsBuffer, byteOffset, 1, sizeof(DrawIndexedIndirectArgs));
+    }
+
+    void GfxSWContext::MultiDrawIndexedIndirect(IBuffer* argsBuffer, uint32_t byteOffset, uint32_t drawCount, uint32_t stride)
+    {
+        auto* args = static_cast<SWBuffer*>(argsBuffer);
+        if (!args || drawCount == 0)
+            return;
+        if (stride == 0)
+            stride = sizeof(DrawIndexedIndirectArgs);
+
+        for (uint32_t i = 0; i < drawCount; ++i)
+        {
+            const std::size_t offset = static_cast<std::size_t>(byteOffset) + static_cast<std::size_t>(i) * stride;
+            if (offset + sizeof(DrawIndexedIndirectArgs) > args->GetSize())
+                break;
+            DrawIndexedIndirectArgs a{};
+            std::memcpy(&a, args->GetData() + offset, sizeof(a));
+            DrawIndexedInstanced(a);
+        }
+    }
+
+    void GfxSWContext::DrawIndexedInstanced(const DrawIndexedIndirectArgs& args)
+    {
+        if (!indexBuffer_ || args.indexCount == 0)
+            return;
+        const uint32_t indexSize = indexFormat_ == IndexFormat::UInt16 ? 2u : 4u;
+        const std::size_t first = static_cast<std::size_t>(args.firstIndex) * indexSize;
+        if (first + static_cast<std::size_t>(args.indexCount) * indexSize > indexBuffer_->GetSize())
+        {
+            Logger::Error("GfxSWContext: index range [{}, +{}) exceeds the index buffer", args.firstIndex, args.indexCount);
+            return;
+        }
+
+        indexScratch_.resize(args.indexCount);
+        const uint8_t* src = indexBuffer_->GetData() + first;
+        if (indexSize == 2)
+        {
+            for (uint32_t i = 0; i < args.indexCount; ++i)
+            {
+                uint16_t v;
+                std::memcpy(&v, src + i * 2, 2);
+                indexScratch_[i] = v;
+            }
+        }
+        else
+        {
+            std::memcpy(indexScratch_.data(), src, static_cast<std::size_t>(args.indexCount) * 4);
+        }
+
+        for (uint32_t instance = 0; instance < args.instanceCount; ++instance)
+            DrawTriangles(indexScratch_.data(), args.indexCount, args.baseVertex, args.baseInstance + instance);
+    }
+
+    void GfxSWContext::DrawTriangles(const uint32_t* indices, uint32_t indexCount, int32_t baseVertex, uint32_t instance)
+    {
+        if (!currentProgram_ || !currentProgram_->IsValid() || !currentLayout_)
+            return;
+        const uint32_t triangleCount = indexCount / 3;
+        if (triangleCount == 0)
+            return;
+
+        // Shade the referenced vertex range once, then assemble triangles from it
+        uint32_t minIndex = UINT32_MAX, maxIndex = 0;
+        for (uint32_t i = 0; i < triangleCount * 3; ++i)
+        {
+            minIndex = std::min(minIndex, indices[i]);
+            maxIndex = std::max(maxIndex, indices[i]);
+        }
+        const int64_t firstVertex = static_cast<int64_t>(minIndex) + baseVertex;
+        if (firstVertex < 0)
+        {
+            Logger::Error("GfxSWContext: negative vertex index after baseVertex {}", baseVertex);
+            return;
+        }
+        const uint32_t vertexCount = maxIndex - minIndex + 1;
+        vertexScratch_.resize(vertexCount);
+
+        struct AttributeStream
+        {
+            uint32_t location;
+            DataFormat format;
+            const uint8_t* base;
+            std::size_t size;
+            std::size_t offset;
+            uint32_t stride;
+            uint32_t stepRate;
+        };
+        std::vector<AttributeStream> streams;
+        for (const VertexAttribute& a : currentLayout_->GetAttributes())
+        {
+            if (a.location >= kSWMaxVertexAttributes || a.bindingSlot >= vbSlots_.size() || !vbSlots_[a.bindingSlot])
+                continue;
+            const SWBuffer* vb = vbSlots_[a.bindingSlot];
+            const uint32_t stride = strides_[a.bindingSlot] ? strides_[a.bindingSlot] : GetDataFormatSize(a.format);
+            streams.push_back({ a.location, a.format, vb->GetData(), vb->GetSize(),
+                                static_cast<std::size_t>(offsets_[a.bindingSlot]) + a.offset, stride, a.stepRate });
+        }
+
+        SWShaderResources vsResources;
+        const auto& vsUniforms = currentProgram_->GetStageUniforms(ShaderStage::Vertex);
+        vsResources.uniforms = vsUniforms.empty() ? nullptr : vsUniforms.data();
+        for (uint32_t i = 0; i < currentProgram_->GetBlockCount(ShaderStage::Vertex); ++i)
+        {
+            const uint32_t slot = currentProgram_->GetBlockSlot(ShaderStage::Vertex, i);
+            if (slot < kSWMaxUniformBlocks && constantBuffers_[slot])
+                vsResources.blocks[i] = constantBuffers_[slot]->GetData();
+        }
+        for (uint32_t slot = 0; slot < kSWMaxStorageBuffers; ++slot)
+            vsResources.storage[slot] = storageBuffers_[slot] ? storageBuffers_[slot]->GetData() : nullptr;
+        std::copy(std::begin(textures_), std::end(textures_), vsResources.textures);
+        std::copy(std::begin(samplers_), std::end(samplers_), vsResources.samplers);
+
+        const SWVertexShaderFn vertexFn = currentProgram_->GetVertexFn();
+        JobSystem::GetInstance().ParallelFor(vertexCount, kVertexGrain, [&](uint32_t begin, uint32_t end) {
+            float attributes[kSWMaxVertexAttributes][4];
+            for (uint32_t v = begin; v < end; ++v)
+            {
+                const std::size_t vertexIndex = static_cast<std::size_t>(firstVertex) + v;
+                for (const AttributeStream& s : streams)
+                {
+                    const std::size_t element = s.stepRate ? instance / s.stepRate : vertexIndex;
+                    const std::size_t offset = s.offset + element * s.stride;
+                    if (offset + GetDataFormatSize(s.format) <= s.size)
+                        SWFetchAttribute(s.format, s.base + offset, attributes[s.location]);
+                    else
+                        SWFetchAttribute(DataFormat::Unknown, nullptr, attributes[s.location]);
+                }
+                SWClipVertex& out = vertexScratch_[v];
+                vertexFn(vsResources, attributes, out.position, out.varyings);
+            }
+        });
+
+        // Fragment-stage uniforms and blocks are snapshotted because rasterization happens at Flush
+        SWDrawState drawState;
+        drawState.fragment = currentProgram_->GetFragmentFn();
+        drawState.varyingCount = currentProgram_->GetVaryingCount();
+        drawState.cullMode = state_.cullMode;
+        drawState.blendMode = state_.blendMode;
+        drawState.depthTest = state_.depthTest;
+        drawState.depthWrite = state_.depthWrite;
+        drawState.depthFunc = state_.depthFunc;
+        drawState.scissorTest = scissorTest_;
+        std::copy(std::begin(scissor_), std::end(scissor_), drawState.scissor);
+        std::copy(std::begin(vsResources.storage), std::end(vsResources.storage), drawState.storage);
+        std::copy(std::begin(textures_), std::end(textures_), drawState.textures);
+        std::copy(std::begin(samplers_), std::end(samplers_), drawState.samplers);
+
+        const uint8_t* blocks[kSWMaxUniformBlocks] = {};
+        std::size_t blockSizes[kSWMaxUniformBlocks] = {};
+        const uint32_t blockCount = currentProgram_->GetBlockCount(ShaderStage::Fragment);
+        for (uint32_t i = 0; i < blockCount; ++i)
+        {
+            const uint32_t slot = currentProgram_->GetBlockSlot(ShaderStage::Fragment, i);
+            if (slot < kSWMaxUniformBlocks && constantBuffers_[slot])
+            {
+                blocks[i] = constantBuffers_[slot]->GetData();
+                blockSizes[i] = constantBuffers_[slot]->GetSize();
+            }
+        }
+        const uint32_t drawIndex = raster_.BeginDraw(drawState, currentProgram_->GetStageUniforms(ShaderStage::Fragment),
+                                                     blocks, blockSizes, blockCount);
+
+        // Rebase indices onto the shaded range
+        std::vector<uint32_t> local(indices, indices + triangleCount * 3);
+        for (uint32_t& i : local)
+            i -= minIndex;
+        raster_.SubmitTriangles(drawIndex, vertexScratch_.data(), local.data(), triangleCount);
+
+        if (raster_.GetPendingTriangleCount() >= kFlushTriangleThreshold)
+            raster_.Flush();
+    }
+
+    void GfxSWContext::Clear(const float color[4], float depth)
+    {
+        raster_.Clear(color, depth);
+    }
+
+    void GfxSWContext::Flush()
+    {
+        raster_.Flush();
+    }
+
+    void GfxSWContext::Resize(uint32_t width, uint32_t height)
+    {
+        raster_.Resize(width, height);
+    }
+
+    void GfxSWContext::ReadColorBuffer(std::vector<uint8_t>& outRgba)
+    {
+        raster_.Flush();
+        const SWFramebuffer& fb = raster_.GetFramebuffer();
+        outRgba.resize(fb.color.size() * 4);
+        for (std::size_t i = 0; i < fb.color.size(); ++i)
+        {
+            const uint32_t c = fb.color[i];
+            outRgba[i * 4 + 0] = static_cast<uint8_t>(c & 0xFFu);
+            outRgba[i * 4 + 1] = static_cast<uint8_t>((c >> 8) & 0xFFu);
+            outRgba[i * 4 + 2] = static_cast<uint8_t>((c >> 16) & 0xFFu);
+            outRgba[i * 4 + 3] = static_cast<uint8_t>((c >> 24) & 0xFFu);
+        }
+    }
+}
+
+#endif // SOULENGINE_ENABLE_SOFTWARE
@@ -0,0 +1,91 @@
+#pragma once
+
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+
+#include "Renderer/Gfx.h"
+#include "Renderer/Software/GfxSWRasterizer.h"
+#include <cstdint>
+#include <vector>
+
+namespace SoulEngine::Gfx
+{
+    class SWBuffer;
+    class SWVertexInputLayout;
+    class SWProgram;
+    class SWPipelineState;
+
+    class GfxSWContext final : public IContext
+    {
+    public:
+        GfxSWContext(uint32_t width, uint32_t height);
+        ~GfxSWContext() override = default;
+
+        void SetVertexBuffers(uint32_t startSlot, IBuffer* const* buffers, const uint32_t* strides, const uint32_t* offsets, uint32_t count) override;
+        void SetIndexBuffer(IBuffer* buffer, IndexFormat fmt) override;
+        void SetConstantBuffer(uint32_t stage, uint32_t slot, IBuffer* buffer) override;
+        void SetStorageBuffer(uint32_t slot, IBuffer* buffer) override;
+        void SetTexture(uint32_t slot, ITexture* texture, ISampler* sampler) override;
+        void SetVertexInputLayout(IVertexInputLayout* layout) override;
+        void BindProgram(IProgram* program) override;
+        void SetPipelineState(IPipelineState* pipeline) override;
+
+        // 渲染状态设置
+        void SetPolygonMode(PolygonMode mode) override;
+        void SetCullMode(CullMode mode) override;
+        void SetBlendMode(BlendMode mode) override;
+        void SetDepthTest(bool enable) override;
+        void SetScissorTest(bool enable, int x = 0, int y = 0, int width = 0, int height = 0) override;
+
+        void Draw(uint32_t vertexCount, uint32_t startVertex) override;
+        void DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex) override;
+        void DrawIndexedIndirect(IBuffer* argsBuffer, uint32_t byteOffset) override;
+        void MultiDrawIndexedIndirect(IBuffer* argsBuffer, uint32_t byteOffset, uint32_t drawCount, uint32_t stride) override;
+
+        // Software-only entry points used by SoftwareRenderer
+        void Clear(const float color[4], float depth);
+        void Flush();
+        void Resize(uint32_t width, uint32_t height);
+        // Flushes pending triangles, then copies the color buffer as tightly packed RGBA8 rows, bottom row first
+        void ReadColorBuffer(std::vector<uint8_t>& outRgba);
+        const SWFramebuffer& GetFramebuffer() const { return raster_.GetFramebuffer(); }
+        const SWRasterStats& GetStats() const { return raster_.GetStats(); }
+        void ResetStats() { raster_.ResetStats(); }
+
+    private:
+        struct FixedFunctionState
+        {
+            PolygonMode polygonMode = PolygonMode::Fill;
+            CullMode    cullMode    = CullMode::None;
+            BlendMode   blendMode   = BlendMode::None;
+            bool        depthTest   = false;
+            bool        depthWrite  = true;
+            CompareFunc depthFunc   = CompareFunc::Less;
+        };
+
+        void DrawTriangles(const uint32_t* indices, uint32_t indexCount, int32_t baseVertex, uint32_t instance);
+        void DrawIndexedInstanced(const DrawIndexedIndirectArgs& args);
+
+        SWRasterizer raster_;
+        FixedFunctionState state_{};
+        bool scissorTest_ = false;
+        int32_t scissor_[4] = {};
+        SWProgram* currentProgram_ = nullptr;
+        SWVertexInputLayout* currentLayout_ = nullptr;
+        std::vector<SWBuffer*> vbSlots_;
+        std::vector<uint32_t> strides_;
+        std::vector<uint32_t> offsets_;
+        SWBuffer* indexBuffer_ = nullptr;
+        IndexFormat indexFormat_ = IndexFormat::UInt32;
+        SWBuffer* constantBuffers_[kSWMaxUniformBlocks] = {};
+        SWBuffer* storageBuffers_[kSWMaxStorageBuffers] = {};
+        SWTexture* textures_[kSWMaxTextures] = {};
+        SWSampler* samplers_[kSWMaxTextures] = {};
+
+        // Scratch reused across draws
+        std::vector<uint32_t> indexScratch_;
+        std::vector<SWClipVertex> vertexScratch_;
+        bool warnedPolygonMode_ = false;
+    };
+}
+
+#endif // SOULENGINE_ENABLE_SOFTWARE
@@ -0,0 +1,89 @@
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+
+#include "Renderer/Software/GfxSWDevice.h"
+#include "Renderer/Software/GfxSWBuffer.h"
+#include "Renderer/Software/GfxSWTexture.h"
+#include "Log/Logger.h"
+
+namespace SoulEngine::Gfx
+{
+    GfxSWDevice::~GfxSWDevice()
+    {
+        pipelineCache_.Clear();
+    }
+
+    std::shared_ptr<IBuffer> GfxSWDevice::CreateBuffer(const BufferDesc& desc, const SubresourceData* initial)
+    {
+        return std::make_shared<SWBuffer>(desc, initial);
+    }
+
+    std::shared_ptr<IVertexInputLayout> GfxSWDevice::CreateVertexInputLayout(const VertexAttribute* attrs, uint32_t count)
+    {
+        return std::make_shared<SWVertexInputLayout>(attrs, count);
+    }
+
+    std::shared_ptr<IShaderModule> GfxSWDevice::CreateShaderModule(const ShaderDesc& desc)
+    {
+        const char* key = desc.entryPoint ? desc.entryPoint : desc.name;
+        SWShaderDesc swDesc;
+        if (!key || !SWShaderLibrary::GetInstance().Find(key, swDesc))
+        {
+            Logger::Error("GfxSWDevice: no software shader registered for '{}'", key ? key : "<null>");
+            return nullptr;
+        }
+        if (swDesc.stage != desc.stage)
+            Logger::Warn("GfxSWDevice: software shader '{}' registered for a different stage", key);
+        return CreateShaderModule(swDesc, desc.name);
+    }
+
+    std::shared_ptr<IShaderModule> GfxSWDevice::CreateShaderModule(const SWShaderDesc& desc, const char* name)
+    {
+        return std::make_shared<SWShaderModule>(desc, name);
+    }
+
+    std::shared_ptr<IProgram> GfxSWDevice::CreateProgram(const std::shared_ptr<IShaderModule>& vs,
+                                                         const std::shared_ptr<IShaderModule>& fs,
+                                                         const char* name)
+    {
+        auto swvs = std::static_pointer_cast<SWShaderModule>(vs);
+        auto swfs = std::static_pointer_cast<SWShaderModule>(fs);
+        return std::make_shared<SWProgram>(swvs, swfs, name);
+    }
+
+    std::shared_ptr<IPipelineState> GfxSWDevice::CreatePipelineState(const PipelineStateDesc& desc)
+    {
+        return pipelineCache_.GetOrCreate(desc, [](const PipelineStateDesc& d, std::size_t hash) {
+            return std::make_shared<SWPipelineState>(d, hash);
+        });
+    }
+
+    std::size_t GfxSWDevice::TrimPipelineStates()
+    {
+        return pipelineCache_.Trim();
+    }
+
+    std::shared_ptr<ITexture> GfxSWDevice::CreateTexture(const TextureDesc& desc, const SubresourceData* initial)
+    {
+        if (!SWTexture::CanSample(desc.format))
+        {
+            Logger::Error("GfxSWDevice: texture '{}' uses a format the software backend cannot sample ({})",
+                          desc.name ? desc.name : "", static_cast<int>(desc.format));
+            return nullptr;
+        }
+        return std::make_shared<SWTexture>(desc, initial);
+    }
+
+    std::shared_ptr<ISampler> GfxSWDevice::CreateSampler(const SamplerDesc& desc)
+    {
+        for (const auto& entry : samplers_)
+        {
+            if (entry.first == desc)
+                return entry.second;
+        }
+        auto sampler = std::make_shared<SWSampler>(desc);
+        samplers_.emplace_back(desc, sampler);
+        return sampler;
+    }
+}
+
+#endif // SOULENGINE_ENABLE_SOFTWARE
@@ -0,0 +1,41 @@
+#pragma once
+
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include "Renderer/Gfx.h"
+#include "Renderer/GfxPipelineCache.h"
+#include "Renderer/Software/GfxSWShader.h"
+
+namespace SoulEngine::Gfx
+{
+    class GfxSWDevice final : public IDevice
+    {
+    public:
+        GfxSWDevice() = default;
+        ~GfxSWDevice() override;
+
+        std::shared_ptr<IBuffer> CreateBuffer(const BufferDesc& desc, const SubresourceData* initial) override;
+        std::shared_ptr<IVertexInputLayout> CreateVertexInputLayout(const VertexAttribute* attrs, uint32_t count) override;
+        // Looks the stage up in SWShaderLibrary by entryPoint, falling back to name; source is ignored
+        std::shared_ptr<IShaderModule> CreateShaderModule(const ShaderDesc& desc) override;
+        std::shared_ptr<IShaderModule> CreateShaderModule(const SWShaderDesc& desc, const char* name = nullptr);
+        std::shared_ptr<IProgram> CreateProgram(const std::shared_ptr<IShaderModule>& vs,
+                                               const std::shared_ptr<IShaderModule>& fs,
+                                               const char* name = nullptr) override;
+        std::shared_ptr<IPipelineState> CreatePipelineState(const PipelineStateDesc& desc) override;
+        std::size_t TrimPipelineStates() override;
+        std::shared_ptr<ITexture> CreateTexture(const TextureDesc& desc, const SubresourceData* initial) override;
+        std::shared_ptr<ISampler> CreateSampler(const SamplerDesc& desc) override;
+
+        const PipelineStateCache& GetPipelineCache() const { return pipelineCache_; }
+
+    private:
+        PipelineStateCache pipelineCache_;
+        std::vector<std::pair<SamplerDesc, std::shared_ptr<ISampler>>> samplers_;
+    };
+}
+
+#endif // SOULENGINE_ENABLE_SOFTWARE
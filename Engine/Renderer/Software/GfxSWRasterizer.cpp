@@ -0,0 +1,579 @@
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+
+#include "Renderer/Software/GfxSWRasterizer.h"
+#include "Renderer/Software/GfxSWCommon.h"
+#include "Core/JobSystem.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SOULENGINE_SW_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOULENGINE_SW_SSE2 1
+#endif
+
+namespace SoulEngine::Gfx
+{
+    namespace
+    {
+        constexpr float kNearW = 1e-5f;
+        constexpr float kGuardBandPixels = 8192.0f;
+        constexpr uint32_t kClipPlaneCount = 7;
+        constexpr uint32_t kMaxClipVertices = 3 + kClipPlaneCount;
+        constexpr uint32_t kSetupGrain = 512;
+
+        // Signed distance to the w > 0, near, far and four guard-band planes; inside is >= 0
+        float ClipDistance(uint32_t plane, const float* p, float gx, float gy)
+        {
+            switch (plane)
+            {
+            case 0: return p[3] - kNearW;
+            case 1: return p[3] + p[2];
+            case 2: return p[3] - p[2];
+            case 3: return gx * p[3] - p[0];
+            case 4: return gx * p[3] + p[0];
+            case 5: return gy * p[3] - p[1];
+            default: return gy * p[3] + p[1];
+            }
+        }
+
+        uint32_t ClipOutcode(const float* p, float gx, float gy)
+        {
+            uint32_t code = 0;
+            for (uint32_t plane = 0; plane < kClipPlaneCount; ++plane)
+                code |= ClipDistance(plane, p, gx, gy) < 0.0f ? (1u << plane) : 0u;
+            return code;
+        }
+
+        int32_t FloorDiv16(int32_t v) { return v >= 0 ? v / 16 : -((-v + 15) / 16); }
+        int32_t CeilDiv16(int32_t v) { return -FloorDiv16(-v); }
+
+#if defined(SOULENGINE_SW_AVX2)
+        constexpr int32_t kLanes = 8;
+        struct EdgeLanes
+        {
+            __m256i value, step;
+            void Init(int32_t rowValue, int32_t stepX)
+            {
+                value = _mm256_add_epi32(_mm256_set1_epi32(rowValue),
+                                         _mm256_setr_epi32(0, stepX, 2 * stepX, 3 * stepX, 4 * stepX, 5 * stepX, 6 * stepX, 7 * stepX));
+                step = _mm256_set1_epi32(stepX * kLanes);
+            }
+            uint32_t Mask() const
+            {
+                return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(value, _mm256_set1_epi32(-1)))));
+            }
+            void Advance() { value = _mm256_add_epi32(value, step); }
+        };
+#elif defined(SOULENGINE_SW_SSE2)
+        constexpr int32_t kLanes = 4;
+        struct EdgeLanes
+        {
+            __m128i value, step;
+            void Init(int32_t rowValue, int32_t stepX)
+            {
+                value = _mm_add_epi32(_mm_set1_epi32(rowValue), _mm_setr_epi32(0, stepX, 2 * stepX, 3 * stepX));
+                step = _mm_set1_epi32(stepX * kLanes);
+            }
+            uint32_t Mask() const
+            {
+                return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(value, _mm_set1_epi32(-1)))));
+            }
+            void Advance() { value = _mm_add_epi32(value, step); }
+        };
+#else
+        constexpr int32_t kLanes = 4;
+        struct EdgeLanes
+        {
+            int32_t value[kLanes];
+            int32_t step;
+            void Init(int32_t rowValue, int32_t stepX)
+            {
+                for (int32_t i = 0; i < kLanes; ++i)
+                    value[i] = rowValue + i * stepX;
+                step = stepX * kLanes;
+            }
+            uint32_t Mask() const
+            {
+                uint32_t mask = 0;
+                for (int32_t i = 0; i < kLanes; ++i)
+                    mask |= value[i] >= 0 ? (1u << i) : 0u;
+                return mask;
+            }
+            void Advance()
+            {
+                for (int32_t i = 0; i < kLanes; ++i)
+                    value[i] += step;
+            }
+        };
+#endif
+        constexpr uint32_t kFullLaneMask = (1u << kLanes) - 1;
+    }
+
+    void SWRasterizer::Resize(uint32_t width, uint32_t height)
+    {
+        if (width > kSWMaxFramebufferSize || height > kSWMaxFramebufferSize)
+        {
+            Logger::Warn("SWRasterizer: {}x{} exceeds the {} limit, clamping", width, height, kSWMaxFramebufferSize);
+            width = std::min(width, kSWMaxFramebufferSize);
+            height = std::min(height, kSWMaxFramebufferSize);
+        }
+        width = std::max(width, 1u);
+        height = std::max(height, 1u);
+
+        triangles_.clear();
+        planes_.clear();
+        draws_.clear();
+        uniformArena_.clear();
+        blockArena_.clear();
+
+        framebuffer_.width = width;
+        framebuffer_.height = height;
+        framebuffer_.color.assign(static_cast<std::size_t>(width) * height, 0u);
+        framebuffer_.depth.assign(static_cast<std::size_t>(width) * height, 1.0f);
+
+        tilesX_ = (width + kSWTileSize - 1) / kSWTileSize;
+        tilesY_ = (height + kSWTileSize - 1) / kSWTileSize;
+        bins_.assign(static_cast<std::size_t>(tilesX_) * tilesY_, {});
+
+        // Guard band of +-kGuardBandPixels around the viewport centre, in NDC units
+        guardBandX_ = 2.0f * kGuardBandPixels / static_cast<float>(width) - 1.0f;
+        guardBandY_ = 2.0f * kGuardBandPixels / static_cast<float>(height) - 1.0f;
+    }
+
+    uint32_t SWRasterizer::BeginDraw(const SWDrawState& state, const std::vector<float>& uniforms,
+                                     const uint8_t* const* blocks, const std::size_t* blockSizes, uint32_t blockCount)
+    {
+        Draw draw;
+        draw.state = state;
+        draw.state.varyingCount = std::min(state.varyingCount, kSWMaxVaryings);
+        draw.uniformOffset = static_cast<uint32_t>(uniformArena_.size());
+        uniformArena_.insert(uniformArena_.end(), uniforms.begin(), uniforms.end());
+
+        draw.blockCount = std::min(blockCount, kSWMaxUniformBlocks);
+        for (uint32_t i = 0; i < draw.blockCount; ++i)
+        {
+            if (!blocks[i])
+            {
+                draw.blockOffsets[i] = UINT32_MAX;
+                continue;
+            }
+            // 16-byte aligned so shaders can read vec4/mat4 blocks in place
+            const std::size_t offset = (blockArena_.size() + 15) & ~std::size_t(15);
+            blockArena_.resize(offset + blockSizes[i]);
+            std::memcpy(blockArena_.data() + offset, blocks[i], blockSizes[i]);
+            draw.blockOffsets[i] = static_cast<uint32_t>(offset);
+        }
+
+        draws_.push_back(draw);
+        return static_cast<uint32_t>(draws_.size() - 1);
+    }
+
+    void SWRasterizer::SubmitTriangles(uint32_t drawIndex, const SWClipVertex* vertices, const uint32_t* indices, uint32_t triangleCount)
+    {
+        if (triangleCount == 0)
+            return;
+        stats_.trianglesSubmitted += triangleCount;
+
+        const Draw& draw = draws_[drawIndex];
+        const uint32_t chunkCount = (triangleCount + kSetupGrain - 1) / kSetupGrain;
+        std::vector<SetupOutput> outputs(chunkCount);
+
+        JobSystem::GetInstance().ParallelFor(triangleCount, kSetupGrain, [&](uint32_t begin, uint32_t end) {
+            SetupOutput& out = outputs[begin / kSetupGrain];
+            for (uint32_t t = begin; t < end; ++t)
+            {
+                SetupTriangle(draw, drawIndex, &vertices[indices[t * 3 + 0]], &vertices[indices[t * 3 + 1]],
+                              &vertices[indices[t * 3 + 2]], out);
+            }
+        });
+
+        // Concatenate in submission order so blending and equal-depth ties match the draw order
+        for (SetupOutput& out : outputs)
+        {
+            const uint32_t planeBase = static_cast<uint32_t>(planes_.size());
+            for (Triangle& tri : out.triangles)
+            {
+                tri.varyingOffset += planeBase;
+                triangles_.push_back(tri);
+            }
+            planes_.insert(planes_.end(), out.planes.begin(), out.planes.end());
+            stats_.trianglesCulled += out.culled;
+            stats_.trianglesClipped += out.clipped;
+        }
+    }
+
+    void SWRasterizer::SetupTriangle(const Draw& draw, uint32_t drawIndex, const SWClipVertex* v0, const SWClipVertex* v1,
+                                     const SWClipVertex* v2, SetupOutput& out) const
+    {
+        const uint32_t c0 = ClipOutcode(v0->position, guardBandX_, guardBandY_);
+        const uint32_t c1 = ClipOutcode(v1->position, guardBandX_, guardBandY_);
+        const uint32_t c2 = ClipOutcode(v2->position, guardBandX_, guardBandY_);
+        if (c0 & c1 & c2)
+        {
+            ++out.culled;
+            return;
+        }
+        if ((c0 | c1 | c2) == 0)
+        {
+            const SWClipVertex* tri[3] = { v0, v1, v2 };
+            EmitTriangle(draw, drawIndex, tri, out);
+            return;
+        }
+
+        // Sutherland-Hodgman against the planes the triangle actually crosses
+        ++out.clipped;
+        const uint32_t varyingCount = draw.state.varyingCount;
+        SWClipVertex bufferA[kMaxClipVertices];
+        SWClipVertex bufferB[kMaxClipVertices];
+        SWClipVertex* in = bufferA;
+        SWClipVertex* outPoly = bufferB;
+        uint32_t count = 3;
+        in[0] = *v0;
+        in[1] = *v1;
+        in[2] = *v2;
+
+        const uint32_t crossed = c0 | c1 | c2;
+        for (uint32_t plane = 0; plane < kClipPlaneCount && count >= 3; ++plane)
+        {
+            if (!(crossed & (1u << plane)))
+                continue;
+            uint32_t outCount = 0;
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const SWClipVertex& a = in[i];
+                const SWClipVertex& b = in[(i + 1) % count];
+                const float da = ClipDistance(plane, a.position, guardBandX_, guardBandY_);
+                const float db = ClipDistance(plane, b.position, guardBandX_, guardBandY_);
+                if (da >= 0.0f)
+                    outPoly[outCount++] = a;
+                if ((da >= 0.0f) != (db >= 0.0f) && outCount < kMaxClipVertices)
+                {
+                    const float t = da / (da - db);
+                    SWClipVertex& v = outPoly[outCount++];
+                    for (int c = 0; c < 4; ++c)
+                        v.position[c] = a.position[c] + (b.position[c] - a.position[c]) * t;
+                    for (uint32_t k = 0; k < varyingCount; ++k)
+                        v.varyings[k] = a.varyings[k] + (b.varyings[k] - a.varyings[k]) * t;
+                }
+            }
+            std::swap(in, outPoly);
+            count = outCount;
+        }
+
+        if (count < 3)
+        {
+            ++out.culled;
+            return;
+        }
+        for (uint32_t i = 1; i + 1 < count; ++i)
+        {
+            const SWClipVertex* tri[3] = { &in[0], &in[i], &in[i + 1] };
+            EmitTriangle(draw, drawIndex, tri, out);
+        }
+    }
+
+    void SWRasterizer::EmitTriangle(const Draw& draw, uint32_t drawIndex, const SWClipVertex* const v[3], SetupOutput& out) const
+    {
+        const float width = static_cast<float>(framebuffer_.width);
+        const float height = static_cast<float>(framebuffer_.height);
+
+        int32_t x[3], y[3];
+        float z[3], invW[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            invW[i] = 1.0f / v[i]->position[3];
+            const float sx = (v[i]->position[0] * invW[i] * 0.5f + 0.5f) * width;
+            const float sy = (v[i]->position[1] * invW[i] * 0.5f + 0.5f) * height;
+            z[i] = v[i]->position[2] * invW[i] * 0.5f + 0.5f;
+            x[i] = static_cast<int32_t>(std::lrint(sx * 16.0f));
+            y[i] = static_cast<int32_t>(std::lrint(sy * 16.0f));
+        }
+
+        int64_t area = static_cast<int64_t>(x[1] - x[0]) * (y[2] - y[0]) - static_cast<int64_t>(x[2] - x[0]) * (y[1] - y[0]);
+        const bool counterClockwise = area > 0;
+        if (area == 0 ||
+            (draw.state.cullMode == CullMode::Back && !counterClockwise) ||
+            (draw.state.cullMode == CullMode::Front && counterClockwise))
+        {
+            ++out.culled;
+            return;
+        }
+
+        // Normalise to counter-clockwise so all edge functions are positive inside
+        int order[3] = { 0, 1, 2 };
+        if (!counterClockwise)
+            std::swap(order[1], order[2]);
+
+        Triangle tri{};
+        for (int i = 0; i < 3; ++i)
+        {
+            tri.x[i] = x[order[i]];
+            tri.y[i] = y[order[i]];
+        }
+
+        const int32_t minXf = std::min({ tri.x[0], tri.x[1], tri.x[2] });
+        const int32_t maxXf = std::max({ tri.x[0], tri.x[1], tri.x[2] });
+        const int32_t minYf = std::min({ tri.y[0], tri.y[1], tri.y[2] });
+        const int32_t maxYf = std::max({ tri.y[0], tri.y[1], tri.y[2] });
+        // Pixel centres sit at +8 in 28.4
+        int32_t minX = std::max(CeilDiv16(minXf - 8), 0);
+        int32_t minY = std::max(CeilDiv16(minYf - 8), 0);
+        int32_t maxX = std::min(FloorDiv16(maxXf - 8) + 1, static_cast<int32_t>(framebuffer_.width));
+        int32_t maxY = std::min(FloorDiv16(maxYf - 8) + 1, static_cast<int32_t>(framebuffer_.height));
+        if (draw.state.scissorTest)
+        {
+            minX = std::max(minX, draw.state.scissor[0]);
+            minY = std::max(minY, draw.state.scissor[1]);
+            maxX = std::min(maxX, draw.state.scissor[0] + draw.state.scissor[2]);
+            maxY = std::min(maxY, draw.state.scissor[1] + draw.state.scissor[3]);
+        }
+        if (minX >= maxX || minY >= maxY)
+        {
+            ++out.culled;
+            return;
+        }
+        tri.minX = minX;
+        tri.minY = minY;
+        tri.maxX = maxX;
+        tri.maxY = maxY;
+
+        // Attribute planes a(x, y) = a0 + dadx * (x - ox) + dady * (y - oy), using the snapped positions
+        const float fx0 = tri.x[0] / 16.0f, fy0 = tri.y[0] / 16.0f;
+        const float dx1 = tri.x[1] / 16.0f - fx0, dy1 = tri.y[1] / 16.0f - fy0;
+        const float dx2 = tri.x[2] / 16.0f - fx0, dy2 = tri.y[2] / 16.0f - fy0;
+        const float invArea = 1.0f / (dx1 * dy2 - dx2 * dy1);
+        auto makePlane = [&](float a0, float a1, float a2, float* plane) {
+            const float da1 = a1 - a0, da2 = a2 - a0;
+            plane[0] = a0;
+            plane[1] = (da1 * dy2 - da2 * dy1) * invArea;
+            plane[2] = (da2 * dx1 - da1 * dx2) * invArea;
+        };
+        tri.ox = fx0;
+        tri.oy = fy0;
+        makePlane(z[order[0]], z[order[1]], z[order[2]], tri.z);
+        makePlane(invW[order[0]], invW[order[1]], invW[order[2]], tri.invW);
+
+        tri.varyingOffset = static_cast<uint32_t>(out.planes.size());
+        tri.drawIndex = drawIndex;
+        const uint32_t varyingCount = draw.state.varyingCount;
+        out.planes.resize(out.planes.size() + varyingCount * 3);
+        float* plane = out.planes.data() + tri.varyingOffset;
+        for (uint32_t k = 0; k < varyingCount; ++k, plane += 3)
+        {
+            makePlane(v[order[0]]->varyings[k] * invW[order[0]],
+                      v[order[1]]->varyings[k] * invW[order[1]],
+                      v[order[2]]->varyings[k] * invW[order[2]], plane);
+        }
+
+        out.triangles.push_back(tri);
+    }
+
+    void SWRasterizer::Flush()
+    {
+        if (triangles_.empty())
+        {
+            draws_.clear();
+            uniformArena_.clear();
+            blockArena_.clear();
+            return;
+        }
+        ++stats_.flushes;
+
+        for (Draw& draw : draws_)
+        {
+            draw.resources = SWShaderResources{};
+            draw.resources.uniforms = uniformArena_.empty() ? nullptr : uniformArena_.data() + draw.uniformOffset;
+            std::copy(std::begin(draw.state.storage), std::end(draw.state.storage), draw.resources.storage);
+            std::copy(std::begin(draw.state.textures), std::end(draw.state.textures), draw.resources.textures);
+            std::copy(std::begin(draw.state.samplers), std::end(draw.state.samplers), draw.resources.samplers);
+            for (uint32_t i = 0; i < draw.blockCount; ++i)
+            {
+                if (draw.blockOffsets[i] != UINT32_MAX)
+                    draw.resources.blocks[i] = blockArena_.data() + draw.blockOffsets[i];
+            }
+        }
+
+        // Binning is serial so every bin keeps submission order
+        for (auto& bin : bins_)
+            bin.clear();
+        for (uint32_t i = 0; i < triangles_.size(); ++i)
+        {
+            const Triangle& tri = triangles_[i];
+            const uint32_t tx0 = static_cast<uint32_t>(tri.minX) / kSWTileSize;
+            const uint32_t tx1 = static_cast<uint32_t>(tri.maxX - 1) / kSWTileSize;
+            const uint32_t ty0 = static_cast<uint32_t>(tri.minY) / kSWTileSize;
+            const uint32_t ty1 = static_cast<uint32_t>(tri.maxY - 1) / kSWTileSize;
+            for (uint32_t ty = ty0; ty <= ty1; ++ty)
+                for (uint32_t tx = tx0; tx <= tx1; ++tx)
+                    bins_[ty * tilesX_ + tx].push_back(i);
+            stats_.binEntries += static_cast<uint64_t>(tx1 - tx0 + 1) * (ty1 - ty0 + 1);
+        }
+        stats_.trianglesBinned += triangles_.size();
+
+        std::vector<uint32_t> activeTiles;
+        for (uint32_t t = 0; t < bins_.size(); ++t)
+        {
+            if (!bins_[t].empty())
+                activeTiles.push_back(t);
+        }
+        stats_.tilesRasterized += activeTiles.size();
+
+        std::atomic<uint64_t> fragments{ 0 };
+        JobSystem::GetInstance().ParallelFor(static_cast<uint32_t>(activeTiles.size()), 1, [&](uint32_t begin, uint32_t end) {
+            uint64_t local = 0;
+            for (uint32_t i = begin; i < end; ++i)
+                local += RasterizeTile(activeTiles[i]);
+            fragments.fetch_add(local, std::memory_order_relaxed);
+        });
+        stats_.fragmentsShaded += fragments.load();
+
+        triangles_.clear();
+        planes_.clear();
+        draws_.clear();
+        uniformArena_.clear();
+        blockArena_.clear();
+    }
+
+    uint64_t SWRasterizer::RasterizeTile(uint32_t tileIndex)
+    {
+        const int32_t fbWidth = static_cast<int32_t>(framebuffer_.width);
+        const int32_t tileX0 = static_cast<int32_t>((tileIndex % tilesX_) * kSWTileSize);
+        const int32_t tileY0 = static_cast<int32_t>((tileIndex / tilesX_) * kSWTileSize);
+        const int32_t tileX1 = std::min(tileX0 + static_cast<int32_t>(kSWTileSize), fbWidth);
+        const int32_t tileY1 = std::min(tileY0 + static_cast<int32_t>(kSWTileSize), static_cast<int32_t>(framebuffer_.height));
+        uint32_t* color = framebuffer_.color.data();
+        float* depth = framebuffer_.depth.data();
+        uint64_t shaded = 0;
+
+        for (uint32_t triIndex : bins_[tileIndex])
+        {
+            const Triangle& tri = triangles_[triIndex];
+            const Draw& draw = draws_[tri.drawIndex];
+            const SWDrawState& st = draw.state;
+
+            const int32_t rx0 = std::max(tri.minX, tileX0), rx1 = std::min(tri.maxX, tileX1);
+            const int32_t ry0 = std::max(tri.minY, tileY0), ry1 = std::min(tri.maxY, tileY1);
+            if (rx0 >= rx1 || ry0 >= ry1)
+                continue;
+
+            // Edge functions at the first pixel centre; the top-left rule is folded into a -1 bias
+            int32_t rowValue[3], stepX[3], stepY[3];
+            uint32_t partialCount = 0;
+            bool rejected = false;
+            for (int k = 0; k < 3 && !rejected; ++k)
+            {
+                const int32_t ax = tri.x[k], ay = tri.y[k];
+                const int32_t bx = tri.x[(k + 1) % 3], by = tri.y[(k + 1) % 3];
+                const int32_t dx = bx - ax, dy = by - ay;
+                const bool topLeft = dy < 0 || (dy == 0 && dx < 0);
+                const int64_t px = static_cast<int64_t>(rx0) * 16 + 8 - ax;
+                const int64_t py = static_cast<int64_t>(ry0) * 16 + 8 - ay;
+                const int64_t e = static_cast<int64_t>(dx) * py - static_cast<int64_t>(dy) * px + (topLeft ? 0 : -1);
+                const int64_t sx = -static_cast<int64_t>(dy) * 16;
+                const int64_t sy = static_cast<int64_t>(dx) * 16;
+
+                const int64_t spanX = sx * (rx1 - rx0 - 1);
+                const int64_t spanY = sy * (ry1 - ry0 - 1);
+                const int64_t corners[4] = { e, e + spanX, e + spanY, e + spanX + spanY };
+                const int64_t lo = std::min({ corners[0], corners[1], corners[2], corners[3] });
+                const int64_t hi = std::max({ corners[0], corners[1], corners[2], corners[3] });
+                if (hi < 0)
+                    rejected = true;
+                else if (lo < 0)
+                {
+                    // Edges crossing the rect are bounded by the guard band, so 32-bit lanes suffice
+                    rowValue[partialCount] = static_cast<int32_t>(e);
+                    stepX[partialCount] = static_cast<int32_t>(sx);
+                    stepY[partialCount] = static_cast<int32_t>(sy);
+                    ++partialCount;
+                }
+            }
+            if (rejected)
+                continue;
+
+            const float* varyingPlanes = planes_.data() + tri.varyingOffset;
+            auto shadePixel = [&](int32_t x, int32_t y) {
+                const std::size_t idx = static_cast<std::size_t>(y) * fbWidth + x;
+                const float fx = static_cast<float>(x) + 0.5f - tri.ox;
+                const float fy = static_cast<float>(y) + 0.5f - tri.oy;
+                float z = tri.z[0] + tri.z[1] * fx + tri.z[2] * fy;
+                z = z < 0.0f ? 0.0f : (z > 1.0f ? 1.0f : z);
+                if (st.depthTest && !SWDepthCompare(st.depthFunc, z, depth[idx]))
+                    return;
+
+                const float w = 1.0f / (tri.invW[0] + tri.invW[1] * fx + tri.invW[2] * fy);
+                float varyings[kSWMaxVaryings];
+                for (uint32_t k = 0; k < st.varyingCount; ++k)
+                {
+                    const float* p = varyingPlanes + k * 3;
+                    varyings[k] = (p[0] + p[1] * fx + p[2] * fy) * w;
+                }
+
+                float out[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+                if (!st.fragment(draw.resources, varyings, out))
+                    return;
+                ++shaded;
+
+                if (st.blendMode != BlendMode::None)
+                {
+                    float dst[4];
+                    SWUnpackColor(color[idx], dst);
+                    const float srcAlpha = out[3] < 0.0f ? 0.0f : (out[3] > 1.0f ? 1.0f : out[3]);
+                    const float dstFactor = st.blendMode == BlendMode::Alpha ? 1.0f - srcAlpha : 1.0f;
+                    for (int c = 0; c < 4; ++c)
+                        out[c] = out[c] * srcAlpha + dst[c] * dstFactor;
+                }
+                color[idx] = SWPackColor(out);
+                if (st.depthTest && st.depthWrite)
+                    depth[idx] = z;
+            };
+
+            for (int32_t y = ry0; y < ry1; ++y)
+            {
+                EdgeLanes lanes[3];
+                for (uint32_t k = 0; k < partialCount; ++k)
+                    lanes[k].Init(rowValue[k], stepX[k]);
+
+                for (int32_t x = rx0; x < rx1; x += kLanes)
+                {
+                    uint32_t mask = x + kLanes <= rx1 ? kFullLaneMask : (1u << (rx1 - x)) - 1;
+                    for (uint32_t k = 0; k < partialCount; ++k)
+                    {
+                        mask &= lanes[k].Mask();
+                        lanes[k].Advance();
+                    }
+                    for (int32_t lane = 0; mask; ++lane, mask >>= 1)
+                    {
+                        if (mask & 1u)
+                            shadePixel(x + lane, y);
+                    }
+                }
+
+                for (uint32_t k = 0; k < partialCount; ++k)
+                    rowValue[k] += stepY[k];
+            }
+        }
+        return shaded;
+    }
+
+    void SWRasterizer::Clear(const float color[4], float depth)
+    {
+        Flush();
+        const uint32_t packed = SWPackColor(color);
+        const uint32_t width = framebuffer_.width;
+        JobSystem::GetInstance().ParallelFor(framebuffer_.height, 32, [&](uint32_t begin, uint32_t end) {
+            const std::size_t first = static_cast<std::size_t>(begin) * width;
+            const std::size_t last = static_cast<std::size_t>(end) * width;
+            std::fill(framebuffer_.color.begin() + first, framebuffer_.color.begin() + last, packed);
+            std::fill(framebuffer_.depth.begin() + first, framebuffer_.depth.begin() + last, depth);
+        });
+    }
+}
+
+#endif // SOULENGINE_ENABLE_SOFTWARE
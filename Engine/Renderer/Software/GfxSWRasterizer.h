@@ -0,0 +1,137 @@
+#pragma once
+
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+
+#include <cstdint>
+#include <vector>
+#include "Renderer/Gfx.h"
+#include "Renderer/Software/GfxSWShader.h"
+
+namespace SoulEngine::Gfx
+{
+    constexpr uint32_t kSWTileSize = 64;
+    constexpr uint32_t kSWMaxFramebufferSize = 4096;  // keeps guard-band coordinates inside 28.4 fixed point
+
+    // Rows are stored bottom-up like a GL default framebuffer
+    struct SWFramebuffer
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint32_t> color;    // RGBA8, see SWPackColor
+        std::vector<float> depth;       // window-space depth in [0, 1]
+    };
+
+    // Vertex shader output
+    struct SWClipVertex
+    {
+        float position[4];
+        float varyings[kSWMaxVaryings];
+    };
+
+    // Per-draw state captured at submit time, since rasterization is deferred until Flush
+    struct SWDrawState
+    {
+        SWFragmentShaderFn fragment = nullptr;
+        uint32_t varyingCount = 0;
+        CullMode cullMode = CullMode::None;
+        BlendMode blendMode = BlendMode::None;
+        bool depthTest = false;
+        bool depthWrite = true;
+        CompareFunc depthFunc = CompareFunc::Less;
+        bool scissorTest = false;
+        int32_t scissor[4] = {};        // x, y, width, height; bottom-left origin
+        const uint8_t* storage[kSWMaxStorageBuffers] = {};
+        const SWTexture* textures[kSWMaxTextures] = {};
+        const SWSampler* samplers[kSWMaxTextures] = {};
+    };
+
+    struct SWRasterStats
+    {
+        uint64_t trianglesSubmitted = 0;
+        uint64_t trianglesCulled = 0;   // back/front-face, zero-area or fully clipped
+        uint64_t trianglesClipped = 0;  // needed polygon clipping against near/far/guard band
+        uint64_t trianglesBinned = 0;
+        uint64_t binEntries = 0;
+        uint64_t tilesRasterized = 0;
+        uint64_t fragmentsShaded = 0;
+        uint64_t flushes = 0;
+    };
+
+    /**
+     * @brief 分块软件光栅化器
+     * 三角形在提交时完成裁剪与 28.4 定点三角形建立，Flush 时按 64x64 分块装箱，
+     * 再由任务系统的工作线程并行光栅化各块（块之间不共享像素，无需加锁）。
+     * 边函数以 SSE2/AVX2 一次评估 4/8 个像素，编译器不支持时退回标量路径。
+     */
+    class SWRasterizer
+    {
+    public:
+        void Resize(uint32_t width, uint32_t height);
+        SWFramebuffer& GetFramebuffer() { return framebuffer_; }
+        const SWFramebuffer& GetFramebuffer() const { return framebuffer_; }
+
+        // Snapshots fragment uniforms and uniform block contents; returns the draw index for SubmitTriangles
+        uint32_t BeginDraw(const SWDrawState& state, const std::vector<float>& uniforms,
+                           const uint8_t* const* blocks, const std::size_t* blockSizes, uint32_t blockCount);
+
+        // indices are triangle-list indices into vertices
+        void SubmitTriangles(uint32_t drawIndex, const SWClipVertex* vertices, const uint32_t* indices, uint32_t triangleCount);
+
+        std::size_t GetPendingTriangleCount() const { return triangles_.size(); }
+
+        void Flush();
+        void Clear(const float color[4], float depth);
+
+        const SWRasterStats& GetStats() const { return stats_; }
+        void ResetStats() { stats_ = SWRasterStats{}; }
+
+    private:
+        struct Triangle
+        {
+            int32_t x[3], y[3];             // 28.4 window coordinates, counter-clockwise
+            int32_t minX, minY, maxX, maxY; // covered pixel range, max exclusive
+            float ox, oy;                   // plane origin (vertex 0) in pixels
+            float z[3];                     // value, d/dx, d/dy
+            float invW[3];
+            uint32_t varyingOffset;         // into planes_, 3 floats per varying (pre-divided by w)
+            uint32_t drawIndex;
+        };
+
+        struct Draw
+        {
+            SWDrawState state;
+            uint32_t uniformOffset = 0;
+            uint32_t blockOffsets[kSWMaxUniformBlocks] = {};
+            uint32_t blockCount = 0;
+            SWShaderResources resources;    // resolved at Flush once the arenas stop growing
+        };
+
+        struct SetupOutput
+        {
+            std::vector<Triangle> triangles;
+            std::vector<float> planes;
+            uint64_t culled = 0;
+            uint64_t clipped = 0;
+        };
+
+        void SetupTriangle(const Draw& draw, uint32_t drawIndex, const SWClipVertex* v0, const SWClipVertex* v1,
+                           const SWClipVertex* v2, SetupOutput& out) const;
+        void EmitTriangle(const Draw& draw, uint32_t drawIndex, const SWClipVertex* const v[3], SetupOutput& out) const;
+        uint64_t RasterizeTile(uint32_t tileIndex);
+
+        SWFramebuffer framebuffer_;
+        std::vector<Triangle> triangles_;
+        std::vector<float> planes_;
+        std::vector<Draw> draws_;
+        std::vector<float> uniformArena_;
+        std::vector<uint8_t> blockArena_;
+        std::vector<std::vector<uint32_t>> bins_;
+        uint32_t tilesX_ = 0;
+        uint32_t tilesY_ = 0;
+        float guardBandX_ = 1.0f;
+        float guardBandY_ = 1.0f;
+        SWRasterStats stats_{};
+    };
+}
+
+#endif // SOULENGINE_ENABLE_SOFTWARE
@@ -0,0 +1,186 @@
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+
+#include "Renderer/Software/GfxSWShader.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace SoulEngine::Gfx
+{
+    uint32_t GetSWUniformFloatCount(UniformType type)
+    {
+        switch (type)
+        {
+        case UniformType::Float: return 1;
+        case UniformType::Int:   return 1;
+        case UniformType::Vec2:  return 2;
+        case UniformType::Vec3:  return 3;
+        case UniformType::Vec4:  return 4;
+        case UniformType::Mat4:  return 16;
+        default: return 0;
+        }
+    }
+
+    void SWShaderLibrary::Register(const std::string& name, const SWShaderDesc& desc)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shaders_[name] = desc;
+    }
+
+    bool SWShaderLibrary::Find(const std::string& name, SWShaderDesc& out) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = shaders_.find(name);
+        if (it == shaders_.end())
+            return false;
+        out = it->second;
+        return true;
+    }
+
+    SWProgram::SWProgram(std::shared_ptr<SWShaderModule> vs, std::shared_ptr<SWShaderModule> fs, const char* name)
+        : vs_(std::move(vs)), fs_(std::move(fs)), name_(name ? name : "")
+    {
+        if (!vs_ || !fs_)
+        {
+            Logger::Error("SWProgram '{}': missing shader stage", name_);
+            return;
+        }
+        if (vs_->GetDesc().varyingCount != fs_->GetDesc().varyingCount)
+            Logger::Warn("SWProgram '{}': varying count mismatch (vs {}, fs {})", name_,
+                         vs_->GetDesc().varyingCount, fs_->GetDesc().varyingCount);
+        varyingCount_ = std::min(vs_->GetDesc().varyingCount, kSWMaxVaryings);
+
+        // Each stage gets its own packed storage so shaders index it by declaration order
+        auto layoutStage = [this](const SWShaderDesc& desc, std::vector<float>& storage, bool vertex) {
+            for (const SWUniformDecl& decl : desc.uniforms)
+            {
+                const int offset = static_cast<int>(storage.size());
+                const uint32_t floats = GetSWUniformFloatCount(decl.type) * static_cast<uint32_t>(std::max(decl.arraySize, 1));
+                storage.resize(storage.size() + floats, 0.0f);
+
+                auto it = lookup_.find(decl.name);
+                int index;
+                if (it == lookup_.end())
+                {
+                    index = static_cast<int>(entries_.size());
+                    entries_.push_back({ decl.type, std::max(decl.arraySize, 1), -1, -1 });
+                    lookup_.emplace(decl.name, index);
+                    if (decl.arraySize > 1)
+                        lookup_.emplace(std::string(decl.name) + "[0]", index);
+                    reflection_.uniforms.push_back({ decl.name, index, decl.type, std::max(decl.arraySize, 1) });
+                }
+                else
+                {
+                    index = it->second;
+                }
+                (vertex ? entries_[index].vsOffset : entries_[index].fsOffset) = offset;
+            }
+        };
+        layoutStage(vs_->GetDesc(), vsUniforms_, true);
+        layoutStage(fs_->GetDesc(), fsUniforms_, false);
+
+        // blocks[i] reads constant buffer slot i until BindUniformBlock says otherwise
+        auto layoutBlocks = [this](const SWShaderDesc& desc, std::vector<uint32_t>& slots) {
+            const uint32_t count = std::min<uint32_t>(static_cast<uint32_t>(desc.uniformBlocks.size()), kSWMaxUniformBlocks);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                slots.push_back(i);
+                bool known = false;
+                for (const auto& info : reflection_.uniformBlocks)
+                    known |= info.name == desc.uniformBlocks[i];
+                if (!known)
+                    reflection_.uniformBlocks.push_back({ desc.uniformBlocks[i], i, 0 });
+            }
+        };
+        layoutBlocks(vs_->GetDesc(), vsBlockSlots_);
+        layoutBlocks(fs_->GetDesc(), fsBlockSlots_);
+    }
+
+    uint32_t SWProgram::GetBlockSlot(ShaderStage stage, uint32_t index) const
+    {
+        const auto& slots = stage == ShaderStage::Vertex ? vsBlockSlots_ : fsBlockSlots_;
+        return index < slots.size() ? slots[index] : UINT32_MAX;
+    }
+
+    uint32_t SWProgram::GetBlockCount(ShaderStage stage) const
+    {
+        return static_cast<uint32_t>(stage == ShaderStage::Vertex ? vsBlockSlots_.size() : fsBlockSlots_.size());
+    }
+
+    void SWProgram::BindUniformBlock(const char* blockName, uint32_t slot)
+    {
+        if (!blockName || !vs_ || !fs_)
+            return;
+        bool found = false;
+        auto bind = [&](const SWShaderDesc& desc, std::vector<uint32_t>& slots) {
+            for (uint32_t i = 0; i < slots.size(); ++i)
+            {
+                if (std::strcmp(desc.uniformBlocks[i], blockName) == 0)
+                {
+                    slots[i] = slot;
+                    found = true;
+                }
+            }
+        };
+        bind(vs_->GetDesc(), vsBlockSlots_);
+        bind(fs_->GetDesc(), fsBlockSlots_);
+        if (!found)
+            Logger::Warn("SWProgram '{}': uniform block '{}' not found", name_, blockName);
+    }
+
+    UniformHandle SWProgram::GetUniformHandle(const char* name) const
+    {
+        if (!name)
+            return {};
+        auto it = lookup_.find(name);
+        return it == lookup_.end() ? UniformHandle{} : UniformHandle{ it->second };
+    }
+
+    void SWProgram::Write(UniformHandle h, const float* values, uint32_t count)
+    {
+        if (!h.IsValid() || static_cast<std::size_t>(h.location) >= entries_.size())
+            return;
+        const Entry& e = entries_[h.location];
+        count = std::min(count, GetSWUniformFloatCount(e.type) * static_cast<uint32_t>(e.arraySize));
+        if (e.vsOffset >= 0)
+            std::memcpy(vsUniforms_.data() + e.vsOffset, values, count * sizeof(float));
+        if (e.fsOffset >= 0)
+            std::memcpy(fsUniforms_.data() + e.fsOffset, values, count * sizeof(float));
+    }
+
+    void SWProgram::SetInt(UniformHandle h, int v)
+    {
+        const float f = static_cast<float>(v);
+        Write(h, &f, 1);
+    }
+
+    void SWProgram::SetFloat(UniformHandle h, float v) { Write(h, &v, 1); }
+    void SWProgram::SetVec2(UniformHandle h, const float* v2) { Write(h, v2, 2); }
+    void SWProgram::SetVec3(UniformHandle h, const float* v3) { Write(h, v3, 3); }
+    void SWProgram::SetVec4(UniformHandle h, const float* v4) { Write(h, v4, 4); }
+
+    void SWProgram::SetMat4(UniformHandle h, const float* m16, bool transpose)
+    {
+        if (!transpose)
+        {
+            Write(h, m16, 16);
+            return;
+        }
+        float t[16];
+        for (int c = 0; c < 4; ++c)
+            for (int r = 0; r < 4; ++r)
+                t[c * 4 + r] = m16[r * 4 + c];
+        Write(h, t, 16);
+    }
+
+    // No texture units in the software backend yet; keep the slot readable as an int uniform
+    void SWProgram::SetTexture(const char* name, int slot) { SetInt(GetUniformHandle(name), slot); }
+    void SWProgram::SetFloat(const char* name, float v) { SetFloat(GetUniformHandle(name), v); }
+    void SWProgram::SetInt(const char* name, int v) { SetInt(GetUniformHandle(name), v); }
+    void SWProgram::SetVec2(const char* name, const float* v2) { SetVec2(GetUniformHandle(name), v2); }
+    void SWProgram::SetVec3(const char* name, const float* v3) { SetVec3(GetUniformHandle(name), v3); }
+    void SWProgram::SetVec4(const char* name, const float* v4) { SetVec4(GetUniformHandle(name), v4); }
+    void SWProgram::SetMat4(const char* name, const float* m16, bool transpose) { SetMat4(GetUniformHandle(name), m16, transpose); }
+}
+
+#endif // SOULENGINE_ENABLE_SOFTWARE
@@ -0,0 +1,170 @@
+#pragma once
+
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Define.h"
+#include "Renderer/Gfx.h"
+
+namespace SoulEngine::Gfx
+{
+    constexpr uint32_t kSWMaxVertexAttributes = 16;
+    constexpr uint32_t kSWMaxVaryings = 16;
+    constexpr uint32_t kSWMaxUniformBlocks = 8;
+    constexpr uint32_t kSWMaxStorageBuffers = 8;
+    constexpr uint32_t kSWMaxTextures = 16;
+
+    class SWTexture;
+    class SWSampler;
+
+    // What a software shader can read besides its inputs.
+    // uniforms follow the order of the module's SWUniformDecl list, one float per scalar
+    // (ints are stored as float, matrices as 16 column-major floats).
+    struct SWShaderResources
+    {
+        const float* uniforms = nullptr;
+        const uint8_t* blocks[kSWMaxUniformBlocks] = {};
+        // Indexed by storage slot. Read in place rather than snapshotted, so leave them unchanged until Flush.
+        const uint8_t* storage[kSWMaxStorageBuffers] = {};
+        // Indexed by texture unit, same in-place rule as storage
+        const SWTexture* textures[kSWMaxTextures] = {};
+        const SWSampler* samplers[kSWMaxTextures] = {};
+
+        // lod is chosen by the shader since there are no derivatives; see SWSampleTexture
+        void Sample(uint32_t slot, float u, float v, float lod, float out[4], uint32_t arrayLayer = 0) const;
+
+        template <class T>
+        const T* GetBlock(uint32_t index) const { return reinterpret_cast<const T*>(blocks[index]); }
+        template <class T>
+        const T* GetStorage(uint32_t slot) const { return reinterpret_cast<const T*>(storage[slot]); }
+    };
+
+    // attributes is indexed by VertexAttribute::location, missing components default to (0,0,0,1).
+    // outPosition is the clip-space position; outVaryings holds SWShaderDesc::varyingCount floats.
+    using SWVertexShaderFn = void (*)(const SWShaderResources& res, const float (*attributes)[4],
+                                      float outPosition[4], float* outVaryings);
+    // Returns false to discard the fragment. varyings are perspective-correct.
+    using SWFragmentShaderFn = bool (*)(const SWShaderResources& res, const float* varyings, float outColor[4]);
+
+    struct SWUniformDecl
+    {
+        const char* name;
+        UniformType type;
+        int arraySize = 1;
+    };
+
+    // C++ replacement for a GLSL stage
+    struct SWShaderDesc
+    {
+        ShaderStage stage = ShaderStage::Vertex;
+        SWVertexShaderFn vertex = nullptr;
+        SWFragmentShaderFn fragment = nullptr;
+        uint32_t varyingCount = 0;                 // must match between the two stages of a program
+        std::vector<SWUniformDecl> uniforms;
+        std::vector<const char*> uniformBlocks;    // index i is read through SWShaderResources::blocks[i]
+    };
+
+    uint32_t GetSWUniformFloatCount(UniformType type);
+
+    /**
+     * @brief 软件着色器注册表
+     * IDevice::CreateShaderModule 在软件后端中按 ShaderDesc::entryPoint（为空时用 name）查找这里注册的函数。
+     */
+    class SWShaderLibrary
+    {
+        SINGLETON_CLASS(SWShaderLibrary);
+
+    public:
+        void Register(const std::string& name, const SWShaderDesc& desc);
+        bool Find(const std::string& name, SWShaderDesc& out) const;
+
+    private:
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, SWShaderDesc> shaders_;
+    };
+
+    class SWShaderModule final : public IShaderModule
+    {
+    public:
+        SWShaderModule(const SWShaderDesc& desc, const char* name)
+            : desc_(desc), name_(name ? name : "")
+        {
+        }
+
+        ShaderStage GetStage() const override { return desc_.stage; }
+        const SWShaderDesc& GetDesc() const { return desc_; }
+        const std::string& GetName() const { return name_; }
+
+    private:
+        SWShaderDesc desc_;
+        std::string name_;
+    };
+
+    class SWProgram final : public IProgram
+    {
+    public:
+        SWProgram(std::shared_ptr<SWShaderModule> vs, std::shared_ptr<SWShaderModule> fs, const char* name);
+
+        const ProgramReflection& GetReflection() const override { return reflection_; }
+        void SetTexture(const char* name, int slot) override;
+        void SetFloat(const char* name, float v) override;
+        void SetInt(const char* name, int v) override;
+        void SetVec2(const char* name, const float* v2) override;
+        void SetVec3(const char* name, const float* v3) override;
+        void SetVec4(const char* name, const float* v4) override;
+        void SetMat4(const char* name, const float* m16, bool transpose = false) override;
+
+        UniformHandle GetUniformHandle(const char* name) const override;
+        void SetInt(UniformHandle h, int v) override;
+        void SetFloat(UniformHandle h, float v) override;
+        void SetVec2(UniformHandle h, const float* v2) override;
+        void SetVec3(UniformHandle h, const float* v3) override;
+        void SetVec4(UniformHandle h, const float* v4) override;
+        void SetMat4(UniformHandle h, const float* m16, bool transpose = false) override;
+
+        void BindUniformBlock(const char* blockName, uint32_t slot) override;
+
+        bool IsValid() const { return vs_ && fs_ && vs_->GetDesc().vertex && fs_->GetDesc().fragment; }
+        SWVertexShaderFn GetVertexFn() const { return vs_->GetDesc().vertex; }
+        SWFragmentShaderFn GetFragmentFn() const { return fs_->GetDesc().fragment; }
+        uint32_t GetVaryingCount() const { return varyingCount_; }
+
+        const std::vector<float>& GetStageUniforms(ShaderStage stage) const
+        {
+            return stage == ShaderStage::Vertex ? vsUniforms_ : fsUniforms_;
+        }
+        // Constant buffer slot feeding blocks[index] of the given stage, UINT32_MAX when unbound
+        uint32_t GetBlockSlot(ShaderStage stage, uint32_t index) const;
+        uint32_t GetBlockCount(ShaderStage stage) const;
+
+    private:
+        struct Entry
+        {
+            UniformType type;
+            int arraySize;
+            int vsOffset;   // float offset into vsUniforms_, -1 if the stage does not use it
+            int fsOffset;
+        };
+
+        void Write(UniformHandle h, const float* values, uint32_t count);
+
+        std::shared_ptr<SWShaderModule> vs_;
+        std::shared_ptr<SWShaderModule> fs_;
+        std::string name_;
+        ProgramReflection reflection_;
+        std::vector<Entry> entries_;                    // indexed by UniformHandle::location
+        std::unordered_map<std::string, int> lookup_;   // also holds "name[0]" aliases for arrays
+        std::vector<float> vsUniforms_;
+        std::vector<float> fsUniforms_;
+        std::vector<uint32_t> vsBlockSlots_;
+        std::vector<uint32_t> fsBlockSlots_;
+        uint32_t varyingCount_ = 0;
+    };
+}
+
+#endif // SOULENGINE_ENABLE_SOFTWARE
@@ -0,0 +1,234 @@
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+
+#include "Renderer/Software/GfxSWTexture.h"
+#include "Renderer/Software/GfxSWCommon.h"
+#include "Renderer/Software/GfxSWShader.h"
+#include "Renderer/Texture/TextureCompression.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace SoulEngine::Gfx
+{
+    namespace
+    {
+        const float* GetSRGBTable()
+        {
+            static const auto table = [] {
+                std::vector<float> t(256);
+                for (int i = 0; i < 256; ++i)
+                {
+                    const float c = i / 255.0f;
+                    t[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                }
+                return t;
+            }();
+            return table.data();
+        }
+
+        // Returns false when the coordinate falls on the border color
+        bool ApplyAddressMode(AddressMode mode, int32_t coord, uint32_t size, uint32_t& out)
+        {
+            const int32_t n = static_cast<int32_t>(size);
+            switch (mode)
+            {
+            case AddressMode::Repeat:
+                out = static_cast<uint32_t>(((coord % n) + n) % n);
+                return true;
+            case AddressMode::MirroredRepeat:
+            {
+                int32_t t = ((coord % (2 * n)) + 2 * n) % (2 * n);
+                out = static_cast<uint32_t>(t < n ? t : 2 * n - 1 - t);
+                return true;
+            }
+            case AddressMode::ClampToEdge:
+                out = static_cast<uint32_t>(std::clamp(coord, 0, n - 1));
+                return true;
+            case AddressMode::ClampToBorder:
+                if (coord < 0 || coord >= n)
+                    return false;
+                out = static_cast<uint32_t>(coord);
+                return true;
+            }
+            return false;
+        }
+
+        void FetchAddressed(const SWTexture& tex, const SamplerDesc& s, uint32_t mip, uint32_t layer,
+                            int32_t x, int32_t y, float out[4])
+        {
+            uint32_t tx, ty;
+            if (!ApplyAddressMode(s.addressU, x, tex.GetLevelWidth(mip), tx) ||
+                !ApplyAddressMode(s.addressV, y, tex.GetLevelHeight(mip), ty))
+            {
+                std::memcpy(out, s.borderColor, sizeof(float) * 4);
+                return;
+            }
+            tex.Fetch(mip, layer, tx, ty, out);
+        }
+
+        void SampleLevel(const SWTexture& tex, const SamplerDesc& s, FilterMode filter, uint32_t mip, uint32_t layer,
+                         float u, float v, float out[4])
+        {
+            const float fx = u * static_cast<float>(tex.GetLevelWidth(mip));
+            const float fy = v * static_cast<float>(tex.GetLevelHeight(mip));
+            if (filter == FilterMode::Nearest)
+            {
+                FetchAddressed(tex, s, mip, layer, static_cast<int32_t>(std::floor(fx)), static_cast<int32_t>(std::floor(fy)), out);
+                return;
+            }
+
+            const float sx = fx - 0.5f, sy = fy - 0.5f;
+            const float x0f = std::floor(sx), y0f = std::floor(sy);
+            const float ax = sx - x0f, ay = sy - y0f;
+            const int32_t x0 = static_cast<int32_t>(x0f), y0 = static_cast<int32_t>(y0f);
+            float c00[4], c10[4], c01[4], c11[4];
+            FetchAddressed(tex, s, mip, layer, x0, y0, c00);
+            FetchAddressed(tex, s, mip, layer, x0 + 1, y0, c10);
+            FetchAddressed(tex, s, mip, layer, x0, y0 + 1, c01);
+            FetchAddressed(tex, s, mip, layer, x0 + 1, y0 + 1, c11);
+            for (int i = 0; i < 4; ++i)
+            {
+                const float top = c00[i] + (c10[i] - c00[i]) * ax;
+                const float bottom = c01[i] + (c11[i] - c01[i]) * ax;
+                out[i] = top + (bottom - top) * ay;
+            }
+        }
+    }
+
+    SWTexture::SWTexture(const TextureDesc& desc, const SubresourceData* initial)
+        : desc_(desc)
+    {
+        desc_.width = std::max(desc_.width, 1u);
+        desc_.height = std::max(desc_.height, 1u);
+        desc_.arrayLayers = std::max(desc_.arrayLayers, 1u);
+        desc_.mipLevels = std::min(std::max(desc_.mipLevels, 1u), GetMipLevelCount(desc_.width, desc_.height));
+
+        storedFormat_ = desc_.format;
+        if (desc_.format == DataFormat::BC1_SRGB || desc_.format == DataFormat::BC3_SRGB)
+            storedFormat_ = DataFormat::R8G8B8A8_SRGB;
+        else if (IsBlockCompressed(desc_.format))
+            storedFormat_ = DataFormat::R8G8B8A8_UNorm;
+        texelSize_ = GetDataFormatSize(storedFormat_);
+
+        levels_.resize(static_cast<std::size_t>(desc_.arrayLayers) * desc_.mipLevels);
+        for (uint32_t layer = 0; layer < desc_.arrayLayers; ++layer)
+        {
+            for (uint32_t mip = 0; mip < desc_.mipLevels; ++mip)
+            {
+                const uint32_t index = layer * desc_.mipLevels + mip;
+                levels_[index].assign(static_cast<std::size_t>(GetLevelWidth(mip)) * GetLevelHeight(mip) * texelSize_, 0);
+                if (initial && initial[index].data)
+                    UpdateLevel(mip, layer, initial[index].data, initial[index].size);
+            }
+        }
+    }
+
+    bool SWTexture::CanSample(DataFormat fmt)
+    {
+        switch (fmt)
+        {
+        case DataFormat::BC7_UNorm:
+        case DataFormat::BC7_SRGB:
+        case DataFormat::Unknown:
+            return false;
+        default:
+            return IsBlockCompressed(fmt) || GetDataFormatSize(fmt) != 0;
+        }
+    }
+
+    void SWTexture::UpdateLevel(uint32_t mipLevel, uint32_t arrayLayer, const void* data, std::size_t size)
+    {
+        const std::size_t expected = GetTextureLevelSize(desc_.format, GetLevelWidth(mipLevel), GetLevelHeight(mipLevel));
+        if (mipLevel >= desc_.mipLevels || arrayLayer >= desc_.arrayLayers || !data || (size && size < expected))
+        {
+            Logger::Warn("SWTexture '{}': invalid update of mip {} layer {}", desc_.name ? desc_.name : "", mipLevel, arrayLayer);
+            return;
+        }
+        std::vector<uint8_t>& level = levels_[arrayLayer * desc_.mipLevels + mipLevel];
+        if (IsBlockCompressed(desc_.format))
+            DecompressImage(desc_.format, static_cast<const uint8_t*>(data), GetLevelWidth(mipLevel), GetLevelHeight(mipLevel), level.data());
+        else
+            std::memcpy(level.data(), data, level.size());
+    }
+
+    void SWTexture::Fetch(uint32_t mipLevel, uint32_t arrayLayer, uint32_t x, uint32_t y, float out[4]) const
+    {
+        const std::vector<uint8_t>& level = levels_[arrayLayer * desc_.mipLevels + mipLevel];
+        const uint8_t* texel = level.data() + (static_cast<std::size_t>(y) * GetLevelWidth(mipLevel) + x) * texelSize_;
+        switch (storedFormat_)
+        {
+        case DataFormat::R8_UNorm:
+            out[0] = texel[0] * (1.0f / 255.0f);
+            out[1] = 0.0f; out[2] = 0.0f; out[3] = 1.0f;
+            break;
+        case DataFormat::R8G8_UNorm:
+            out[0] = texel[0] * (1.0f / 255.0f);
+            out[1] = texel[1] * (1.0f / 255.0f);
+            out[2] = 0.0f; out[3] = 1.0f;
+            break;
+        case DataFormat::R8G8B8A8_SRGB:
+        {
+            const float* table = GetSRGBTable();
+            out[0] = table[texel[0]];
+            out[1] = table[texel[1]];
+            out[2] = table[texel[2]];
+            out[3] = texel[3] * (1.0f / 255.0f);
+            break;
+        }
+        default:
+            SWFetchAttribute(storedFormat_, texel, out);
+            break;
+        }
+    }
+
+    void SWSampleTexture(const SWTexture* texture, const SWSampler* sampler, float u, float v, float lod,
+                         uint32_t arrayLayer, float out[4])
+    {
+        if (!texture)
+        {
+            out[0] = 0.0f; out[1] = 0.0f; out[2] = 0.0f; out[3] = 1.0f;
+            return;
+        }
+        static const SamplerDesc kDefaultSampler{};
+        const SamplerDesc& s = sampler ? sampler->GetDesc() : kDefaultSampler;
+        const TextureDesc& desc = texture->GetDesc();
+        const uint32_t layer = std::min(arrayLayer, desc.arrayLayers - 1);
+
+        lod = std::clamp(lod + s.mipLodBias, s.minLod, s.maxLod);
+        const float maxMip = static_cast<float>(desc.mipLevels - 1);
+        if (lod <= 0.0f)
+        {
+            SampleLevel(*texture, s, s.magFilter, 0, layer, u, v, out);
+            return;
+        }
+        lod = std::min(lod, maxMip);
+
+        if (s.mipFilter == FilterMode::Nearest || desc.mipLevels == 1)
+        {
+            SampleLevel(*texture, s, s.minFilter, static_cast<uint32_t>(lod + 0.5f), layer, u, v, out);
+            return;
+        }
+
+        const uint32_t mip0 = static_cast<uint32_t>(lod);
+        const uint32_t mip1 = std::min(mip0 + 1, desc.mipLevels - 1);
+        const float t = lod - static_cast<float>(mip0);
+        float a[4], b[4];
+        SampleLevel(*texture, s, s.minFilter, mip0, layer, u, v, a);
+        SampleLevel(*texture, s, s.minFilter, mip1, layer, u, v, b);
+        for (int i = 0; i < 4; ++i)
+            out[i] = a[i] + (b[i] - a[i]) * t;
+    }
+
+    void SWShaderResources::Sample(uint32_t slot, float u, float v, float lod, float out[4], uint32_t arrayLayer) const
+    {
+        if (slot >= kSWMaxTextures)
+        {
+            out[0] = 0.0f; out[1] = 0.0f; out[2] = 0.0f; out[3] = 1.0f;
+            return;
+        }
+        SWSampleTexture(textures[slot], samplers[slot], u, v, lod, arrayLayer, out);
+    }
+}
+
+#endif // SOULENGINE_ENABLE_SOFTWARE
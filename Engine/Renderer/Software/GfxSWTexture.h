@@ -0,0 +1,53 @@
+#pragma once
+
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+
+#include <cstdint>
+#include <vector>
+#include "Renderer/Gfx.h"
+
+namespace SoulEngine::Gfx
+{
+    // System-memory texture. BC1/BC3/BC4/BC5 levels are decoded to RGBA8 on upload so sampling
+    // only has to deal with plain texels; BC7 is not supported (CanSample returns false).
+    class SWTexture final : public ITexture
+    {
+    public:
+        SWTexture(const TextureDesc& desc, const SubresourceData* initial);
+
+        static bool CanSample(DataFormat fmt);
+
+        const TextureDesc& GetDesc() const override { return desc_; }
+        void UpdateLevel(uint32_t mipLevel, uint32_t arrayLayer, const void* data, std::size_t size) override;
+
+        // Texel of an integer coordinate, no bounds checks
+        void Fetch(uint32_t mipLevel, uint32_t arrayLayer, uint32_t x, uint32_t y, float out[4]) const;
+
+        uint32_t GetLevelWidth(uint32_t mipLevel) const { return desc_.width >> mipLevel ? desc_.width >> mipLevel : 1; }
+        uint32_t GetLevelHeight(uint32_t mipLevel) const { return desc_.height >> mipLevel ? desc_.height >> mipLevel : 1; }
+
+    private:
+        TextureDesc desc_{};
+        DataFormat storedFormat_ = DataFormat::Unknown;     // format of levels_ after BC decoding
+        uint32_t texelSize_ = 0;
+        std::vector<std::vector<uint8_t>> levels_;          // [layer * mipLevels + mip]
+    };
+
+    class SWSampler final : public ISampler
+    {
+    public:
+        explicit SWSampler(const SamplerDesc& desc) : desc_(desc) {}
+
+        const SamplerDesc& GetDesc() const override { return desc_; }
+
+    private:
+        SamplerDesc desc_{};
+    };
+
+    // Samples texture at normalized (u, v); lod is the mip level the shader computed (software shaders
+    // have no derivatives), before the sampler's bias and clamps. Unbound textures read as opaque black.
+    void SWSampleTexture(const SWTexture* texture, const SWSampler* sampler, float u, float v, float lod,
+                         uint32_t arrayLayer, float out[4]);
+}
+
+#endif // SOULENGINE_ENABLE_SOFTWARE
@@ -0,0 +1,103 @@
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+
+#include "SoftwareRenderer.h"
+#include "Log/Logger.h"
+#include "Window/IWindow.h"
+#include "Renderer/Software/GfxSWDevice.h"
+#include "Renderer/Software/GfxSWContext.h"
+#include "Renderer/Capture/GfxCapture.h"
+
+namespace SoulEngine
+{
+    SoftwareRenderer::SoftwareRenderer() = default;
+    SoftwareRenderer::~SoftwareRenderer() = default;
+
+    bool SoftwareRenderer::Initialize(IWindow* window)
+    {
+        m_window = window;
+        if (m_window && m_window->GetWidth() > 0 && m_window->GetHeight() > 0)
+        {
+            width_ = static_cast<uint32_t>(m_window->GetWidth());
+            height_ = static_cast<uint32_t>(m_window->GetHeight());
+        }
+
+        device_ = std::make_shared<Gfx::GfxSWDevice>();
+        context_ = std::make_shared<Gfx::GfxSWContext>(width_, height_);
+        InstallGfxCapture(device_.get(), context_.get());
+
+        m_initialized = true;
+        Logger::Log("SoftwareRenderer initialized ({}x{}, {})", width_, height_, m_window ? "windowed, readback only" : "headless");
+        return true;
+    }
+
+    void SoftwareRenderer::BeginFrame()
+    {
+        if (context_)
+            context_->ResetStats();
+    }
+
+    void SoftwareRenderer::EndFrame()
+    {
+        // Pipelines released this frame no longer pin their programs and layouts
+        if (Gfx::IDevice* device = GetGfxDevice())
+            device->TrimPipelineStates();
+    }
+
+    void SoftwareRenderer::Shutdown()
+    {
+        Logger::Log("SoftwareRenderer Shutdown");
+        gfxCapture_.reset();
+        context_.reset();
+        device_.reset();
+        m_initialized = false;
+    }
+
+    void SoftwareRenderer::Clear()
+    {
+        const float color[4] = { 0.1f, 0.1f, 0.2f, 0.1f };
+        context_->Clear(color, 1.0f);
+    }
+
+    // There is no presentation surface; finishing the frame means resolving all queued triangles
+    void SoftwareRenderer::SwapBuffers()
+    {
+        context_->Flush();
+        if (gfxCapture_)
+            gfxCapture_->EndFrame();
+        ++frameIndex_;
+    }
+
+    void SoftwareRenderer::SetDefaultSize(uint32_t width, uint32_t height)
+    {
+        width_ = width;
+        height_ = height;
+        if (context_)
+        {
+            context_->Resize(width, height);
+            width_ = context_->GetFramebuffer().width;
+            height_ = context_->GetFramebuffer().height;
+        }
+    }
+
+    void SoftwareRenderer::ReadColorBuffer(std::vector<uint8_t>& outRgba)
+    {
+        if (!context_)
+        {
+            outRgba.clear();
+            return;
+        }
+        context_->ReadColorBuffer(outRgba);
+    }
+
+    Gfx::IDevice* SoftwareRenderer::GetGfxDevice()
+    {
+        return gfxCapture_ ? gfxCapture_->GetDevice() : device_.get();
+    }
+
+    Gfx::IContext* SoftwareRenderer::GetGfxContext()
+    {
+        return gfxCapture_ ? gfxCapture_->GetContext() : context_.get();
+    }
+} // namespace SoulEngine
+
+#endif
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Renderer/Renderer.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace SoulEngine
+{
+    class IWindow;
+    namespace Gfx { class IDevice; class IContext; class GfxSWDevice; class GfxSWContext; }
+
+    /**
+     * @brief CPU 软件渲染器
+     * 不依赖 GPU 与图形 API，可在无窗口（window 为空）的 CI/服务器环境下运行；
+     * 结果通过 ReadColorBuffer 回读，用于离线对比图与提交开销基准测试。
+     */
+    class SoftwareRenderer final : public Renderer
+    {
+    public:
+        SoftwareRenderer();
+        ~SoftwareRenderer() override;
+
+        // window 为空时以 SetDefaultSize 指定的尺寸（默认 1280x720）无头运行
+        bool Initialize(IWindow* window) override;
+        void BeginFrame() override;
+        void EndFrame() override;
+        void Shutdown() override;
+        void Clear() override;
+        void SwapBuffers() override;
+
+        Gfx::IDevice* GetGfxDevice() override;
+        Gfx::IContext* GetGfxContext() override;
+
+        void SetDefaultSize(uint32_t width, uint32_t height);
+        // Tightly packed RGBA8, bottom row first (same layout as glReadPixels)
+        void ReadColorBuffer(std::vector<uint8_t>& outRgba);
+        uint32_t GetWidth() const { return width_; }
+        uint32_t GetHeight() const { return height_; }
+
+    private:
+        bool m_initialized = false;
+        IWindow* m_window = nullptr;
+        uint32_t width_ = 1280;
+        uint32_t height_ = 720;
+        uint64_t frameIndex_ = 0;
+
+        std::shared_ptr<Gfx::GfxSWDevice> device_;
+        std::shared_ptr<Gfx::GfxSWContext> context_;
+    };
+} // namespace SoulEngine
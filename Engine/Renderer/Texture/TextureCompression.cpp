@@ -0,0 +1,815 @@
+#include "Renderer/Texture/TextureCompression.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace SoulEngine::Gfx
+{
+    namespace
+    {
+        using Block = uint8_t[16][4];
+
+        constexpr uint32_t kBlocksPerJob = 64;
+        constexpr uint32_t kRefineIterations = 2;
+        constexpr uint8_t kBC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        class BitWriter
+        {
+        public:
+            explicit BitWriter(uint8_t* out) : out_(out) {}
+
+            void Write(uint32_t value, uint32_t bits)
+            {
+                for (uint32_t i = 0; i < bits; ++i, ++pos_)
+                {
+                    if ((value >> i) & 1)
+                        out_[pos_ >> 3] |= static_cast<uint8_t>(1u << (pos_ & 7));
+                }
+            }
+
+        private:
+            uint8_t* out_;
+            uint32_t pos_ = 0;
+        };
+
+        class BitReader
+        {
+        public:
+            explicit BitReader(const uint8_t* data) : data_(data) {}
+
+            uint32_t Read(uint32_t bits)
+            {
+                uint32_t value = 0;
+                for (uint32_t i = 0; i < bits; ++i, ++pos_)
+                    value |= static_cast<uint32_t>((data_[pos_ >> 3] >> (pos_ & 7)) & 1) << i;
+                return value;
+            }
+
+        private:
+            const uint8_t* data_;
+            uint32_t pos_ = 0;
+        };
+
+        // ---- Decoding ----
+
+        void Expand565(uint16_t c, uint8_t out[3])
+        {
+            const uint32_t r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+            out[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+            out[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+            out[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+        }
+
+        // Palette of a BC1 color block; entry 3 is transparent black in the 3-color mode
+        void BuildColorPalette(uint16_t c0, uint16_t c1, bool fourColor, uint8_t palette[4][4])
+        {
+            std::memset(palette, 0, 16);
+            Expand565(c0, palette[0]);
+            Expand565(c1, palette[1]);
+            for (int i = 0; i < 3; ++i)
+            {
+                if (fourColor)
+                {
+                    palette[2][i] = static_cast<uint8_t>((2 * palette[0][i] + palette[1][i] + 1) / 3);
+                    palette[3][i] = static_cast<uint8_t>((palette[0][i] + 2 * palette[1][i] + 1) / 3);
+                }
+                else
+                {
+                    palette[2][i] = static_cast<uint8_t>((palette[0][i] + palette[1][i]) / 2);
+                }
+            }
+            palette[0][3] = palette[1][3] = palette[2][3] = 255;
+            palette[3][3] = fourColor ? 255 : 0;
+        }
+
+        void BuildAlphaPalette(uint32_t a0, uint32_t a1, uint8_t palette[8])
+        {
+            palette[0] = static_cast<uint8_t>(a0);
+            palette[1] = static_cast<uint8_t>(a1);
+            if (a0 > a1)
+            {
+                for (uint32_t i = 1; i < 7; ++i)
+                    palette[i + 1] = static_cast<uint8_t>(((7 - i) * a0 + i * a1 + 3) / 7);
+            }
+            else
+            {
+                for (uint32_t i = 1; i < 5; ++i)
+                    palette[i + 1] = static_cast<uint8_t>(((5 - i) * a0 + i * a1 + 2) / 5);
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+        }
+
+        // 16 RGBA8 texels, row-major; alpha is written only in the 3-color (punch-through) mode
+        void DecodeColorBlock(const uint8_t* block, bool allowPunchThrough, uint8_t out[16][4])
+        {
+            uint16_t c0, c1;
+            std::memcpy(&c0, block, 2);
+            std::memcpy(&c1, block + 2, 2);
+            uint8_t palette[4][4];
+            BuildColorPalette(c0, c1, c0 > c1 || !allowPunchThrough, palette);
+
+            uint32_t bits;
+            std::memcpy(&bits, block + 4, 4);
+            for (int t = 0; t < 16; ++t)
+                std::memcpy(out[t], palette[(bits >> (t * 2)) & 3], 4);
+        }
+
+        // BC4-style 8-byte block: 16 single-channel values
+        void DecodeAlphaBlock(const uint8_t* block, uint8_t out[16])
+        {
+            uint8_t palette[8];
+            BuildAlphaPalette(block[0], block[1], palette);
+            uint64_t bits = 0;
+            for (int i = 0; i < 6; ++i)
+                bits |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+            for (int t = 0; t < 16; ++t)
+                out[t] = palette[(bits >> (t * 3)) & 7];
+        }
+
+        uint8_t InterpolateBC7(uint32_t e0, uint32_t e1, uint32_t weight)
+        {
+            return static_cast<uint8_t>(((64 - weight) * e0 + weight * e1 + 32) >> 6);
+        }
+
+        bool DecodeBC7Block(const uint8_t* block, uint8_t out[16][4])
+        {
+            BitReader reader(block);
+            if (reader.Read(7) != 1u << 6)
+            {
+                for (int t = 0; t < 16; ++t)
+                {
+                    out[t][0] = out[t][2] = out[t][3] = 255;
+                    out[t][1] = 0;
+                }
+                return false;
+            }
+            uint32_t endpoints[2][4];
+            for (int c = 0; c < 4; ++c)
+            {
+                endpoints[0][c] = reader.Read(7) << 1;
+                endpoints[1][c] = reader.Read(7) << 1;
+            }
+            const uint32_t p0 = reader.Read(1), p1 = reader.Read(1);
+            for (int c = 0; c < 4; ++c)
+            {
+                endpoints[0][c] |= p0;
+                endpoints[1][c] |= p1;
+            }
+            for (int t = 0; t < 16; ++t)
+            {
+                const uint32_t weight = kBC7Weights[reader.Read(t == 0 ? 3 : 4)];
+                for (int c = 0; c < 4; ++c)
+                    out[t][c] = InterpolateBC7(endpoints[0][c], endpoints[1][c], weight);
+            }
+            return true;
+        }
+
+        // ---- Encoding ----
+
+        // Line through the texels along their principal axis (power iteration on the covariance),
+        // clipped to the extent of their projections. Degenerate sets give e0 == e1 == mean.
+        template <int D>
+        void FitLine(const float points[][D], int count, float e0[D], float e1[D])
+        {
+            float mean[D] = {};
+            for (int i = 0; i < count; ++i)
+            {
+                for (int c = 0; c < D; ++c)
+                    mean[c] += points[i][c];
+            }
+            for (int c = 0; c < D; ++c)
+                mean[c] /= static_cast<float>(count);
+
+            float cov[D][D] = {};
+            for (int i = 0; i < count; ++i)
+            {
+                for (int a = 0; a < D; ++a)
+                {
+                    for (int b = 0; b < D; ++b)
+                        cov[a][b] += (points[i][a] - mean[a]) * (points[i][b] - mean[b]);
+                }
+            }
+
+            // Start from the row of the widest channel: cov * e_k, never orthogonal to the main axis
+            int widest = 0;
+            for (int c = 1; c < D; ++c)
+            {
+                if (cov[c][c] > cov[widest][widest])
+                    widest = c;
+            }
+            float axis[D];
+            for (int c = 0; c < D; ++c)
+                axis[c] = cov[widest][c];
+            for (int iteration = 0; iteration < 8; ++iteration)
+            {
+                float next[D] = {};
+                float scale = 0.0f;
+                for (int a = 0; a < D; ++a)
+                {
+                    for (int b = 0; b < D; ++b)
+                        next[a] += cov[a][b] * axis[b];
+                    scale = std::max(scale, std::fabs(next[a]));
+                }
+                if (scale < 1e-6f)
+                    break;
+                for (int c = 0; c < D; ++c)
+                    axis[c] = next[c] / scale;
+            }
+
+            float length = 0.0f;
+            for (int c = 0; c < D; ++c)
+                length += axis[c] * axis[c];
+            float tMin = 0.0f, tMax = 0.0f;
+            if (length > 1e-6f)
+            {
+                tMin = std::numeric_limits<float>::max();
+                tMax = -tMin;
+                for (int i = 0; i < count; ++i)
+                {
+                    float t = 0.0f;
+                    for (int c = 0; c < D; ++c)
+                        t += (points[i][c] - mean[c]) * axis[c];
+                    tMin = std::min(tMin, t / length);
+                    tMax = std::max(tMax, t / length);
+                }
+            }
+            for (int c = 0; c < D; ++c)
+            {
+                e0[c] = std::clamp(mean[c] + axis[c] * tMin, 0.0f, 255.0f);
+                e1[c] = std::clamp(mean[c] + axis[c] * tMax, 0.0f, 255.0f);
+            }
+        }
+
+        // Least-squares endpoints for texels already assigned to palette weights: minimizes
+        // sum |w_i * e0 + (1 - w_i) * e1 - x_i|^2. False when the weights are all equal.
+        template <int D>
+        bool SolveEndpoints(const float points[][D], const float weights[], int count, float e0[D], float e1[D])
+        {
+            float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            float ax[D] = {}, bx[D] = {};
+            for (int i = 0; i < count; ++i)
+            {
+                const float a = weights[i], b = 1.0f - a;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (int c = 0; c < D; ++c)
+                {
+                    ax[c] += a * points[i][c];
+                    bx[c] += b * points[i][c];
+                }
+            }
+            const float det = aa * bb - ab * ab;
+            if (std::fabs(det) < 1e-6f)
+                return false;
+            for (int c = 0; c < D; ++c)
+            {
+                e0[c] = std::clamp((ax[c] * bb - bx[c] * ab) / det, 0.0f, 255.0f);
+                e1[c] = std::clamp((bx[c] * aa - ax[c] * ab) / det, 0.0f, 255.0f);
+            }
+            return true;
+        }
+
+        uint16_t To565(const float c[3])
+        {
+            const uint32_t r = static_cast<uint32_t>(std::lround(c[0] * 31.0f / 255.0f));
+            const uint32_t g = static_cast<uint32_t>(std::lround(c[1] * 63.0f / 255.0f));
+            const uint32_t b = static_cast<uint32_t>(std::lround(c[2] * 31.0f / 255.0f));
+            return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+        }
+
+        // Endpoint pairs (high, low) whose 2:1 interpolant is closest to each 8-bit value, for
+        // solid 4-color blocks: far more accurate than rounding the color to 565 directly
+        struct SolidColorTable
+        {
+            uint8_t pair[256][2];
+        };
+
+        SolidColorTable BuildSolidColorTable(uint32_t bits)
+        {
+            SolidColorTable table{};
+            const uint32_t levels = 1u << bits;
+            for (uint32_t value = 0; value < 256; ++value)
+            {
+                int bestError = 256;
+                for (uint32_t hi = 0; hi < levels; ++hi)
+                {
+                    const uint32_t h = bits == 5 ? (hi << 3) | (hi >> 2) : (hi << 2) | (hi >> 4);
+                    for (uint32_t lo = 0; lo < levels; ++lo)
+                    {
+                        const uint32_t l = bits == 5 ? (lo << 3) | (lo >> 2) : (lo << 2) | (lo >> 4);
+                        const int error = std::abs(static_cast<int>((2 * h + l + 1) / 3) - static_cast<int>(value));
+                        if (error < bestError)
+                        {
+                            bestError = error;
+                            table.pair[value][0] = static_cast<uint8_t>(hi);
+                            table.pair[value][1] = static_cast<uint8_t>(lo);
+                        }
+                    }
+                }
+            }
+            return table;
+        }
+
+        const SolidColorTable& GetSolidColorTable(uint32_t bits)
+        {
+            static const SolidColorTable table5 = BuildSolidColorTable(5);
+            static const SolidColorTable table6 = BuildSolidColorTable(6);
+            return bits == 5 ? table5 : table6;
+        }
+
+        // Nearest palette entry per texel; transparent texels take entry 3 of the 3-color palette
+        int AssignColorIndices(const Block texels, const bool transparent[16], uint16_t c0, uint16_t c1, bool fourColor,
+                               uint32_t& indices)
+        {
+            uint8_t palette[4][4];
+            BuildColorPalette(c0, c1, fourColor, palette);
+            const int entries = fourColor ? 4 : 3;
+            int error = 0;
+            indices = 0;
+            for (int t = 0; t < 16; ++t)
+            {
+                if (transparent[t])
+                {
+                    indices |= 3u << (t * 2);
+                    continue;
+                }
+                int best = 0, bestError = std::numeric_limits<int>::max();
+                for (int i = 0; i < entries; ++i)
+                {
+                    int e = 0;
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        const int d = static_cast<int>(texels[t][c]) - palette[i][c];
+                        e += d * d;
+                    }
+                    if (e < bestError)
+                    {
+                        bestError = e;
+                        best = i;
+                    }
+                }
+                indices |= static_cast<uint32_t>(best) << (t * 2);
+                error += bestError;
+            }
+            return error;
+        }
+
+        // BC1 color block (also the color half of BC3). Without allowPunchThrough alpha is ignored.
+        void EncodeColorBlock(const Block texels, bool allowPunchThrough, uint8_t out[8])
+        {
+            bool transparent[16];
+            float points[16][3];
+            int opaque = 0;
+            bool solid = true;
+            for (int t = 0; t < 16; ++t)
+            {
+                transparent[t] = allowPunchThrough && texels[t][3] < 128;
+                if (transparent[t])
+                    continue;
+                for (int c = 0; c < 3; ++c)
+                    points[opaque][c] = texels[t][c];
+                solid = solid && (opaque == 0 || std::memcmp(points[opaque], points[0], sizeof(points[0])) == 0);
+                ++opaque;
+            }
+
+            uint16_t c0 = 0, c1 = 0;
+            uint32_t indices = 0xFFFFFFFFu;            // all transparent: 3-color mode, entry 3
+            const bool fourColor = opaque == 16;
+            if (opaque > 0 && fourColor && solid)
+            {
+                const uint8_t* r = GetSolidColorTable(5).pair[texels[0][0]];
+                const uint8_t* g = GetSolidColorTable(6).pair[texels[0][1]];
+                const uint8_t* b = GetSolidColorTable(5).pair[texels[0][2]];
+                c0 = static_cast<uint16_t>((r[0] << 11) | (g[0] << 5) | b[0]);
+                c1 = static_cast<uint16_t>((r[1] << 11) | (g[1] << 5) | b[1]);
+                indices = 0xAAAAAAAAu;                 // entry 2 everywhere
+            }
+            else if (opaque > 0)
+            {
+                float e0[3], e1[3];
+                FitLine<3>(points, opaque, e0, e1);
+                c0 = To565(e1);
+                c1 = To565(e0);
+                int error = AssignColorIndices(texels, transparent, c0, c1, fourColor, indices);
+
+                static constexpr float kFourColorWeights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+                static constexpr float kThreeColorWeights[4] = { 1.0f, 0.0f, 0.5f, 0.0f };
+                const float* paletteWeights = fourColor ? kFourColorWeights : kThreeColorWeights;
+                for (uint32_t iteration = 0; iteration < kRefineIterations && error > 0; ++iteration)
+                {
+                    float weights[16];
+                    for (int t = 0, i = 0; t < 16; ++t)
+                    {
+                        if (!transparent[t])
+                            weights[i++] = paletteWeights[(indices >> (t * 2)) & 3];
+                    }
+                    if (!SolveEndpoints<3>(points, weights, opaque, e0, e1))
+                        break;
+                    const uint16_t r0 = To565(e0), r1 = To565(e1);
+                    uint32_t refinedIndices;
+                    const int refinedError = AssignColorIndices(texels, transparent, r0, r1, fourColor, refinedIndices);
+                    if (refinedError >= error)
+                        break;
+                    c0 = r0;
+                    c1 = r1;
+                    indices = refinedIndices;
+                    error = refinedError;
+                }
+            }
+
+            // The decoder picks the mode from the endpoint order: c0 > c1 is the 4-color mode
+            if (fourColor)
+            {
+                if (c0 < c1)
+                {
+                    std::swap(c0, c1);
+                    indices ^= 0x55555555u;             // 0 <-> 1, 2 <-> 3
+                }
+                else if (c0 == c1)
+                {
+                    indices = 0;                        // would decode as 3-color; entry 0 is the color either way
+                }
+            }
+            else if (c0 > c1)
+            {
+                std::swap(c0, c1);
+                for (int t = 0; t < 16; ++t)
+                {
+                    if (((indices >> (t * 2)) & 2) == 0)
+                        indices ^= 1u << (t * 2);       // 0 <-> 1; the midpoint and transparent stay
+                }
+            }
+            std::memcpy(out, &c0, 2);
+            std::memcpy(out + 2, &c1, 2);
+            std::memcpy(out + 4, &indices, 4);
+        }
+
+        int AssignAlphaIndices(const uint8_t values[16], uint32_t a0, uint32_t a1, uint64_t& bits)
+        {
+            uint8_t palette[8];
+            BuildAlphaPalette(a0, a1, palette);
+            int error = 0;
+            bits = 0;
+            for (int t = 0; t < 16; ++t)
+            {
+                int best = 0, bestError = std::numeric_limits<int>::max();
+                for (int i = 0; i < 8; ++i)
+                {
+                    const int d = static_cast<int>(values[t]) - palette[i];
+                    if (d * d < bestError)
+                    {
+                        bestError = d * d;
+                        best = i;
+                    }
+                }
+                bits |= static_cast<uint64_t>(best) << (t * 3);
+                error += bestError;
+            }
+            return error;
+        }
+
+        // BC4-style block: the 8-value mode spans min..max; the 6-value mode spans the values
+        // strictly inside (0, 255) and has exact 0 and 255 entries for masks
+        void EncodeAlphaBlock(const uint8_t values[16], uint8_t out[8])
+        {
+            uint32_t lo = 255, hi = 0, innerLo = 255, innerHi = 0;
+            for (int t = 0; t < 16; ++t)
+            {
+                lo = std::min<uint32_t>(lo, values[t]);
+                hi = std::max<uint32_t>(hi, values[t]);
+                if (values[t] != 0 && values[t] != 255)
+                {
+                    innerLo = std::min<uint32_t>(innerLo, values[t]);
+                    innerHi = std::max<uint32_t>(innerHi, values[t]);
+                }
+            }
+
+            uint32_t a0 = lo, a1 = lo;
+            uint64_t bits = 0;
+            if (lo != hi)
+            {
+                a0 = hi;
+                a1 = lo;
+                int error = AssignAlphaIndices(values, a0, a1, bits);
+
+                // Least squares on the 8-value palette weights, kept while it helps
+                for (uint32_t iteration = 0; iteration < kRefineIterations && error > 0; ++iteration)
+                {
+                    float points[16][1], weights[16];
+                    for (int t = 0; t < 16; ++t)
+                    {
+                        const uint32_t index = static_cast<uint32_t>(bits >> (t * 3)) & 7;
+                        points[t][0] = values[t];
+                        weights[t] = index == 0 ? 1.0f : index == 1 ? 0.0f : (8 - index) / 7.0f;
+                    }
+                    float e0[1], e1[1];
+                    if (!SolveEndpoints<1>(points, weights, 16, e0, e1))
+                        break;
+                    const uint32_t r0 = static_cast<uint32_t>(std::lround(e0[0]));
+                    const uint32_t r1 = static_cast<uint32_t>(std::lround(e1[0]));
+                    if (r0 <= r1)
+                        break;
+                    uint64_t refinedBits;
+                    const int refinedError = AssignAlphaIndices(values, r0, r1, refinedBits);
+                    if (refinedError >= error)
+                        break;
+                    a0 = r0;
+                    a1 = r1;
+                    bits = refinedBits;
+                    error = refinedError;
+                }
+
+                if (lo == 0 || hi == 255)
+                {
+                    if (innerLo > innerHi)
+                        innerLo = innerHi = 0;
+                    uint64_t sixBits;
+                    if (AssignAlphaIndices(values, innerLo, innerHi, sixBits) < error)
+                    {
+                        a0 = innerLo;
+                        a1 = innerHi;
+                        bits = sixBits;
+                    }
+                }
+            }
+            out[0] = static_cast<uint8_t>(a0);
+            out[1] = static_cast<uint8_t>(a1);
+            for (int i = 0; i < 6; ++i)
+                out[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+        }
+
+        struct BC7Mode6
+        {
+            uint32_t q[2][4] = {};      // 7-bit endpoints
+            uint32_t p[2] = {};         // p-bits, the shared low bit of each endpoint
+            uint8_t indices[16] = {};
+            int error = std::numeric_limits<int>::max();
+        };
+
+        // Indices for fixed endpoints: project onto the segment, then settle among the neighbours
+        int AssignBC7Indices(const Block texels, const BC7Mode6& mode, uint8_t indices[16])
+        {
+            int e0[4], e1[4], axis[4];
+            int axisLength = 0;
+            for (int c = 0; c < 4; ++c)
+            {
+                e0[c] = static_cast<int>((mode.q[0][c] << 1) | mode.p[0]);
+                e1[c] = static_cast<int>((mode.q[1][c] << 1) | mode.p[1]);
+                axis[c] = e1[c] - e0[c];
+                axisLength += axis[c] * axis[c];
+            }
+            uint8_t palette[16][4];
+            for (int i = 0; i < 16; ++i)
+            {
+                for (int c = 0; c < 4; ++c)
+                    palette[i][c] = InterpolateBC7(static_cast<uint32_t>(e0[c]), static_cast<uint32_t>(e1[c]), kBC7Weights[i]);
+            }
+
+            int error = 0;
+            for (int t = 0; t < 16; ++t)
+            {
+                int guess = 0;
+                if (axisLength > 0)
+                {
+                    int dot = 0;
+                    for (int c = 0; c < 4; ++c)
+                        dot += (texels[t][c] - e0[c]) * axis[c];
+                    guess = std::clamp(static_cast<int>(std::lround(15.0f * static_cast<float>(dot) / static_cast<float>(axisLength))), 0, 15);
+                }
+                int best = guess, bestError = std::numeric_limits<int>::max();
+                for (int i = std::max(guess - 1, 0); i <= std::min(guess + 1, 15); ++i)
+                {
+                    int e = 0;
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        const int d = static_cast<int>(texels[t][c]) - palette[i][c];
+                        e += d * d;
+                    }
+                    if (e < bestError)
+                    {
+                        bestError = e;
+                        best = i;
+                    }
+                }
+                indices[t] = static_cast<uint8_t>(best);
+                error += bestError;
+            }
+            return error;
+        }
+
+        // Tries the p-bit combinations for a pair of float endpoints, keeping the best in best. Opaque
+        // blocks only try p-bits of 1, the only way both endpoints reach alpha 255.
+        void TryBC7Endpoints(const Block texels, const float e0[4], const float e1[4], bool opaque, BC7Mode6& best)
+        {
+            for (uint32_t p0 = opaque ? 1 : 0; p0 < 2; ++p0)
+            {
+                for (uint32_t p1 = opaque ? 1 : 0; p1 < 2; ++p1)
+                {
+                    BC7Mode6 candidate;
+                    candidate.p[0] = p0;
+                    candidate.p[1] = p1;
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        candidate.q[0][c] = static_cast<uint32_t>(std::clamp(static_cast<int>(std::lround((e0[c] - p0) * 0.5f)), 0, 127));
+                        candidate.q[1][c] = static_cast<uint32_t>(std::clamp(static_cast<int>(std::lround((e1[c] - p1) * 0.5f)), 0, 127));
+                    }
+                    candidate.error = AssignBC7Indices(texels, candidate, candidate.indices);
+                    if (candidate.error < best.error)
+                        best = candidate;
+                }
+            }
+        }
+
+        void EncodeBC7Block(const Block texels, uint8_t out[16])
+        {
+            float points[16][4];
+            bool opaque = true;
+            for (int t = 0; t < 16; ++t)
+            {
+                for (int c = 0; c < 4; ++c)
+                    points[t][c] = texels[t][c];
+                opaque = opaque && texels[t][3] == 255;
+            }
+            float e0[4], e1[4];
+            FitLine<4>(points, 16, e0, e1);
+            BC7Mode6 best;
+            TryBC7Endpoints(texels, e0, e1, opaque, best);
+
+            for (uint32_t iteration = 0; iteration < kRefineIterations && best.error > 0; ++iteration)
+            {
+                float weights[16];
+                for (int t = 0; t < 16; ++t)
+                    weights[t] = 1.0f - kBC7Weights[best.indices[t]] / 64.0f;
+                if (!SolveEndpoints<4>(points, weights, 16, e0, e1))
+                    break;
+                const int previous = best.error;
+                TryBC7Endpoints(texels, e0, e1, opaque, best);
+                if (best.error >= previous)
+                    break;
+            }
+
+            // The first index is stored without its top bit: swap the endpoints when it is set
+            // (the weight table is symmetric, so 15 - i addresses the same color)
+            if (best.indices[0] >= 8)
+            {
+                std::swap(best.q[0], best.q[1]);
+                std::swap(best.p[0], best.p[1]);
+                for (uint8_t& index : best.indices)
+                    index = static_cast<uint8_t>(15 - index);
+            }
+
+            std::memset(out, 0, 16);
+            BitWriter writer(out);
+            writer.Write(1u << 6, 7);
+            for (int c = 0; c < 4; ++c)
+            {
+                writer.Write(best.q[0][c], 7);
+                writer.Write(best.q[1][c], 7);
+            }
+            writer.Write(best.p[0], 1);
+            writer.Write(best.p[1], 1);
+            for (int t = 0; t < 16; ++t)
+                writer.Write(best.indices[t], t == 0 ? 3 : 4);
+        }
+
+        void EncodeBlock(DataFormat fmt, const Block texels, uint8_t* out)
+        {
+            uint8_t channel[16];
+            switch (fmt)
+            {
+            case DataFormat::BC1_UNorm:
+            case DataFormat::BC1_SRGB:
+                EncodeColorBlock(texels, true, out);
+                break;
+            case DataFormat::BC3_UNorm:
+            case DataFormat::BC3_SRGB:
+                for (int t = 0; t < 16; ++t)
+                    channel[t] = texels[t][3];
+                EncodeAlphaBlock(channel, out);
+                EncodeColorBlock(texels, false, out + 8);
+                break;
+            case DataFormat::BC4_UNorm:
+            case DataFormat::BC5_UNorm:
+                for (int t = 0; t < 16; ++t)
+                    channel[t] = texels[t][0];
+                EncodeAlphaBlock(channel, out);
+                if (fmt == DataFormat::BC5_UNorm)
+                {
+                    for (int t = 0; t < 16; ++t)
+                        channel[t] = texels[t][1];
+                    EncodeAlphaBlock(channel, out + 8);
+                }
+                break;
+            default:
+                EncodeBC7Block(texels, out);
+                break;
+            }
+        }
+    }
+
+    bool CanCompress(DataFormat fmt)
+    {
+        return IsBlockCompressed(fmt);
+    }
+
+    bool CompressImage(DataFormat fmt, const uint8_t* pixels, uint32_t width, uint32_t height, uint8_t* dst)
+    {
+        if (!CanCompress(fmt) || !pixels || !dst || width == 0 || height == 0)
+            return false;
+        const uint32_t blocksX = (width + 3) / 4;
+        const uint32_t blocksY = (height + 3) / 4;
+        const uint32_t blockBytes = GetFormatBlockBytes(fmt);
+        const uint32_t rowsPerJob = std::max(kBlocksPerJob / blocksX, 1u);
+        JobSystem::GetInstance().ParallelFor(blocksY, rowsPerJob, [&](uint32_t begin, uint32_t end) {
+            Block texels;
+            for (uint32_t by = begin; by < end; ++by)
+            {
+                for (uint32_t bx = 0; bx < blocksX; ++bx)
+                {
+                    for (uint32_t y = 0; y < 4; ++y)
+                    {
+                        const uint32_t sy = std::min(by * 4 + y, height - 1);
+                        for (uint32_t x = 0; x < 4; ++x)
+                        {
+                            const uint32_t sx = std::min(bx * 4 + x, width - 1);
+                            std::memcpy(texels[y * 4 + x], pixels + (static_cast<std::size_t>(sy) * width + sx) * 4, 4);
+                        }
+                    }
+                    EncodeBlock(fmt, texels, dst + (static_cast<std::size_t>(by) * blocksX + bx) * blockBytes);
+                }
+            }
+        });
+        return true;
+    }
+
+    bool DecompressImage(DataFormat fmt, const uint8_t* src, uint32_t width, uint32_t height, uint8_t* dst)
+    {
+        if (!IsBlockCompressed(fmt))
+            return false;
+        const uint32_t blocksX = (width + 3) / 4;
+        const uint32_t blocksY = (height + 3) / 4;
+        const uint32_t blockBytes = GetFormatBlockBytes(fmt);
+        bool ok = true;
+        uint8_t texels[16][4];
+        uint8_t channel[16];
+        for (uint32_t by = 0; by < blocksY; ++by)
+        {
+            for (uint32_t bx = 0; bx < blocksX; ++bx)
+            {
+                const uint8_t* block = src + (static_cast<std::size_t>(by) * blocksX + bx) * blockBytes;
+                switch (fmt)
+                {
+                case DataFormat::BC1_UNorm:
+                case DataFormat::BC1_SRGB:
+                    DecodeColorBlock(block, true, texels);
+                    break;
+                case DataFormat::BC3_UNorm:
+                case DataFormat::BC3_SRGB:
+                    DecodeColorBlock(block + 8, false, texels);
+                    DecodeAlphaBlock(block, channel);
+                    for (int t = 0; t < 16; ++t)
+                        texels[t][3] = channel[t];
+                    break;
+                case DataFormat::BC4_UNorm:
+                    DecodeAlphaBlock(block, channel);
+                    for (int t = 0; t < 16; ++t)
+                    {
+                        texels[t][0] = channel[t];
+                        texels[t][1] = texels[t][2] = 0;
+                        texels[t][3] = 255;
+                    }
+                    break;
+                case DataFormat::BC5_UNorm:
+                    DecodeAlphaBlock(block, channel);
+                    for (int t = 0; t < 16; ++t)
+                    {
+                        texels[t][0] = channel[t];
+                        texels[t][2] = 0;
+                        texels[t][3] = 255;
+                    }
+                    DecodeAlphaBlock(block + 8, channel);
+                    for (int t = 0; t < 16; ++t)
+                        texels[t][1] = channel[t];
+                    break;
+                default:
+                    ok = DecodeBC7Block(block, texels) && ok;
+                    break;
+                }
+
+                for (uint32_t y = 0; y < 4 && by * 4 + y < height; ++y)
+                {
+                    for (uint32_t x = 0; x < 4 && bx * 4 + x < width; ++x)
+                    {
+                        const std::size_t dstIndex = static_cast<std::size_t>(by * 4 + y) * width + bx * 4 + x;
+                        std::memcpy(dst + dstIndex * 4, texels[y * 4 + x], 4);
+                    }
+                }
+            }
+        }
+        return ok;
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include "Renderer/Gfx.h"
+
+namespace SoulEngine::Gfx
+{
+    // CPU block compression of tightly packed RGBA8 images. Blocks are fitted along the principal
+    // axis of their texels, then refined by least squares on the chosen indices:
+    //   BC1  4-color blocks; 3-color punch-through blocks when a texel has alpha < 128
+    //   BC3  BC1 color block plus an 8- or 6-value alpha block (whichever fits better)
+    //   BC4  red, BC5 red and green, each as an alpha-style block
+    //   BC7  mode 6 only (one RGBA subset, 7-bit endpoints + p-bits, 4-bit indices)
+    // sRGB variants encode the stored bytes, as the hardware decodes them before conversion.
+
+    // Whether CompressImage can produce fmt
+    bool CanCompress(DataFormat fmt);
+
+    // Encodes an image into GetTextureLevelSize(fmt, width, height) bytes at dst. Rows of blocks are
+    // split across the JobSystem (safe to call from a job); partial edge blocks repeat the last
+    // row / column. Returns false for formats CanCompress rejects.
+    bool CompressImage(DataFormat fmt, const uint8_t* pixels, uint32_t width, uint32_t height, uint8_t* dst);
+
+    // Decodes block compressed data to RGBA8 (BC4 as R,0,0,1 and BC5 as R,G,0,1). BC7 supports mode 6,
+    // what CompressImage writes; blocks in other modes decode to opaque magenta and make the call
+    // return false, as do formats that are not block compressed.
+    bool DecompressImage(DataFormat fmt, const uint8_t* src, uint32_t width, uint32_t height, uint8_t* dst);
+}
@@ -0,0 +1,646 @@
+#include "Renderer/Texture/TextureContainer.h"
+#include "Core/EngineFileIO.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace SoulEngine::Gfx
+{
+    namespace
+    {
+        // ---- DDS ------------------------------------------------------------------------------
+        constexpr uint32_t kDDSMagic = 0x20534444;                  // "DDS "
+        constexpr uint32_t kDDSFlagMipMapCount = 0x20000;
+        constexpr uint32_t kDDSFlagDepth = 0x800000;
+        constexpr uint32_t kDDSPixelAlpha = 0x2;
+        constexpr uint32_t kDDSPixelFourCC = 0x4;
+        constexpr uint32_t kDDSPixelRGB = 0x40;
+        constexpr uint32_t kDDSPixelLuminance = 0x20000;
+        constexpr uint32_t kDDSCaps2Cubemap = 0x200;
+        constexpr uint32_t kDDSCaps2AllFaces = 0xFC00;
+        constexpr uint32_t kDDSCaps2Volume = 0x200000;
+        constexpr uint32_t kDX10Texture1D = 2;
+        constexpr uint32_t kDX10Texture3D = 4;
+        constexpr uint32_t kDX10MiscTextureCube = 0x4;
+
+        struct DDSPixelFormat
+        {
+            uint32_t size;
+            uint32_t flags;
+            uint32_t fourCC;
+            uint32_t rgbBitCount;
+            uint32_t rBitMask;
+            uint32_t gBitMask;
+            uint32_t bBitMask;
+            uint32_t aBitMask;
+        };
+
+        struct DDSHeader
+        {
+            uint32_t size;
+            uint32_t flags;
+            uint32_t height;
+            uint32_t width;
+            uint32_t pitchOrLinearSize;
+            uint32_t depth;
+            uint32_t mipMapCount;
+            uint32_t reserved1[11];
+            DDSPixelFormat pixelFormat;
+            uint32_t caps;
+            uint32_t caps2;
+            uint32_t caps3;
+            uint32_t caps4;
+            uint32_t reserved2;
+        };
+        static_assert(sizeof(DDSHeader) == 124, "DDS_HEADER layout");
+
+        struct DDSHeaderDX10
+        {
+            uint32_t dxgiFormat;
+            uint32_t resourceDimension;
+            uint32_t miscFlag;
+            uint32_t arraySize;
+            uint32_t miscFlags2;
+        };
+        static_assert(sizeof(DDSHeaderDX10) == 20, "DDS_HEADER_DXT10 layout");
+
+        constexpr uint32_t MakeFourCC(char a, char b, char c, char d)
+        {
+            return static_cast<uint32_t>(static_cast<uint8_t>(a)) | (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8)
+                | (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16) | (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+        }
+
+        // ---- KTX2 -----------------------------------------------------------------------------
+        constexpr uint8_t kKTX2Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+        struct KTX2Header
+        {
+            uint8_t identifier[12];
+            uint32_t vkFormat;
+            uint32_t typeSize;
+            uint32_t pixelWidth;
+            uint32_t pixelHeight;
+            uint32_t pixelDepth;
+            uint32_t layerCount;
+            uint32_t faceCount;
+            uint32_t levelCount;
+            uint32_t supercompressionScheme;
+            uint32_t dfdByteOffset;
+            uint32_t dfdByteLength;
+            uint32_t kvdByteOffset;
+            uint32_t kvdByteLength;
+            uint64_t sgdByteOffset;
+            uint64_t sgdByteLength;
+        };
+        static_assert(sizeof(KTX2Header) == 80, "KTX2 header layout");
+
+        struct KTX2LevelIndex
+        {
+            uint64_t byteOffset;
+            uint64_t byteLength;
+            uint64_t uncompressedByteLength;
+        };
+
+        // ---- Formats --------------------------------------------------------------------------
+        struct FormatInfo
+        {
+            uint32_t code;                  // DXGI_FORMAT or VkFormat
+            DataFormat format;              // Unknown when the engine has no equivalent
+            uint8_t blockBytes;             // per texel, or per 4x4 block
+            bool blockCompressed;
+        };
+
+        constexpr FormatInfo kDXGIFormats[] = {
+            { 2, DataFormat::R32G32B32A32_Float, 16, false },
+            { 6, DataFormat::R32G32B32_Float, 12, false },
+            { 10, DataFormat::R16G16B16A16_Float, 8, false },
+            { 11, DataFormat::R16G16B16A16_UNorm, 8, false },
+            { 13, DataFormat::R16G16B16A16_SNorm, 8, false },
+            { 16, DataFormat::R32G32_Float, 8, false },
+            { 24, DataFormat::R10G10B10A2_UNorm, 4, false },
+            { 26, DataFormat::Unknown, 4, false },              // R11G11B10_FLOAT
+            { 28, DataFormat::R8G8B8A8_UNorm, 4, false },
+            { 29, DataFormat::R8G8B8A8_SRGB, 4, false },
+            { 31, DataFormat::R8G8B8A8_SNorm, 4, false },
+            { 34, DataFormat::R16G16_Float, 4, false },
+            { 35, DataFormat::R16G16_UNorm, 4, false },
+            { 37, DataFormat::R16G16_SNorm, 4, false },
+            { 41, DataFormat::R32_Float, 4, false },
+            { 49, DataFormat::R8G8_UNorm, 2, false },
+            { 51, DataFormat::R8G8_SNorm, 2, false },
+            { 54, DataFormat::Unknown, 2, false },              // R16_FLOAT
+            { 56, DataFormat::Unknown, 2, false },              // R16_UNORM
+            { 61, DataFormat::R8_UNorm, 1, false },
+            { 65, DataFormat::Unknown, 1, false },              // A8_UNORM
+            { 67, DataFormat::Unknown, 4, false },              // R9G9B9E5_SHAREDEXP
+            { 71, DataFormat::BC1_UNorm, 8, true },
+            { 72, DataFormat::BC1_SRGB, 8, true },
+            { 74, DataFormat::Unknown, 16, true },              // BC2_UNORM
+            { 75, DataFormat::Unknown, 16, true },              // BC2_UNORM_SRGB
+            { 77, DataFormat::BC3_UNorm, 16, true },
+            { 78, DataFormat::BC3_SRGB, 16, true },
+            { 80, DataFormat::BC4_UNorm, 8, true },
+            { 81, DataFormat::Unknown, 8, true },               // BC4_SNORM
+            { 83, DataFormat::BC5_UNorm, 16, true },
+            { 84, DataFormat::Unknown, 16, true },              // BC5_SNORM
+            { 87, DataFormat::Unknown, 4, false },              // B8G8R8A8_UNORM
+            { 88, DataFormat::Unknown, 4, false },              // B8G8R8X8_UNORM
+            { 91, DataFormat::Unknown, 4, false },              // B8G8R8A8_UNORM_SRGB
+            { 95, DataFormat::Unknown, 16, true },              // BC6H_UF16
+            { 96, DataFormat::Unknown, 16, true },              // BC6H_SF16
+            { 98, DataFormat::BC7_UNorm, 16, true },
+            { 99, DataFormat::BC7_SRGB, 16, true },
+        };
+
+        constexpr FormatInfo kVkFormats[] = {
+            { 9, DataFormat::R8_UNorm, 1, false },
+            { 16, DataFormat::R8G8_UNorm, 2, false },
+            { 17, DataFormat::R8G8_SNorm, 2, false },
+            { 37, DataFormat::R8G8B8A8_UNorm, 4, false },
+            { 38, DataFormat::R8G8B8A8_SNorm, 4, false },
+            { 43, DataFormat::R8G8B8A8_SRGB, 4, false },
+            { 44, DataFormat::Unknown, 4, false },              // B8G8R8A8_UNORM
+            { 50, DataFormat::Unknown, 4, false },              // B8G8R8A8_SRGB
+            { 64, DataFormat::R10G10B10A2_UNorm, 4, false },    // A2B10G10R10_UNORM_PACK32
+            { 70, DataFormat::Unknown, 2, false },              // R16_UNORM
+            { 76, DataFormat::Unknown, 2, false },              // R16_SFLOAT
+            { 77, DataFormat::R16G16_UNorm, 4, false },
+            { 78, DataFormat::R16G16_SNorm, 4, false },
+            { 83, DataFormat::R16G16_Float, 4, false },
+            { 91, DataFormat::R16G16B16A16_UNorm, 8, false },
+            { 92, DataFormat::R16G16B16A16_SNorm, 8, false },
+            { 97, DataFormat::R16G16B16A16_Float, 8, false },
+            { 100, DataFormat::R32_Float, 4, false },
+            { 103, DataFormat::R32G32_Float, 8, false },
+            { 106, DataFormat::R32G32B32_Float, 12, false },
+            { 109, DataFormat::R32G32B32A32_Float, 16, false },
+            { 122, DataFormat::Unknown, 4, false },             // B10G11R11_UFLOAT_PACK32
+            { 123, DataFormat::Unknown, 4, false },             // E5B9G9R9_UFLOAT_PACK32
+            { 131, DataFormat::BC1_UNorm, 8, true },            // BC1_RGB_UNORM_BLOCK
+            { 132, DataFormat::BC1_SRGB, 8, true },             // BC1_RGB_SRGB_BLOCK
+            { 133, DataFormat::BC1_UNorm, 8, true },
+            { 134, DataFormat::BC1_SRGB, 8, true },
+            { 135, DataFormat::Unknown, 16, true },             // BC2_UNORM_BLOCK
+            { 136, DataFormat::Unknown, 16, true },             // BC2_SRGB_BLOCK
+            { 137, DataFormat::BC3_UNorm, 16, true },
+            { 138, DataFormat::BC3_SRGB, 16, true },
+            { 139, DataFormat::BC4_UNorm, 8, true },
+            { 140, DataFormat::Unknown, 8, true },              // BC4_SNORM_BLOCK
+            { 141, DataFormat::BC5_UNorm, 16, true },
+            { 142, DataFormat::Unknown, 16, true },             // BC5_SNORM_BLOCK
+            { 143, DataFormat::Unknown, 16, true },             // BC6H_UFLOAT_BLOCK
+            { 144, DataFormat::Unknown, 16, true },             // BC6H_SFLOAT_BLOCK
+            { 145, DataFormat::BC7_UNorm, 16, true },
+            { 146, DataFormat::BC7_SRGB, 16, true },
+        };
+
+        template <std::size_t N>
+        const FormatInfo* FindFormat(const FormatInfo (&table)[N], uint32_t code)
+        {
+            for (const FormatInfo& info : table)
+            {
+                if (info.code == code)
+                    return &info;
+            }
+            return nullptr;
+        }
+
+        // DXGI_FORMAT for a pre-DX10 pixel format, 0 when there is none
+        uint32_t GetLegacyDXGIFormat(const DDSPixelFormat& pf)
+        {
+            if (pf.flags & kDDSPixelFourCC)
+            {
+                switch (pf.fourCC)
+                {
+                case MakeFourCC('D', 'X', 'T', '1'): return 71;
+                case MakeFourCC('D', 'X', 'T', '2'):
+                case MakeFourCC('D', 'X', 'T', '3'): return 74;
+                case MakeFourCC('D', 'X', 'T', '4'):
+                case MakeFourCC('D', 'X', 'T', '5'): return 77;
+                case MakeFourCC('A', 'T', 'I', '1'):
+                case MakeFourCC('B', 'C', '4', 'U'): return 80;
+                case MakeFourCC('B', 'C', '4', 'S'): return 81;
+                case MakeFourCC('A', 'T', 'I', '2'):
+                case MakeFourCC('B', 'C', '5', 'U'): return 83;
+                case MakeFourCC('B', 'C', '5', 'S'): return 84;
+                // D3DFORMAT values written as the FourCC
+                case 36:  return 11;        // A16B16G16R16
+                case 110: return 13;        // Q16W16V16U16
+                case 111: return 54;        // R16F
+                case 112: return 34;        // G16R16F
+                case 113: return 10;        // A16B16G16R16F
+                case 114: return 41;        // R32F
+                case 115: return 16;        // G32R32F
+                case 116: return 2;         // A32B32G32R32F
+                default:  return 0;
+                }
+            }
+            if ((pf.flags & kDDSPixelRGB) && pf.rgbBitCount == 32)
+            {
+                if (pf.rBitMask == 0x000000ff && pf.gBitMask == 0x0000ff00 && pf.bBitMask == 0x00ff0000)
+                    return 28;
+                if (pf.rBitMask == 0x00ff0000 && pf.gBitMask == 0x0000ff00 && pf.bBitMask == 0x000000ff)
+                    return pf.aBitMask ? 87 : 88;
+                if (pf.rBitMask == 0x0000ffff && pf.gBitMask == 0xffff0000)
+                    return 35;
+                if (pf.rBitMask == 0x000003ff && pf.gBitMask == 0x000ffc00 && pf.bBitMask == 0x3ff00000)
+                    return 24;
+                if (pf.rBitMask == 0xffffffff)
+                    return 41;
+                return 0;
+            }
+            if (pf.flags & kDDSPixelLuminance)
+            {
+                if (pf.rgbBitCount == 8)
+                    return 61;
+                if (pf.rgbBitCount == 16)
+                    return pf.aBitMask ? 49 : 56;
+                return 0;
+            }
+            if ((pf.flags & kDDSPixelAlpha) && pf.rgbBitCount == 8)
+                return 65;
+            return 0;
+        }
+
+        // Largest texture the backends can create (D3D12 / Vulkan minimum limits); anything larger is a corrupt header
+        constexpr uint32_t kMaxDimension = 16384;
+        constexpr uint32_t kMaxDepth = 2048;
+        constexpr uint32_t kMaxLayers = 2048;
+
+        bool IsWithinLimits(uint32_t width, uint32_t height, uint32_t depth, uint32_t arraySize, uint32_t faceCount)
+        {
+            // arraySize is checked first so arraySize * faceCount (faceCount <= 6) cannot overflow
+            return width <= kMaxDimension && height <= kMaxDimension && depth <= kMaxDepth && arraySize <= kMaxLayers
+                && arraySize * faceCount <= kMaxLayers;
+        }
+
+        // Fills the pitches and size of a range from its dimensions; false when it would exceed maxSize bytes
+        bool SetRangeSize(TextureSubresourceRange& range, uint32_t blockBytes, bool blockCompressed, uint64_t maxSize)
+        {
+            uint64_t rowPitch, slicePitch;
+            if (blockCompressed)
+            {
+                rowPitch = static_cast<uint64_t>((range.width + 3) / 4) * blockBytes;
+                slicePitch = rowPitch * ((range.height + 3) / 4);
+            }
+            else
+            {
+                rowPitch = static_cast<uint64_t>(range.width) * blockBytes;
+                slicePitch = rowPitch * range.height;
+            }
+            // Within the dimension limits none of these products can wrap in 64 bits
+            const uint64_t size = slicePitch * range.depth;
+            if (size > maxSize)
+                return false;
+            range.rowPitch = static_cast<std::size_t>(rowPitch);
+            range.slicePitch = static_cast<std::size_t>(slicePitch);
+            range.size = static_cast<std::size_t>(size);
+            return true;
+        }
+
+        const TextureSubresourceRange kEmptyRange{};
+    }
+
+    bool TextureContainer::Open(const std::string& path)
+    {
+        MappedFile file = EngineFileIO::MapFile(path);
+        if (!file)
+        {
+            Logger::Error("TextureContainer: cannot open {}", path);
+            return false;
+        }
+        return Open(std::move(file), std::filesystem::path(path).filename().string());
+    }
+
+    bool TextureContainer::Open(MappedFile file, const std::string& name)
+    {
+        Close();
+        const uint8_t* data = file.Data();
+        const std::size_t size = file.Size();
+
+        Layout layout;
+        std::vector<TextureSubresourceRange> ranges;
+        TextureContainerType type = TextureContainerType::DDS;
+        uint32_t magic = 0;
+        if (size >= sizeof(magic))
+            std::memcpy(&magic, data, sizeof(magic));
+        if (magic == kDDSMagic)
+        {
+            if (!ParseDDS(data, size, name, layout, ranges))
+                return false;
+        }
+        else if (size >= sizeof(kKTX2Identifier) && std::memcmp(data, kKTX2Identifier, sizeof(kKTX2Identifier)) == 0)
+        {
+            type = TextureContainerType::KTX2;
+            if (!ParseKTX2(data, size, name, layout, ranges))
+                return false;
+        }
+        else
+        {
+            Logger::Error("TextureContainer: {} is neither a DDS nor a KTX2 file", name);
+            return false;
+        }
+
+        file_ = std::move(file);
+        name_ = name;
+        type_ = type;
+        const uint32_t layers = layout.arraySize * layout.faceCount;
+        desc_.type = layers > 1 ? TextureType::Texture2DArray : TextureType::Texture2D;
+        desc_.format = layout.format;
+        desc_.width = layout.width;
+        desc_.height = layout.height;
+        desc_.arrayLayers = layers;
+        desc_.mipLevels = layout.mipLevels;
+        desc_.name = name_.c_str();
+        depth_ = layout.depth;
+        faceCount_ = layout.faceCount;
+        sourceFormat_ = layout.sourceFormat;
+        blockCompressed_ = layout.blockCompressed;
+        ranges_ = std::move(ranges);
+        return true;
+    }
+
+    bool TextureContainer::ParseDDS(const uint8_t* data, std::size_t size, const std::string& name, Layout& layout,
+                                    std::vector<TextureSubresourceRange>& ranges) const
+    {
+        DDSHeader header{};
+        if (size < sizeof(uint32_t) + sizeof(header))
+        {
+            Logger::Error("TextureContainer: {} is too small for a DDS header", name);
+            return false;
+        }
+        std::memcpy(&header, data + sizeof(uint32_t), sizeof(header));
+        if (header.size != sizeof(DDSHeader) || header.pixelFormat.size != sizeof(DDSPixelFormat))
+        {
+            Logger::Error("TextureContainer: {} has an invalid DDS header", name);
+            return false;
+        }
+        std::size_t offset = sizeof(uint32_t) + sizeof(header);
+
+        layout.width = header.width;
+        layout.height = header.height;
+        layout.mipLevels = (header.flags & kDDSFlagMipMapCount) && header.mipMapCount ? header.mipMapCount : 1;
+        if ((header.pixelFormat.flags & kDDSPixelFourCC) && header.pixelFormat.fourCC == MakeFourCC('D', 'X', '1', '0'))
+        {
+            DDSHeaderDX10 dx10{};
+            if (size - offset < sizeof(dx10))
+            {
+                Logger::Error("TextureContainer: {} is too small for a DX10 header", name);
+                return false;
+            }
+            std::memcpy(&dx10, data + offset, sizeof(dx10));
+            offset += sizeof(dx10);
+            layout.sourceFormat = dx10.dxgiFormat;
+            layout.arraySize = dx10.arraySize;
+            if (dx10.resourceDimension == kDX10Texture1D)
+                layout.height = 1;
+            else if (dx10.resourceDimension == kDX10Texture3D)
+                layout.depth = header.depth;
+            if (dx10.miscFlag & kDX10MiscTextureCube)
+                layout.faceCount = 6;
+        }
+        else
+        {
+            layout.sourceFormat = GetLegacyDXGIFormat(header.pixelFormat);
+            if ((header.caps2 & kDDSCaps2Volume) && (header.flags & kDDSFlagDepth))
+                layout.depth = header.depth;
+            if (header.caps2 & kDDSCaps2Cubemap)
+            {
+                // Partial cube maps cannot be created on any backend we target
+                if ((header.caps2 & kDDSCaps2AllFaces) != kDDSCaps2AllFaces)
+                {
+                    Logger::Error("TextureContainer: {} is a cube map without all six faces", name);
+                    return false;
+                }
+                layout.faceCount = 6;
+            }
+        }
+
+        const FormatInfo* info = FindFormat(kDXGIFormats, layout.sourceFormat);
+        if (!info)
+        {
+            Logger::Error("TextureContainer: {} has an unsupported pixel format (DXGI {}, FourCC {:#x})", name,
+                          layout.sourceFormat, header.pixelFormat.fourCC);
+            return false;
+        }
+        layout.format = info->format;
+        layout.blockBytes = info->blockBytes;
+        layout.blockCompressed = info->blockCompressed;
+
+        const uint32_t largest = std::max({ layout.width, layout.height, layout.depth });
+        if (layout.width == 0 || layout.height == 0 || layout.depth == 0 || layout.arraySize == 0
+            || layout.mipLevels > GetMipLevelCount(largest, 1) || (layout.depth > 1 && layout.arraySize * layout.faceCount > 1)
+            || (layout.faceCount == 6 && layout.width != layout.height)
+            || !IsWithinLimits(layout.width, layout.height, layout.depth, layout.arraySize, layout.faceCount))
+        {
+            Logger::Error("TextureContainer: {} has an invalid DDS header", name);
+            return false;
+        }
+
+        // DDS stores each layer's whole mip chain before the next layer; every subresource takes at least a byte
+        const uint32_t layers = layout.arraySize * layout.faceCount;
+        if (static_cast<uint64_t>(layers) * layout.mipLevels > size - offset)
+        {
+            Logger::Error("TextureContainer: {} is too small for {} layers of {} mips", name, layers, layout.mipLevels);
+            return false;
+        }
+        ranges.resize(static_cast<std::size_t>(layers) * layout.mipLevels);
+        for (uint32_t layer = 0; layer < layers; ++layer)
+        {
+            for (uint32_t mip = 0; mip < layout.mipLevels; ++mip)
+            {
+                TextureSubresourceRange& range = ranges[static_cast<std::size_t>(layer) * layout.mipLevels + mip];
+                range.width = std::max(layout.width >> mip, 1u);
+                range.height = std::max(layout.height >> mip, 1u);
+                range.depth = std::max(layout.depth >> mip, 1u);
+                if (!SetRangeSize(range, layout.blockBytes, layout.blockCompressed, size - offset))
+                {
+                    Logger::Error("TextureContainer: {} is truncated at layer {} mip {}", name, layer, mip);
+                    return false;
+                }
+                range.offset = offset;
+                offset += range.size;
+            }
+        }
+        return true;
+    }
+
+    bool TextureContainer::ParseKTX2(const uint8_t* data, std::size_t size, const std::string& name, Layout& layout,
+                                     std::vector<TextureSubresourceRange>& ranges) const
+    {
+        KTX2Header header{};
+        if (size < sizeof(header))
+        {
+            Logger::Error("TextureContainer: {} is too small for a KTX2 header", name);
+            return false;
+        }
+        std::memcpy(&header, data, sizeof(header));
+        if (header.vkFormat == 0 || header.supercompressionScheme != 0)
+        {
+            Logger::Error("TextureContainer: {} is supercompressed (Basis Universal / Zstd), which is not supported", name);
+            return false;
+        }
+        const FormatInfo* info = FindFormat(kVkFormats, header.vkFormat);
+        if (!info)
+        {
+            Logger::Error("TextureContainer: {} has an unsupported VkFormat {}", name, header.vkFormat);
+            return false;
+        }
+        layout.sourceFormat = header.vkFormat;
+        layout.format = info->format;
+        layout.blockBytes = info->blockBytes;
+        layout.blockCompressed = info->blockCompressed;
+
+        // Zero height / depth / layer / level counts mean 1D, 2D, not an array and "generate mips"
+        layout.width = header.pixelWidth;
+        layout.height = std::max(header.pixelHeight, 1u);
+        layout.depth = std::max(header.pixelDepth, 1u);
+        layout.arraySize = std::max(header.layerCount, 1u);
+        layout.faceCount = header.faceCount;
+        layout.mipLevels = std::max(header.levelCount, 1u);
+        const uint32_t largest = std::max({ layout.width, layout.height, layout.depth });
+        if (layout.width == 0 || (layout.faceCount != 1 && layout.faceCount != 6)
+            || (layout.faceCount == 6 && (layout.width != layout.height || layout.depth > 1))
+            || (layout.depth > 1 && layout.arraySize > 1) || layout.mipLevels > GetMipLevelCount(largest, 1)
+            || (info->blockCompressed && layout.depth > 1)
+            || !IsWithinLimits(layout.width, layout.height, layout.depth, layout.arraySize, layout.faceCount))
+        {
+            Logger::Error("TextureContainer: {} has an invalid KTX2 header", name);
+            return false;
+        }
+
+        const std::size_t indexOffset = sizeof(header);
+        if ((size - indexOffset) / sizeof(KTX2LevelIndex) < layout.mipLevels)
+        {
+            Logger::Error("TextureContainer: {} is truncated in the level index", name);
+            return false;
+        }
+
+        // Within a level: layers, then faces, then depth slices; engine layer = layer * faces + face
+        const uint32_t layers = layout.arraySize * layout.faceCount;
+        if (static_cast<uint64_t>(layers) * layout.mipLevels > size - indexOffset)
+        {
+            Logger::Error("TextureContainer: {} is too small for {} layers of {} mips", name, layers, layout.mipLevels);
+            return false;
+        }
+        ranges.resize(static_cast<std::size_t>(layers) * layout.mipLevels);
+        for (uint32_t mip = 0; mip < layout.mipLevels; ++mip)
+        {
+            KTX2LevelIndex level{};
+            std::memcpy(&level, data + indexOffset + sizeof(KTX2LevelIndex) * mip, sizeof(level));
+
+            TextureSubresourceRange shape;
+            shape.width = std::max(layout.width >> mip, 1u);
+            shape.height = std::max(layout.height >> mip, 1u);
+            shape.depth = std::max(layout.depth >> mip, 1u);
+            const bool fits = SetRangeSize(shape, layout.blockBytes, layout.blockCompressed, size / layers);
+            const uint64_t expected = static_cast<uint64_t>(shape.size) * layers;
+            if (!fits || level.byteLength != expected || level.uncompressedByteLength != expected
+                || level.byteOffset > size || size - level.byteOffset < level.byteLength)
+            {
+                Logger::Error("TextureContainer: {} has an invalid level {} (offset {}, {} bytes, expected {})", name, mip,
+                              level.byteOffset, level.byteLength, expected);
+                return false;
+            }
+            for (uint32_t layer = 0; layer < layers; ++layer)
+            {
+                TextureSubresourceRange& range = ranges[static_cast<std::size_t>(layer) * layout.mipLevels + mip];
+                range = shape;
+                range.offset = static_cast<std::size_t>(level.byteOffset) + shape.size * layer;
+            }
+        }
+        return true;
+    }
+
+    void TextureContainer::Close()
+    {
+        ranges_.clear();
+        file_.Close();
+        desc_ = {};
+        name_.clear();
+        depth_ = 1;
+        faceCount_ = 1;
+        sourceFormat_ = 0;
+        blockCompressed_ = false;
+    }
+
+    const TextureSubresourceRange& TextureContainer::GetRange(uint32_t mip, uint32_t layer) const
+    {
+        if (mip >= desc_.mipLevels || layer >= desc_.arrayLayers)
+            return kEmptyRange;
+        return ranges_[static_cast<std::size_t>(layer) * desc_.mipLevels + mip];
+    }
+
+    SubresourceData TextureContainer::GetLevel(uint32_t mip, uint32_t layer) const
+    {
+        SubresourceData level{};
+        const TextureSubresourceRange& range = GetRange(mip, layer);
+        if (range.size == 0)
+            return level;
+        level.data = file_.Data() + range.offset;
+        level.size = range.size;
+        return level;
+    }
+
+    SubresourceData TextureContainer::GetSlice(uint32_t mip, uint32_t layer, uint32_t slice) const
+    {
+        SubresourceData level{};
+        const TextureSubresourceRange& range = GetRange(mip, layer);
+        if (range.size == 0 || slice >= range.depth)
+            return level;
+        level.data = file_.Data() + range.offset + range.slicePitch * slice;
+        level.size = range.slicePitch;
+        return level;
+    }
+
+    std::vector<SubresourceData> TextureContainer::GetSubresources(uint32_t firstMip, uint32_t mipCount) const
+    {
+        std::vector<SubresourceData> subresources;
+        if (firstMip >= desc_.mipLevels)
+            return subresources;
+        mipCount = std::min(mipCount, desc_.mipLevels - firstMip);
+        subresources.reserve(static_cast<std::size_t>(desc_.arrayLayers) * mipCount);
+        for (uint32_t layer = 0; layer < desc_.arrayLayers; ++layer)
+        {
+            for (uint32_t i = 0; i < mipCount; ++i)
+                subresources.push_back(GetLevel(firstMip + i, layer));
+        }
+        return subresources;
+    }
+
+    std::shared_ptr<ITexture> TextureContainer::CreateTexture(IDevice* device, uint32_t firstMip) const
+    {
+        if (!IsOpen() || !device)
+            return nullptr;
+        if (desc_.format == DataFormat::Unknown || depth_ > 1)
+        {
+            Logger::Error("TextureContainer: {} has no engine texture equivalent (format {}, depth {})", name_, sourceFormat_, depth_);
+            return nullptr;
+        }
+        firstMip = std::min(firstMip, desc_.mipLevels - 1);
+        TextureDesc desc = desc_;
+        desc.width = std::max(desc_.width >> firstMip, 1u);
+        desc.height = std::max(desc_.height >> firstMip, 1u);
+        desc.mipLevels = desc_.mipLevels - firstMip;
+        const std::vector<SubresourceData> initial = GetSubresources(firstMip);
+        return device->CreateTexture(desc, initial.data());
+    }
+
+    bool TextureContainerSource::LoadMips(uint32_t firstMip, uint32_t mipCount, std::vector<std::vector<uint8_t>>& out)
+    {
+        const TextureDesc& desc = container_->GetDesc();
+        if (!container_->IsOpen() || desc.format == DataFormat::Unknown || container_->GetDepth() > 1
+            || firstMip + mipCount > desc.mipLevels)
+            return false;
+        // The streamer owns its staging copies, so this is the one copy out of the mapping
+        const std::vector<SubresourceData> levels = container_->GetSubresources(firstMip, mipCount);
+        out.resize(levels.size());
+        for (std::size_t i = 0; i < levels.size(); ++i)
+        {
+            const auto* data = static_cast<const uint8_t*>(levels[i].data);
+            out[i].assign(data, data + levels[i].size);
+        }
+        return true;
+    }
+}
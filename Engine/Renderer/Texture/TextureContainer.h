@@ -0,0 +1,122 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Define.h"
+#include "Core/MappedFile.h"
+#include "Renderer/Gfx.h"
+#include "Renderer/Texture/TextureSource.h"
+
+namespace SoulEngine::Gfx
+{
+    enum class TextureContainerType : uint8_t { DDS, KTX2 };
+
+    // Where one subresource (mip, layer) lives in the file. Volume textures keep their depth slices
+    // back to back, slicePitch apart; everything else has depth 1 and size == slicePitch.
+    struct TextureSubresourceRange
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t depth = 1;
+        std::size_t offset = 0;             // from the start of the file
+        std::size_t size = 0;               // all depth slices
+        std::size_t rowPitch = 0;           // one row of texels, or of 4x4 blocks for BC formats
+        std::size_t slicePitch = 0;
+    };
+
+    /**
+     * @brief 只读映射的 DDS（含 DX10 扩展头）与 KTX2 容器，与平台和图形 API 无关。
+     * 打开时校验头信息并计算每个 mip / 数组层 / 深度切片的字节范围，之后取到的都是映射内存里的指针，不做拷贝。
+     * 层编号按 D3D 约定为 数组下标 * 面数 + 面，立方体贴图因此是 6 的倍数个层。
+     * 引擎没有对应 DataFormat 的格式（BC2、BC6H、BGRA8 等）仍可打开并取得字节范围，GetDesc().format 为 Unknown，
+     * GetSourceFormat 返回文件中的 DXGI_FORMAT / VkFormat。KTX2 的超压缩（Basis、Zstd）不支持。
+     *
+     * 使用方式:
+     *   TextureContainer container;
+     *   if (container.Open("Texture/skybox.dds"))
+     *   {
+     *       SubresourceData mip2 = container.GetLevel(2, 0);     // 指向映射内存
+     *       texture = container.CreateTexture(device);           // 格式受支持时直接从映射上传
+     *   }
+     */
+    class TextureContainer
+    {
+        NON_COPY_AND_MOVE(TextureContainer)  // desc_.name points into name_
+
+    public:
+        TextureContainer() = default;
+
+        // Picks the parser from the file's magic; .dds and .ktx2 need not be the extension
+        bool Open(const std::string& path);
+        bool Open(MappedFile file, const std::string& name);
+        bool IsOpen() const { return !ranges_.empty(); }
+        void Close();
+
+        TextureContainerType GetType() const { return type_; }
+        // arrayLayers counts cube faces; type is Texture2DArray for more than one layer
+        const TextureDesc& GetDesc() const { return desc_; }
+        uint32_t GetDepth() const { return depth_; }
+        uint32_t GetFaceCount() const { return faceCount_; }
+        bool IsCubemap() const { return faceCount_ == 6; }
+        // DXGI_FORMAT for DDS (legacy pixel formats are translated), VkFormat for KTX2
+        uint32_t GetSourceFormat() const { return sourceFormat_; }
+        bool IsBlockCompressedFormat() const { return blockCompressed_; }
+
+        // Empty range / data when out of range
+        const TextureSubresourceRange& GetRange(uint32_t mip, uint32_t layer) const;
+        SubresourceData GetLevel(uint32_t mip, uint32_t layer) const;
+        SubresourceData GetSlice(uint32_t mip, uint32_t layer, uint32_t slice) const;
+
+        // Layer-major [layer * mipCount + i] subresources of mips [firstMip, firstMip + mipCount),
+        // the layout IDevice::CreateTexture takes
+        std::vector<SubresourceData> GetSubresources(uint32_t firstMip = 0, uint32_t mipCount = UINT32_MAX) const;
+
+        // Creates the texture from mips [firstMip, end) straight from the mapping. Needs a format the
+        // engine knows and depth 1; cube maps come out as 2D arrays of their faces.
+        std::shared_ptr<ITexture> CreateTexture(IDevice* device, uint32_t firstMip = 0) const;
+
+    private:
+        struct Layout
+        {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            uint32_t depth = 1;
+            uint32_t mipLevels = 1;
+            uint32_t arraySize = 1;
+            uint32_t faceCount = 1;
+            uint32_t sourceFormat = 0;
+            DataFormat format = DataFormat::Unknown;
+            uint32_t blockBytes = 0;        // per texel, or per 4x4 block when blockCompressed
+            bool blockCompressed = false;
+        };
+
+        bool ParseDDS(const uint8_t* data, std::size_t size, const std::string& name, Layout& layout,
+                      std::vector<TextureSubresourceRange>& ranges) const;
+        bool ParseKTX2(const uint8_t* data, std::size_t size, const std::string& name, Layout& layout,
+                       std::vector<TextureSubresourceRange>& ranges) const;
+
+        MappedFile file_;
+        std::string name_;
+        TextureContainerType type_ = TextureContainerType::DDS;
+        TextureDesc desc_{};
+        uint32_t depth_ = 1;
+        uint32_t faceCount_ = 1;
+        uint32_t sourceFormat_ = 0;
+        bool blockCompressed_ = false;
+        std::vector<TextureSubresourceRange> ranges_;   // [layer * mipLevels + mip]
+    };
+
+    // Streams mips out of a DDS / KTX2 container for the TextureStreamer (2D formats the engine knows)
+    class TextureContainerSource final : public ITextureMipSource
+    {
+    public:
+        explicit TextureContainerSource(std::shared_ptr<const TextureContainer> container) : container_(std::move(container)) {}
+
+        const TextureDesc& GetDesc() const override { return container_->GetDesc(); }
+        bool LoadMips(uint32_t firstMip, uint32_t mipCount, std::vector<std::vector<uint8_t>>& out) override;
+
+    private:
+        std::shared_ptr<const TextureContainer> container_;
+    };
+}
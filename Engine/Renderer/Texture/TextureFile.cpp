@@ -0,0 +1,355 @@
+#include "Renderer/Texture/TextureFile.h"
+#include "Core/EngineFileIO.h"
+#include "Core/JobSystem.h"
+#include "Renderer/Texture/TextureCompression.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace SoulEngine::Gfx
+{
+    namespace
+    {
+        double ElapsedMs(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        std::size_t AlignUp(std::size_t value)
+        {
+            return (value + kTextureFileAlignment - 1) & ~static_cast<std::size_t>(kTextureFileAlignment - 1);
+        }
+
+        bool IsSupportedFormat(uint32_t format)
+        {
+            return format <= static_cast<uint32_t>(DataFormat::BC7_SRGB)
+                && GetFormatBlockBytes(static_cast<DataFormat>(format)) != 0;
+        }
+
+        // The stored format of a cook, Unknown when it cannot be produced
+        DataFormat GetCookFormat(DataFormat format, bool srgb)
+        {
+            switch (format)
+            {
+            case DataFormat::R8G8B8A8_UNorm:
+            case DataFormat::R8G8B8A8_SRGB:
+                return srgb ? DataFormat::R8G8B8A8_SRGB : DataFormat::R8G8B8A8_UNorm;
+            case DataFormat::BC1_UNorm:
+            case DataFormat::BC1_SRGB:
+                return srgb ? DataFormat::BC1_SRGB : DataFormat::BC1_UNorm;
+            case DataFormat::BC3_UNorm:
+            case DataFormat::BC3_SRGB:
+                return srgb ? DataFormat::BC3_SRGB : DataFormat::BC3_UNorm;
+            case DataFormat::BC7_UNorm:
+            case DataFormat::BC7_SRGB:
+                return srgb ? DataFormat::BC7_SRGB : DataFormat::BC7_UNorm;
+            case DataFormat::BC4_UNorm:
+            case DataFormat::BC5_UNorm:
+                return srgb ? DataFormat::Unknown : format;
+            default:
+                return DataFormat::Unknown;
+            }
+        }
+    }
+
+    bool TextureFile::Open(const std::string& path)
+    {
+        MappedFile file = EngineFileIO::MapFile(path);
+        if (!file)
+        {
+            Logger::Error("TextureFile: cannot open {}", path);
+            return false;
+        }
+        return Open(std::move(file), std::filesystem::path(path).filename().string());
+    }
+
+    bool TextureFile::Open(MappedFile file, const std::string& name)
+    {
+        Close();
+        const uint8_t* data = file.Data();
+        const std::size_t size = file.Size();
+
+        RuntimeTextureHeader header{};
+        if (size < sizeof(header))
+        {
+            Logger::Error("TextureFile: {} is too small", name);
+            return false;
+        }
+        std::memcpy(&header, data, sizeof(header));
+        if (header.magic != kTextureFileMagic || header.version != kTextureFileVersion)
+        {
+            Logger::Error("TextureFile: {} is not a version {} .stex file", name, kTextureFileVersion);
+            return false;
+        }
+        if (!IsSupportedFormat(header.format) || header.width == 0 || header.height == 0 || header.arrayLayers == 0
+            || header.mipLevels == 0 || header.mipLevels > GetMipLevelCount(header.width, header.height)
+            || header.type > static_cast<uint32_t>(TextureType::Texture2DArray)
+            || header.dataSize != size - sizeof(header))
+        {
+            Logger::Error("TextureFile: {} has an invalid header", name);
+            return false;
+        }
+
+        const DataFormat format = static_cast<DataFormat>(header.format);
+        std::vector<MipLevelHeader> mipHeaders(header.mipLevels);
+        std::vector<const uint8_t*> mipData(header.mipLevels);
+        std::size_t offset = sizeof(header);
+        for (uint32_t mip = 0; mip < header.mipLevels; ++mip)
+        {
+            MipLevelHeader& level = mipHeaders[mip];
+            if (size - offset < sizeof(level))
+            {
+                Logger::Error("TextureFile: {} is truncated at mip {}", name, mip);
+                return false;
+            }
+            std::memcpy(&level, data + offset, sizeof(level));
+            offset += sizeof(level);
+
+            const uint32_t width = std::max(header.width >> mip, 1u);
+            const uint32_t height = std::max(header.height >> mip, 1u);
+            const std::size_t layerSize = GetTextureLevelSize(format, width, height);
+            if (level.width != width || level.height != height || level.layerSize != layerSize
+                || level.dataSize != static_cast<uint64_t>(layerSize) * header.arrayLayers
+                || size - offset < level.dataSize)
+            {
+                Logger::Error("TextureFile: {} has an invalid mip {} header", name, mip);
+                return false;
+            }
+            mipData[mip] = data + offset;
+            offset = std::min(AlignUp(offset + level.dataSize), size);
+        }
+
+        file_ = std::move(file);
+        name_ = name;
+        desc_.type = static_cast<TextureType>(header.type);
+        desc_.format = format;
+        desc_.width = header.width;
+        desc_.height = header.height;
+        desc_.arrayLayers = header.arrayLayers;
+        desc_.mipLevels = header.mipLevels;
+        desc_.name = name_.c_str();
+        mipHeaders_ = std::move(mipHeaders);
+        mipData_ = std::move(mipData);
+        return true;
+    }
+
+    void TextureFile::Close()
+    {
+        mipHeaders_.clear();
+        mipData_.clear();
+        file_.Close();
+        desc_ = {};
+        name_.clear();
+    }
+
+    SubresourceData TextureFile::GetLevel(uint32_t mip, uint32_t layer) const
+    {
+        SubresourceData level{};
+        if (mip >= mipData_.size() || layer >= desc_.arrayLayers)
+            return level;
+        const std::size_t layerSize = mipHeaders_[mip].layerSize;
+        level.data = mipData_[mip] + layerSize * layer;
+        level.size = layerSize;
+        return level;
+    }
+
+    std::vector<SubresourceData> TextureFile::GetSubresources(uint32_t firstMip, uint32_t mipCount) const
+    {
+        std::vector<SubresourceData> subresources;
+        if (firstMip >= desc_.mipLevels)
+            return subresources;
+        mipCount = std::min(mipCount, desc_.mipLevels - firstMip);
+        subresources.reserve(static_cast<std::size_t>(desc_.arrayLayers) * mipCount);
+        for (uint32_t layer = 0; layer < desc_.arrayLayers; ++layer)
+        {
+            for (uint32_t i = 0; i < mipCount; ++i)
+                subresources.push_back(GetLevel(firstMip + i, layer));
+        }
+        return subresources;
+    }
+
+    std::shared_ptr<ITexture> TextureFile::CreateTexture(IDevice* device, uint32_t firstMip) const
+    {
+        if (!IsOpen() || !device)
+            return nullptr;
+        firstMip = std::min(firstMip, desc_.mipLevels - 1);
+        TextureDesc desc = desc_;
+        desc.width = std::max(desc_.width >> firstMip, 1u);
+        desc.height = std::max(desc_.height >> firstMip, 1u);
+        desc.mipLevels = desc_.mipLevels - firstMip;
+        const std::vector<SubresourceData> initial = GetSubresources(firstMip);
+        return device->CreateTexture(desc, initial.data());
+    }
+
+    std::size_t TextureFile::GetDataSize() const
+    {
+        std::size_t size = 0;
+        for (const MipLevelHeader& level : mipHeaders_)
+            size += level.dataSize;
+        return size;
+    }
+
+    bool WriteTextureFile(const std::string& path, const TextureDesc& desc, const std::vector<std::vector<uint8_t>>& levels)
+    {
+        const uint32_t layers = std::max(desc.arrayLayers, 1u);
+        const uint32_t mipLevels = std::max(desc.mipLevels, 1u);
+        if (levels.size() != static_cast<std::size_t>(layers) * mipLevels || !IsSupportedFormat(static_cast<uint32_t>(desc.format))
+            || mipLevels > GetMipLevelCount(desc.width, desc.height))
+        {
+            Logger::Error("WriteTextureFile: {} levels do not describe a {}x{} texture with {} layers and {} mips",
+                          levels.size(), desc.width, desc.height, layers, mipLevels);
+            return false;
+        }
+
+        RuntimeTextureHeader header{};
+        header.width = desc.width;
+        header.height = desc.height;
+        header.format = static_cast<uint32_t>(desc.format);
+        header.mipLevels = mipLevels;
+        header.arrayLayers = layers;
+        header.type = static_cast<uint32_t>(desc.type);
+
+        // Build the whole file in memory and write it with one call
+        std::vector<uint8_t> body;
+        for (uint32_t mip = 0; mip < mipLevels; ++mip)
+        {
+            MipLevelHeader level{};
+            level.width = std::max(desc.width >> mip, 1u);
+            level.height = std::max(desc.height >> mip, 1u);
+            const std::size_t layerSize = GetTextureLevelSize(desc.format, level.width, level.height);
+            if (layerSize * layers > UINT32_MAX)
+            {
+                Logger::Error("WriteTextureFile: mip {} of {} exceeds 4 GiB", mip, path);
+                return false;
+            }
+            level.layerSize = static_cast<uint32_t>(layerSize);
+            level.dataSize = level.layerSize * layers;
+
+            const std::size_t start = body.size();
+            body.resize(start + sizeof(level) + level.dataSize);
+            std::memcpy(body.data() + start, &level, sizeof(level));
+            for (uint32_t layer = 0; layer < layers; ++layer)
+            {
+                const std::vector<uint8_t>& src = levels[static_cast<std::size_t>(layer) * mipLevels + mip];
+                if (src.size() != level.layerSize)
+                {
+                    Logger::Error("WriteTextureFile: mip {} layer {} has {} bytes, expected {}", mip, layer, src.size(), level.layerSize);
+                    return false;
+                }
+                std::memcpy(body.data() + start + sizeof(level) + static_cast<std::size_t>(layer) * level.layerSize, src.data(), src.size());
+            }
+            if (mip + 1 < mipLevels)
+                body.resize(AlignUp(sizeof(header) + body.size()) - sizeof(header), 0);
+        }
+        header.dataSize = body.size();
+
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file)
+        {
+            Logger::Error("WriteTextureFile: cannot create {}", path);
+            return false;
+        }
+        bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+        ok = ok && (body.empty() || std::fwrite(body.data(), body.size(), 1, file) == 1);
+        ok = std::fclose(file) == 0 && ok;
+        if (!ok)
+            Logger::Error("WriteTextureFile: failed to write {}", path);
+        else
+            EngineFileIO::NotifyFileChanged(path, true);
+        return ok;
+    }
+
+    bool ParseCookFormat(const std::string& name, DataFormat& format)
+    {
+        static const std::pair<const char*, DataFormat> kNames[] = {
+            { "rgba8", DataFormat::R8G8B8A8_UNorm },
+            { "bc1", DataFormat::BC1_UNorm },
+            { "bc3", DataFormat::BC3_UNorm },
+            { "bc4", DataFormat::BC4_UNorm },
+            { "bc5", DataFormat::BC5_UNorm },
+            { "bc7", DataFormat::BC7_UNorm },
+        };
+        for (const auto& [entryName, entryFormat] : kNames)
+        {
+            if (name == entryName)
+            {
+                format = entryFormat;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool CookTexture(const std::vector<std::string>& sourcePaths, const TextureCookOptions& options,
+                     const std::string& outputPath, TextureCookStats* stats)
+    {
+        const DataFormat format = GetCookFormat(options.format, options.srgb);
+        if (format == DataFormat::Unknown)
+        {
+            Logger::Error("CookTexture: cannot cook {} as format {}{}", outputPath, static_cast<uint32_t>(options.format), options.srgb ? " (sRGB)" : "");
+            return false;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        ImageFileTextureSource source(sourcePaths, options.srgb, options.mipFilter);
+        if (!source.IsValid())
+            return false;
+        TextureDesc desc = source.GetDesc();
+        std::vector<std::vector<uint8_t>> levels;
+        if (!source.LoadMips(0, desc.mipLevels, levels))
+            return false;
+        TextureCookStats result;
+        result.decodeMs = ElapsedMs(start);
+
+        if (IsBlockCompressed(format))
+        {
+            // One job per layer; CompressImage splits each level again, ParallelFor nests safely
+            start = std::chrono::steady_clock::now();
+            JobSystem::GetInstance().ParallelFor(desc.arrayLayers, 1, [&](uint32_t begin, uint32_t end) {
+                for (uint32_t layer = begin; layer < end; ++layer)
+                {
+                    for (uint32_t mip = 0; mip < desc.mipLevels; ++mip)
+                    {
+                        std::vector<uint8_t>& level = levels[static_cast<std::size_t>(layer) * desc.mipLevels + mip];
+                        const uint32_t width = std::max(desc.width >> mip, 1u);
+                        const uint32_t height = std::max(desc.height >> mip, 1u);
+                        std::vector<uint8_t> blocks(GetTextureLevelSize(format, width, height));
+                        CompressImage(format, level.data(), width, height, blocks.data());
+                        level.swap(blocks);
+                    }
+                }
+            });
+            desc.format = format;
+            result.encodeMs = ElapsedMs(start);
+        }
+
+        start = std::chrono::steady_clock::now();
+        if (!WriteTextureFile(outputPath, desc, levels))
+            return false;
+        result.writeMs = ElapsedMs(start);
+        std::error_code ec;
+        result.outputBytes = static_cast<std::size_t>(std::filesystem::file_size(outputPath, ec));
+        if (stats)
+            *stats = result;
+        return true;
+    }
+
+    bool TextureFileSource::LoadMips(uint32_t firstMip, uint32_t mipCount, std::vector<std::vector<uint8_t>>& out)
+    {
+        const TextureDesc& desc = file_->GetDesc();
+        if (!file_->IsOpen() || firstMip + mipCount > desc.mipLevels)
+            return false;
+        // The streamer owns its staging copies, so this is the one copy out of the mapping
+        const std::vector<SubresourceData> levels = file_->GetSubresources(firstMip, mipCount);
+        out.resize(levels.size());
+        for (std::size_t i = 0; i < levels.size(); ++i)
+        {
+            const auto* data = static_cast<const uint8_t*>(levels[i].data);
+            out[i].assign(data, data + levels[i].size);
+        }
+        return true;
+    }
+}
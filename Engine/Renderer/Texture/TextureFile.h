@@ -0,0 +1,131 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Define.h"
+#include "Core/MappedFile.h"
+#include "Renderer/Gfx.h"
+#include "Renderer/Texture/TextureSource.h"
+
+namespace SoulEngine::Gfx
+{
+    // Cooked runtime texture (.stex), see Doc/ResourceSystem/ResourceSystemDesign.md 8.1.5.
+    // Layout: RuntimeTextureHeader, then for each mip (largest first): MipLevelHeader followed by the
+    // level's texels for every layer (layer i at i * layerSize), padded to kTextureFileAlignment.
+    // Texels are stored exactly as IDevice::CreateTexture / ITexture::UpdateLevel expect them, so a
+    // loaded file is uploaded straight from the mapping. All values little-endian.
+    constexpr uint32_t kTextureFileMagic = 0x58455453;          // "STEX"
+    constexpr uint32_t kTextureFileVersion = 1;
+    constexpr uint32_t kTextureFileAlignment = 16;
+
+    struct RuntimeTextureHeader
+    {
+        uint32_t magic = kTextureFileMagic;
+        uint32_t version = kTextureFileVersion;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t format = 0;                // DataFormat
+        uint32_t mipLevels = 0;
+        uint64_t dataSize = 0;              // bytes after the header
+        uint32_t arrayLayers = 1;
+        uint32_t type = 0;                  // TextureType
+        uint64_t reserved[3] = {};
+    };
+    static_assert(sizeof(RuntimeTextureHeader) == 64, "RuntimeTextureHeader layout changed");
+
+    struct MipLevelHeader
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t layerSize = 0;             // GetTextureLevelSize(format, width, height)
+        uint32_t dataSize = 0;              // layerSize * arrayLayers, before padding
+    };
+    static_assert(sizeof(MipLevelHeader) == 16, "MipLevelHeader layout changed");
+
+    /**
+     * @brief 只读映射的 .stex 文件：打开时校验全部头信息，之后的 mip 数据都是映射内存里的指针，不做拷贝。
+     * 通过 EngineFileIO::MapFile 打开，支持搜索路径与资源包（未压缩的包内条目同样零拷贝）。
+     *
+     * 使用方式:
+     *   TextureFile file;
+     *   if (file.Open("Texture/FireAnim.stex"))
+     *       texture = file.CreateTexture(device);          // 直接从映射上传
+     */
+    class TextureFile
+    {
+        NON_COPY_AND_MOVE(TextureFile)  // desc_.name points into name_
+
+    public:
+        TextureFile() = default;
+
+        bool Open(const std::string& path);
+        bool Open(MappedFile file, const std::string& name);
+        bool IsOpen() const { return !mipData_.empty(); }
+        void Close();
+
+        const TextureDesc& GetDesc() const { return desc_; }
+
+        // One layer of one mip, pointing into the mapping; empty when out of range
+        SubresourceData GetLevel(uint32_t mip, uint32_t layer) const;
+
+        // Layer-major [layer * mipCount + i] subresources of mips [firstMip, firstMip + mipCount),
+        // the layout IDevice::CreateTexture takes
+        std::vector<SubresourceData> GetSubresources(uint32_t firstMip = 0, uint32_t mipCount = UINT32_MAX) const;
+
+        // Creates the texture from mips [firstMip, end); skipping top mips gives a lower resolution texture
+        std::shared_ptr<ITexture> CreateTexture(IDevice* device, uint32_t firstMip = 0) const;
+
+        // Total bytes of texel data
+        std::size_t GetDataSize() const;
+
+    private:
+        MappedFile file_;
+        std::string name_;
+        TextureDesc desc_{};
+        std::vector<MipLevelHeader> mipHeaders_;   // copied out: the mapping need not be aligned
+        std::vector<const uint8_t*> mipData_;
+    };
+
+    // Writes a .stex file. levels is layer-major over the whole chain: levels[layer * mipLevels + mip],
+    // each holding GetTextureLevelSize bytes (the layout of MemoryTextureSource and CreateTexture).
+    bool WriteTextureFile(const std::string& path, const TextureDesc& desc, const std::vector<std::vector<uint8_t>>& levels);
+
+    struct TextureCookOptions
+    {
+        bool srgb = false;
+        // R8G8B8A8_UNorm or a block format CompressImage supports; srgb selects the sRGB variant
+        // (BC4 / BC5 have none and are rejected with srgb)
+        DataFormat format = DataFormat::R8G8B8A8_UNorm;
+        MipFilter mipFilter = MipFilter::Box;
+    };
+
+    // Cook format by name: rgba8, bc1, bc3, bc4, bc5 or bc7 (the UNorm variants)
+    bool ParseCookFormat(const std::string& name, DataFormat& format);
+
+    struct TextureCookStats
+    {
+        double decodeMs = 0.0;              // source decode and mip generation
+        double encodeMs = 0.0;              // block compression, 0 for RGBA8
+        double writeMs = 0.0;
+        std::size_t outputBytes = 0;
+    };
+
+    // Decodes source images (several paths make a texture array, as ImageFileTextureSource) with a
+    // full mip chain, compresses every level when options.format asks for it and writes the .stex
+    bool CookTexture(const std::vector<std::string>& sourcePaths, const TextureCookOptions& options,
+                     const std::string& outputPath, TextureCookStats* stats = nullptr);
+
+    // Streams mips out of a .stex file for the TextureStreamer
+    class TextureFileSource final : public ITextureMipSource
+    {
+    public:
+        explicit TextureFileSource(std::shared_ptr<const TextureFile> file) : file_(std::move(file)) {}
+
+        const TextureDesc& GetDesc() const override { return file_->GetDesc(); }
+        bool LoadMips(uint32_t firstMip, uint32_t mipCount, std::vector<std::vector<uint8_t>>& out) override;
+
+    private:
+        std::shared_ptr<const TextureFile> file_;
+    };
+}
@@ -0,0 +1,326 @@
+#include "Renderer/Texture/TextureProcessing.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOULENGINE_TEXTURE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace SoulEngine::Gfx
+{
+    namespace
+    {
+        constexpr uint32_t kRowGrain = 16;
+        constexpr uint32_t kEncodeGuessSize = 4096;
+        constexpr float kKaiserWidth = 3.0f;        // in destination texels
+        constexpr float kKaiserAlpha = 4.0f;
+        constexpr float kPi = 3.14159265358979f;
+
+        float SRGBToLinear(float c)
+        {
+            return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+
+        struct ColorTables
+        {
+            float decode[2][256];                   // [srgb] stored byte -> linear value
+            float thresholds[255];                  // linear value halfway (in sRGB) between codes k and k + 1
+            uint8_t guess[kEncodeGuessSize];        // code of the start of each linear bucket
+        };
+
+        const ColorTables& GetColorTables()
+        {
+            static const ColorTables tables = [] {
+                ColorTables t{};
+                for (int i = 0; i < 256; ++i)
+                {
+                    t.decode[0][i] = i / 255.0f;
+                    t.decode[1][i] = SRGBToLinear(i / 255.0f);
+                }
+                for (int k = 0; k < 255; ++k)
+                    t.thresholds[k] = SRGBToLinear((k + 0.5f) / 255.0f);
+                uint32_t code = 0;
+                for (uint32_t i = 0; i < kEncodeGuessSize; ++i)
+                {
+                    const float bucketStart = static_cast<float>(i) / (kEncodeGuessSize - 1);
+                    while (code < 255 && t.thresholds[code] <= bucketStart)
+                        ++code;
+                    t.guess[i] = static_cast<uint8_t>(code);
+                }
+                return t;
+            }();
+            return tables;
+        }
+
+        // Correctly rounded linear -> sRGB byte: start from the bucket guess, then settle against
+        // the exact thresholds (at most a step or two)
+        uint8_t EncodeSRGB(float v, const ColorTables& tables)
+        {
+            if (!(v > 0.0f))
+                return 0;
+            if (v >= 1.0f)
+                return 255;
+            uint32_t code = tables.guess[static_cast<uint32_t>(v * (kEncodeGuessSize - 1))];
+            while (code < 255 && v >= tables.thresholds[code])
+                ++code;
+            while (code > 0 && v < tables.thresholds[code - 1])
+                --code;
+            return static_cast<uint8_t>(code);
+        }
+
+#if defined(SOULENGINE_TEXTURE_SSE2)
+        using Vec4 = __m128;
+        inline Vec4 Zero() { return _mm_setzero_ps(); }
+        inline Vec4 Splat(float v) { return _mm_set1_ps(v); }
+        inline Vec4 Load(const float* p) { return _mm_loadu_ps(p); }
+        inline void Store(float* p, Vec4 v) { _mm_storeu_ps(p, v); }
+        inline Vec4 Add(Vec4 a, Vec4 b) { return _mm_add_ps(a, b); }
+        inline Vec4 Mul(Vec4 a, Vec4 b) { return _mm_mul_ps(a, b); }
+        inline Vec4 Clamp01(Vec4 v) { return _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f)); }
+
+        // Clamped [0, 1] RGBA -> UNorm bytes
+        inline void StoreUNorm(Vec4 v, uint8_t* out)
+        {
+            __m128i i = _mm_cvtps_epi32(_mm_mul_ps(Clamp01(v), _mm_set1_ps(255.0f)));
+            i = _mm_packs_epi32(i, i);
+            i = _mm_packus_epi16(i, i);
+            const int packed = _mm_cvtsi128_si32(i);
+            std::memcpy(out, &packed, 4);
+        }
+#else
+        struct Vec4
+        {
+            float v[4];
+        };
+        inline Vec4 Zero() { return { { 0.0f, 0.0f, 0.0f, 0.0f } }; }
+        inline Vec4 Splat(float s) { return { { s, s, s, s } }; }
+        inline Vec4 Load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+        inline void Store(float* p, Vec4 v) { std::memcpy(p, v.v, sizeof(v.v)); }
+        inline Vec4 Add(Vec4 a, Vec4 b) { return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } }; }
+        inline Vec4 Mul(Vec4 a, Vec4 b) { return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } }; }
+        inline Vec4 Clamp01(Vec4 v)
+        {
+            for (float& c : v.v)
+                c = std::clamp(c, 0.0f, 1.0f);
+            return v;
+        }
+
+        inline void StoreUNorm(Vec4 v, uint8_t* out)
+        {
+            v = Clamp01(v);
+            for (int c = 0; c < 4; ++c)
+                out[c] = static_cast<uint8_t>(v.v[c] * 255.0f + 0.5f);
+        }
+#endif
+
+        // RGBA float image in linear light
+        struct LinearImage
+        {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            std::vector<float> texels;
+
+            LinearImage(uint32_t w, uint32_t h) : width(w), height(h), texels(static_cast<std::size_t>(w) * h * 4) {}
+            float* Row(uint32_t y) { return texels.data() + static_cast<std::size_t>(y) * width * 4; }
+            const float* Row(uint32_t y) const { return texels.data() + static_cast<std::size_t>(y) * width * 4; }
+        };
+
+        template <class Fn>
+        void ForEachRow(uint32_t rows, Fn&& fn)
+        {
+            JobSystem::GetInstance().ParallelFor(rows, kRowGrain, [&](uint32_t begin, uint32_t end) {
+                for (uint32_t y = begin; y < end; ++y)
+                    fn(y);
+            });
+        }
+
+        LinearImage ToLinear(const uint8_t* pixels, uint32_t width, uint32_t height, bool srgb)
+        {
+            const ColorTables& tables = GetColorTables();
+            const float* color = tables.decode[srgb ? 1 : 0];
+            const float* alpha = tables.decode[0];
+            LinearImage image(width, height);
+            ForEachRow(height, [&](uint32_t y) {
+                const uint8_t* src = pixels + static_cast<std::size_t>(y) * width * 4;
+                float* dst = image.Row(y);
+                for (uint32_t i = 0; i < width * 4; i += 4)
+                {
+                    dst[i + 0] = color[src[i + 0]];
+                    dst[i + 1] = color[src[i + 1]];
+                    dst[i + 2] = color[src[i + 2]];
+                    dst[i + 3] = alpha[src[i + 3]];
+                }
+            });
+            return image;
+        }
+
+        void Quantize(const LinearImage& image, bool srgb, uint8_t* pixels)
+        {
+            const ColorTables& tables = GetColorTables();
+            ForEachRow(image.height, [&](uint32_t y) {
+                const float* src = image.Row(y);
+                uint8_t* dst = pixels + static_cast<std::size_t>(y) * image.width * 4;
+                for (uint32_t i = 0; i < image.width * 4; i += 4)
+                {
+                    StoreUNorm(Load(src + i), dst + i);
+                    if (srgb)
+                    {
+                        dst[i + 0] = EncodeSRGB(src[i + 0], tables);
+                        dst[i + 1] = EncodeSRGB(src[i + 1], tables);
+                        dst[i + 2] = EncodeSRGB(src[i + 2], tables);
+                    }
+                }
+            });
+        }
+
+        LinearImage DownsampleBox(const LinearImage& src)
+        {
+            const uint32_t w = src.width, h = src.height;
+            LinearImage dst(std::max(w / 2, 1u), std::max(h / 2, 1u));
+            const Vec4 quarter = Splat(0.25f);
+            ForEachRow(dst.height, [&](uint32_t y) {
+                const float* row0 = src.Row(std::min(y * 2, h - 1));
+                const float* row1 = src.Row(std::min(y * 2 + 1, h - 1));
+                float* out = dst.Row(y);
+                for (uint32_t x = 0; x < dst.width; ++x)
+                {
+                    const uint32_t x0 = std::min(x * 2, w - 1) * 4;
+                    const uint32_t x1 = std::min(x * 2 + 1, w - 1) * 4;
+                    const Vec4 sum = Add(Add(Load(row0 + x0), Load(row0 + x1)), Add(Load(row1 + x0), Load(row1 + x1)));
+                    Store(out + x * 4, Mul(sum, quarter));
+                }
+            });
+            return dst;
+        }
+
+        float BesselI0(float x)
+        {
+            float sum = 1.0f, term = 1.0f;
+            const float q = x * x * 0.25f;
+            for (int k = 1; k < 32 && term > sum * 1e-8f; ++k)
+            {
+                term *= q / static_cast<float>(k * k);
+                sum += term;
+            }
+            return sum;
+        }
+
+        float KaiserSinc(float x)
+        {
+            if (std::fabs(x) >= kKaiserWidth)
+                return 0.0f;
+            const float sinc = x == 0.0f ? 1.0f : std::sin(kPi * x) / (kPi * x);
+            const float t = x / kKaiserWidth;
+            return sinc * BesselI0(kKaiserAlpha * std::sqrt(1.0f - t * t)) / BesselI0(kKaiserAlpha);
+        }
+
+        // Fixed-size tap lists of a 1D reduction, source indices already clamped to the edge
+        struct FilterTaps
+        {
+            uint32_t count = 0;
+            std::vector<uint32_t> index;            // [dst * count + tap]
+            std::vector<float> weight;
+        };
+
+        FilterTaps BuildKaiserTaps(uint32_t srcSize, uint32_t dstSize)
+        {
+            const float scale = static_cast<float>(srcSize) / static_cast<float>(dstSize);
+            const float radius = kKaiserWidth * scale;
+            FilterTaps taps;
+            taps.count = static_cast<uint32_t>(std::ceil(radius * 2.0f)) + 1;
+            taps.index.resize(static_cast<std::size_t>(dstSize) * taps.count);
+            taps.weight.resize(taps.index.size());
+            for (uint32_t j = 0; j < dstSize; ++j)
+            {
+                const float center = (static_cast<float>(j) + 0.5f) * scale;
+                const int32_t first = static_cast<int32_t>(std::floor(center - radius));
+                uint32_t* index = taps.index.data() + static_cast<std::size_t>(j) * taps.count;
+                float* weight = taps.weight.data() + static_cast<std::size_t>(j) * taps.count;
+                float sum = 0.0f;
+                for (uint32_t t = 0; t < taps.count; ++t)
+                {
+                    const int32_t i = first + static_cast<int32_t>(t);
+                    index[t] = static_cast<uint32_t>(std::clamp(i, 0, static_cast<int32_t>(srcSize) - 1));
+                    weight[t] = KaiserSinc((static_cast<float>(i) + 0.5f - center) / scale);
+                    sum += weight[t];
+                }
+                for (uint32_t t = 0; t < taps.count; ++t)
+                    weight[t] /= sum;
+            }
+            return taps;
+        }
+
+        // Separable: horizontal pass over every source row, then vertical pass over the result
+        LinearImage DownsampleKaiser(const LinearImage& src)
+        {
+            const uint32_t dw = std::max(src.width / 2, 1u), dh = std::max(src.height / 2, 1u);
+            const FilterTaps horizontal = BuildKaiserTaps(src.width, dw);
+            const FilterTaps vertical = BuildKaiserTaps(src.height, dh);
+
+            LinearImage rows(dw, src.height);
+            ForEachRow(src.height, [&](uint32_t y) {
+                const float* in = src.Row(y);
+                float* out = rows.Row(y);
+                for (uint32_t x = 0; x < dw; ++x)
+                {
+                    const uint32_t* index = horizontal.index.data() + static_cast<std::size_t>(x) * horizontal.count;
+                    const float* weight = horizontal.weight.data() + static_cast<std::size_t>(x) * horizontal.count;
+                    Vec4 sum = Zero();
+                    for (uint32_t t = 0; t < horizontal.count; ++t)
+                        sum = Add(sum, Mul(Load(in + index[t] * 4), Splat(weight[t])));
+                    Store(out + x * 4, sum);
+                }
+            });
+
+            LinearImage dst(dw, dh);
+            ForEachRow(dh, [&](uint32_t y) {
+                const uint32_t* index = vertical.index.data() + static_cast<std::size_t>(y) * vertical.count;
+                const float* weight = vertical.weight.data() + static_cast<std::size_t>(y) * vertical.count;
+                float* out = dst.Row(y);
+                for (uint32_t t = 0; t < vertical.count; ++t)
+                {
+                    const float* in = rows.Row(index[t]);
+                    const Vec4 w = Splat(weight[t]);
+                    for (uint32_t i = 0; i < dw * 4; i += 4)
+                        Store(out + i, Add(Load(out + i), Mul(Load(in + i), w)));
+                }
+                // Negative lobes can overshoot; clamp so the ringing does not feed the next level
+                for (uint32_t i = 0; i < dw * 4; i += 4)
+                    Store(out + i, Clamp01(Load(out + i)));
+            });
+            return dst;
+        }
+
+        LinearImage Downsample(const LinearImage& src, MipFilter filter)
+        {
+            return filter == MipFilter::Kaiser ? DownsampleKaiser(src) : DownsampleBox(src);
+        }
+    }
+
+    void DownsampleImage(const uint8_t* src, uint32_t width, uint32_t height, bool srgb, MipFilter filter, uint8_t* dst)
+    {
+        Quantize(Downsample(ToLinear(src, width, height, srgb), filter), srgb, dst);
+    }
+
+    void GenerateMipChain(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t mipCount, bool srgb,
+                          MipFilter filter, std::vector<std::vector<uint8_t>>& levels)
+    {
+        levels.assign(mipCount, {});
+        if (mipCount == 0)
+            return;
+        levels[0].assign(pixels, pixels + static_cast<std::size_t>(width) * height * 4);
+        if (mipCount == 1)
+            return;
+
+        LinearImage current = ToLinear(pixels, width, height, srgb);
+        for (uint32_t mip = 1; mip < mipCount; ++mip)
+        {
+            current = Downsample(current, filter);
+            levels[mip].resize(static_cast<std::size_t>(current.width) * current.height * 4);
+            Quantize(current, srgb, levels[mip].data());
+        }
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace SoulEngine::Gfx
+{
+    enum class MipFilter
+    {
+        Box,        // 2x2 average; odd edges repeat the last texel
+        Kaiser,     // Kaiser-windowed sinc (width 3, alpha 4): sharper mips, clamped ringing
+    };
+
+    // Mip generation for tightly packed RGBA8 images. Filtering runs in linear light: with srgb the
+    // color channels are decoded through a lookup table before filtering and re-encoded with exact
+    // rounding afterwards; alpha is always filtered as stored. Lower mips are filtered from the
+    // previous level kept in float, so rounding does not accumulate down the chain. Rows are split
+    // across the JobSystem (safe to call from a job); the inner loops use SSE2 when available.
+
+    // Halves an image (each dimension rounds down, at least 1) into dst
+    void DownsampleImage(const uint8_t* src, uint32_t width, uint32_t height, bool srgb, MipFilter filter, uint8_t* dst);
+
+    // Fills levels[0, mipCount) with the chain of the image; levels[0] is a copy of the source
+    void GenerateMipChain(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t mipCount, bool srgb,
+                          MipFilter filter, std::vector<std::vector<uint8_t>>& levels);
+}
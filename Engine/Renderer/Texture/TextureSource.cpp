@@ -0,0 +1,136 @@
+#include "Renderer/Texture/TextureSource.h"
+#include "Core/EngineFileIO.h"
+#include "Core/JobSystem.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_NO_STDIO
+#include "stb_image.h"
+
+namespace SoulEngine::Gfx
+{
+    bool DecodeImageRGBA8(const uint8_t* data, std::size_t size, ImageRGBA8& out)
+    {
+        int width = 0, height = 0, components = 0;
+        stbi_uc* pixels = size == 0 ? nullptr
+            : stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &components, 4);
+        if (!pixels)
+            return false;
+        out.width = static_cast<uint32_t>(width);
+        out.height = static_cast<uint32_t>(height);
+        out.pixels.assign(pixels, pixels + static_cast<std::size_t>(width) * height * 4);
+        stbi_image_free(pixels);
+        return true;
+    }
+
+    MemoryTextureSource::MemoryTextureSource(const TextureDesc& desc, std::vector<std::vector<uint8_t>> levels)
+        : desc_(desc), levels_(std::move(levels))
+    {
+        desc_.arrayLayers = std::max(desc_.arrayLayers, 1u);
+        desc_.mipLevels = std::max(desc_.mipLevels, 1u);
+        if (levels_.size() != static_cast<std::size_t>(desc_.arrayLayers) * desc_.mipLevels)
+            Logger::Error("MemoryTextureSource '{}': expected {} levels, got {}", desc_.name ? desc_.name : "",
+                          desc_.arrayLayers * desc_.mipLevels, levels_.size());
+    }
+
+    bool MemoryTextureSource::LoadMips(uint32_t firstMip, uint32_t mipCount, std::vector<std::vector<uint8_t>>& out)
+    {
+        if (firstMip + mipCount > desc_.mipLevels || levels_.size() != static_cast<std::size_t>(desc_.arrayLayers) * desc_.mipLevels)
+            return false;
+        out.resize(static_cast<std::size_t>(desc_.arrayLayers) * mipCount);
+        for (uint32_t layer = 0; layer < desc_.arrayLayers; ++layer)
+        {
+            for (uint32_t i = 0; i < mipCount; ++i)
+                out[layer * mipCount + i] = levels_[layer * desc_.mipLevels + firstMip + i];
+        }
+        return true;
+    }
+
+    ImageFileTextureSource::ImageFileTextureSource(std::vector<std::string> paths, bool srgb, MipFilter mipFilter)
+        : paths_(std::move(paths)), mipFilter_(mipFilter)
+    {
+        desc_.type = paths_.size() > 1 ? TextureType::Texture2DArray : TextureType::Texture2D;
+        desc_.format = srgb ? DataFormat::R8G8B8A8_SRGB : DataFormat::R8G8B8A8_UNorm;
+        desc_.arrayLayers = static_cast<uint32_t>(std::max<std::size_t>(paths_.size(), 1));
+        if (paths_.empty())
+            return;
+
+        name_ = std::filesystem::path(paths_.front()).filename().string();
+        desc_.name = name_.c_str();
+
+        const std::vector<uint8_t> file = EngineFileIO::LoadBinary(paths_.front());
+        int width = 0, height = 0, components = 0;
+        if (file.empty() || !stbi_info_from_memory(file.data(), static_cast<int>(file.size()), &width, &height, &components))
+        {
+            Logger::Error("ImageFileTextureSource: cannot read image header of {}", paths_.front());
+            return;
+        }
+        desc_.width = static_cast<uint32_t>(width);
+        desc_.height = static_cast<uint32_t>(height);
+        desc_.mipLevels = GetMipLevelCount(desc_.width, desc_.height);
+        valid_ = true;
+    }
+
+    bool ImageFileTextureSource::LoadMips(uint32_t firstMip, uint32_t mipCount, std::vector<std::vector<uint8_t>>& out)
+    {
+        if (!valid_ || firstMip + mipCount > desc_.mipLevels)
+            return false;
+        out.assign(static_cast<std::size_t>(desc_.arrayLayers) * mipCount, {});
+
+        // One decode per layer; ParallelFor is safe to nest inside the streaming job
+        std::atomic<bool> ok{ true };
+        JobSystem::GetInstance().ParallelFor(desc_.arrayLayers, 1, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t layer = begin; layer < end; ++layer)
+            {
+                if (!DecodeLayer(layer, firstMip, mipCount, out.data() + static_cast<std::size_t>(layer) * mipCount))
+                    ok = false;
+            }
+        });
+        return ok;
+    }
+
+    bool ImageFileTextureSource::DecodeLayer(uint32_t layer, uint32_t firstMip, uint32_t mipCount, std::vector<uint8_t>* out) const
+    {
+        const std::vector<uint8_t> file = EngineFileIO::LoadBinary(paths_[layer]);
+        int width = 0, height = 0, components = 0;
+        stbi_uc* pixels = file.empty() ? nullptr
+            : stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &width, &height, &components, 4);
+        if (!pixels)
+        {
+            Logger::Error("ImageFileTextureSource: failed to decode {}: {}", paths_[layer], stbi_failure_reason() ? stbi_failure_reason() : "unreadable");
+            return false;
+        }
+        if (static_cast<uint32_t>(width) != desc_.width || static_cast<uint32_t>(height) != desc_.height)
+        {
+            Logger::Error("ImageFileTextureSource: {} is {}x{}, expected {}x{}", paths_[layer], width, height, desc_.width, desc_.height);
+            stbi_image_free(pixels);
+            return false;
+        }
+
+        // The chain is filtered from mip 0 down; keep only the requested levels
+        std::vector<std::vector<uint8_t>> chain;
+        GenerateMipChain(pixels, desc_.width, desc_.height, firstMip + mipCount, desc_.format == DataFormat::R8G8B8A8_SRGB, mipFilter_, chain);
+        stbi_image_free(pixels);
+        for (uint32_t i = 0; i < mipCount; ++i)
+            out[i] = std::move(chain[firstMip + i]);
+        return true;
+    }
+
+    std::vector<std::string> ImageFileTextureSource::ListImageSequence(const std::string& directory, const std::string& extension)
+    {
+        std::filesystem::path dir(directory);
+        if (!std::filesystem::is_directory(dir))
+        {
+            if (auto resolved = EngineFileIO::ResolveFilePath(directory))
+                dir = *resolved;
+        }
+        std::vector<std::string> paths;
+        for (const auto& file : EngineFileIO::ListFilesInDirectory(dir.string(), extension))
+            paths.push_back(file.string());
+        std::sort(paths.begin(), paths.end());
+        return paths;
+    }
+}
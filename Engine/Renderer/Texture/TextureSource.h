@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Renderer/Gfx.h"
+#include "Renderer/Texture/TextureProcessing.h"
+
+namespace SoulEngine::Gfx
+{
+    // Supplies the texel data of one texture's full mip chain to the TextureStreamer.
+    // LoadMips runs on a JobSystem thread, so implementations must not touch the device.
+    class ITextureMipSource
+    {
+    public:
+        virtual ~ITextureMipSource() = default;
+
+        // Description of the complete chain; name may be null
+        virtual const TextureDesc& GetDesc() const = 0;
+
+        // Fills out with mips [firstMip, firstMip + mipCount) of every layer, tightly packed,
+        // layer-major: out[layer * mipCount + i] holds mip firstMip + i.
+        virtual bool LoadMips(uint32_t firstMip, uint32_t mipCount, std::vector<std::vector<uint8_t>>& out) = 0;
+    };
+
+    struct ImageRGBA8
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint8_t> pixels;        // tightly packed RGBA8, top row first
+    };
+
+    // Decodes an in-memory image file (any format ImageFileTextureSource reads) to RGBA8; thread-safe.
+    // Suitable as an AsyncLoader decode step.
+    bool DecodeImageRGBA8(const uint8_t* data, std::size_t size, ImageRGBA8& out);
+
+    // Chain already in memory (procedural textures, tests); levels is layer-major over the whole chain
+    class MemoryTextureSource final : public ITextureMipSource
+    {
+    public:
+        MemoryTextureSource(const TextureDesc& desc, std::vector<std::vector<uint8_t>> levels);
+
+        const TextureDesc& GetDesc() const override { return desc_; }
+        bool LoadMips(uint32_t firstMip, uint32_t mipCount, std::vector<std::vector<uint8_t>>& out) override;
+
+    private:
+        TextureDesc desc_{};
+        std::vector<std::vector<uint8_t>> levels_;
+    };
+
+    /**
+     * @brief 从图片文件（stb_image 支持的 BMP/PNG/TGA/JPG 等）读取的纹理源，解码为 RGBA8 并用 GenerateMipChain 生成 mip 链（sRGB 纹理在线性空间滤波）。
+     * 传入多个路径时构成纹理数组，每个文件一层（例如 FireAnim 的 120 帧序列），所有文件须尺寸一致。
+     * 每次 LoadMips 都会重新读取并解码文件，不在内存中保留像素。
+     *
+     * 使用方式:
+     *   auto frames = ImageFileTextureSource::ListImageSequence("Resources/Texture/FireAnim", ".bmp");
+     *   auto source = std::make_shared<ImageFileTextureSource>(frames, true);
+     *   StreamedTextureHandle fire = streamer.Register(source);
+     */
+    class ImageFileTextureSource final : public ITextureMipSource
+    {
+    public:
+        ImageFileTextureSource(std::vector<std::string> paths, bool srgb, MipFilter mipFilter = MipFilter::Box);
+
+        // False when the first file could not be read; GetDesc then reports a 1x1 texture
+        bool IsValid() const { return valid_; }
+
+        const TextureDesc& GetDesc() const override { return desc_; }
+        bool LoadMips(uint32_t firstMip, uint32_t mipCount, std::vector<std::vector<uint8_t>>& out) override;
+
+        // Files of directory with the given extension, sorted by name so numbered frames stay in order
+        static std::vector<std::string> ListImageSequence(const std::string& directory, const std::string& extension);
+
+    private:
+        bool DecodeLayer(uint32_t layer, uint32_t firstMip, uint32_t mipCount, std::vector<uint8_t>* out) const;
+
+        std::vector<std::string> paths_;
+        std::string name_;
+        TextureDesc desc_{};
+        MipFilter mipFilter_ = MipFilter::Box;
+        bool valid_ = false;
+    };
+}
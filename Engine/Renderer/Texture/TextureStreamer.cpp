@@ -0,0 +1,358 @@
+#include "Renderer/Texture/TextureStreamer.h"
+#include "Core/JobSystem.h"
+#include "Log/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace SoulEngine::Gfx
+{
+    namespace
+    {
+        double ElapsedMs(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        bool IsReady(const std::future<void>& future)
+        {
+            return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }
+    }
+
+    TextureStreamer::TextureStreamer(IDevice* device, const TextureStreamerSettings& settings)
+        : device_(device), settings_(settings)
+    {
+    }
+
+    TextureStreamer::~TextureStreamer()
+    {
+        // Jobs own what they touch, but the sources may reference engine state torn down after us
+        for (Slot& slot : slots_)
+        {
+            if (slot.load)
+            {
+                slot.load->cancelled = true;
+                slot.load->done.wait();
+            }
+        }
+    }
+
+    StreamedTextureHandle TextureStreamer::Register(std::shared_ptr<ITextureMipSource> source)
+    {
+        if (!source)
+            return {};
+        const TextureDesc& desc = source->GetDesc();
+        const uint32_t mipLevels = std::max(desc.mipLevels, 1u);
+
+        Slot slot;
+        slot.source = source;
+        slot.tailMip = mipLevels - 1;
+        for (uint32_t mip = 0; mip < mipLevels; ++mip)
+        {
+            if (std::max(desc.width >> mip, desc.height >> mip) <= settings_.tailSize)
+            {
+                slot.tailMip = mip;
+                break;
+            }
+        }
+        if (!source->LoadMips(slot.tailMip, mipLevels - slot.tailMip, slot.tail))
+        {
+            Logger::Error("TextureStreamer: failed to load the mip tail of '{}'", desc.name ? desc.name : "");
+            return {};
+        }
+        std::shared_ptr<ITexture> texture = CreateResident(slot, slot.tailMip, slot.tail);
+        if (!texture)
+            return {};
+
+        slot.texture = std::move(texture);
+        slot.residentMip = slot.wantedMip = slot.grantedMip = slot.tailMip;
+        slot.lastRequested = frameIndex_;
+        slot.alive = true;
+        stats_.residentBytes += GetChainBytes(slot, slot.tailMip);
+        ++stats_.textures;
+
+        uint32_t index;
+        if (!freeSlots_.empty())
+        {
+            index = freeSlots_.back();
+            freeSlots_.pop_back();
+            slot.generation = slots_[index].generation;
+            slots_[index] = std::move(slot);
+        }
+        else
+        {
+            index = static_cast<uint32_t>(slots_.size());
+            slots_.push_back(std::move(slot));
+        }
+        return { index, slots_[index].generation };
+    }
+
+    void TextureStreamer::Unregister(StreamedTextureHandle handle)
+    {
+        Slot* slot = Resolve(handle);
+        if (!slot)
+            return;
+        CancelLoad(*slot);
+        stats_.residentBytes -= GetChainBytes(*slot, slot->residentMip);
+        --stats_.textures;
+        const uint32_t generation = slot->generation + 1;
+        *slot = Slot{};
+        slot->generation = generation;
+        freeSlots_.push_back(handle.index);
+    }
+
+    bool TextureStreamer::IsAlive(StreamedTextureHandle handle) const
+    {
+        return Resolve(handle) != nullptr;
+    }
+
+    void TextureStreamer::RequestMip(StreamedTextureHandle handle, uint32_t desiredMip)
+    {
+        if (Slot* slot = Resolve(handle))
+            slot->pendingMip = std::min(slot->pendingMip, desiredMip);
+    }
+
+    uint32_t TextureStreamer::ComputeDesiredMip(const TextureDesc& desc, float projectedPixels)
+    {
+        const float texels = static_cast<float>(std::max(desc.width, desc.height));
+        const float ratio = texels / std::max(projectedPixels, 1.0f);
+        if (ratio <= 1.0f)
+            return 0;
+        const uint32_t mip = static_cast<uint32_t>(std::floor(std::log2(ratio)));
+        return std::min(mip, std::max(desc.mipLevels, 1u) - 1);
+    }
+
+    ITexture* TextureStreamer::GetTexture(StreamedTextureHandle handle) const
+    {
+        const Slot* slot = Resolve(handle);
+        return slot ? slot->texture.get() : nullptr;
+    }
+
+    uint32_t TextureStreamer::GetResidentMip(StreamedTextureHandle handle) const
+    {
+        const Slot* slot = Resolve(handle);
+        return slot ? slot->residentMip : 0;
+    }
+
+    void TextureStreamer::Update(uint64_t frameIndex)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        frameIndex_ = frameIndex;
+
+        for (Slot& slot : slots_)
+        {
+            if (!slot.alive)
+                continue;
+            if (slot.pendingMip != UINT32_MAX)
+            {
+                slot.wantedMip = std::min(slot.pendingMip, slot.tailMip);
+                slot.lastRequested = frameIndex;
+                slot.pendingMip = UINT32_MAX;
+            }
+            else if (frameIndex - slot.lastRequested > settings_.idleFrames)
+            {
+                slot.wantedMip = slot.tailMip;
+                if (slot.load || slot.residentMip < slot.tailMip)
+                {
+                    CancelLoad(slot);
+                    if (slot.residentMip < slot.tailMip)
+                    {
+                        DropToTail(slot);
+                        ++stats_.idleDrops;
+                    }
+                }
+            }
+        }
+
+        ApplyFinishedLoads();
+        PlanResidency();
+        IssueLoads();
+        stats_.updateMs = ElapsedMs(start);
+    }
+
+    TextureStreamer::Slot* TextureStreamer::Resolve(StreamedTextureHandle handle)
+    {
+        if (handle.index >= slots_.size())
+            return nullptr;
+        Slot& slot = slots_[handle.index];
+        return slot.alive && slot.generation == handle.generation ? &slot : nullptr;
+    }
+
+    const TextureStreamer::Slot* TextureStreamer::Resolve(StreamedTextureHandle handle) const
+    {
+        return const_cast<TextureStreamer*>(this)->Resolve(handle);
+    }
+
+    std::size_t TextureStreamer::GetChainBytes(const Slot& slot, uint32_t firstMip) const
+    {
+        const TextureDesc& desc = slot.source->GetDesc();
+        std::size_t bytes = 0;
+        for (uint32_t mip = firstMip; mip < desc.mipLevels; ++mip)
+            bytes += GetTextureLevelSize(desc.format, std::max(desc.width >> mip, 1u), std::max(desc.height >> mip, 1u));
+        return bytes * std::max(desc.arrayLayers, 1u);
+    }
+
+    std::shared_ptr<ITexture> TextureStreamer::CreateResident(const Slot& slot, uint32_t firstMip,
+                                                              const std::vector<std::vector<uint8_t>>& levels) const
+    {
+        TextureDesc desc = slot.source->GetDesc();
+        const uint32_t mipCount = desc.mipLevels - firstMip;
+        desc.width = std::max(desc.width >> firstMip, 1u);
+        desc.height = std::max(desc.height >> firstMip, 1u);
+        desc.arrayLayers = std::max(desc.arrayLayers, 1u);
+        desc.mipLevels = mipCount;
+        if (levels.size() != static_cast<std::size_t>(desc.arrayLayers) * mipCount)
+        {
+            Logger::Error("TextureStreamer: '{}' loaded {} levels, expected {}", desc.name ? desc.name : "",
+                          levels.size(), desc.arrayLayers * mipCount);
+            return nullptr;
+        }
+
+        std::vector<SubresourceData> initial(levels.size());
+        for (std::size_t i = 0; i < levels.size(); ++i)
+        {
+            initial[i].data = levels[i].data();
+            initial[i].size = levels[i].size();
+        }
+        return device_->CreateTexture(desc, initial.data());
+    }
+
+    void TextureStreamer::SetResident(Slot& slot, uint32_t firstMip, std::shared_ptr<ITexture> texture)
+    {
+        stats_.residentBytes -= GetChainBytes(slot, slot.residentMip);
+        stats_.residentBytes += GetChainBytes(slot, firstMip);
+        slot.texture = std::move(texture);
+        slot.residentMip = firstMip;
+    }
+
+    void TextureStreamer::DropToTail(Slot& slot)
+    {
+        if (slot.residentMip >= slot.tailMip)
+            return;
+        if (std::shared_ptr<ITexture> tail = CreateResident(slot, slot.tailMip, slot.tail))
+            SetResident(slot, slot.tailMip, std::move(tail));
+    }
+
+    void TextureStreamer::CancelLoad(Slot& slot)
+    {
+        if (!slot.load)
+            return;
+        // The job keeps its own reference; a cancelled request is simply never applied
+        slot.load->cancelled = true;
+        slot.load.reset();
+        --stats_.loadsInFlight;
+        ++stats_.loadsDiscarded;
+    }
+
+    void TextureStreamer::ApplyFinishedLoads()
+    {
+        uint32_t uploads = 0;
+        for (Slot& slot : slots_)
+        {
+            if (!slot.alive || !slot.load || !IsReady(slot.load->done))
+                continue;
+            if (uploads >= settings_.maxUploadsPerFrame)
+                break;
+
+            std::shared_ptr<LoadRequest> load = std::move(slot.load);
+            --stats_.loadsInFlight;
+            if (!load->ok)
+            {
+                ++stats_.loadsFailed;
+                continue;
+            }
+            const std::size_t newBytes = GetChainBytes(slot, load->firstMip);
+            const std::size_t oldBytes = GetChainBytes(slot, slot.residentMip);
+            if (load->firstMip >= slot.residentMip || stats_.residentBytes - oldBytes + newBytes > settings_.budgetBytes)
+            {
+                ++stats_.loadsDiscarded;
+                continue;
+            }
+            if (std::shared_ptr<ITexture> texture = CreateResident(slot, load->firstMip, load->levels))
+            {
+                SetResident(slot, load->firstMip, std::move(texture));
+                ++stats_.loadsCompleted;
+                ++uploads;
+            }
+            else
+            {
+                ++stats_.loadsFailed;
+            }
+        }
+    }
+
+    void TextureStreamer::PlanResidency()
+    {
+        // Most recently requested first; among equals the finer request wins
+        order_.clear();
+        std::size_t remaining = settings_.budgetBytes;
+        stats_.wantedBytes = 0;
+        for (uint32_t i = 0; i < slots_.size(); ++i)
+        {
+            const Slot& slot = slots_[i];
+            if (!slot.alive)
+                continue;
+            order_.push_back(i);
+            const std::size_t tailBytes = GetChainBytes(slot, slot.tailMip);
+            remaining = remaining > tailBytes ? remaining - tailBytes : 0;
+            stats_.wantedBytes += GetChainBytes(slot, slot.wantedMip);
+        }
+        std::sort(order_.begin(), order_.end(), [this](uint32_t a, uint32_t b) {
+            const Slot& sa = slots_[a];
+            const Slot& sb = slots_[b];
+            if (sa.lastRequested != sb.lastRequested)
+                return sa.lastRequested > sb.lastRequested;
+            if (sa.wantedMip != sb.wantedMip)
+                return sa.wantedMip < sb.wantedMip;
+            return a < b;
+        });
+
+        // Grant each texture the finest mip that still fits behind everything more important
+        for (uint32_t index : order_)
+        {
+            Slot& slot = slots_[index];
+            const std::size_t tailBytes = GetChainBytes(slot, slot.tailMip);
+            uint32_t mip = slot.wantedMip;
+            std::size_t extra = GetChainBytes(slot, mip) - tailBytes;
+            while (extra > remaining && mip < slot.tailMip)
+                extra = GetChainBytes(slot, ++mip) - tailBytes;
+            slot.grantedMip = mip;
+            remaining -= extra;
+        }
+
+        // Over budget: least recently used textures resident finer than granted go back to the tail first
+        for (auto it = order_.rbegin(); it != order_.rend() && stats_.residentBytes > settings_.budgetBytes; ++it)
+        {
+            Slot& slot = slots_[*it];
+            if (slot.residentMip < slot.grantedMip)
+            {
+                CancelLoad(slot);
+                DropToTail(slot);
+                ++stats_.budgetDrops;
+            }
+        }
+    }
+
+    void TextureStreamer::IssueLoads()
+    {
+        for (uint32_t index : order_)
+        {
+            if (stats_.loadsInFlight >= settings_.maxLoadsInFlight)
+                break;
+            Slot& slot = slots_[index];
+            if (slot.load || slot.grantedMip >= slot.residentMip)
+                continue;
+
+            auto load = std::make_shared<LoadRequest>();
+            load->firstMip = slot.grantedMip;
+            const uint32_t mipCount = slot.source->GetDesc().mipLevels - slot.grantedMip;
+            load->done = JobSystem::GetInstance().Submit([load, source = slot.source, mipCount] {
+                if (!load->cancelled)
+                    load->ok = source->LoadMips(load->firstMip, mipCount, load->levels);
+            });
+            slot.load = std::move(load);
+            ++stats_.loadsInFlight;
+        }
+    }
+}
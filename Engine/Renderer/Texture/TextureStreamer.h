@@ -0,0 +1,136 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+#include "Renderer/Gfx.h"
+#include "Renderer/Texture/TextureSource.h"
+
+namespace SoulEngine::Gfx
+{
+    // Stable reference to a streamed texture, same scheme as MeshHandle
+    struct StreamedTextureHandle
+    {
+        uint32_t index = UINT32_MAX;
+        uint32_t generation = 0;
+        bool IsValid() const { return index != UINT32_MAX; }
+    };
+
+    struct TextureStreamerSettings
+    {
+        std::size_t budgetBytes = 256ull << 20;  // all resident mips of all textures, tails included
+        uint32_t idleFrames = 120;               // textures not requested for this long fall back to their tail
+        uint32_t tailSize = 64;                  // mips no larger than this are loaded at Register and never dropped
+        uint32_t maxLoadsInFlight = 4;
+        uint32_t maxUploadsPerFrame = 2;         // texture creations per Update, bounds the frame-time spike
+    };
+
+    struct TextureStreamerStats
+    {
+        uint32_t textures = 0;
+        uint32_t loadsInFlight = 0;
+        uint64_t loadsCompleted = 0;
+        uint64_t loadsFailed = 0;
+        uint64_t loadsDiscarded = 0;             // finished after unregister, or no longer fitting the budget
+        uint64_t idleDrops = 0;                  // fell back to the tail after idleFrames
+        uint64_t budgetDrops = 0;                // fell back to the tail to make room
+        std::size_t residentBytes = 0;
+        std::size_t wantedBytes = 0;             // what the requested mips would need without a budget
+        double updateMs = 0.0;
+    };
+
+    /**
+     * @brief 纹理 mip 流式加载与驻留管理
+     * 每个纹理只常驻 mip 尾部（不大于 tailSize 的层级），更精细的层级按 RequestMip 的需求在任务系统上异步加载，
+     * 加载完成后在 Update 中创建只含 [residentMip, 末级] 的新纹理并替换旧纹理，旧纹理经由后端的延迟删除释放。
+     * 超出预算时按最近使用时间排序，优先满足最近使用的纹理；超过 idleFrames 帧未被请求的纹理退回到尾部。
+     * 因为使用归一化 UV 采样，替换后的纹理对着色器透明。
+     *
+     * 使用方式:
+     *   TextureStreamer streamer(device, settings);
+     *   StreamedTextureHandle h = streamer.Register(source);
+     *   // 每帧: 对可见物体
+     *   streamer.RequestMip(h, TextureStreamer::ComputeDesiredMip(source->GetDesc(), projectedPixels));
+     *   streamer.Update(frameIndex);                 // 渲染线程
+     *   context->SetTexture(0, streamer.GetTexture(h), sampler);
+     */
+    class TextureStreamer
+    {
+    public:
+        TextureStreamer(IDevice* device, const TextureStreamerSettings& settings = {});
+        ~TextureStreamer();
+
+        TextureStreamer(const TextureStreamer&) = delete;
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        // Loads the tail synchronously, so GetTexture is usable right away. Invalid handle if that fails.
+        StreamedTextureHandle Register(std::shared_ptr<ITextureMipSource> source);
+        // Cancels the pending load, if any, and releases the texture
+        void Unregister(StreamedTextureHandle handle);
+        bool IsAlive(StreamedTextureHandle handle) const;
+
+        // Marks the texture as sampled this frame with at least mip desiredMip (0 = full resolution)
+        void RequestMip(StreamedTextureHandle handle, uint32_t desiredMip);
+
+        // Mip whose texel density matches a footprint of projectedPixels along the larger side
+        static uint32_t ComputeDesiredMip(const TextureDesc& desc, float projectedPixels);
+
+        // Mip 0 of the returned texture is source mip GetResidentMip(handle)
+        ITexture* GetTexture(StreamedTextureHandle handle) const;
+        uint32_t GetResidentMip(StreamedTextureHandle handle) const;
+
+        // Render thread, once per frame: applies finished loads, drops idle mips and issues new loads
+        void Update(uint64_t frameIndex);
+
+        void SetSettings(const TextureStreamerSettings& settings) { settings_ = settings; }
+        const TextureStreamerSettings& GetSettings() const { return settings_; }
+        const TextureStreamerStats& GetStats() const { return stats_; }
+
+    private:
+        // Shared with the load job, which may outlive the slot
+        struct LoadRequest
+        {
+            uint32_t firstMip = 0;
+            std::atomic<bool> cancelled{ false };
+            bool ok = false;
+            std::vector<std::vector<uint8_t>> levels;
+            std::future<void> done;
+        };
+
+        struct Slot
+        {
+            std::shared_ptr<ITextureMipSource> source;
+            std::shared_ptr<ITexture> texture;
+            std::vector<std::vector<uint8_t>> tail;      // CPU copy of the tail, layer-major, to drop back without I/O
+            std::shared_ptr<LoadRequest> load;
+            uint32_t residentMip = 0;
+            uint32_t tailMip = 0;
+            uint32_t wantedMip = 0;                      // from the latest frame with requests
+            uint32_t pendingMip = UINT32_MAX;            // min of the RequestMip calls since the last Update
+            uint32_t grantedMip = 0;
+            uint64_t lastRequested = 0;
+            uint32_t generation = 0;
+            bool alive = false;
+        };
+
+        Slot* Resolve(StreamedTextureHandle handle);
+        const Slot* Resolve(StreamedTextureHandle handle) const;
+        std::size_t GetChainBytes(const Slot& slot, uint32_t firstMip) const;
+        std::shared_ptr<ITexture> CreateResident(const Slot& slot, uint32_t firstMip, const std::vector<std::vector<uint8_t>>& levels) const;
+        void SetResident(Slot& slot, uint32_t firstMip, std::shared_ptr<ITexture> texture);
+        void DropToTail(Slot& slot);
+        void CancelLoad(Slot& slot);
+        void ApplyFinishedLoads();
+        void PlanResidency();
+        void IssueLoads();
+
+        IDevice* device_ = nullptr;
+        TextureStreamerSettings settings_{};
+        std::vector<Slot> slots_;
+        std::vector<uint32_t> freeSlots_;
+        std::vector<uint32_t> order_;                    // scratch: live slots by priority
+        uint64_t frameIndex_ = 0;
+        TextureStreamerStats stats_{};
+    };
+}
@@ -0,0 +1,127 @@
+#include "Resource/AssetImporter.h"
+#include <algorithm>
+#include <filesystem>
+#include "Core/EngineFileIO.h"
+#include "Core/MappedFile.h"
+#include "Log/Logger.h"
+#include "Renderer/Texture/TextureFile.h"
+
+namespace SoulEngine
+{
+    namespace
+    {
+        constexpr std::size_t kMaxIncludeDepth = 32;
+
+        // "#include "name"" 中的 name；不是 include 行时返回空
+        std::string ParseInclude(const std::string &line)
+        {
+            const std::size_t start = line.find_first_not_of(" \t");
+            if (start == std::string::npos || line.compare(start, 8, "#include") != 0)
+                return {};
+            const std::size_t open = line.find('"', start + 8);
+            const std::size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+            if (close == std::string::npos)
+                return {};
+            return line.substr(open + 1, close - open - 1);
+        }
+    }
+
+    std::string ImportContext::AddOutput(const std::string &extension)
+    {
+        const std::string name = guid.ToString();
+        const std::string relative = "ImportedAssets/" + name.substr(0, 2) + "/" + name + extension;
+        outputs.push_back(relative);
+        const std::filesystem::path path = std::filesystem::path(libraryRoot) / relative;
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+        return path.generic_string();
+    }
+
+    void ImportContext::AddDependency(const std::string &dependencyPath)
+    {
+        if (std::find(dependencies.begin(), dependencies.end(), dependencyPath) == dependencies.end())
+            dependencies.push_back(dependencyPath);
+    }
+
+    std::vector<std::string> TextureImporter::GetExtensions() const
+    {
+        return { ".png", ".jpg", ".jpeg", ".bmp", ".tga" };
+    }
+
+    bool TextureImporter::Import(ImportContext &context)
+    {
+        Gfx::TextureCookOptions options;
+        options.srgb = context.settings.value("srgb", true);
+        const std::string format = context.settings.value("format", "bc3");
+        if (!Gfx::ParseCookFormat(format, options.format))
+        {
+            Logger::Error("TextureImporter: {} has an unknown format '{}'", context.assetPath, format);
+            return false;
+        }
+        options.mipFilter = context.settings.value("mipFilter", "box") == "kaiser" ? Gfx::MipFilter::Kaiser : Gfx::MipFilter::Box;
+        return Gfx::CookTexture({ context.sourcePath }, options, context.AddOutput(".stex"));
+    }
+
+    std::vector<std::string> ShaderImporter::GetExtensions() const
+    {
+        return { ".glsl" };
+    }
+
+    bool ShaderImporter::Import(ImportContext &context)
+    {
+        std::vector<std::string> stack;
+        std::string source;
+        if (!Expand(context, context.assetPath, stack, source))
+            return false;
+        return EngineFileIO::SaveText(context.AddOutput(".glsl"), source);
+    }
+
+    bool ShaderImporter::Expand(ImportContext &context, const std::string &assetPath, std::vector<std::string> &stack, std::string &out)
+    {
+        if (std::find(stack.begin(), stack.end(), assetPath) != stack.end() || stack.size() >= kMaxIncludeDepth)
+        {
+            Logger::Error("ShaderImporter: recursive #include of {} in {}", assetPath, context.assetPath);
+            return false;
+        }
+        // 直接读磁盘而不经过 EngineFileIO 的路径缓存：被包含的文件可能刚刚创建
+        MappedFile file(std::filesystem::path(context.assetsRoot) / assetPath);
+        if (!file)
+        {
+            Logger::Error("ShaderImporter: cannot read {} (included by {})", assetPath, context.assetPath);
+            return false;
+        }
+
+        stack.push_back(assetPath);
+        const std::string_view text = file.GetView();
+        const std::filesystem::path directory = std::filesystem::path(assetPath).parent_path();
+        std::size_t lineStart = 0;
+        while (lineStart < text.size())
+        {
+            std::size_t lineEnd = text.find('\n', lineStart);
+            if (lineEnd == std::string_view::npos)
+                lineEnd = text.size();
+            const std::string line(text.substr(lineStart, lineEnd - lineStart));
+            lineStart = lineEnd + 1;
+
+            const std::string include = ParseInclude(line);
+            if (include.empty())
+            {
+                out += line;
+                out += '\n';
+                continue;
+            }
+            const std::string includePath = (directory / include).lexically_normal().generic_string();
+            if (includePath.rfind("..", 0) == 0)
+            {
+                Logger::Error("ShaderImporter: #include \"{}\" in {} leaves the Assets directory", include, assetPath);
+                return false;
+            }
+            // 先登记依赖：被包含的文件缺失时，它出现后也会触发重新导入
+            context.AddDependency(includePath);
+            if (!Expand(context, includePath, stack, out))
+                return false;
+        }
+        stack.pop_back();
+        return true;
+    }
+} // namespace SoulEngine
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "nlohmann/json.hpp"
+#include "Resource/Guid.h"
+
+namespace SoulEngine
+{
+    /**
+     * @brief 一次导入的输入与输出
+     * 路径均以 '/' 分隔；assetPath 相对 Assets 目录，输出路径相对 Library 目录。
+     */
+    struct ImportContext
+    {
+        std::string assetPath;              // 例如 "Textures/player.png"
+        std::string sourcePath;             // 源文件的绝对路径
+        std::string assetsRoot;             // Assets 目录的绝对路径
+        std::string libraryRoot;            // Library 目录的绝对路径
+        GUID guid;
+        nlohmann::json settings;            // .meta 中的 importSettings，没有时为空对象
+
+        std::vector<std::string> dependencies;
+        std::vector<std::string> outputs;
+
+        // 登记一个输出文件，返回其绝对路径：Library/ImportedAssets/<GUID 前两位>/<GUID><extension>
+        std::string AddOutput(const std::string &extension);
+
+        // 登记导入时读取的其他资源（相对 Assets 的路径）；它们变化时本资源会重新导入
+        void AddDependency(const std::string &dependencyPath);
+    };
+
+    /**
+     * @brief 资源导入器：把 Assets 中的源文件转换为 Library 中的运行时格式
+     * Import 可能在 JobSystem 线程上并行调用，实现必须线程安全。
+     * 输出格式或默认设置变化时递增 GetVersion，已导入的资源会随之重新导入。
+     */
+    class IAssetImporter
+    {
+    public:
+        virtual ~IAssetImporter() = default;
+
+        virtual const char *GetName() const = 0;
+        virtual uint32_t GetVersion() const = 0;
+        // 小写、带点的扩展名，例如 ".png"
+        virtual std::vector<std::string> GetExtensions() const = 0;
+
+        virtual bool Import(ImportContext &context) = 0;
+    };
+
+    /**
+     * @brief 图片 -> .stex（CookTexture）
+     * 设置：srgb（默认 true）、format（rgba8/bc1/bc3/bc4/bc5/bc7，默认 bc3）、mipFilter（box/kaiser，默认 box）
+     */
+    class TextureImporter final : public IAssetImporter
+    {
+    public:
+        const char *GetName() const override { return "TextureImporter"; }
+        uint32_t GetVersion() const override { return 1; }
+        std::vector<std::string> GetExtensions() const override;
+        bool Import(ImportContext &context) override;
+    };
+
+    /**
+     * @brief GLSL 源码：展开 #include "file"（相对包含它的文件），被包含的文件登记为依赖
+     */
+    class ShaderImporter final : public IAssetImporter
+    {
+    public:
+        const char *GetName() const override { return "ShaderImporter"; }
+        uint32_t GetVersion() const override { return 1; }
+        std::vector<std::string> GetExtensions() const override;
+        bool Import(ImportContext &context) override;
+
+    private:
+        bool Expand(ImportContext &context, const std::string &assetPath, std::vector<std::string> &stack, std::string &out);
+    };
+} // namespace SoulEngine
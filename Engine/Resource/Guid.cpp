@@ -0,0 +1,87 @@
+#include "Resource/Guid.h"
+#include "Core/Hash.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <random>
+#include <thread>
+
+namespace SoulEngine
+{
+    namespace
+    {
+        void SetVersion(GUID &guid, uint64_t version)
+        {
+            guid.high = (guid.high & ~0xF000ull) | (version << 12);
+            guid.low = (guid.low & ~(0xC000ull << 48)) | (0x8000ull << 48); // RFC 4122 变体
+        }
+
+        int HexValue(char c)
+        {
+            if (c >= '0' && c <= '9')
+                return c - '0';
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            if (c >= 'a' && c <= 'f')
+                return c - 'a' + 10;
+            return -1;
+        }
+    }
+
+    std::string GUID::ToString() const
+    {
+        static const char kDigits[] = "0123456789abcdef";
+        std::string text;
+        text.reserve(36);
+        for (int i = 0; i < 32; ++i)
+        {
+            if (i == 8 || i == 12 || i == 16 || i == 20)
+                text.push_back('-');
+            const uint64_t word = i < 16 ? high : low;
+            text.push_back(kDigits[(word >> ((15 - i % 16) * 4)) & 0xF]);
+        }
+        return text;
+    }
+
+    GUID GUID::Generate()
+    {
+        static thread_local std::mt19937_64 rng{ std::random_device{}() ^ static_cast<uint64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) };
+        GUID guid{ rng(), rng() };
+        SetVersion(guid, 4);
+        return guid;
+    }
+
+    GUID GUID::FromPath(std::string_view path)
+    {
+        std::string normalized = std::filesystem::path(path).lexically_normal().generic_string();
+        std::transform(normalized.begin(), normalized.end(), normalized.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        GUID guid{ HashFNV1a(normalized.data(), normalized.size()),
+                   HashFNV1a(normalized.data(), normalized.size(), 0x84222325cbf29ce4ull) };
+        SetVersion(guid, 5);
+        return guid;
+    }
+
+    std::optional<GUID> GUID::Parse(std::string_view text)
+    {
+        if (text.size() != 36)
+            return std::nullopt;
+        GUID guid;
+        int digit = 0;
+        for (std::size_t i = 0; i < text.size(); ++i)
+        {
+            if (i == 8 || i == 13 || i == 18 || i == 23)
+            {
+                if (text[i] != '-')
+                    return std::nullopt;
+                continue;
+            }
+            const int value = HexValue(text[i]);
+            if (value < 0)
+                return std::nullopt;
+            uint64_t &word = digit < 16 ? guid.high : guid.low;
+            word = (word << 4) | static_cast<uint64_t>(value);
+            ++digit;
+        }
+        return guid;
+    }
+} // namespace SoulEngine
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace SoulEngine
+{
+    /**
+     * @brief 128 位资源标识，文本形式为 "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx"
+     * 有 .meta 文件的资源使用其中记录的随机 GUID（Generate），其余资源使用由路径确定的 GUID（FromPath），
+     * 同一路径在不同机器、不同运行之间得到相同的 GUID。
+     */
+    struct GUID
+    {
+        uint64_t high = 0;
+        uint64_t low = 0;
+
+        bool IsValid() const { return high != 0 || low != 0; }
+        std::string ToString() const;
+
+        // 随机 GUID（UUID version 4）
+        static GUID Generate();
+        // 由规范化路径（小写、'/' 分隔）派生的名称 GUID（UUID version 5 的布局，哈希为 FNV-1a）
+        static GUID FromPath(std::string_view path);
+        static std::optional<GUID> Parse(std::string_view text);
+
+        bool operator==(const GUID &other) const { return high == other.high && low == other.low; }
+        bool operator!=(const GUID &other) const { return !(*this == other); }
+        bool operator<(const GUID &other) const { return high != other.high ? high < other.high : low < other.low; }
+    };
+} // namespace SoulEngine
+
+namespace std
+{
+    template <>
+    struct hash<SoulEngine::GUID>
+    {
+        std::size_t operator()(const SoulEngine::GUID &guid) const noexcept
+        {
+            return static_cast<std::size_t>(guid.high ^ (guid.low * 0x9e3779b97f4a7c15ull));
+        }
+    };
+}
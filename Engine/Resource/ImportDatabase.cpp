@@ -0,0 +1,548 @@
+#include "Resource/ImportDatabase.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <unordered_set>
+#include "Core/EngineFileIO.h"
+#include "Core/Hash.h"
+#include "Core/JobSystem.h"
+#include "Core/MappedFile.h"
+#include "Log/Logger.h"
+#include "Resource/ResourceManager.h"
+
+namespace SoulEngine
+{
+    namespace
+    {
+        // 记录格式或哈希方式变化时递增，旧数据库随之作废（全部重新导入）
+        constexpr uint32_t kDatabaseVersion = 1;
+        constexpr uint32_t kScanGrain = 16;
+
+        double ElapsedMs(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        std::string GetLowerExtension(const std::string &path)
+        {
+            std::string extension = std::filesystem::path(path).extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return extension;
+        }
+
+        bool Contains(const std::vector<std::string> &values, const std::string &value)
+        {
+            return std::find(values.begin(), values.end(), value) != values.end();
+        }
+    }
+
+    struct ImportDatabase::ScanEntry
+    {
+        std::string path;
+        std::filesystem::path absolutePath;
+        bool hasMeta = false;
+        uint64_t size = 0;
+        int64_t modifiedTime = 0;
+
+        // 以下在并行阶段填写
+        GUID guid;
+        nlohmann::json settings = nlohmann::json::object();
+        uint64_t settingsHash = 0;
+        uint64_t contentHash = 0;
+        bool hashed = false;
+        bool readable = true;
+        IAssetImporter *importer = nullptr;
+    };
+
+    void ImportDatabase::RegisterImporter(std::shared_ptr<IAssetImporter> importer)
+    {
+        for (const std::string &extension : importer->GetExtensions())
+            importers_[extension] = importer;
+    }
+
+    void ImportDatabase::RegisterDefaultImporters()
+    {
+        RegisterImporter(std::make_shared<TextureImporter>());
+        RegisterImporter(std::make_shared<ShaderImporter>());
+    }
+
+    bool ImportDatabase::Open(const std::string &assetsPath, const std::string &libraryPath)
+    {
+        Close();
+        std::error_code ec;
+        if (!std::filesystem::is_directory(assetsPath, ec))
+        {
+            Logger::Error("ImportDatabase: assets directory {} does not exist", assetsPath);
+            return false;
+        }
+        assetsPath_ = std::filesystem::absolute(assetsPath).lexically_normal().generic_string();
+        libraryPath_ = std::filesystem::absolute(libraryPath).lexically_normal().generic_string();
+        std::filesystem::create_directories(std::filesystem::path(GetDatabasePath()).parent_path(), ec);
+        open_ = true;
+        Load();
+        return true;
+    }
+
+    void ImportDatabase::Close()
+    {
+        open_ = false;
+        assetsPath_.clear();
+        libraryPath_.clear();
+        records_.clear();
+        dependencies_.clear();
+        dependents_.clear();
+    }
+
+    std::string ImportDatabase::GetDatabasePath() const
+    {
+        return libraryPath_ + "/AssetDatabase/ImportDatabase.json";
+    }
+
+    void ImportDatabase::Load()
+    {
+        const std::filesystem::path path = GetDatabasePath();
+        std::error_code ec;
+        if (!std::filesystem::exists(path, ec))
+            return;
+        MappedFile file(path);
+        const std::string_view text = file.GetView();
+        const nlohmann::json root = nlohmann::json::parse(text.begin(), text.end(), nullptr, false);
+        if (root.is_discarded() || !root.is_object() || root.value("version", 0u) != kDatabaseVersion)
+        {
+            Logger::Warn("ImportDatabase: {} is invalid or outdated, all assets will be imported again", path.string());
+            return;
+        }
+
+        for (const nlohmann::json &item : root.value("assets", nlohmann::json::array()))
+        {
+            ImportRecord record;
+            record.path = item.value("path", "");
+            record.guid = GUID::Parse(item.value("guid", "")).value_or(GUID());
+            if (record.path.empty() || !record.guid.IsValid())
+                continue;
+            record.importer = item.value("importer", "");
+            record.importerVersion = item.value("importerVersion", 0u);
+            record.settingsHash = item.value("settingsHash", uint64_t(0));
+            record.contentHash = item.value("contentHash", uint64_t(0));
+            record.size = item.value("size", uint64_t(0));
+            record.modifiedTime = item.value("modifiedTime", int64_t(0));
+            record.dependencies = item.value("dependencies", std::vector<std::string>());
+            record.outputs = item.value("outputs", std::vector<std::string>());
+            record.imported = item.value("imported", false);
+            records_[record.path] = std::move(record);
+        }
+        RebuildDependencyMaps();
+    }
+
+    bool ImportDatabase::Save()
+    {
+        if (!open_)
+            return false;
+
+        // 按路径排序，数据库文件的差异便于查看
+        std::vector<const ImportRecord *> sorted;
+        sorted.reserve(records_.size());
+        for (const auto &[path, record] : records_)
+            sorted.push_back(&record);
+        std::sort(sorted.begin(), sorted.end(), [](const ImportRecord *a, const ImportRecord *b) { return a->path < b->path; });
+
+        nlohmann::json assets = nlohmann::json::array();
+        for (const ImportRecord *record : sorted)
+        {
+            assets.push_back({
+                { "path", record->path },
+                { "guid", record->guid.ToString() },
+                { "importer", record->importer },
+                { "importerVersion", record->importerVersion },
+                { "settingsHash", record->settingsHash },
+                { "contentHash", record->contentHash },
+                { "size", record->size },
+                { "modifiedTime", record->modifiedTime },
+                { "dependencies", record->dependencies },
+                { "outputs", record->outputs },
+                { "imported", record->imported },
+            });
+        }
+        const nlohmann::json root = { { "version", kDatabaseVersion }, { "assets", std::move(assets) } };
+
+        // 先写临时文件再替换，写入中途退出不会留下损坏的数据库
+        const std::string path = GetDatabasePath();
+        const std::string temporary = path + ".tmp";
+        if (!EngineFileIO::SaveText(temporary, root.dump(1, '\t')))
+            return false;
+        std::error_code ec;
+        std::filesystem::rename(temporary, path, ec);
+        if (ec)
+        {
+            Logger::Error("ImportDatabase: failed to replace {}: {}", path, ec.message());
+            return false;
+        }
+        return true;
+    }
+
+    IAssetImporter *ImportDatabase::FindImporter(const std::string &assetPath) const
+    {
+        auto it = importers_.find(GetLowerExtension(assetPath));
+        return it != importers_.end() ? it->second.get() : nullptr;
+    }
+
+    bool ImportDatabase::NeedsImport(const ScanEntry &entry, const ImportRecord *record) const
+    {
+        if (!record || !entry.importer)
+            return entry.importer != nullptr;
+        if (record->importer != entry.importer->GetName() || record->importerVersion != entry.importer->GetVersion() ||
+            record->settingsHash != entry.settingsHash || record->contentHash != entry.contentHash || record->guid != entry.guid)
+            return true;
+        // 失败的导入在输入变化前不再重试
+        if (!record->imported)
+            return false;
+        std::error_code ec;
+        for (const std::string &output : record->outputs)
+        {
+            if (!std::filesystem::exists(libraryPath_ + "/" + output, ec))
+                return true;
+        }
+        return false;
+    }
+
+    ImportStats ImportDatabase::Refresh()
+    {
+        ImportStats stats;
+        if (!open_)
+            return stats;
+        const auto scanStart = std::chrono::steady_clock::now();
+
+        // 1. 枚举 Assets（跳过以 '.' 开头的文件与目录）
+        std::vector<ScanEntry> scanned;
+        std::unordered_set<std::string> metaFiles;
+        std::error_code ec;
+        for (auto it = std::filesystem::recursive_directory_iterator(assetsPath_, std::filesystem::directory_options::skip_permission_denied, ec);
+             !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+        {
+            const std::filesystem::path &absolutePath = it->path();
+            if (absolutePath.filename().string().rfind('.', 0) == 0)
+            {
+                if (it->is_directory(ec))
+                    it.disable_recursion_pending();
+                continue;
+            }
+            if (!it->is_regular_file(ec))
+                continue;
+            const std::string path = absolutePath.lexically_relative(assetsPath_).generic_string();
+            if (absolutePath.extension() == ".meta")
+            {
+                metaFiles.insert(path);
+                continue;
+            }
+            ScanEntry entry;
+            entry.path = path;
+            entry.absolutePath = absolutePath;
+            entry.size = it->file_size(ec);
+            entry.modifiedTime = static_cast<int64_t>(it->last_write_time(ec).time_since_epoch().count());
+            scanned.push_back(std::move(entry));
+        }
+        for (ScanEntry &entry : scanned)
+        {
+            entry.hasMeta = metaFiles.count(entry.path + ".meta") != 0;
+            entry.importer = FindImporter(entry.path);
+        }
+
+        // 2. 并行读取 .meta 与计算内容哈希；大小与修改时间未变的文件沿用记录中的哈希
+        JobSystem::GetInstance().ParallelFor(static_cast<uint32_t>(scanned.size()), kScanGrain, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                ScanEntry &entry = scanned[i];
+                if (entry.hasMeta)
+                {
+                    MappedFile metaFile(std::filesystem::path(entry.absolutePath) += ".meta");
+                    const std::string_view text = metaFile.GetView();
+                    const nlohmann::json meta = nlohmann::json::parse(text.begin(), text.end(), nullptr, false);
+                    if (meta.is_object())
+                    {
+                        entry.guid = GUID::Parse(meta.value("guid", "")).value_or(GUID());
+                        const auto settings = meta.find("importSettings");
+                        if (settings != meta.end() && settings->is_object())
+                            entry.settings = *settings;
+                    }
+                }
+                if (!entry.guid.IsValid())
+                    entry.guid = GUID::FromPath(entry.path);
+                const std::string settings = entry.settings.dump();
+                entry.settingsHash = HashXXH64(settings.data(), settings.size());
+
+                auto record = records_.find(entry.path);
+                if (record != records_.end() && record->second.size == entry.size && record->second.modifiedTime == entry.modifiedTime)
+                {
+                    entry.contentHash = record->second.contentHash;
+                    continue;
+                }
+                MappedFile file(entry.absolutePath);
+                entry.readable = file.IsOpen();
+                entry.contentHash = HashXXH64(file.Data(), file.Size());
+                entry.hashed = true;
+            }
+        });
+
+        // 3. 找出内容变化（含新增、删除）的文件与自身需要导入的资源
+        std::unordered_map<std::string, ScanEntry> entries;
+        entries.reserve(scanned.size());
+        std::vector<std::string> changed;
+        std::unordered_set<std::string> dirty;
+        bool modified = false;
+        for (ScanEntry &entry : scanned)
+        {
+            ++stats.scanned;
+            stats.hashed += entry.hashed ? 1 : 0;
+            auto record = records_.find(entry.path);
+            const ImportRecord *existing = record != records_.end() ? &record->second : nullptr;
+            if (!existing || existing->contentHash != entry.contentHash)
+                changed.push_back(entry.path);
+            if (entry.readable && NeedsImport(entry, existing))
+                dirty.insert(entry.path);
+            entries.emplace(entry.path, std::move(entry));
+        }
+        for (auto it = records_.begin(); it != records_.end();)
+        {
+            if (entries.count(it->first))
+            {
+                ++it;
+                continue;
+            }
+            RemoveOutputs(it->second.outputs, {});
+            changed.push_back(it->first);
+            ++stats.removed;
+            it = records_.erase(it);
+        }
+
+        // 4. 依赖了变化文件的资源需要重新导入，并继续传递给依赖它们的资源
+        std::deque<std::string> queue(changed.begin(), changed.end());
+        queue.insert(queue.end(), dirty.begin(), dirty.end());
+        while (!queue.empty())
+        {
+            const std::string path = std::move(queue.front());
+            queue.pop_front();
+            auto dependents = dependents_.find(path);
+            if (dependents == dependents_.end())
+                continue;
+            for (const std::string &dependent : dependents->second)
+            {
+                auto entry = entries.find(dependent);
+                if (entry != entries.end() && entry->second.importer && entry->second.readable && dirty.insert(dependent).second)
+                    queue.push_back(dependent);
+            }
+        }
+
+        // 5. 不需要导入的文件只更新记录；失去导入器的资源删除旧输出
+        for (auto &[path, entry] : entries)
+        {
+            if (dirty.count(path))
+                continue;
+            ImportRecord &record = records_[path];
+            if (!entry.importer && !record.outputs.empty())
+            {
+                RemoveOutputs(record.outputs, {});
+                record.outputs.clear();
+                record.dependencies.clear();
+                record.importer.clear();
+                record.importerVersion = 0;
+                record.imported = false;
+            }
+            modified |= record.path.empty() || record.guid != entry.guid || record.size != entry.size ||
+                        record.modifiedTime != entry.modifiedTime || record.contentHash != entry.contentHash;
+            record.path = path;
+            record.guid = entry.guid;
+            record.settingsHash = entry.settingsHash;
+            record.size = entry.size;
+            record.modifiedTime = entry.modifiedTime;
+            record.contentHash = entry.contentHash;
+            if (entry.importer)
+                ++stats.upToDate;
+        }
+        stats.scanMs = ElapsedMs(scanStart);
+
+        // 6. 按依赖分批导入
+        const auto importStart = std::chrono::steady_clock::now();
+        if (!dirty.empty())
+            Import(std::vector<std::string>(dirty.begin(), dirty.end()), entries, stats);
+        stats.importMs = ElapsedMs(importStart);
+        if (modified || !dirty.empty() || stats.removed > 0)
+        {
+            RebuildDependencyMaps();
+            Save();
+        }
+
+        ResourceManager &resources = ResourceManager::GetInstance();
+        for (const auto &[path, record] : records_)
+        {
+            if (record.imported && !record.outputs.empty())
+                resources.RegisterAsset(record.guid, libraryPath_ + "/" + record.outputs.front());
+        }
+        // 已加载的资源换成新的导入结果
+        for (const std::string &path : dirty)
+        {
+            const ImportRecord &record = records_.at(path);
+            if (record.imported && resources.IsResident(record.guid))
+                resources.ReloadAsset(record.guid);
+        }
+
+        Logger::Log("ImportDatabase: {} files ({} hashed), {} imported, {} failed, {} up to date, {} removed; scan {:.1f} ms, import {:.1f} ms",
+                    stats.scanned, stats.hashed, stats.imported, stats.failed, stats.upToDate, stats.removed, stats.scanMs, stats.importMs);
+        return stats;
+    }
+
+    void ImportDatabase::Import(const std::vector<std::string> &paths, std::unordered_map<std::string, ScanEntry> &entries, ImportStats &stats)
+    {
+        // 同批内的资源互不依赖；依赖关系取自上一次导入的记录（新资源没有记录，归入第一批）
+        std::unordered_set<std::string> remaining(paths.begin(), paths.end());
+        std::unordered_map<std::string, uint32_t> pendingCount;
+        std::vector<std::string> wave;
+        for (const std::string &path : paths)
+        {
+            uint32_t pending = 0;
+            auto dependencies = dependencies_.find(path);
+            if (dependencies != dependencies_.end())
+            {
+                for (const std::string &dependency : dependencies->second)
+                    pending += dependency != path && remaining.count(dependency) ? 1 : 0;
+            }
+            pendingCount[path] = pending;
+            if (pending == 0)
+                wave.push_back(path);
+        }
+
+        while (!remaining.empty())
+        {
+            if (wave.empty())
+            {
+                Logger::Warn("ImportDatabase: circular dependencies between {} assets, importing them in arbitrary order", remaining.size());
+                wave.assign(remaining.begin(), remaining.end());
+            }
+            std::sort(wave.begin(), wave.end());
+
+            std::vector<ImportContext> contexts(wave.size());
+            for (std::size_t i = 0; i < wave.size(); ++i)
+            {
+                const ScanEntry &entry = entries.at(wave[i]);
+                ImportContext &context = contexts[i];
+                context.assetPath = entry.path;
+                context.sourcePath = entry.absolutePath.generic_string();
+                context.assetsRoot = assetsPath_;
+                context.libraryRoot = libraryPath_;
+                context.guid = entry.guid;
+                context.settings = entry.settings;
+            }
+            std::vector<uint8_t> succeeded(wave.size(), 0);
+            JobSystem::GetInstance().ParallelFor(static_cast<uint32_t>(wave.size()), 1, [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    IAssetImporter *importer = entries.at(wave[i]).importer;
+                    try
+                    {
+                        succeeded[i] = importer->Import(contexts[i]) ? 1 : 0;
+                    }
+                    catch (const std::exception &e)
+                    {
+                        Logger::Error("ImportDatabase: {} threw while importing {}: {}", importer->GetName(), wave[i], e.what());
+                    }
+                }
+            });
+
+            std::vector<std::string> next;
+            for (std::size_t i = 0; i < wave.size(); ++i)
+            {
+                const ScanEntry &entry = entries.at(wave[i]);
+                ImportContext &context = contexts[i];
+                ImportRecord &record = records_[entry.path];
+                // 失败时不保留任何输出，避免加载到与源文件不一致的旧结果
+                if (succeeded[i])
+                {
+                    RemoveOutputs(record.outputs, context.outputs);
+                    record.outputs = std::move(context.outputs);
+                    ++stats.imported;
+                }
+                else
+                {
+                    RemoveOutputs(record.outputs, {});
+                    RemoveOutputs(context.outputs, {});
+                    record.outputs.clear();
+                    ++stats.failed;
+                    Logger::Error("ImportDatabase: failed to import {}", entry.path);
+                }
+                record.path = entry.path;
+                record.guid = entry.guid;
+                record.importer = entry.importer->GetName();
+                record.importerVersion = entry.importer->GetVersion();
+                record.settingsHash = entry.settingsHash;
+                record.contentHash = entry.contentHash;
+                record.size = entry.size;
+                record.modifiedTime = entry.modifiedTime;
+                record.dependencies = std::move(context.dependencies);
+                record.imported = succeeded[i] != 0;
+
+                remaining.erase(entry.path);
+                auto dependents = dependents_.find(entry.path);
+                if (dependents == dependents_.end())
+                    continue;
+                for (const std::string &dependent : dependents->second)
+                {
+                    if (remaining.count(dependent) && pendingCount[dependent] > 0 && --pendingCount[dependent] == 0)
+                        next.push_back(dependent);
+                }
+            }
+            wave = std::move(next);
+        }
+    }
+
+    void ImportDatabase::RemoveOutputs(const std::vector<std::string> &outputs, const std::vector<std::string> &keep) const
+    {
+        std::error_code ec;
+        for (const std::string &output : outputs)
+        {
+            if (!Contains(keep, output))
+                std::filesystem::remove(libraryPath_ + "/" + output, ec);
+        }
+    }
+
+    void ImportDatabase::RebuildDependencyMaps()
+    {
+        dependencies_.clear();
+        dependents_.clear();
+        for (const auto &[path, record] : records_)
+        {
+            for (const std::string &dependency : record.dependencies)
+            {
+                dependencies_[path].insert(dependency);
+                dependents_[dependency].insert(path);
+            }
+        }
+    }
+
+    const ImportRecord *ImportDatabase::FindRecord(const std::string &assetPath) const
+    {
+        auto it = records_.find(assetPath);
+        return it != records_.end() ? &it->second : nullptr;
+    }
+
+    std::string ImportDatabase::GetImportedPath(const std::string &assetPath) const
+    {
+        const ImportRecord *record = FindRecord(assetPath);
+        if (!record || !record->imported || record->outputs.empty())
+            return {};
+        return libraryPath_ + "/" + record->outputs.front();
+    }
+
+    std::set<std::string> ImportDatabase::GetDependencies(const std::string &assetPath) const
+    {
+        auto it = dependencies_.find(assetPath);
+        return it != dependencies_.end() ? it->second : std::set<std::string>();
+    }
+
+    std::set<std::string> ImportDatabase::GetDependents(const std::string &assetPath) const
+    {
+        auto it = dependents_.find(assetPath);
+        return it != dependents_.end() ? it->second : std::set<std::string>();
+    }
+} // namespace SoulEngine
@@ -0,0 +1,113 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Define.h"
+#include "Resource/AssetImporter.h"
+#include "Resource/Guid.h"
+
+namespace SoulEngine
+{
+    /**
+     * @brief 导入数据库中一个资源的记录
+     * 没有导入器的文件（如只被 #include 的头文件）同样记录内容哈希，用于依赖变化的判断。
+     */
+    struct ImportRecord
+    {
+        std::string path;                       // 相对 Assets，'/' 分隔
+        GUID guid;
+        std::string importer;                   // 没有导入器时为空
+        uint32_t importerVersion = 0;
+        uint64_t settingsHash = 0;              // importSettings 的 XXH64
+        uint64_t contentHash = 0;               // 文件内容的 XXH64
+        uint64_t size = 0;
+        int64_t modifiedTime = 0;               // 大小与修改时间都未变时不重新计算内容哈希
+        std::vector<std::string> dependencies;  // 相对 Assets 的路径
+        std::vector<std::string> outputs;       // 相对 Library 的路径
+        bool imported = false;                  // 最近一次导入是否成功
+    };
+
+    struct ImportStats
+    {
+        uint32_t scanned = 0;
+        uint32_t hashed = 0;        // 大小或修改时间变化而重新计算内容哈希的文件
+        uint32_t imported = 0;
+        uint32_t failed = 0;
+        uint32_t upToDate = 0;
+        uint32_t removed = 0;
+        double scanMs = 0.0;
+        double importMs = 0.0;
+    };
+
+    /**
+     * @brief 导入数据库 - 增量导入 Assets 并把结果缓存在 Library 中
+     *
+     * 每个资源记录内容哈希、导入器版本与设置哈希，数据库保存在 Library/AssetDatabase/ImportDatabase.json。
+     * Refresh 扫描 Assets 目录，只重新导入以下资源：新增的、内容/设置/导入器版本变化的、输出文件缺失的，
+     * 以及（沿 dependents_ 传递地）依赖了变化或删除文件的资源。已删除资源的输出文件随之删除。
+     * 导入按依赖分批并行执行，同一批内的资源互不依赖；导入成功的资源通过 ResourceManager::RegisterAsset
+     * 以 GUID 注册其输出文件，已常驻的资源随之重新加载。未变化的项目再次打开时只需逐个 stat 文件，无需读取内容。
+     * 资源的 GUID 与导入设置来自同名 .meta 文件（"guid"、"importSettings"），没有 .meta 时 GUID 由路径派生。
+     * 非线程安全，应在主线程调用。
+     *
+     * 使用方式:
+     *   ImportDatabase database;
+     *   database.RegisterDefaultImporters();
+     *   database.Open(project.GetAssetsPath(), project.GetLibraryPath());
+     *   ImportStats stats = database.Refresh();
+     *   std::string cooked = database.GetImportedPath("Textures/player.png");
+     */
+    class ImportDatabase
+    {
+        NON_COPY_AND_MOVE(ImportDatabase)
+
+    public:
+        ImportDatabase() = default;
+        ~ImportDatabase() = default;
+
+        // 注册导入器；同一扩展名后注册的覆盖先注册的
+        void RegisterImporter(std::shared_ptr<IAssetImporter> importer);
+        // TextureImporter 与 ShaderImporter
+        void RegisterDefaultImporters();
+
+        // 读取 Library 中的数据库（不存在或版本不符时视为空），不会导入任何资源
+        bool Open(const std::string &assetsPath, const std::string &libraryPath);
+        void Close();
+        bool IsOpen() const { return open_; }
+
+        // 扫描 Assets 并导入需要更新的资源，有变化时保存数据库
+        ImportStats Refresh();
+        bool Save();
+
+        const ImportRecord *FindRecord(const std::string &assetPath) const;
+        // 导入结果（第一个输出文件）的绝对路径；未导入时为空
+        std::string GetImportedPath(const std::string &assetPath) const;
+        // 直接依赖与直接被依赖的资源路径
+        std::set<std::string> GetDependencies(const std::string &assetPath) const;
+        std::set<std::string> GetDependents(const std::string &assetPath) const;
+        std::size_t GetRecordCount() const { return records_.size(); }
+
+    private:
+        struct ScanEntry;
+
+        std::string GetDatabasePath() const;
+        void Load();
+        IAssetImporter *FindImporter(const std::string &assetPath) const;
+        bool NeedsImport(const ScanEntry &entry, const ImportRecord *record) const;
+        void Import(const std::vector<std::string> &paths, std::unordered_map<std::string, ScanEntry> &entries, ImportStats &stats);
+        void RemoveOutputs(const std::vector<std::string> &outputs, const std::vector<std::string> &keep) const;
+        void RebuildDependencyMaps();
+
+        bool open_ = false;
+        std::string assetsPath_;
+        std::string libraryPath_;
+        std::unordered_map<std::string, std::shared_ptr<IAssetImporter>> importers_;   // 扩展名 -> 导入器
+        std::unordered_map<std::string, ImportRecord> records_;                        // 资源路径 -> 记录
+        // 以资源路径为键：依赖的文件可能尚不存在，也就没有 GUID
+        std::unordered_map<std::string, std::set<std::string>> dependencies_;
+        std::unordered_map<std::string, std::set<std::string>> dependents_;
+    };
+} // namespace SoulEngine
@@ -0,0 +1,30 @@
+#include "Resource/Resource.h"
+#include "Log/Logger.h"
+
+namespace SoulEngine
+{
+    std::shared_ptr<TextResource> TextResource::Load(const std::string &/*path*/, std::vector<uint8_t> &bytes)
+    {
+        auto resource = std::make_shared<TextResource>();
+        resource->text_.assign(bytes.begin(), bytes.end());
+        return resource;
+    }
+
+    std::shared_ptr<BinaryResource> BinaryResource::Load(const std::string &/*path*/, std::vector<uint8_t> &bytes)
+    {
+        auto resource = std::make_shared<BinaryResource>();
+        resource->data_ = std::move(bytes);
+        return resource;
+    }
+
+    std::shared_ptr<ImageResource> ImageResource::Load(const std::string &path, std::vector<uint8_t> &bytes)
+    {
+        auto resource = std::make_shared<ImageResource>();
+        if (!Gfx::DecodeImageRGBA8(bytes.data(), bytes.size(), resource->image_))
+        {
+            Logger::Error("ImageResource: failed to decode {}", path);
+            return nullptr;
+        }
+        return resource;
+    }
+} // namespace SoulEngine
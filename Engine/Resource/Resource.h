@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Resource/Guid.h"
+#include "Renderer/Texture/TextureSource.h"
+
+namespace SoulEngine
+{
+    /**
+     * @brief 由 ResourceManager 管理的资源基类
+     *
+     * 派生类型需要提供：
+     *   static constexpr const char* kTypeName;       // 类型名，用于预算、统计与异步解码的合并键
+     *   static std::shared_ptr<T> Load(const std::string& path, std::vector<uint8_t>& bytes);
+     * Load 由文件内容构造资源（可以取走 bytes），失败返回空；异步加载时在 JobSystem 线程上调用。
+     */
+    class Resource
+    {
+    public:
+        virtual ~Resource() = default;
+
+        const GUID &GetGUID() const { return guid_; }
+        const std::string &GetPath() const { return path_; }
+
+        // 常驻内存大小（字节），用于预算与统计；加载后不应再变化
+        virtual std::size_t GetMemoryUsage() const = 0;
+
+    private:
+        friend class ResourceManager;
+        GUID guid_;
+        std::string path_;
+    };
+
+    // 文本资源（着色器源码、配置等）
+    class TextResource final : public Resource
+    {
+    public:
+        static constexpr const char *kTypeName = "Text";
+        static std::shared_ptr<TextResource> Load(const std::string &path, std::vector<uint8_t> &bytes);
+
+        const std::string &GetText() const { return text_; }
+        std::size_t GetMemoryUsage() const override { return text_.capacity(); }
+
+    private:
+        std::string text_;
+    };
+
+    // 原始字节资源
+    class BinaryResource final : public Resource
+    {
+    public:
+        static constexpr const char *kTypeName = "Binary";
+        static std::shared_ptr<BinaryResource> Load(const std::string &path, std::vector<uint8_t> &bytes);
+
+        const std::vector<uint8_t> &GetData() const { return data_; }
+        std::size_t GetMemoryUsage() const override { return data_.capacity(); }
+
+    private:
+        std::vector<uint8_t> data_;
+    };
+
+    // 解码为 RGBA8 的图片（stb_image 支持的格式）
+    class ImageResource final : public Resource
+    {
+    public:
+        static constexpr const char *kTypeName = "Image";
+        static std::shared_ptr<ImageResource> Load(const std::string &path, std::vector<uint8_t> &bytes);
+
+        const Gfx::ImageRGBA8 &GetImage() const { return image_; }
+        std::size_t GetMemoryUsage() const override { return image_.pixels.capacity(); }
+
+    private:
+        Gfx::ImageRGBA8 image_;
+    };
+} // namespace SoulEngine
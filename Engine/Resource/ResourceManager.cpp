@@ -0,0 +1,371 @@
+#include "Resource/ResourceManager.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <limits>
+
+namespace SoulEngine
+{
+    std::string ResourceManager::NormalizePath(const std::string &path)
+    {
+        std::string normalized = std::filesystem::path(path).lexically_normal().generic_string();
+        std::transform(normalized.begin(), normalized.end(), normalized.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return normalized;
+    }
+
+    GUID ResourceManager::GetGUID(const std::string &path)
+    {
+        const std::string key = NormalizePath(path);
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pathToGuid_.find(key);
+        if (it != pathToGuid_.end())
+            return it->second;
+        const GUID guid = GUID::FromPath(key);
+        pathToGuid_.emplace(key, guid);
+        guidToPath_.emplace(guid, path);
+        return guid;
+    }
+
+    void ResourceManager::RegisterAsset(const GUID &guid, const std::string &path)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pathToGuid_[NormalizePath(path)] = guid;
+        guidToPath_[guid] = path;
+    }
+
+    std::string ResourceManager::GetPath(const GUID &guid)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = guidToPath_.find(guid);
+        return it != guidToPath_.end() ? it->second : std::string();
+    }
+
+    bool ResourceManager::IsResident(const GUID &guid)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return slots_.count(guid) != 0;
+    }
+
+    void ResourceManager::EnableHotReload(bool enable)
+    {
+        std::vector<FileWatcher::WatchId> watches;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (hotReloadEnabled_ == enable)
+                return;
+            hotReloadEnabled_ = enable;
+            watches.swap(hotReloadWatches_);
+        }
+        FileWatcher &watcher = FileWatcher::GetInstance();
+        for (FileWatcher::WatchId id : watches)
+            watcher.Unwatch(id);
+        if (!enable)
+            return;
+
+        for (const std::filesystem::path &searchPath : EngineFileIO::GetSearchPaths())
+        {
+            const FileWatcher::WatchId id = watcher.Watch(searchPath, true, [this](const std::vector<FileChangeEvent> &events) {
+                OnFilesChanged(events);
+            });
+            if (id != 0)
+                watches.push_back(id);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        hotReloadWatches_ = std::move(watches);
+    }
+
+    bool ResourceManager::IsHotReloadEnabled()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return hotReloadEnabled_;
+    }
+
+    void ResourceManager::OnFilesChanged(const std::vector<FileChangeEvent> &events)
+    {
+        // 资源以加载时的路径登记：相对搜索路径的路径，或导入系统注册的绝对路径
+        std::vector<GUID> changed;
+        for (const FileChangeEvent &event : events)
+        {
+            if (event.isDirectory || event.action == FileAction::Deleted)
+                continue;
+            std::vector<std::string> candidates{ event.path.generic_string() };
+            for (const std::filesystem::path &searchPath : EngineFileIO::GetSearchPaths())
+            {
+                const std::filesystem::path relative = event.path.lexically_relative(std::filesystem::absolute(searchPath).lexically_normal());
+                if (!relative.empty() && *relative.begin() != "..")
+                    candidates.push_back(relative.generic_string());
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const std::string &candidate : candidates)
+            {
+                auto guid = pathToGuid_.find(NormalizePath(candidate));
+                if (guid != pathToGuid_.end() && slots_.count(guid->second) &&
+                    std::find(changed.begin(), changed.end(), guid->second) == changed.end())
+                    changed.push_back(guid->second);
+            }
+        }
+        for (const GUID &guid : changed)
+            ReloadAsset(guid);
+    }
+
+    bool ResourceManager::ReloadAsset(const GUID &guid)
+    {
+        std::string path;
+        ResourceLoadFn load = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = slots_.find(guid);
+            if (it == slots_.end())
+                return false;
+            path = std::atomic_load(&it->second->resource)->GetPath();
+            load = GetTypeState(it->second->typeName).load;
+        }
+        if (!load || !EngineFileIO::FileExists(path))
+        {
+            Logger::Error("ResourceManager: cannot reload {}", path);
+            return false;
+        }
+        std::vector<uint8_t> bytes = EngineFileIO::LoadBinary(path);
+        std::shared_ptr<Resource> resource = load(path, bytes);
+        if (!resource)
+        {
+            Logger::Error("ResourceManager: failed to reload {}, keeping the previous version", path);
+            return false;
+        }
+        resource->guid_ = guid;
+        resource->path_ = path;
+
+        std::shared_ptr<Resource> previous;
+        std::vector<ResourceReloadCallback> listeners;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = slots_.find(guid);
+            if (it == slots_.end())
+                return false;
+            Detail::ResourceSlot &slot = *it->second;
+            TypeState &type = GetTypeState(slot.typeName);
+            const std::size_t size = resource->GetMemoryUsage();
+            type.stats.residentBytes = type.stats.residentBytes - slot.size + size;
+            ++type.stats.reloads;
+            slot.size = size;
+            // 句柄在其他线程上可能正在读取 slot.resource
+            previous = std::atomic_exchange(&slot.resource, std::move(resource));
+            EnforceBudget(type);
+            for (const auto &[id, listener] : reloadListeners_)
+                listeners.push_back(listener);
+        }
+        // 旧对象在锁外释放
+        previous.reset();
+        Logger::Log("ResourceManager: reloaded {}", path);
+        for (const ResourceReloadCallback &listener : listeners)
+            listener(guid);
+        return true;
+    }
+
+    uint32_t ResourceManager::AddReloadListener(ResourceReloadCallback callback)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const uint32_t id = nextListenerId_++;
+        reloadListeners_.emplace(id, std::move(callback));
+        return id;
+    }
+
+    void ResourceManager::RemoveReloadListener(uint32_t id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reloadListeners_.erase(id);
+    }
+
+    ResourceManager::TypeState &ResourceManager::GetTypeState(const char *typeName)
+    {
+        auto it = types_.find(typeName);
+        if (it == types_.end())
+        {
+            it = types_.emplace(typeName, TypeState{}).first;
+            it->second.stats.typeName = typeName;
+            it->second.stats.budgetBytes = std::numeric_limits<std::size_t>::max();
+        }
+        return it->second;
+    }
+
+    ResourceManager::LookupResult ResourceManager::Acquire(const GUID &guid, const char *typeName,
+                                                           std::shared_ptr<Detail::ResourceSlot> &slot)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        TypeState &type = GetTypeState(typeName);
+        auto it = slots_.find(guid);
+        if (it == slots_.end())
+        {
+            ++type.stats.misses;
+            return LookupResult::Miss;
+        }
+        if (std::string_view(it->second->typeName) != typeName)
+        {
+            Logger::Error("ResourceManager: {} is already loaded as {}, requested as {}",
+                          guid.ToString(), it->second->typeName, typeName);
+            return LookupResult::WrongType;
+        }
+        ++type.stats.hits;
+        slot = it->second;
+        AddRef(*slot);
+        return LookupResult::Hit;
+    }
+
+    std::shared_ptr<Detail::ResourceSlot> ResourceManager::Insert(const GUID &guid, const std::string &path, const char *typeName,
+                                                                  ResourceLoadFn load, std::shared_ptr<Resource> resource)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = slots_.find(guid);
+        if (it != slots_.end())
+        {
+            // 另一次加载先完成了（同步与异步同时请求同一资源），丢弃这份
+            if (std::string_view(it->second->typeName) != typeName)
+                return nullptr;
+            AddRef(*it->second);
+            return it->second;
+        }
+
+        resource->guid_ = guid;
+        resource->path_ = path;
+        auto slot = std::make_shared<Detail::ResourceSlot>();
+        slot->guid = guid;
+        slot->typeName = typeName;
+        slot->size = resource->GetMemoryUsage();
+        slot->resource = std::move(resource);
+        slot->refCount = 1;
+        slots_.emplace(guid, slot);
+
+        TypeState &type = GetTypeState(typeName);
+        type.load = load;
+        ++type.stats.resident;
+        ++type.stats.referenced;
+        type.stats.residentBytes += slot->size;
+        EnforceBudget(type);
+        return slot;
+    }
+
+    void ResourceManager::RecordFailure(const char *typeName)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++GetTypeState(typeName).stats.loadFailures;
+    }
+
+    void ResourceManager::Retain(Detail::ResourceSlot &slot)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        AddRef(slot);
+    }
+
+    // 调用方持有 mutex_
+    void ResourceManager::AddRef(Detail::ResourceSlot &slot)
+    {
+        if (slot.detached)
+            return;
+        if (slot.refCount++ == 0)
+        {
+            TypeState &type = GetTypeState(slot.typeName);
+            ++type.stats.referenced;
+            if (slot.inLru)
+            {
+                type.lru.erase(slot.lruIt);
+                slot.inLru = false;
+            }
+        }
+    }
+
+    void ResourceManager::Release(Detail::ResourceSlot &slot)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (slot.detached || slot.refCount == 0 || --slot.refCount > 0)
+            return;
+        TypeState &type = GetTypeState(slot.typeName);
+        --type.stats.referenced;
+        type.lru.push_front(&slot);
+        slot.lruIt = type.lru.begin();
+        slot.inLru = true;
+        EnforceBudget(type);
+    }
+
+    void ResourceManager::EnforceBudget(TypeState &type)
+    {
+        while (type.stats.residentBytes > type.stats.budgetBytes && !type.lru.empty())
+        {
+            Detail::ResourceSlot *slot = type.lru.back();
+            Evict(type, *slot);
+            ++type.stats.evictions;
+        }
+    }
+
+    void ResourceManager::Evict(TypeState &type, Detail::ResourceSlot &slot)
+    {
+        type.lru.erase(slot.lruIt);
+        slot.inLru = false;
+        --type.stats.resident;
+        type.stats.residentBytes -= slot.size;
+        slots_.erase(slot.guid); // 最后一个 shared_ptr，slot 在此之后失效
+    }
+
+    void ResourceManager::SetBudget(const char *typeName, std::size_t bytes)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        TypeState &type = GetTypeState(typeName);
+        type.stats.budgetBytes = bytes;
+        EnforceBudget(type);
+    }
+
+    void ResourceManager::UnloadUnused()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &[name, type] : types_)
+        {
+            while (!type.lru.empty())
+                Evict(type, *type.lru.back());
+        }
+    }
+
+    void ResourceManager::Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &[guid, slot] : slots_)
+        {
+            slot->detached = true;
+            slot->inLru = false;
+        }
+        slots_.clear();
+        for (auto &[name, type] : types_)
+        {
+            type.lru.clear();
+            type.stats.resident = 0;
+            type.stats.referenced = 0;
+            type.stats.residentBytes = 0;
+        }
+    }
+
+    ResourceTypeStats ResourceManager::GetStats(const char *typeName)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return GetTypeState(typeName).stats;
+    }
+
+    std::vector<ResourceTypeStats> ResourceManager::GetAllStats()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<ResourceTypeStats> stats;
+        stats.reserve(types_.size());
+        for (const auto &[name, type] : types_)
+            stats.push_back(type.stats);
+        std::sort(stats.begin(), stats.end(), [](const ResourceTypeStats &a, const ResourceTypeStats &b) { return a.typeName < b.typeName; });
+        return stats;
+    }
+
+    std::size_t ResourceManager::GetTotalMemoryUsage()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::size_t total = 0;
+        for (const auto &[name, type] : types_)
+            total += type.stats.residentBytes;
+        return total;
+    }
+} // namespace SoulEngine
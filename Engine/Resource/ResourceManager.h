@@ -0,0 +1,211 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Define.h"
+#include "Core/AsyncLoader.h"
+#include "Core/FileWatcher.h"
+#include "Resource/Guid.h"
+#include "Resource/Resource.h"
+
+namespace SoulEngine
+{
+    namespace Detail
+    {
+        // 一个常驻资源；refCount/lru 等字段受 ResourceManager 的互斥锁保护
+        struct ResourceSlot
+        {
+            GUID guid;
+            const char *typeName = nullptr;
+            // 句柄不加锁读取，重新加载时替换：发布后只能用 std::atomic_load / std::atomic_exchange 访问
+            std::shared_ptr<Resource> resource;
+            std::size_t size = 0;
+            uint32_t refCount = 0;
+            bool detached = false;                  // Clear 之后仍被句柄持有，不再计入缓存
+            bool inLru = false;
+            std::list<ResourceSlot *>::iterator lruIt;
+        };
+    }
+
+    /**
+     * @brief 资源的强引用句柄：持有期间资源常驻，不会被淘汰
+     */
+    template <class T>
+    class ResourceHandle
+    {
+    public:
+        ResourceHandle() = default;
+        ResourceHandle(const ResourceHandle &other);
+        ResourceHandle(ResourceHandle &&other) noexcept : slot_(std::move(other.slot_)) {}
+        ResourceHandle &operator=(const ResourceHandle &other);
+        ResourceHandle &operator=(ResourceHandle &&other) noexcept;
+        ~ResourceHandle() { Reset(); }
+
+        // 裸指针在下一次重新加载（主线程）前有效
+        T *Get() const { return slot_ ? static_cast<T *>(std::atomic_load(&slot_->resource).get()) : nullptr; }
+        // 在其他线程使用时取共享指针，期间即使资源被重新加载，旧对象也不会被释放
+        std::shared_ptr<T> Lock() const
+        {
+            return slot_ ? std::static_pointer_cast<T>(std::atomic_load(&slot_->resource)) : nullptr;
+        }
+        T *operator->() const { return Get(); }
+        T &operator*() const { return *Get(); }
+        explicit operator bool() const { return slot_ != nullptr; }
+
+        GUID GetGUID() const { return slot_ ? slot_->guid : GUID{}; }
+        void Reset();
+
+    private:
+        friend class ResourceManager;
+        // slot 的引用计数已由 ResourceManager 增加
+        explicit ResourceHandle(std::shared_ptr<Detail::ResourceSlot> slot) : slot_(std::move(slot)) {}
+
+        std::shared_ptr<Detail::ResourceSlot> slot_;
+    };
+
+    struct ResourceTypeStats
+    {
+        std::string typeName;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t loadFailures = 0;
+        uint64_t evictions = 0;
+        uint64_t reloads = 0;
+        uint32_t resident = 0;               // 常驻数量（含被引用的）
+        uint32_t referenced = 0;             // 被句柄持有的数量
+        std::size_t residentBytes = 0;
+        std::size_t budgetBytes = 0;
+    };
+
+    // 由文件内容构造资源，即 T::Load
+    using ResourceLoadFn = std::shared_ptr<Resource> (*)(const std::string &path, std::vector<uint8_t> &bytes);
+    // 资源重新加载后在主线程调用
+    using ResourceReloadCallback = std::function<void(const GUID &guid)>;
+
+    /**
+     * @brief 资源管理器 - 按 GUID 去重、引用计数常驻、按类型预算做 LRU 淘汰
+     *
+     * 同一资源（路径经 GetGUID 映射为 GUID）只加载一次，之后的 Load 直接返回同一对象的句柄。
+     * 句柄持有期间资源常驻；最后一个句柄释放后资源进入该类型的 LRU 缓存，
+     * 当该类型的常驻字节数超过预算时从最久未使用的开始淘汰。被引用的资源永不淘汰，因此预算可能被暂时超出。
+     * 没有 .meta 的资源使用由路径派生的 GUID；导入系统可用 RegisterAsset 建立显式 GUID 与路径的映射。
+     * 所有接口线程安全；异步加载的回调在主线程（AsyncLoader::Update）执行。
+     * 开启热重载后，搜索路径下常驻资源的文件变化时（FileWatcher）在主线程重新加载：句柄随之指向新对象，
+     * 旧对象被释放，因此不要跨帧保存 Get() 返回的裸指针；在任务或加载线程上使用资源时应通过 ResourceHandle::Lock
+     * 持有共享指针。需要重建派生数据（如着色器程序）时注册 AddReloadListener。
+     *
+     * 使用方式:
+     *   auto& resources = ResourceManager::GetInstance();
+     *   resources.SetBudget<ImageResource>(256 * 1024 * 1024);
+     *   ResourceHandle<TextResource> vs = resources.Load<TextResource>("Shaders/base2.vs.glsl");
+     *   resources.LoadAsync<ImageResource>("Texture/wall.png", LoadPriority::Normal,
+     *                                      [](ResourceHandle<ImageResource> image) { ... });
+     *   ResourceTypeStats stats = resources.GetStats<ImageResource>();
+     *   resources.EnableHotReload(true);
+     *   resources.AddReloadListener([](const GUID& guid) { ... });
+     */
+    class ResourceManager
+    {
+        SINGLETON_CLASS(ResourceManager);
+
+    public:
+        template <class T>
+        ResourceHandle<T> Load(const std::string &path);
+
+        template <class T>
+        ResourceHandle<T> LoadByGUID(const GUID &guid);
+
+        /**
+         * @brief 异步加载：读取在 AsyncLoader 的 I/O 线程，T::Load 在 JobSystem 上执行
+         * 已常驻时立即回调并返回无效的 LoadHandle；加载失败时回调收到空句柄
+         */
+        template <class T>
+        LoadHandle LoadAsync(const std::string &path, LoadPriority priority,
+                             std::function<void(ResourceHandle<T>)> callback);
+
+        // 路径对应的 GUID：显式注册的优先，否则由路径派生
+        GUID GetGUID(const std::string &path);
+        void RegisterAsset(const GUID &guid, const std::string &path);
+        std::string GetPath(const GUID &guid);
+
+        bool IsResident(const GUID &guid);
+
+        // 监视当前所有搜索路径，文件变化时重新加载对应的常驻资源
+        void EnableHotReload(bool enable);
+        bool IsHotReloadEnabled();
+        /**
+         * @brief 从文件重新加载常驻资源并替换句柄指向的对象，只能在主线程调用
+         * @return 未常驻或加载失败（保留旧版本）时返回 false
+         */
+        bool ReloadAsset(const GUID &guid);
+        uint32_t AddReloadListener(ResourceReloadCallback callback);
+        void RemoveReloadListener(uint32_t id);
+
+        // 单个类型的常驻字节预算，默认不限
+        void SetBudget(const char *typeName, std::size_t bytes);
+        template <class T>
+        void SetBudget(std::size_t bytes) { SetBudget(T::kTypeName, bytes); }
+
+        // 淘汰所有未被引用的资源
+        void UnloadUnused();
+        // 释放全部缓存；仍被句柄持有的资源随最后一个句柄释放
+        void Clear();
+
+        ResourceTypeStats GetStats(const char *typeName);
+        template <class T>
+        ResourceTypeStats GetStats() { return GetStats(T::kTypeName); }
+        std::vector<ResourceTypeStats> GetAllStats();
+        std::size_t GetTotalMemoryUsage();
+
+    private:
+        template <class T>
+        friend class ResourceHandle;
+
+        enum class LookupResult
+        {
+            Hit,
+            Miss,
+            WrongType,
+        };
+
+        struct TypeState
+        {
+            ResourceTypeStats stats;
+            std::list<Detail::ResourceSlot *> lru;      // 未被引用的资源，最近释放的在前
+            ResourceLoadFn load = nullptr;              // 热重载使用
+        };
+
+        LookupResult Acquire(const GUID &guid, const char *typeName, std::shared_ptr<Detail::ResourceSlot> &slot);
+        std::shared_ptr<Detail::ResourceSlot> Insert(const GUID &guid, const std::string &path, const char *typeName,
+                                                     ResourceLoadFn load, std::shared_ptr<Resource> resource);
+        void RecordFailure(const char *typeName);
+        void Retain(Detail::ResourceSlot &slot);
+        void AddRef(Detail::ResourceSlot &slot);
+        void Release(Detail::ResourceSlot &slot);
+
+        TypeState &GetTypeState(const char *typeName);
+        void EnforceBudget(TypeState &type);
+        void Evict(TypeState &type, Detail::ResourceSlot &slot);
+        void OnFilesChanged(const std::vector<FileChangeEvent> &events);
+        static std::string NormalizePath(const std::string &path);
+
+        std::mutex mutex_;
+        std::unordered_map<GUID, std::shared_ptr<Detail::ResourceSlot>> slots_;
+        std::unordered_map<std::string, TypeState> types_;
+        std::unordered_map<std::string, GUID> pathToGuid_;
+        std::unordered_map<GUID, std::string> guidToPath_;
+        std::map<uint32_t, ResourceReloadCallback> reloadListeners_;
+        uint32_t nextListenerId_ = 1;
+        std::vector<FileWatcher::WatchId> hotReloadWatches_;
+        bool hotReloadEnabled_ = false;
+    };
+} // namespace SoulEngine
+
+#include "Resource/ResourceManager.inl"
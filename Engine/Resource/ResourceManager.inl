@@ -0,0 +1,135 @@
+// ResourceManager.inl - template implementations for ResourceManager and ResourceHandle
+#pragma once
+
+#include <type_traits>
+#include "Core/EngineFileIO.h"
+#include "Log/Logger.h"
+
+namespace SoulEngine
+{
+
+namespace Detail
+{
+    template <class T>
+    std::shared_ptr<Resource> LoadResource(const std::string &path, std::vector<uint8_t> &bytes)
+    {
+        return T::Load(path, bytes);
+    }
+}
+
+template <class T>
+ResourceHandle<T>::ResourceHandle(const ResourceHandle &other) : slot_(other.slot_)
+{
+    if (slot_)
+        ResourceManager::GetInstance().Retain(*slot_);
+}
+
+template <class T>
+ResourceHandle<T> &ResourceHandle<T>::operator=(const ResourceHandle &other)
+{
+    if (slot_ != other.slot_)
+    {
+        ResourceHandle copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template <class T>
+ResourceHandle<T> &ResourceHandle<T>::operator=(ResourceHandle &&other) noexcept
+{
+    if (this != &other)
+    {
+        Reset();
+        slot_ = std::move(other.slot_);
+    }
+    return *this;
+}
+
+template <class T>
+void ResourceHandle<T>::Reset()
+{
+    if (slot_)
+    {
+        ResourceManager::GetInstance().Release(*slot_);
+        slot_.reset();
+    }
+}
+
+template <class T>
+ResourceHandle<T> ResourceManager::Load(const std::string &path)
+{
+    static_assert(std::is_base_of<Resource, T>::value, "T must derive from Resource");
+
+    const GUID guid = GetGUID(path);
+    std::shared_ptr<Detail::ResourceSlot> slot;
+    const LookupResult lookup = Acquire(guid, T::kTypeName, slot);
+    if (lookup == LookupResult::Hit)
+        return ResourceHandle<T>(std::move(slot));
+    if (lookup == LookupResult::WrongType)
+        return {};
+
+    if (!EngineFileIO::FileExists(path))
+    {
+        Logger::Error("ResourceManager: file not found: {}", path);
+        RecordFailure(T::kTypeName);
+        return {};
+    }
+    std::vector<uint8_t> bytes = EngineFileIO::LoadBinary(path);
+    std::shared_ptr<Resource> resource = T::Load(path, bytes);
+    if (!resource)
+    {
+        RecordFailure(T::kTypeName);
+        return {};
+    }
+    return ResourceHandle<T>(Insert(guid, path, T::kTypeName, &Detail::LoadResource<T>, std::move(resource)));
+}
+
+template <class T>
+ResourceHandle<T> ResourceManager::LoadByGUID(const GUID &guid)
+{
+    const std::string path = GetPath(guid);
+    if (path.empty())
+    {
+        Logger::Error("ResourceManager: unknown GUID {}", guid.ToString());
+        return {};
+    }
+    return Load<T>(path);
+}
+
+template <class T>
+LoadHandle ResourceManager::LoadAsync(const std::string &path, LoadPriority priority,
+                                      std::function<void(ResourceHandle<T>)> callback)
+{
+    static_assert(std::is_base_of<Resource, T>::value, "T must derive from Resource");
+
+    const GUID guid = GetGUID(path);
+    std::shared_ptr<Detail::ResourceSlot> slot;
+    const LookupResult lookup = Acquire(guid, T::kTypeName, slot);
+    if (lookup != LookupResult::Miss)
+    {
+        if (callback)
+            callback(ResourceHandle<T>(std::move(slot)));
+        return {};
+    }
+
+    LoadRequest request;
+    request.path = path;
+    request.priority = priority;
+    request.decodeKey = T::kTypeName;
+    request.decode = [path](std::vector<uint8_t> &bytes) -> std::shared_ptr<void> {
+        std::shared_ptr<Resource> resource = T::Load(path, bytes);
+        return resource;
+    };
+    return AsyncLoader::GetInstance().Load(std::move(request), [this, guid, path, callback](const LoadResult &result) {
+        ResourceHandle<T> handle;
+        if (result.IsOk())
+            handle = ResourceHandle<T>(Insert(guid, path, T::kTypeName, &Detail::LoadResource<T>, result.Get<Resource>()));
+        else
+            RecordFailure(T::kTypeName);
+        if (callback)
+            callback(std::move(handle));
+    });
+}
+
+} // namespace SoulEngine
@@ -1,6 +1,8 @@
 #include <SoulEngine.h>
 #include "Core/ApplicationHelper.h"
+#include "Core/AsyncLoader.h"
 #include "Core/Timer.h"
+#include "Renderer/GfxGeometryPool.h"
 #include "EngineFileIO.h"
 #include "Input.h"
 #include "nlohmann/json.hpp"
@@ -16,9 +18,10 @@ public:
 
     std::shared_ptr<IProgram> program;
     std::shared_ptr<IVertexInputLayout> layout;
-    std::shared_ptr<IBuffer> vertexBuffer1;
-    std::shared_ptr<IBuffer> vertexBuffer2;
-    std::shared_ptr<IBuffer> indexBuffer;
+    std::unique_ptr<GeometryPool> geometryPool;
+    MeshHandle quad;
+    std::shared_ptr<IPipelineState> pipeline;
+    UniformHandle colorHandle;
 
     bool OnInitialize() override
     {
@@ -29,12 +32,29 @@ public:
         Logger::Log("MyApplication initialized");
         auto device = GetDevice();
         auto context = GetContext();
-        auto vsCode = EngineFileIO::LoadText("Shaders/base2.vs.glsl");
-        auto fsCode = EngineFileIO::LoadText("Shaders/base2.fs.glsl");
+        // 两个着色器在 I/O 线程上并行读取，这里只在真正需要时等待
+        auto& loader = AsyncLoader::GetInstance();
+        LoadRequest vsRequest;
+        vsRequest.path = "Shaders/base2.vs.glsl";
+        vsRequest.priority = LoadPriority::High;
+        LoadRequest fsRequest = vsRequest;
+        fsRequest.path = "Shaders/base2.fs.glsl";
+        LoadHandle vsLoad = loader.Load(std::move(vsRequest));
+        LoadHandle fsLoad = loader.Load(std::move(fsRequest));
+        loader.Wait(vsLoad);
+        loader.Wait(fsLoad);
+        if (!vsLoad.GetResult()->IsOk() || !fsLoad.GetResult()->IsOk())
+        {
+            Logger::Error("Failed to load base2 shaders");
+            return false;
+        }
+        const std::string vsCode(vsLoad.GetResult()->GetText());
+        const std::string fsCode(fsLoad.GetResult()->GetText());
 
         auto vs = device->CreateShaderModule({Gfx::ShaderStage::Vertex, vsCode.c_str(), "base"});
         auto fs = device->CreateShaderModule({Gfx::ShaderStage::Fragment, fsCode.c_str(), "base"});
         program = device->CreateProgram(vs, fs, "base");
+        colorHandle = program->GetUniformHandle("u_Color");
 
         struct Vertex
         {
@@ -71,50 +91,40 @@ public:
         };
 
 
-        Gfx::BufferDesc indexBufferDesc{};
-        indexBufferDesc.size = indices.size() * sizeof(uint16_t);
-        indexBufferDesc.kind = Gfx::BufferKind::Index;
-        indexBufferDesc.usage = Gfx::BufferUsage::Immutable;
-        indexBufferDesc.bindFlags = Gfx::BindFlags::IndexBuffer;
-        auto indexData = Gfx::SubresourceData{indices.data(), indexBufferDesc.size, 0};
-        indexBuffer = device->CreateBuffer(indexBufferDesc, &indexData);
-        context->SetIndexBuffer(indexBuffer.get(), Gfx::IndexFormat::UInt16);
-
-
-        Gfx::BufferDesc bufferDesc1{};
-        bufferDesc1.size = positions.size() * sizeof(Pos);
-        bufferDesc1.kind = Gfx::BufferKind::Vertex;
-        bufferDesc1.usage = Gfx::BufferUsage::Immutable;
-        bufferDesc1.bindFlags = Gfx::BindFlags::VertexBuffer;
-        auto data = Gfx::SubresourceData{positions.data(), bufferDesc1.size, 0};
-        vertexBuffer1 = device->CreateBuffer(bufferDesc1, &data);
-
+        // 位置与颜色分两路顶点流，从几何池中子分配，绘制时只需 baseVertex 偏移
+        GeometryPoolDesc poolDesc{};
+        poolDesc.vertexStrides = {sizeof(Pos), sizeof(Color)};
+        poolDesc.vertexCapacity = 4096;
+        poolDesc.indexCapacity = 16384;
+        poolDesc.indexFormat = Gfx::IndexFormat::UInt16;
+        poolDesc.name = "DemoGeometry";
+        geometryPool = std::make_unique<GeometryPool>(device, poolDesc);
 
-        Gfx::BufferDesc bufferDesc2{};
-        bufferDesc2.size = colors.size() * sizeof(Color);
-        bufferDesc2.kind = Gfx::BufferKind::Vertex;
-        bufferDesc2.usage = Gfx::BufferUsage::Immutable;
-        bufferDesc2.bindFlags = Gfx::BindFlags::VertexBuffer;
-        auto data2 = Gfx::SubresourceData{colors.data(), bufferDesc2.size, 0};
-        vertexBuffer2 = device->CreateBuffer(bufferDesc2, &data2);
+        const void* streams[] = {positions.data(), colors.data()};
+        quad = geometryPool->Allocate(streams, static_cast<uint32_t>(positions.size()),
+                                      indices.data(), static_cast<uint32_t>(indices.size()));
 
         Gfx::VertexAttribute attrs[] = {
             {0, Gfx::DataFormat::R32G32B32_Float, 0, 0,},
             {1, Gfx::DataFormat::R32G32B32_Float, 0, 1},
         };
 
-        uint32_t strides[] = {sizeof(float) * 3, sizeof(float) * 3};
-        uint32_t offsets[] = {0, 0};
-        auto vertexBufferPtr1 = vertexBuffer1.get();
-        auto vertexBufferPtr2 = vertexBuffer2.get();
-        IBuffer* vertexBuffers[] = {vertexBufferPtr1, vertexBufferPtr2};
-        context->SetVertexBuffers(0, vertexBuffers, strides, offsets, 2);
-
         layout = device->CreateVertexInputLayout(attrs, 2);
         context->SetVertexInputLayout(layout.get());
+        pipeline = CreatePipeline(PolygonMode::Fill);
         return true;
     }
 
+    std::shared_ptr<IPipelineState> CreatePipeline(PolygonMode polygonMode)
+    {
+        PipelineStateDesc desc{};
+        desc.program = program;
+        desc.inputLayout = layout;
+        desc.polygonMode = polygonMode;
+        desc.name = "base";
+        return GetDevice()->CreatePipelineState(desc);
+    }
+
     void Update(float deltaTime) override
     {
 
@@ -125,17 +135,18 @@ public:
             m_window->SetShouldClose(true);
         }
 
+        // 相同描述会命中设备的 PSO 缓存
         if (Input::GetKeyDown(KeyCode::F1))
         {
-            GetContext()->SetPolygonMode(PolygonMode::Fill);
+            pipeline = CreatePipeline(PolygonMode::Fill);
         }
         else if (Input::GetKeyDown(KeyCode::F2))
         {
-            GetContext()->SetPolygonMode(PolygonMode::Line);
+            pipeline = CreatePipeline(PolygonMode::Line);
         }
         else if (Input::GetKeyDown(KeyCode::F3))
         {
-            GetContext()->SetPolygonMode(PolygonMode::Point);
+            pipeline = CreatePipeline(PolygonMode::Point);
         }
 
         static bool dynamicColor = true;
@@ -144,7 +155,7 @@ public:
             float time = Timer::GetInstance().GetElapsedTime();
             float g = (sin(time) + 1.0f) / 2.0f;
             float c[] = {1.0f, 0.0f, g, 1.0f};
-            program->SetVec4("u_Color", c);
+            program->SetVec4(colorHandle, c);
         }
 
         
@@ -156,16 +167,16 @@ public:
         else if (Input::GetKeyDown(KeyCode::F7))
         {
             float c[] = {1.0f, 1.0f, 1.0f, 1.0f};
-            program->SetVec4("u_Color", c);
+            program->SetVec4(colorHandle, c);
         }
     }
 
     void Render() override
     {
         auto context = GetContext();
-        context->BindProgram(program.get());
-        context->SetVertexInputLayout(layout.get());
-        context->DrawIndexed(6, 0, 0);
+        context->SetPipelineState(pipeline.get());
+        geometryPool->Bind(context);
+        geometryPool->Draw(context, quad);
     }
 
     void Shutdown() override
@@ -0,0 +1,82 @@
+// AssetPacker <input dir> <output.pak> [--align N] [--store]
+// AssetPacker --list <archive.pak>
+// Builds a pack archive from a directory tree, or lists the entries of an existing one.
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "Core/PackFile.h"
+#include "Log/Logger.h"
+
+using namespace SoulEngine;
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::printf("usage: AssetPacker <input dir> <output.pak> [--align N] [--store]\n"
+                    "       AssetPacker --list <archive.pak>\n");
+    }
+
+    int List(const std::string &path)
+    {
+        auto pack = PackArchive::Open(path);
+        if (!pack)
+            return 1;
+        uint64_t stored = 0;
+        uint64_t size = 0;
+        std::printf("%12s %12s  %s\n", "size", "stored", "name");
+        for (uint32_t i = 0; i < pack->GetEntryCount(); ++i)
+        {
+            const PackEntry &e = pack->GetEntry(i);
+            const std::string_view name = pack->GetEntryName(e);
+            std::printf("%12llu %12llu  %.*s%s\n", static_cast<unsigned long long>(e.size), static_cast<unsigned long long>(e.storedSize),
+                        static_cast<int>(name.size()), name.data(), (e.flags & PackEntryCompressed) ? " [lz]" : "");
+            stored += e.storedSize;
+            size += e.size;
+        }
+        std::printf("%u entries, %llu bytes, %llu stored\n", pack->GetEntryCount(), static_cast<unsigned long long>(size),
+                    static_cast<unsigned long long>(stored));
+        return 0;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 3 && std::string(argv[1]) == "--list")
+        return List(argv[2]);
+
+    std::string input;
+    std::string output;
+    PackWriterSettings settings;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--align" && i + 1 < argc)
+            settings.alignment = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--store")
+            settings.compress = false;
+        else if (input.empty() && arg[0] != '-')
+            input = arg;
+        else if (output.empty() && arg[0] != '-')
+            output = arg;
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+    if (input.empty() || output.empty() || !std::filesystem::is_directory(input))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    PackWriter writer;
+    writer.AddDirectory(input);
+    PackWriterStats stats;
+    if (!writer.Write(output, settings, &stats))
+        return 1;
+    Logger::Log("AssetPacker: {} entries ({} compressed), {} -> {} bytes in {:.1f} ms", stats.entries, stats.compressedEntries,
+                stats.inputBytes, stats.outputBytes, stats.ms);
+    return 0;
+}
@@ -0,0 +1,240 @@
+// FrameGraphCheck
+// Builds small frame graphs on the CPU and checks culling, execution order and transient aliasing without a GPU.
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Renderer/FrameGraph/FrameGraph.h"
+
+using namespace SoulEngine;
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::printf("usage: FrameGraphCheck\n");
+    }
+
+    struct Checker
+    {
+        const char* scope = "";
+        uint32_t failures = 0;
+        uint32_t checks = 0;
+
+        void Expect(bool condition, const char* what)
+        {
+            ++checks;
+            if (condition)
+                return;
+            ++failures;
+            std::printf("  FAIL %s: %s\n", scope, what);
+        }
+    };
+
+    FrameGraphResourceDesc MakeBuffer(std::size_t size)
+    {
+        FrameGraphResourceDesc desc{};
+        desc.type = FrameGraphResourceType::Buffer;
+        desc.size = size;
+        return desc;
+    }
+
+    // Records acquires/releases and fails when two live resources share pool bytes.
+    class TrackingAllocator final : public IFrameGraphAllocator
+    {
+    public:
+        explicit TrackingAllocator(Checker& checker) : checker_(checker) {}
+
+        void BeginFrame(std::size_t poolBytes) override
+        {
+            poolBytes_ = poolBytes;
+            live_.clear();
+        }
+
+        void* Acquire(const char* /*name*/, const FrameGraphResourceDesc& desc, std::size_t poolOffset) override
+        {
+            Slot slot{ poolOffset, poolOffset + desc.GetByteSize() };
+            checker_.Expect(slot.end <= poolBytes_, "resource placed past the end of the pool");
+            for (const Slot* other : live_)
+                checker_.Expect(slot.end <= other->begin || other->end <= slot.begin, "live resources share pool bytes");
+            slots_.push_back(std::make_unique<Slot>(slot));
+            live_.push_back(slots_.back().get());
+            ++acquired;
+            return slots_.back().get();
+        }
+
+        void Release(void* resource) override
+        {
+            for (auto it = live_.begin(); it != live_.end(); ++it)
+            {
+                if (*it == resource)
+                {
+                    live_.erase(it);
+                    ++released;
+                    return;
+                }
+            }
+            checker_.Expect(false, "release of a resource that is not live");
+        }
+
+        void EndFrame() override
+        {
+            checker_.Expect(live_.empty(), "resources still live at end of frame");
+        }
+
+        uint32_t acquired = 0;
+        uint32_t released = 0;
+
+    private:
+        struct Slot { std::size_t begin, end; };
+
+        Checker& checker_;
+        std::size_t poolBytes_ = 0;
+        std::vector<std::unique_ptr<Slot>> slots_;
+        std::vector<const Slot*> live_;
+    };
+
+    // Unread outputs cull their writers transitively; side effects and imported writes keep passes alive.
+    void CheckCulling(Checker& c)
+    {
+        c.scope = "culling";
+        FrameGraph graph;
+        int backbuffer = 0;
+        const FrameGraphResource output = graph.Import("Backbuffer", MakeBuffer(16), &backbuffer);
+
+        struct One { FrameGraphResource res; };
+        const auto& dead = graph.AddPass<One>("DeadSource",
+            [&](FrameGraphBuilder& b, One& d) { d.res = b.Create("DeadA", MakeBuffer(64)); },
+            [](const One&, const FrameGraphPassResources&) {});
+        graph.AddPass<One>("DeadSink",
+            [&](FrameGraphBuilder& b, One& d) { b.Read(dead.res); d.res = b.Create("DeadB", MakeBuffer(64)); },
+            [](const One&, const FrameGraphPassResources&) {});
+        const auto& live = graph.AddPass<One>("LiveSource",
+            [&](FrameGraphBuilder& b, One& d) { d.res = b.Create("Color", MakeBuffer(64)); },
+            [](const One&, const FrameGraphPassResources&) {});
+        graph.AddPass<One>("Present",
+            [&](FrameGraphBuilder& b, One& d) { b.Read(live.res); d.res = b.Write(output); },
+            [](const One&, const FrameGraphPassResources&) {});
+        graph.AddPass<One>("Readback",
+            [&](FrameGraphBuilder& b, One&) { b.SetSideEffect(); },
+            [](const One&, const FrameGraphPassResources&) {});
+
+        c.Expect(graph.Compile(), "compile");
+        c.Expect(graph.GetPass(0).IsCulled(), "DeadSource is culled");
+        c.Expect(graph.GetPass(1).IsCulled(), "DeadSink is culled");
+        c.Expect(!graph.GetPass(2).IsCulled(), "LiveSource is kept");
+        c.Expect(!graph.GetPass(3).IsCulled(), "Present is kept");
+        c.Expect(!graph.GetPass(4).IsCulled(), "side-effect pass is kept");
+        c.Expect(graph.IsResourceCulled(dead.res), "DeadA is culled");
+        c.Expect(!graph.IsResourceCulled(live.res), "Color is kept");
+        c.Expect(!graph.IsResourceCulled(output), "imported resource is kept");
+        c.Expect(graph.GetStats().culledPassCount == 2, "two passes culled");
+        c.Expect(graph.GetStats().transientCount == 1, "one live transient");
+        c.Expect(graph.GetExecutionOrder().size() == 3, "three passes executed");
+    }
+
+    // Read-after-write, write-after-read and write-after-write hazards keep passes after the ones they depend on.
+    void CheckOrder(Checker& c)
+    {
+        c.scope = "order";
+        FrameGraph graph;
+        int backbuffer = 0;
+        const FrameGraphResource output = graph.Import("Backbuffer", MakeBuffer(16), &backbuffer);
+        std::vector<std::string> executed;
+
+        struct Res { FrameGraphResource a, b; };
+        auto record = [&executed](const char* name) {
+            return [&executed, name](const Res&, const FrameGraphPassResources&) { executed.push_back(name); };
+        };
+
+        const auto& shadow = graph.AddPass<Res>("Shadow",
+            [&](FrameGraphBuilder& b, Res& d) { d.a = b.Create("ShadowMap", MakeBuffer(128)); }, record("Shadow"));
+        const auto& gbuffer = graph.AddPass<Res>("GBuffer",
+            [&](FrameGraphBuilder& b, Res& d) { d.a = b.Create("Albedo", MakeBuffer(128)); }, record("GBuffer"));
+        graph.AddPass<Res>("Lighting",
+            [&](FrameGraphBuilder& b, Res& d) {
+                b.Read(shadow.a);
+                b.Read(gbuffer.a);
+                d.a = b.Write(output);
+            }, record("Lighting"));
+        // Overwrites the shadow map after Lighting read it (WAR), then the UI reads it
+        const auto& reuse = graph.AddPass<Res>("ShadowReuse",
+            [&](FrameGraphBuilder& b, Res& d) { d.a = b.Write(shadow.a); }, record("ShadowReuse"));
+        graph.AddPass<Res>("UI",
+            [&](FrameGraphBuilder& b, Res& d) {
+                b.Read(reuse.a);
+                d.a = b.Write(output);
+            }, record("UI"));
+
+        c.Expect(graph.Compile(), "compile");
+        graph.Execute(nullptr);
+        const std::vector<std::string> expected = { "Shadow", "GBuffer", "Lighting", "ShadowReuse", "UI" };
+        c.Expect(executed == expected, "passes run as Shadow, GBuffer, Lighting, ShadowReuse, UI");
+    }
+
+    // Three 100-byte buffers in a chain: the first and last never overlap in time and share an offset.
+    void CheckAliasing(Checker& c)
+    {
+        c.scope = "aliasing";
+        FrameGraph graph;
+        int backbuffer = 0;
+        const FrameGraphResource output = graph.Import("Backbuffer", MakeBuffer(16), &backbuffer);
+        std::vector<void*> seen;
+
+        struct Res { FrameGraphResource in, out; };
+        const auto& p0 = graph.AddPass<Res>("P0",
+            [&](FrameGraphBuilder& b, Res& d) { d.out = b.Create("B0", MakeBuffer(100)); },
+            [&](const Res& d, const FrameGraphPassResources& r) { seen.push_back(r.Get(d.out)); });
+        const auto& p1 = graph.AddPass<Res>("P1",
+            [&](FrameGraphBuilder& b, Res& d) { d.in = b.Read(p0.out); d.out = b.Create("B1", MakeBuffer(100)); },
+            [&](const Res& d, const FrameGraphPassResources& r) { seen.push_back(r.Get(d.out)); });
+        const auto& p2 = graph.AddPass<Res>("P2",
+            [&](FrameGraphBuilder& b, Res& d) { d.in = b.Read(p1.out); d.out = b.Create("B2", MakeBuffer(100)); },
+            [&](const Res& d, const FrameGraphPassResources& r) { seen.push_back(r.Get(d.out)); });
+        graph.AddPass<Res>("Resolve",
+            [&](FrameGraphBuilder& b, Res& d) { d.in = b.Read(p2.out); d.out = b.Write(output); },
+            [&](const Res& d, const FrameGraphPassResources& r) { seen.push_back(r.Get(d.out)); });
+
+        c.Expect(graph.Compile(), "compile");
+        const FrameGraphStats& stats = graph.GetStats();
+        c.Expect(stats.transientCount == 3, "three transients");
+        c.Expect(stats.transientBytes == 3 * 256, "unaliased size uses the pool alignment");
+        c.Expect(stats.pooledBytes == 256 + 100, "pool holds two live buffers");
+        c.Expect(stats.GetSavedBytes() == 3 * 256 - (256 + 100), "saved bytes");
+        c.Expect(graph.GetPoolOffset(p0.out) == graph.GetPoolOffset(p2.out), "B0 and B2 alias");
+        c.Expect(graph.GetPoolOffset(p1.out) == 256, "B1 starts at the next aligned offset");
+
+        // Null allocator: transients resolve to nullptr, imported resources to their external object
+        graph.Execute(nullptr);
+        const std::vector<void*> expectedNull = { nullptr, nullptr, nullptr, &backbuffer };
+        c.Expect(seen == expectedNull, "null allocator resolves transients to nullptr");
+
+        seen.clear();
+        TrackingAllocator allocator(c);
+        graph.Execute(&allocator);
+        c.Expect(allocator.acquired == 3 && allocator.released == 3, "every transient acquired and released once");
+        c.Expect(seen.size() == 4 && seen[0] && seen[1] && seen[2] && seen[3] == &backbuffer, "allocator objects reach the passes");
+    }
+}
+
+int main(int argc, char** /*argv*/)
+{
+    if (argc > 1)
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    Checker checker;
+    using CheckFn = void (*)(Checker&);
+    const CheckFn checks[] = { CheckCulling, CheckOrder, CheckAliasing };
+    for (CheckFn check : checks)
+    {
+        const uint32_t before = checker.failures;
+        check(checker);
+        std::printf("%-10s %s\n", checker.scope, checker.failures == before ? "ok" : "FAILED");
+    }
+
+    std::printf("%u checks, %u failed\n", checker.checks, checker.failures);
+    return checker.failures ? 1 : 0;
+}
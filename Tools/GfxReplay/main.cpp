@@ -0,0 +1,193 @@
+// GfxReplay <capture file> [--backend null|software|gl] [--loops N] [--csv out.csv]
+// Plays a GfxCapture recording against a backend and prints per-call timings.
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "Log/Logger.h"
+#include "Renderer/Capture/GfxReplayer.h"
+#include "Renderer/Null/GfxNullDevice.h"
+#include "Renderer/Renderer.h"
+#include "Window/IWindow.h"
+
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+#include "Renderer/Software/SoftwareRenderer.h"
+#endif
+#if defined(SOULENGINE_ENABLE_OPENGL)
+#include "Renderer/OpenGL/OpenGLRenderer.h"
+#include "Window/Platform/GLFWWindow.h"
+#endif
+
+using namespace SoulEngine;
+using namespace SoulEngine::Gfx;
+
+namespace
+{
+    struct Options
+    {
+        std::string path;
+        std::string backend = "null";
+        uint32_t loops = 1;
+        std::string csv;
+    };
+
+    void PrintUsage()
+    {
+        std::printf("usage: GfxReplay <capture> [--backend null|software|gl] [--loops N] [--csv out.csv]\n");
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--backend" && hasValue)
+                options.backend = argv[++i];
+            else if (arg == "--loops" && hasValue)
+                options.loops = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+            else if (arg == "--csv" && hasValue)
+                options.csv = argv[++i];
+            else if (!arg.empty() && arg[0] != '-' && options.path.empty())
+                options.path = arg;
+            else
+                return false;
+        }
+        return !options.path.empty();
+    }
+
+    void PrintSummary(const GfxReplayStats& stats)
+    {
+        std::vector<double> frames = stats.frameMs;
+        std::sort(frames.begin(), frames.end());
+        if (!frames.empty())
+        {
+            const double avg = std::accumulate(frames.begin(), frames.end(), 0.0) / frames.size();
+            std::printf("frames %u: avg %.3f ms, median %.3f ms, min %.3f ms, max %.3f ms\n", stats.frames, avg,
+                        frames[frames.size() / 2], frames.front(), frames.back());
+        }
+        std::printf("records %llu, skipped %llu, failed creates %llu, backend time %.3f ms\n",
+                    static_cast<unsigned long long>(stats.records), static_cast<unsigned long long>(stats.skipped),
+                    static_cast<unsigned long long>(stats.failedCreates), stats.totalMs);
+
+        std::vector<uint32_t> order;
+        for (uint32_t op = 0; op < stats.ops.size(); ++op)
+        {
+            if (stats.ops[op].count)
+                order.push_back(op);
+        }
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return stats.ops[a].totalMs > stats.ops[b].totalMs; });
+
+        std::printf("%-26s %10s %12s %10s %10s\n", "call", "count", "total ms", "avg us", "max us");
+        for (uint32_t op : order)
+        {
+            const GfxReplayOpStats& s = stats.ops[op];
+            std::printf("%-26s %10llu %12.3f %10.3f %10.3f\n", GetGfxCaptureOpName(static_cast<GfxCaptureOp>(op)),
+                        static_cast<unsigned long long>(s.count), s.totalMs, s.totalMs * 1000.0 / s.count, s.maxMs * 1000.0);
+        }
+    }
+
+    bool WriteCsv(const std::string& path, const GfxReplayStats& stats)
+    {
+        std::FILE* file = std::fopen(path.c_str(), "w");
+        if (!file)
+            return false;
+        std::fprintf(file, "call,count,total_ms,avg_us,max_us\n");
+        for (uint32_t op = 0; op < stats.ops.size(); ++op)
+        {
+            const GfxReplayOpStats& s = stats.ops[op];
+            if (!s.count)
+                continue;
+            std::fprintf(file, "%s,%llu,%.6f,%.6f,%.6f\n", GetGfxCaptureOpName(static_cast<GfxCaptureOp>(op)),
+                         static_cast<unsigned long long>(s.count), s.totalMs, s.totalMs * 1000.0 / s.count, s.maxMs * 1000.0);
+        }
+        std::fclose(file);
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // The null backend needs no renderer; the others replay through the renderer so SwapBuffers marks frames
+    std::unique_ptr<GfxNullDevice> nullDevice;
+    std::unique_ptr<GfxNullContext> nullContext;
+    std::unique_ptr<IWindow> window;
+    std::unique_ptr<Renderer> renderer;
+    IDevice* device = nullptr;
+    IContext* context = nullptr;
+
+    if (options.backend == "null")
+    {
+        nullDevice = std::make_unique<GfxNullDevice>();
+        nullContext = std::make_unique<GfxNullContext>();
+        device = nullDevice.get();
+        context = nullContext.get();
+    }
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+    else if (options.backend == "software")
+    {
+        renderer = std::make_unique<SoftwareRenderer>();
+        renderer->Initialize(nullptr);
+    }
+#endif
+#if defined(SOULENGINE_ENABLE_OPENGL)
+    else if (options.backend == "gl")
+    {
+        window = std::make_unique<GLFWWindow>();
+        WindowConfig config;
+        config.title = "GfxReplay";
+        config.width = 1280;
+        config.height = 720;
+        config.vsync = false;
+        window->Initialize(config);
+        renderer = std::make_unique<OpenGLRenderer>();
+        if (!renderer->Initialize(window.get()))
+            return 1;
+    }
+#endif
+    else
+    {
+        Logger::Error("GfxReplay: backend '{}' is not available in this build", options.backend);
+        return 1;
+    }
+
+    if (renderer)
+    {
+        device = renderer->GetGfxDevice();
+        context = renderer->GetGfxContext();
+    }
+
+    GfxReplayer replayer(device, context);
+    if (!replayer.Load(options.path))
+        return 1;
+    std::printf("%s: %u frames, %u records, backend %s, %u loop(s)\n", options.path.c_str(), replayer.GetHeader().frameCount,
+                replayer.GetHeader().recordCount, options.backend.c_str(), options.loops);
+
+    replayer.Replay(options.loops, [&](uint32_t) {
+        if (!renderer)
+            return;
+        renderer->SwapBuffers();
+        if (window)
+            window->PollEvents();
+        renderer->BeginFrame();
+    });
+
+    PrintSummary(replayer.GetStats());
+    if (!options.csv.empty() && !WriteCsv(options.csv, replayer.GetStats()))
+        Logger::Error("GfxReplay: cannot write {}", options.csv);
+
+    if (renderer)
+        renderer->Shutdown();
+    return 0;
+}
@@ -0,0 +1,240 @@
+// TextureCooker <image | directory> <output.stex> [--srgb] [--format rgba8|bc1|bc3|bc4|bc5|bc7]
+//               [--filter box|kaiser] [--ext .bmp] [--bench N] [--encode-bench]
+// Cooks an image (or a directory of equally sized images, as a texture array) into a .stex file with a
+// full mip chain, block compressed with --format. --bench N then compares N loads of the sources
+// (stb_image decode + mip generation) against N loads of the cooked file, both ending in a texture
+// upload. --encode-bench times both mip filters and every block encoder on the first image and reports
+// their PSNR against the source; the output path may then be left out.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Core/EngineFileIO.h"
+#include "Core/JobSystem.h"
+#include "Log/Logger.h"
+#include "Renderer/Null/GfxNullDevice.h"
+#include "Renderer/Texture/TextureCompression.h"
+#include "Renderer/Texture/TextureFile.h"
+#include "Renderer/Texture/TextureProcessing.h"
+
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+#include "Renderer/Software/GfxSWDevice.h"
+#endif
+
+using namespace SoulEngine;
+using namespace SoulEngine::Gfx;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedMs(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    void PrintUsage()
+    {
+        std::printf("usage: TextureCooker <image | directory> <output.stex> [--srgb] [--format rgba8|bc1|bc3|bc4|bc5|bc7]\n"
+                    "                     [--filter box|kaiser] [--ext .bmp] [--bench N] [--encode-bench]\n");
+    }
+
+    constexpr const char* kEncoderNames[] = { "bc1", "bc3", "bc4", "bc5", "bc7" };
+
+    // PSNR over channels [first, first + count) of two RGBA8 images; 0 dB difference reads as inf
+    std::string Psnr(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, int first, int count)
+    {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < a.size(); i += 4)
+        {
+            for (int c = first; c < first + count; ++c)
+            {
+                const double d = static_cast<double>(a[i + c]) - b[i + c];
+                sum += d * d;
+            }
+        }
+        const double mse = sum / (static_cast<double>(a.size() / 4) * count);
+        if (mse == 0.0)
+            return "inf";
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.2f", 10.0 * std::log10(255.0 * 255.0 / mse));
+        return text;
+    }
+
+    void EncodeBench(const std::string& sourcePath, bool srgb, int iterations)
+    {
+        const std::vector<uint8_t> file = EngineFileIO::LoadBinary(sourcePath);
+        ImageRGBA8 image;
+        if (!DecodeImageRGBA8(file.data(), file.size(), image))
+        {
+            Logger::Error("TextureCooker: cannot decode {}", sourcePath);
+            return;
+        }
+        const double megapixels = static_cast<double>(image.width) * image.height / 1e6;
+        std::printf("%s: %ux%u, %d iterations, %u job workers + caller\n", sourcePath.c_str(), image.width, image.height,
+                    iterations, JobSystem::GetInstance().GetWorkerCount());
+
+        const uint32_t mipCount = GetMipLevelCount(image.width, image.height);
+        std::printf("  mip chain (%u levels, %s)     ms      MPix/s\n", mipCount, srgb ? "sRGB" : "linear");
+        for (MipFilter filter : { MipFilter::Box, MipFilter::Kaiser })
+        {
+            std::vector<std::vector<uint8_t>> levels;
+            const auto start = Clock::now();
+            for (int i = 0; i < iterations; ++i)
+                GenerateMipChain(image.pixels.data(), image.width, image.height, mipCount, srgb, filter, levels);
+            const double ms = ElapsedMs(start) / iterations;
+            std::printf("    %-27s %8.2f %10.1f\n", filter == MipFilter::Box ? "box" : "kaiser", ms, megapixels / (ms / 1000.0));
+        }
+
+        std::printf("  encoder (mip 0)                   ms      MPix/s   PSNR color   PSNR alpha\n");
+        std::vector<uint8_t> decoded(image.pixels.size());
+        for (const char* name : kEncoderNames)
+        {
+            DataFormat format = DataFormat::Unknown;
+            ParseCookFormat(name, format);
+            std::vector<uint8_t> blocks(GetTextureLevelSize(format, image.width, image.height));
+            const auto start = Clock::now();
+            for (int i = 0; i < iterations; ++i)
+                CompressImage(format, image.pixels.data(), image.width, image.height, blocks.data());
+            const double ms = ElapsedMs(start) / iterations;
+            DecompressImage(format, blocks.data(), image.width, image.height, decoded.data());
+
+            // Only the channels the format stores: BC4 keeps red, BC5 red and green
+            const int colorChannels = format == DataFormat::BC4_UNorm ? 1 : format == DataFormat::BC5_UNorm ? 2 : 3;
+            const bool hasAlpha = colorChannels == 3;
+            std::printf("    %-27s %8.2f %10.1f %12s %12s\n", name, ms, megapixels / (ms / 1000.0),
+                        Psnr(image.pixels, decoded, 0, colorChannels).c_str(),
+                        hasAlpha ? Psnr(image.pixels, decoded, 3, 1).c_str() : "-");
+        }
+    }
+
+    std::unique_ptr<IDevice> CreateUploadDevice(const char*& name)
+    {
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+        name = "software";
+        return std::make_unique<GfxSWDevice>();
+#else
+        name = "null";
+        return std::make_unique<GfxNullDevice>();
+#endif
+    }
+
+    void Bench(const std::vector<std::string>& sources, const TextureCookOptions& options, const std::string& cooked, int iterations)
+    {
+        const char* deviceName = nullptr;
+        std::unique_ptr<IDevice> device = CreateUploadDevice(deviceName);
+
+        double sourceMs = 0.0;
+        for (int i = 0; i < iterations; ++i)
+        {
+            const auto start = Clock::now();
+            ImageFileTextureSource source(sources, options.srgb, options.mipFilter);
+            std::vector<std::vector<uint8_t>> levels;
+            if (!source.IsValid() || !source.LoadMips(0, source.GetDesc().mipLevels, levels))
+                return;
+            std::vector<SubresourceData> initial(levels.size());
+            for (std::size_t l = 0; l < levels.size(); ++l)
+                initial[l] = { levels[l].data(), levels[l].size(), 0 };
+            device->CreateTexture(source.GetDesc(), initial.data());
+            sourceMs += ElapsedMs(start);
+        }
+
+        double cookedMs = 0.0;
+        double openMs = 0.0;
+        for (int i = 0; i < iterations; ++i)
+        {
+            const auto start = Clock::now();
+            TextureFile file;
+            if (!file.Open(cooked))
+                return;
+            openMs += ElapsedMs(start);
+            file.CreateTexture(device.get());
+            cookedMs += ElapsedMs(start);
+        }
+
+        std::printf("upload to %s device, average of %d:\n", deviceName, iterations);
+        std::printf("  source (stb_image decode + mips + upload): %8.2f ms\n", sourceMs / iterations);
+        std::printf("  cooked (map + validate + upload):          %8.2f ms (open %.3f ms)\n", cookedMs / iterations, openMs / iterations);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string input;
+    std::string output;
+    std::string extension = ".bmp";
+    TextureCookOptions options;
+    int benchIterations = 0;
+    bool encodeBench = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--srgb")
+            options.srgb = true;
+        else if (arg == "--format" && i + 1 < argc && ParseCookFormat(argv[i + 1], options.format))
+            ++i;
+        else if (arg == "--filter" && i + 1 < argc && (std::string(argv[i + 1]) == "box" || std::string(argv[i + 1]) == "kaiser"))
+            options.mipFilter = std::string(argv[++i]) == "box" ? MipFilter::Box : MipFilter::Kaiser;
+        else if (arg == "--encode-bench")
+            encodeBench = true;
+        else if (arg == "--ext" && i + 1 < argc)
+            extension = argv[++i];
+        else if (arg == "--bench" && i + 1 < argc)
+            benchIterations = std::max(std::atoi(argv[++i]), 1);
+        else if (input.empty() && arg[0] != '-')
+            input = arg;
+        else if (output.empty() && arg[0] != '-')
+            output = arg;
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+    if (input.empty() || (output.empty() && !encodeBench))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // EngineFileIO resolves relative paths against its search paths, not the working directory
+    if (std::filesystem::exists(input))
+        input = std::filesystem::absolute(input).string();
+
+    std::vector<std::string> sources;
+    if (std::filesystem::is_directory(input))
+        sources = ImageFileTextureSource::ListImageSequence(input, extension);
+    else
+        sources.push_back(input);
+    if (sources.empty())
+    {
+        Logger::Error("TextureCooker: no {} images in {}", extension, input);
+        return 1;
+    }
+
+    if (encodeBench)
+        EncodeBench(sources.front(), options.srgb, std::max(benchIterations, 1));
+    if (output.empty())
+        return 0;
+
+    TextureCookStats stats;
+    if (!CookTexture(sources, options, output, &stats))
+        return 1;
+    TextureFile cooked;
+    if (!cooked.Open(output))
+        return 1;
+    const TextureDesc& desc = cooked.GetDesc();
+    Logger::Log("TextureCooker: {} -> {} ({}x{}, {} layers, {} mips, format {}, {} bytes), decode {:.1f} ms, encode {:.1f} ms, write {:.1f} ms",
+                input, output, desc.width, desc.height, desc.arrayLayers, desc.mipLevels, static_cast<uint32_t>(desc.format),
+                stats.outputBytes, stats.decodeMs, stats.encodeMs, stats.writeMs);
+    cooked.Close();
+
+    if (benchIterations > 0)
+        Bench(sources, options, output, benchIterations);
+    return 0;
+}
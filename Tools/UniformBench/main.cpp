@@ -0,0 +1,180 @@
+// UniformBench [--draws N] [--runs N] [--static]
+// Times per-draw material updates through IProgram::SetVec4(name), IProgram::SetVec4(UniformHandle) and
+// ParameterBlock::Commit. Programs and buffers come from the software device; draws go to the null context
+// so the numbers only contain the uniform path.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Renderer/GfxParameterBlock.h"
+#include "Renderer/Null/GfxNullDevice.h"
+
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+#include "Renderer/Software/GfxSWDevice.h"
+#endif
+
+using namespace SoulEngine;
+using namespace SoulEngine::Gfx;
+
+namespace
+{
+    struct Options
+    {
+        uint32_t draws = 100000;
+        uint32_t runs = 5;
+        bool staticValues = false;   // same values every draw, so ParameterBlock skips the upload
+    };
+
+    void PrintUsage()
+    {
+        std::printf("usage: UniformBench [--draws N] [--runs N] [--static]\n");
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--draws" && hasValue)
+                options.draws = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+            else if (arg == "--runs" && hasValue)
+                options.runs = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+            else if (arg == "--static")
+                options.staticValues = true;
+            else
+                return false;
+        }
+        return true;
+    }
+
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+    // A typical material: eight vec4 parameters read by the fragment stage
+    constexpr uint32_t kParamCount = 8;
+    const char* const kParamNames[kParamCount] = { "u_BaseColor", "u_Emissive", "u_Tiling", "u_Params0",
+                                                   "u_Params1", "u_Params2", "u_Params3", "u_Params4" };
+
+    void BenchVertex(const SWShaderResources&, const float (*)[4], float outPosition[4], float*)
+    {
+        outPosition[0] = outPosition[1] = outPosition[2] = 0.0f;
+        outPosition[3] = 1.0f;
+    }
+
+    bool BenchFragment(const SWShaderResources& res, const float*, float outColor[4])
+    {
+        std::copy(res.uniforms, res.uniforms + 4, outColor);
+        return true;
+    }
+
+    // Median nanoseconds per draw over options.runs runs of options.draws draws
+    template <class DrawFn>
+    double Measure(const Options& options, DrawFn&& draw)
+    {
+        std::vector<double> samples;
+        for (uint32_t run = 0; run < options.runs; ++run)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < options.draws; ++i)
+                draw(options.staticValues ? 0u : i);
+            const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            samples.push_back(elapsed.count() / options.draws);
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+#endif
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+#if defined(SOULENGINE_ENABLE_SOFTWARE)
+    GfxSWDevice device;
+    GfxNullContext context;
+
+    SWShaderDesc vsDesc{};
+    vsDesc.stage = ShaderStage::Vertex;
+    vsDesc.vertex = BenchVertex;
+    SWShaderDesc fsDesc{};
+    fsDesc.stage = ShaderStage::Fragment;
+    fsDesc.fragment = BenchFragment;
+    ParameterBlockLayout layout;
+    for (const char* name : kParamNames)
+    {
+        fsDesc.uniforms.push_back({ name, UniformType::Vec4 });
+        layout.Add(name, UniformType::Vec4);
+    }
+    fsDesc.uniformBlocks.push_back("Material");
+
+    auto program = device.CreateProgram(device.CreateShaderModule(vsDesc, "UniformBench.vs"),
+                                        device.CreateShaderModule(fsDesc, "UniformBench.fs"), "UniformBench");
+    program->BindUniformBlock("Material", 0);
+    context.BindProgram(program.get());
+
+    UniformHandle handles[kParamCount];
+    for (uint32_t p = 0; p < kParamCount; ++p)
+        handles[p] = program->GetUniformHandle(kParamNames[p]);
+
+    ParameterBlock block(&device, layout, "Material");
+    ParameterHandle params[kParamCount];
+    for (uint32_t p = 0; p < kParamCount; ++p)
+        params[p] = block.GetHandle(kParamNames[p]);
+
+    auto values = [](uint32_t draw, uint32_t p, float v[4]) {
+        v[0] = static_cast<float>(draw);
+        v[1] = static_cast<float>(p);
+        v[2] = 0.5f;
+        v[3] = 1.0f;
+    };
+
+    const double byName = Measure(options, [&](uint32_t draw) {
+        float v[4];
+        for (uint32_t p = 0; p < kParamCount; ++p)
+        {
+            values(draw, p, v);
+            program->SetVec4(kParamNames[p], v);
+        }
+        context.Draw(3, 0);
+    });
+    const double byHandle = Measure(options, [&](uint32_t draw) {
+        float v[4];
+        for (uint32_t p = 0; p < kParamCount; ++p)
+        {
+            values(draw, p, v);
+            program->SetVec4(handles[p], v);
+        }
+        context.Draw(3, 0);
+    });
+    const uint64_t uploadsBefore = block.GetUploadCount();
+    const double byBlock = Measure(options, [&](uint32_t draw) {
+        float v[4];
+        for (uint32_t p = 0; p < kParamCount; ++p)
+        {
+            values(draw, p, v);
+            block.SetVec4(params[p], v);
+        }
+        block.Commit(&context, 0);
+        context.Draw(3, 0);
+    });
+
+    std::printf("%u draws x %u runs, %u vec4 per draw, %s values\n", options.draws, options.runs, kParamCount,
+                options.staticValues ? "static" : "per-draw");
+    std::printf("  SetVec4(name)          %8.1f ns/draw\n", byName);
+    std::printf("  SetVec4(UniformHandle) %8.1f ns/draw  (%.2fx)\n", byHandle, byName / byHandle);
+    std::printf("  ParameterBlock::Commit %8.1f ns/draw  (%.2fx), %llu uploads\n", byBlock, byName / byBlock,
+                static_cast<unsigned long long>(block.GetUploadCount() - uploadsBefore));
+    return 0;
+#else
+    std::printf("UniformBench needs the software backend (SOULENGINE_WITH_SOFTWARE)\n");
+    return 1;
+#endif
+}
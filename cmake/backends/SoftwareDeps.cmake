@@ -0,0 +1,23 @@
+# SoulEngine software rasterizer dependency setup
+# Exposes SoulEngine::SoftwareDeps carrying optional SIMD flags for the CPU backend
+
+if (NOT SOULENGINE_WITH_SOFTWARE)
+  return()
+endif()
+message("Including software rasterizer dependencies")
+
+# SSE2 is baseline on x86-64; AVX2 widens edge evaluation to 8 pixels but is opt-in for portable binaries
+option(SOULENGINE_SOFTWARE_AVX2 "Build the software rasterizer with AVX2" OFF)
+
+if (NOT TARGET SoulEngine_SoftwareDeps)
+  add_library(SoulEngine_SoftwareDeps INTERFACE)
+  set_target_properties(SoulEngine_SoftwareDeps PROPERTIES FOLDER "thirdlib/Software")
+  if (SOULENGINE_SOFTWARE_AVX2)
+    if (MSVC)
+      target_compile_options(SoulEngine_SoftwareDeps INTERFACE /arch:AVX2)
+    else()
+      target_compile_options(SoulEngine_SoftwareDeps INTERFACE -mavx2)
+    endif()
+  endif()
+  add_library(SoulEngine::SoftwareDeps ALIAS SoulEngine_SoftwareDeps)
+endif()